@@ -161,6 +161,13 @@ struct ac_cs_clear_copy_buffer_options {
    const struct radeon_info *info;
    bool print_key;      /* print the shader key into stderr */
    bool fail_if_slow;   /* fail if a gfx blit is faster, set to false on compute queues */
+
+   /* If non-zero, VRAM copies/clears of at most this many bytes fail if fail_if_slow is set,
+    * so that CP DMA does them, instead of using the built-in per-chip heuristic. They are
+    * meant to be measured on the GPU at hand.
+    */
+   unsigned cp_dma_max_copy_size;
+   unsigned cp_dma_max_clear_size;
 };
 
 struct ac_cs_clear_copy_buffer_info {
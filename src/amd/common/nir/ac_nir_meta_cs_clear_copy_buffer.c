@@ -328,6 +328,94 @@ ac_create_clear_copy_buffer_cs(struct ac_cs_clear_copy_buffer_options *options,
    return b.shader;
 }
 
+/* Whether CP DMA is faster than the compute shader for the clear/copy. */
+static bool
+is_cp_dma_faster(const struct ac_cs_clear_copy_buffer_options *options,
+                 const struct ac_cs_clear_copy_buffer_info *info, bool is_copy,
+                 int clear_value_size)
+{
+   unsigned tuned_max_size = is_copy ? options->cp_dma_max_copy_size :
+                                       options->cp_dma_max_clear_size;
+
+   /* Measured values only cover VRAM. */
+   if (tuned_max_size && info->dst_is_vram && (!is_copy || info->src_is_vram)) {
+      /* CP DMA only supports dword-aligned clears and small clear values. */
+      return info->size <= tuned_max_size &&
+             (is_copy || (clear_value_size <= 4 && info->dst_offset % 4 == 0 &&
+                          info->size % 4 == 0));
+   }
+
+   switch (options->info->gfx_level) {
+   /* GFX6-8: CP DMA clears are so slow that we risk getting a GPU timeout. CP DMA copies
+    * are also slow but less.
+    */
+   case GFX6:
+      /* Optimal for Tahiti. */
+      if (is_copy) {
+         if (!info->dst_is_vram || !info->src_is_vram ||
+             info->size <= (info->dst_offset % 4 ||
+                            (info->dst_offset == 4 && info->src_offset % 4) ? 32 * 1024 : 16 * 1024))
+            return true;
+      } else {
+         /* CP DMA only supports dword-aligned clears and small clear values. */
+         if (clear_value_size <= 4 && info->dst_offset % 4 == 0 && info->size % 4 == 0 &&
+             info->dst_is_vram && info->size <= 1024)
+            return true;
+      }
+      break;
+
+   case GFX7:
+      /* Optimal for Hawaii. */
+      if (is_copy && info->dst_is_vram && info->src_is_vram && info->size <= 512)
+         return true;
+      break;
+
+   case GFX8:
+      /* Optimal for Tonga. */
+      break;
+
+   case GFX9:
+      /* Optimal for Vega10. */
+      if (is_copy) {
+         if (info->src_is_vram) {
+            if (info->dst_is_vram) {
+               if (info->size < 4096)
+                  return true;
+            } else {
+               if (info->size < (info->dst_offset % 64 ? 8192 : 2048))
+                  return true;
+            }
+         } else {
+            /* GTT->VRAM and GTT->GTT. */
+            return true;
+         }
+      } else {
+         /* CP DMA only supports dword-aligned clears and small clear values. */
+         if (clear_value_size <= 4 && info->dst_offset % 4 == 0 && info->size % 4 == 0 &&
+             !info->dst_is_vram && (info->size < 2048 || info->size >= 8 << 20 /* 8 MB */))
+            return true;
+      }
+      break;
+
+   case GFX10:
+   case GFX10_3:
+      /* Optimal for Navi21, Navi10. */
+      break;
+
+   case GFX11:
+   default:
+      /* Optimal for Navi31. */
+      if (is_copy && info->size < 1024 && info->dst_offset % 256 && info->dst_is_vram && info->src_is_vram)
+         return true;
+      break;
+
+   case GFX12:
+      UNREACHABLE("cp_sdma_ge_use_system_memory_scope should be true, so we should never get here");
+   }
+
+   return false;
+}
+
 bool
 ac_prepare_cs_clear_copy_buffer(const struct ac_cs_clear_copy_buffer_options *options,
                                 const struct ac_cs_clear_copy_buffer_info *info,
@@ -353,75 +441,9 @@ ac_prepare_cs_clear_copy_buffer(const struct ac_cs_clear_copy_buffer_options *op
     * support the render condition.
     */
    if (options->fail_if_slow && !info->render_condition_enabled && options->info->has_cp_dma &&
-       !options->info->cp_sdma_ge_use_system_memory_scope) {
-      switch (options->info->gfx_level) {
-      /* GFX6-8: CP DMA clears are so slow that we risk getting a GPU timeout. CP DMA copies
-       * are also slow but less.
-       */
-      case GFX6:
-         /* Optimal for Tahiti. */
-         if (is_copy) {
-            if (!info->dst_is_vram || !info->src_is_vram ||
-                info->size <= (info->dst_offset % 4 ||
-                               (info->dst_offset == 4 && info->src_offset % 4) ? 32 * 1024 : 16 * 1024))
-               return false;
-         } else {
-            /* CP DMA only supports dword-aligned clears and small clear values. */
-            if (clear_value_size <= 4 && info->dst_offset % 4 == 0 && info->size % 4 == 0 &&
-                info->dst_is_vram && info->size <= 1024)
-               return false;
-         }
-         break;
-
-      case GFX7:
-         /* Optimal for Hawaii. */
-         if (is_copy && info->dst_is_vram && info->src_is_vram && info->size <= 512)
-            return false;
-         break;
-
-      case GFX8:
-         /* Optimal for Tonga. */
-         break;
-
-      case GFX9:
-         /* Optimal for Vega10. */
-         if (is_copy) {
-            if (info->src_is_vram) {
-               if (info->dst_is_vram) {
-                  if (info->size < 4096)
-                     return false;
-               } else {
-                  if (info->size < (info->dst_offset % 64 ? 8192 : 2048))
-                     return false;
-               }
-            } else {
-               /* GTT->VRAM and GTT->GTT. */
-               return false;
-            }
-         } else {
-            /* CP DMA only supports dword-aligned clears and small clear values. */
-            if (clear_value_size <= 4 && info->dst_offset % 4 == 0 && info->size % 4 == 0 &&
-                !info->dst_is_vram && (info->size < 2048 || info->size >= 8 << 20 /* 8 MB */))
-               return false;
-         }
-         break;
-
-      case GFX10:
-      case GFX10_3:
-         /* Optimal for Navi21, Navi10. */
-         break;
-
-      case GFX11:
-      default:
-         /* Optimal for Navi31. */
-         if (is_copy && info->size < 1024 && info->dst_offset % 256 && info->dst_is_vram && info->src_is_vram)
-            return false;
-         break;
-
-      case GFX12:
-         UNREACHABLE("cp_sdma_ge_use_system_memory_scope should be true, so we should never get here");
-      }
-   }
+       !options->info->cp_sdma_ge_use_system_memory_scope &&
+       is_cp_dma_faster(options, info, is_copy, clear_value_size))
+      return false;
 
    unsigned dwords_per_thread = info->dwords_per_thread;
 
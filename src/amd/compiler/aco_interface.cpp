@@ -9,6 +9,7 @@
 #include "aco_ir.h"
 
 #include "util/memstream.h"
+#include "util/os_time.h"
 
 #include "ac_gpu_info.h"
 #include "nir.h"
@@ -30,6 +31,28 @@ validate(Program* program)
    assert(is_valid);
 }
 
+/* Adds the time since the previous call to the pass that was running, and
+ * starts timing the next one.
+ */
+static void
+start_pass(Program* program, aco_compile_pass pass)
+{
+   aco_compile_stats* stats = program->compile_stats;
+   if (!stats)
+      return;
+
+   uint64_t now = os_time_get_nano();
+   aco_compile_pass prev = program->compile_pass;
+   if (prev != aco_num_compile_passes) {
+      uint64_t memory = program->m.allocated_size() + program->live.memory.allocated_size();
+      stats->time_ns[prev] += now - program->compile_pass_start;
+      stats->memory[prev] = MAX2(stats->memory[prev], memory);
+   }
+
+   program->compile_pass = pass;
+   program->compile_pass_start = now;
+}
+
 static std::string
 get_disasm_string(Program* program, enum radeon_family family, std::vector<uint32_t>& code,
                   unsigned exec_size)
@@ -69,6 +92,8 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    if (options->dump_preoptir)
       aco_print_program(program.get(), stderr);
 
+   start_pass(program.get(), aco_compile_pass_lower_phis);
+
    ASSERTED bool is_valid = validate_cfg(program.get());
    assert(is_valid);
 
@@ -84,8 +109,10 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
 
    /* Optimization */
    if (!options->optimisations_disabled) {
+      start_pass(program.get(), aco_compile_pass_value_numbering);
       if (!(debug_flags & DEBUG_NO_VN))
          value_numbering(program.get());
+      start_pass(program.get(), aco_compile_pass_optimizer);
       if (!(debug_flags & DEBUG_NO_OPT))
          optimize(program.get());
 
@@ -95,14 +122,17 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    }
 
    /* cleanup and exec mask handling */
+   start_pass(program.get(), aco_compile_pass_exec_mask);
    setup_reduce_temp(program.get());
    insert_exec_mask(program.get());
    validate(program.get());
 
    /* spilling and scheduling */
+   start_pass(program.get(), aco_compile_pass_live_vars);
    live_var_analysis(program.get());
    if (program->collect_statistics)
       collect_presched_stats(program.get());
+   start_pass(program.get(), aco_compile_pass_spill);
    spill(program.get());
 
    if (options->record_ir) {
@@ -123,12 +153,14 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    if ((debug_flags & DEBUG_LIVE_INFO) && options->dump_ir)
       aco_print_program(program.get(), stderr, print_live_vars | print_kill);
 
+   start_pass(program.get(), aco_compile_pass_scheduler);
    if (!options->optimisations_disabled && !(debug_flags & DEBUG_NO_SCHED))
       schedule_program(program.get());
    validate(program.get());
 
    /* Register Allocation */
-   register_allocation(program.get());
+   start_pass(program.get(), aco_compile_pass_register_allocation);
+   register_allocation(program.get(), {}, options->optimisations_disabled);
 
    if (validate_ra(program.get())) {
       aco_print_program(program.get(), stderr);
@@ -140,11 +172,13 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    validate(program.get());
 
    /* Optimization */
+   start_pass(program.get(), aco_compile_pass_optimizer_post_ra);
    if (!options->optimisations_disabled && !(debug_flags & DEBUG_NO_OPT)) {
       optimize_postRA(program.get());
       validate(program.get());
    }
 
+   start_pass(program.get(), aco_compile_pass_lower_to_hw);
    spill_preserved(program.get());
 
    /* Lower to HW Instructions */
@@ -153,6 +187,7 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    lower_branches(program.get());
    validate(program.get());
 
+   start_pass(program.get(), aco_compile_pass_scheduler_ilp);
    if (!options->optimisations_disabled && !(debug_flags & DEBUG_NO_SCHED_VOPD))
       schedule_vopd(program.get());
 
@@ -160,6 +195,7 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    if (!options->optimisations_disabled && !(debug_flags & DEBUG_NO_SCHED_ILP))
       schedule_ilp(program.get());
 
+   start_pass(program.get(), aco_compile_pass_hazards);
    disable_wqm(program.get());
 
    if (program->needs_fp_mode_insertion)
@@ -182,6 +218,26 @@ aco_postprocess_shader(const struct aco_compiler_options* options,
    return llvm_ir;
 }
 
+/* Estimates how much memory the instructions of a program take, based on the size of the NIR
+ * shaders it is selected from.
+ */
+static size_t
+estimate_program_size(unsigned shader_count, struct nir_shader* const* shaders)
+{
+   size_t num_instrs = 0;
+   for (unsigned i = 0; i < shader_count; i++) {
+      nir_foreach_function_impl (impl, shaders[i]) {
+         nir_foreach_block (block, impl)
+            num_instrs += exec_list_length(&block->instr_list);
+      }
+   }
+
+   /* Most NIR instructions are selected to one or two ACO instructions, and later passes add
+    * copies, waits and lowered pseudo instructions.
+    */
+   return num_instrs * 128;
+}
+
 typedef void(select_shader_part_callback)(Program* program, void* pinfo, ac_shader_config* config,
                                           const struct aco_compiler_options* options,
                                           const struct aco_shader_info* info,
@@ -237,19 +293,26 @@ aco_compile_shader(const struct aco_compiler_options* options, const struct aco_
 
    ac_shader_config config = {0};
    std::unique_ptr<Program> program{new Program};
+   program->m.reserve(estimate_program_size(shader_count, shaders));
 
    program->collect_statistics = options->record_stats;
    memset(&program->statistics, 0, sizeof(program->statistics));
 
+   aco_compile_stats compile_stats = {};
+   if (options->record_compile_stats)
+      program->compile_stats = &compile_stats;
+
    program->debug.func = options->debug.func;
    program->debug.private_data = options->debug.private_data;
 
    /* Instruction Selection */
+   start_pass(program.get(), aco_compile_pass_isel);
    select_program(program.get(), shader_count, shaders, &config, options, info, args);
 
    std::string llvm_ir = aco_postprocess_shader(options, program);
 
    /* assembly */
+   start_pass(program.get(), aco_compile_pass_assembly);
    std::vector<uint32_t> code;
    std::vector<struct aco_symbol> symbols;
    /* OpenGL combine multi shader parts into one continous code block,
@@ -261,13 +324,16 @@ aco_compile_shader(const struct aco_compiler_options* options, const struct aco_
    if (program->collect_statistics)
       collect_postasm_stats(program.get(), code);
 
+   start_pass(program.get(), aco_num_compile_passes);
+
    std::string disasm;
    if (options->record_asm)
       disasm = get_disasm_string(program.get(), options->family, code, exec_size);
 
    (*build_binary)(binary, &config, llvm_ir.c_str(), llvm_ir.size(), disasm.c_str(), disasm.size(),
-                   &program->statistics, exec_size, code.data(), code.size(), symbols.data(),
-                   symbols.size(), program->debug_info.data(), program->debug_info.size());
+                   &program->statistics, program->compile_stats, exec_size, code.data(),
+                   code.size(), symbols.data(), symbols.size(), program->debug_info.data(),
+                   program->debug_info.size());
 }
 
 void
@@ -308,8 +374,8 @@ aco_compile_rt_prolog(const struct aco_compiler_options* options,
    if (options->record_asm)
       disasm = get_disasm_string(program.get(), options->family, code, exec_size);
 
-   (*build_prolog)(binary, &config, NULL, 0, disasm.c_str(), disasm.size(), NULL, exec_size,
-                   code.data(), code.size(), NULL, 0, NULL, 0);
+   (*build_prolog)(binary, &config, NULL, 0, disasm.c_str(), disasm.size(), NULL, NULL,
+                   exec_size, code.data(), code.size(), NULL, 0, NULL, 0);
 }
 
 void
@@ -408,8 +474,43 @@ aco_compile_trap_handler(const struct aco_compiler_options* options,
    if (options->record_asm)
       disasm = get_disasm_string(program.get(), options->family, code, exec_size);
 
-   (*build_binary)(binary, &config, NULL, 0, disasm.c_str(), disasm.size(), NULL, exec_size,
-                   code.data(), code.size(), NULL, 0, NULL, 0);
+   (*build_binary)(binary, &config, NULL, 0, disasm.c_str(), disasm.size(), NULL, NULL,
+                   exec_size, code.data(), code.size(), NULL, 0, NULL, 0);
+}
+
+const char*
+aco_get_compile_pass_name(enum aco_compile_pass pass)
+{
+   switch (pass) {
+   case aco_compile_pass_isel: return "Instruction selection";
+   case aco_compile_pass_lower_phis: return "Phi lowering";
+   case aco_compile_pass_value_numbering: return "Value numbering";
+   case aco_compile_pass_optimizer: return "Optimizer";
+   case aco_compile_pass_exec_mask: return "Exec mask";
+   case aco_compile_pass_live_vars: return "Live variables";
+   case aco_compile_pass_spill: return "Spilling";
+   case aco_compile_pass_scheduler: return "Scheduler";
+   case aco_compile_pass_register_allocation: return "Register allocation";
+   case aco_compile_pass_optimizer_post_ra: return "Post-RA optimizer";
+   case aco_compile_pass_lower_to_hw: return "Lower to HW";
+   case aco_compile_pass_scheduler_ilp: return "ILP scheduler";
+   case aco_compile_pass_hazards: return "Waitcnt and hazards";
+   case aco_compile_pass_assembly: return "Assembly";
+   default: UNREACHABLE("invalid compile pass");
+   }
+}
+
+void
+aco_print_compile_stats(const struct aco_compile_stats* stats, FILE* output)
+{
+   uint64_t total_ns = 0;
+   for (unsigned i = 0; i < aco_num_compile_passes; i++) {
+      fprintf(output, "%-24s %10.3f ms %8" PRIu64 " KiB\n",
+              aco_get_compile_pass_name((enum aco_compile_pass)i), stats->time_ns[i] / 1000000.0,
+              stats->memory[i] / 1024);
+      total_ns += stats->time_ns[i];
+   }
+   fprintf(output, "%-24s %10.3f ms\n", "Total", total_ns / 1000000.0);
 }
 
 uint64_t
@@ -29,7 +29,8 @@ struct radeon_info;
 
 typedef void(aco_callback)(void** priv_ptr, const struct ac_shader_config* config,
                            const char* llvm_ir_str, unsigned llvm_ir_size, const char* disasm_str,
-                           unsigned disasm_size, struct amd_stats* stats, uint32_t exec_size,
+                           unsigned disasm_size, struct amd_stats* stats,
+                           const struct aco_compile_stats* compile_stats, uint32_t exec_size,
                            const uint32_t* code, uint32_t code_dw, const struct aco_symbol* symbols,
                            unsigned num_symbols, const struct ac_shader_debug_info* debug_info,
                            unsigned debug_info_count);
@@ -72,6 +73,10 @@ void aco_compile_trap_handler(const struct aco_compiler_options* options,
 
 uint64_t aco_get_codegen_flags();
 
+const char* aco_get_compile_pass_name(enum aco_compile_pass pass);
+
+void aco_print_compile_stats(const struct aco_compile_stats* stats, FILE* output);
+
 bool aco_is_gpu_supported(const struct radeon_info* info);
 
 void aco_print_asm(const struct radeon_info *info, unsigned wave_size,
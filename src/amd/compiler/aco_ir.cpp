@@ -1471,7 +1471,7 @@ get_tied_defs(Instruction* instr)
 }
 
 uint8_t
-get_vmem_type(Instruction* instr, bool has_point_sample_accel)
+get_vmem_type(const Instruction* instr, bool has_point_sample_accel)
 {
    if (instr->opcode == aco_opcode::image_bvh_intersect_ray ||
        instr->opcode == aco_opcode::image_bvh64_intersect_ray ||
@@ -2054,7 +2054,7 @@ enum vmem_type : uint8_t {
 /* VMEM instructions of the same type return in-order. For GFX12+, this determines which counter
  * is used.
  */
-uint8_t get_vmem_type(Instruction* instr, bool has_point_sample_accel);
+uint8_t get_vmem_type(const Instruction* instr, bool has_point_sample_accel);
 
 /* For all of the counters, the maximum value means no wait.
  * Some of the counters are larger than their bit field,
@@ -2312,6 +2312,11 @@ public:
    bool collect_statistics = false;
    amd_stats statistics;
 
+   /* Per-pass compile time and memory, only recorded if not NULL. */
+   aco_compile_stats* compile_stats = nullptr;
+   aco_compile_pass compile_pass = aco_num_compile_passes;
+   uint64_t compile_pass_start = 0;
+
    float_mode next_fp_mode;
    unsigned next_loop_depth = 0;
    unsigned next_divergent_if_logical_depth = 0;
@@ -2430,7 +2435,7 @@ void optimize_postRA(Program* program);
 void lower_branches(Program* program);
 void setup_reduce_temp(Program* program);
 void lower_to_cssa(Program* program);
-void register_allocation(Program* program, ra_test_policy = {});
+void register_allocation(Program* program, ra_test_policy = {}, bool fast_compile = false);
 void reindex_ssa(Program* program);
 void spill_preserved(Program* program);
 void ssa_elimination(Program* program);
@@ -2474,6 +2479,9 @@ struct Instruction_cycle_info {
 
 Instruction_cycle_info get_cycle_info(const Program& program, const Instruction& instr);
 
+/* Estimated latency until the result of a memory instruction is available, 0 for others. */
+unsigned get_mem_latency(const Program& program, const Instruction& instr);
+
 enum print_flags {
    print_no_ssa = 0x1,
    print_perf_info = 0x2,
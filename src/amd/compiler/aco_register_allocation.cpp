@@ -166,10 +166,14 @@ struct ra_ctx {
 
    ra_test_policy policy;
 
-   ra_ctx(Program* program_, ra_test_policy policy_)
+   /* Grow the register file rather than searching for live-range splits. */
+   bool fast_compile;
+
+   ra_ctx(Program* program_, ra_test_policy policy_, bool fast_compile_)
        : program(program_), assignments(program->peekAllocationId()),
          renames(program->blocks.size(), aco::unordered_map<uint32_t, Temp>(memory)),
-         orig_names(memory), vectors(memory), split_vectors(memory), policy(policy_)
+         orig_names(memory), vectors(memory), split_vectors(memory), policy(policy_),
+         fast_compile(fast_compile_)
    {
       pseudo_dummy.reset(create_instruction(aco_opcode::p_parallelcopy, Format::PSEUDO, 0, 0));
       phi_dummy.reset(create_instruction(aco_opcode::p_linear_phi, Format::PSEUDO, 0, 0));
@@ -2006,6 +2010,13 @@ get_reg(ra_ctx& ctx, const RegisterFile& reg_file, Temp temp,
 
       if (res)
          return *res;
+
+      /* get_reg_impl() tries every register window and moves the variables in it out of the way,
+       * which is what makes RA slow on huge shaders. When optimizations are disabled, use more
+       * registers instead, for as long as the wave count allows it.
+       */
+      if (ctx.fast_compile && increase_register_file(ctx, info.rc))
+         return get_reg(ctx, reg_file, temp, parallelcopies, instr, operand_index);
    }
 
    if (!ctx.policy.use_compact_relocate) {
@@ -3736,9 +3747,9 @@ handle_call(ra_ctx& ctx, aco_ptr<Instruction>& instr, BITSET_DECLARE(call_clobbe
 } /* end namespace */
 
 void
-register_allocation(Program* program, ra_test_policy policy)
+register_allocation(Program* program, ra_test_policy policy, bool fast_compile)
 {
-   ra_ctx ctx(program, policy);
+   ra_ctx ctx(program, policy, fast_compile);
    get_affinities(ctx);
 
    for (Block& block : program->blocks) {
@@ -360,25 +360,9 @@ get_cycle_info_with_mem_latency(const SchedILPContext& ctx, const Instruction* c
 {
    Instruction_cycle_info cycle_info = get_cycle_info(*ctx.program, *instr);
 
-   /* Based on get_wait_counter_info in aco_statistics.cpp. */
-   if (instr->isVMEM() || instr->isFlatLike()) {
-      cycle_info.latency = 320;
-   } else if (instr->isSMEM()) {
-      if (instr->operands.empty()) {
-         cycle_info.latency = 1;
-      } else if (instr->operands[0].size() == 2 ||
-                 (instr->operands[1].isConstant() &&
-                  (instr->operands.size() < 3 || instr->operands[2].isConstant()))) {
-         /* Likely cached. */
-         cycle_info.latency = 30;
-      } else {
-         cycle_info.latency = 200;
-      }
-   } else if (instr->isLDSDIR()) {
-      cycle_info.latency = 13;
-   } else if (instr->isDS()) {
-      cycle_info.latency = 20;
-   }
+   if (instr->isVMEM() || instr->isFlatLike() || instr->isSMEM() || instr->isLDSDIR() ||
+       instr->isDS())
+      cycle_info.latency = get_mem_latency(*ctx.program, *instr);
 
    return cycle_info;
 }
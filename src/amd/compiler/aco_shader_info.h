@@ -147,6 +147,7 @@ struct aco_compiler_options {
    bool record_asm;
    bool record_ir;
    bool record_stats;
+   bool record_compile_stats;
    bool has_ls_vgpr_init_bug;
    bool load_grid_size_from_user_sgpr;
    bool optimisations_disabled;
@@ -181,6 +182,33 @@ enum aco_statistic {
    aco_num_statistics
 };
 
+/* Groups of passes whose compile time and memory usage are recorded
+ * with aco_compiler_options::record_compile_stats.
+ */
+enum aco_compile_pass {
+   aco_compile_pass_isel,
+   aco_compile_pass_lower_phis,
+   aco_compile_pass_value_numbering,
+   aco_compile_pass_optimizer,
+   aco_compile_pass_exec_mask,
+   aco_compile_pass_live_vars,
+   aco_compile_pass_spill,
+   aco_compile_pass_scheduler,
+   aco_compile_pass_register_allocation,
+   aco_compile_pass_optimizer_post_ra,
+   aco_compile_pass_lower_to_hw,
+   aco_compile_pass_scheduler_ilp,
+   aco_compile_pass_hazards,
+   aco_compile_pass_assembly,
+   aco_num_compile_passes
+};
+
+struct aco_compile_stats {
+   uint64_t time_ns[aco_num_compile_passes];
+   /* Memory held by the IR arenas at the end of the pass, in bytes. */
+   uint64_t memory[aco_num_compile_passes];
+};
+
 enum aco_symbol_id {
    aco_symbol_invalid,
    aco_symbol_scratch_addr_lo,
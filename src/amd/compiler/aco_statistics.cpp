@@ -281,7 +281,7 @@ BlockCycleEstimator::cycles_until_res_available(aco_ptr<Instruction>& instr)
 }
 
 static std::array<unsigned, wait_type_num>
-get_wait_counter_info(Program* program, aco_ptr<Instruction>& instr)
+get_wait_counter_info(const Program* program, const Instruction* instr)
 {
    /* These numbers are all a bit nonsense. LDS/VMEM/SMEM/EXP performance
     * depends a lot on the situation. */
@@ -320,7 +320,7 @@ get_wait_counter_info(Program* program, aco_ptr<Instruction>& instr)
    } else if (instr->isVMEM() && instr->definitions.empty() && program->gfx_level >= GFX10) {
       info[wait_type_vs] = 320;
    } else if (instr->isVMEM()) {
-      uint8_t vm_type = get_vmem_type(instr.get(), program->dev.has_point_sample_accel);
+      uint8_t vm_type = get_vmem_type(instr, program->dev.has_point_sample_accel);
       wait_type type = wait_type_vm;
       if (program->gfx_level >= GFX12 && vm_type == vmem_bvh)
          type = wait_type_bvh;
@@ -346,7 +346,7 @@ get_wait_imm(Program* program, aco_ptr<Instruction>& instr)
          imm.exp = wait_imm::unset_counter;
    } else {
       /* If an instruction increases a counter, it waits for it to be below maximum first. */
-      std::array<unsigned, wait_type_num> wait_info = get_wait_counter_info(program, instr);
+      std::array<unsigned, wait_type_num> wait_info = get_wait_counter_info(program, instr.get());
       wait_imm max = wait_imm::max(program->gfx_level);
       for (unsigned i = 0; i < wait_type_num; i++) {
          if (wait_info[i])
@@ -435,7 +435,7 @@ BlockCycleEstimator::add(aco_ptr<Instruction>& instr)
          mem_ops[i].pop_front();
    }
 
-   std::array<unsigned, wait_type_num> wait_info = get_wait_counter_info(program, instr);
+   std::array<unsigned, wait_type_num> wait_info = get_wait_counter_info(program, instr.get());
    for (unsigned i = 0; i < wait_type_num; i++) {
       if (wait_info[i])
          mem_ops[i].push_back(cur_cycle + wait_info[i]);
@@ -663,4 +663,18 @@ get_cycle_info(const Program& program, const Instruction& instr)
    return Instruction_cycle_info{(unsigned)info.latency, std::max(info.cost0, info.cost1)};
 }
 
+unsigned
+get_mem_latency(const Program& program, const Instruction& instr)
+{
+   std::array<unsigned, wait_type_num> wait_info = get_wait_counter_info(&program, &instr);
+
+   unsigned latency = 0;
+   for (unsigned i = 0; i < wait_type_num; i++) {
+      /* Stores only increase vscnt, their result is never used. */
+      if (i != wait_type_vs)
+         latency = MAX2(latency, wait_info[i]);
+   }
+   return latency;
+}
+
 } // namespace aco
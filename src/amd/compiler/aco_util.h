@@ -288,6 +288,26 @@ public:
       return allocate(size, alignment);
    }
 
+   /* Replaces the initial buffer with one of at least the given size, if nothing has been
+    * allocated yet. Avoids growing through a chain of buffers when the size is known upfront.
+    */
+   void reserve(size_t size)
+   {
+      size = MIN2(size, UINT32_MAX - sizeof(Buffer));
+      if (buffer->next || buffer->current_idx || buffer->data_size >= size)
+         return;
+
+      Buffer* next = (Buffer*)malloc(size + sizeof(Buffer));
+      if (!next)
+         return;
+
+      free(buffer);
+      buffer = next;
+      buffer->next = nullptr;
+      buffer->data_size = size;
+      buffer->current_idx = 0;
+   }
+
    void release()
    {
       while (buffer->next) {
@@ -300,6 +320,15 @@ public:
 
    bool operator==(const monotonic_buffer_resource& other) const { return buffer == other.buffer; }
 
+   /* Total size of the buffers allocated so far. */
+   size_t allocated_size() const
+   {
+      size_t size = 0;
+      for (Buffer* buf = buffer; buf; buf = buf->next)
+         size += buf->data_size + sizeof(Buffer);
+      return size;
+   }
+
 private:
    struct Buffer {
       Buffer* next;
@@ -1217,6 +1217,16 @@ sqtt_CmdExecuteGeneratedCommandsEXT(VkCommandBuffer commandBuffer, VkBool32 isPr
                     pGeneratedCommandsInfo);
 }
 
+VKAPI_ATTR void VKAPI_CALL
+sqtt_CmdPreprocessGeneratedCommandsEXT(VkCommandBuffer commandBuffer,
+                                       const VkGeneratedCommandsInfoEXT *pGeneratedCommandsInfo,
+                                       VkCommandBuffer stateCommandBuffer)
+{
+   /* Same as above, this makes the preprocess dispatch show up separately from the execution. */
+   API_MARKER_ALIAS(PreprocessGeneratedCommandsEXT, ExecuteCommands, commandBuffer, pGeneratedCommandsInfo,
+                    stateCommandBuffer);
+}
+
 VKAPI_ATTR void VKAPI_CALL
 sqtt_CmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t viewportCount,
                     const VkViewport *pViewports)
@@ -74,6 +74,7 @@ enum {
    RADV_DEBUG_NO_BO_LIST = 1ull << 59,
    RADV_DEBUG_DUMP_IBS = 1ull << 60,
    RADV_DEBUG_VM = 1ull << 61,
+   RADV_DEBUG_COMPILE_TIME = 1ull << 62,
    RADV_DEBUG_DUMP_SHADERS = RADV_DEBUG_DUMP_VS | RADV_DEBUG_DUMP_TCS | RADV_DEBUG_DUMP_TES | RADV_DEBUG_DUMP_GS |
                              RADV_DEBUG_DUMP_PS | RADV_DEBUG_DUMP_TASK | RADV_DEBUG_DUMP_MESH | RADV_DEBUG_DUMP_CS |
                              RADV_DEBUG_DUMP_NIR | RADV_DEBUG_DUMP_ASM | RADV_DEBUG_DUMP_BACKEND_IR,
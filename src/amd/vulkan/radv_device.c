@@ -1132,6 +1132,9 @@ radv_destroy_device(struct radv_device *device, const VkAllocationCallbacks *pAl
    simple_mtx_destroy(&device->rt_handles_mtx);
    simple_mtx_destroy(&device->pso_cache_stats_mtx);
    simple_mtx_destroy(&device->blit_queue_mtx);
+   if (util_queue_is_initialized(&device->pipeline_compile_queue))
+      util_queue_destroy(&device->pipeline_compile_queue);
+   simple_mtx_destroy(&device->pipeline_compile_queue_mtx);
 
    radv_destroy_shader_arenas(device);
    if (device->capture_replay_arena_vas)
@@ -1190,6 +1193,7 @@ radv_CreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo *pCr
    simple_mtx_init(&device->rt_handles_mtx, mtx_plain);
    simple_mtx_init(&device->pso_cache_stats_mtx, mtx_plain);
    simple_mtx_init(&device->blit_queue_mtx, mtx_plain);
+   simple_mtx_init(&device->pipeline_compile_queue_mtx, mtx_plain);
 
    device->rt_handles = _mesa_hash_table_create(NULL, _mesa_hash_u32, _mesa_key_u32_equal);
 
@@ -17,6 +17,7 @@
 
 #include "util/bitset.h"
 #include "util/mesa-blake3.h"
+#include "util/u_queue.h"
 
 #include "radv_debug_nir.h"
 #include "radv_pipeline.h"
@@ -311,6 +312,10 @@ struct radv_device {
 
    simple_mtx_t blit_queue_mtx;
 
+   /* Compiles the pipelines of a single vkCreate*Pipelines call in parallel, created on first use. */
+   simple_mtx_t pipeline_compile_queue_mtx;
+   struct util_queue pipeline_compile_queue;
+
    struct radv_address_binding_tracker *addr_binding_tracker;
 };
 
@@ -90,6 +90,7 @@ static const struct debug_control radv_debug_options[] = {
    {"nobolist", RADV_DEBUG_NO_BO_LIST},
    {"dumpibs", RADV_DEBUG_DUMP_IBS},
    {"vm", RADV_DEBUG_VM},
+   {"compiletime", RADV_DEBUG_COMPILE_TIME},
    {NULL, 0},
 };
 
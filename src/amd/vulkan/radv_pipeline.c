@@ -16,6 +16,7 @@
 #include "util/disk_cache.h"
 #include "util/os_time.h"
 #include "util/u_atomic.h"
+#include "util/u_cpu_detect.h"
 #include "radv_cs.h"
 #include "radv_debug.h"
 #include "radv_descriptors.h"
@@ -53,7 +54,7 @@ radv_pipeline_capture_shader_stats(const struct radv_device *device, VkPipelineC
 
    /* Capture shader statistics when RGP is enabled to correlate shader hashes with Fossilize. */
    return (flags & VK_PIPELINE_CREATE_2_CAPTURE_STATISTICS_BIT_KHR) ||
-          (instance->debug_flags & (RADV_DEBUG_DUMP_SHADER_STATS | RADV_DEBUG_PSO_HISTORY)) ||
+          (instance->debug_flags & (RADV_DEBUG_DUMP_SHADER_STATS | RADV_DEBUG_PSO_HISTORY | RADV_DEBUG_COMPILE_TIME)) ||
           device->keep_shader_info || (instance->vk.trace_mode & RADV_TRACE_MODE_RGP);
 }
 
@@ -82,6 +83,94 @@ radv_pipeline_init(struct radv_device *device, struct radv_pipeline *pipeline, e
    pipeline->type = type;
 }
 
+struct radv_pipeline_create_job {
+   radv_pipeline_create_cb create;
+   void *data;
+   uint32_t index;
+   VkResult result;
+   struct util_queue_fence fence;
+};
+
+static void
+radv_pipeline_create_job_execute(void *data, void *gdata, int thread_index)
+{
+   struct radv_pipeline_create_job *job = data;
+
+   job->result = job->create(job->data, job->index);
+}
+
+static struct util_queue *
+radv_get_pipeline_compile_queue(struct radv_device *device)
+{
+   struct util_queue *queue = &device->pipeline_compile_queue;
+
+   simple_mtx_lock(&device->pipeline_compile_queue_mtx);
+   if (!util_queue_is_initialized(queue)) {
+      const unsigned num_threads = MIN2(util_get_cpu_caps()->nr_cpus, 16);
+
+      if (num_threads < 2 ||
+          !util_queue_init(queue, "radv_pso", 64, num_threads, UTIL_QUEUE_INIT_RESIZE_IF_FULL, NULL))
+         queue = NULL;
+   }
+   simple_mtx_unlock(&device->pipeline_compile_queue_mtx);
+
+   return queue;
+}
+
+/**
+ * Calls create() for all pipelines of a vkCreate*Pipelines call on the device's compile threads, and stores the
+ * results. Returns false without creating anything when the pipelines have to be created on the calling thread.
+ */
+bool
+radv_create_pipelines_parallel(struct radv_device *device, VkPipelineCache pipelineCache, uint32_t count,
+                               const VkAllocationCallbacks *pAllocator, radv_pipeline_create_cb create, void *data,
+                               VkResult *results)
+{
+   VK_FROM_HANDLE(vk_pipeline_cache, cache, pipelineCache);
+   const struct radv_physical_device *pdev = radv_device_physical(device);
+   const struct radv_instance *instance = radv_physical_device_instance(pdev);
+
+   if (count < 2)
+      return false;
+
+   /* Applications' allocators may only be called from the thread calling the command. */
+   if (pAllocator || device->vk.alloc.pfnAllocation != vk_default_allocator()->pfnAllocation)
+      return false;
+
+   /* The application synchronizes accesses to the cache, which can't be used concurrently. */
+   if (cache && (cache->flags & VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT))
+      return false;
+
+   /* Keep shader dumps readable. */
+   if (instance->debug_flags & RADV_DEBUG_DUMP_SHADERS)
+      return false;
+
+   struct util_queue *queue = radv_get_pipeline_compile_queue(device);
+   if (!queue)
+      return false;
+
+   struct radv_pipeline_create_job *jobs = malloc(count * sizeof(*jobs));
+   if (!jobs)
+      return false;
+
+   for (uint32_t i = 0; i < count; i++) {
+      jobs[i].create = create;
+      jobs[i].data = data;
+      jobs[i].index = i;
+      util_queue_fence_init(&jobs[i].fence);
+      util_queue_add_job(queue, &jobs[i], &jobs[i].fence, radv_pipeline_create_job_execute, NULL, 0);
+   }
+
+   for (uint32_t i = 0; i < count; i++) {
+      util_queue_fence_wait(&jobs[i].fence);
+      util_queue_fence_destroy(&jobs[i].fence);
+      results[i] = jobs[i].result;
+   }
+
+   free(jobs);
+   return true;
+}
+
 void
 radv_pipeline_destroy(struct radv_device *device, struct radv_pipeline *pipeline,
                       const VkAllocationCallbacks *allocator)
@@ -943,6 +1032,21 @@ radv_GetPipelineExecutableStatisticsKHR(VkDevice _device, const VkPipelineExecut
 
    vk_add_amd_stats(out, &stats);
 
+   if (shader->compile_stats) {
+      for (unsigned i = 0; i < aco_num_compile_passes; i++) {
+         char name[VK_MAX_DESCRIPTION_SIZE];
+         snprintf(name, sizeof(name), "%s time", aco_get_compile_pass_name(i));
+         vk_add_exec_statistic_u64(out, name, "Time spent in this group of ACO passes, in nanoseconds",
+                                   shader->compile_stats->time_ns[i]);
+      }
+      for (unsigned i = 0; i < aco_num_compile_passes; i++) {
+         char name[VK_MAX_DESCRIPTION_SIZE];
+         snprintf(name, sizeof(name), "%s memory", aco_get_compile_pass_name(i));
+         vk_add_exec_statistic_u64(out, name, "Memory held by the ACO IR after this group of passes, in bytes",
+                                   shader->compile_stats->memory[i]);
+      }
+   }
+
    return vk_outarray_status(&out);
 }
 
@@ -77,6 +77,12 @@ bool radv_pipeline_skip_shaders_cache(const struct radv_device *device, const st
 
 void radv_pipeline_init(struct radv_device *device, struct radv_pipeline *pipeline, enum radv_pipeline_type type);
 
+typedef VkResult (*radv_pipeline_create_cb)(void *data, uint32_t index);
+
+bool radv_create_pipelines_parallel(struct radv_device *device, VkPipelineCache pipelineCache, uint32_t count,
+                                    const VkAllocationCallbacks *pAllocator, radv_pipeline_create_cb create,
+                                    void *data, VkResult *results);
+
 void radv_pipeline_destroy(struct radv_device *device, struct radv_pipeline *pipeline,
                            const VkAllocationCallbacks *allocator);
 
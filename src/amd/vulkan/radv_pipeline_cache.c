@@ -68,13 +68,14 @@ radv_shader_deserialize(struct radv_device *device, const void *key_data, size_t
 {
    const struct radv_shader_binary *binary = blob_read_bytes(blob, sizeof(struct radv_shader_binary));
 
+   /* The cache key is the hash of the binary, no need to compute it again. */
+   assert(key_size == sizeof(blake3_hash));
+
    struct radv_shader *shader;
-   radv_shader_create_uncached(device, binary, false, NULL, &shader);
+   radv_shader_create_uncached(device, binary, false, NULL, (const blake3_hash *)key_data, &shader);
    if (!shader)
       return NULL;
 
-   assert(key_size == sizeof(shader->hash));
-   memcpy(shader->hash, key_data, key_size);
    blob_skip_bytes(blob, binary->total_size - sizeof(struct radv_shader_binary));
 
    return shader;
@@ -166,7 +167,7 @@ radv_shader_create(struct radv_device *device, struct vk_pipeline_cache *cache,
 {
    if (radv_is_cache_disabled(device, cache) || skip_cache) {
       struct radv_shader *shader;
-      radv_shader_create_uncached(device, binary, false, NULL, &shader);
+      radv_shader_create_uncached(device, binary, false, NULL, NULL, &shader);
       return shader;
    }
 
@@ -17,9 +17,11 @@
 #include "util/disk_cache.h"
 #include "util/mesa-sha1.h"
 #include "util/os_time.h"
+#include "util/stack_array.h"
 #include "util/u_atomic.h"
 #include "radv_cs.h"
 #include "radv_debug.h"
+#include "radv_entrypoints.h"
 #include "radv_pipeline_binary.h"
 #include "radv_pipeline_cache.h"
 #include "radv_rmv.h"
@@ -313,20 +315,53 @@ radv_compute_pipeline_create(VkDevice _device, VkPipelineCache _cache, const VkC
    return VK_SUCCESS;
 }
 
+static struct radv_compute_pipelines_create_info {
+   VkDevice device;
+   VkPipelineCache cache;
+   const VkComputePipelineCreateInfo *create_infos;
+   const VkAllocationCallbacks *alloc;
+   VkPipeline *pipelines;
+};
+
 static VkResult
+radv_create_compute_pipeline_index(void *data, uint32_t index)
+{
+   const struct radv_compute_pipelines_create_info *info = data;
+   VkResult result;
+
+   result = radv_compute_pipeline_create(info->device, info->cache, &info->create_infos[index], info->alloc,
+                                         &info->pipelines[index]);
+   if (result != VK_SUCCESS)
+      info->pipelines[index] = VK_NULL_HANDLE;
+
+   return result;
+}
+
+VkResult
 radv_create_compute_pipelines(VkDevice _device, VkPipelineCache pipelineCache, uint32_t count,
                               const VkComputePipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                               VkPipeline *pPipelines)
 {
+   VK_FROM_HANDLE(radv_device, device, _device);
+   const struct radv_compute_pipelines_create_info info = {
+      .device = _device,
+      .cache = pipelineCache,
+      .create_infos = pCreateInfos,
+      .alloc = pAllocator,
+      .pipelines = pPipelines,
+   };
    VkResult result = VK_SUCCESS;
 
+   STACK_ARRAY(VkResult, results, count);
+   const bool parallel = results && radv_create_pipelines_parallel(device, pipelineCache, count, pAllocator,
+                                                                   radv_create_compute_pipeline_index,
+                                                                   (void *)&info, results);
+
    unsigned i = 0;
    for (; i < count; i++) {
-      VkResult r;
-      r = radv_compute_pipeline_create(_device, pipelineCache, &pCreateInfos[i], pAllocator, &pPipelines[i]);
+      VkResult r = parallel ? results[i] : radv_create_compute_pipeline_index((void *)&info, i);
       if (r != VK_SUCCESS) {
          result = r;
-         pPipelines[i] = VK_NULL_HANDLE;
 
          VkPipelineCreateFlagBits2 create_flags = vk_compute_pipeline_create_flags(&pCreateInfos[i]);
          if (create_flags & VK_PIPELINE_CREATE_2_EARLY_RETURN_ON_FAILURE_BIT)
@@ -334,8 +369,14 @@ radv_create_compute_pipelines(VkDevice _device, VkPipelineCache pipelineCache, u
       }
    }
 
-   for (; i < count; ++i)
+   for (; i < count; ++i) {
+      /* Pipelines after an early return were still created when compiling in parallel. */
+      if (parallel)
+         radv_DestroyPipeline(_device, pPipelines[i], NULL);
       pPipelines[i] = VK_NULL_HANDLE;
+   }
+
+   STACK_ARRAY_FINISH(results);
 
    return result;
 }
@@ -18,6 +18,7 @@
 #include "util/disk_cache.h"
 #include "util/mesa-sha1.h"
 #include "util/os_time.h"
+#include "util/stack_array.h"
 #include "util/u_atomic.h"
 #include "radv_cs.h"
 #include "radv_debug.h"
@@ -3697,33 +3698,75 @@ radv_destroy_graphics_lib_pipeline(struct radv_device *device, struct radv_graph
    radv_destroy_graphics_pipeline(device, &pipeline->base);
 }
 
+struct radv_graphics_pipelines_create_info {
+   VkDevice device;
+   VkPipelineCache cache;
+   const VkGraphicsPipelineCreateInfo *create_infos;
+   const VkAllocationCallbacks *alloc;
+   VkPipeline *pipelines;
+};
+
+static VkResult
+radv_create_graphics_pipeline_index(void *data, uint32_t index)
+{
+   const struct radv_graphics_pipelines_create_info *info = data;
+   const VkGraphicsPipelineCreateInfo *pCreateInfo = &info->create_infos[index];
+   const VkPipelineCreateFlagBits2 create_flags = vk_graphics_pipeline_create_flags(pCreateInfo);
+   VkResult result;
+
+   if (create_flags & VK_PIPELINE_CREATE_2_LIBRARY_BIT_KHR) {
+      result =
+         radv_graphics_lib_pipeline_create(info->device, info->cache, pCreateInfo, info->alloc, &info->pipelines[index]);
+   } else {
+      result = radv_graphics_pipeline_create(info->device, info->cache, pCreateInfo, info->alloc, &info->pipelines[index]);
+   }
+
+   if (result != VK_SUCCESS)
+      info->pipelines[index] = VK_NULL_HANDLE;
+
+   return result;
+}
+
 VKAPI_ATTR VkResult VKAPI_CALL
 radv_CreateGraphicsPipelines(VkDevice _device, VkPipelineCache pipelineCache, uint32_t count,
                              const VkGraphicsPipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
                              VkPipeline *pPipelines)
 {
+   VK_FROM_HANDLE(radv_device, device, _device);
+   const struct radv_graphics_pipelines_create_info info = {
+      .device = _device,
+      .cache = pipelineCache,
+      .create_infos = pCreateInfos,
+      .alloc = pAllocator,
+      .pipelines = pPipelines,
+   };
    VkResult result = VK_SUCCESS;
    unsigned i = 0;
 
+   STACK_ARRAY(VkResult, results, count);
+   const bool parallel = results && radv_create_pipelines_parallel(device, pipelineCache, count, pAllocator,
+                                                                   radv_create_graphics_pipeline_index,
+                                                                   (void *)&info, results);
+
    for (; i < count; i++) {
       const VkPipelineCreateFlagBits2 create_flags = vk_graphics_pipeline_create_flags(&pCreateInfos[i]);
-      VkResult r;
-      if (create_flags & VK_PIPELINE_CREATE_2_LIBRARY_BIT_KHR) {
-         r = radv_graphics_lib_pipeline_create(_device, pipelineCache, &pCreateInfos[i], pAllocator, &pPipelines[i]);
-      } else {
-         r = radv_graphics_pipeline_create(_device, pipelineCache, &pCreateInfos[i], pAllocator, &pPipelines[i]);
-      }
+      VkResult r = parallel ? results[i] : radv_create_graphics_pipeline_index((void *)&info, i);
       if (r != VK_SUCCESS) {
          result = r;
-         pPipelines[i] = VK_NULL_HANDLE;
 
          if (create_flags & VK_PIPELINE_CREATE_2_EARLY_RETURN_ON_FAILURE_BIT)
             break;
       }
    }
 
-   for (; i < count; ++i)
+   for (; i < count; ++i) {
+      /* Pipelines after an early return were still created when compiling in parallel. */
+      if (parallel)
+         radv_DestroyPipeline(_device, pPipelines[i], NULL);
       pPipelines[i] = VK_NULL_HANDLE;
+   }
+
+   STACK_ARRAY_FINISH(results);
 
    return result;
 }
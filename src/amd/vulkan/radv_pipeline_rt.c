@@ -480,7 +480,7 @@ radv_rt_nir_to_asm(struct radv_device *device, struct vk_pipeline_cache *cache,
 
    struct radv_shader *shader;
    if (replay_block || replayable) {
-      VkResult result = radv_shader_create_uncached(device, binary, replayable, replay_block, &shader);
+      VkResult result = radv_shader_create_uncached(device, binary, replayable, replay_block, NULL, &shader);
       if (result != VK_SUCCESS) {
          if (dump_shader)
             simple_mtx_unlock(&instance->shader_dump_mtx);
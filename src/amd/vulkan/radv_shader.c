@@ -65,7 +65,8 @@ get_nir_options_for_stage(struct radv_physical_device *pdev, mesa_shader_stage s
    options->max_unroll_iterations = 32;
    options->max_unroll_iterations_aggressive = 128;
    options->lower_doubles_options = nir_lower_drcp | nir_lower_dsqrt | nir_lower_drsq | nir_lower_ddiv;
-   options->io_options |= nir_io_mediump_is_32bit | nir_io_radv_intrinsic_component_workaround;
+   options->io_options |= nir_io_mediump_is_32bit | nir_io_radv_intrinsic_component_workaround |
+                          nir_io_can_move_push_constants;
    options->varying_expression_max_cost = ac_nir_varying_expression_max_cost;
 }
 
@@ -2821,9 +2822,11 @@ radv_get_max_scratch_waves(const struct radv_device *device, struct radv_shader
    return MIN2(device->scratch_waves, 4 * num_cu * shader->max_waves);
 }
 
+/* hash is the BLAKE3 of the binary when the caller already knows it (e.g. the pipeline cache key), or NULL. */
 VkResult
 radv_shader_create_uncached(struct radv_device *device, const struct radv_shader_binary *binary, bool replayable,
-                            struct radv_serialized_shader_arena_block *replay_block, struct radv_shader **out_shader)
+                            struct radv_serialized_shader_arena_block *replay_block, const blake3_hash *hash,
+                            struct radv_shader **out_shader)
 {
    VkResult result = VK_SUCCESS;
    struct radv_shader *shader = calloc(1, sizeof(struct radv_shader));
@@ -2833,7 +2836,10 @@ radv_shader_create_uncached(struct radv_device *device, const struct radv_shader
    }
    simple_mtx_init(&shader->replay_mtx, mtx_plain);
 
-   _mesa_blake3_compute(binary, binary->total_size, shader->hash);
+   if (hash)
+      memcpy(shader->hash, *hash, sizeof(shader->hash));
+   else
+      _mesa_blake3_compute(binary, binary->total_size, shader->hash);
 
    vk_pipeline_cache_object_init(&device->vk, &shader->base, &radv_shader_ops, shader->hash, sizeof(shader->hash));
 
@@ -2880,6 +2886,9 @@ radv_shader_create_uncached(struct radv_device *device, const struct radv_shader
       if (bin->stats_size) {
          shader->statistics = calloc(bin->stats_size, 1);
          memcpy(shader->statistics, layout.stats, bin->stats_size);
+
+         if (bin->stats_size > sizeof(struct amd_stats))
+            shader->compile_stats = (struct aco_compile_stats *)(shader->statistics + 1);
       }
 
       shader->ir_string = bin->ir_size ? strdup(layout.ir) : NULL;
@@ -3066,17 +3075,19 @@ radv_shader_part_cache_get(struct radv_device *device, struct radv_shader_part_c
       return radv_shader_part_from_cache_entry(local->key);
 
    simple_mtx_lock(&cache->lock);
-   global = _mesa_set_search_or_add_pre_hashed(&cache->entries, hash, key, &global_found);
-   if (global_found) {
-      simple_mtx_unlock(&cache->lock);
-      local->key = global->key;
-      return radv_shader_part_from_cache_entry(global->key);
+   global = _mesa_set_search_pre_hashed(&cache->entries, hash, key);
+   const void *global_key = global ? global->key : NULL;
+   simple_mtx_unlock(&cache->lock);
+   if (global_key) {
+      local->key = global_key;
+      return radv_shader_part_from_cache_entry(global_key);
    }
 
+   /* Compile without holding the lock, so that a miss doesn't stall every
+    * other command buffer looking up a prolog or epilog at the same time.
+    */
    struct radv_shader_part *shader_part = cache->ops->create(device, key);
    if (!shader_part) {
-      _mesa_set_remove(&cache->entries, global);
-      simple_mtx_unlock(&cache->lock);
       _mesa_set_remove(local_entries, local);
       return NULL;
    }
@@ -3084,8 +3095,17 @@ radv_shader_part_cache_get(struct radv_device *device, struct radv_shader_part_c
    /* Make the set entry a pointer to the key, so that the hash and equals
     * functions from radv_shader_part_cache_ops can be directly used.
     */
-   global->key = &shader_part->key;
+   simple_mtx_lock(&cache->lock);
+   global = _mesa_set_search_or_add_pre_hashed(&cache->entries, hash, &shader_part->key, &global_found);
+   global_key = global->key;
    simple_mtx_unlock(&cache->lock);
+
+   /* Another thread created the same one in the meantime. */
+   if (global_found) {
+      radv_shader_part_unref(device, shader_part);
+      shader_part = radv_shader_part_from_cache_entry(global_key);
+   }
+
    local->key = &shader_part->key;
    return shader_part;
 }
@@ -3152,7 +3172,8 @@ radv_dump_nir_shaders(const struct radv_instance *instance, struct nir_shader *c
 static void
 radv_aco_build_shader_binary(void **bin, const struct ac_shader_config *config, const char *llvm_ir_str,
                              unsigned llvm_ir_size, const char *disasm_str, unsigned disasm_size,
-                             struct amd_stats *statistics, uint32_t exec_size, const uint32_t *code, uint32_t code_dw,
+                             struct amd_stats *statistics, const struct aco_compile_stats *compile_stats,
+                             uint32_t exec_size, const uint32_t *code, uint32_t code_dw,
                              const struct aco_symbol *symbols, unsigned num_symbols,
                              const struct ac_shader_debug_info *debug_info, unsigned debug_info_count)
 {
@@ -3161,6 +3182,10 @@ radv_aco_build_shader_binary(void **bin, const struct ac_shader_config *config,
    uint32_t debug_info_size = debug_info_count * sizeof(struct ac_shader_debug_info);
    uint32_t stats_size = statistics ? sizeof(struct amd_stats) : 0;
 
+   /* Compile stats are stored after the statistics and aren't kept in the cache. */
+   if (statistics && compile_stats)
+      stats_size += sizeof(struct aco_compile_stats);
+
    size_t size = llvm_ir_size;
 
    size += debug_info_size;
@@ -3188,6 +3213,8 @@ radv_aco_build_shader_binary(void **bin, const struct ac_shader_config *config,
 
    if (stats_size)
       amd_stats_serialize(layout.stats, statistics);
+   if (stats_size > sizeof(struct amd_stats))
+      memcpy((uint8_t *)layout.stats + sizeof(struct amd_stats), compile_stats, sizeof(struct aco_compile_stats));
 
    memcpy(layout.code, code, code_dw * sizeof(uint32_t));
 
@@ -3222,6 +3249,7 @@ radv_fill_nir_compiler_options(struct radv_nir_compiler_options *options, struct
    options->record_asm = keep_shader_info || options->dump_shader;
    options->record_ir = keep_shader_info;
    options->record_stats = keep_statistic_info;
+   options->record_compile_stats = keep_statistic_info && (instance->debug_flags & RADV_DEBUG_COMPILE_TIME);
    options->check_ir = instance->debug_flags & RADV_DEBUG_CHECKIR;
    options->enable_mrt_output_nan_fixup = gfx_state ? gfx_state->ps.epilog.enable_mrt_output_nan_fixup : false;
 }
@@ -3272,6 +3300,14 @@ shader_compile(struct radv_device *device, struct nir_shader *const *shaders, in
       radv_aco_convert_shader_info(&ac_info, info, args, &device->cache_key, options->info->gfx_level);
       aco_compile_shader(&ac_opts, &ac_info, shader_count, shaders, &args->ac, &radv_aco_build_shader_binary,
                          (void **)&binary);
+
+      struct radv_shader_binary_legacy *legacy_binary = (struct radv_shader_binary_legacy *)binary;
+      if (legacy_binary->stats_size > sizeof(struct amd_stats)) {
+         struct radv_shader_binary_layout layout = radv_shader_binary_get_layout(legacy_binary);
+         fprintf(stderr, "ACO compile time of the %s shader:\n", radv_get_shader_name(info, stage));
+         aco_print_compile_stats((const struct aco_compile_stats *)((uint8_t *)layout.stats + sizeof(struct amd_stats)),
+                                 stderr);
+      }
    }
 
    binary->info = *info;
@@ -3367,7 +3403,7 @@ radv_create_trap_handler_shader(struct radv_device *device)
    radv_postprocess_binary_config(device, binary, &args);
 
    struct radv_shader *shader;
-   radv_shader_create_uncached(device, binary, false, NULL, &shader);
+   radv_shader_create_uncached(device, binary, false, NULL, NULL, &shader);
 
    if (options.dump_shader) {
       fprintf(stderr, "Trap handler");
@@ -3452,7 +3488,7 @@ radv_create_rt_prolog(struct radv_device *device)
    binary->info = info;
 
    radv_postprocess_binary_config(device, binary, &in_args);
-   radv_shader_create_uncached(device, binary, false, NULL, &prolog);
+   radv_shader_create_uncached(device, binary, false, NULL, NULL, &prolog);
    if (!prolog)
       goto done;
 
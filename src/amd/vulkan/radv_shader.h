@@ -190,6 +190,7 @@ struct radv_nir_compiler_options {
    bool record_asm;
    bool record_ir;
    bool record_stats;
+   bool record_compile_stats;
    bool check_ir;
    uint8_t enable_mrt_output_nan_fixup;
    bool wgp_mode;
@@ -435,6 +436,7 @@ struct radv_shader {
    char *disasm_string;
    char *ir_string;
    struct amd_stats *statistics;
+   struct aco_compile_stats *compile_stats; /* points past statistics, RADV_DEBUG=compiletime only */
    struct ac_shader_debug_info *debug_info;
    uint32_t debug_info_count;
 };
@@ -510,7 +512,7 @@ struct radv_shader_args;
 
 VkResult radv_shader_create_uncached(struct radv_device *device, const struct radv_shader_binary *binary,
                                      bool replayable, struct radv_serialized_shader_arena_block *replay_block,
-                                     struct radv_shader **out_shader);
+                                     const blake3_hash *hash, struct radv_shader **out_shader);
 
 struct radv_shader_binary *radv_shader_nir_to_asm(struct radv_device *device, struct radv_shader_stage *pl_stage,
                                                   struct nir_shader *const *shaders, int shader_count,
@@ -43,29 +43,11 @@ def_size(nir_def *def, unsigned *size, unsigned *align,
 static bool
 all_uses_float(nir_def *def)
 {
-   nir_foreach_use_including_if(use, def) {
-      if (nir_src_is_if(use))
-         return false;
-
-      nir_instr *use_instr = nir_src_parent_instr(use);
-      if (use_instr->type != nir_instr_type_alu)
-         return false;
-
-      nir_alu_instr *use_alu = nir_instr_as_alu(use_instr);
-      unsigned src_index = ~0;
-      for (unsigned i = 0; i < nir_op_infos[use_alu->op].num_inputs; i++) {
-         if (&use_alu->src[i].src == use) {
-            src_index = i;
-            break;
-         }
-      }
-
-      assert(src_index != ~0);
-      nir_alu_type src_type = nir_alu_type_get_base_type(
-         nir_op_infos[use_alu->op].input_types[src_index]);
+   if (!nir_def_all_uses_are_float_alu_srcs(def, ~0u))
+      return false;
 
-      if (src_type != nir_type_float)
-         return false;
+   nir_foreach_use(use, def) {
+      nir_alu_instr *use_alu = nir_instr_as_alu(nir_src_parent_instr(use));
 
       /* No float modifiers on G13 */
       if (use_alu->op == nir_op_fmax || use_alu->op == nir_op_fmin)
@@ -1141,6 +1141,7 @@ uint64_t *v3d_compile(const struct v3d_compiler *compiler,
                                            void *debug_output_data),
                       void *debug_output_data,
                       int program_id, int variant_id,
+                      uint32_t first_strategy_idx,
                       uint32_t *final_assembly_size);
 
 uint32_t v3d_prog_data_size(mesa_shader_stage stage);
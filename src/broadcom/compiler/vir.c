@@ -2070,6 +2070,14 @@ set_best_compile(struct v3d_compile **best, struct v3d_compile *c)
    *best = c;
 }
 
+/**
+ * Compiles the shader, trying the strategies in order until one allocates
+ * registers well enough.
+ *
+ * first_strategy_idx lets the caller start further down the list, when it
+ * knows from earlier compiles of the same shader (prog_data's
+ * compile_strategy_idx) that the first strategies are going to fail anyway.
+ */
 uint64_t *v3d_compile(const struct v3d_compiler *compiler,
                       struct v3d_key *key,
                       struct v3d_prog_data **out_prog_data,
@@ -2078,6 +2086,7 @@ uint64_t *v3d_compile(const struct v3d_compiler *compiler,
                                            void *debug_output_data),
                       void *debug_output_data,
                       int program_id, int variant_id,
+                      uint32_t first_strategy_idx,
                       uint32_t *final_assembly_size)
 {
         struct v3d_compile *c = NULL;
@@ -2086,10 +2095,13 @@ uint64_t *v3d_compile(const struct v3d_compiler *compiler,
 
         MESA_TRACE_FUNC();
 
-        for (int32_t strat = 0; strat < ARRAY_SIZE(strategies); strat++) {
+        first_strategy_idx = MIN2(first_strategy_idx,
+                                  ARRAY_SIZE(strategies) - 1);
+
+        for (int32_t strat = first_strategy_idx;
+             strat < ARRAY_SIZE(strategies); strat++) {
                 /* Fallback strategy */
-                if (strat > 0) {
-                        assert(c);
+                if (c) {
                         if (skip_compile_strategy(c, strat))
                                 continue;
 
@@ -727,6 +727,11 @@ struct nir_link_uniforms_state {
    struct type_tree_entry *current_type;
    struct hash_table *referenced_uniforms[MESA_SHADER_MESH_STAGES];
    struct hash_table *uniform_hash;
+
+   /* SPIR-V only: explicit location -> index + 1 of the first entry in
+    * UniformStorage with that location.
+    */
+   struct hash_table_u64 *location_hash;
 };
 
 static void
@@ -1164,21 +1169,17 @@ find_and_update_previous_uniform_storage(const struct gl_constants *consts,
    if (var->data.location == -1)
       return false;
 
-   /* TODO: following search can be problematic with shaders with a lot of
-    * uniforms. Would it be better to use some type of hash
-    */
-   for (unsigned i = 0; i < prog->data->NumUniformStorage; i++) {
-      if (prog->data->UniformStorage[i].remap_location == var->data.location) {
-         mark_stage_as_active(&prog->data->UniformStorage[i], stage);
+   uintptr_t index = (uintptr_t)
+      _mesa_hash_table_u64_search(state->location_hash, var->data.location);
+   if (!index)
+      return false;
 
-         struct gl_uniform_storage *uniform = &prog->data->UniformStorage[i];
-         var->data.location = uniform - prog->data->UniformStorage;
-         add_parameter(uniform, consts, prog, var->type, state);
-         return true;
-      }
-   }
+   struct gl_uniform_storage *uniform = &prog->data->UniformStorage[index - 1];
+   mark_stage_as_active(uniform, stage);
 
-   return false;
+   var->data.location = uniform - prog->data->UniformStorage;
+   add_parameter(uniform, consts, prog, var->type, state);
+   return true;
 }
 
 static struct type_tree_entry *
@@ -1610,6 +1611,13 @@ nir_link_uniform(const struct gl_constants *consts,
          _mesa_hash_table_insert(state->uniform_hash, strdup(*name),
                                  (void *) (intptr_t)
                                     (prog->data->NumUniformStorage - 1));
+      } else if (uniform->remap_location != UNMAPPED_UNIFORM_LOC &&
+                 !_mesa_hash_table_u64_search(state->location_hash,
+                                              uniform->remap_location)) {
+         _mesa_hash_table_u64_insert(state->location_hash,
+                                     uniform->remap_location,
+                                     (void *) (uintptr_t)
+                                        prog->data->NumUniformStorage);
       }
 
       if (!is_gl_identifier(uniform->name.string) && !uniform->is_shader_storage &&
@@ -1701,6 +1709,7 @@ gl_nir_link_uniforms(const struct gl_constants *consts,
    /* Iterate through all linked shaders */
    state.uniform_hash = _mesa_hash_table_create(NULL, _mesa_hash_string,
                                                 _mesa_key_string_equal);
+   state.location_hash = _mesa_hash_table_u64_create(NULL);
 
    for (unsigned shader_type = 0; shader_type < MESA_SHADER_MESH_STAGES; shader_type++) {
       struct gl_linked_shader *sh = prog->_LinkedShaders[shader_type];
@@ -1978,8 +1987,11 @@ gl_nir_link_uniforms(const struct gl_constants *consts,
          free_type_tree(type_tree);
          ralloc_free(name);
 
-         if (res == -1)
+         if (res == -1) {
+            _mesa_hash_table_destroy(state.uniform_hash, hash_free_uniform_name);
+            _mesa_hash_table_u64_destroy(state.location_hash);
             return false;
+         }
       }
 
       if (!prog->data->spirv) {
@@ -2022,6 +2034,7 @@ gl_nir_link_uniforms(const struct gl_constants *consts,
    gl_nir_set_uniform_initializers(consts, prog);
 
    _mesa_hash_table_destroy(state.uniform_hash, hash_free_uniform_name);
+   _mesa_hash_table_u64_destroy(state.location_hash);
 
    return true;
 }
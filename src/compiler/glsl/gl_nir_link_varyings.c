@@ -33,6 +33,7 @@
 #include "main/mtypes.h"
 #include "program/symbol_table.h"
 #include "util/hash_table.h"
+#include "util/set.h"
 #include "util/u_math.h"
 #include "util/perf/cpu_trace.h"
 #include "pipe/p_screen.h"
@@ -1729,6 +1730,25 @@ xfb_decl_is_same(const struct xfb_decl *x, const struct xfb_decl *y)
    return true;
 }
 
+static uint32_t
+hash_xfb_decl(const void *key)
+{
+   const struct xfb_decl *x = (const struct xfb_decl *) key;
+
+   uint32_t hash = _mesa_hash_string(x->var_name);
+   if (x->is_subscripted)
+      hash = _mesa_hash_data_with_seed(&x->array_subscript,
+                                       sizeof(x->array_subscript), hash);
+   return hash;
+}
+
+static bool
+xfb_decl_equal(const void *a, const void *b)
+{
+   return xfb_decl_is_same((const struct xfb_decl *) a,
+                           (const struct xfb_decl *) b);
+}
+
 /**
  * The total number of varying components taken up by this variable.  Only
  * valid if assign_location() has been called.
@@ -2179,6 +2199,8 @@ parse_xfb_decls(const struct gl_constants *consts,
                 const void *mem_ctx, unsigned num_names,
                 char **varying_names, struct xfb_decl *decls, bool compact_arrays)
 {
+   struct set *seen = _mesa_set_create(NULL, hash_xfb_decl, xfb_decl_equal);
+
    for (unsigned i = 0; i < num_names; ++i) {
       xfb_decl_init(&decls[i], consts, exts, mem_ctx, varying_names[i], compact_arrays);
 
@@ -2195,16 +2217,17 @@ parse_xfb_decls(const struct gl_constants *consts,
        * specify the same varying variable and array index", since transform
        * feedback of arrays would be useless otherwise.
        */
-      for (unsigned j = 0; j < i; ++j) {
-         if (xfb_decl_is_varying(&decls[j])) {
-            if (xfb_decl_is_same(&decls[i], &decls[j])) {
-               linker_error(prog, "Transform feedback varying %s specified "
-                            "more than once.", varying_names[i]);
-               return false;
-            }
-         }
+      bool found;
+      _mesa_set_search_or_add(seen, &decls[i], &found);
+      if (found) {
+         linker_error(prog, "Transform feedback varying %s specified "
+                      "more than once.", varying_names[i]);
+         _mesa_set_destroy(seen, NULL);
+         return false;
       }
    }
+
+   _mesa_set_destroy(seen, NULL);
    return true;
 }
 
@@ -3809,7 +3832,23 @@ assign_final_varying_locations(const struct gl_constants *consts,
          vm->num_matches++;
       }
 
-      /* Regather xfb varyings too */
+      /* Regather xfb varyings too.  Index the outputs by location once
+       * rather than walking them again for every declaration.
+       */
+      struct hash_table_u64 *outputs = NULL;
+      if (num_xfb_decls > 0) {
+         outputs = _mesa_hash_table_u64_create(NULL);
+         nir_foreach_shader_out_variable(var_out, producer->Program->nir) {
+            assert(var_out->data.location != -1);
+            const uint64_t key = (uint64_t) var_out->data.location << 2 |
+                                 var_out->data.location_frac;
+
+            /* Keep the first variable, as the search used to. */
+            if (!_mesa_hash_table_u64_search(outputs, key))
+               _mesa_hash_table_u64_insert(outputs, key, var_out);
+         }
+      }
+
       for (unsigned i = 0; i < num_xfb_decls; i++) {
          if (!xfb_decl_is_varying(&xfb_decls[i]))
             continue;
@@ -3818,23 +3857,20 @@ assign_final_varying_locations(const struct gl_constants *consts,
          if (xfb_decls[i].matched_candidate->initial_location == -1)
             continue;
 
-         bool UNUSED is_reset = false;
-         bool UNUSED no_outputs = true;
-         nir_foreach_shader_out_variable(var_out, producer->Program->nir) {
-            no_outputs = false;
-            assert(var_out->data.location != -1);
-            if (var_out->data.location ==
-                xfb_decls[i].matched_candidate->initial_location &&
-                var_out->data.location_frac ==
-                xfb_decls[i].matched_candidate->initial_location_frac) {
-               xfb_decls[i].matched_candidate->toplevel_var = var_out;
-               xfb_decls[i].matched_candidate->initial_location = -1;
-               is_reset = true;
-               break;
-            }
+         const uint64_t key =
+            (uint64_t) xfb_decls[i].matched_candidate->initial_location << 2 |
+            xfb_decls[i].matched_candidate->initial_location_frac;
+         nir_variable *var_out = (nir_variable *)
+            _mesa_hash_table_u64_search(outputs, key);
+         if (var_out) {
+            xfb_decls[i].matched_candidate->toplevel_var = var_out;
+            xfb_decls[i].matched_candidate->initial_location = -1;
          }
-         assert(is_reset || no_outputs);
+         assert(var_out || _mesa_hash_table_u64_num_entries(outputs) == 0);
       }
+
+      if (outputs)
+         _mesa_hash_table_u64_destroy(outputs);
    }
 
    bool found_match = false;
@@ -34,6 +34,7 @@
 #include "main/context.h"
 #include "main/shaderobj.h"
 #include "util/glheader.h"
+#include "util/os_time.h"
 #include "util/u_range_remap.h"
 #include "util/perf/cpu_trace.h"
 #include "pipe/p_screen.h"
@@ -3689,6 +3690,24 @@ validate_geometry_shader_executable(struct gl_shader_program *prog,
    analyze_clip_cull_usage(prog, shader, consts, &shader->info);
 }
 
+/**
+ * With MESA_GLSL=link_time, prints how long the link phase that just ended
+ * took, and starts timing the next one.
+ */
+static void
+report_link_phase(const struct gl_context *ctx,
+                  const struct gl_shader_program *prog,
+                  const char *phase, int64_t *start)
+{
+   if (!(ctx->_Shader->Flags & GLSL_LINK_TIME))
+      return;
+
+   const int64_t now = os_time_get_nano();
+   fprintf(stderr, "GLSL link %u: %-20s %8.3f ms\n", prog->Name, phase,
+           (now - *start) / 1000000.0);
+   *start = now;
+}
+
 bool
 gl_nir_link_glsl(struct gl_context *ctx, struct gl_shader_program *prog)
 {
@@ -3701,6 +3720,9 @@ gl_nir_link_glsl(struct gl_context *ctx, struct gl_shader_program *prog)
 
    MESA_TRACE_FUNC();
 
+   const int64_t link_start = os_time_get_nano();
+   int64_t phase_start = link_start;
+
    void *mem_ctx = ralloc_context(NULL); /* temporary linker context */
 
    /* Separate the shaders into groups based on their type.
@@ -3889,6 +3911,8 @@ gl_nir_link_glsl(struct gl_context *ctx, struct gl_shader_program *prog)
       }
    }
 
+   report_link_phase(ctx, prog, "intrastage", &phase_start);
+
    /* Here begins the inter-stage linking phase.  Some initial validation is
     * performed, then locations are assigned for uniforms, attributes, and
     * varyings.
@@ -4059,6 +4083,8 @@ gl_nir_link_glsl(struct gl_context *ctx, struct gl_shader_program *prog)
       }
    }
 
+   report_link_phase(ctx, prog, "interstage checks", &phase_start);
+
    if (!gl_assign_attribute_or_color_locations(consts, prog))
       goto done;
 
@@ -4066,9 +4092,13 @@ gl_nir_link_glsl(struct gl_context *ctx, struct gl_shader_program *prog)
                          num_linked_shaders))
       goto done;
 
+   report_link_phase(ctx, prog, "prelink lowering", &phase_start);
+
    if (!gl_nir_link_varyings(ctx->screen, consts, exts, api, prog))
       goto done;
 
+   report_link_phase(ctx, prog, "varyings", &phase_start);
+
    /* Validation for special cases where we allow sampler array indexing
     * with loop induction variable. This check emits a warning or error
     * depending if backend can handle dynamic indexing.
@@ -4125,12 +4155,18 @@ gl_nir_link_glsl(struct gl_context *ctx, struct gl_shader_program *prog)
       }
    }
 
+   report_link_phase(ctx, prog, "dead variables", &phase_start);
+
    if (!gl_nir_link_uniform_blocks(consts, prog))
       goto done;
 
+   report_link_phase(ctx, prog, "uniform blocks", &phase_start);
+
    if (!gl_nir_link_uniforms(consts, prog, true))
       goto done;
 
+   report_link_phase(ctx, prog, "uniforms", &phase_start);
+
    link_util_calculate_subroutine_compat(prog);
    link_util_check_uniform_resources(consts, prog);
    link_util_check_subroutine_resources(prog);
@@ -4181,6 +4217,9 @@ done:
 
    ralloc_free(mem_ctx);
 
+   phase_start = link_start;
+   report_link_phase(ctx, prog, "total", &phase_start);
+
    if (prog->data->LinkStatus == LINKING_FAILURE)
       return false;
 
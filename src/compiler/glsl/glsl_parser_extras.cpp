@@ -2331,8 +2331,20 @@ can_skip_compile(struct gl_context *ctx, struct gl_shader *shader,
    if (!force_recompile) {
       if (ctx->Cache) {
          char buf[41];
-         disk_cache_compute_key(ctx->Cache, source, strlen(source),
-                                shader->disk_cache_sha1);
+
+         /* Without shader includes the key only depends on the source as
+          * set by glShaderSource, which has hashed it already.  Hashing that
+          * instead of the whole source again keeps warm starts from spending
+          * their time hashing sources.
+          */
+         if (!source_has_shader_include && shader->has_source_key_blake3 &&
+             source == shader->Source) {
+            disk_cache_compute_key(ctx->Cache, shader->source_key_blake3,
+                                   BLAKE3_OUT_LEN, shader->disk_cache_sha1);
+         } else {
+            disk_cache_compute_key(ctx->Cache, source, strlen(source),
+                                   shader->disk_cache_sha1);
+         }
          if (disk_cache_has_key(ctx->Cache, shader->disk_cache_sha1)) {
             /* We've seen this shader before and know it compiles */
             if (ctx->_Shader->Flags & GLSL_CACHE_INFO) {
@@ -31,10 +31,22 @@
 #include "util/ralloc.h"
 #include "util/u_math.h"
 #include "util/u_string.h"
+#include "util/sharded_hash_table.h"
 #include "util/simple_mtx.h"
 
 static simple_mtx_t glsl_type_cache_mutex = SIMPLE_MTX_INITIALIZER;
 
+struct PACKED array_key {
+   uintptr_t element;
+   uintptr_t array_size;
+   uintptr_t explicit_stride;
+};
+
+DERIVE_HASH_TABLE(array_key);
+
+static bool record_key_compare(const void *a, const void *b);
+static unsigned record_key_hash(const void *a);
+
 static struct {
    void *mem_ctx;
 
@@ -50,9 +62,15 @@ static struct {
    uint32_t users;
 
    struct hash_table *explicit_matrix_types;
-   struct hash_table *array_types;
    struct hash_table *cmat_types;
-   struct hash_table *struct_types;
+
+   /* Array and struct types are looked up all the time, often from several
+    * compiler threads at once.  These tables have their own locks, so that a
+    * lookup of an existing type doesn't take glsl_type_cache_mutex.  Creating
+    * a type still does, to protect lin_ctx.
+    */
+   struct util_sharded_hash_table array_types;
+   struct util_sharded_hash_table struct_types;
    struct hash_table *interface_types;
    struct hash_table *subroutine_types;
 } glsl_type_cache;
@@ -484,6 +502,10 @@ glsl_type_singleton_init_or_ref()
    if (glsl_type_cache.users == 0) {
       glsl_type_cache.mem_ctx = ralloc_context(NULL);
       glsl_type_cache.lin_ctx = linear_context(glsl_type_cache.mem_ctx);
+      util_sharded_hash_table_init(&glsl_type_cache.array_types,
+                                   array_key_hash, array_key_equal);
+      util_sharded_hash_table_init(&glsl_type_cache.struct_types,
+                                   record_key_hash, record_key_compare);
    }
    glsl_type_cache.users++;
    simple_mtx_unlock(&glsl_type_cache_mutex);
@@ -501,6 +523,8 @@ glsl_type_singleton_decref()
       return;
    }
 
+   util_sharded_hash_table_fini(&glsl_type_cache.array_types, NULL);
+   util_sharded_hash_table_fini(&glsl_type_cache.struct_types, NULL);
    ralloc_free(glsl_type_cache.mem_ctx);
    memset(&glsl_type_cache, 0, sizeof(glsl_type_cache));
 
@@ -1255,14 +1279,6 @@ glsl_image_type(enum glsl_sampler_dim dim, bool array, enum glsl_base_type type)
    UNREACHABLE("switch statement above should be complete");
 }
 
-struct PACKED array_key {
-   uintptr_t element;
-   uintptr_t array_size;
-   uintptr_t explicit_stride;
-};
-
-DERIVE_HASH_TABLE(array_key);
-
 const glsl_type *
 glsl_array_type(const glsl_type *element,
                 unsigned array_size,
@@ -1276,31 +1292,26 @@ glsl_array_type(const glsl_type *element,
    key.array_size = array_size;
    key.explicit_stride = explicit_stride;
 
-   const uint32_t key_hash = array_key_hash(&key);
-
-   simple_mtx_lock(&glsl_type_cache_mutex);
    assert(glsl_type_cache.users > 0);
-   void *mem_ctx = glsl_type_cache.mem_ctx;
+   struct util_sharded_hash_table *array_types = &glsl_type_cache.array_types;
 
-   if (glsl_type_cache.array_types == NULL) {
-      glsl_type_cache.array_types = array_key_table_create(mem_ctx);
-   }
-   struct hash_table *array_types = glsl_type_cache.array_types;
+   const glsl_type *t = util_sharded_hash_table_search(array_types, &key);
+   if (t == NULL) {
+      simple_mtx_lock(&glsl_type_cache_mutex);
 
-   const struct hash_entry *entry = _mesa_hash_table_search_pre_hashed(array_types, key_hash, &key);
-   if (entry == NULL) {
-      linear_ctx *lin_ctx = glsl_type_cache.lin_ctx;
-      const glsl_type *t = make_array_type(lin_ctx, element, array_size, explicit_stride);
-      struct array_key *stored_key = linear_zalloc(lin_ctx, struct array_key);
-      memcpy(stored_key, &key, sizeof(key));
+      /* Another thread might have created it in the meantime. */
+      t = util_sharded_hash_table_search(array_types, &key);
+      if (t == NULL) {
+         linear_ctx *lin_ctx = glsl_type_cache.lin_ctx;
+         t = make_array_type(lin_ctx, element, array_size, explicit_stride);
+         struct array_key *stored_key = linear_zalloc(lin_ctx, struct array_key);
+         memcpy(stored_key, &key, sizeof(key));
 
-      entry = _mesa_hash_table_insert_pre_hashed(array_types, key_hash,
-                                                 stored_key,
-                                                 (void *) t);
-   }
+         util_sharded_hash_table_insert(array_types, stored_key, (void *) t);
+      }
 
-   const glsl_type *t = (const glsl_type *) entry->data;
-   simple_mtx_unlock(&glsl_type_cache_mutex);
+      simple_mtx_unlock(&glsl_type_cache_mutex);
+   }
 
    assert(t->base_type == GLSL_TYPE_ARRAY);
    assert(t->length == array_size);
@@ -1557,29 +1568,25 @@ glsl_struct_type_with_explicit_alignment(const glsl_struct_field *fields,
 {
    glsl_type key = {0};
    fill_struct_type(&key, fields, num_fields, name, packed, explicit_alignment);
-   const uint32_t key_hash = record_key_hash(&key);
 
-   simple_mtx_lock(&glsl_type_cache_mutex);
    assert(glsl_type_cache.users > 0);
-   void *mem_ctx = glsl_type_cache.mem_ctx;
+   struct util_sharded_hash_table *struct_types = &glsl_type_cache.struct_types;
 
-   if (glsl_type_cache.struct_types == NULL) {
-      glsl_type_cache.struct_types =
-         _mesa_hash_table_create(mem_ctx, record_key_hash, record_key_compare);
-   }
-   struct hash_table *struct_types = glsl_type_cache.struct_types;
+   const glsl_type *t = util_sharded_hash_table_search(struct_types, &key);
+   if (t == NULL) {
+      simple_mtx_lock(&glsl_type_cache_mutex);
 
-   const struct hash_entry *entry = _mesa_hash_table_search_pre_hashed(struct_types,
-                                                                       key_hash, &key);
-   if (entry == NULL) {
-      const glsl_type *t = make_struct_type(glsl_type_cache.lin_ctx, fields, num_fields,
-                                            name, packed, explicit_alignment);
+      /* Another thread might have created it in the meantime. */
+      t = util_sharded_hash_table_search(struct_types, &key);
+      if (t == NULL) {
+         t = make_struct_type(glsl_type_cache.lin_ctx, fields, num_fields,
+                              name, packed, explicit_alignment);
 
-      entry = _mesa_hash_table_insert_pre_hashed(struct_types, key_hash, t, (void *) t);
-   }
+         util_sharded_hash_table_insert(struct_types, t, (void *) t);
+      }
 
-   const glsl_type *t = (const glsl_type *) entry->data;
-   simple_mtx_unlock(&glsl_type_cache_mutex);
+      simple_mtx_unlock(&glsl_type_cache_mutex);
+   }
 
    assert(t->base_type == GLSL_TYPE_STRUCT);
    assert(t->length == num_fields);
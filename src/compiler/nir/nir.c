@@ -41,6 +41,7 @@
 #ifndef NDEBUG
 uint32_t nir_debug = 0;
 bool nir_debug_print_shader[MESA_SHADER_KERNEL + 1] = { 0 };
+uint32_t nir_validate_interval = 1;
 
 static const struct debug_named_value nir_debug_control[] = {
    { "clone", NIR_DEBUG_CLONE,
@@ -53,6 +54,8 @@ static const struct debug_named_value nir_debug_control[] = {
      "Validate even if a pass does not make progress and test that it properly preserves most types of metadata. This can be very slow" },
    { "progress_validation", NIR_DEBUG_PROGRESS_VALIDATION,
      "Validate that a shader is unmodified if a pass does not report progress" },
+   { "sampled_validation", NIR_DEBUG_SAMPLED_VALIDATION,
+     "Only validate after every Nth pass that makes progress, N being NIR_VALIDATE_INTERVAL (default 16). A failure may come from any pass since the last validation" },
    { "invalidate_metadata", NIR_DEBUG_INVALIDATE_METADATA,
      "Invalidate metadata before passes to try to find passes which don't require metadata that they use. This overrides NIR_DEBUG=extended_validation somewhat" },
    { "tgsi", NIR_DEBUG_TGSI,
@@ -107,6 +110,9 @@ nir_process_debug_variable_once(void)
 {
    nir_debug = debug_get_option_nir_debug();
 
+   if (NIR_DEBUG(SAMPLED_VALIDATION))
+      nir_validate_interval = MAX2(debug_get_num_option("NIR_VALIDATE_INTERVAL", 16), 1);
+
    /* clang-format off */
    nir_debug_print_shader[MESA_SHADER_VERTEX]       = NIR_DEBUG(PRINT_VS);
    nir_debug_print_shader[MESA_SHADER_TESS_CTRL]    = NIR_DEBUG(PRINT_TCS);
@@ -1901,6 +1907,36 @@ nir_def_all_uses_ignore_sign_bit(const nir_def *def)
    return true;
 }
 
+/**
+ * Returns true if every use of def is a float source of an ALU instruction,
+ * so that a float source modifier (fneg, fabs) producing def can be folded
+ * into all of its users.  src_mask selects the source indices the backend
+ * supports modifiers on, uses in other sources make this return false.
+ */
+bool
+nir_def_all_uses_are_float_alu_srcs(const nir_def *def, unsigned src_mask)
+{
+   nir_foreach_use_including_if(use, def) {
+      if (nir_src_is_if(use))
+         return false;
+
+      nir_instr *instr = nir_src_parent_instr(use);
+      if (instr->type != nir_instr_type_alu)
+         return false;
+
+      nir_alu_instr *alu = nir_instr_as_alu(instr);
+      nir_alu_src *alu_src = list_entry(use, nir_alu_src, src);
+      unsigned src_index = alu_src - alu->src;
+      nir_alu_type src_type =
+         nir_alu_type_get_base_type(nir_op_infos[alu->op].input_types[src_index]);
+
+      if (src_type != nir_type_float || !(src_mask & BITFIELD_BIT(src_index)))
+         return false;
+   }
+
+   return true;
+}
+
 nir_block *
 nir_block_unstructured_next(nir_block *block)
 {
@@ -62,6 +62,7 @@ extern "C" {
 typedef struct u_printf_info u_printf_info;
 extern uint32_t nir_debug;
 extern bool nir_debug_print_shader[MESA_SHADER_KERNEL + 1];
+extern uint32_t nir_validate_interval;
 
 #ifndef NDEBUG
 #define NIR_DEBUG(flag) unlikely(nir_debug &(NIR_DEBUG_##flag))
@@ -95,6 +96,7 @@ extern bool nir_debug_print_shader[MESA_SHADER_KERNEL + 1];
 #define NIR_DEBUG_INVALIDATE_METADATA    (1u << 23)
 #define NIR_DEBUG_PRINT_STRUCT_DECLS     (1u << 24)
 #define NIR_DEBUG_PROGRESS_VALIDATION    (1u << 25)
+#define NIR_DEBUG_SAMPLED_VALIDATION     (1u << 26)
 
 #define NIR_DEBUG_PRINT (NIR_DEBUG_PRINT_VS |  \
                          NIR_DEBUG_PRINT_TCS | \
@@ -3220,6 +3222,12 @@ typedef struct nir_block {
     */
    struct u_sparse_bitset live_in;
    struct u_sparse_bitset live_out;
+
+   /* Fingerprint of the block when the last run of algebraic_table found
+    * nothing to do in it, see nir_algebraic_impl().
+    */
+   const void *algebraic_table;
+   uint32_t algebraic_fingerprint;
 } nir_block;
 
 static inline bool
@@ -3582,6 +3590,18 @@ typedef enum {
     */
    nir_metadata_dominance_lca = 0x80,
 
+   /** Indicates that nir_opt_cse would not make progress
+    *
+    * This is set by nir_opt_cse after a run that didn't find anything to
+    * eliminate, so that optimization loops don't rebuild the instruction set
+    * for functions that weren't touched since.  Unlike the other types, it
+    * can't be computed by nir_metadata_require().
+    *
+    * A pass can only preserve this metadata type if it doesn't change any
+    * instructions.
+    */
+   nir_metadata_cse = 0x100,
+
    /** All control flow metadata
     *
     * This includes all metadata preserved by a pass that preserves control flow
@@ -4071,6 +4091,19 @@ nir_shader *nir_shader_create(void *mem_ctx,
                               mesa_shader_stage stage,
                               const nir_shader_compiler_options *options);
 
+/**
+ * Makes freed instructions and variables of the shader only get reclaimed
+ * by the next nir_sweep() instead of being recycled right away, so that the
+ * instructions built by a pass stay contiguous in memory.  Meant for
+ * drivers which already sweep between their optimization loops.  Survives
+ * nir_shader_clone().
+ */
+static inline void
+nir_shader_set_defer_free(nir_shader *shader, bool defer)
+{
+   gc_set_defer_free(shader->gctx, defer);
+}
+
 bool nir_shader_bisect_select(nir_shader *s);
 
 /** Adds a variable to the appropriate list in nir_shader */
@@ -4625,6 +4658,8 @@ nir_component_mask_t nir_src_components_read(const nir_src *src);
 nir_component_mask_t nir_def_components_read(const nir_def *def);
 bool nir_def_all_uses_are_fsat(const nir_def *def);
 bool nir_def_all_uses_ignore_sign_bit(const nir_def *def);
+bool nir_def_all_uses_are_float_alu_srcs(const nir_def *def,
+                                         unsigned src_mask);
 
 static inline int
 nir_def_first_component_read(nir_def *def)
@@ -4808,10 +4843,16 @@ nir_variable *nir_variable_clone(const nir_variable *c, nir_shader *shader);
 
 void nir_shader_replace(nir_shader *dest, nir_shader *src);
 
+struct util_queue;
+typedef bool (*nir_opt_function_loop)(nir_shader *shader, void *data);
+bool nir_opt_functions_parallel(nir_shader *shader, struct util_queue *queue,
+                                nir_opt_function_loop opt_loop, void *data);
+
 void nir_shader_serialize_deserialize(nir_shader *s);
 
 #ifndef NDEBUG
 void nir_validate_shader(nir_shader *shader, const char *when);
+void nir_validate_shader_after_pass(nir_shader *shader, const char *when);
 void nir_validate_ssa_dominance(nir_shader *shader, const char *when);
 void nir_metadata_set_validation_flag(nir_shader *shader);
 void nir_metadata_check_validation_flag(nir_shader *shader);
@@ -4854,6 +4895,12 @@ nir_validate_shader(nir_shader *shader, const char *when)
    (void)when;
 }
 static inline void
+nir_validate_shader_after_pass(nir_shader *shader, const char *when)
+{
+   (void)shader;
+   (void)when;
+}
+static inline void
 nir_validate_ssa_dominance(nir_shader *shader, const char *when)
 {
    (void)shader;
@@ -4930,7 +4977,7 @@ should_print_nir(UNUSED nir_shader *shader)
    static const char *when = "after " #pass " in " __FILE__ ":" NIR_STRINGIZE(__LINE__); \
    struct blob blob_before = nir_validate_progress_setup(nir);                           \
    if (pass(nir, ##__VA_ARGS__)) {                                                       \
-      nir_validate_shader(nir, when);                                                    \
+      nir_validate_shader_after_pass(nir, when);                                         \
       UNUSED bool _;                                                                     \
       progress = true;                                                                   \
       if (should_print_nir(nir))                                                         \
@@ -5486,6 +5533,12 @@ typedef struct nir_load_store_vectorize_options {
    nir_variable_mode robust_modes;
    void *cb_data;
    bool has_shared2_amd;
+
+   /* If non-zero, the maximum number of instructions between two accesses
+    * for them to be considered for combining, which bounds the cost of the
+    * aliasing checks in blocks with lots of accesses.
+    */
+   unsigned max_distance;
 } nir_load_store_vectorize_options;
 
 bool nir_opt_load_store_vectorize(nir_shader *shader, const nir_load_store_vectorize_options *options);
@@ -1178,6 +1178,7 @@ static const nir_algebraic_table ${pass_name}_table = {
    .values = ${pass_name}_values,
    .expression_cond = ${ pass_name + "_expression_cond" if expression_cond else "NULL" },
    .variable_cond = ${ pass_name + "_variable_cond" if variable_cond else "NULL" },
+   .num_conditions = ${len(condition_list)},
 };
 
 bool
@@ -827,6 +827,7 @@ nir_shader_clone(void *mem_ctx, const nir_shader *s)
    state.ns = ns;
 
    ns->has_debug_info = s->has_debug_info;
+   gc_set_defer_free(ns->gctx, gc_get_defer_free(s->gctx));
 
    clone_var_list(&state, &ns->variables, &s->variables);
 
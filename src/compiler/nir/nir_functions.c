@@ -353,8 +353,31 @@ struct lower_link_state {
    struct hash_table *shader_var_remap;
    const nir_shader *link_shader;
    unsigned printf_index_offset;
+
+   /* Functions of both shaders by name, libraries have far too many
+    * functions to look each call up with nir_shader_get_function_for_name.
+    */
+   struct hash_table *shader_funcs;
+   struct hash_table *link_funcs;
 };
 
+static void
+add_function_name(struct hash_table *funcs, nir_function *func)
+{
+   /* Keep the first function of a given name, like
+    * nir_shader_get_function_for_name.
+    */
+   if (func->name && !_mesa_hash_table_search(funcs, func->name))
+      _mesa_hash_table_insert(funcs, func->name, func);
+}
+
+static nir_function *
+get_function_for_name(struct hash_table *funcs, const char *name)
+{
+   struct hash_entry *entry = _mesa_hash_table_search(funcs, name);
+   return entry ? entry->data : NULL;
+}
+
 static bool
 lower_calls_vars_instr(struct nir_builder *b,
                        nir_instr *instr,
@@ -387,16 +410,19 @@ lower_calls_vars_instr(struct nir_builder *b,
       if (!ncall->callee->name)
          return false;
 
-      nir_function *func = nir_shader_get_function_for_name(b->shader, ncall->callee->name);
+      nir_function *func = get_function_for_name(state->shader_funcs,
+                                                 ncall->callee->name);
       if (func) {
          ncall->callee = func;
          break;
       }
 
       nir_function *new_func;
-      new_func = nir_shader_get_function_for_name(state->link_shader, ncall->callee->name);
-      if (new_func)
+      new_func = get_function_for_name(state->link_funcs, ncall->callee->name);
+      if (new_func) {
          ncall->callee = nir_function_clone(b->shader, new_func);
+         add_function_name(state->shader_funcs, ncall->callee);
+      }
       break;
    }
    case nir_instr_type_intrinsic: {
@@ -454,7 +480,7 @@ function_link_pass(struct nir_builder *b,
    if (call->callee->impl)
       return false;
 
-   func = nir_shader_get_function_for_name(state->link_shader, call->callee->name);
+   func = get_function_for_name(state->link_funcs, call->callee->name);
    if (!func || !func->impl) {
       return false;
    }
@@ -475,7 +501,14 @@ nir_link_shader_functions(nir_shader *shader,
       .shader_var_remap = copy_vars,
       .link_shader = link_shader,
       .printf_index_offset = shader->printf_info_count,
+      .shader_funcs = _mesa_string_hash_table_create(ra_ctx),
+      .link_funcs = _mesa_string_hash_table_create(ra_ctx),
    };
+
+   nir_foreach_function(func, shader)
+      add_function_name(state.shader_funcs, func);
+   nir_foreach_function(func, link_shader)
+      add_function_name(state.link_funcs, func);
    /* do progress passes inside the pass */
    do {
       progress = false;
@@ -46,21 +46,15 @@ struct live_defs_state {
    /* Used in propagate_across_edge() */
    struct u_sparse_bitset tmp_live;
 
+   /* Per-block summaries indexed by block index: the defs used in the block
+    * before being defined in it, and the defs of the block.
+    */
+   struct u_sparse_bitset *gen;
+   struct u_sparse_bitset *kill;
+
    nir_block_worklist worklist;
 };
 
-/* Initialize the liveness data to zero and add the given block to the
- * worklist.
- */
-static void
-init_liveness_block(nir_block *block,
-                    struct live_defs_state *state)
-{
-   u_sparse_bitset_init(&block->live_in, state->num_bits, state->mem_ctx);
-   u_sparse_bitset_init(&block->live_out, state->num_bits, state->mem_ctx);
-   nir_block_worklist_push_head(&state->worklist, block);
-}
-
 static bool
 set_src_live(nir_src *src, void *void_live)
 {
@@ -84,6 +78,55 @@ set_ssa_def_dead(nir_def *def, void *void_live)
    return true;
 }
 
+static bool
+set_ssa_def_killed(nir_def *def, void *void_kill)
+{
+   struct u_sparse_bitset *kill = void_kill;
+
+   u_sparse_bitset_set(kill, def->index);
+
+   return true;
+}
+
+/* Initialize the liveness data to zero, compute the gen and kill sets of the
+ * block and add it to the worklist.
+ *
+ * Walking the instructions only once here means the fixed-point iteration
+ * below only does bitset operations, instead of walking the instructions of
+ * a block again every time it is popped off the worklist.
+ */
+static void
+init_liveness_block(nir_block *block,
+                    struct live_defs_state *state)
+{
+   u_sparse_bitset_init(&block->live_in, state->num_bits, state->mem_ctx);
+   u_sparse_bitset_init(&block->live_out, state->num_bits, state->mem_ctx);
+
+   struct u_sparse_bitset *gen = &state->gen[block->index];
+   struct u_sparse_bitset *kill = &state->kill[block->index];
+   u_sparse_bitset_init(gen, state->num_bits, state->mem_ctx);
+   u_sparse_bitset_init(kill, state->num_bits, state->mem_ctx);
+
+   nir_if *following_if = nir_block_get_following_if(block);
+   if (following_if)
+      set_src_live(&following_if->condition, gen);
+
+   nir_foreach_instr_reverse(instr, block) {
+      /* Phi nodes are handled seperately so we want to skip them.  Since
+       * we are going backwards and they are at the beginning, we can just
+       * break as soon as we see one.
+       */
+      if (instr->type == nir_instr_type_phi)
+         break;
+
+      nir_foreach_def(instr, set_ssa_def_dead, gen);
+      nir_foreach_def(instr, set_ssa_def_killed, kill);
+      nir_foreach_src(instr, set_src_live, gen);
+   }
+
+   nir_block_worklist_push_head(&state->worklist, block);
+}
+
 /** Propagates the live in of succ across the edge to the live out of pred
  *
  * Phi nodes exist "between" blocks and all the phi nodes at the start of a
@@ -127,6 +170,8 @@ nir_live_defs_impl(nir_function_impl *impl)
    };
 
    nir_block_worklist_init(&state.worklist, impl->num_blocks, NULL);
+   state.gen = ralloc_array(NULL, struct u_sparse_bitset, impl->num_blocks);
+   state.kill = ralloc_array(NULL, struct u_sparse_bitset, impl->num_blocks);
 
    /* Allocate live_in and live_out sets and add all of the blocks to the
     * worklist.
@@ -148,23 +193,10 @@ nir_live_defs_impl(nir_function_impl *impl)
        */
       nir_block *block = nir_block_worklist_pop_head(&state.worklist);
 
+      /* live_in = gen | (live_out & ~kill) */
       u_sparse_bitset_dup(&block->live_in, &block->live_out);
-
-      nir_if *following_if = nir_block_get_following_if(block);
-      if (following_if)
-         set_src_live(&following_if->condition, &block->live_in);
-
-      nir_foreach_instr_reverse(instr, block) {
-         /* Phi nodes are handled seperately so we want to skip them.  Since
-          * we are going backwards and they are at the beginning, we can just
-          * break as soon as we see one.
-          */
-         if (instr->type == nir_instr_type_phi)
-            break;
-
-         nir_foreach_def(instr, set_ssa_def_dead, &block->live_in);
-         nir_foreach_src(instr, set_src_live, &block->live_in);
-      }
+      u_sparse_bitset_subtract(&block->live_in, &state.kill[block->index]);
+      u_sparse_bitset_merge(&block->live_in, &state.gen[block->index]);
 
       /* Walk over all of the predecessors of the current block updating
        * their live in with the live out of this one.  If anything has
@@ -178,6 +210,13 @@ nir_live_defs_impl(nir_function_impl *impl)
       }
    }
 
+   for (unsigned i = 0; i < impl->num_blocks; i++) {
+      u_sparse_bitset_free(&state.gen[i]);
+      u_sparse_bitset_free(&state.kill[i]);
+   }
+   ralloc_free(state.gen);
+   ralloc_free(state.kill);
+
    nir_block_worklist_fini(&state.worklist);
 }
 
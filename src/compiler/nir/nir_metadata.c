@@ -192,6 +192,9 @@ nir_metadata_require_most(nir_shader *shader)
       /* We don't know if divergence analysis supports this shader. */
       md &= ~nir_metadata_divergence;
 
+      /* This one can't be computed. */
+      md &= ~nir_metadata_cse;
+
       if (!impl->structured) {
          /* These don't support unstructured control flow. */
          md &= ~nir_metadata_instr_index;
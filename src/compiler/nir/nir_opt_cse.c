@@ -79,6 +79,10 @@ dominates(const nir_instr *old_instr, const nir_instr *new_instr)
 static bool
 nir_opt_cse_impl(nir_function_impl *impl)
 {
+   /* Nothing changed since the last run that didn't make progress. */
+   if (impl->valid_metadata & nir_metadata_cse)
+      return nir_no_progress(impl);
+
    struct set instr_set;
    nir_instr_set_init(&instr_set, NULL);
 
@@ -98,6 +102,13 @@ nir_opt_cse_impl(nir_function_impl *impl)
 
    nir_progress(progress, impl, nir_metadata_control_flow);
 
+   /* Eliminating instructions can make phis whose sources come from back
+    * edges equal, so only a run without progress proves that another one
+    * would be useless.
+    */
+   if (!progress)
+      impl->valid_metadata |= nir_metadata_cse;
+
    nir_instr_set_fini(&instr_set);
    return progress;
 }
@@ -0,0 +1,174 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * Runs a driver's optimization loop on every function implementation of a
+ * shader at once, one util_queue job per implementation.
+ *
+ * NIR instructions are allocated from the shader, so implementations of the
+ * same shader can't be modified from several threads.  Instead each job
+ * clones its implementation into a private shader, which also holds clones
+ * of the shader's global variables and of every nir_function (without
+ * implementation) so that derefs and calls resolve.  Once all jobs are done,
+ * the optimized implementations are cloned back into the original shader
+ * and replace the old ones, whose memory is left for nir_sweep() to reclaim.
+ *
+ * The optimization loop thus has to be local to a function: it only gets to
+ * see the function it optimizes, as the entrypoint of a shader without other
+ * implementations, and changes it makes to the shader itself (shader_info,
+ * constant data, removing variables) are thrown away.  New variables it
+ * creates are moved over to the original shader.
+ */
+
+#include "nir.h"
+#include "util/hash_table.h"
+#include "util/u_queue.h"
+
+struct opt_function_job {
+   nir_shader *shader;
+   nir_function *func;
+   nir_opt_function_loop opt_loop;
+   void *data;
+
+   /* Private shader and the orig -> private pointer map used to build it */
+   nir_shader *private_shader;
+   struct hash_table *remap_table;
+   bool progress;
+
+   struct util_queue_fence fence;
+};
+
+static void
+opt_function_job_execute(void *data, void *gdata, int thread_index)
+{
+   struct opt_function_job *job = data;
+   const nir_shader *shader = job->shader;
+
+   nir_shader *ps = nir_shader_create(NULL, shader->info.stage,
+                                      shader->options);
+   ps->info = shader->info;
+   ps->has_debug_info = shader->has_debug_info;
+
+   job->remap_table = _mesa_pointer_hash_table_create(NULL);
+
+   nir_foreach_variable_in_shader(var, shader) {
+      nir_variable *nvar = nir_variable_clone(var, ps);
+      nir_shader_add_variable(ps, nvar);
+      _mesa_hash_table_insert(job->remap_table, var, nvar);
+   }
+
+   nir_function *nfunc = NULL;
+   nir_foreach_function(func, shader) {
+      nir_function *clone = nir_function_clone(ps, func);
+      /* Make passes using nir_shader_get_entrypoint() see this function. */
+      clone->is_entrypoint = func == job->func;
+      _mesa_hash_table_insert(job->remap_table, func, clone);
+      if (func == job->func)
+         nfunc = clone;
+   }
+
+   nir_function_set_impl(nfunc,
+      nir_function_impl_clone_remap_globals(ps, job->func->impl,
+                                            job->remap_table));
+
+   job->progress = job->opt_loop(ps, job->data);
+   job->private_shader = ps;
+}
+
+/* Moves the optimized implementation of a job back into the shader. */
+static void
+opt_function_job_finish(struct opt_function_job *job)
+{
+   nir_shader *shader = job->shader;
+   nir_shader *ps = job->private_shader;
+   struct hash_table *back_table = _mesa_pointer_hash_table_create(NULL);
+
+   nir_foreach_function(func, shader) {
+      struct hash_entry *entry =
+         _mesa_hash_table_search(job->remap_table, func);
+      _mesa_hash_table_insert(back_table, entry->data, func);
+   }
+
+   nir_foreach_variable_in_shader(var, shader) {
+      struct hash_entry *entry =
+         _mesa_hash_table_search(job->remap_table, var);
+      _mesa_hash_table_insert(back_table, entry->data, var);
+   }
+
+   nir_foreach_variable_in_shader(nvar, ps) {
+      if (_mesa_hash_table_search(back_table, nvar))
+         continue;
+
+      nir_variable *var = nir_variable_clone(nvar, shader);
+      nir_shader_add_variable(shader, var);
+      _mesa_hash_table_insert(back_table, nvar, var);
+   }
+
+   nir_function *nfunc = nir_shader_get_entrypoint(ps)->function;
+   nir_function_set_impl(job->func,
+      nir_function_impl_clone_remap_globals(shader, nfunc->impl, back_table));
+
+   _mesa_hash_table_destroy(back_table, NULL);
+   _mesa_hash_table_destroy(job->remap_table, NULL);
+   ralloc_free(ps);
+}
+
+/**
+ * Calls opt_loop for every function implementation of the shader, in
+ * parallel on the given queue.  opt_loop returns whether it made progress.
+ *
+ * Without a queue, or with a single implementation, this is the same as
+ * calling opt_loop on the whole shader.
+ */
+bool
+nir_opt_functions_parallel(nir_shader *shader, struct util_queue *queue,
+                           nir_opt_function_loop opt_loop, void *data)
+{
+   unsigned num_impls = 0;
+   nir_foreach_function_impl(impl, shader)
+      num_impls++;
+
+   if (!queue || num_impls < 2)
+      return opt_loop(shader, data);
+
+   struct opt_function_job *jobs = calloc(num_impls, sizeof(*jobs));
+   if (!jobs)
+      return opt_loop(shader, data);
+
+   unsigned i = 0;
+   nir_foreach_function_with_impl(func, impl, shader) {
+      struct opt_function_job *job = &jobs[i++];
+
+      job->shader = shader;
+      job->func = func;
+      job->opt_loop = opt_loop;
+      job->data = data;
+      util_queue_fence_init(&job->fence);
+      util_queue_add_job(queue, job, &job->fence,
+                         opt_function_job_execute, NULL, 0);
+   }
+
+   /* Nothing may touch the shader before all of the jobs have cloned their
+    * function out of it.
+    */
+   for (i = 0; i < num_impls; i++)
+      util_queue_fence_wait(&jobs[i].fence);
+
+   bool progress = false;
+   for (i = 0; i < num_impls; i++) {
+      if (jobs[i].progress) {
+         opt_function_job_finish(&jobs[i]);
+         progress = true;
+      } else {
+         _mesa_hash_table_destroy(jobs[i].remap_table, NULL);
+         ralloc_free(jobs[i].private_shader);
+      }
+      util_queue_fence_destroy(&jobs[i].fence);
+   }
+
+   free(jobs);
+
+   return progress;
+}
@@ -245,5 +245,6 @@ nir_opt_load_skip_helpers(nir_shader *shader, nir_opt_load_skip_helpers_options
    nir_instr_worklist_fini(&hs.worklist);
    ralloc_free(hs.needs_helpers);
 
-   return nir_progress(progress, impl, nir_metadata_all);
+   /* Access flags are compared by CSE. */
+   return nir_progress(progress, impl, nir_metadata_all & ~nir_metadata_cse);
 }
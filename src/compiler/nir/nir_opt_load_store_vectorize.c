@@ -1606,7 +1606,14 @@ vectorize_sorted_entries(struct vectorize_ctx *ctx, nir_function_impl *impl,
          unsigned max_hole = first->is_store ? 0 : 28;
          unsigned low_size = get_bit_size(low) / 8u * low->num_components;
          bool separate = diff > max_hole + low_size;
+         /* The entries are sorted by offset and low keeps its offset when
+          * combined, so none of the remaining ones can be close enough.
+          */
          if (separate)
+            break;
+
+         if (ctx->options->max_distance &&
+             second->index - first->index > ctx->options->max_distance)
             continue;
 
          if (try_vectorize(impl, ctx, low, high, first, second)) {
@@ -1632,8 +1639,16 @@ vectorize_sorted_entries(struct vectorize_ctx *ctx, nir_function_impl *impl,
          if (!high || get_variable_mode(high) != nir_var_mem_shared)
             continue;
 
+         /* Past the largest offset that load/store_shared2 can encode. */
+         if (get_offset_diff(low, high) > 255 * 64 * 8)
+            break;
+
          struct entry *first = low->index < high->index ? low : high;
          struct entry *second = low->index < high->index ? high : low;
+         if (ctx->options->max_distance &&
+             second->index - first->index > ctx->options->max_distance)
+            continue;
+
          if (try_vectorize_shared2(ctx, low, high, first, second)) {
             low = NULL;
             *util_dynarray_element(arr, struct entry *, second_idx) = NULL;
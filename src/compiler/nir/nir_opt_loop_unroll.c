@@ -208,6 +208,85 @@ simple_unroll(nir_loop *loop)
    _mesa_hash_table_destroy(remap_table, NULL);
 }
 
+/**
+ * Unroll a loop with a known trip count by a factor that divides the trip
+ * count.  Only the first copy keeps the loop terminator, since the exit
+ * condition can only be met after a multiple of factor iterations:
+ *
+ *     loop {
+ *         ...header...
+ *         if (cond) break;
+ *         ...body...
+ *     }
+ *
+ * With a factor of 2 this becomes:
+ *
+ *     loop {
+ *         ...header...
+ *         if (cond) break;
+ *         ...body... ...header... ...body...
+ *     }
+ *
+ * This leaves straight-line code with several iterations worth of loads for
+ * the backend scheduler to overlap, for loops too large to unroll completely.
+ */
+static void
+unroll_by_factor(nir_loop *loop, unsigned factor)
+{
+   nir_loop_terminator *limiting_term = loop->info->limiting_terminator;
+   assert(nir_is_trivial_loop_if(limiting_term->nif,
+                                 limiting_term->break_block));
+
+   loop_prepare_for_unroll(loop);
+
+   nir_block *first_break_block;
+   nir_block *first_continue_block;
+   get_first_blocks_in_terminator(limiting_term, &first_break_block,
+                                  &first_continue_block);
+
+   /* Pluck out the loop header */
+   nir_cf_list lp_header;
+   nir_cf_extract(&lp_header, nir_before_block(nir_loop_first_block(loop)),
+                  nir_before_cf_node(&limiting_term->nif->cf_node));
+
+   /* Add the continue from block of the limiting terminator to the loop body
+    */
+   nir_cf_list continue_from_lst;
+   nir_cf_extract(&continue_from_lst, nir_before_block(first_continue_block),
+                  nir_after_block(limiting_term->continue_from_block));
+   nir_cf_reinsert(&continue_from_lst,
+                   nir_after_cf_node(&limiting_term->nif->cf_node));
+
+   /* Pluck out the loop body */
+   nir_cf_list loop_body;
+   nir_cf_extract(&loop_body, nir_after_cf_node(&limiting_term->nif->cf_node),
+                  nir_after_block(nir_loop_last_block(loop)));
+
+   struct hash_table *remap_table = _mesa_pointer_hash_table_create(NULL);
+
+   /* Append the extra copies of the header and body to the loop */
+   for (unsigned i = 1; i < factor; i++) {
+      nir_cf_list_clone_and_reinsert(&lp_header, &loop->cf_node,
+                                     nir_after_cf_list(&loop->body),
+                                     remap_table);
+      nir_cf_list_clone_and_reinsert(&loop_body, &loop->cf_node,
+                                     nir_after_cf_list(&loop->body),
+                                     remap_table);
+   }
+
+   /* Put the original header and body back around the terminator, in front
+    * of the copies.
+    */
+   nir_cf_reinsert(&lp_header,
+                   nir_before_cf_node(&limiting_term->nif->cf_node));
+   nir_cf_reinsert(&loop_body,
+                   nir_after_cf_node(&limiting_term->nif->cf_node));
+
+   loop->partially_unrolled = true;
+
+   _mesa_hash_table_destroy(remap_table, NULL);
+}
+
 static void
 move_cf_list_into_loop_term(nir_cf_list *lst, nir_loop_terminator *term)
 {
@@ -888,6 +967,34 @@ can_pipeline_loads(nir_loop *loop)
    return interesting_loads;
 }
 
+/*
+ * Returns the factor to unroll a loop by that is too large to unroll
+ * completely, or 0 if it shouldn't be.
+ */
+static unsigned
+get_unroll_factor_for_loads(nir_shader *shader, nir_loop *loop)
+{
+   nir_loop_info *li = loop->info;
+   unsigned max_factor = shader->options->max_unroll_factor_for_loads;
+
+   if (max_factor < 2 || loop->control != nir_loop_control_none ||
+       loop->partially_unrolled || !li->exact_trip_count_known ||
+       !list_is_singular(&li->loop_terminator_list) ||
+       !can_pipeline_loads(loop))
+      return 0;
+
+   /* Stay within the size limit of complete unrolling. */
+   unsigned cost_limit = shader->options->max_unroll_iterations * LOOP_UNROLL_LIMIT;
+
+   for (unsigned factor = max_factor; factor >= 2; factor--) {
+      if (li->max_trip_count % factor == 0 &&
+          li->instr_cost * factor <= cost_limit)
+         return factor;
+   }
+
+   return 0;
+}
+
 /*
  * Returns true if we should unroll the loop, otherwise false.
  */
@@ -1103,8 +1210,14 @@ process_loops(nir_shader *sh, nir_cf_node *cf_node, bool *has_nested_loop_out,
           (loop->info->max_trip_count != 1 && has_nested_loop))
          goto exit;
 
-      if (!check_unrolling_restrictions(sh, loop))
+      if (!check_unrolling_restrictions(sh, loop)) {
+         unsigned factor = get_unroll_factor_for_loads(sh, loop);
+         if (factor) {
+            unroll_by_factor(loop, factor);
+            progress = true;
+         }
          goto exit;
+      }
 
       if (loop->info->exact_trip_count_known) {
          simple_unroll(loop);
@@ -655,6 +655,7 @@ struct linkage_info {
    bool spirv;
    bool can_move_uniforms;
    bool can_move_ubos;
+   bool can_move_push_consts;
    bool can_mix_convergent_flat_with_interpolated;
    bool has_flexible_interp;
    bool always_interpolate_convergent_fs_inputs;
@@ -2161,6 +2162,18 @@ can_move_deref_between_shaders(struct linkage_info *linkage, nir_instr *instr)
    return true;
 }
 
+/* Push constant loads with a constant offset read the same value in every
+ * stage if the driver says so.
+ */
+static bool
+can_move_intrinsic_between_shaders(struct linkage_info *linkage,
+                                   nir_intrinsic_instr *intr)
+{
+   return linkage->can_move_push_consts &&
+          intr->intrinsic == nir_intrinsic_load_push_constant &&
+          nir_src_is_const(intr->src[0]);
+}
+
 static nir_intrinsic_instr *
 find_per_vertex_load_for_tes_interp(nir_instr *instr)
 {
@@ -2268,8 +2281,8 @@ clone_ssa_impl(struct linkage_info *linkage, nir_builder *b, nir_def *ssa)
    }
 
    case nir_instr_type_intrinsic: {
-      /* Clone load_deref of uniform or ubo. It's the only thing that can
-       * occur here.
+      /* Clone load_deref of uniform or ubo, or load_push_constant. They are
+       * the only things that can occur here.
        */
       nir_intrinsic_instr *intr = nir_def_as_intrinsic(ssa);
 
@@ -2280,6 +2293,22 @@ clone_ssa_impl(struct linkage_info *linkage, nir_builder *b, nir_def *ssa)
          break;
       }
 
+      case nir_intrinsic_load_push_constant: {
+         nir_intrinsic_instr *intr_clone =
+            nir_intrinsic_instr_create(b->shader, intr->intrinsic);
+
+         intr_clone->num_components = intr->num_components;
+         memcpy(intr_clone->const_index, intr->const_index,
+                sizeof(intr->const_index));
+         intr_clone->src[0] =
+            nir_src_for_ssa(clone_ssa_impl(linkage, b, intr->src[0].ssa));
+         nir_def_init(&intr_clone->instr, &intr_clone->def,
+                      intr->def.num_components, intr->def.bit_size);
+         nir_builder_instr_insert(b, &intr_clone->instr);
+         clone = &intr_clone->def;
+         break;
+      }
+
       case nir_intrinsic_load_input:
       case nir_intrinsic_load_per_primitive_input:
       case nir_intrinsic_load_interpolated_input: {
@@ -2407,7 +2436,9 @@ is_uniform_expression(nir_instr *instr, struct is_uniform_expr_state *state)
       break;
 
    case nir_instr_type_intrinsic:
-      if (nir_instr_as_intrinsic(instr)->intrinsic == nir_intrinsic_load_deref)
+      if (nir_instr_as_intrinsic(instr)->intrinsic == nir_intrinsic_load_deref ||
+          can_move_intrinsic_between_shaders(state->linkage,
+                                             nir_instr_as_intrinsic(instr)))
          break;
       return false;
 
@@ -3255,11 +3286,17 @@ update_movable_flags(struct linkage_info *linkage, nir_instr *instr)
        * Unmovable input loads skipped by initialization get UNMOVABLE here.
        * (e.g. colors, texcoords)
        *
-       * The only other movable intrinsic is load_deref for uniforms and UBOs.
-       * Other intrinsics are not movable.
+       * The only other movable intrinsics are load_deref for uniforms and
+       * UBOs, and load_push_constant if allowed by the driver. Other
+       * intrinsics are not movable.
        */
       nir_intrinsic_instr *intr = nir_instr_as_intrinsic(instr);
 
+      if (can_move_intrinsic_between_shaders(linkage, intr)) {
+         instr->pass_flags |= FLAG_MOVABLE | FLAG_INTERP_CONVERGENT;
+         return;
+      }
+
       if (intr->intrinsic == nir_intrinsic_load_deref) {
          nir_instr *deref = nir_def_instr(intr->src[0].ssa);
 
@@ -3380,6 +3417,7 @@ gather_used_input_loads(nir_instr *instr,
 
       switch (intr->intrinsic) {
       case nir_intrinsic_load_tess_coord:
+      case nir_intrinsic_load_push_constant:
          return;
 
       case nir_intrinsic_load_deref:
@@ -5187,14 +5225,18 @@ default_varying_estimate_instr_cost(nir_instr *instr)
       dst_bit_size = nir_instr_as_intrinsic(instr)->def.bit_size;
       num_dst_dwords = DIV_ROUND_UP(dst_bit_size, 32);
 
-      /* This can only be a uniform load. Other intrinsics and variables are
-       * rejected before this is called.
+      /* This can only be a uniform or push constant load. Other intrinsics
+       * and variables are rejected before this is called.
        */
       switch (nir_instr_as_intrinsic(instr)->intrinsic) {
       case nir_intrinsic_load_deref:
          /* Uniform loads can appear fast if latency hiding is effective. */
          return 2 * num_dst_dwords;
 
+      case nir_intrinsic_load_push_constant:
+         /* Push constants are usually preloaded into registers. */
+         return num_dst_dwords;
+
       default:
          UNREACHABLE("unexpected intrinsic");
       }
@@ -5246,6 +5288,9 @@ init_linkage(nir_shader *producer, nir_shader *consumer, bool spirv,
          consumer->info.stage == MESA_SHADER_TESS_EVAL &&
          consumer->options->io_options &
          nir_io_compaction_groups_tes_inputs_into_pos_and_var_groups,
+      .can_move_push_consts =
+         producer->options->io_options & consumer->options->io_options &
+         nir_io_can_move_push_constants,
       .producer_stage = producer->info.stage,
       .consumer_stage = consumer->info.stage,
       .producer_builder =
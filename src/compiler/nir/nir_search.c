@@ -27,6 +27,9 @@
 #include "nir_builder.h"
 #include "nir_worklist.h"
 
+#define XXH_INLINE_ALL
+#include "util/xxhash.h"
+
 /* This should be the same as nir_search_max_comm_ops in nir_algebraic.py. */
 #define NIR_SEARCH_MAX_COMM_OPS 8
 
@@ -907,6 +910,212 @@ nir_algebraic_instr(nir_builder *build, nir_instr *instr,
    return false;
 }
 
+/* Block fingerprints
+ *
+ * Drivers run algebraic passes in a loop with other optimizations until
+ * nothing makes progress, and most blocks don't change between iterations.
+ * With nir_shader_compiler_options::algebraic_skip_unchanged_blocks, every
+ * block the pass found nothing to do in remembers a fingerprint of itself,
+ * and later runs of the same table don't put the instructions of blocks
+ * with an unchanged fingerprint on the worklist.
+ *
+ * Whether a transform applies to an instruction depends on its sources,
+ * transitively (bigger search patterns and range analysis), and on its
+ * uses (is_used_once() and friends), so the fingerprint of an instruction
+ * covers the instruction itself and its users, and is mixed with the
+ * fingerprints of its sources in a forward walk and with the ones of its
+ * users in a backward walk.  Every block of a loop also gets the
+ * fingerprints of the whole loop, since phis make the walks miss the back
+ * edges.  Instructions are hashed along with their address, so anything
+ * replaced by a pass shows up as a change.
+ */
+
+#define HASH(hash, data) XXH32(&(data), sizeof(data), hash)
+
+static uint32_t
+hash_instr_uses(uint32_t hash, nir_def *def)
+{
+   hash = HASH(hash, def->num_components);
+   hash = HASH(hash, def->bit_size);
+
+   nir_foreach_use_including_if(src, def) {
+      if (nir_src_is_if(src)) {
+         const nir_if *nif = nir_src_parent_if(src);
+         hash = HASH(hash, nif);
+      } else {
+         const nir_instr *user = nir_src_parent_instr(src);
+         hash = HASH(hash, user);
+         if (user->type == nir_instr_type_alu)
+            hash = HASH(hash, nir_instr_as_alu(user)->op);
+      }
+   }
+
+   return hash;
+}
+
+static uint32_t
+hash_instr_local(uint32_t hash, nir_instr *instr)
+{
+   hash = HASH(hash, instr);
+   hash = HASH(hash, instr->type);
+
+   switch (instr->type) {
+   case nir_instr_type_alu: {
+      nir_alu_instr *alu = nir_instr_as_alu(instr);
+      uint32_t flags = alu->exact | alu->no_signed_wrap << 1 |
+                       alu->no_unsigned_wrap << 2 | alu->fp_fast_math << 3;
+      hash = HASH(hash, alu->op);
+      hash = HASH(hash, flags);
+      for (unsigned i = 0; i < nir_op_infos[alu->op].num_inputs; i++) {
+         hash = XXH32(alu->src[i].swizzle,
+                      nir_ssa_alu_instr_src_components(alu, i), hash);
+      }
+      break;
+   }
+
+   case nir_instr_type_load_const: {
+      nir_load_const_instr *load = nir_instr_as_load_const(instr);
+      hash = XXH32(load->value,
+                   load->def.num_components * sizeof(load->value[0]), hash);
+      break;
+   }
+
+   case nir_instr_type_intrinsic: {
+      nir_intrinsic_instr *intrin = nir_instr_as_intrinsic(instr);
+      const nir_intrinsic_info *info = &nir_intrinsic_infos[intrin->intrinsic];
+      hash = HASH(hash, intrin->intrinsic);
+      hash = XXH32(intrin->const_index,
+                   info->num_indices * sizeof(intrin->const_index[0]), hash);
+      break;
+   }
+
+   case nir_instr_type_tex: {
+      nir_tex_instr *tex = nir_instr_as_tex(instr);
+      hash = HASH(hash, tex->op);
+      hash = HASH(hash, tex->dest_type);
+      break;
+   }
+
+   default:
+      break;
+   }
+
+   nir_def *def = nir_instr_def(instr);
+   if (def)
+      hash = hash_instr_uses(hash, def);
+
+   return hash;
+}
+
+struct fingerprint_state {
+   /* Indexed by nir_def::index, 0 for defs that weren't visited yet. */
+   uint32_t *hashes;
+   uint32_t hash;
+};
+
+static bool
+hash_src_cb(nir_src *src, void *_state)
+{
+   struct fingerprint_state *state = _state;
+
+   if (state->hashes[src->ssa->index])
+      state->hash = HASH(state->hash, state->hashes[src->ssa->index]);
+   else
+      state->hash = HASH(state->hash, src->ssa);
+
+   return true;
+}
+
+static void
+mix_loop_fingerprints(struct exec_list *cf_list, uint32_t *block_hashes)
+{
+   foreach_list_typed(nir_cf_node, node, node, cf_list) {
+      switch (node->type) {
+      case nir_cf_node_if: {
+         nir_if *nif = nir_cf_node_as_if(node);
+         mix_loop_fingerprints(&nif->then_list, block_hashes);
+         mix_loop_fingerprints(&nif->else_list, block_hashes);
+         break;
+      }
+
+      case nir_cf_node_loop: {
+         uint32_t loop_hash = 0;
+         nir_foreach_block_in_cf_node(block, node)
+            loop_hash ^= block_hashes[block->index];
+         nir_foreach_block_in_cf_node(block, node)
+            block_hashes[block->index] ^= loop_hash * 0x9e3779b1u;
+         break;
+      }
+
+      default:
+         break;
+      }
+   }
+}
+
+/* Returns the fingerprint of every block of the impl, by block index. */
+static uint32_t *
+fingerprint_blocks(nir_function_impl *impl, uint32_t seed)
+{
+   nir_metadata_require(impl, nir_metadata_block_index);
+
+   uint32_t *block_hashes = calloc(impl->num_blocks, sizeof(uint32_t));
+   uint32_t *hashes = calloc(impl->ssa_alloc, sizeof(uint32_t));
+   if (!block_hashes || !hashes) {
+      free(block_hashes);
+      free(hashes);
+      return NULL;
+   }
+
+   nir_foreach_block(block, impl) {
+      uint32_t block_hash = HASH(seed, block->successors);
+
+      nir_foreach_instr(instr, block) {
+         struct fingerprint_state state = {
+            .hashes = hashes,
+            .hash = hash_instr_local(seed, instr),
+         };
+         nir_foreach_src(instr, hash_src_cb, &state);
+
+         /* Keep 0 for defs that weren't visited. */
+         nir_def *def = nir_instr_def(instr);
+         if (def)
+            hashes[def->index] = state.hash | 1;
+
+         block_hash = HASH(block_hash, state.hash);
+      }
+
+      block_hashes[block->index] = block_hash;
+   }
+
+   nir_foreach_block_reverse(block, impl) {
+      uint32_t block_hash = block_hashes[block->index];
+
+      nir_foreach_instr_reverse(instr, block) {
+         nir_def *def = nir_instr_def(instr);
+         if (!def)
+            continue;
+
+         uint32_t hash = hashes[def->index];
+         nir_foreach_use(src, def) {
+            nir_def *user_def = nir_instr_def(nir_src_parent_instr(src));
+            if (user_def)
+               hash = HASH(hash, hashes[user_def->index]);
+         }
+
+         hashes[def->index] = hash | 1;
+         block_hash = HASH(block_hash, hash);
+      }
+
+      block_hashes[block->index] = block_hash;
+   }
+
+   mix_loop_fingerprints(&impl->body, block_hashes);
+
+   free(hashes);
+   return block_hashes;
+}
+
 bool
 nir_algebraic_impl(nir_function_impl *impl,
                    const bool *condition_flags,
@@ -939,6 +1148,20 @@ nir_algebraic_impl(nir_function_impl *impl,
    nir_instr_worklist worklist;
    nir_instr_worklist_init(&worklist);
 
+   uint32_t *block_hashes = NULL;
+   BITSET_WORD *changed_blocks = NULL;
+   if (impl->function->shader->options->algebraic_skip_unchanged_blocks) {
+      /* The fingerprints only cover the instructions, so everything else the
+       * search depends on goes into the seed.
+       */
+      uint32_t seed = HASH(0, table);
+      seed = HASH(seed, impl->function->shader->info.float_controls_execution_mode);
+      seed = XXH32(condition_flags, table->num_conditions * sizeof(bool), seed);
+
+      block_hashes = fingerprint_blocks(impl, seed);
+      changed_blocks = BITSET_CALLOC(impl->num_blocks);
+   }
+
    /* Walk top-to-bottom setting up the automaton state. */
    nir_foreach_block(block, impl) {
       nir_foreach_instr(instr, block) {
@@ -951,9 +1174,17 @@ nir_algebraic_impl(nir_function_impl *impl,
     * possible.
     */
    nir_foreach_block_reverse(block, impl) {
+      /* Instructions of an unchanged block only need revisiting when one of
+       * their sources gets replaced during this run.
+       */
+      const bool unchanged = block_hashes && changed_blocks &&
+                             block->algebraic_table == table &&
+                             block->algebraic_fingerprint ==
+                                block_hashes[block->index];
+
       nir_foreach_instr_reverse(instr, block) {
          instr->pass_flags = 0;
-         if (instr->type == nir_instr_type_alu)
+         if (instr->type == nir_instr_type_alu && !unchanged)
             nir_instr_worklist_push_tail(&worklist, instr);
       }
    }
@@ -970,13 +1201,31 @@ nir_algebraic_impl(nir_function_impl *impl,
       if (instr->pass_flags)
          continue;
 
-      progress |= nir_algebraic_instr(&build, instr,
-                                      &state, condition_flags,
-                                      table, &states, &worklist, &dead_instrs);
+      nir_block *block = instr->block;
+      if (nir_algebraic_instr(&build, instr,
+                              &state, condition_flags,
+                              table, &states, &worklist, &dead_instrs)) {
+         if (changed_blocks)
+            BITSET_SET(changed_blocks, block->index);
+         progress = true;
+      }
    }
 
    nir_instr_free_list(&dead_instrs);
 
+   if (block_hashes && changed_blocks) {
+      nir_foreach_block(block, impl) {
+         if (BITSET_TEST(changed_blocks, block->index)) {
+            block->algebraic_table = NULL;
+         } else {
+            block->algebraic_table = table;
+            block->algebraic_fingerprint = block_hashes[block->index];
+         }
+      }
+   }
+   free(changed_blocks);
+   free(block_hashes);
+
    nir_instr_worklist_fini(&worklist);
    _mesa_hash_table_fini(&numlsb_ht, NULL);
    _mesa_hash_table_fini(&range_ht, NULL);
@@ -235,6 +235,9 @@ typedef struct {
     * nir_search_variable->cond.
     */
    const nir_search_variable_cond *variable_cond;
+
+   /** Number of entries in the condition_flags array of the pass. */
+   unsigned num_conditions;
 } nir_algebraic_table;
 
 /* Note: these must match the start states created in
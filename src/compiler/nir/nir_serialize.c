@@ -22,6 +22,7 @@
  */
 
 #include "nir_serialize.h"
+#include "util/fast_hash_table.h"
 #include "util/u_dynarray.h"
 #include "util/u_math.h"
 #include "util/u_printf.h"
@@ -42,8 +43,8 @@ typedef struct {
 
    struct blob *blob;
 
-   /* maps pointer to index */
-   struct hash_table remap_table;
+   /* maps pointer to index, looked up for every source written */
+   struct fast_hash_table *remap_table;
 
    /* the next index to assign to a NIR in-memory object */
    uint32_t next_idx;
@@ -98,13 +99,13 @@ write_add_object(write_ctx *ctx, const void *obj)
 {
    uint32_t index = ctx->next_idx++;
    assert(index != MAX_OBJECT_IDS);
-   _mesa_hash_table_insert(&ctx->remap_table, obj, (void *)(uintptr_t)index);
+   _mesa_fast_hash_table_insert(ctx->remap_table, obj, (void *)(uintptr_t)index);
 }
 
 static uint32_t
 write_lookup_object(write_ctx *ctx, const void *obj)
 {
-   struct hash_entry *entry = _mesa_hash_table_search(&ctx->remap_table, obj);
+   struct hash_entry *entry = _mesa_fast_hash_table_search(ctx->remap_table, obj);
    assert(entry);
    return (uint32_t)(uintptr_t)entry->data;
 }
@@ -2169,7 +2170,9 @@ void
 nir_serialize_function(struct blob *blob, const nir_function *fxn)
 {
    write_ctx ctx = { 0 };
-   _mesa_pointer_hash_table_init(&ctx.remap_table, NULL);
+   ctx.remap_table = _mesa_pointer_fast_hash_table_create(NULL);
+   if (fxn->impl)
+      _mesa_fast_hash_table_reserve(ctx.remap_table, fxn->impl->ssa_alloc);
    ctx.blob = blob;
    ctx.nir = fxn->shader;
    ctx.strip = true;
@@ -2182,7 +2185,7 @@ nir_serialize_function(struct blob *blob, const nir_function *fxn)
 
    blob_overwrite_uint32(blob, idx_size_offset, ctx.next_idx);
 
-   _mesa_hash_table_fini(&ctx.remap_table, NULL);
+   _mesa_fast_hash_table_destroy(ctx.remap_table, NULL);
    util_dynarray_fini(&ctx.phi_fixups);
 }
 
@@ -2190,9 +2193,18 @@ static void
 serialize_internal(struct blob *blob, const nir_shader *nir, bool strip, bool serialize_info)
 {
    write_ctx ctx = { 0 };
-   _mesa_pointer_hash_table_init(&ctx.remap_table, NULL);
+   ctx.remap_table = _mesa_pointer_fast_hash_table_create(NULL);
    ctx.blob = blob;
    ctx.nir = nir;
+
+   /* Most objects are SSA defs, size the table for them up front rather
+    * than rehashing it over and over for big shaders.
+    */
+   unsigned num_defs = 0;
+   nir_foreach_function_impl(impl, nir)
+      num_defs += impl->ssa_alloc;
+   _mesa_fast_hash_table_reserve(ctx.remap_table, num_defs);
+
    ctx.strip = strip;
    ctx.debug_info = nir->has_debug_info && !strip;
    ctx.phi_fixups = UTIL_DYNARRAY_INIT;
@@ -2246,7 +2258,7 @@ serialize_internal(struct blob *blob, const nir_shader *nir, bool strip, bool se
 
    blob_overwrite_uint32(blob, idx_size_offset, ctx.next_idx);
 
-   _mesa_hash_table_fini(&ctx.remap_table, NULL);
+   _mesa_fast_hash_table_destroy(ctx.remap_table, NULL);
    util_dynarray_fini(&ctx.phi_fixups);
 }
 
@@ -216,6 +216,15 @@ typedef enum {
     */
    nir_io_use_frag_result_dual_src_blend = BITFIELD_BIT(12),
 
+   /**
+    * Whether push constants (load_push_constant) have the same contents and
+    * layout in all stages of a pipeline.  This allows nir_opt_varyings to
+    * move expressions using them into the next or previous shader, like it
+    * does for uniforms.  Only push constant loads with a constant offset are
+    * moved.
+    */
+   nir_io_can_move_push_constants = BITFIELD_BIT(13),
+
    /* Options affecting the GLSL compiler or Gallium are below. */
 
    /**
@@ -716,6 +725,14 @@ typedef struct nir_shader_compiler_options {
    unsigned max_unroll_iterations_aggressive;
    unsigned max_unroll_iterations_fp64;
 
+   /**
+    * If at least 2, loops with a known trip count that are too large to
+    * unroll completely but do indirect memory loads are unrolled by up to
+    * this factor, so that the backend can overlap the loads of consecutive
+    * iterations.  This bounds the increase in register pressure.
+    */
+   unsigned max_unroll_factor_for_loads;
+
    bool lower_uniforms_to_ubo;
 
    /* Specifies if indirect sampler array access will trigger forced loop
@@ -903,6 +920,15 @@ typedef struct nir_shader_compiler_options {
 
    /** Maximum compute shader / kernel dispatchable work size. */
    unsigned max_workgroup_count[3];
+
+   /**
+    * Makes algebraic passes fingerprint every block and skip the blocks
+    * which didn't change since the last run of the same pass found nothing
+    * to do in them.  This pays off when algebraic passes run in a loop with
+    * other optimizations, which otherwise revisit the whole shader every
+    * iteration.
+    */
+   bool algebraic_skip_unchanged_blocks;
 } nir_shader_compiler_options;
 
 #ifdef __cplusplus
@@ -29,6 +29,7 @@
 #include "c11/threads.h"
 #include "util/hash_table.h"
 #include "util/simple_mtx.h"
+#include "util/u_atomic.h"
 #include "nir.h"
 #include "nir_xfb_info.h"
 
@@ -2344,6 +2345,26 @@ nir_validate_shader(nir_shader *shader, const char *when)
    destroy_validate_state(&state);
 }
 
+/**
+ * Validation done by NIR_PASS after a pass made progress.
+ *
+ * With NIR_DEBUG=sampled_validation, only every nir_validate_interval-th call
+ * validates, so that debug builds running long optimization loops don't
+ * spend most of their time in here.  The counter is global rather than per
+ * shader, which is fine given that it only needs to be roughly regular.
+ */
+void
+nir_validate_shader_after_pass(nir_shader *shader, const char *when)
+{
+   if (NIR_DEBUG(SAMPLED_VALIDATION)) {
+      static uint32_t pass_count = 0;
+      if (p_atomic_inc_return(&pass_count) % nir_validate_interval)
+         return;
+   }
+
+   nir_validate_shader(shader, when);
+}
+
 void
 nir_validate_ssa_dominance(nir_shader *shader, const char *when)
 {
@@ -186,6 +186,57 @@ TEST_F(nir_opt_algebraic_test, msad)
    require_one_alu(nir_op_msad_4x8);
 }
 
+TEST_F(nir_opt_algebraic_test, skip_unchanged_blocks)
+{
+   options.algebraic_skip_unchanged_blocks = true;
+
+   nir_def *x = nir_load_var(b, nir_local_variable_create(b->impl, glsl_int_type(), "x"));
+   nir_store_var(b, res_var, nir_iadd(b, x, nir_imm_int(b, 0)), 0x1);
+
+   nir_block *block = nir_start_block(b->impl);
+
+   EXPECT_TRUE(nir_opt_algebraic(b->shader));
+   EXPECT_EQ(block->algebraic_table, nullptr);
+
+   EXPECT_FALSE(nir_opt_algebraic(b->shader));
+   EXPECT_NE(block->algebraic_table, nullptr);
+
+   /* New instructions make the block get revisited. */
+   nir_store_var(b, res_var, nir_imul(b, x, nir_imm_int(b, 1)), 0x1);
+   EXPECT_TRUE(nir_opt_algebraic(b->shader));
+}
+
+TEST_F(nir_opt_algebraic_test, skip_unchanged_blocks_source_changed)
+{
+   options.algebraic_skip_unchanged_blocks = true;
+
+   nir_def *x = nir_load_var(b, nir_local_variable_create(b->impl, glsl_int_type(), "x"));
+   nir_def *abs = nir_iabs(b, x);
+   nir_push_if(b, nir_ieq_imm(b, x, 3));
+   nir_def *neg = nir_ineg(b, abs);
+   nir_store_var(b, res_var, neg, 0x1);
+   nir_pop_if(b, NULL);
+
+   while (nir_opt_algebraic(b->shader))
+      ;
+   EXPECT_NE(nir_def_block(neg)->algebraic_table, nullptr);
+
+   /* Changing the source of a source in another block still revisits the
+    * block: ineg(ineg(x)) gets folded.
+    */
+   nir_def_as_alu(abs)->op = nir_op_ineg;
+   EXPECT_TRUE(nir_opt_algebraic(b->shader));
+
+   nir_foreach_block(block, b->impl) {
+      nir_foreach_instr(instr, block) {
+         if (instr->type == nir_instr_type_intrinsic &&
+             nir_instr_as_intrinsic(instr)->intrinsic == nir_intrinsic_store_deref) {
+            EXPECT_EQ(nir_instr_as_intrinsic(instr)->src[1].ssa, x);
+         }
+      }
+   }
+}
+
 TEST_F(nir_opt_mqsad_test, mqsad)
 {
    options.lower_bitfield_extract = true;
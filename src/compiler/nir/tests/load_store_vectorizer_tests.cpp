@@ -85,6 +85,7 @@ protected:
    unsigned max_components = 4;
    bool overfetch = false;
    int64_t max_hole_size = 0;
+   unsigned max_distance = 0;
 };
 
 std::string
@@ -146,6 +147,7 @@ nir_load_store_vectorize_test::run_vectorizer(nir_variable_mode modes,
    opts.modes = modes;
    opts.robust_modes = robust_modes;
    opts.cb_data = this;
+   opts.max_distance = max_distance;
    bool progress = nir_opt_load_store_vectorize(b->shader, &opts);
 
    if (progress) {
@@ -551,6 +553,27 @@ TEST_F(nir_load_store_vectorize_test, ssbo_load_adjacent)
    EXPECT_INSTR_SWIZZLES(movs[0x2], load, "y");
 }
 
+TEST_F(nir_load_store_vectorize_test, ssbo_load_adjacent_max_distance)
+{
+   create_load(nir_var_mem_ssbo, 0, 0, 0x1);
+   for (unsigned i = 0; i < 8; i++)
+      create_load(nir_var_mem_ssbo, 1, i * 16, 0x10 + i);
+   create_load(nir_var_mem_ssbo, 0, 4, 0x2);
+
+   nir_validate_shader(b->shader, NULL);
+   ASSERT_EQ(count_intrinsics(nir_intrinsic_load_ssbo), 10);
+
+   /* This still makes progress by updating the alignments. */
+   max_distance = 8;
+   run_vectorizer(nir_var_mem_ssbo);
+   ASSERT_EQ(count_intrinsics(nir_intrinsic_load_ssbo), 10);
+
+   max_distance = 0;
+   EXPECT_TRUE(run_vectorizer(nir_var_mem_ssbo));
+
+   ASSERT_EQ(count_intrinsics(nir_intrinsic_load_ssbo), 9);
+}
+
 TEST_F(nir_load_store_vectorize_test, ssbo_load_adjacent_indirect)
 {
    nir_def *index_base = nir_load_local_invocation_index(b);
@@ -200,3 +200,47 @@ UNROLL_TEST_UNKNOWN_INIT_INSERT(iadd_ugt_unknown_init_eq, int, 16, 4,
                                 ult, iadd, true, TRUE, 6, 0)
 UNROLL_TEST_UNKNOWN_INIT_INSERT(iadd_ige_unknown_init, int, 4, 6,
                                 ige, iadd, false, FALSE, 1, 1)
+
+TEST_F(nir_loop_unroll_test, unroll_factor_for_loads)
+{
+   nir_shader_compiler_options options = *bld.shader->options;
+   options.max_unroll_factor_for_loads = 4;
+   bld.shader->options = &options;
+
+   nir_def *zero = nir_imm_int(&bld, 0);
+   nir_loop *loop = nir_push_loop(&bld);
+
+   nir_block *top_block =
+      nir_cf_node_as_block(nir_cf_node_prev(&loop->cf_node));
+   nir_block *head_block = nir_loop_first_block(loop);
+
+   nir_phi_instr *phi = nir_phi_instr_create(bld.shader);
+   nir_def_init(&phi->instr, &phi->def, 1, 32);
+   nir_phi_instr_add_src(phi, top_block, zero);
+
+   nir_break_if(&bld, nir_ige_imm(&bld, &phi->def, 64));
+
+   nir_def *offset = nir_imul_imm(&bld, &phi->def, 4);
+   nir_def *val = nir_load_ssbo(&bld, 1, 32, zero, offset);
+   nir_store_ssbo(&bld, val, nir_imm_int(&bld, 1), offset);
+
+   nir_def *next = nir_iadd_imm(&bld, &phi->def, 1);
+   nir_phi_instr_add_src(phi, nir_cursor_current_block(bld.cursor), next);
+
+   nir_pop_loop(&bld, loop);
+
+   bld.cursor = nir_after_phis(head_block);
+   nir_builder_instr_insert(&bld, &phi->instr);
+
+   nir_validate_shader(bld.shader, NULL);
+
+   /* 64 iterations are too many to unroll completely. */
+   EXPECT_TRUE(nir_opt_loop_unroll(bld.shader));
+   nir_validate_shader(bld.shader, NULL);
+   nir_opt_dce(bld.shader);
+
+   /* Only the first copy keeps the exit condition. */
+   EXPECT_EQ(1, count_loops());
+   EXPECT_EQ(1, count_instr(nir_op_ige));
+   EXPECT_EQ(4, count_instr(nir_op_iadd));
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "nir_test.h"
+#include "util/u_atomic.h"
+#include "util/u_queue.h"
+
+class nir_opt_functions_parallel_test : public nir_test {
+protected:
+   nir_opt_functions_parallel_test()
+      : nir_test::nir_test("nir_opt_functions_parallel_test")
+   {
+      util_queue_init(&queue, "nir_test", 8, 2, 0, NULL);
+
+      var = nir_variable_create(b->shader, nir_var_shader_temp,
+                                glsl_int_type(), "var");
+
+      helper = nir_function_create(b->shader, "helper");
+      nir_function_impl *impl = nir_function_impl_create(helper);
+      nir_builder hb = nir_builder_at(nir_before_impl(impl));
+      nir_store_deref(&hb, nir_build_deref_var(&hb, var),
+                      nir_imul(&hb, nir_imm_int(&hb, 3), nir_imm_int(&hb, 4)),
+                      0x1);
+
+      nir_store_deref(b, nir_build_deref_var(b, var),
+                      nir_iadd(b, nir_imm_int(b, 1), nir_imm_int(b, 2)),
+                      0x1);
+      nir_build_call(b, helper, 0, NULL);
+   }
+
+   ~nir_opt_functions_parallel_test()
+   {
+      util_queue_destroy(&queue);
+   }
+
+   struct util_queue queue;
+   nir_variable *var;
+   nir_function *helper;
+};
+
+static bool
+fold_constants(nir_shader *shader, void *data)
+{
+   unsigned *num_calls = (unsigned *)data;
+   p_atomic_inc(num_calls);
+
+   /* Each call only gets to see the function it optimizes. */
+   unsigned num_impls = 0;
+   nir_foreach_function_impl(impl, shader)
+      num_impls++;
+   EXPECT_EQ(num_impls, 1);
+   EXPECT_NE(nir_shader_get_entrypoint(shader), nullptr);
+
+   return nir_opt_constant_folding(shader);
+}
+
+TEST_F(nir_opt_functions_parallel_test, fold_each_function)
+{
+   unsigned num_calls = 0;
+   ASSERT_TRUE(nir_opt_functions_parallel(b->shader, &queue,
+                                          fold_constants, &num_calls));
+   EXPECT_EQ(num_calls, 2);
+
+   nir_validate_shader(b->shader, NULL);
+
+   /* Both functions got folded, and still reference the shader's own
+    * variable and functions.
+    */
+   nir_foreach_function_impl(impl, b->shader) {
+      nir_foreach_block(block, impl) {
+         nir_foreach_instr(instr, block) {
+            EXPECT_NE(instr->type, nir_instr_type_alu);
+
+            if (instr->type == nir_instr_type_deref) {
+               nir_deref_instr *deref = nir_instr_as_deref(instr);
+               if (deref->deref_type == nir_deref_type_var) {
+                  EXPECT_EQ(deref->var, var);
+               }
+            } else if (instr->type == nir_instr_type_call) {
+               EXPECT_EQ(nir_instr_as_call(instr)->callee, helper);
+            }
+         }
+      }
+   }
+   EXPECT_EQ(helper->impl->function, helper);
+}
+
+TEST_F(nir_opt_functions_parallel_test, no_progress)
+{
+   ASSERT_TRUE(nir_opt_constant_folding(b->shader));
+
+   nir_function_impl *main_impl = nir_shader_get_entrypoint(b->shader);
+   nir_function_impl *helper_impl = helper->impl;
+
+   unsigned num_calls = 0;
+   EXPECT_FALSE(nir_opt_functions_parallel(b->shader, &queue,
+                                           fold_constants, &num_calls));
+   EXPECT_EQ(num_calls, 2);
+
+   /* Implementations are only replaced when the loop made progress. */
+   EXPECT_EQ(nir_shader_get_entrypoint(b->shader), main_impl);
+   EXPECT_EQ(helper->impl, helper_impl);
+}
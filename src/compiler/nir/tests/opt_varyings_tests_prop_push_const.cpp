@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "nir_opt_varyings_test.h"
+
+class nir_opt_varyings_test_prop_push_const : public nir_opt_varyings_test
+{
+protected:
+   nir_def *build_push_const_expr(nir_builder *b, nir_def *offset)
+   {
+      nir_def *value =
+         nir_load_push_constant(b, 1, 32, offset, .base = 0, .range = 64);
+
+      return nir_fsqrt(b, nir_fmul_imm(b, value, 3.14));
+   }
+
+   nir_intrinsic_instr *store_push_const_expr(nir_def *offset)
+   {
+      return store_output(b1, VARYING_SLOT_VAR0, 0, nir_type_float32,
+                          build_push_const_expr(b1, offset), 0);
+   }
+
+   nir_def *load_and_store_input()
+   {
+      nir_def *input = load_input(b2, VARYING_SLOT_VAR0, 0, nir_type_float32,
+                                  0, INTERP_FLAT);
+      store_output(b2, VARYING_SLOT_VAR0, 0, nir_type_float32, input, 0);
+      return input;
+   }
+
+   bool shader_contains_push_const_load(nir_builder *b)
+   {
+      nir_foreach_block(block, b->impl) {
+         nir_foreach_instr(instr, block) {
+            if (instr->type == nir_instr_type_intrinsic &&
+                nir_instr_as_intrinsic(instr)->intrinsic ==
+                   nir_intrinsic_load_push_constant)
+               return true;
+         }
+      }
+      return false;
+   }
+};
+
+TEST_F(nir_opt_varyings_test_prop_push_const, prop_VERTEX_FRAGMENT)
+{
+   options.io_options = (nir_io_options)(options.io_options |
+                                         nir_io_can_move_push_constants);
+   create_shaders(MESA_SHADER_VERTEX, MESA_SHADER_FRAGMENT);
+
+   nir_intrinsic_instr *store = store_push_const_expr(nir_imm_int(b1, 8));
+   nir_def *input = load_and_store_input();
+
+   ASSERT_TRUE(opt_varyings() == (nir_progress_producer | nir_progress_consumer));
+   ASSERT_TRUE(b1->shader->info.outputs_written == 0);
+   ASSERT_TRUE(!shader_contains_instr(b1, &store->instr));
+   ASSERT_TRUE(b2->shader->info.inputs_read == 0);
+   ASSERT_TRUE(!shader_contains_def(b2, input));
+   ASSERT_TRUE(shader_contains_push_const_load(b2));
+}
+
+TEST_F(nir_opt_varyings_test_prop_push_const, no_prop_without_option)
+{
+   create_shaders(MESA_SHADER_VERTEX, MESA_SHADER_FRAGMENT);
+
+   store_push_const_expr(nir_imm_int(b1, 8));
+   nir_def *input = load_and_store_input();
+
+   opt_varyings();
+   ASSERT_TRUE(b2->shader->info.inputs_read != 0);
+   ASSERT_TRUE(shader_contains_def(b2, input));
+   ASSERT_TRUE(!shader_contains_push_const_load(b2));
+}
+
+TEST_F(nir_opt_varyings_test_prop_push_const, no_prop_indirect)
+{
+   options.io_options = (nir_io_options)(options.io_options |
+                                         nir_io_can_move_push_constants);
+   create_shaders(MESA_SHADER_VERTEX, MESA_SHADER_FRAGMENT);
+
+   store_push_const_expr(nir_imul_imm(b1, nir_load_vertex_id(b1), 4));
+   nir_def *input = load_and_store_input();
+
+   opt_varyings();
+   ASSERT_TRUE(b2->shader->info.inputs_read != 0);
+   ASSERT_TRUE(shader_contains_def(b2, input));
+   ASSERT_TRUE(!shader_contains_push_const_load(b2));
+}
+
+}
@@ -30,6 +30,7 @@
 #include "nir.h"
 #include "nir_spirv.h"
 #include "spirv.h"
+#include "util/os_time.h"
 #include "util/u_dynarray.h"
 #include "vtn_private.h"
 
@@ -102,6 +103,8 @@ print_usage(char *exec_name, FILE *f)
            "  -g, --opengl            Use OpenGL environment instead of Vulkan for\n"
            "                          graphics stages.\n"
            "  --optimize              Run basic NIR optimizations in the result.\n"
+           "  --time <runs>           Translate the shader <runs> times and print\n"
+           "                          timing statistics instead of the result.\n"
            "\n"
            "Passing the stage and the entry-point name is optional unless there's\n"
            "ambiguity, in which case the program will print the entry-points\n"
@@ -188,6 +191,151 @@ select_entry_point(void *mem_ctx, const uint32_t *words, size_t word_count,
    return r;
 }
 
+#define MAX_TIMED_PASSES 16
+
+struct pass_times {
+   unsigned count;
+   struct {
+      const char *name;
+      unsigned calls;
+      int64_t total;
+   } passes[MAX_TIMED_PASSES];
+};
+
+static void
+pass_times_add(struct pass_times *times, const char *name, int64_t time)
+{
+   unsigned i;
+
+   for (i = 0; i < times->count; i++) {
+      if (!strcmp(times->passes[i].name, name))
+         break;
+   }
+
+   if (i == times->count) {
+      assert(times->count < MAX_TIMED_PASSES);
+      times->passes[times->count++].name = name;
+   }
+
+   times->passes[i].calls++;
+   times->passes[i].total += time;
+}
+
+/* Runs basic NIR optimizations, and accumulates the time spent in each pass
+ * into times if it isn't NULL.
+ */
+static void
+optimize_nir(nir_shader *nir, struct pass_times *times)
+{
+   bool progress;
+   do {
+      progress = false;
+
+      #define OPT(pass, ...) ({                                  \
+         int64_t start = times ? os_time_get_nano() : 0;         \
+         bool this_progress = false;                             \
+         NIR_PASS(this_progress, nir, pass, ##__VA_ARGS__);      \
+         if (times)                                              \
+            pass_times_add(times, #pass,                         \
+                           os_time_get_nano() - start);          \
+         if (this_progress)                                      \
+            progress = true;                                     \
+         this_progress;                                          \
+      })
+
+      OPT(nir_opt_dce);
+      OPT(nir_opt_cse);
+      OPT(nir_opt_dead_cf);
+      OPT(nir_lower_vars_to_ssa);
+      OPT(nir_opt_copy_prop);
+      OPT(nir_opt_deref);
+      OPT(nir_opt_constant_folding);
+      OPT(nir_opt_copy_prop_vars);
+      OPT(nir_opt_dead_write_vars);
+      OPT(nir_opt_combine_stores, nir_var_all);
+      OPT(nir_remove_dead_variables, nir_var_function_temp, NULL);
+      OPT(nir_opt_algebraic);
+      OPT(nir_opt_if, 0);
+      OPT(nir_opt_loop_unroll);
+
+      #undef OPT
+   } while (progress);
+}
+
+static int
+compare_times(const void *a, const void *b)
+{
+   int64_t ta = *(const int64_t *)a, tb = *(const int64_t *)b;
+   return ta < tb ? -1 : ta > tb;
+}
+
+static void
+print_time_stats(const char *name, int64_t *times, unsigned runs)
+{
+   int64_t total = 0;
+
+   qsort(times, runs, sizeof(*times), compare_times);
+   for (unsigned i = 0; i < runs; i++)
+      total += times[i];
+
+   #define PERCENTILE(p) (times[(runs - 1) * (p) / 100] / 1000.0)
+   printf("%-14s min %9.1f  p50 %9.1f  p90 %9.1f  p99 %9.1f  max %9.1f  "
+          "total %11.1f us\n",
+          name, PERCENTILE(0), PERCENTILE(50), PERCENTILE(90),
+          PERCENTILE(99), PERCENTILE(100), total / 1000.0);
+   #undef PERCENTILE
+}
+
+static void
+print_timings(const uint32_t *words, size_t word_count,
+              struct entry_point entry_point,
+              const struct spirv_to_nir_options *spirv_opts,
+              const struct nir_shader_compiler_options *nir_opts,
+              bool optimize, unsigned runs)
+{
+   int64_t *translate_times = calloc(runs, sizeof(int64_t));
+   int64_t *optimize_times = calloc(runs, sizeof(int64_t));
+   struct pass_times pass_times = {0};
+
+   for (unsigned i = 0; i < runs; i++) {
+      int64_t start = os_time_get_nano();
+      nir_shader *nir = spirv_to_nir(words, word_count, NULL, 0,
+                                     entry_point.stage, entry_point.name,
+                                     spirv_opts, nir_opts);
+      int64_t translated = os_time_get_nano();
+
+      if (!nir) {
+         fprintf(stderr, "SPIRV to NIR compilation failed\n");
+         goto out;
+      }
+
+      if (optimize)
+         optimize_nir(nir, &pass_times);
+
+      translate_times[i] = translated - start;
+      optimize_times[i] = os_time_get_nano() - translated;
+
+      ralloc_free(nir);
+   }
+
+   printf("%u runs of %s\n", runs, entry_point.name);
+   print_time_stats("spirv_to_nir", translate_times, runs);
+
+   if (optimize) {
+      print_time_stats("optimize", optimize_times, runs);
+
+      for (unsigned i = 0; i < pass_times.count; i++) {
+         printf("  %-28s %8u calls  %11.1f us\n", pass_times.passes[i].name,
+                pass_times.passes[i].calls,
+                pass_times.passes[i].total / 1000.0);
+      }
+   }
+
+out:
+   free(translate_times);
+   free(optimize_times);
+}
+
 int main(int argc, char **argv)
 {
    struct entry_point entry_point = {
@@ -196,6 +344,7 @@ int main(int argc, char **argv)
    };
    int ch;
    bool optimize = false;
+   unsigned time_runs = 0;
    enum nir_spirv_execution_environment env = NIR_SPIRV_VULKAN;
 
    static struct option long_options[] =
@@ -205,6 +354,7 @@ int main(int argc, char **argv)
          {"entry",    required_argument, 0, 'e'},
          {"opengl",   no_argument,       0, 'g'},
          {"optimize", no_argument,       0, 'O'},
+         {"time",     required_argument, 0, 't'},
          {0, 0,                          0, 0}
       };
 
@@ -232,6 +382,13 @@ int main(int argc, char **argv)
       case 'O':
          optimize = true;
          break;
+      case 't':
+         time_runs = strtoul(optarg, NULL, 0);
+         if (!time_runs) {
+            fprintf(stderr, "Invalid number of runs \"%s\"\n", optarg);
+            return 1;
+         }
+         break;
       default:
          fprintf(stderr, "Unrecognized option \"%s\".\n", optarg);
          print_usage(argv[0], stderr);
@@ -288,45 +445,21 @@ int main(int argc, char **argv)
    if (entry_point.stage == MESA_SHADER_KERNEL)
       spirv_opts.environment = NIR_SPIRV_OPENCL;
 
-   nir_shader *nir = spirv_to_nir(map, word_count, NULL, 0,
-                                  entry_point.stage, entry_point.name,
-                                  &spirv_opts, &nir_opts);
-
-   if (nir) {
-      if (optimize) {
-         bool progress;
-         do {
-            progress = false;
-
-            #define OPT(pass, ...) ({                                  \
-               bool this_progress = false;                             \
-               NIR_PASS(this_progress, nir, pass, ##__VA_ARGS__);      \
-               if (this_progress)                                      \
-                  progress = true;                                     \
-               this_progress;                                          \
-            })
-
-            OPT(nir_opt_dce);
-            OPT(nir_opt_cse);
-            OPT(nir_opt_dead_cf);
-            OPT(nir_lower_vars_to_ssa);
-            OPT(nir_opt_copy_prop);
-            OPT(nir_opt_deref);
-            OPT(nir_opt_constant_folding);
-            OPT(nir_opt_copy_prop_vars);
-            OPT(nir_opt_dead_write_vars);
-            OPT(nir_opt_combine_stores, nir_var_all);
-            OPT(nir_remove_dead_variables, nir_var_function_temp, NULL);
-            OPT(nir_opt_algebraic);
-            OPT(nir_opt_if, 0);
-            OPT(nir_opt_loop_unroll);
-
-            #undef OPT
-         } while (progress);
-      }
-      nir_print_shader(nir, stdout);
+   if (time_runs) {
+      print_timings(map, word_count, entry_point, &spirv_opts, &nir_opts,
+                    optimize, time_runs);
    } else {
-      fprintf(stderr, "SPIRV to NIR compilation failed\n");
+      nir_shader *nir = spirv_to_nir(map, word_count, NULL, 0,
+                                     entry_point.stage, entry_point.name,
+                                     &spirv_opts, &nir_opts);
+
+      if (nir) {
+         if (optimize)
+            optimize_nir(nir, NULL);
+         nir_print_shader(nir, stdout);
+      } else {
+         fprintf(stderr, "SPIRV to NIR compilation failed\n");
+      }
    }
 
    glsl_type_singleton_decref();
@@ -536,11 +536,6 @@ vtn_build_cfg(struct vtn_builder *b, const uint32_t *words, const uint32_t *end)
 {
    vtn_foreach_instruction(b, words, end,
                            vtn_cfg_handle_prepass_instruction);
-
-   if (b->shader->info.stage == MESA_SHADER_KERNEL)
-      return;
-
-   vtn_build_structured_cfg(b, words, end);
 }
 
 bool
@@ -781,6 +776,10 @@ vtn_function_emit(struct vtn_builder *b, struct vtn_function *func,
       impl->structured = false;
       vtn_emit_cf_func_unstructured(b, func, instruction_handler);
    } else {
+      /* Only done for functions that actually get emitted, modules often
+       * contain many more than the entry point ends up calling.
+       */
+      vtn_build_structured_cfg(b, func);
       vtn_emit_cf_func_structured(b, func, instruction_handler);
    }
 
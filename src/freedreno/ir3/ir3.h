@@ -2051,7 +2051,9 @@ __ssa_srcp_n(struct ir3_instruction *instr, unsigned n)
 
 #define IR3_PASS(ir, pass, ...)                                                \
    ({                                                                          \
+      int64_t pass_start = ir3_pass_time_start();                              \
       bool progress = pass(ir, ##__VA_ARGS__);                                 \
+      ir3_pass_time_end(#pass, pass_start);                                    \
       if (progress) {                                                          \
          ir3_debug_print(ir, "AFTER: " #pass);                                 \
          ir3_validate(ir);                                                     \
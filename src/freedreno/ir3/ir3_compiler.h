@@ -12,6 +12,7 @@
 #include "compiler/nir/nir.h"
 #include "util/disk_cache.h"
 #include "util/log.h"
+#include "util/os_time.h"
 #include "util/perf/cpu_trace.h"
 
 #include "freedreno_dev_info.h"
@@ -397,6 +398,7 @@ enum ir3_shader_debug {
    IR3_DBG_RAMSGS = BITFIELD_BIT(22),
    IR3_DBG_NOALIASTEX = BITFIELD_BIT(23),
    IR3_DBG_NOALIASRT = BITFIELD_BIT(24),
+   IR3_DBG_PASSTIME = BITFIELD_BIT(25),
 };
 
 extern enum ir3_shader_debug ir3_shader_debug;
@@ -440,6 +442,19 @@ ir3_debug_print(struct ir3 *ir, const char *when)
    }
 }
 
+static inline int64_t
+ir3_pass_time_start(void)
+{
+   return (ir3_shader_debug & IR3_DBG_PASSTIME) ? os_time_get_nano() : 0;
+}
+
+static inline void
+ir3_pass_time_end(const char *pass, int64_t start)
+{
+   if (ir3_shader_debug & IR3_DBG_PASSTIME)
+      mesa_logi("%s: %.3f ms", pass, (os_time_get_nano() - start) / 1000000.0);
+}
+
 /* Return the debug flags that influence shader codegen and should be included
  * in the hash key. Note that we use a deny list so that we don't accidentally
  * forget to include new flags.
@@ -452,7 +467,8 @@ ir3_shader_debug_hash_key()
       ~(IR3_DBG_SHADER_VS | IR3_DBG_SHADER_TCS | IR3_DBG_SHADER_TES |
         IR3_DBG_SHADER_GS | IR3_DBG_SHADER_FS | IR3_DBG_SHADER_CS |
         IR3_DBG_DISASM | IR3_DBG_OPTMSGS | IR3_DBG_NOCACHE |
-        IR3_DBG_SHADER_INTERNAL | IR3_DBG_SCHEDMSGS | IR3_DBG_RAMSGS));
+        IR3_DBG_SHADER_INTERNAL | IR3_DBG_SCHEDMSGS | IR3_DBG_RAMSGS |
+        IR3_DBG_PASSTIME));
 }
 
 /* Returns a pointer to internal static tmp buffer. */
@@ -5907,7 +5907,9 @@ ir3_compile_shader_nir(struct ir3_compiler *compiler,
    /* At this point, all the dead code should be long gone: */
    assert(!IR3_PASS(ir, ir3_dce, so));
 
+   int64_t start = ir3_pass_time_start();
    ret = ir3_sched(ir);
+   ir3_pass_time_end("ir3_sched", start);
    if (ret) {
       DBG("SCHED failed!");
       goto out;
@@ -5949,7 +5951,9 @@ ir3_compile_shader_nir(struct ir3_compiler *compiler,
    }
 
    IR3_PASS(ir, ir3_cleanup_rpt, so);
+   start = ir3_pass_time_start();
    ret = ir3_ra(so);
+   ir3_pass_time_end("ir3_ra", start);
 
    if (ret) {
       mesa_loge("ir3_ra() failed!");
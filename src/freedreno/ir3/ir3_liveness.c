@@ -17,9 +17,13 @@
  *   treated very differently by RA at the beginning of a block.
  */
 
+/* Marks the predecessors whose live_out changed in "dirty", as they need to
+ * be processed again.
+ */
 static bool
 compute_block_liveness(struct ir3_liveness *live, struct ir3_block *block,
                        BITSET_WORD *tmp_live, unsigned bitset_words,
+                       BITSET_WORD *dirty,
                        reg_filter_cb filter_src, reg_filter_cb filter_dst)
 {
    memcpy(tmp_live, live->live_out[block->index],
@@ -61,9 +65,10 @@ compute_block_liveness(struct ir3_liveness *live, struct ir3_block *block,
    bool progress = false;
    for (unsigned i = 0; i < block->predecessors_count; i++) {
       const struct ir3_block *pred = block->predecessors[i];
+      bool pred_progress = false;
       for (unsigned j = 0; j < bitset_words; j++) {
          if (tmp_live[j] & ~live->live_out[pred->index][j])
-            progress = true;
+            pred_progress = true;
          live->live_out[pred->index][j] |= tmp_live[j];
       }
 
@@ -77,10 +82,15 @@ compute_block_liveness(struct ir3_liveness *live, struct ir3_block *block,
             continue;
          unsigned name = phi->srcs[i]->def->name;
          if (!BITSET_TEST(live->live_out[pred->index], name)) {
-            progress = true;
+            pred_progress = true;
             BITSET_SET(live->live_out[pred->index], name);
          }
       }
+
+      if (pred_progress) {
+         BITSET_SET(dirty, pred->index);
+         progress = true;
+      }
    }
 
    for (unsigned i = 0; i < block->physical_predecessors_count; i++) {
@@ -91,6 +101,7 @@ compute_block_liveness(struct ir3_liveness *live, struct ir3_block *block,
          if (!(reg->flags & IR3_REG_SHARED))
             continue;
          if (!BITSET_TEST(live->live_out[pred->index], name)) {
+            BITSET_SET(dirty, pred->index);
             progress = true;
             BITSET_SET(live->live_out[pred->index], name);
          }
@@ -138,15 +149,30 @@ ir3_calc_liveness_for(void *mem_ctx, struct ir3 *ir, reg_filter_cb filter_src,
          rzalloc_array(live, BITSET_WORD, bitset_words);
    }
 
+   /* Only blocks whose live_out changed since they were last processed need
+    * to be processed again, which makes a big difference for large shaders
+    * with loops, where most blocks would otherwise be walked once more for
+    * every iteration of the fixed point.
+    */
+   const unsigned dirty_words = BITSET_WORDS(block_count);
+   BITSET_WORD *dirty = ralloc_array(live, BITSET_WORD, dirty_words);
+   memset(dirty, 0xff, dirty_words * sizeof(BITSET_WORD));
+
    bool progress = true;
    while (progress) {
       progress = false;
       foreach_block_rev (block, &ir->block_list) {
+         if (!BITSET_TEST(dirty, block->index))
+            continue;
+
+         BITSET_CLEAR(dirty, block->index);
          progress |= compute_block_liveness(live, block, tmp_live, bitset_words,
-                                            filter_src, filter_dst);
+                                            dirty, filter_src, filter_dst);
       }
    }
 
+   ralloc_free(dirty);
+
    return live;
 }
 
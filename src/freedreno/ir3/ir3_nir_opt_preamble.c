@@ -32,31 +32,7 @@ def_size(nir_def *def, unsigned *size, unsigned *align,
 static bool
 all_uses_float(nir_def *def, bool allow_src2)
 {
-   nir_foreach_use_including_if (use, def) {
-      if (nir_src_is_if(use))
-         return false;
-
-      nir_instr *use_instr = nir_src_parent_instr(use);
-      if (use_instr->type != nir_instr_type_alu)
-         return false;
-      nir_alu_instr *use_alu = nir_instr_as_alu(use_instr);
-      unsigned src_index = ~0;
-      for  (unsigned i = 0; i < nir_op_infos[use_alu->op].num_inputs; i++) {
-         if (&use_alu->src[i].src == use) {
-            src_index = i;
-            break;
-         }
-      }
-
-      assert(src_index != ~0);
-      nir_alu_type src_type =
-         nir_alu_type_get_base_type(nir_op_infos[use_alu->op].input_types[src_index]);
-
-      if (src_type != nir_type_float || (src_index == 2 && !allow_src2))
-         return false;
-   }
-
-   return true;
+   return nir_def_all_uses_are_float_alu_srcs(def, allow_src2 ? ~0u : 0x3);
 }
 
 static bool
@@ -2789,12 +2789,16 @@ ir3_ra(struct ir3_shader_variant *v)
    ctx->compiler = v->compiler;
    ctx->stage = v->type;
 
+   int64_t start = ir3_pass_time_start();
    struct ir3_liveness *live = ir3_calc_liveness(ctx, v->ir);
+   ir3_pass_time_end("ir3_calc_liveness", start);
 
    ir3_debug_print(v->ir, "AFTER: create_parallel_copies");
 
+   start = ir3_pass_time_start();
    ir3_index_instrs_for_merge_sets(v->ir);
    ir3_merge_regs(live, v->ir);
+   ir3_pass_time_end("ir3_merge_regs", start);
 
    bool has_shared_vectors = false;
    foreach_block (block, &v->ir->block_list) {
@@ -2835,7 +2839,9 @@ ir3_ra(struct ir3_shader_variant *v)
    if (max_pressure.shared + max_pressure.shared_half > limit_pressure.shared ||
        (max_pressure.shared_half > 0 && max_pressure.shared > limit_pressure.shared_half) ||
        has_shared_vectors) {
+      start = ir3_pass_time_start();
       ir3_ra_shared(v, &live);
+      ir3_pass_time_end("ir3_ra_shared", start);
       ir3_calc_pressure(v, live, &max_pressure);
 
       ir3_debug_print(v->ir, "AFTER: shared register allocation");
@@ -2877,8 +2883,10 @@ ir3_ra(struct ir3_shader_variant *v)
 
    ctx->full.start = ctx->half.start = ctx->shared.start = 0;
 
+   start = ir3_pass_time_start();
    foreach_block (block, &v->ir->block_list)
       handle_block(ctx, block);
+   ir3_pass_time_end("ir3_ra (allocation)", start);
 
    ir3_ra_validate(v, ctx->full.size, ctx->half.size, live->block_count, false);
 
@@ -11,6 +11,9 @@
 #include "tu_image.h"
 #include "tu_pass.h"
 
+#include "util/blob.h"
+#include "util/disk_cache.h"
+
 #define XXH_INLINE_ALL
 #include "util/xxhash.h"
 
@@ -57,6 +60,8 @@ tu_autotune_free_results_locked(struct tu_device *dev, struct list_head *results
 #define MAX_HISTORY_RESULTS 5
 /* For how many submissions we store renderpass stats. */
 #define MAX_HISTORY_LIFETIME 128
+/* How many renderpasses we remember across runs. */
+#define MAX_STORED_HISTORY 1024
 
 
 /**
@@ -202,10 +207,115 @@ free_history(struct tu_device *dev, struct tu_renderpass_history *history)
    free(history);
 }
 
+/* The stored history stays valid for as long as the disk cache does, which
+ * is keyed by the driver build and GPU, so the key just needs to be fixed.
+ */
+static void
+stored_history_cache_key(struct disk_cache *cache, cache_key key)
+{
+   static const char name[] = "tu_autotune_history";
+   disk_cache_compute_key(cache, name, sizeof(name), key);
+}
+
+static void
+load_stored_history(struct tu_autotune *at)
+{
+   struct disk_cache *cache = at->device->physical_device->vk.disk_cache;
+   if (!cache)
+      return;
+
+   cache_key key;
+   stored_history_cache_key(cache, key);
+
+   size_t size;
+   void *data = disk_cache_get(cache, key, &size);
+   if (!data)
+      return;
+
+   struct blob_reader blob;
+   blob_reader_init(&blob, data, size);
+
+   const uint32_t count = blob_read_uint32(&blob);
+   for (uint32_t i = 0; i < count && !blob.overrun; i++) {
+      const uint64_t rp_key = blob_read_uint64(&blob);
+      const uint32_t avg_samples = blob_read_uint32(&blob);
+      if (blob.overrun)
+         break;
+
+      /* 0 can't be told apart from a missing entry, which is fine as
+       * renderpasses that pass no samples don't need a stored history.
+       */
+      if (avg_samples)
+         _mesa_hash_table_u64_insert(at->stored_history, rp_key,
+                                     (void *)(uintptr_t) avg_samples);
+   }
+
+   free(data);
+
+   if (TU_AUTOTUNE_DEBUG_LOG)
+      mesa_logi("Loaded %u stored history entries",
+                _mesa_hash_table_u64_num_entries(at->stored_history));
+}
+
+/**
+ * Writes the history of the renderpasses seen in this run, and as much of
+ * the previously stored one as fits, to the disk cache.
+ */
+static void
+store_history(struct tu_autotune *at)
+{
+   struct disk_cache *cache = at->device->physical_device->vk.disk_cache;
+   if (!cache)
+      return;
+
+   struct blob blob;
+   blob_init(&blob);
+
+   uint32_t count = 0;
+   intptr_t count_offset = blob_reserve_uint32(&blob);
+
+   hash_table_foreach(at->ht, entry) {
+      struct tu_renderpass_history *history =
+         (struct tu_renderpass_history *) entry->data;
+      if (count == MAX_STORED_HISTORY)
+         break;
+      if (!history->num_results || !history->avg_samples)
+         continue;
+
+      blob_write_uint64(&blob, history->key);
+      blob_write_uint32(&blob, history->avg_samples);
+      count++;
+   }
+
+   hash_table_u64_foreach(at->stored_history, entry) {
+      if (count == MAX_STORED_HISTORY)
+         break;
+
+      if (_mesa_hash_table_search(at->ht, &entry.key))
+         continue;
+
+      blob_write_uint64(&blob, entry.key);
+      blob_write_uint32(&blob, (uint32_t)(uintptr_t) entry.data);
+      count++;
+   }
+
+   blob_overwrite_uint32(&blob, count_offset, count);
+
+   if (!blob.out_of_memory) {
+      cache_key key;
+      stored_history_cache_key(cache, key);
+      disk_cache_put(cache, key, blob.data, blob.size, NULL);
+   }
+
+   blob_finish(&blob);
+}
+
 static bool
-get_history(struct tu_autotune *at, uint64_t rp_key, uint32_t *avg_samples)
+get_history(struct tu_autotune *at, uint64_t rp_key, uint32_t *avg_samples,
+            bool *stored)
 {
    bool has_history = false;
+   *stored = false;
 
    /* If the lock contantion would be found in the wild -
     * we could use try_lock here.
@@ -223,6 +333,12 @@ get_history(struct tu_autotune *at, uint64_t rp_key, uint32_t *avg_samples)
    }
    u_rwlock_rdunlock(&at->ht_lock);
 
+   if (!has_history && at->stored_history) {
+      *avg_samples = (uint32_t)(uintptr_t)
+         _mesa_hash_table_u64_search(at->stored_history, rp_key);
+      has_history = *stored = *avg_samples != 0;
+   }
+
    return has_history;
 }
 
@@ -428,6 +544,9 @@ tu_autotune_init(struct tu_autotune *at, struct tu_device *dev)
    /* start from 1 because tu6_global::autotune_fence is initialized to 0 */
    at->fence_counter = 1;
 
+   at->stored_history = _mesa_hash_table_u64_create(NULL);
+   load_stored_history(at);
+
    return VK_SUCCESS;
 }
 
@@ -449,6 +568,11 @@ tu_autotune_fini(struct tu_autotune *at, struct tu_device *dev)
       }
    }
 
+   /* Entries that got removed for not being used in a while are lost,
+    * which is alright since they are the least likely to be needed again.
+    */
+   store_history(at);
+
    tu_autotune_free_results(dev, &at->pending_results);
 
    mtx_lock(&dev->autotune_mutex);
@@ -470,6 +594,7 @@ tu_autotune_fini(struct tu_autotune *at, struct tu_device *dev)
    }
 
    _mesa_hash_table_destroy(at->ht, NULL);
+   _mesa_hash_table_u64_destroy(at->stored_history);
    u_rwlock_destroy(&at->ht_lock);
 }
 
@@ -576,8 +701,15 @@ tu_autotune_use_bypass(struct tu_autotune *at,
    bool simultaneous_use =
       cmd_buffer->usage_flags & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
 
-   if (!at->enabled || simultaneous_use)
-      return fallback_use_bypass(pass, framebuffer, cmd_buffer);
+   if (!at->enabled || simultaneous_use) {
+      const bool use_bypass =
+         fallback_use_bypass(pass, framebuffer, cmd_buffer);
+      if (use_bypass) {
+         cmd_buffer->state.rp.gmem_disable_reason =
+            "Autotune selected sysmem (disabled)";
+      }
+      return use_bypass;
+   }
 
    /* We use 64bit hash as a key since we don't fear rare hash collision,
     * the worst that would happen is sysmem being selected when it should
@@ -593,7 +725,8 @@ tu_autotune_use_bypass(struct tu_autotune *at,
    *autotune_result = create_history_result(at, renderpass_key);
 
    uint32_t avg_samples = 0;
-   if (get_history(at, renderpass_key, &avg_samples)) {
+   bool stored_history;
+   if (get_history(at, renderpass_key, &avg_samples, &stored_history)) {
       const uint32_t pass_pixel_count =
          get_render_pass_pixel_count(cmd_buffer);
       uint64_t sysmem_bandwidth =
@@ -620,10 +753,11 @@ tu_autotune_use_bypass(struct tu_autotune *at,
             (float)cmd_buffer->state.rp.drawcall_bandwidth_per_sample_sum /
             cmd_buffer->state.rp.drawcall_count;
 
-         mesa_logi("autotune %016" PRIx64 ":%u selecting %s",
+         mesa_logi("autotune %016" PRIx64 ":%u selecting %s%s",
                renderpass_key,
                cmd_buffer->state.rp.drawcall_count,
-               select_sysmem ? "sysmem" : "gmem");
+               select_sysmem ? "sysmem" : "gmem",
+               stored_history ? " (stored history)" : "");
          mesa_logi("   avg_samples=%u, draw_bandwidth_per_sample=%.2f, total_draw_call_bandwidth=%" PRIu64,
                avg_samples,
                drawcall_bandwidth_per_sample,
@@ -636,10 +770,22 @@ tu_autotune_use_bypass(struct tu_autotune *at,
                sysmem_bandwidth, gmem_bandwidth);
       }
 
+      /* Shows up as tilingDisableReason of the render_pass tracepoint. */
+      if (select_sysmem) {
+         cmd_buffer->state.rp.gmem_disable_reason = stored_history ?
+            "Autotune selected sysmem (stored history)" :
+            "Autotune selected sysmem";
+      }
+
       return select_sysmem;
    }
 
-   return fallback_use_bypass(pass, framebuffer, cmd_buffer);
+   const bool use_bypass = fallback_use_bypass(pass, framebuffer, cmd_buffer);
+   if (use_bypass) {
+      cmd_buffer->state.rp.gmem_disable_reason =
+         "Autotune selected sysmem (no history)";
+   }
+   return use_bypass;
 }
 
 template <chip CHIP>
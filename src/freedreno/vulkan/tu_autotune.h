@@ -60,6 +60,14 @@ struct tu_autotune {
    struct hash_table *ht;
    struct u_rwlock ht_lock;
 
+   /**
+    * Average sample counts of renderpasses seen in previous runs, loaded
+    * from the disk cache at init and never modified afterwards, so it is
+    * read without locking.  Used for renderpasses that have no history in
+    * this run yet.
+    */
+   struct hash_table_u64 *stored_history;
+
    /**
     * List of per-renderpass results that we are waiting for the GPU
     * to finish with before reading back the results.
@@ -413,7 +413,7 @@ tu_emit_cache_flush(struct tu_cmd_buffer *cmd_buffer)
 
    if ((flushes & TU_CMD_FLAG_WAIT_FOR_BR) && CHIP >= A7XX &&
        !(cmd_buffer->state.pass && cmd_buffer->state.renderpass_cb_disabled) &&
-       !TU_DEBUG(NO_CONCURRENT_BINNING)) {
+       !tu_concurrent_binning_disabled(cmd_buffer->device)) {
       trace_start_concurrent_binning_barrier(&cmd_buffer->trace, cs, cmd_buffer);
 
       /* Wait-for-BR when repeated a lot of times per frame can add up
@@ -1352,10 +1352,7 @@ use_sysmem_rendering(struct tu_cmd_buffer *cmd,
       list_addtail(&(*autotune_result)->node, &cmd->renderpass_autotune_results);
    }
 
-   if (use_sysmem) {
-      cmd->state.rp.gmem_disable_reason = "Autotune selected sysmem";
-   }
-
+   /* gmem_disable_reason is set by the autotuner when it picks sysmem. */
    return use_sysmem;
 }
 
@@ -2916,7 +2913,10 @@ tu7_emit_concurrent_binning_start(struct tu_cmd_buffer *cmd,
           (!cmd->state.lrz.fast_clear && cmd->state.lrz.image_view), cmd,
           "LRZ fast clear disabled") ||
        tu7_cb_disable_reason(TU_DEBUG(NO_CONCURRENT_BINNING), cmd,
-                             "TU_DEBUG(NO_CONCURRENT_BINNING)")) {
+                             "TU_DEBUG(NO_CONCURRENT_BINNING)") ||
+       tu7_cb_disable_reason(
+          cmd->device->physical_device->instance->disable_concurrent_binning,
+          cmd, "tu_disable_concurrent_binning driconf")) {
      tu_cs_emit_pkt7(cs, CP_THREAD_CONTROL, 1);
      tu_cs_emit(cs, CP_THREAD_CONTROL_0_THREAD(CP_SET_THREAD_BR) |
                     CP_THREAD_CONTROL_0_CONCURRENT_BIN_DISABLE);
@@ -1795,6 +1795,7 @@ static const driOptionDescription tu_dri_options[] = {
       DRI_CONF_TU_USE_TEX_COORD_ROUND_NEAREST_EVEN_MODE(false)
       DRI_CONF_TU_IGNORE_FRAG_DEPTH_DIRECTION(false)
       DRI_CONF_TU_ENABLE_SOFTFLOAT32(false)
+      DRI_CONF_TU_DISABLE_CONCURRENT_BINNING(false)
    DRI_CONF_SECTION_END
 };
 
@@ -1825,6 +1826,8 @@ tu_init_dri_options(struct tu_instance *instance)
          driQueryOptionb(&instance->dri_options, "tu_ignore_frag_depth_direction");
    instance->enable_softfloat32 =
          driQueryOptionb(&instance->dri_options, "tu_enable_softfloat32");
+   instance->disable_concurrent_binning =
+         driQueryOptionb(&instance->dri_options, "tu_disable_concurrent_binning");
 }
 
 static uint32_t instance_count = 0;
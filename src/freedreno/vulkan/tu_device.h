@@ -233,6 +233,12 @@ struct tu_instance
     * However we don't want native Vulkan apps using this.
     */
    bool enable_softfloat32;
+
+   /* Concurrent binning can be slower when the binning pass (BV) keeps
+    * waiting on the rendering (BR), e.g. with many render passes that
+    * depend on each other.
+    */
+   bool disable_concurrent_binning;
 };
 VK_DEFINE_HANDLE_CASTS(tu_instance, vk.base, VkInstance,
                        VK_OBJECT_TYPE_INSTANCE)
@@ -600,6 +606,13 @@ tu_physical_device_get_global_priority_properties(const struct tu_physical_devic
 uint64_t
 tu_device_ticks_to_ns(struct tu_device *dev, uint64_t ts);
 
+static inline bool
+tu_concurrent_binning_disabled(const struct tu_device *device)
+{
+   return TU_DEBUG(NO_CONCURRENT_BINNING) ||
+          device->physical_device->instance->disable_concurrent_binning;
+}
+
 static inline struct tu_bo *
 tu_device_lookup_bo(struct tu_device *device, uint32_t handle)
 {
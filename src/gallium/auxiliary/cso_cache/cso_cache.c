@@ -30,38 +30,80 @@
 
 #include "util/u_debug.h"
 
+#include "util/hash_table.h"
+#include "util/os_time.h"
+#include "util/simple_mtx.h"
+#include "util/u_atomic.h"
 #include "util/u_memory.h"
+#include "pipe/p_screen.h"
 
 #include "cso_cache.h"
 #include "cso_hash.h"
 
 
+static void
+delete_driver_state(struct pipe_context *pipe, void *data,
+                    enum cso_cache_type type)
+{
+   switch (type) {
+   case CSO_BLEND:
+      pipe->delete_blend_state(pipe, data);
+      break;
+   case CSO_SAMPLER:
+      pipe->delete_sampler_state(pipe, data);
+      break;
+   case CSO_DEPTH_STENCIL_ALPHA:
+      pipe->delete_depth_stencil_alpha_state(pipe, data);
+      break;
+   case CSO_RASTERIZER:
+      pipe->delete_rasterizer_state(pipe, data);
+      break;
+   case CSO_VELEMENTS:
+      pipe->delete_vertex_elements_state(pipe, data);
+      break;
+   default:
+      assert(0);
+   }
+}
+
+
 /* Default delete callback. It can also be used by custom callbacks. */
 void
 cso_delete_state(struct pipe_context *pipe, void *state,
                  enum cso_cache_type type)
 {
+   void *data;
+   bool shared;
+
    switch (type) {
    case CSO_BLEND:
-      pipe->delete_blend_state(pipe, ((struct cso_blend*)state)->data);
+      data = ((struct cso_blend*)state)->data;
+      shared = ((struct cso_blend*)state)->shared;
       break;
    case CSO_SAMPLER:
-      pipe->delete_sampler_state(pipe, ((struct cso_sampler*)state)->data);
+      data = ((struct cso_sampler*)state)->data;
+      shared = ((struct cso_sampler*)state)->shared;
       break;
    case CSO_DEPTH_STENCIL_ALPHA:
-      pipe->delete_depth_stencil_alpha_state(pipe,
-                           ((struct cso_depth_stencil_alpha*)state)->data);
+      data = ((struct cso_depth_stencil_alpha*)state)->data;
+      shared = ((struct cso_depth_stencil_alpha*)state)->shared;
       break;
    case CSO_RASTERIZER:
-      pipe->delete_rasterizer_state(pipe, ((struct cso_rasterizer*)state)->data);
+      data = ((struct cso_rasterizer*)state)->data;
+      shared = ((struct cso_rasterizer*)state)->shared;
       break;
    case CSO_VELEMENTS:
-      pipe->delete_vertex_elements_state(pipe, ((struct cso_velements*)state)->data);
+      data = ((struct cso_velements*)state)->data;
+      shared = ((struct cso_velements*)state)->shared;
       break;
    default:
-      assert(0);
+      UNREACHABLE("invalid CSO type");
    }
 
+   /* States shared with other contexts are deleted with the screen cache. */
+   if (!shared)
+      delete_driver_state(pipe, data, type);
+
    FREE(state);
 }
 
@@ -205,3 +247,238 @@ cso_cache_set_delete_cso_callback(struct cso_cache *sc,
    sc->delete_cso = delete_cso;
    sc->delete_cso_ctx = ctx;
 }
+
+
+/*
+ * Screen-wide cache.
+ *
+ * The entries use the same structures as the per-context caches, with
+ * shared = false since the screen cache owns their data.
+ */
+
+struct cso_screen_cache {
+   struct pipe_screen *screen;
+   unsigned refcount; /**< protected by screen_caches_mtx */
+
+   simple_mtx_t mtx;
+   struct cso_hash hashes[CSO_CACHE_MAX];
+   int max_size;
+
+   unsigned hits, misses;
+};
+
+static simple_mtx_t screen_caches_mtx = SIMPLE_MTX_INITIALIZER;
+static struct hash_table *screen_caches;
+
+static const size_t cso_state_size[CSO_CACHE_MAX] = {
+   [CSO_RASTERIZER] = sizeof(struct cso_rasterizer),
+   [CSO_BLEND] = sizeof(struct cso_blend),
+   [CSO_DEPTH_STENCIL_ALPHA] = sizeof(struct cso_depth_stencil_alpha),
+   [CSO_SAMPLER] = sizeof(struct cso_sampler),
+   [CSO_VELEMENTS] = sizeof(struct cso_velements),
+};
+
+static void **
+cso_state_data(void *state, enum cso_cache_type type)
+{
+   switch (type) {
+   case CSO_BLEND:
+      return &((struct cso_blend*)state)->data;
+   case CSO_SAMPLER:
+      return &((struct cso_sampler*)state)->data;
+   case CSO_DEPTH_STENCIL_ALPHA:
+      return &((struct cso_depth_stencil_alpha*)state)->data;
+   case CSO_RASTERIZER:
+      return &((struct cso_rasterizer*)state)->data;
+   case CSO_VELEMENTS:
+      return &((struct cso_velements*)state)->data;
+   default:
+      UNREACHABLE("invalid CSO type");
+   }
+}
+
+
+/**
+ * Returns the screen cache of the screen, creating it if this is the first
+ * context of the screen using it.  Each call must be paired with a
+ * cso_screen_cache_release().
+ */
+struct cso_screen_cache *
+cso_screen_cache_acquire(struct pipe_screen *screen)
+{
+   struct cso_screen_cache *cache = NULL;
+
+   simple_mtx_lock(&screen_caches_mtx);
+
+   if (!screen_caches)
+      screen_caches = _mesa_pointer_hash_table_create(NULL);
+   if (!screen_caches)
+      goto out;
+
+   struct hash_entry *entry = _mesa_hash_table_search(screen_caches, screen);
+   if (entry) {
+      cache = entry->data;
+      cache->refcount++;
+      goto out;
+   }
+
+   cache = CALLOC_STRUCT(cso_screen_cache);
+   if (!cache)
+      goto out;
+
+   cache->screen = screen;
+   cache->refcount = 1;
+   cache->max_size = 4096;
+   simple_mtx_init(&cache->mtx, mtx_plain);
+   for (int i = 0; i < CSO_CACHE_MAX; i++)
+      cso_hash_init(&cache->hashes[i]);
+
+   _mesa_hash_table_insert(screen_caches, screen, cache);
+
+out:
+   simple_mtx_unlock(&screen_caches_mtx);
+   return cache;
+}
+
+
+/**
+ * Drops the reference of a context to the screen cache.  The last context
+ * deletes all of the states, which is why the other contexts first wait for
+ * their pending work, that may still reference them, to be done.
+ */
+void
+cso_screen_cache_release(struct cso_screen_cache *cache,
+                         struct pipe_context *pipe)
+{
+   struct pipe_screen *screen = cache->screen;
+
+   simple_mtx_lock(&screen_caches_mtx);
+   bool last = --cache->refcount == 0;
+   if (last)
+      _mesa_hash_table_remove_key(screen_caches, screen);
+   simple_mtx_unlock(&screen_caches_mtx);
+
+   if (!last) {
+      struct pipe_fence_handle *fence = NULL;
+
+      pipe->flush(pipe, &fence, 0);
+      if (fence) {
+         screen->fence_finish(screen, NULL, fence, OS_TIMEOUT_INFINITE);
+         screen->fence_reference(screen, &fence, NULL);
+      }
+      return;
+   }
+
+   for (int i = 0; i < CSO_CACHE_MAX; i++) {
+      struct cso_hash_iter iter = cso_hash_first_node(&cache->hashes[i]);
+      while (!cso_hash_iter_is_null(iter)) {
+         void *state = cso_hash_iter_data(iter);
+         iter = cso_hash_iter_next(iter);
+         cso_delete_state(pipe, state, i);
+      }
+      cso_hash_deinit(&cache->hashes[i]);
+   }
+
+   simple_mtx_destroy(&cache->mtx);
+   FREE(cache);
+}
+
+
+static void *
+screen_cache_search_locked(struct cso_screen_cache *cache,
+                           enum cso_cache_type type, unsigned hash_key,
+                           const void *templ, unsigned key_size)
+{
+   struct cso_hash_iter iter = cso_hash_find(&cache->hashes[type], hash_key);
+
+   while (!cso_hash_iter_is_null(iter)) {
+      void *state = cso_hash_iter_data(iter);
+      if (!memcmp(state, templ, key_size))
+         return *cso_state_data(state, type);
+      iter = cso_hash_iter_next(iter);
+   }
+   return NULL;
+}
+
+
+/**
+ * Returns the driver state matching the first key_size bytes of templ, or
+ * NULL if no context created it yet.
+ */
+void *
+cso_screen_cache_find(struct cso_screen_cache *cache,
+                      enum cso_cache_type type, unsigned hash_key,
+                      const void *templ, unsigned key_size)
+{
+   simple_mtx_lock(&cache->mtx);
+   void *data = screen_cache_search_locked(cache, type, hash_key, templ,
+                                           key_size);
+   simple_mtx_unlock(&cache->mtx);
+
+   if (data)
+      p_atomic_inc(&cache->hits);
+   else
+      p_atomic_inc(&cache->misses);
+
+   return data;
+}
+
+
+/**
+ * Hands the driver state *data, which the context just created after
+ * cso_screen_cache_find() missed, over to the screen cache.
+ *
+ * If another context inserted the same state in the meantime, *data is
+ * deleted and replaced by the state of the cache.  Returns false if the
+ * cache is full, in which case *data stays owned by the context.
+ */
+bool
+cso_screen_cache_insert(struct cso_screen_cache *cache,
+                        struct pipe_context *pipe,
+                        enum cso_cache_type type, unsigned hash_key,
+                        const void *templ, unsigned key_size, void **data)
+{
+   simple_mtx_lock(&cache->mtx);
+
+   void *existing = screen_cache_search_locked(cache, type, hash_key, templ,
+                                               key_size);
+   if (existing) {
+      simple_mtx_unlock(&cache->mtx);
+      delete_driver_state(pipe, *data, type);
+      *data = existing;
+      return true;
+   }
+
+   if (cso_hash_size(&cache->hashes[type]) >= cache->max_size) {
+      simple_mtx_unlock(&cache->mtx);
+      return false;
+   }
+
+   void *state = CALLOC(1, cso_state_size[type]);
+   if (!state) {
+      simple_mtx_unlock(&cache->mtx);
+      return false;
+   }
+
+   memcpy(state, templ, key_size);
+   *cso_state_data(state, type) = *data;
+
+   struct cso_hash_iter iter = cso_hash_insert(&cache->hashes[type],
+                                               hash_key, state);
+   simple_mtx_unlock(&cache->mtx);
+
+   if (cso_hash_iter_is_null(iter)) {
+      FREE(state);
+      return false;
+   }
+   return true;
+}
+
+
+void
+cso_screen_cache_get_stats(struct cso_screen_cache *cache,
+                           unsigned *hits, unsigned *misses)
+{
+   *hits = p_atomic_read(&cache->hits);
+   *misses = p_atomic_read(&cache->misses);
+}
@@ -118,21 +118,25 @@ struct cso_cache {
 struct cso_blend {
    struct pipe_blend_state state;
    void *data;
+   bool shared; /**< data is owned by the cso_screen_cache */
 };
 
 struct cso_depth_stencil_alpha {
    struct pipe_depth_stencil_alpha_state state;
    void *data;
+   bool shared; /**< data is owned by the cso_screen_cache */
 };
 
 struct cso_rasterizer {
    struct pipe_rasterizer_state state;
    void *data;
+   bool shared; /**< data is owned by the cso_screen_cache */
 };
 
 struct cso_sampler {
    struct pipe_sampler_state state;
    void *data;
+   bool shared; /**< data is owned by the cso_screen_cache */
    unsigned hash_key;
 };
 
@@ -144,6 +148,7 @@ struct cso_velems_state {
 struct cso_velements {
    struct cso_velems_state state;
    void *data;
+   bool shared; /**< data is owned by the cso_screen_cache */
 };
 
 
@@ -175,6 +180,39 @@ cso_delete_state(struct pipe_context *pipe, void *state,
                  enum cso_cache_type type);
 
 
+/**
+ * Screen-wide cache of the non-shader CSOs, shared by all the cso_contexts
+ * of a screen exposing pipe_caps.shareable_csos, so that a state used by
+ * several contexts is only created once.
+ *
+ * The cache is only looked up when the per-context cache misses.  Its
+ * states live until the last context releases the cache.
+ */
+struct cso_screen_cache;
+
+struct cso_screen_cache *
+cso_screen_cache_acquire(struct pipe_screen *screen);
+
+void
+cso_screen_cache_release(struct cso_screen_cache *cache,
+                         struct pipe_context *pipe);
+
+void *
+cso_screen_cache_find(struct cso_screen_cache *cache,
+                      enum cso_cache_type type, unsigned hash_key,
+                      const void *templ, unsigned key_size);
+
+bool
+cso_screen_cache_insert(struct cso_screen_cache *cache,
+                        struct pipe_context *pipe,
+                        enum cso_cache_type type, unsigned hash_key,
+                        const void *templ, unsigned key_size, void **data);
+
+void
+cso_screen_cache_get_stats(struct cso_screen_cache *cache,
+                           unsigned *hits, unsigned *misses);
+
+
 static ALWAYS_INLINE unsigned
 cso_construct_key(const void *key, int key_size)
 {
@@ -124,6 +124,9 @@ struct cso_context_priv {
    unsigned min_samples, min_samples_saved;
    struct pipe_stencil_ref stencil_ref, stencil_ref_saved;
 
+   /** Screen cache shared with the other contexts, if any */
+   struct cso_screen_cache *screen_cache;
+
    /* This should be last to keep all of the above together in memory. */
    struct cso_cache cache;
 };
@@ -166,6 +169,39 @@ delete_cso(struct cso_context_priv *ctx,
 }
 
 
+/**
+ * Looks a state that is missing from the context cache up in the screen
+ * cache, so that it doesn't have to be created again.
+ */
+static inline void *
+find_shared_state(struct cso_context_priv *ctx, enum cso_cache_type type,
+                  unsigned hash_key, const void *state, unsigned key_size)
+{
+   if (!ctx->screen_cache)
+      return NULL;
+
+   return cso_screen_cache_find(ctx->screen_cache, type, hash_key, state,
+                                key_size);
+}
+
+
+/**
+ * Hands a state that was just created by this context over to the screen
+ * cache.  Returns whether the screen cache now owns *data.
+ */
+static inline bool
+share_state(struct cso_context_priv *ctx, enum cso_cache_type type,
+            unsigned hash_key, const void *state, unsigned key_size,
+            void **data)
+{
+   if (!ctx->screen_cache)
+      return false;
+
+   return cso_screen_cache_insert(ctx->screen_cache, ctx->base.pipe, type,
+                                  hash_key, state, key_size, data);
+}
+
+
 static inline void
 sanitize_hash(struct cso_hash *hash, enum cso_cache_type type,
               int max_size, void *user_data)
@@ -293,6 +329,9 @@ cso_create_context(struct pipe_context *pipe, unsigned flags)
    ctx->base.pipe = pipe;
    ctx->sample_mask = ~0;
 
+   if (pipe->screen->caps.shareable_csos)
+      ctx->screen_cache = cso_screen_cache_acquire(pipe->screen);
+
    if (!(flags & CSO_NO_VBUF))
       cso_init_vbuf(ctx, flags);
 
@@ -484,6 +523,8 @@ cso_destroy_context(struct cso_context *cso)
 
    cso_unbind_context(cso);
    cso_cache_delete(&ctx->cache);
+   if (ctx->screen_cache)
+      cso_screen_cache_release(ctx->screen_cache, ctx->base.pipe);
 
    if (ctx->vbuf)
       u_vbuf_destroy(ctx->vbuf);
@@ -493,6 +534,24 @@ cso_destroy_context(struct cso_context *cso)
 }
 
 
+/**
+ * Returns how many of the states missing from the context cache were found
+ * in the screen cache, or false if the context doesn't use one.
+ */
+bool
+cso_get_screen_cache_stats(struct cso_context *cso,
+                           unsigned *hits, unsigned *misses)
+{
+   struct cso_context_priv *ctx = (struct cso_context_priv *)cso;
+
+   if (!ctx->screen_cache)
+      return false;
+
+   cso_screen_cache_get_stats(ctx->screen_cache, hits, misses);
+   return true;
+}
+
+
 /* Those function will either find the state of the given template
  * in the cache or they will create a new state from the given
  * template, insert it in the cache and return it.
@@ -538,7 +597,15 @@ cso_set_blend(struct cso_context *cso,
 
       memset(&cso->state, 0, sizeof cso->state);
       memcpy(&cso->state, templ, key_size);
-      cso->data = ctx->base.pipe->create_blend_state(ctx->base.pipe, &cso->state);
+      cso->data = find_shared_state(ctx, CSO_BLEND, hash_key, &cso->state,
+                                    key_size);
+      cso->shared = cso->data != NULL;
+      if (!cso->data) {
+         cso->data = ctx->base.pipe->create_blend_state(ctx->base.pipe,
+                                                        &cso->state);
+         cso->shared = share_state(ctx, CSO_BLEND, hash_key, &cso->state,
+                                   key_size, &cso->data);
+      }
 
       iter = cso_insert_state(&ctx->cache, hash_key, CSO_BLEND, cso);
       if (cso_hash_iter_is_null(iter)) {
@@ -598,8 +665,15 @@ cso_set_depth_stencil_alpha(struct cso_context *cso,
          return PIPE_ERROR_OUT_OF_MEMORY;
 
       memcpy(&cso->state, templ, sizeof(*templ));
-      cso->data = ctx->base.pipe->create_depth_stencil_alpha_state(ctx->base.pipe,
-                                                              &cso->state);
+      cso->data = find_shared_state(ctx, CSO_DEPTH_STENCIL_ALPHA, hash_key,
+                                    &cso->state, key_size);
+      cso->shared = cso->data != NULL;
+      if (!cso->data) {
+         cso->data = ctx->base.pipe->create_depth_stencil_alpha_state(ctx->base.pipe,
+                                                                 &cso->state);
+         cso->shared = share_state(ctx, CSO_DEPTH_STENCIL_ALPHA, hash_key,
+                                   &cso->state, key_size, &cso->data);
+      }
 
       iter = cso_insert_state(&ctx->cache, hash_key,
                               CSO_DEPTH_STENCIL_ALPHA, cso);
@@ -666,7 +740,15 @@ cso_set_rasterizer(struct cso_context *cso,
          return PIPE_ERROR_OUT_OF_MEMORY;
 
       memcpy(&cso->state, templ, sizeof(*templ));
-      cso->data = ctx->base.pipe->create_rasterizer_state(ctx->base.pipe, &cso->state);
+      cso->data = find_shared_state(ctx, CSO_RASTERIZER, hash_key,
+                                    &cso->state, key_size);
+      cso->shared = cso->data != NULL;
+      if (!cso->data) {
+         cso->data = ctx->base.pipe->create_rasterizer_state(ctx->base.pipe,
+                                                             &cso->state);
+         cso->shared = share_state(ctx, CSO_RASTERIZER, hash_key,
+                                   &cso->state, key_size, &cso->data);
+      }
 
       iter = cso_insert_state(&ctx->cache, hash_key, CSO_RASTERIZER, cso);
       if (cso_hash_iter_is_null(iter)) {
@@ -1272,15 +1354,22 @@ cso_get_vertex_elements(struct cso_context_priv *ctx,
          return NULL;
 
       memcpy(&cso->state, velems, key_size);
-
-      /* Lower 64-bit vertex attributes. */
-      unsigned new_count = velems->count;
-      const struct pipe_vertex_element *new_elems = velems->velems;
-      struct pipe_vertex_element tmp[PIPE_MAX_ATTRIBS];
-      util_lower_uint64_vertex_elements(&new_elems, &new_count, tmp);
-
-      cso->data = ctx->base.pipe->create_vertex_elements_state(ctx->base.pipe, new_count,
-                                                          new_elems);
+      cso->data = find_shared_state(ctx, CSO_VELEMENTS, hash_key,
+                                    &cso->state, key_size);
+      cso->shared = cso->data != NULL;
+      if (!cso->data) {
+         /* Lower 64-bit vertex attributes. */
+         unsigned new_count = velems->count;
+         const struct pipe_vertex_element *new_elems = velems->velems;
+         struct pipe_vertex_element tmp[PIPE_MAX_ATTRIBS];
+         util_lower_uint64_vertex_elements(&new_elems, &new_count, tmp);
+
+         cso->data = ctx->base.pipe->create_vertex_elements_state(ctx->base.pipe,
+                                                                  new_count,
+                                                                  new_elems);
+         cso->shared = share_state(ctx, CSO_VELEMENTS, hash_key,
+                                   &cso->state, key_size, &cso->data);
+      }
 
       iter = cso_insert_state(&ctx->cache, hash_key, CSO_VELEMENTS, cso);
       if (cso_hash_iter_is_null(iter)) {
@@ -1461,7 +1550,15 @@ set_sampler(struct cso_context_priv *ctx, mesa_shader_stage shader_stage,
          return NULL;
 
       memcpy(&cso->state, templ, sizeof(*templ));
-      cso->data = ctx->base.pipe->create_sampler_state(ctx->base.pipe, &cso->state);
+      cso->data = find_shared_state(ctx, CSO_SAMPLER, hash_key, &cso->state,
+                                    key_size);
+      cso->shared = cso->data != NULL;
+      if (!cso->data) {
+         cso->data = ctx->base.pipe->create_sampler_state(ctx->base.pipe,
+                                                          &cso->state);
+         cso->shared = share_state(ctx, CSO_SAMPLER, hash_key, &cso->state,
+                                   key_size, &cso->data);
+      }
       cso->hash_key = hash_key;
 
       iter = cso_insert_state(&ctx->cache, hash_key, CSO_SAMPLER, cso);
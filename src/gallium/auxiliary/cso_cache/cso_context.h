@@ -59,6 +59,10 @@ cso_unbind_context(struct cso_context *ctx);
 void
 cso_destroy_context(struct cso_context *cso);
 
+bool
+cso_get_screen_cache_stats(struct cso_context *cso,
+                           unsigned *hits, unsigned *misses);
+
 enum pipe_error
 cso_set_blend(struct cso_context *cso, const struct pipe_blend_state *blend);
 
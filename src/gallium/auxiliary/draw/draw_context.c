@@ -79,6 +79,17 @@ draw_create_context(struct pipe_context *pipe, void *context,
    if (try_llvm && draw_get_option_use_llvm()) {
       draw->llvm = draw_llvm_create(draw, (lp_context_ref *)context);
    }
+
+   /* The calling thread runs a part of the vertex shader work itself, so
+    * the queue only needs the remaining threads.
+    */
+   unsigned num_vs_threads = debug_get_num_option("DRAW_VS_THREADS", 0);
+   if (draw->llvm && num_vs_threads > 1) {
+      num_vs_threads = MIN2(num_vs_threads, DRAW_MAX_VS_THREADS);
+      util_queue_init(&draw->vs_queue, "draw_vs", DRAW_MAX_VS_THREADS,
+                      num_vs_threads - 1,
+                      UTIL_QUEUE_INIT_SPIN_BEFORE_WAIT, NULL);
+   }
 #endif
 
    draw->pipe = pipe;
@@ -223,6 +234,8 @@ draw_destroy(struct draw_context *draw)
    draw_vs_destroy(draw);
    draw_gs_destroy(draw);
 #if DRAW_LLVM_AVAILABLE
+   if (util_queue_is_initialized(&draw->vs_queue))
+      util_queue_destroy(&draw->vs_queue);
    if (draw->llvm)
       draw_llvm_destroy(draw->llvm);
 #endif
@@ -44,6 +44,7 @@
 #include "pipe/p_state.h"
 #include "pipe/p_defines.h"
 #include "pipe/p_shader_tokens.h"
+#include "util/u_queue.h"
 
 #include "draw_vertex_header.h"
 
@@ -123,6 +124,9 @@ struct draw_vertex_buffer {
 /* maximum number of shader variants we can cache */
 #define DRAW_MAX_SHADER_VARIANTS 512
 
+/* maximum number of threads running the vertex shader of one draw */
+#define DRAW_MAX_VS_THREADS 8
+
 struct draw_buffer_info {
    const void *ptr;
    unsigned size;
@@ -374,6 +378,11 @@ struct draw_context
    unsigned constant_buffer_stride;
    struct draw_llvm *llvm;
 
+   /** Worker threads running the vertex shader on parts of large draws,
+    * initialized only if DRAW_VS_THREADS asks for more than one thread.
+    */
+   struct util_queue vs_queue;
+
    /** Texture sampler and sampler view state.
     * Note that we have arrays indexed by shader type.  At this time
     * we only handle vertex and geometry shaders in the draw module, but
@@ -489,6 +489,121 @@ emit(struct pt_emit *emit,
 }
 
 
+/* Smallest part of a draw worth handing to another thread. */
+#define LLVM_VS_MIN_VERTICES_PER_JOB 256
+
+struct llvm_vs_job {
+   struct llvm_middle_end *fpme;
+   struct vertex_header *verts;
+   unsigned count;
+   unsigned start;
+   unsigned vertex_id_offset;
+   const unsigned *elts;
+   bool clipped;
+   struct util_queue_fence fence;
+};
+
+
+static void
+llvm_vs_job_execute(void *data, void *gdata, int thread_index)
+{
+   struct llvm_vs_job *job = data;
+   struct llvm_middle_end *fpme = job->fpme;
+   struct draw_context *draw = fpme->draw;
+
+   job->clipped = fpme->current_variant->jit_func(&fpme->llvm->vs_jit_context,
+                                                  &fpme->llvm->jit_resources[MESA_SHADER_VERTEX],
+                                                  job->verts,
+                                                  draw->pt.user.vbuffer,
+                                                  job->count,
+                                                  job->start,
+                                                  fpme->vertex_size,
+                                                  draw->pt.vertex_buffer,
+                                                  draw->instance_id,
+                                                  job->vertex_id_offset,
+                                                  draw->start_instance,
+                                                  job->elts,
+                                                  draw->pt.user.drawid,
+                                                  draw->pt.user.viewid);
+}
+
+
+/**
+ * Run fetch and vertex shader for all vertices of fetch_info.
+ *
+ * With a vs_queue, large draws are cut into parts which run in parallel.
+ * The jitted function only reads the shared context and writes the
+ * vertices it is given, and a vertex's results don't depend on where the
+ * part it is in starts: linear parts just start further into the vertex
+ * buffers, indexed ones further into the elts.  Everything after the
+ * vertex shader still runs on the calling thread, in primitive order.
+ */
+static bool
+llvm_pipeline_run_vs(struct llvm_middle_end *fpme,
+                     const struct draw_fetch_info *fetch_info,
+                     struct vertex_header *verts)
+{
+   struct draw_context *draw = fpme->draw;
+   struct llvm_vs_job jobs[DRAW_MAX_VS_THREADS];
+   unsigned num_jobs = 1;
+   unsigned vertices_per_job = fetch_info->count;
+
+   if (util_queue_is_initialized(&draw->vs_queue)) {
+      unsigned max_jobs = draw->vs_queue.num_threads + 1;
+
+      num_jobs = MIN2(fetch_info->count / LLVM_VS_MIN_VERTICES_PER_JOB,
+                      max_jobs);
+      num_jobs = MAX2(num_jobs, 1);
+      /* Only the last part may end with a partial vector, the others would
+       * store the unused lanes over the next part's first vertices.
+       */
+      vertices_per_job = align(DIV_ROUND_UP(fetch_info->count, num_jobs),
+                               lp_native_vector_width / 32);
+   }
+
+   unsigned first = 0;
+   for (unsigned i = 0; i < num_jobs && first < fetch_info->count; i++) {
+      struct llvm_vs_job *job = &jobs[i];
+
+      job->fpme = fpme;
+      job->verts = (struct vertex_header *)
+         ((char *)verts + first * fpme->vertex_size);
+      job->count = MIN2(vertices_per_job, fetch_info->count - first);
+
+      if (fetch_info->linear) {
+         job->start = fetch_info->start + first;
+         job->vertex_id_offset = draw->start_index;
+         job->elts = NULL;
+      } else {
+         job->start = draw->pt.user.eltMax;
+         job->vertex_id_offset = draw->pt.user.eltBias;
+         job->elts = fetch_info->elts + first;
+      }
+
+      first += job->count;
+      num_jobs = i + 1;
+   }
+
+   /* Hand all but the first part to the queue, the first one is ours. */
+   for (unsigned i = 1; i < num_jobs; i++) {
+      util_queue_fence_init(&jobs[i].fence);
+      util_queue_add_job(&draw->vs_queue, &jobs[i], &jobs[i].fence,
+                         llvm_vs_job_execute, NULL, 0);
+   }
+
+   llvm_vs_job_execute(&jobs[0], NULL, 0);
+   bool clipped = jobs[0].clipped;
+
+   for (unsigned i = 1; i < num_jobs; i++) {
+      util_queue_fence_wait(&jobs[i].fence);
+      util_queue_fence_destroy(&jobs[i].fence);
+      clipped |= jobs[i].clipped;
+   }
+
+   return clipped;
+}
+
+
 static void
 llvm_pipeline_generic(struct draw_pt_middle_end *middle,
                       const struct draw_fetch_info *fetch_info,
@@ -540,33 +655,8 @@ llvm_pipeline_generic(struct draw_pt_middle_end *middle,
    }
 
    {
-      unsigned start, vertex_id_offset;
-      const unsigned *elts;
-
-      if (fetch_info->linear) {
-         start = fetch_info->start;
-         vertex_id_offset = draw->start_index;
-         elts = NULL;
-      } else {
-         start = draw->pt.user.eltMax;
-         vertex_id_offset = draw->pt.user.eltBias;
-         elts = fetch_info->elts;
-      }
       /* Run vertex fetch shader */
-      clipped = fpme->current_variant->jit_func(&fpme->llvm->vs_jit_context,
-                                                &fpme->llvm->jit_resources[MESA_SHADER_VERTEX],
-                                                llvm_vert_info.verts,
-                                                draw->pt.user.vbuffer,
-                                                fetch_info->count,
-                                                start,
-                                                fpme->vertex_size,
-                                                draw->pt.vertex_buffer,
-                                                draw->instance_id,
-                                                vertex_id_offset,
-                                                draw->start_instance,
-                                                elts,
-                                                draw->pt.user.drawid,
-                                                draw->pt.user.viewid);
+      clipped = llvm_pipeline_run_vs(fpme, fetch_info, llvm_vert_info.verts);
 
       /* Finished with fetch and vs */
       fetch_info = NULL;
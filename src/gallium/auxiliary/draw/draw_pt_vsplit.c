@@ -34,7 +34,14 @@
 #include "draw/draw_pt.h"
 
 #define SEGMENT_SIZE 1024
-#define MAP_SIZE     256
+
+/* The fetch -> draw element map is direct mapped.  It is sized for the
+ * segment at hand, with twice as many entries as the segment has elements
+ * so that indices with poor locality rarely evict each other, up to
+ * DRAW_VSPLIT_CACHE_SIZE entries.
+ */
+#define MIN_MAP_SIZE 256
+#define MAX_MAP_SIZE (2 * SEGMENT_SIZE)
 
 struct vsplit_frontend {
    struct draw_pt_front_end base;
@@ -46,6 +53,7 @@ struct vsplit_frontend {
 
    unsigned max_vertices;
    uint16_t segment_size;
+   unsigned max_map_size;
 
    /* buffers for splitting */
    unsigned fetch_elts[SEGMENT_SIZE];
@@ -54,8 +62,9 @@ struct vsplit_frontend {
 
    struct {
       /* map a fetch element to a draw element */
-      unsigned fetches[MAP_SIZE];
-      uint16_t draws[MAP_SIZE];
+      unsigned fetches[MAX_MAP_SIZE];
+      uint16_t draws[MAX_MAP_SIZE];
+      unsigned map_mask;
       bool has_max_fetch;
 
       uint16_t num_fetch_elts;
@@ -65,9 +74,15 @@ struct vsplit_frontend {
 
 
 static void
-vsplit_clear_cache(struct vsplit_frontend *vsplit)
+vsplit_clear_cache(struct vsplit_frontend *vsplit, unsigned num_elts)
 {
-   memset(vsplit->cache.fetches, 0xff, sizeof(vsplit->cache.fetches));
+   unsigned map_size = util_next_power_of_two(MAX2(2 * num_elts,
+                                                   MIN_MAP_SIZE));
+   map_size = MIN2(map_size, vsplit->max_map_size);
+
+   memset(vsplit->cache.fetches, 0xff,
+          map_size * sizeof(vsplit->cache.fetches[0]));
+   vsplit->cache.map_mask = map_size - 1;
    vsplit->cache.has_max_fetch = false;
    vsplit->cache.num_fetch_elts = 0;
    vsplit->cache.num_draw_elts = 0;
@@ -91,7 +106,7 @@ vsplit_add_cache(struct vsplit_frontend *vsplit, unsigned fetch)
 {
    unsigned hash;
 
-   hash = fetch % MAP_SIZE;
+   hash = fetch & vsplit->cache.map_mask;
 
    /* If the value isn't in the cache or it's an overflow due to the
     * element bias */
@@ -130,7 +145,7 @@ vsplit_add_cache_uint8(struct vsplit_frontend *vsplit, const uint8_t *elts,
    elt_idx = (unsigned)((int)(DRAW_GET_IDX(elts, elt_idx)) + elt_bias);
    /* unlike the uint32_t case this can only happen with elt_bias */
    if (elt_bias && elt_idx == DRAW_MAX_FETCH_IDX && !vsplit->cache.has_max_fetch) {
-      unsigned hash = elt_idx % MAP_SIZE;
+      unsigned hash = elt_idx & vsplit->cache.map_mask;
       vsplit->cache.fetches[hash] = 0;
       vsplit->cache.has_max_fetch = true;
    }
@@ -148,7 +163,7 @@ vsplit_add_cache_uint16(struct vsplit_frontend *vsplit, const uint16_t *elts,
    elt_idx = (unsigned)((int)(DRAW_GET_IDX(elts, elt_idx)) + elt_bias);
    /* unlike the uint32_t case this can only happen with elt_bias */
    if (elt_bias && elt_idx == DRAW_MAX_FETCH_IDX && !vsplit->cache.has_max_fetch) {
-      unsigned hash = elt_idx % MAP_SIZE;
+      unsigned hash = elt_idx & vsplit->cache.map_mask;
       vsplit->cache.fetches[hash] = 0;
       vsplit->cache.has_max_fetch = true;
    }
@@ -173,7 +188,7 @@ vsplit_add_cache_uint32(struct vsplit_frontend *vsplit, const uint32_t *elts,
    elt_idx = (unsigned)((int)(DRAW_GET_IDX(elts, elt_idx)) + elt_bias);
    /* Take care for DRAW_MAX_FETCH_IDX (since cache is initialized to -1). */
    if (elt_idx == DRAW_MAX_FETCH_IDX && !vsplit->cache.has_max_fetch) {
-      unsigned hash = elt_idx % MAP_SIZE;
+      unsigned hash = elt_idx & vsplit->cache.map_mask;
       /* force update - any value will do except DRAW_MAX_FETCH_IDX */
       vsplit->cache.fetches[hash] = 0;
       vsplit->cache.has_max_fetch = true;
@@ -270,6 +285,11 @@ draw_pt_vsplit(struct draw_context *draw)
    vsplit->base.destroy = vsplit_destroy;
    vsplit->draw = draw;
 
+   unsigned map_size = debug_get_num_option("DRAW_VSPLIT_CACHE_SIZE",
+                                            MAX_MAP_SIZE);
+   map_size = CLAMP(map_size, MIN_MAP_SIZE, MAX_MAP_SIZE);
+   vsplit->max_map_size = util_next_power_of_two(map_size);
+
    for (unsigned i = 0; i < SEGMENT_SIZE; i++)
       vsplit->identity_draw_elts[i] = i;
 
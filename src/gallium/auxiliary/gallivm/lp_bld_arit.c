@@ -114,10 +114,14 @@ lp_build_min_simple(struct lp_build_context *bld,
             intrinsic = "llvm.x86.sse.min.ps";
             intr_size = 128;
          }
-         else {
+         else if (type.length <= 8 || !util_get_cpu_caps()->has_avx512f) {
             intrinsic = "llvm.x86.avx.min.ps.256";
             intr_size = 256;
          }
+         /* For 512-bit vectors leave it to the generic compare + select
+          * below, which LLVM matches to a single vmin/vmaxps on zmm rather
+          * than two split 256-bit intrinsics.
+          */
       }
       if (type.width == 64 && util_get_cpu_caps()->has_sse2) {
          if (type.length == 1) {
@@ -268,10 +272,14 @@ lp_build_max_simple(struct lp_build_context *bld,
             intrinsic = "llvm.x86.sse.max.ps";
             intr_size = 128;
          }
-         else {
+         else if (type.length <= 8 || !util_get_cpu_caps()->has_avx512f) {
             intrinsic = "llvm.x86.avx.max.ps.256";
             intr_size = 256;
          }
+         /* For 512-bit vectors leave it to the generic compare + select
+          * below, which LLVM matches to a single vmin/vmaxps on zmm rather
+          * than two split 256-bit intrinsics.
+          */
       }
       if (type.width == 64 && util_get_cpu_caps()->has_sse2) {
          if (type.length == 1) {
@@ -1098,6 +1106,45 @@ lp_build_mul_imm(struct lp_build_context *bld,
 }
 
 
+/**
+ * Generate a / b for vectors of 32-bit integers through double precision.
+ *
+ * There are no SIMD integer division instructions, so LLVM scalarizes
+ * vector udiv/sdiv unless the divisor is a constant. Every 32-bit integer
+ * is exact as a double, and the quotient n/d of two of them is at least
+ * 1/n away from the next integer when not exact, which is far above half
+ * a double ulp, so truncating the correctly rounded double quotient gives
+ * the exact integer result.
+ */
+static LLVMValueRef
+lp_build_div_int32_vec(struct lp_build_context *bld,
+                       LLVMValueRef a,
+                       LLVMValueRef b)
+{
+   LLVMBuilderRef builder = bld->gallivm->builder;
+   const struct lp_type type = bld->type;
+   LLVMTypeRef dbl_vec_type =
+      LLVMVectorType(LLVMDoubleTypeInContext(bld->gallivm->context),
+                     type.length);
+   LLVMValueRef res;
+
+   if (type.sign) {
+      a = LLVMBuildSIToFP(builder, a, dbl_vec_type, "");
+      b = LLVMBuildSIToFP(builder, b, dbl_vec_type, "");
+   } else {
+      a = LLVMBuildUIToFP(builder, a, dbl_vec_type, "");
+      b = LLVMBuildUIToFP(builder, b, dbl_vec_type, "");
+   }
+
+   res = LLVMBuildFDiv(builder, a, b, "");
+
+   if (type.sign)
+      return LLVMBuildFPToSI(builder, res, bld->vec_type, "");
+   else
+      return LLVMBuildFPToUI(builder, res, bld->vec_type, "");
+}
+
+
 /**
  * Generate a / b
  */
@@ -1132,7 +1179,13 @@ lp_build_div(struct lp_build_context *bld,
 
    if (type.floating)
       return LLVMBuildFDiv(builder, a, b, "");
-   else if (type.sign)
+
+   if (util_get_cpu_caps()->has_sse2 &&
+       type.width == 32 && type.length > 1 &&
+       !LLVMIsConstant(b))
+      return lp_build_div_int32_vec(bld, a, b);
+
+   if (type.sign)
       return LLVMBuildSDiv(builder, a, b, "");
    else
       return LLVMBuildUDiv(builder, a, b, "");
@@ -3495,7 +3548,13 @@ lp_build_mod(struct lp_build_context *bld,
 
    if (type.floating)
       res = LLVMBuildFRem(builder, x, y, "");
-   else if (type.sign)
+   else if (util_get_cpu_caps()->has_sse2 &&
+            type.width == 32 && type.length > 1 &&
+            !LLVMIsConstant(y)) {
+      /* x - (x / y) * y, with the quotient computed in double precision */
+      res = lp_build_div_int32_vec(bld, x, y);
+      res = LLVMBuildSub(builder, x, LLVMBuildMul(builder, res, y, ""), "");
+   } else if (type.sign)
       res = LLVMBuildSRem(builder, x, y, "");
    else
       res = LLVMBuildURem(builder, x, y, "");
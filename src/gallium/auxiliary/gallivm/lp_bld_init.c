@@ -153,7 +153,8 @@ init_gallivm_engine(struct gallivm_state *gallivm)
       char *error = NULL;
       int ret;
 
-      if (gallivm_perf & GALLIVM_PERF_NO_OPT) {
+      if ((gallivm_perf & GALLIVM_PERF_NO_OPT) ||
+          gallivm_module_is_fast_compile(gallivm->module)) {
          optlevel = None;
       }
       else {
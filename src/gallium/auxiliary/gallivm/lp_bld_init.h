@@ -131,6 +131,12 @@ gallivm_jit_function(struct gallivm_state *gallivm,
 void
 gallivm_stub_func(struct gallivm_state *gallivm, LLVMValueRef func);
 
+void
+gallivm_set_fast_compile(struct gallivm_state *gallivm);
+
+bool
+gallivm_module_is_fast_compile(LLVMModuleRef module);
+
 unsigned gallivm_get_perf_flags(void);
 
 void lp_init_clock_hook(struct gallivm_state *gallivm);
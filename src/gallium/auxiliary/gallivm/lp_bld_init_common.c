@@ -65,11 +65,31 @@ DEBUG_GET_ONCE_FLAGS_OPTION(gallivm_debug, "GALLIVM_DEBUG", lp_bld_debug_flags,
 
 unsigned lp_native_vector_width;
 
+/**
+ * Whether to default to 512-bit (16 x float32) vectors.
+ *
+ * Only do so when the CPU has the full AVX-512 integer and mask register
+ * feature set (BW/DQ/VL) plus VBMI.  That covers Ice Lake and newer Intel
+ * cores and Zen 4+, and excludes Knights Landing (no BW/VL, so 8/16-bit
+ * blend and sampling code falls apart into 256-bit halves) as well as
+ * Skylake-SP/Cascade Lake, where the zmm frequency penalty makes 512-bit
+ * vectors a net loss for llvmpipe.
+ */
+static bool
+lp_build_prefer_512bit_vectors(void)
+{
+   const struct util_cpu_caps_t *caps = util_get_cpu_caps();
+
+   return caps->max_vector_bits >= 512 &&
+          caps->has_avx512f && caps->has_avx512bw && caps->has_avx512dq &&
+          caps->has_avx512vl && caps->has_avx512vbmi;
+}
+
 unsigned
 lp_build_init_native_width(void)
 {
-   // Default to 256 until we're confident llvmpipe with 512 is as correct and not slower than 256
-   lp_native_vector_width = MIN2(util_get_cpu_caps()->max_vector_bits, 256);
+   lp_native_vector_width = MIN2(util_get_cpu_caps()->max_vector_bits,
+                                 lp_build_prefer_512bit_vectors() ? 512 : 256);
    assert(lp_native_vector_width);
 
    lp_native_vector_width = debug_get_num_option("LP_NATIVE_VECTOR_WIDTH", lp_native_vector_width);
@@ -95,6 +115,39 @@ gallivm_get_perf_flags(void)
    return gallivm_perf;
 }
 
+/*
+ * Module flag marking a module as a quick, unoptimized compile.  It is
+ * carried on the module itself since with ORCJIT the IR passes run from
+ * the JIT's transform layer, which only sees the module.
+ */
+static const char gallivm_fast_compile_flag[] = "gallivm.fast_compile";
+
+/**
+ * Compile this module as quickly as possible, like GALLIVM_PERF=nopt does
+ * globally: only the mandatory IR passes get run (LLVM 15+, where the
+ * pipeline is picked per run), and with MCJIT codegen happens at -O0.  Meant for code which will be replaced by an optimized
+ * recompile later.  Must be called before gallivm_compile_module().
+ */
+void
+gallivm_set_fast_compile(struct gallivm_state *gallivm)
+{
+   LLVMValueRef one = LLVMConstInt(LLVMInt32TypeInContext(gallivm->context),
+                                   1, 0);
+
+   assert(gallivm->module);
+   LLVMAddModuleFlag(gallivm->module, LLVMModuleFlagBehaviorOverride,
+                     gallivm_fast_compile_flag,
+                     sizeof(gallivm_fast_compile_flag) - 1,
+                     LLVMValueAsMetadata(one));
+}
+
+bool
+gallivm_module_is_fast_compile(LLVMModuleRef module)
+{
+   return LLVMGetModuleFlag(module, gallivm_fast_compile_flag,
+                            sizeof(gallivm_fast_compile_flag) - 1) != NULL;
+}
+
 void
 lp_init_clock_hook(struct gallivm_state *gallivm)
 {
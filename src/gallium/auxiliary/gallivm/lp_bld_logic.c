@@ -349,6 +349,18 @@ lp_build_select(struct lp_build_context *bld,
 
       res = LLVMBuildSelect(builder, mask, a, b, "");
    }
+   else if (util_get_cpu_caps()->has_avx512f &&
+            type.width * type.length == 512 &&
+            (type.width >= 32 || util_get_cpu_caps()->has_avx512bw)) {
+      /* AVX-512 has no blendv, but a select on a vector of booleans maps
+       * directly onto a masked blend through a k register, which is much
+       * better than the and/andnot/or sequence of the bitwise fallback.
+       */
+      LLVMTypeRef bool_vec_type =
+         LLVMVectorType(LLVMInt1TypeInContext(lc), type.length);
+      mask = LLVMBuildTrunc(builder, mask, bool_vec_type, "");
+      res = LLVMBuildSelect(builder, mask, a, b, "");
+   }
    else if (((util_get_cpu_caps()->has_sse4_1 &&
               type.width * type.length == 128) ||
              (util_get_cpu_caps()->has_avx &&
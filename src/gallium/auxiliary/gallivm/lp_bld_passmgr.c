@@ -28,6 +28,7 @@
 #include "util/u_debug.h"
 #include "util/os_time.h"
 #include "lp_bld_debug.h"
+#include "lp_bld_init.h"
 #include "lp_bld_passmgr.h"
 
 #define USE_NEW_PASS (LLVM_VERSION_MAJOR >= 15)
@@ -149,7 +150,8 @@ lp_passmgr_run(struct lp_passmgr *mgr,
    LLVMPassBuilderOptionsRef opts = LLVMCreatePassBuilderOptions();
    LLVMRunPasses(module, passes, tm, opts);
 
-   if (!(gallivm_perf & GALLIVM_PERF_NO_OPT))
+   if (!(gallivm_perf & GALLIVM_PERF_NO_OPT) &&
+       !gallivm_module_is_fast_compile(module))
 #if LLVM_VERSION_MAJOR >= 18
       strcpy(passes, "sroa,early-cse,simplifycfg,reassociate,mem2reg,instsimplify,instcombine<no-verify-fixpoint>");
 #else
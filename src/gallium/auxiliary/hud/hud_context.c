@@ -998,6 +998,7 @@ hud_pane_add_graph(struct hud_pane *pane, struct hud_graph *gr)
    gr->color[1] = colors[color][1];
    gr->color[2] = colors[color][2];
    gr->pane = pane;
+   gr->shm_index = -1;
    list_addtail(&gr->head, &pane->graph_list);
    pane->num_graphs++;
    pane->next_color++;
@@ -1022,6 +1023,9 @@ hud_graph_add_value(struct hud_graph *gr, double value)
       fprintf(gr->fd, "%s", gr->separator ? gr->separator : "\n");
    }
 
+   if (gr->shm_index >= 0)
+      hud_shm_add_value(gr->pane->hud, gr->shm_index, gr->current_value);
+
    if (gr->index == gr->pane->max_num_vertices) {
       gr->vertices[0] = 0;
       gr->vertices[1] = gr->vertices[(gr->index-1)*2+1];
@@ -1595,6 +1599,13 @@ hud_parse_env_var(struct hud_context *hud, struct pipe_screen *screen,
          }
       }
    }
+
+   /* Export the values to a shared-memory ring for external collectors.
+    * This also works with the HUD hidden by GALLIUM_HUD_VISIBLE.
+    */
+   const char *hud_shm_path = os_get_option("GALLIUM_HUD_SHM");
+   if (hud_shm_path && *hud_shm_path)
+      hud_shm_init(hud, hud_shm_path);
 }
 
 static void
@@ -2116,6 +2127,7 @@ hud_destroy(struct hud_context *hud, struct cso_context *cso)
       hud_unset_draw_context(hud);
 
    if (p_atomic_dec_zero(&hud->refcount)) {
+      hud_shm_destroy(hud);
       pipe_resource_reference(&hud->font.texture, NULL);
       FREE(hud);
    }
@@ -103,6 +103,10 @@ struct hud_context {
    int record_device_x, record_device_y;
 
    bool has_srgb;
+
+   /* GALLIUM_HUD_SHM export, see hud_shm.h */
+   struct hud_shm_header *shm;
+   int shm_fd;
 };
 
 struct hud_graph {
@@ -126,6 +130,7 @@ struct hud_graph {
    double current_value;
    FILE *fd;
    const char *separator;
+   int shm_index; /* -1 if not exported */
 };
 
 struct hud_pane {
@@ -161,6 +166,11 @@ void hud_pane_add_graph(struct hud_pane *pane, struct hud_graph *gr);
 void hud_pane_set_max_value(struct hud_pane *pane, uint64_t value);
 void hud_graph_add_value(struct hud_graph *gr, double value);
 
+/* shared-memory export */
+void hud_shm_init(struct hud_context *hud, const char *path);
+void hud_shm_destroy(struct hud_context *hud);
+void hud_shm_add_value(struct hud_context *hud, unsigned graph, double value);
+
 /* graphs/queries */
 struct hud_batch_query_context;
 
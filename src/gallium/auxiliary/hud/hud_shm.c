@@ -0,0 +1,138 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Export of the HUD values to a shared-memory ring, see hud_shm.h. */
+
+#include "hud/hud_private.h"
+#include "hud/hud_shm.h"
+#include "util/detect_os.h"
+#include "util/os_time.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if DETECT_OS_POSIX
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * Create the ring at \p path and register all graphs of the HUD.
+ * Graphs beyond HUD_SHM_MAX_GRAPHS are not exported.
+ */
+void
+hud_shm_init(struct hud_context *hud, const char *path)
+{
+   struct hud_shm_header *shm;
+   struct hud_pane *pane;
+   struct hud_graph *gr;
+   int fd;
+
+   fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+   if (fd < 0) {
+      fprintf(stderr, "gallium_hud: can't open %s: %s\n", path,
+              strerror(errno));
+      return;
+   }
+
+   /* The ring has a single writer. */
+   if (flock(fd, LOCK_EX | LOCK_NB) < 0) {
+      fprintf(stderr, "gallium_hud: %s is already used by another HUD\n",
+              path);
+      close(fd);
+      return;
+   }
+
+   if (ftruncate(fd, 0) < 0 ||
+       ftruncate(fd, sizeof(*shm)) < 0) {
+      fprintf(stderr, "gallium_hud: can't resize %s: %s\n", path,
+              strerror(errno));
+      close(fd);
+      return;
+   }
+
+   shm = mmap(NULL, sizeof(*shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (shm == MAP_FAILED) {
+      fprintf(stderr, "gallium_hud: can't map %s: %s\n", path,
+              strerror(errno));
+      close(fd);
+      return;
+   }
+
+   LIST_FOR_EACH_ENTRY(pane, &hud->pane_list, head) {
+      LIST_FOR_EACH_ENTRY(gr, &pane->graph_list, head) {
+         if (shm->num_graphs == HUD_SHM_MAX_GRAPHS)
+            break;
+
+         gr->shm_index = shm->num_graphs++;
+         strncpy(shm->graph_names[gr->shm_index], gr->name,
+                 HUD_SHM_NAME_SIZE - 1);
+      }
+   }
+
+   shm->num_records = HUD_SHM_NUM_RECORDS;
+   shm->version = HUD_SHM_VERSION;
+   /* Readers check the magic last. */
+   __atomic_store_n(&shm->magic, HUD_SHM_MAGIC, __ATOMIC_RELEASE);
+
+   hud->shm = shm;
+   hud->shm_fd = fd;
+}
+
+void
+hud_shm_destroy(struct hud_context *hud)
+{
+   if (!hud->shm)
+      return;
+
+   munmap(hud->shm, sizeof(*hud->shm));
+   close(hud->shm_fd);
+   hud->shm = NULL;
+}
+
+void
+hud_shm_add_value(struct hud_context *hud, unsigned graph, double value)
+{
+   struct hud_shm_header *shm = hud->shm;
+   uint64_t n = shm->write_count;
+   struct hud_shm_record *rec = &shm->records[n % HUD_SHM_NUM_RECORDS];
+
+   /* A seqlock per record: readers discard records whose seq changed
+    * while they copied them.
+    */
+   __atomic_store_n(&rec->seq, 2 * n + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+   rec->timestamp_ns = os_time_get_nano();
+   rec->graph = graph;
+   rec->value = value;
+
+   __atomic_store_n(&rec->seq, 2 * n + 2, __ATOMIC_RELEASE);
+   __atomic_store_n(&shm->write_count, n + 1, __ATOMIC_RELEASE);
+}
+
+#else
+
+void
+hud_shm_init(struct hud_context *hud, const char *path)
+{
+   fprintf(stderr, "gallium_hud: GALLIUM_HUD_SHM is not supported on this "
+           "platform\n");
+}
+
+void
+hud_shm_destroy(struct hud_context *hud)
+{
+}
+
+void
+hud_shm_add_value(struct hud_context *hud, unsigned graph, double value)
+{
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Layout of the shared-memory ring written when GALLIUM_HUD_SHM is set.
+ *
+ * This header only depends on <stdint.h> so that external collectors can
+ * include it as is.
+ *
+ * The HUD is the only writer. Every new value of a graph is appended as
+ * one record, and write_count is the total number of records written so
+ * far. Record n lives in records[n % HUD_SHM_NUM_RECORDS]. Its seq is
+ * 2 * n + 1 while the record is being written and 2 * n + 2 once it is
+ * complete.
+ *
+ * A reader never writes to the ring. For each record n it wants to read,
+ * it loads seq with acquire semantics, copies the record, issues an
+ * acquire fence and loads seq again. The copy is valid if both loads
+ * returned 2 * n + 2. A larger seq means that the reader fell behind and
+ * the record was overwritten.
+ */
+
+#ifndef HUD_SHM_H
+#define HUD_SHM_H
+
+#include <stdint.h>
+
+#define HUD_SHM_MAGIC        0x44554853 /* "SHUD" */
+#define HUD_SHM_VERSION      1
+#define HUD_SHM_MAX_GRAPHS   64
+#define HUD_SHM_NAME_SIZE    128
+#define HUD_SHM_NUM_RECORDS  4096 /* must be a power of two */
+
+struct hud_shm_record {
+   uint64_t seq;
+   uint64_t timestamp_ns; /* CLOCK_MONOTONIC */
+   uint32_t graph;        /* index into hud_shm_header::graph_names */
+   uint32_t pad;
+   double value;
+};
+
+struct hud_shm_header {
+   uint32_t magic;
+   uint32_t version;
+   uint32_t num_graphs;
+   uint32_t num_records;
+   uint64_t write_count;
+   char graph_names[HUD_SHM_MAX_GRAPHS][HUD_SHM_NAME_SIZE];
+   struct hud_shm_record records[HUD_SHM_NUM_RECORDS];
+};
+
+#endif /* HUD_SHM_H */
@@ -56,6 +56,15 @@ struct primconvert_context
    struct pipe_context *pipe;
    struct primconvert_config cfg;
    unsigned api_pv;
+
+   /* Index buffers generated for non-indexed draws, see
+    * primconvert_get_generated_indices().
+    */
+   struct {
+      u_generate_func generate;
+      unsigned nr;
+      struct pipe_resource *buffer;
+   } gen_cache[MESA_PRIM_COUNT];
 };
 
 
@@ -81,6 +90,8 @@ util_primconvert_create(struct pipe_context *pipe, uint32_t primtypes_mask)
 void
 util_primconvert_destroy(struct primconvert_context *pc)
 {
+   for (unsigned i = 0; i < ARRAY_SIZE(pc->gen_cache); i++)
+      pipe_resource_reference(&pc->gen_cache[i].buffer, NULL);
    FREE(pc);
 }
 
@@ -102,6 +113,51 @@ util_primconvert_save_flatshade_first(struct primconvert_context *pc, bool flats
    pc->api_pv = flatshade_first ? PV_FIRST : PV_LAST;
 }
 
+/**
+ * Returns an index buffer holding at least the first nr indices produced by
+ * a U_GENERATE_REUSABLE generator starting at 0.  Those are a prefix of the
+ * indices for any larger count, so a single buffer per primitive type is
+ * kept around and only regenerated when it gets too small.
+ */
+static struct pipe_resource *
+primconvert_get_generated_indices(struct primconvert_context *pc,
+                                  enum mesa_prim prim,
+                                  u_generate_func generate,
+                                  unsigned index_size,
+                                  unsigned nr)
+{
+   struct pipe_context *pipe = pc->pipe;
+   struct pipe_transfer *transfer;
+
+   if (pc->gen_cache[prim].buffer &&
+       pc->gen_cache[prim].generate == generate &&
+       pc->gen_cache[prim].nr >= nr)
+      return pc->gen_cache[prim].buffer;
+
+   pipe_resource_reference(&pc->gen_cache[prim].buffer, NULL);
+
+   struct pipe_resource *buffer =
+      pipe_buffer_create(pipe->screen, PIPE_BIND_INDEX_BUFFER,
+                         PIPE_USAGE_IMMUTABLE, index_size * nr);
+   if (!buffer)
+      return NULL;
+
+   void *map = pipe_buffer_map(pipe, buffer, PIPE_MAP_WRITE |
+                               PIPE_MAP_DISCARD_WHOLE_RESOURCE, &transfer);
+   if (!map) {
+      pipe_resource_reference(&buffer, NULL);
+      return NULL;
+   }
+
+   generate(0, nr, map);
+   pipe_buffer_unmap(pipe, transfer);
+
+   pc->gen_cache[prim].generate = generate;
+   pc->gen_cache[prim].nr = nr;
+   pc->gen_cache[prim].buffer = buffer;
+   return buffer;
+}
+
 static bool
 primconvert_init_draw(struct primconvert_context *pc,
                       const struct pipe_draw_info *info,
@@ -212,6 +268,27 @@ primconvert_init_draw(struct primconvert_context *pc,
       enum mesa_prim mode = 0;
       unsigned index_size;
 
+      /* Reusable indices don't depend on the start vertex, so take them from
+       * the cached buffer and apply the start through index_bias instead.
+       */
+      if (u_index_generator(pc->cfg.primtypes_mask,
+                            info->mode, 0, draw.count,
+                            pc->api_pv, pc->api_pv,
+                            &mode, &index_size, &new_draw->count,
+                            &gen_func) == U_GENERATE_REUSABLE) {
+         new_info->mode = mode;
+         new_info->index_size = index_size;
+         new_info->index.resource =
+            primconvert_get_generated_indices(pc, info->mode, gen_func,
+                                              index_size, new_draw->count);
+         if (!new_info->index.resource)
+            return false;
+
+         new_draw->start = 0;
+         new_draw->index_bias = draw.start;
+         return true;
+      }
+
       u_index_generator(pc->cfg.primtypes_mask,
                         info->mode, draw.start, draw.count,
                         pc->api_pv, pc->api_pv,
@@ -39,18 +39,42 @@
  */
 struct pb_cache_entry
 {
-   struct list_head head;
+   struct list_head head; /**< Link in the size class list of the bucket */
+   struct list_head lru;  /**< Link in pb_cache::lru */
    unsigned start_ms; /**< Cached start time */
    unsigned bucket_index;
 };
 
+/* Buffers of each bucket are further split by the log2 of their size, so
+ * that reclaiming only looks at lists that can hold a compatible buffer.
+ * Everything above the last class shares it.
+ */
+#define PB_CACHE_NUM_SIZE_CLASSES 36
+
+struct pb_cache_stats
+{
+   uint64_t num_hits;
+   uint64_t num_misses;
+   uint64_t num_expired;   /**< buffers freed because they got too old */
+   uint64_t wasted_bytes;  /**< sum of the size overhead of all hits */
+   uint64_t cache_size;
+   unsigned num_buffers;
+};
+
 struct pb_cache
 {
    /* The cache is divided into buckets for minimizing cache misses.
     * The driver controls which buffer goes into which bucket.
+    *
+    * This holds num_heaps * PB_CACHE_NUM_SIZE_CLASSES lists.
     */
    struct list_head *buckets;
 
+   /* All cached buffers, oldest first, for releasing expired buffers
+    * without walking every bucket.
+    */
+   struct list_head lru;
+
    simple_mtx_t mutex;
    void *winsys;
    uint64_t cache_size;
@@ -63,6 +87,12 @@ struct pb_cache
    float size_factor;
    unsigned offsetof_pb_cache_entry; /* offsetof(driver_bo, pb_cache_entry) */
 
+   /* Statistics, protected by the mutex */
+   uint64_t num_hits;
+   uint64_t num_misses;
+   uint64_t num_expired;
+   uint64_t wasted_bytes;
+
    void (*destroy_buffer)(void *winsys, struct pb_buffer_lean *buf);
    bool (*can_reclaim)(void *winsys, struct pb_buffer_lean *buf);
 };
@@ -81,5 +111,6 @@ void pb_cache_init(struct pb_cache *mgr, unsigned num_heaps,
                    void (*destroy_buffer)(void *winsys, struct pb_buffer_lean *buf),
                    bool (*can_reclaim)(void *winsys, struct pb_buffer_lean *buf));
 void pb_cache_deinit(struct pb_cache *mgr);
+void pb_cache_get_stats(struct pb_cache *mgr, struct pb_cache_stats *stats);
 
 #endif
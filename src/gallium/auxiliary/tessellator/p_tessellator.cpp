@@ -44,6 +44,13 @@ namespace pipe_tessellator_wrap
       alignas(32) float      domain_points_v[MAX_POINT_COUNT];
       uint32_t               num_domain_points;
 
+      /* Factors used by the last Tessellate() call, whose results are
+       * reused as long as the following patches have the same factors.
+       */
+      bool                   have_last_factors;
+      float                  last_outer_tf[4];
+      float                  last_inner_tf[2];
+
    public:
       void Init(enum mesa_prim tes_prim_mode,
                 enum pipe_tess_spacing ts_spacing,
@@ -70,10 +77,36 @@ namespace pipe_tessellator_wrap
 
          prim_mode          = tes_prim_mode;
          num_domain_points = 0;
+         have_last_factors = false;
       }
 
-      void Tessellate(const struct pipe_tessellation_factors *tess_factors,
-                      struct pipe_tessellator_data *tess_data)
+      bool SameFactors(const struct pipe_tessellation_factors *tess_factors)
+      {
+         unsigned num_outer, num_inner;
+         switch (prim_mode) {
+         case MESA_PRIM_QUADS:
+            num_outer = 4;
+            num_inner = 2;
+            break;
+         case MESA_PRIM_TRIANGLES:
+            num_outer = 3;
+            num_inner = 1;
+            break;
+         default:
+            num_outer = 2;
+            num_inner = 0;
+            break;
+         }
+
+         /* Compare the bits, the same bits always tessellate the same way. */
+         return have_last_factors &&
+                memcmp(last_outer_tf, tess_factors->outer_tf,
+                       num_outer * sizeof(float)) == 0 &&
+                memcmp(last_inner_tf, tess_factors->inner_tf,
+                       num_inner * sizeof(float)) == 0;
+      }
+
+      void TessellateDomain(const struct pipe_tessellation_factors *tess_factors)
       {
          switch (prim_mode)
             {
@@ -113,6 +146,21 @@ namespace pipe_tessellator_wrap
             domain_points_u[i] = points[i].u;
             domain_points_v[i] = points[i].v;
          }
+
+         memcpy(last_outer_tf, tess_factors->outer_tf, sizeof(last_outer_tf));
+         memcpy(last_inner_tf, tess_factors->inner_tf, sizeof(last_inner_tf));
+         have_last_factors = true;
+      }
+
+      void Tessellate(const struct pipe_tessellation_factors *tess_factors,
+                      struct pipe_tessellator_data *tess_data)
+      {
+         /* Patches very often share their factors, e.g. when they come from
+          * constant tessellation levels.
+          */
+         if (!SameFactors(tess_factors))
+            TessellateDomain(tess_factors);
+
          tess_data->num_domain_points = num_domain_points;
          tess_data->domain_points_u = &domain_points_u[0];
          tess_data->domain_points_v = &domain_points_v[0];
@@ -32,6 +32,8 @@
 #include "util/u_cpu_detect.h"
 #include "util/u_math.h"
 #include "util/format/u_format.h"
+#include "util/hash_table.h"
+#include "util/simple_mtx.h"
 
 #include "translate.h"
 
@@ -64,8 +66,8 @@ struct translate_buffer_variant
 
 #define ELEMENT_BUFFER_INSTANCE_ID  1001
 
-#define NUM_FLOAT_CONSTS 9
-#define NUM_UNSIGNED_CONSTS 1
+#define NUM_FLOAT_CONSTS 13
+#define NUM_UNSIGNED_CONSTS 5
 
 enum
 {
@@ -78,8 +80,16 @@ enum
    CONST_INV_4294967295,
    CONST_255,
    CONST_2147483648,
+   CONST_MINUS_1,
+   CONST_2POW112,
+   CONST_2_10_10_10_UNORM,
+   CONST_2_10_10_10_USCALED,
    /* float consts end */
    CONST_2147483647_INT,
+   CONST_7FFF_INT,
+   CONST_7BFF_INT,
+   CONST_7F800000_INT,
+   CONST_2_10_10_10_MASK_INT,
 };
 
 #define C(v) {(float)(v), (float)(v), (float)(v), (float)(v)}
@@ -93,26 +103,59 @@ static float consts[NUM_FLOAT_CONSTS][4] = {
    C(1.0 / 4294967295.0),
    C(255.0),
    C(2147483648.0),
+   C(-1.0),
+   C(0x1p112),
+   /* Each channel of a 2_10_10_10 vertex is scaled down by its shift too. */
+   {1.0 / 1023.0, 1.0 / (1023.0 * 0x1p10), 1.0 / (1023.0 * 0x1p20),
+    1.0 / (3.0 * 0x1p30)},
+   {1.0, 0x1p-10, 0x1p-20, 0x1p-30},
 };
 
 #undef C
 
 static unsigned uconsts[NUM_UNSIGNED_CONSTS][4] = {
    {0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff},
+   {0x7fff, 0x7fff, 0x7fff, 0x7fff},
+   {0x7bff, 0x7bff, 0x7bff, 0x7bff},
+   {0x7f800000, 0x7f800000, 0x7f800000, 0x7f800000},
+   {0x3ff, 0x3ff << 10, 0x3ff << 20, 0x3u << 30},
 };
 
-struct translate_sse
+/**
+ * The generated code of a key.
+ *
+ * The code only addresses the translate_sse it is called with, never the
+ * one it was built for, so all translates of the process with the same key
+ * share it.  Programs nobody uses stay around for the next context asking
+ * for them, unless there are already MAX_CACHED_PROGRAMS of them.
+ */
+struct translate_sse_program
 {
-   struct translate translate;
+   struct translate_key key;
+   unsigned refcount;           /**< protected by program_cache_mtx */
 
    struct x86_function linear_func;
    struct x86_function elt_func;
    struct x86_function elt16_func;
    struct x86_function elt8_func;
+};
+
+#define MAX_CACHED_PROGRAMS 256
+
+static simple_mtx_t program_cache_mtx = SIMPLE_MTX_INITIALIZER;
+static struct hash_table *program_cache;
+
+
+struct translate_sse
+{
+   struct translate translate;
+
+   struct translate_sse_program *program;
    struct x86_function *func;
 
    alignas(16) float consts[NUM_FLOAT_CONSTS][4];
    alignas(16) float uconsts[NUM_UNSIGNED_CONSTS][4];
+   alignas(16) float scratch[4];
    int8_t reg_to_const[16];
    int8_t const_to_reg[NUM_FLOAT_CONSTS + NUM_UNSIGNED_CONSTS];
 
@@ -471,6 +514,72 @@ emit_memcpy(struct translate_sse *p, struct x86_reg dst, struct x86_reg src,
    }
 }
 
+/**
+ * Convert the half floats in the low word of each dword of data to floats.
+ *
+ * The exponent and mantissa are moved to their float position and scaled by
+ * 2^(127 - 15), which also handles denormals, and infinities and NaNs get
+ * the maximum exponent.
+ */
+static void
+emit_half_to_float(struct translate_sse *p, struct x86_reg data)
+{
+   struct x86_reg aux = x86_make_reg(file_XMM, 1);
+   struct x86_reg scratch =
+      x86_make_disp(p->machine_EDI, get_offset(p, &p->scratch[0]));
+
+   /* aux = exponent and mantissa, data = sign */
+   sse_movaps(p->func, aux, data);
+   sse_andps(p->func, aux, get_const(p, CONST_7FFF_INT));
+   sse_xorps(p->func, data, aux);
+   sse2_pslld_imm(p->func, data, 16);
+   sse_movaps(p->func, scratch, data);
+
+   /* data = sign | (infinity or NaN ? 0x7f800000 : 0) */
+   sse_movaps(p->func, data, aux);
+   sse2_pcmpgtd(p->func, data, get_const(p, CONST_7BFF_INT));
+   sse_andps(p->func, data, get_const(p, CONST_7F800000_INT));
+   sse_orps(p->func, data, scratch);
+
+   sse2_pslld_imm(p->func, aux, 13);
+   sse_mulps(p->func, aux, get_const(p, CONST_2POW112));
+   sse_orps(p->func, data, aux);
+}
+
+
+/* Whether the format is one of the [RB]10G10[BR]10A2 UNORM or USCALED. */
+static bool
+is_unsigned_2_10_10_10(const struct util_format_description *desc)
+{
+   static const unsigned sizes[4] = { 10, 10, 10, 2 };
+
+   if (desc->nr_channels != 4 || desc->block.bits != 32)
+      return false;
+
+   for (unsigned i = 0; i < 4; i++) {
+      if (desc->channel[i].type != UTIL_FORMAT_TYPE_UNSIGNED ||
+          desc->channel[i].pure_integer ||
+          desc->channel[i].normalized != desc->channel[0].normalized ||
+          desc->channel[i].size != sizes[i] ||
+          desc->channel[i].shift != i * 10)
+         return false;
+   }
+   return true;
+}
+
+
+/* Whether two channels only differ by their position in the vertex. */
+static bool
+channel_types_equal(const struct util_format_channel_description *a,
+                    const struct util_format_channel_description *b)
+{
+   return a->type == b->type &&
+          a->normalized == b->normalized &&
+          a->pure_integer == b->pure_integer &&
+          a->size == b->size;
+}
+
+
 static bool
 translate_attr_convert(struct translate_sse *p,
                        const struct translate_element *a,
@@ -492,25 +601,24 @@ translate_attr_convert(struct translate_sse *p,
        || a->input_format == PIPE_FORMAT_NONE)
       return false;
 
-   if (input_desc->channel[0].size & 7)
+   const bool packed_2_10_10_10 = is_unsigned_2_10_10_10(input_desc);
+
+   if ((input_desc->channel[0].size & 7) && !packed_2_10_10_10)
       return false;
 
    if (input_desc->colorspace != output_desc->colorspace)
       return false;
 
-   for (i = 1; i < input_desc->nr_channels; ++i) {
-      if (memcmp
-          (&input_desc->channel[i], &input_desc->channel[0],
-           sizeof(input_desc->channel[0])))
+   for (i = 1; i < input_desc->nr_channels && !packed_2_10_10_10; ++i) {
+      if (!channel_types_equal(&input_desc->channel[i],
+                               &input_desc->channel[0]))
          return false;
    }
 
    for (i = 1; i < output_desc->nr_channels; ++i) {
-      if (memcmp
-          (&output_desc->channel[i], &output_desc->channel[0],
-           sizeof(output_desc->channel[0]))) {
+      if (!channel_types_equal(&output_desc->channel[i],
+                               &output_desc->channel[0]))
          return false;
-      }
    }
 
    for (i = 0; i < output_desc->nr_channels; ++i) {
@@ -544,6 +652,29 @@ translate_attr_convert(struct translate_sse *p,
          case UTIL_FORMAT_TYPE_UNSIGNED:
             if (!(x86_target_caps(p->func) & X86_SSE2))
                return false;
+            if (packed_2_10_10_10) {
+               /* Give each lane its channel, still at its shift. */
+               sse2_movd(p->func, dataXMM, src);
+               sse2_pshufd(p->func, dataXMM, dataXMM, SHUF(0, 0, 0, 0));
+               sse_andps(p->func, dataXMM,
+                         get_const(p, CONST_2_10_10_10_MASK_INT));
+
+               /* The alpha lane has the high bit set, handled like for
+                * 32-bit channels below. */
+               auxXMM = x86_make_reg(file_XMM, 1);
+               sse_xorps(p->func, auxXMM, auxXMM);
+               sse2_pcmpgtd(p->func, auxXMM, dataXMM);
+               sse_andps(p->func, dataXMM, get_const(p, CONST_2147483647_INT));
+               sse_andps(p->func, auxXMM, get_const(p, CONST_2147483648));
+               sse2_cvtdq2ps(p->func, dataXMM, dataXMM);
+               sse_addps(p->func, dataXMM, auxXMM);
+
+               sse_mulps(p->func, dataXMM,
+                         get_const(p, input_desc->channel[0].normalized ?
+                                      CONST_2_10_10_10_UNORM :
+                                      CONST_2_10_10_10_USCALED));
+               break;
+            }
             emit_load_sse2(p, dataXMM, src,
                            input_desc->channel[0].size *
                            input_desc->nr_channels >> 3);
@@ -649,11 +780,22 @@ translate_attr_convert(struct translate_sse *p,
                   break;
                }
                sse_mulps(p->func, dataXMM, factor);
+               /* The most negative value maps to -1.0 too. */
+               sse_maxps(p->func, dataXMM, get_const(p, CONST_MINUS_1));
             }
             break;
 
             break;
          case UTIL_FORMAT_TYPE_FLOAT:
+            if (input_desc->channel[0].size == 16) {
+               if (!(x86_target_caps(p->func) & X86_SSE2))
+                  return false;
+               emit_load_sse2(p, dataXMM, src,
+                              2 * input_desc->nr_channels);
+               sse2_punpcklwd(p->func, dataXMM, get_const(p, CONST_IDENTITY));
+               emit_half_to_float(p, dataXMM);
+               break;
+            }
             if (input_desc->channel[0].size != 32
                 && input_desc->channel[0].size != 64) {
                return false;
@@ -753,6 +895,12 @@ translate_attr_convert(struct translate_sse *p,
       }
       return true;
    }
+   /* The integer paths below only match translate_generic for
+    * single-channel formats.
+    */
+   else if (input_desc->nr_channels > 1 || output_desc->nr_channels > 1) {
+      return false;
+   }
    else if ((x86_target_caps(p->func) & X86_SSE2)
             && input_desc->channel[0].size == 8
             && output_desc->channel[0].size == 16
@@ -1485,20 +1633,122 @@ translate_sse_set_buffer(struct translate *translate,
 }
 
 
+static unsigned
+translate_key_size(const struct translate_key *key)
+{
+   return offsetof(struct translate_key, element) +
+          key->nr_elements * sizeof(key->element[0]);
+}
+
+
+static uint32_t
+translate_key_hash(const void *key)
+{
+   return _mesa_hash_data(key, translate_key_size(key));
+}
+
+
+static bool
+translate_key_equal(const void *a, const void *b)
+{
+   const struct translate_key *ka = a;
+   const struct translate_key *kb = b;
+
+   return ka->nr_elements == kb->nr_elements &&
+          memcmp(ka, kb, translate_key_size(ka)) == 0;
+}
+
+
+static void
+program_destroy(struct translate_sse_program *program)
+{
+   x86_release_func(&program->elt8_func);
+   x86_release_func(&program->elt16_func);
+   x86_release_func(&program->elt_func);
+   x86_release_func(&program->linear_func);
+   FREE(program);
+}
+
+
+static void
+program_unreference(struct translate_sse_program *program)
+{
+   simple_mtx_lock(&program_cache_mtx);
+   if (--program->refcount == 0 &&
+       program_cache->entries > MAX_CACHED_PROGRAMS) {
+      _mesa_hash_table_remove_key(program_cache, &program->key);
+      program_destroy(program);
+   }
+   simple_mtx_unlock(&program_cache_mtx);
+}
+
+
 static void
 translate_sse_release(struct translate *translate)
 {
    struct translate_sse *p = (struct translate_sse *) translate;
 
-   x86_release_func(&p->elt8_func);
-   x86_release_func(&p->elt16_func);
-   x86_release_func(&p->elt_func);
-   x86_release_func(&p->linear_func);
+   if (p->program)
+      program_unreference(p->program);
 
    os_free_aligned(p);
 }
 
 
+/**
+ * Returns a referenced program for the key of p, generating its code with
+ * p if no other translate did yet.
+ */
+static struct translate_sse_program *
+get_program(struct translate_sse *p)
+{
+   const struct translate_key *key = &p->translate.key;
+   struct translate_sse_program *program = NULL;
+
+   simple_mtx_lock(&program_cache_mtx);
+
+   if (!program_cache) {
+      program_cache = _mesa_hash_table_create(NULL, translate_key_hash,
+                                              translate_key_equal);
+      if (!program_cache)
+         goto out;
+   }
+
+   struct hash_entry *entry = _mesa_hash_table_search(program_cache, key);
+   if (entry) {
+      program = entry->data;
+      program->refcount++;
+      goto out;
+   }
+
+   program = CALLOC_STRUCT(translate_sse_program);
+   if (!program)
+      goto out;
+
+   program->key = *key;
+
+   if (!build_vertex_emit(p, &program->linear_func, 0) ||
+       !build_vertex_emit(p, &program->elt_func, 4) ||
+       !build_vertex_emit(p, &program->elt16_func, 2) ||
+       !build_vertex_emit(p, &program->elt8_func, 1) ||
+       !x86_get_func(&program->linear_func) ||
+       !x86_get_func(&program->elt_func) ||
+       !x86_get_func(&program->elt16_func) ||
+       !x86_get_func(&program->elt8_func)) {
+      program_destroy(program);
+      program = NULL;
+      goto out;
+   }
+
+   program->refcount = 1;
+   _mesa_hash_table_insert(program_cache, &program->key, program);
+
+out:
+   simple_mtx_unlock(&program_cache_mtx);
+   return program;
+}
+
+
 struct translate *
 translate_sse2_create(const struct translate_key *key)
 {
@@ -1562,33 +1812,16 @@ translate_sse2_create(const struct translate_key *key)
    if (0)
       debug_printf("nr_buffers: %d\n", p->nr_buffers);
 
-   if (!build_vertex_emit(p, &p->linear_func, 0))
+   p->program = get_program(p);
+   if (!p->program)
       goto fail;
 
-   if (!build_vertex_emit(p, &p->elt_func, 4))
-      goto fail;
-
-   if (!build_vertex_emit(p, &p->elt16_func, 2))
-      goto fail;
-
-   if (!build_vertex_emit(p, &p->elt8_func, 1))
-      goto fail;
-
-   p->translate.run = (run_func) x86_get_func(&p->linear_func);
-   if (p->translate.run == NULL)
-      goto fail;
-
-   p->translate.run_elts = (run_elts_func) x86_get_func(&p->elt_func);
-   if (p->translate.run_elts == NULL)
-      goto fail;
-
-   p->translate.run_elts16 = (run_elts16_func) x86_get_func(&p->elt16_func);
-   if (p->translate.run_elts16 == NULL)
-      goto fail;
-
-   p->translate.run_elts8 = (run_elts8_func) x86_get_func(&p->elt8_func);
-   if (p->translate.run_elts8 == NULL)
-      goto fail;
+   p->translate.run = (run_func) x86_get_func(&p->program->linear_func);
+   p->translate.run_elts = (run_elts_func) x86_get_func(&p->program->elt_func);
+   p->translate.run_elts16 =
+      (run_elts16_func) x86_get_func(&p->program->elt16_func);
+   p->translate.run_elts8 =
+      (run_elts8_func) x86_get_func(&p->program->elt8_func);
 
    return &p->translate;
 
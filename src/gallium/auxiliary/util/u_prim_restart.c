@@ -142,6 +142,47 @@ add_range(enum mesa_prim mode, struct range_info *info, unsigned start, unsigned
    return true;
 }
 
+/**
+ * Helpers for util_prim_restart_convert_to_direct(): return the position of
+ * the first restart index at or after i, or count if there is none.
+ *
+ * Indices are tested 64 bits at a time, with the usual trick for finding a
+ * zero lane in a word applied to the word xor'ed with the restart index.
+ * Only the block that has a restart index is searched one index at a time.
+ */
+#define FIND_RESTART(TYPE) \
+static unsigned \
+find_restart_##TYPE(const TYPE *indices, unsigned i, unsigned count, \
+                    uint32_t restart_index) \
+{ \
+   if (restart_index > (TYPE)~0) \
+      return count; \
+   const TYPE restart = restart_index; \
+   const uint64_t lo = UINT64_MAX / (TYPE)~0; \
+   const uint64_t hi = lo << (sizeof(TYPE) * 8 - 1); \
+   const uint64_t rep = lo * restart; \
+   const unsigned block = 4 * sizeof(uint64_t) / sizeof(TYPE); \
+   for (; i + block <= count; i += block) { \
+      uint64_t w[4], found = 0; \
+      memcpy(w, &indices[i], sizeof(w)); \
+      for (unsigned j = 0; j < 4; j++) { \
+         w[j] ^= rep; \
+         found |= (w[j] - lo) & ~w[j] & hi; \
+      } \
+      if (found) \
+         break; \
+   } \
+   for (; i < count; i++) { \
+      if (indices[i] == restart) \
+         break; \
+   } \
+   return i; \
+}
+
+FIND_RESTART(uint8_t)
+FIND_RESTART(uint16_t)
+FIND_RESTART(uint32_t)
+
 struct pipe_draw_start_count_bias *
 util_prim_restart_convert_to_direct(const void *index_map,
                                     const struct pipe_draw_info *info,
@@ -152,32 +193,24 @@ util_prim_restart_convert_to_direct(const void *index_map,
                                     unsigned *total_index_count)
 {
    struct range_info ranges = { .min_index = UINT32_MAX, 0 };
-   unsigned i, start, count;
+   unsigned start, end;
    ranges.min_index = UINT32_MAX;
 
    assert(info->index_size);
    assert(info->primitive_restart);
 
 #define SCAN_INDEXES(TYPE) \
-   for (i = 0; i <= draw->count; i++) { \
-      if (i == draw->count || \
-          ((const TYPE *) index_map)[i] == info->restart_index) { \
-         /* cut / restart */ \
-         if (count > 0) { \
-            if (!add_range(info->mode, &ranges, draw->start + start, count, draw->index_bias)) { \
-               return NULL; \
-            } \
+   for (start = 0; start <= draw->count; start = end + 1) { \
+      end = find_restart_##TYPE((const TYPE *) index_map, start, \
+                                draw->count, info->restart_index); \
+      /* cut / restart */ \
+      if (end > start) { \
+         if (!add_range(info->mode, &ranges, draw->start + start, end - start, draw->index_bias)) { \
+            return NULL; \
          } \
-         start = i + 1; \
-         count = 0; \
-      } \
-      else { \
-         count++; \
       } \
    }
 
-   start = 0;
-   count = 0;
    switch (info->index_size) {
    case 1:
       SCAN_INDEXES(uint8_t);
@@ -190,6 +190,13 @@
  * meaning that it's added to the queue for execution in the other thread.
  * The batches are ordered in a ring and reused once they are idle again.
  * The batching is necessary for low queue/mutex overhead.
+ *
+ * There is exactly one driver thread per threaded context, because
+ * pipe_context isn't thread-safe and calls depend on the state bound by the
+ * calls before them. Work that should execute independently, such as
+ * compute or copies from another API context, needs its own pipe_context
+ * (e.g. with PIPE_CONTEXT_COMPUTE_ONLY), which gets its own threaded context
+ * and driver thread.
  */
 
 #ifndef U_THREADED_CONTEXT_H
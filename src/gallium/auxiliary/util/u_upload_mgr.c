@@ -32,11 +32,18 @@
 #include "pipe/p_defines.h"
 #include "util/u_inlines.h"
 #include "pipe/p_context.h"
+#include "pipe/p_screen.h"
 #include "util/u_memory.h"
 #include "util/u_math.h"
 
 #include "u_upload_mgr.h"
 
+#define U_UPLOAD_MAX_RING_BUFFERS 8
+
+struct u_upload_full_buffer {
+   struct pipe_resource *buffer;
+   struct pipe_fence_handle *fence; /* NULL until u_upload_fence is called. */
+};
 
 struct u_upload_mgr {
    struct pipe_context *pipe;
@@ -54,6 +61,13 @@ struct u_upload_mgr {
    unsigned buffer_size; /* Same as buffer->width0. */
    unsigned offset; /* Aligned offset to the upload buffer, pointing
                      * at the first unused byte. */
+
+   /* Ring mode: the full buffers, oldest first. */
+   unsigned ring_size; /* 0 if ring mode is disabled. */
+   unsigned num_full;
+   struct u_upload_full_buffer full[U_UPLOAD_MAX_RING_BUFFERS];
+
+   struct u_upload_stats stats;
 };
 
 
@@ -107,6 +121,8 @@ u_upload_clone(struct pipe_context *pipe, struct u_upload_mgr *upload)
                                                  upload->flags);
    if (!upload->map_persistent && result->map_persistent)
       u_upload_disable_persistent(result);
+   if (upload->ring_size)
+      u_upload_enable_ring(result, upload->ring_size);
 
    return result;
 }
@@ -119,6 +135,77 @@ u_upload_disable_persistent(struct u_upload_mgr *upload)
    upload->map_flags |= PIPE_MAP_FLUSH_EXPLICIT;
 }
 
+void
+u_upload_enable_ring(struct u_upload_mgr *upload, unsigned num_buffers)
+{
+   upload->ring_size = MIN2(num_buffers, U_UPLOAD_MAX_RING_BUFFERS);
+}
+
+void
+u_upload_fence(struct u_upload_mgr *upload, struct pipe_fence_handle *fence)
+{
+   struct pipe_screen *screen = upload->pipe->screen;
+
+   for (unsigned i = 0; i < upload->num_full; i++) {
+      if (!upload->full[i].fence)
+         screen->fence_reference(screen, &upload->full[i].fence, fence);
+   }
+}
+
+void
+u_upload_get_stats(struct u_upload_mgr *upload, struct u_upload_stats *stats)
+{
+   *stats = upload->stats;
+}
+
+static void
+u_upload_drop_oldest_full_buffer(struct u_upload_mgr *upload)
+{
+   struct pipe_screen *screen = upload->pipe->screen;
+
+   assert(upload->num_full);
+   pipe_resource_release(upload->pipe, upload->full[0].buffer);
+   screen->fence_reference(screen, &upload->full[0].fence, NULL);
+
+   upload->num_full--;
+   memmove(&upload->full[0], &upload->full[1],
+           upload->num_full * sizeof(upload->full[0]));
+}
+
+/* Return the oldest full buffer if it's idle and big enough, or NULL. */
+static struct pipe_resource *
+u_upload_reuse_full_buffer(struct u_upload_mgr *upload, unsigned size)
+{
+   struct pipe_screen *screen = upload->pipe->screen;
+
+   if (!upload->num_full)
+      return NULL;
+
+   struct u_upload_full_buffer *oldest = &upload->full[0];
+
+   /* The buffer must not be referenced by any bound state either, as that
+    * could still be used by draws after the fence.
+    */
+   if (!oldest->fence ||
+       p_atomic_read(&oldest->buffer->reference.count) != 1 ||
+       !screen->fence_finish(screen, NULL, oldest->fence, 0))
+      return NULL;
+
+   if (oldest->buffer->width0 < size) {
+      u_upload_drop_oldest_full_buffer(upload);
+      return NULL;
+   }
+
+   struct pipe_resource *buffer = oldest->buffer;
+   oldest->buffer = NULL;
+   screen->fence_reference(screen, &oldest->fence, NULL);
+
+   upload->num_full--;
+   memmove(&upload->full[0], &upload->full[1],
+           upload->num_full * sizeof(upload->full[0]));
+   return buffer;
+}
+
 static void
 upload_unmap_internal(struct u_upload_mgr *upload, bool destroying)
 {
@@ -159,6 +246,8 @@ u_upload_destroy(struct u_upload_mgr *upload)
 {
    u_upload_release_buffer(upload);
    pipe_resource_release(upload->pipe, upload->buffer);
+   while (upload->num_full)
+      u_upload_drop_oldest_full_buffer(upload);
    FREE(upload);
 }
 
@@ -176,9 +265,33 @@ u_upload_alloc_buffer(struct u_upload_mgr *upload, unsigned min_size, struct pip
    *releasebuf = upload->buffer;
    upload->buffer = NULL;
 
+   size = align(MAX2(upload->default_size, min_size), 4096);
+
+   /* In ring mode, keep the old buffer for reuse and try reusing one that
+    * got full earlier.
+    */
+   if (upload->ring_size) {
+      upload->buffer = u_upload_reuse_full_buffer(upload, size);
+
+      if (*releasebuf) {
+         if (upload->num_full == upload->ring_size)
+            u_upload_drop_oldest_full_buffer(upload);
+
+         upload->full[upload->num_full].buffer = *releasebuf;
+         upload->full[upload->num_full].fence = NULL;
+         upload->num_full++;
+         *releasebuf = NULL;
+      }
+
+      if (upload->buffer) {
+         size = upload->buffer->width0;
+         upload->stats.reused_buffers++;
+         goto map;
+      }
+   }
+
    /* Allocate a new one:
     */
-   size = align(MAX2(upload->default_size, min_size), 4096);
 
    memset(&buffer, 0, sizeof buffer);
    buffer.target = PIPE_BUFFER;
@@ -200,6 +313,9 @@ u_upload_alloc_buffer(struct u_upload_mgr *upload, unsigned min_size, struct pip
    if (upload->buffer == NULL)
       return 0;
 
+   upload->stats.new_buffers++;
+
+map:
    /* Map the new buffer. */
    upload->map = pipe_buffer_map_range(upload->pipe, upload->buffer,
                                        0, size, upload->map_flags,
@@ -260,6 +376,7 @@ u_upload_alloc(struct u_upload_mgr *upload,
       }
    } else {
       *releasebuf = NULL;
+      upload->stats.fast_allocs++;
    }
 
    if (unlikely(!upload->map)) {
@@ -36,8 +36,16 @@
 #include "pipe/p_defines.h"
 
 struct pipe_context;
+struct pipe_fence_handle;
 struct pipe_resource;
 
+/** Counters of how u_upload_alloc got its memory. */
+struct u_upload_stats {
+   uint64_t fast_allocs;    /**< suballocations from the current buffer */
+   uint64_t new_buffers;    /**< buffers created */
+   uint64_t reused_buffers; /**< idle buffers reused in ring mode */
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -73,6 +81,28 @@ u_upload_clone(struct pipe_context *pipe, struct u_upload_mgr *upload);
 void
 u_upload_disable_persistent(struct u_upload_mgr *upload);
 
+/**
+ * Keep up to num_buffers full upload buffers around and reuse them once
+ * they are idle, instead of creating a new buffer every time the current
+ * one is full.
+ *
+ * A full buffer is only known to be idle after a fence passed to
+ * u_upload_fence() after it got full signalled, so ring mode needs the
+ * user of the uploader to call u_upload_fence() when it flushes.
+ */
+void
+u_upload_enable_ring(struct u_upload_mgr *upload, unsigned num_buffers);
+
+/**
+ * Tell the uploader that all the work using the buffers that got full so
+ * far is done once fence signals.  Does nothing if ring mode is disabled.
+ */
+void
+u_upload_fence(struct u_upload_mgr *upload, struct pipe_fence_handle *fence);
+
+void
+u_upload_get_stats(struct u_upload_mgr *upload, struct u_upload_stats *stats);
+
 /**
  * Destroy the upload manager.
  */
@@ -799,10 +799,6 @@ cs_launch(struct vl_compositor *c,
    info.grid[2] = 1;
 
    ctx->launch_grid(ctx, &info);
-
-   /* Make the result visible to all clients. */
-   ctx->memory_barrier(ctx, PIPE_BARRIER_ALL);
-
 }
 
 static inline struct u_rect
@@ -1002,7 +998,8 @@ draw_layers(struct vl_compositor       *c,
             struct vl_compositor_state *s,
             struct u_rect              *dirty)
 {
-   unsigned i;
+   unsigned i, max_sampler_views = 0;
+   bool drawn_any = false;
 
    assert(c);
 
@@ -1029,21 +1026,23 @@ draw_layers(struct vl_compositor       *c,
          calc_proj(layer, sampler1->texture, drawn.chroma_proj);
          set_viewport(s, &drawn, samplers);
 
+         /* The parameters got re-uploaded with a discarding map, rebind
+          * them for every layer.
+          */
+         pipe_set_constant_buffer(c->pipe, MESA_SHADER_COMPUTE, 0, s->shader_params);
          c->pipe->bind_sampler_states(c->pipe, MESA_SHADER_COMPUTE, 0,
                         num_sampler_views, layer->samplers);
          c->pipe->set_sampler_views(c->pipe, MESA_SHADER_COMPUTE, 0,
                         num_sampler_views, 0, samplers);
 
+         /* Layers blend with what the previous ones stored. */
+         if (drawn_any)
+            c->pipe->memory_barrier(c->pipe, PIPE_BARRIER_IMAGE);
+
          cs_launch(c, layer->cs, &(drawn.area));
 
-         /* Unbind. */
-         c->pipe->set_shader_images(c->pipe, MESA_SHADER_COMPUTE, 0, 0, 1, NULL);
-         c->pipe->set_constant_buffer(c->pipe, MESA_SHADER_COMPUTE, 0, NULL);
-         c->pipe->set_sampler_views(c->pipe, MESA_SHADER_COMPUTE, 0, 0,
-                        num_sampler_views, NULL);
-         c->pipe->bind_compute_state(c->pipe, NULL);
-         c->pipe->bind_sampler_states(c->pipe, MESA_SHADER_COMPUTE, 0,
-                        num_sampler_views, NULL);
+         drawn_any = true;
+         max_sampler_views = MAX2(max_sampler_views, num_sampler_views);
 
          if (dirty) {
             struct u_rect drawn = calc_drawn_area(s, layer);
@@ -1054,6 +1053,21 @@ draw_layers(struct vl_compositor       *c,
          }
       }
    }
+
+   if (!drawn_any)
+      return;
+
+   /* Make the result visible to all clients. */
+   c->pipe->memory_barrier(c->pipe, PIPE_BARRIER_ALL);
+
+   /* Unbind. */
+   c->pipe->set_shader_images(c->pipe, MESA_SHADER_COMPUTE, 0, 0, 1, NULL);
+   c->pipe->set_constant_buffer(c->pipe, MESA_SHADER_COMPUTE, 0, NULL);
+   c->pipe->set_sampler_views(c->pipe, MESA_SHADER_COMPUTE, 0, 0,
+                  max_sampler_views, NULL);
+   c->pipe->bind_compute_state(c->pipe, NULL);
+   c->pipe->bind_sampler_states(c->pipe, MESA_SHADER_COMPUTE, 0,
+                  max_sampler_views, NULL);
 }
 
 void
@@ -1085,8 +1099,6 @@ vl_compositor_cs_render(struct vl_compositor_state *s,
       dirty_area->x1 = dirty_area->y1 = VL_COMPOSITOR_MIN_DIRTY;
    }
 
-   pipe_set_constant_buffer(c->pipe, MESA_SHADER_COMPUTE, 0, s->shader_params);
-
    draw_layers(c, s, dirty_area);
 }
 
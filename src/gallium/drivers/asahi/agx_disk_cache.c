@@ -196,6 +196,93 @@ agx_disk_cache_retrieve(struct agx_screen *screen,
 #endif
 }
 
+/**
+ * Compute a disk cache key for a prolog or epilog. These don't belong to an
+ * API shader, so they are identified by name and their own key instead.
+ */
+static void
+agx_disk_cache_compute_part_key(struct disk_cache *cache, const char *name,
+                                const void *key, size_t key_size,
+                                cache_key cache_key)
+{
+   struct blob data;
+   blob_init(&data);
+
+   blob_write_string(&data, name);
+   blob_write_bytes(&data, key, key_size);
+
+   disk_cache_compute_key(cache, data.data, data.size, cache_key);
+   blob_finish(&data);
+}
+
+/**
+ * Store the given compiled prolog or epilog in the disk cache.
+ *
+ * These are secondary shader parts that are only ever fast-linked, so there
+ * is no executable BO or push range to save, just the binary.
+ */
+void
+agx_disk_cache_store_part(struct disk_cache *cache, const char *name,
+                          const void *key, size_t key_size,
+                          const struct agx_compiled_shader *binary)
+{
+#ifdef ENABLE_SHADER_CACHE
+   if (!cache)
+      return;
+
+   assert(binary->push_range_count == 0);
+
+   cache_key cache_key;
+   agx_disk_cache_compute_part_key(cache, name, key, key_size, cache_key);
+
+   struct blob blob;
+   blob_init(&blob);
+
+   blob_write_bytes(&blob, &binary->b.info, sizeof(binary->b.info));
+   blob_write_bytes(&blob, binary->b.binary, binary->b.info.binary_size);
+
+   disk_cache_put(cache, cache_key, blob.data, blob.size, NULL);
+   blob_finish(&blob);
+#endif
+}
+
+/**
+ * Search for a compiled prolog or epilog in the disk cache.
+ */
+struct agx_compiled_shader *
+agx_disk_cache_retrieve_part(struct agx_screen *screen, const char *name,
+                             const void *key, size_t key_size)
+{
+#ifdef ENABLE_SHADER_CACHE
+   struct disk_cache *cache = screen->disk_cache;
+   if (!cache)
+      return NULL;
+
+   cache_key cache_key;
+   agx_disk_cache_compute_part_key(cache, name, key, key_size, cache_key);
+
+   size_t size;
+   void *buffer = disk_cache_get(cache, cache_key, &size);
+   if (!buffer)
+      return NULL;
+
+   struct blob_reader blob;
+   blob_reader_init(&blob, buffer, size);
+
+   struct agx_compiled_shader *binary = CALLOC_STRUCT(agx_compiled_shader);
+   binary->stage = MESA_SHADER_COMPUTE;
+
+   blob_copy_bytes(&blob, &binary->b.info, sizeof(binary->b.info));
+   binary->b.binary = malloc(binary->b.info.binary_size);
+   blob_copy_bytes(&blob, binary->b.binary, binary->b.info.binary_size);
+
+   free(buffer);
+   return binary;
+#else
+   return NULL;
+#endif
+}
+
 /**
  * Initialise the on-disk shader cache.
  */
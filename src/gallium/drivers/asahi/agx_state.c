@@ -1529,7 +1529,8 @@ static struct agx_compiled_shader *
 agx_build_meta_shader_internal(struct agx_context *ctx,
                                meta_shader_builder_t builder, void *data,
                                size_t data_size, bool prolog, bool epilog,
-                               unsigned cf_base, bool internal_kernel);
+                               unsigned cf_base, bool internal_kernel,
+                               const char *part_name);
 
 /* Does not take ownership of key. Clones if necessary. */
 static struct agx_compiled_shader *
@@ -2126,11 +2127,11 @@ asahi_fast_link(struct agx_context *ctx, struct agx_uncompiled_shader *so,
    if (so->type == MESA_SHADER_FRAGMENT) {
       prolog = agx_build_meta_shader_internal(
          ctx, build_fs_prolog, &key->prolog.fs, sizeof(key->prolog.fs), true,
-         false, key->prolog.fs.cf_base, false);
+         false, key->prolog.fs.cf_base, false, "fs prolog");
 
       epilog = agx_build_meta_shader_internal(
          ctx, agx_nir_fs_epilog, &key->epilog.fs, sizeof(key->epilog.fs), false,
-         true, 0, false);
+         true, 0, false, "fs epilog");
 
    } else if (so->type == MESA_SHADER_TESS_EVAL) {
       /* No prolog/epilog needed */
@@ -2139,7 +2140,7 @@ asahi_fast_link(struct agx_context *ctx, struct agx_uncompiled_shader *so,
 
       prolog = agx_build_meta_shader_internal(
          ctx, agx_nir_vs_prolog, &key->prolog.vs, sizeof(key->prolog.vs), true,
-         false, 0, false);
+         false, 0, false, "vs prolog");
    }
 
    /* Fast-link it all together */
@@ -2577,7 +2578,8 @@ static struct agx_compiled_shader *
 agx_build_meta_shader_internal(struct agx_context *ctx,
                                meta_shader_builder_t builder, void *data,
                                size_t data_size, bool prolog, bool epilog,
-                               unsigned cf_base, bool internal_kernel)
+                               unsigned cf_base, bool internal_kernel,
+                               const char *part_name)
 {
    /* Build the meta shader key */
    size_t total_key_size = sizeof(struct agx_generic_meta_key) + data_size;
@@ -2596,26 +2598,45 @@ agx_build_meta_shader_internal(struct agx_context *ctx,
    if (ent)
       return ent->data;
 
+   /* Prologs and epilogs are only keyed on their data, so they can also come
+    * from the disk cache. Other meta shaders are cheap and few.
+    */
+   struct agx_screen *screen = agx_screen(ctx->base.screen);
+   struct agx_compiled_shader *shader = NULL;
+
+   if (part_name) {
+      assert(prolog || epilog);
+      shader = agx_disk_cache_retrieve_part(screen, part_name, data,
+                                            data_size);
+   }
+
    /* Otherwise, compile the shader fresh */
-   nir_builder b = nir_builder_init_simple_shader(
-      MESA_SHADER_COMPUTE, &agx_nir_options, "AGX meta shader");
+   if (!shader) {
+      nir_builder b = nir_builder_init_simple_shader(
+         MESA_SHADER_COMPUTE, &agx_nir_options, "AGX meta shader");
 
-   builder(&b, data);
+      builder(&b, data);
 
-   struct agx_device *dev = agx_device(ctx->base.screen);
-   if (!prolog) {
-      agx_preprocess_nir(b.shader);
-      NIR_PASS(_, b.shader, agx_nir_lower_texture);
-      NIR_PASS(_, b.shader, agx_nir_lower_multisampled_image_store);
-   }
+      struct agx_device *dev = agx_device(ctx->base.screen);
+      if (!prolog) {
+         agx_preprocess_nir(b.shader);
+         NIR_PASS(_, b.shader, agx_nir_lower_texture);
+         NIR_PASS(_, b.shader, agx_nir_lower_multisampled_image_store);
+      }
 
-   struct agx_compiled_shader *shader = agx_compile_nir(
-      dev, b.shader, NULL, MESA_SHADER_COMPUTE, internal_kernel,
-      !prolog && !(b.shader->info.stage == MESA_SHADER_FRAGMENT &&
-                   b.shader->info.fs.uses_sample_shading),
-      prolog || epilog, cf_base, NULL);
+      shader = agx_compile_nir(
+         dev, b.shader, NULL, MESA_SHADER_COMPUTE, internal_kernel,
+         !prolog && !(b.shader->info.stage == MESA_SHADER_FRAGMENT &&
+                      b.shader->info.fs.uses_sample_shading),
+         prolog || epilog, cf_base, NULL);
 
-   ralloc_free(b.shader);
+      ralloc_free(b.shader);
+
+      if (part_name) {
+         agx_disk_cache_store_part(screen->disk_cache, part_name, data,
+                                   data_size, shader);
+      }
+   }
 
    /* ..and cache it before we return. The key is on the stack right now, so
     * clone it before using it as a hash table key. The clone is logically owned
@@ -2633,7 +2654,7 @@ agx_build_meta_shader(struct agx_context *ctx, meta_shader_builder_t builder,
                       void *data, size_t data_size)
 {
    return agx_build_meta_shader_internal(ctx, builder, data, data_size, false,
-                                         false, 0, false);
+                                         false, 0, false, NULL);
 }
 
 static unsigned
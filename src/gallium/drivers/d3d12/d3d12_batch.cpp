@@ -83,10 +83,13 @@ d3d12_init_batch(struct d3d12_context *ctx, struct d3d12_batch *batch)
 
       batch->sampler_tables = _mesa_hash_table_create(NULL, d3d12_sampler_desc_table_key_hash,
                                                       d3d12_sampler_desc_table_key_equals);
+      batch->srv_tables = _mesa_hash_table_create(NULL, d3d12_sampler_desc_table_key_hash,
+                                                  d3d12_sampler_desc_table_key_equals);
       batch->sampler_views = _mesa_set_create(NULL, _mesa_hash_pointer,
                                              _mesa_key_pointer_equal);
 
-      if (!batch->sampler_tables || !batch->sampler_views || !batch->view_heap || !batch->queries)
+      if (!batch->sampler_tables || !batch->srv_tables || !batch->sampler_views ||
+          !batch->view_heap || !batch->queries)
          return false;
 
       batch->zombie_samplers = UTIL_DYNARRAY_INIT;
@@ -185,6 +188,7 @@ d3d12_reset_batch(struct d3d12_context *ctx, struct d3d12_batch *batch, uint64_t
 #ifdef HAVE_GALLIUM_D3D12_GRAPHICS
    if (d3d12_screen(ctx->base.screen)->max_feature_level >= D3D_FEATURE_LEVEL_11_0) {
       _mesa_hash_table_clear(batch->sampler_tables, delete_sampler_view_table);
+      _mesa_hash_table_clear(batch->srv_tables, delete_sampler_view_table);
       _mesa_set_clear(batch->sampler_views, delete_sampler_view);
 
       _mesa_set_clear(batch->queries, delete_query);
@@ -217,6 +221,7 @@ d3d12_destroy_batch(struct d3d12_context *ctx, struct d3d12_batch *batch)
       d3d12_descriptor_heap_free(batch->sampler_heap);
       d3d12_descriptor_heap_free(batch->view_heap);
       _mesa_hash_table_destroy(batch->sampler_tables, NULL);
+      _mesa_hash_table_destroy(batch->srv_tables, NULL);
       _mesa_set_destroy(batch->sampler_views, NULL);
       _mesa_set_destroy(batch->queries, NULL);
       util_dynarray_fini(&batch->zombie_samplers);
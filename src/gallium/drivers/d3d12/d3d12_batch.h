@@ -48,6 +48,7 @@ struct d3d12_batch {
    struct hash_table *bos;
    struct util_dynarray local_bos;
    struct hash_table *sampler_tables;
+   struct hash_table *srv_tables;
    struct set *sampler_views;
    struct set *surfaces;
    struct set *objects;
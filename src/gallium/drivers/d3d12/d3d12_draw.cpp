@@ -81,6 +81,39 @@ fill_cbv_descriptors(struct d3d12_context *ctx,
    return table_start.gpu_handle;
 }
 
+/* Returns a descriptor table of the heap holding the given descriptors,
+ * only copying them if no identical table was already appended in this
+ * batch.  With refresh, the descriptors changed since they were last
+ * copied, so a new table is always appended and replaces the old one.
+ */
+static D3D12_GPU_DESCRIPTOR_HANDLE
+get_descriptor_table(struct hash_table *tables,
+                     struct d3d12_descriptor_heap *heap,
+                     const struct d3d12_sampler_desc_table_key *key,
+                     bool refresh)
+{
+   hash_entry *entry = _mesa_hash_table_search(tables, key);
+   if (entry && !refresh)
+      return ((d3d12_descriptor_handle *)entry->data)->gpu_handle;
+
+   d3d12_descriptor_handle *table_data;
+   if (entry) {
+      table_data = (d3d12_descriptor_handle *)entry->data;
+   } else {
+      d3d12_sampler_desc_table_key *table_key = MALLOC_STRUCT(d3d12_sampler_desc_table_key);
+      table_key->count = key->count;
+      memcpy(table_key->descs, key->descs, key->count * sizeof(key->descs[0]));
+
+      table_data = MALLOC_STRUCT(d3d12_descriptor_handle);
+      _mesa_hash_table_insert(tables, table_key, table_data);
+   }
+
+   d2d12_descriptor_heap_get_next_handle(heap, table_data);
+   d3d12_descriptor_heap_append_handles(heap, key->descs, key->count);
+
+   return table_data->gpu_handle;
+}
+
 static D3D12_GPU_DESCRIPTOR_HANDLE
 fill_srv_descriptors(struct d3d12_context *ctx,
                      struct d3d12_shader *shader,
@@ -88,10 +121,11 @@ fill_srv_descriptors(struct d3d12_context *ctx,
 {
    struct d3d12_batch *batch = d3d12_current_batch(ctx);
    struct d3d12_screen *screen = d3d12_screen(ctx->base.screen);
-   D3D12_CPU_DESCRIPTOR_HANDLE descs[PIPE_MAX_SHADER_SAMPLER_VIEWS];
-   struct d3d12_descriptor_handle table_start;
+   struct d3d12_sampler_desc_table_key table;
+   D3D12_CPU_DESCRIPTOR_HANDLE *descs = table.descs;
+   bool refresh = false;
 
-   d2d12_descriptor_heap_get_next_handle(batch->view_heap, &table_start);
+   table.count = shader->end_srv_binding - shader->begin_srv_binding;
 
    for (unsigned i = shader->begin_srv_binding; i < shader->end_srv_binding; i++)
    {
@@ -113,6 +147,7 @@ fill_srv_descriptors(struct d3d12_context *ctx,
          if (view->texture_generation_id != res->generation_id) {
             d3d12_init_sampler_view_descriptor(view);
             view->texture_generation_id = res->generation_id;
+            refresh = true;
          }
 
          D3D12_RESOURCE_STATES state = (stage == MESA_SHADER_FRAGMENT) ?
@@ -136,9 +171,7 @@ fill_srv_descriptors(struct d3d12_context *ctx,
       }
    }
 
-   d3d12_descriptor_heap_append_handles(batch->view_heap, descs, shader->end_srv_binding - shader->begin_srv_binding);
-
-   return table_start.gpu_handle;
+   return get_descriptor_table(batch->srv_tables, batch->view_heap, &table, refresh);
 }
 
 static D3D12_GPU_DESCRIPTOR_HANDLE
@@ -211,25 +244,7 @@ fill_sampler_descriptors(struct d3d12_context *ctx,
          view.descs[desc_idx] = ctx->null_sampler.cpu_handle;
    }
 
-   hash_entry* sampler_entry =
-      (hash_entry*)_mesa_hash_table_search(batch->sampler_tables, &view);
-
-   if (!sampler_entry) {
-      d3d12_sampler_desc_table_key* sampler_table_key = MALLOC_STRUCT(d3d12_sampler_desc_table_key);
-      sampler_table_key->count = view.count;
-      memcpy(sampler_table_key->descs, &view.descs, view.count * sizeof(view.descs[0]));
-
-      d3d12_descriptor_handle* sampler_table_data = MALLOC_STRUCT(d3d12_descriptor_handle);
-      d2d12_descriptor_heap_get_next_handle(batch->sampler_heap, sampler_table_data);
-
-      d3d12_descriptor_heap_append_handles(batch->sampler_heap, view.descs, shader->end_srv_binding - shader->begin_srv_binding);
-
-      _mesa_hash_table_insert(batch->sampler_tables, sampler_table_key, sampler_table_data);
-
-      return sampler_table_data->gpu_handle;
-   } else
-      return ((d3d12_descriptor_handle*)sampler_entry->data)->gpu_handle;
-
+   return get_descriptor_table(batch->sampler_tables, batch->sampler_heap, &view, false);
 }
 
 static D3D12_UAV_DIMENSION
@@ -1039,21 +1039,18 @@ etna_ml_subgraph_read_outputs(struct pipe_context *context, struct pipe_ml_subgr
 
    for (int i = 0; i < outputs_count; i++) {
       struct pipe_resource *res = etna_ml_get_resource(subgraph, output_idxs[i]);
+      unsigned size = etna_ml_get_size(subgraph, output_idxs[i]);
+
+      /* Buffers are write-combined, so copy the output out in one go and
+       * only then convert it in cached memory, instead of doing single byte
+       * reads from the mapping.
+       */
+      pipe_buffer_read(context, res, 0, size, outputs[i]);
+
       if (is_signed[i]) {
-         struct pipe_transfer *src_transfer;
-         uint8_t *src_map;
-         src_map = (uint8_t *) pipe_buffer_map_range(context,
-                                                     res,
-                                                     0, pipe_buffer_size(res),
-                                                     PIPE_MAP_READ,
-                                                     &src_transfer);
-         assert(src_map);
-         for (unsigned k = 0; k < etna_ml_get_size(subgraph, output_idxs[i]); k++) {
-            ((uint8_t *)(outputs[i]))[k] = src_map[k] - 128;
-         }
-         pipe_buffer_unmap(context, src_transfer);
-      } else {
-         pipe_buffer_read(context, res, 0, etna_ml_get_size(subgraph, output_idxs[i]), outputs[i]);
+         uint8_t *dst = outputs[i];
+         for (unsigned k = 0; k < size; k++)
+            dst[k] -= 128;
       }
    }
 }
@@ -159,6 +159,8 @@ fd_autotune_use_bypass(struct fd_autotune *at, struct fd_batch *batch)
 
    process_results(at);
 
+   batch->autotune_reason = FD_AUTOTUNE_FALLBACK;
+
    /* Only enable on gen's that opt-in (and actually have sample-passed
     * collection wired up:
     */
@@ -190,7 +192,7 @@ fd_autotune_use_bypass(struct fd_autotune *at, struct fd_batch *batch)
       return true;
 
    if (history->num_results > 0) {
-      uint32_t total_samples = 0;
+      uint64_t total_samples = 0;
 
       // TODO we should account for clears somehow
       // TODO should we try to notice if there is a drastic change from
@@ -205,8 +207,10 @@ fd_autotune_use_bypass(struct fd_autotune *at, struct fd_batch *batch)
       /* Low sample count could mean there was only a clear.. or there was
        * a clear plus draws that touch no or few samples
        */
-      if (avg_samples < 500.0f)
+      if (avg_samples < 500.0f) {
+         batch->autotune_reason = FD_AUTOTUNE_LOW_SAMPLES;
          return true;
+      }
 
       /* Cost-per-sample is an estimate for the average number of reads+
        * writes for a given passed sample.
@@ -215,18 +219,40 @@ fd_autotune_use_bypass(struct fd_autotune *at, struct fd_batch *batch)
       sample_cost /= batch->num_draws;
 
       float total_draw_cost = (avg_samples * sample_cost) / batch->num_draws;
-      DBG("%08x:%u\ttotal_samples=%u, avg_samples=%f, sample_cost=%f, "
+      DBG("%08x:%u\ttotal_samples=%" PRIu64 ", avg_samples=%f, sample_cost=%f, "
           "total_draw_cost=%f\n",
           batch->hash, batch->num_draws, total_samples, avg_samples,
           sample_cost, total_draw_cost);
 
-      if (total_draw_cost < 3000.0f)
+      if (total_draw_cost < 3000.0f) {
+         batch->autotune_reason = FD_AUTOTUNE_LOW_DRAW_COST;
          return true;
+      }
+
+      batch->autotune_reason = FD_AUTOTUNE_HIGH_DRAW_COST;
    }
 
    return use_bypass;
 }
 
+const char *
+fd_autotune_reason_name(enum fd_autotune_reason reason)
+{
+   switch (reason) {
+   case FD_AUTOTUNE_NONE:
+      return "none";
+   case FD_AUTOTUNE_FALLBACK:
+      return "fallback";
+   case FD_AUTOTUNE_LOW_SAMPLES:
+      return "low-samples";
+   case FD_AUTOTUNE_LOW_DRAW_COST:
+      return "low-draw-cost";
+   case FD_AUTOTUNE_HIGH_DRAW_COST:
+      return "high-draw-cost";
+   }
+   return "unknown";
+}
+
 void
 fd_autotune_init(struct fd_autotune *at, struct fd_device *dev)
 {
@@ -150,6 +150,20 @@ struct fd_batch_result {
    uint64_t samples_passed;
 };
 
+/**
+ * Why fd_autotune_use_bypass() picked bypass or GMEM rendering, recorded
+ * in the render pass traces.
+ */
+enum fd_autotune_reason {
+   FD_AUTOTUNE_NONE,           /* autotune was not consulted */
+   FD_AUTOTUNE_FALLBACK,       /* no usable history, see fallback_use_bypass() */
+   FD_AUTOTUNE_LOW_SAMPLES,    /* few samples passed, bypass */
+   FD_AUTOTUNE_LOW_DRAW_COST,  /* little framebuffer traffic, bypass */
+   FD_AUTOTUNE_HIGH_DRAW_COST, /* enough framebuffer traffic for GMEM */
+};
+
+const char *fd_autotune_reason_name(enum fd_autotune_reason reason);
+
 void fd_autotune_init(struct fd_autotune *at, struct fd_device *dev);
 void fd_autotune_fini(struct fd_autotune *at);
 
@@ -170,6 +170,9 @@ struct fd_batch {
     */
    struct fd_batch_result *autotune_result;
 
+   /* Why autotune picked bypass or GMEM, for the render pass traces: */
+   enum fd_autotune_reason autotune_reason;
+
    unsigned num_draws;    /* number of draws in current batch */
    unsigned num_vertices; /* number of vertices in current batch */
 
@@ -768,7 +768,8 @@ fd_gmem_render_tiles(struct fd_batch *batch)
       trace_start_render_pass(&batch->trace, batch->gmem,
          ctx->submit_count, pipe_surface_format(&pfb->cbufs[0]),
          pipe_surface_format(&pfb->zsbuf), pfb->width, pfb->height,
-         pfb->nr_cbufs, pfb->samples, 0, 0, 0);
+         pfb->nr_cbufs, pfb->samples, 0, 0, 0, batch->num_draws,
+         batch->cost, batch->autotune_reason);
       if (ctx->query_prepare)
          ctx->query_prepare(batch, 1);
       render_sysmem(batch);
@@ -783,7 +784,8 @@ fd_gmem_render_tiles(struct fd_batch *batch)
          ctx->submit_count, pipe_surface_format(&pfb->cbufs[0]),
          pipe_surface_format(&pfb->zsbuf), pfb->width, pfb->height,
          pfb->nr_cbufs, pfb->samples, gmem->nbins_x * gmem->nbins_y,
-         gmem->bin_w, gmem->bin_h);
+         gmem->bin_w, gmem->bin_h, batch->num_draws, batch->cost,
+         batch->autotune_reason);
       if (ctx->query_prepare)
          ctx->query_prepare(batch, gmem->nbins_x * gmem->nbins_y);
       render_tiles(batch, gmem);
@@ -187,6 +187,28 @@ stage_end(struct pipe_context *pctx, uint64_t ts_ns, enum fd_stage_id stage)
             data->set_name("binHeight");
             data->set_value(std::to_string(p->binh));
          }
+
+         {
+            auto data = event->add_extra_data();
+
+            data->set_name("draws");
+            data->set_value(std::to_string(p->num_draws));
+         }
+
+         {
+            auto data = event->add_extra_data();
+
+            data->set_name("drawCost");
+            data->set_value(std::to_string(p->cost));
+         }
+
+         if (p->autotune != FD_AUTOTUNE_NONE) {
+            auto data = event->add_extra_data();
+
+            data->set_name("autotune");
+            data->set_value(
+               fd_autotune_reason_name((enum fd_autotune_reason)p->autotune));
+         }
       } else if (stage == COMPUTE_STAGE_ID) {
          {
             auto data = event->add_extra_data();
@@ -357,6 +379,9 @@ fd_start_render_pass(struct pipe_context *pctx, uint64_t ts_ns,
    p->nbins = payload->nbins;
    p->binw = payload->binw;
    p->binh = payload->binh;
+   p->num_draws = payload->num_draws;
+   p->cost = payload->cost;
+   p->autotune = payload->autotune;
 }
 
 void
@@ -89,7 +89,9 @@ struct fd_perfetto_state {
    uint16_t nbins;
    uint16_t binw;
    uint16_t binh;
-   // TODO # of draws and possibly estimated cost might be useful addition..
+   uint32_t num_draws;
+   uint32_t cost;
+   uint8_t autotune; /* enum fd_autotune_reason */
 
    /*
     * Compute state for grids:
@@ -99,7 +99,10 @@ begin_end_tp('render_pass',
           TracepointArg(type='uint8_t',          var='samples',       c_format='%u'),
           TracepointArg(type='uint16_t',         var='nbins',         c_format='%u'),
           TracepointArg(type='uint16_t',         var='binw',          c_format='%u'),
-          TracepointArg(type='uint16_t',         var='binh',          c_format='%u')],
+          TracepointArg(type='uint16_t',         var='binh',          c_format='%u'),
+          TracepointArg(type='uint32_t',         var='num_draws',     c_format='%u'),
+          TracepointArg(type='uint32_t',         var='cost',          c_format='%u'),
+          TracepointArg(type='enum fd_autotune_reason', var='autotune', c_format='%s', to_prim_type='fd_autotune_reason_name({})')],
 )
 
 begin_end_tp('binning_ib')
@@ -32,12 +32,15 @@
 #include "i915_debug_private.h"
 #include "i915_fpc.h"
 #include "i915_reg.h"
+#include "i915_screen.h"
 
 #include "nir/nir.h"
 #include "pipe/p_shader_tokens.h"
 #include "tgsi/tgsi_dump.h"
 #include "tgsi/tgsi_info.h"
 #include "tgsi/tgsi_parse.h"
+#include "util/blob.h"
+#include "util/disk_cache.h"
 #include "util/log.h"
 #include "util/ralloc.h"
 #include "util/u_math.h"
@@ -1073,6 +1076,79 @@ i915_fixup_depth_write(struct i915_fp_compile *p)
    }
 }
 
+/**
+ * The translation only depends on the TGSI tokens, so they are the key of
+ * the translated program in the disk cache.
+ */
+static void
+i915_fp_cache_key(struct disk_cache *cache, const struct tgsi_token *tokens,
+                  cache_key key)
+{
+   disk_cache_compute_key(cache, tokens,
+                          tgsi_num_tokens(tokens) * sizeof(struct tgsi_token),
+                          key);
+}
+
+static bool
+i915_fp_cache_load(struct disk_cache *cache, struct i915_fragment_shader *fs)
+{
+   cache_key key;
+   size_t size;
+
+   i915_fp_cache_key(cache, fs->state.tokens, key);
+
+   void *data = disk_cache_get(cache, key, &size);
+   if (!data)
+      return false;
+
+   struct blob_reader blob;
+   blob_reader_init(&blob, data, size);
+
+   fs->program_len = blob_read_uint32(&blob);
+   fs->num_constants = blob_read_uint32(&blob);
+   blob_copy_bytes(&blob, fs->constants, sizeof(fs->constants));
+   blob_copy_bytes(&blob, fs->constant_flags, sizeof(fs->constant_flags));
+   blob_copy_bytes(&blob, fs->texcoords, sizeof(fs->texcoords));
+   fs->reads_pntc = blob_read_uint8(&blob);
+
+   if (blob.overrun || fs->program_len == 0 ||
+       blob.end - blob.current != fs->program_len * sizeof(uint32_t)) {
+      fs->program_len = 0;
+      free(data);
+      return false;
+   }
+
+   fs->program = (uint32_t *)MALLOC(fs->program_len * sizeof(uint32_t));
+   blob_copy_bytes(&blob, fs->program, fs->program_len * sizeof(uint32_t));
+
+   free(data);
+   return true;
+}
+
+static void
+i915_fp_cache_store(struct disk_cache *cache,
+                    const struct i915_fragment_shader *fs)
+{
+   struct blob blob;
+   cache_key key;
+
+   i915_fp_cache_key(cache, fs->state.tokens, key);
+
+   blob_init(&blob);
+   blob_write_uint32(&blob, fs->program_len);
+   blob_write_uint32(&blob, fs->num_constants);
+   blob_write_bytes(&blob, fs->constants, sizeof(fs->constants));
+   blob_write_bytes(&blob, fs->constant_flags, sizeof(fs->constant_flags));
+   blob_write_bytes(&blob, fs->texcoords, sizeof(fs->texcoords));
+   blob_write_uint8(&blob, fs->reads_pntc);
+   blob_write_bytes(&blob, fs->program, fs->program_len * sizeof(uint32_t));
+
+   if (!blob.out_of_memory)
+      disk_cache_put(cache, key, blob.data, blob.size, NULL);
+
+   blob_finish(&blob);
+}
+
 void
 i915_translate_fragment_program(struct i915_context *i915,
                                 struct i915_fragment_shader *fs)
@@ -1082,6 +1158,11 @@ i915_translate_fragment_program(struct i915_context *i915,
    struct i915_token_list *i_tokens;
    bool debug =
       I915_DBG_ON(DBG_FS) && (!fs->internal || NIR_DEBUG(PRINT_INTERNAL));
+   struct disk_cache *cache =
+      i915 && !debug ? i915_screen(i915->base.screen)->disk_cache : NULL;
+
+   if (cache && i915_fp_cache_load(cache, fs))
+      return;
 
    if (debug) {
       mesa_logi("TGSI fragment shader:");
@@ -1097,6 +1178,12 @@ i915_translate_fragment_program(struct i915_context *i915,
    i915_fini_compile(i915, p);
    i915_optimize_free(i_tokens);
 
+   /* Failed programs are replaced by the passthrough shader, which has to
+    * be reported again, so only successful translations are cached.
+    */
+   if (cache && !fs->error)
+      i915_fp_cache_store(cache, fs);
+
    if (debug) {
       if (fs->error)
          mesa_loge("%s", fs->error);
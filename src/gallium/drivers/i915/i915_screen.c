@@ -30,6 +30,9 @@
 #include "nir/nir_to_tgsi.h"
 #include "util/format/u_format.h"
 #include "util/format/u_format_s3tc.h"
+#include "util/disk_cache.h"
+#include "util/hex.h"
+#include "util/mesa-sha1.h"
 #include "util/os_misc.h"
 #include "util/u_inlines.h"
 #include "util/u_memory.h"
@@ -487,11 +490,36 @@ i915_fence_finish(struct pipe_screen *screen, struct pipe_context *ctx,
  * Generic functions
  */
 
+static void
+i915_disk_cache_create(struct i915_screen *is)
+{
+   struct mesa_sha1 ctx;
+   unsigned char sha1[20];
+   char cache_id[20 * 2 + 1];
+
+   _mesa_sha1_init(&ctx);
+   if (!disk_cache_get_function_identifier(i915_disk_cache_create, &ctx))
+      return;
+
+   _mesa_sha1_final(&ctx, sha1);
+   mesa_bytes_to_hex(cache_id, sha1, 20);
+
+   is->disk_cache = disk_cache_create("i915", cache_id, 0);
+}
+
+static struct disk_cache *
+i915_get_disk_shader_cache(struct pipe_screen *screen)
+{
+   return i915_screen(screen)->disk_cache;
+}
+
 static void
 i915_destroy_screen(struct pipe_screen *screen)
 {
    struct i915_screen *is = i915_screen(screen);
 
+   disk_cache_destroy(is->disk_cache);
+
    if (is->iws)
       is->iws->destroy(is->iws);
 
@@ -550,6 +578,7 @@ i915_screen_create(struct i915_winsys *iws)
    is->base.get_device_vendor = i915_get_device_vendor;
    is->base.get_screen_fd = i915_screen_get_fd;
    is->base.finalize_nir = i915_finalize_nir;
+   is->base.get_disk_shader_cache = i915_get_disk_shader_cache;
    is->base.is_format_supported = i915_is_format_supported;
 
    is->base.context_create = i915_create_context;
@@ -567,5 +596,7 @@ i915_screen_create(struct i915_winsys *iws)
 
    i915_debug_init(is);
 
+   i915_disk_cache_create(is);
+
    return &is->base;
 }
@@ -43,6 +43,8 @@ struct i915_screen {
 
    bool is_i945;
 
+   struct disk_cache *disk_cache;
+
    struct {
       bool tiling;
       bool use_blitter;
@@ -423,17 +423,53 @@ iris_use_pinned_bo(struct iris_batch *batch,
    }
 }
 
+static void
+retire_batch_bo(struct iris_batch *batch)
+{
+   if (!batch->bo)
+      return;
+
+   if (batch->retired_bo_count == IRIS_BATCH_RETIRED_BO_COUNT) {
+      iris_bo_unreference(batch->retired_bos[0]);
+      memmove(&batch->retired_bos[0], &batch->retired_bos[1],
+              (IRIS_BATCH_RETIRED_BO_COUNT - 1) * sizeof(batch->retired_bos[0]));
+      batch->retired_bo_count--;
+   }
+
+   batch->retired_bos[batch->retired_bo_count++] = batch->bo;
+   batch->bo = NULL;
+}
+
+static struct iris_bo *
+reuse_retired_batch_bo(struct iris_batch *batch)
+{
+   /* Batches complete in order, if the oldest one is busy they all are. */
+   if (batch->retired_bo_count == 0 || iris_bo_busy(batch->retired_bos[0]))
+      return NULL;
+
+   struct iris_bo *bo = batch->retired_bos[0];
+   batch->retired_bo_count--;
+   memmove(&batch->retired_bos[0], &batch->retired_bos[1],
+           batch->retired_bo_count * sizeof(batch->retired_bos[0]));
+
+   return bo;
+}
+
 static void
 create_batch(struct iris_batch *batch)
 {
    struct iris_screen *screen = batch->screen;
    struct iris_bufmgr *bufmgr = screen->bufmgr;
 
+   batch->bo = reuse_retired_batch_bo(batch);
+
    /* TODO: We probably could suballocate batches... */
-   batch->bo = iris_bo_alloc(bufmgr, "command buffer",
-                             BATCH_SZ + BATCH_RESERVED, 8,
-                             IRIS_MEMZONE_OTHER,
-                             BO_ALLOC_NO_SUBALLOC | BO_ALLOC_CAPTURE);
+   if (!batch->bo) {
+      batch->bo = iris_bo_alloc(bufmgr, "command buffer",
+                                BATCH_SZ + BATCH_RESERVED, 8,
+                                IRIS_MEMZONE_OTHER,
+                                BO_ALLOC_NO_SUBALLOC | BO_ALLOC_CAPTURE);
+   }
    batch->map = iris_bo_map(NULL, batch->bo, MAP_READ | MAP_WRITE);
    batch->map_next = batch->map;
 
@@ -468,7 +504,8 @@ iris_batch_reset(struct iris_batch *batch)
 
    u_trace_fini(&batch->trace);
 
-   iris_bo_unreference(batch->bo);
+   /* The batch was submitted, its buffer can be reused once idle. */
+   retire_batch_bo(batch);
    batch->primary_batch_size = 0;
    batch->total_chained_batch_size = 0;
    batch->contains_draw = false;
@@ -532,6 +569,10 @@ iris_batch_free(const struct iris_context *ice, struct iris_batch *batch)
    batch->map = NULL;
    batch->map_next = NULL;
 
+   for (unsigned i = 0; i < batch->retired_bo_count; i++)
+      iris_bo_unreference(batch->retired_bos[i]);
+   batch->retired_bo_count = 0;
+
    switch (devinfo->kmd_type) {
    case INTEL_KMD_TYPE_I915:
       iris_i915_destroy_batch(batch);
@@ -53,6 +53,9 @@ struct iris_context;
 /* Our target batch size - flush approximately at this point. */
 #define BATCH_SZ (128 * 1024 - BATCH_RESERVED)
 
+/* Number of submitted batch buffers kept around for reuse. */
+#define IRIS_BATCH_RETIRED_BO_COUNT 4
+
 enum iris_batch_name {
    IRIS_BATCH_RENDER,
    IRIS_BATCH_COMPUTE,
@@ -84,6 +87,13 @@ struct iris_batch {
    void *map;
    void *map_next;
 
+   /**
+    * Batchbuffers of previous submissions, oldest first.  They are reused
+    * once idle, which skips the bufmgr cache and its madvise calls.
+    */
+   struct iris_bo *retired_bos[IRIS_BATCH_RETIRED_BO_COUNT];
+   unsigned retired_bo_count;
+
    /** Size of the primary batch being submitted to execbuf (in bytes). */
    unsigned primary_batch_size;
 
@@ -35,6 +35,7 @@
 #include "pipe/p_state.h"
 #include "pipe/p_context.h"
 #include "pipe/p_screen.h"
+#include "util/os_time.h"
 #include "util/u_atomic.h"
 #include "util/u_upload_mgr.h"
 #include "util/u_debug.h"
@@ -1747,6 +1748,24 @@ last_vue_stage(struct iris_context *ice)
    return MESA_SHADER_VERTEX;
 }
 
+/**
+ * Wait for a variant compiled on the shader compiler queue, reporting when
+ * the draw had to wait on it.
+ */
+static void
+variant_wait_with_stall_warning(struct util_debug_callback *dbg,
+                                struct iris_compiled_shader *variant)
+{
+   if (likely(util_queue_fence_is_signalled(&variant->ready)))
+      return;
+
+   int64_t start = os_time_get_nano();
+   util_queue_fence_wait(&variant->ready);
+   perf_debug(dbg, "Waiting on a threaded %s compile stalled for %.03f ms.\n",
+              _mesa_shader_stage_to_abbrev(variant->stage),
+              (os_time_get_nano() - start) / 1000000.0);
+}
+
 /**
  * \param added  Set to \c true if the variant was added to the list (i.e., a
  *               variant matching \c key was not found).  Set to \c false
@@ -1754,6 +1773,7 @@ last_vue_stage(struct iris_context *ice)
  */
 static inline struct iris_compiled_shader *
 find_or_add_variant(const struct iris_screen *screen,
+                    struct util_debug_callback *dbg,
                     struct iris_uncompiled_shader *ish,
                     enum iris_program_cache_id cache_id,
                     const void *key, unsigned key_size,
@@ -1773,7 +1793,7 @@ find_or_add_variant(const struct iris_screen *screen,
          list_first_entry(&ish->variants, struct iris_compiled_shader, link);
 
       if (memcmp(&first->key, key, key_size) == 0) {
-         util_queue_fence_wait(&first->ready);
+         variant_wait_with_stall_warning(dbg, first);
          return first;
       }
 
@@ -1810,7 +1830,7 @@ find_or_add_variant(const struct iris_screen *screen,
    } else {
       simple_mtx_unlock(&ish->lock);
 
-      util_queue_fence_wait(&variant->ready);
+      variant_wait_with_stall_warning(dbg, variant);
    }
 
    assert(stage == variant->stage);
@@ -2045,7 +2065,8 @@ iris_update_compiled_vs(struct iris_context *ice)
    struct iris_compiled_shader *old = ice->shaders.prog[IRIS_CACHE_VS];
    bool added;
    struct iris_compiled_shader *shader =
-      find_or_add_variant(screen, ish, IRIS_CACHE_VS, &key, sizeof(key), &added);
+      find_or_add_variant(screen, &ice->dbg, ish, IRIS_CACHE_VS, &key,
+                          sizeof(key), &added);
 
    if (added && !iris_disk_cache_retrieve(screen, uploader, ish, shader,
                                           &key, sizeof(key))) {
@@ -2287,7 +2308,7 @@ iris_update_compiled_tcs(struct iris_context *ice)
    bool added = false;
 
    if (tcs != NULL) {
-      shader = find_or_add_variant(screen, tcs, IRIS_CACHE_TCS, &key,
+      shader = find_or_add_variant(screen, &ice->dbg, tcs, IRIS_CACHE_TCS, &key,
                                    sizeof(key), &added);
    } else {
       /* Look for and possibly create a passthrough TCS */
@@ -2495,7 +2516,8 @@ iris_update_compiled_tes(struct iris_context *ice)
    struct iris_compiled_shader *old = ice->shaders.prog[IRIS_CACHE_TES];
    bool added;
    struct iris_compiled_shader *shader =
-      find_or_add_variant(screen, ish, IRIS_CACHE_TES, &key, sizeof(key), &added);
+      find_or_add_variant(screen, &ice->dbg, ish, IRIS_CACHE_TES, &key,
+                          sizeof(key), &added);
 
    if (added && !iris_disk_cache_retrieve(screen, uploader, ish, shader,
                                           &key, sizeof(key))) {
@@ -2688,7 +2710,7 @@ iris_update_compiled_gs(struct iris_context *ice)
 
       bool added;
 
-      shader = find_or_add_variant(screen, ish, IRIS_CACHE_GS, &key,
+      shader = find_or_add_variant(screen, &ice->dbg, ish, IRIS_CACHE_GS, &key,
                                    sizeof(key), &added);
 
       if (added && !iris_disk_cache_retrieve(screen, uploader, ish, shader,
@@ -2880,7 +2902,7 @@ iris_update_compiled_fs(struct iris_context *ice)
    struct iris_compiled_shader *old = ice->shaders.prog[IRIS_CACHE_FS];
    bool added;
    struct iris_compiled_shader *shader =
-      find_or_add_variant(screen, ish, IRIS_CACHE_FS, &key,
+      find_or_add_variant(screen, &ice->dbg, ish, IRIS_CACHE_FS, &key,
                           sizeof(key), &added);
 
    if (added && !iris_disk_cache_retrieve(screen, uploader, ish, shader,
@@ -3197,7 +3219,7 @@ iris_update_compiled_cs(struct iris_context *ice)
    struct iris_compiled_shader *old = ice->shaders.prog[IRIS_CACHE_CS];
    bool added;
    struct iris_compiled_shader *shader =
-      find_or_add_variant(screen, ish, IRIS_CACHE_CS, &key,
+      find_or_add_variant(screen, &ice->dbg, ish, IRIS_CACHE_CS, &key,
                           sizeof(key), &added);
 
    if (added && !iris_disk_cache_retrieve(screen, uploader, ish, shader,
@@ -3453,7 +3475,7 @@ iris_get_compute_state_subgroup_size(struct pipe_context *ctx, void *state,
 
    bool added;
    struct iris_compiled_shader *shader =
-      find_or_add_variant(screen, ish, IRIS_CACHE_CS, &key,
+      find_or_add_variant(screen, &ice->dbg, ish, IRIS_CACHE_CS, &key,
                           sizeof(key), &added);
 
    if (added && !iris_disk_cache_retrieve(screen, uploader, ish, shader,
@@ -4104,6 +4126,8 @@ iris_compiler_init(struct iris_screen *screen)
       screen->brw = brw_compiler_create(screen, screen->devinfo);
       screen->brw->shader_debug_log = iris_shader_debug_log;
       screen->brw->shader_perf_log = iris_shader_perf_log;
+      screen->brw->optimistic_simd_heuristic |=
+         screen->driconf.simd_fast_compile;
    } else {
 #ifdef INTEL_USE_ELK
       STATIC_ASSERT(IRIS_MAX_DRAW_BUFFERS == ELK_MAX_DRAW_BUFFERS);
@@ -2217,6 +2217,54 @@ tile_extents(const struct isl_surf *surf,
    *y2_el = DIV_ROUND_UP(box->y + box->height, fmtl->bh) + y0_el;
 }
 
+/**
+ * Returns whether the CPU (de)tiling paths can handle this surface.
+ *
+ * Tile64 is only handled for the 2D single-sampled layouts.
+ */
+static bool
+can_tiled_memcpy(const struct isl_surf *surf)
+{
+   return !isl_tiling_is_64(surf->tiling) ||
+          (surf->dim == ISL_SURF_DIM_2D && surf->samples == 1);
+}
+
+static void
+linear_to_tiled(const struct isl_surf *surf,
+                uint32_t x1, uint32_t x2, uint32_t y1, uint32_t y2,
+                char *dst, const char *src, int32_t src_pitch,
+                isl_memcpy_type copy_type)
+{
+   if (isl_tiling_is_64(surf->tiling)) {
+      isl_memcpy_linear_to_tile64(x1, x2, y1, y2, dst, src,
+                                  surf->row_pitch_B, src_pitch,
+                                  isl_format_get_layout(surf->format)->bpb,
+                                  copy_type);
+   } else {
+      isl_memcpy_linear_to_tiled(x1, x2, y1, y2, dst, src,
+                                 surf->row_pitch_B, src_pitch,
+                                 false, surf->tiling, copy_type);
+   }
+}
+
+static void
+tiled_to_linear(const struct isl_surf *surf,
+                uint32_t x1, uint32_t x2, uint32_t y1, uint32_t y2,
+                char *dst, const char *src, int32_t dst_pitch,
+                isl_memcpy_type copy_type)
+{
+   if (isl_tiling_is_64(surf->tiling)) {
+      isl_memcpy_tile64_to_linear(x1, x2, y1, y2, dst, src,
+                                  dst_pitch, surf->row_pitch_B,
+                                  isl_format_get_layout(surf->format)->bpb,
+                                  copy_type);
+   } else {
+      isl_memcpy_tiled_to_linear(x1, x2, y1, y2, dst, src,
+                                 dst_pitch, surf->row_pitch_B,
+                                 false, surf->tiling, copy_type);
+   }
+}
+
 static void
 iris_unmap_tiled_memcpy(struct iris_transfer *map)
 {
@@ -2225,8 +2273,6 @@ iris_unmap_tiled_memcpy(struct iris_transfer *map)
    struct iris_resource *res = (struct iris_resource *) xfer->resource;
    struct isl_surf *surf = &res->surf;
 
-   const bool has_swizzling = false;
-
    if (xfer->usage & PIPE_MAP_WRITE) {
       char *dst = res->offset +
          iris_bo_map(map->dbg, res->bo, (xfer->usage | MAP_RAW) & MAP_FLAGS);
@@ -2237,9 +2283,8 @@ iris_unmap_tiled_memcpy(struct iris_transfer *map)
 
          void *ptr = map->ptr + s * xfer->layer_stride;
 
-         isl_memcpy_linear_to_tiled(x1, x2, y1, y2, dst, ptr,
-                                    surf->row_pitch_B, xfer->stride,
-                                    has_swizzling, surf->tiling, ISL_MEMCPY);
+         linear_to_tiled(surf, x1, x2, y1, y2, dst, ptr, xfer->stride,
+                         ISL_MEMCPY);
       }
    }
    os_free_aligned(map->buffer);
@@ -2269,8 +2314,6 @@ iris_map_tiled_memcpy(struct iris_transfer *map)
    assert(map->buffer);
    map->ptr = (char *)map->buffer + (x1 & 0xf);
 
-   const bool has_swizzling = false;
-
    if (xfer->usage & PIPE_MAP_READ) {
       char *src = res->offset +
          iris_bo_map(map->dbg, res->bo, (xfer->usage | MAP_RAW) & MAP_FLAGS);
@@ -2282,14 +2325,12 @@ iris_map_tiled_memcpy(struct iris_transfer *map)
          /* Use 's' rather than 'box->z' to rebase the first slice to 0. */
          void *ptr = map->ptr + s * xfer->layer_stride;
 
-         isl_memcpy_tiled_to_linear(x1, x2, y1, y2, ptr, src, xfer->stride,
-                                    surf->row_pitch_B, has_swizzling,
-                                    surf->tiling,
+         tiled_to_linear(surf, x1, x2, y1, y2, ptr, src, xfer->stride,
 #if defined(USE_SSE41)
-                                    util_get_cpu_caps()->has_sse4_1 ?
-                                    ISL_MEMCPY_STREAMING_LOAD :
+                         util_get_cpu_caps()->has_sse4_1 ?
+                         ISL_MEMCPY_STREAMING_LOAD :
 #endif
-                                    ISL_MEMCPY);
+                         ISL_MEMCPY);
       }
    }
 
@@ -2507,8 +2548,7 @@ iris_transfer_map(struct pipe_context *ctx,
    if (prefer_cpu_access(res, box, usage, level, map_would_stall))
       usage |= PIPE_MAP_DIRECTLY;
 
-   /* TODO: Teach iris_map_tiled_memcpy about Tile64... */
-   if (isl_tiling_is_64(res->surf.tiling))
+   if (!can_tiled_memcpy(&res->surf))
       usage &= ~PIPE_MAP_DIRECTLY;
 
    if (!(usage & PIPE_MAP_DIRECTLY)) {
@@ -2629,11 +2669,9 @@ iris_texture_subdata(struct pipe_context *ctx,
     * Linear staging buffers appear to be better than tiled ones, too, so
     * take that path if we need the GPU to perform color compression, or
     * stall-avoidance blits.
-    *
-    * TODO: Teach isl_memcpy_linear_to_tiled about Tile64...
     */
    if (surf->tiling == ISL_TILING_LINEAR ||
-       isl_tiling_is_64(res->surf.tiling) ||
+       !can_tiled_memcpy(surf) ||
        isl_aux_usage_has_compression(res->aux.usage) ||
        resource_is_busy(ice, res) ||
        iris_bo_mmap_mode(res->bo) == IRIS_MMAP_NONE) {
@@ -2658,10 +2696,8 @@ iris_texture_subdata(struct pipe_context *ctx,
       unsigned x1, x2, y1, y2;
       tile_extents(surf, box, level, s, &x1, &x2, &y1, &y2);
 
-      isl_memcpy_linear_to_tiled(x1, x2, y1, y2,
-                                 (void *)dst, (void *)src,
-                                 surf->row_pitch_B, stride,
-                                 false, surf->tiling, ISL_MEMCPY);
+      linear_to_tiled(surf, x1, x2, y1, y2, (void *)dst, (void *)src,
+                      stride, ISL_MEMCPY);
    }
 }
 
@@ -753,6 +753,8 @@ iris_screen_create(int fd, const struct pipe_screen_config *config)
       driQueryOptioni(config->options, "generated_indirect_threshold");
    screen->driconf.disable_threaded_context =
       driQueryOptionb(config->options, "intel_disable_threaded_context");
+   screen->driconf.simd_fast_compile =
+      driQueryOptionb(config->options, "intel_simd_fast_compile");
 
    screen->precompile = debug_get_bool_option("shader_precompile", true);
 
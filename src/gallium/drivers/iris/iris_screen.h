@@ -208,6 +208,7 @@ struct iris_screen {
       bool enable_te_distribution;
       unsigned generated_indirect_threshold;
       bool disable_threaded_context;
+      bool simd_fast_compile;
    } driconf;
 
    /** Does the kernel support various features (KERNEL_HAS_* bitfield)? */
@@ -28,9 +28,12 @@
  * based on threadpool.c but modified heavily to be compute shader tuned.
  */
 
+#include <inttypes.h>
+
 #include "util/u_thread.h"
 #include "util/u_memory.h"
 #include "lp_cs_tpool.h"
+#include "lp_debug.h"
 
 static int
 lp_cs_tpool_worker(void *data)
@@ -43,10 +46,11 @@ lp_cs_tpool_worker(void *data)
 
    while (!pool->shutdown) {
       struct lp_cs_tpool_task *task;
-      unsigned iter_per_thread;
 
-      while (list_is_empty(&pool->workqueue) && !pool->shutdown)
+      while (list_is_empty(&pool->workqueue) && !pool->shutdown) {
+         pool->stats.idle_waits++;
          cnd_wait(&pool->new_work, &pool->m);
+      }
 
       if (pool->shutdown)
          break;
@@ -56,19 +60,23 @@ lp_cs_tpool_worker(void *data)
 
       unsigned this_iter = task->iter_start;
 
-      iter_per_thread = task->iter_per_thread;
-
-      if (task->iter_remainder &&
-          task->iter_start + task->iter_remainder == task->iter_total) {
-         task->iter_remainder--;
-         iter_per_thread = 1;
-      }
+      /* Hand out chunks that shrink as the task nears completion, so that
+       * threads which got cheap iterations pick up more of the remaining
+       * ones instead of idling while another thread works through a large
+       * fixed share.
+       */
+      unsigned iter_remaining = task->iter_total - task->iter_start;
+      unsigned iter_per_thread =
+         DIV_ROUND_UP(iter_remaining, 2 * pool->num_threads);
 
       task->iter_start += iter_per_thread;
 
       if (task->iter_start == task->iter_total)
          list_del(&task->list);
 
+      pool->stats.chunks++;
+      pool->stats.iterations += iter_per_thread;
+
       mtx_unlock(&pool->m);
       for (unsigned i = 0; i < iter_per_thread; i++)
          task->work(task->data, this_iter + i, &lmem);
@@ -121,6 +129,11 @@ lp_cs_tpool_destroy(struct lp_cs_tpool *pool)
       thrd_join(pool->threads[i], NULL);
    }
 
+   LP_DBG(DEBUG_CS, "cs tpool: %u threads, %" PRIu64 " tasks, %" PRIu64
+          " chunks, %" PRIu64 " iterations, %" PRIu64 " idle waits\n",
+          pool->num_threads, pool->stats.tasks, pool->stats.chunks,
+          pool->stats.iterations, pool->stats.idle_waits);
+
    cnd_destroy(&pool->new_work);
    mtx_destroy(&pool->m);
    FREE(pool);
@@ -151,14 +164,12 @@ lp_cs_tpool_queue_task(struct lp_cs_tpool *pool,
    task->data = data;
    task->iter_total = num_iters;
 
-   task->iter_per_thread = num_iters / pool->num_threads;
-   task->iter_remainder = num_iters % pool->num_threads;
-
    cnd_init(&task->finish);
 
    mtx_lock(&pool->m);
 
    list_addtail(&task->list, &pool->workqueue);
+   pool->stats.tasks++;
 
    cnd_broadcast(&pool->new_work);
    mtx_unlock(&pool->m);
@@ -49,6 +49,14 @@ struct lp_cs_tpool {
    unsigned num_threads;
    struct list_head workqueue;
    bool shutdown;
+
+   /* Occupancy statistics, printed on destruction with LP_DEBUG=cs */
+   struct {
+      uint64_t tasks;
+      uint64_t chunks;
+      uint64_t iterations;
+      uint64_t idle_waits; /**< times a worker went to sleep for lack of work */
+   } stats;
 };
 
 struct lp_cs_local_mem {
@@ -66,8 +74,6 @@ struct lp_cs_tpool_task {
    unsigned iter_total;
    unsigned iter_start;
    unsigned iter_finished;
-   unsigned iter_per_thread;
-   unsigned iter_remainder;
 };
 
 struct lp_cs_tpool *lp_cs_tpool_create(unsigned num_threads);
@@ -65,6 +65,7 @@
 #define PERF_NO_ALPHATEST   0x80  	/* disable alpha testing */
 #define PERF_NO_RAST_LINEAR 0x100  	/* disable linear rast */
 #define PERF_NO_SHADE       0x200  	/* disable fragment shaders */
+#define PERF_TIERED_JIT     0x400  	/* unoptimized FS first, optimize in background */
 
 
 extern int LP_PERF;
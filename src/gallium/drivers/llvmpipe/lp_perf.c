@@ -74,6 +74,8 @@ lp_print_counters(void)
       debug_printf("llvmpipe:        nr_pure_shade:         %9u (%3.0f%% of %u)\n", lp_count.nr_pure_shade_64, 0.0, lp_count.nr_shade_64);
       debug_printf("llvmpipe:   nr_partially_covered_64x64: %9u (%3.0f%% of %u)\n", lp_count.nr_partially_covered_64, p3, total_64);
       debug_printf("llvmpipe:   nr_empty_64x64:             %9u (%3.0f%% of %u)\n", lp_count.nr_empty_64, p1, total_64);
+      debug_printf("llvmpipe: nr_zculled_64x64:             %9u\n", lp_count.nr_zculled_64);
+      debug_printf("llvmpipe: nr_zoccluded_64x64:           %9u\n", lp_count.nr_zoccluded_64);
 
       total_16 = (lp_count.nr_empty_16 +
                   lp_count.nr_fully_covered_16 +
@@ -118,9 +120,35 @@ lp_print_counters(void)
       debug_printf("llvmpipe: nr_color_tile_load:           %9u\n", lp_count.nr_color_tile_load);
       debug_printf("llvmpipe: nr_color_tile_store:          %9u\n", lp_count.nr_color_tile_store);
 
+      total_4 = (lp_count.nr_linear_blit +
+                 lp_count.nr_linear_shade +
+                 lp_count.nr_linear_fallback);
+
+      p1 = 100.0 * (float) lp_count.nr_linear_blit / (float) total_4;
+      p2 = 100.0 * (float) lp_count.nr_linear_shade / (float) total_4;
+      p3 = 100.0 * (float) lp_count.nr_linear_fallback / (float) total_4;
+
+      debug_printf("llvmpipe: nr_linear:                    %9u\n", total_4);
+      debug_printf("llvmpipe:   nr_linear_blit:             %9u (%3.0f%% of %u)\n", lp_count.nr_linear_blit, p1, total_4);
+      debug_printf("llvmpipe:   nr_linear_shade:            %9u (%3.0f%% of %u)\n", lp_count.nr_linear_shade, p2, total_4);
+      debug_printf("llvmpipe:   nr_linear_fallback:         %9u (%3.0f%% of %u)\n", lp_count.nr_linear_fallback, p3, total_4);
+
       debug_printf("llvmpipe: nr_llvm_compiles:             %u\n", lp_count.nr_llvm_compiles);
       debug_printf("llvmpipe: total LLVM compile time:      %.2f sec\n", lp_count.llvm_compile_time / 1000000.0);
       debug_printf("llvmpipe: average LLVM compile time:    %.2f sec\n", lp_count.llvm_compile_time / 1000000.0 / lp_count.nr_llvm_compiles);
 
+      for (unsigned i = 0; i < LP_MAX_THREADS; i++) {
+         const struct lp_thread_counters *t = &lp_count.thread[i];
+         int64_t total = t->busy_time + t->idle_time;
+
+         if (!total)
+            continue;
+
+         debug_printf("llvmpipe: thread %2u: bins %9u stolen %9u busy %.3f sec idle %.3f sec (%3.0f%%)\n",
+                      i, t->nr_bins, t->nr_stolen_bins,
+                      t->busy_time / 1000000.0, t->idle_time / 1000000.0,
+                      100.0 * (float) t->idle_time / (float) total);
+      }
+
    }
 }
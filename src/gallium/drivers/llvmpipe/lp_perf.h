@@ -34,6 +34,21 @@
 #define LP_PERF_H
 
 #include "util/compiler.h"
+#include "lp_limits.h"
+
+
+/**
+ * Per rasterizer thread counters.  Each thread only writes its own slot,
+ * and only when LP_DEBUG=counters is set, so these work on release builds.
+ */
+struct lp_thread_counters
+{
+   unsigned nr_bins;
+   unsigned nr_stolen_bins;
+   int64_t busy_time;  /**< total, in microseconds */
+   int64_t idle_time;  /**< time spent waiting for other threads, in usec */
+};
+
 
 /**
  * Various counters
@@ -47,6 +62,8 @@ struct lp_counters
    unsigned nr_empty_64;
    unsigned nr_fully_covered_64;
    unsigned nr_partially_covered_64;
+   unsigned nr_zculled_64;
+   unsigned nr_zoccluded_64;
    unsigned nr_blit_64;
    unsigned nr_pure_blit_64;
    unsigned nr_pure_shade_opaque_64;
@@ -68,6 +85,13 @@ struct lp_counters
    unsigned nr_color_tile_clear;
    unsigned nr_color_tile_load;
    unsigned nr_color_tile_store;
+
+   /* Linear rasterizer tiles/rects, by which path ended up drawing them */
+   unsigned nr_linear_blit;
+   unsigned nr_linear_shade;
+   unsigned nr_linear_fallback;
+
+   struct lp_thread_counters thread[LP_MAX_THREADS];
 };
 
 
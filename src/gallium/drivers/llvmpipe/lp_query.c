@@ -446,8 +446,9 @@ llvmpipe_begin_query(struct pipe_context *pipe, struct pipe_query *q)
    case PIPE_QUERY_OCCLUSION_COUNTER:
    case PIPE_QUERY_OCCLUSION_PREDICATE:
    case PIPE_QUERY_OCCLUSION_PREDICATE_CONSERVATIVE:
-      llvmpipe->active_occlusion_queries++;
-      llvmpipe->dirty |= LP_NEW_OCCLUSION_QUERY;
+      /* The fragment shader only cares whether any query is active. */
+      if (llvmpipe->active_occlusion_queries++ == 0)
+         llvmpipe->dirty |= LP_NEW_OCCLUSION_QUERY;
       break;
    default:
       break;
@@ -529,8 +530,8 @@ llvmpipe_end_query(struct pipe_context *pipe, struct pipe_query *q)
    case PIPE_QUERY_OCCLUSION_PREDICATE:
    case PIPE_QUERY_OCCLUSION_PREDICATE_CONSERVATIVE:
       assert(llvmpipe->active_occlusion_queries);
-      llvmpipe->active_occlusion_queries--;
-      llvmpipe->dirty |= LP_NEW_OCCLUSION_QUERY;
+      if (--llvmpipe->active_occlusion_queries == 0)
+         llvmpipe->dirty |= LP_NEW_OCCLUSION_QUERY;
       break;
    default:
       break;
@@ -556,6 +557,14 @@ llvmpipe_check_render_cond(struct llvmpipe_context *lp)
    bool wait = (lp->render_cond_mode == PIPE_RENDER_COND_WAIT ||
                 lp->render_cond_mode == PIPE_RENDER_COND_BY_REGION_WAIT);
 
+   /* Without waiting, a query whose scene hasn't been flushed yet can't
+    * have a result, so draw normally instead of letting get_query_result()
+    * flush the scene for nothing.
+    */
+   struct llvmpipe_query *pq = llvmpipe_query(lp->render_cond_query);
+   if (!wait && pq->fence && !lp_fence_issued(pq->fence))
+      return true;
+
    uint64_t result;
    bool b = pipe->get_query_result(pipe, lp->render_cond_query, wait,
                               (void*)&result);
@@ -87,7 +87,7 @@ lp_rast_begin(struct lp_rasterizer *rast,
    LP_DBG(DEBUG_RAST, "%s\n", __func__);
 
    lp_scene_begin_rasterization(scene);
-   lp_scene_bin_iter_begin(scene);
+   lp_scene_bin_iter_begin(scene, MAX2(1, rast->num_threads));
 }
 
 
@@ -1071,13 +1071,21 @@ rasterize_scene(struct lp_rasterizer_task *task,
 
    if (!task->rast->no_rast) {
       /* loop over scene bins, rasterize each */
+      struct lp_thread_counters *counters = &lp_count.thread[task->thread_index];
       struct cmd_bin *bin;
+      bool stolen;
       int i, j;
 
       assert(scene);
-      while ((bin = lp_scene_bin_iter_next(scene, &i, &j))) {
+      while ((bin = lp_scene_bin_iter_next(scene, task->thread_index,
+                                           &i, &j, &stolen))) {
          if (!is_empty_bin(bin))
             rasterize_bin(task, bin, i, j);
+
+         if (LP_DEBUG & DEBUG_COUNTERS) {
+            counters->nr_bins++;
+            counters->nr_stolen_bins += stolen;
+         }
       }
    }
 
@@ -1212,11 +1220,25 @@ thread_function(void *init_data)
       if (debug)
          debug_printf("thread %d doing work\n", task->thread_index);
 
+      int64_t start = 0, end = 0;
+      if (LP_DEBUG & DEBUG_COUNTERS)
+         start = os_time_get();
+
       rasterize_scene(task, rast->curr_scene);
 
+      if (LP_DEBUG & DEBUG_COUNTERS)
+         end = os_time_get();
+
       /* wait for all threads to finish with this scene */
       util_barrier_wait(&rast->barrier);
 
+      if (LP_DEBUG & DEBUG_COUNTERS) {
+         struct lp_thread_counters *counters =
+            &lp_count.thread[task->thread_index];
+         counters->busy_time += end - start;
+         counters->idle_time += os_time_get() - end;
+      }
+
       /* XXX: shouldn't be necessary:
        */
       if (task->thread_index == 0) {
@@ -302,6 +302,28 @@ lp_rast_arg_triangle_contained(const struct lp_rast_triangle *triangle,
 }
 
 
+/**
+ * Build argument for a triangle contained in a 16x16 block.
+ *
+ * Like lp_rast_arg_triangle_contained(), but additionally records how
+ * many 4x4 columns (nx) and rows (ny) of the block the triangle's bounding
+ * box touches, so the rasterizer can skip the others.  The counts are
+ * stored as 4 - n so that a plain contained argument walks the whole block.
+ */
+static inline union lp_rast_cmd_arg
+lp_rast_arg_triangle_contained_16(const struct lp_rast_triangle *triangle,
+                                   unsigned x, unsigned y,
+                                   unsigned nx, unsigned ny)
+{
+   union lp_rast_cmd_arg arg;
+   assert(nx >= 1 && nx <= 4);
+   assert(ny >= 1 && ny <= 4);
+   arg.triangle.tri = triangle;
+   arg.triangle.plane_mask = x | (y << 8) | ((4 - nx) << 16) | ((4 - ny) << 18);
+   return arg;
+}
+
+
 static inline union lp_rast_cmd_arg
 lp_rast_arg_rectangle(const struct lp_rast_rectangle *rectangle)
 {
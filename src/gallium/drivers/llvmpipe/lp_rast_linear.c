@@ -91,8 +91,10 @@ lp_rast_linear_tile(struct lp_rasterizer_task *task,
                                    GET_DADX(inputs),
                                    GET_DADY(inputs),
                                    scene->cbufs[0].map,
-                                   scene->cbufs[0].stride))
+                                   scene->cbufs[0].stride)) {
+         LP_COUNT(nr_linear_blit);
          return;
+      }
    }
 
    if (variant->jit_linear) {
@@ -105,10 +107,14 @@ lp_rast_linear_tile(struct lp_rasterizer_task *task,
                               GET_DADX(inputs),
                               GET_DADY(inputs),
                               scene->cbufs[0].map,
-                              scene->cbufs[0].stride))
+                              scene->cbufs[0].stride)) {
+         LP_COUNT(nr_linear_shade);
          return;
+      }
    }
 
+   LP_COUNT(nr_linear_fallback);
+
    {
       struct u_rect box;
       box.x0 = task->x;
@@ -160,6 +166,7 @@ lp_rast_linear_rect(struct lp_rasterizer_task *task,
                                    GET_DADY(inputs),
                                    scene->cbufs[0].map,
                                    scene->cbufs[0].stride)) {
+         LP_COUNT(nr_linear_blit);
          return;
       }
    }
@@ -173,10 +180,12 @@ lp_rast_linear_rect(struct lp_rasterizer_task *task,
                               GET_DADY(inputs),
                               scene->cbufs[0].map,
                               scene->cbufs[0].stride)) {
+         LP_COUNT(nr_linear_shade);
          return;
       }
    }
 
+   LP_COUNT(nr_linear_fallback);
    lp_rast_linear_rect_fallback(task, inputs, &box);
 }
 
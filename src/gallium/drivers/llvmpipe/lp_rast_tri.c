@@ -295,7 +295,9 @@ lp_rast_triangle_32_3_16(struct lp_rasterizer_task *task,
    const struct lp_rast_triangle *tri = arg.triangle.tri;
    const struct lp_rast_plane *plane = GET_PLANES(tri);
    const int x = (arg.triangle.plane_mask & 0xff) + task->x;
-   const int y = (arg.triangle.plane_mask >> 8) + task->y;
+   const int y = ((arg.triangle.plane_mask >> 8) & 0xff) + task->y;
+   const unsigned nr_cols = 4 - ((arg.triangle.plane_mask >> 16) & 3);
+   const unsigned nr_rows = 4 - ((arg.triangle.plane_mask >> 18) & 3);
 
    struct { unsigned mask:16; unsigned i:8; unsigned j:8; } out[16];
    unsigned nr = 0;
@@ -342,10 +344,10 @@ lp_rast_triangle_32_3_16(struct lp_rasterizer_task *task,
    transpose4_epi32(&zero, &dcdx, &dcdx2, &dcdx3,
                     &span_0, &span_1, &span_2, &unused);
 
-   for (unsigned i = 0; i < 4; i++) {
+   for (unsigned i = 0; i < nr_rows; i++) {
       __m128i cx = c;
 
-      for (unsigned j = 0; j < 4; j++) {
+      for (unsigned j = 0; j < nr_cols; j++) {
          __m128i c4rej = _mm_add_epi32(cx, rej4);
          __m128i rej_masks = _mm_srai_epi32(c4rej, 31);
 
@@ -578,7 +580,9 @@ lp_rast_triangle_32_3_16(struct lp_rasterizer_task *task,
    const struct lp_rast_triangle *tri = arg.triangle.tri;
    const struct lp_rast_plane *plane = GET_PLANES(tri);
    const int x = (arg.triangle.plane_mask & 0xff) + task->x;
-   const int y = (arg.triangle.plane_mask >> 8) + task->y;
+   const int y = ((arg.triangle.plane_mask >> 8) & 0xff) + task->y;
+   const unsigned nr_cols = 4 - ((arg.triangle.plane_mask >> 16) & 3);
+   const unsigned nr_rows = 4 - ((arg.triangle.plane_mask >> 18) & 3);
 
    struct { unsigned mask:16; unsigned i:8; unsigned j:8; } out[16];
    unsigned nr = 0;
@@ -639,10 +643,10 @@ lp_rast_triangle_32_3_16(struct lp_rasterizer_task *task,
    transpose4_epi32(&zero, &dcdx, &dcdx2, &dcdx3,
                     &span_0, &span_1, &span_2, &unused);
 
-   for (unsigned i = 0; i < 4; i++) {
+   for (unsigned i = 0; i < nr_rows; i++) {
       __m128i cx = c;
 
-      for (unsigned j = 0; j < 4; j++) {
+      for (unsigned j = 0; j < nr_cols; j++) {
          __m128i c4rej = vec_add_epi32(cx, rej4);
          __m128i rej_masks = vec_srai_epi32(c4rej, 31);
 
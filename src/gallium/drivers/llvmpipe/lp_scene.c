@@ -30,6 +30,7 @@
 #include "util/u_memory.h"
 #include "util/reallocarray.h"
 #include "util/u_inlines.h"
+#include "util/u_atomic.h"
 #include "util/format/u_format.h"
 #include "lp_scene.h"
 #include "lp_fence.h"
@@ -103,6 +104,7 @@ lp_scene_destroy(struct lp_scene *scene)
    lp_scene_end_rasterization(scene);
    mtx_destroy(&scene->mutex);
    free(scene->tiles);
+   free(scene->bin_order);
    assert(scene->data.head == &scene->data.first);
    slab_free_st(&scene->setup->scene_slab, scene);
 }
@@ -534,60 +536,90 @@ lp_scene_is_resource_referenced(const struct lp_scene *scene,
 }
 
 
-/** advance curr_x,y to the next bin */
-static bool
-next_bin(struct lp_scene *scene)
+static int
+compare_bin_cost(const void *a, const void *b)
 {
-   scene->curr_x++;
-   if (scene->curr_x >= scene->tiles_x) {
-      scene->curr_x = 0;
-      scene->curr_y++;
-   }
-   if (scene->curr_y >= scene->tiles_y) {
-      /* no more bins */
-      return false;
-   }
-   return true;
+   const uint32_t ka = *(const uint32_t *)a;
+   const uint32_t kb = *(const uint32_t *)b;
+
+   /* descending order */
+   return (ka < kb) - (ka > kb);
 }
 
 
+/**
+ * Prepare the per-thread bin queues for rasterization.
+ *
+ * The cost of a bin is estimated from the number of commands binned into
+ * it.  Bins are dealt out round-robin in order of decreasing cost so that
+ * every queue starts with its most expensive tiles and the cheap ones are
+ * left for the end of the frame, where idle threads can steal them.
+ */
 void
-lp_scene_bin_iter_begin(struct lp_scene *scene)
+lp_scene_bin_iter_begin(struct lp_scene *scene, unsigned num_queues)
 {
-   scene->curr_x = scene->curr_y = -1;
+   const unsigned num_tiles = lp_scene_get_num_bins(scene);
+   unsigned num_bins = 0;
+
+   assert(num_queues > 0 && num_queues <= LP_MAX_THREADS);
+
+   for (unsigned i = 0; i < num_tiles; i++) {
+      const struct cmd_bin *bin = &scene->tiles[i];
+      unsigned cost = 0;
+
+      if (!bin->head)
+         continue;
+
+      for (const struct cmd_block *block = bin->head; block;
+           block = block->next)
+         cost += block->count;
+
+      scene->bin_order[num_bins++] = (MIN2(cost, 0xffff) << 16) | i;
+   }
+
+   qsort(scene->bin_order, num_bins, sizeof(scene->bin_order[0]),
+         compare_bin_cost);
+
+   scene->num_bin_queues = num_queues;
+   for (unsigned q = 0; q < num_queues; q++) {
+      scene->bin_queues[q].next = 0;
+      scene->bin_queues[q].count =
+         q < num_bins ? DIV_ROUND_UP(num_bins - q, num_queues) : 0;
+   }
 }
 
 
 /**
- * Return pointer to next bin to be rendered.
- * The lp_scene::curr_x and ::curr_y fields will be advanced.
- * Multiple rendering threads will call this function to get a chunk
- * of work (a bin) to work on.
+ * Return pointer to next bin to be rendered by the given queue's thread.
+ * The thread's own queue is drained first, after which bins are stolen
+ * from the other queues.  Returns NULL once every queue is empty.
+ * Empty bins are never returned.
  */
 struct cmd_bin *
-lp_scene_bin_iter_next(struct lp_scene *scene , int *x, int *y)
+lp_scene_bin_iter_next(struct lp_scene *scene, unsigned queue,
+                       int *x, int *y, bool *stolen)
 {
-   struct cmd_bin *bin = NULL;
+   const unsigned num_queues = scene->num_bin_queues;
 
-   mtx_lock(&scene->mutex);
+   for (unsigned i = 0; i < num_queues; i++) {
+      const unsigned q = (queue + i) % num_queues;
+      struct lp_bin_queue *bq = &scene->bin_queues[q];
 
-   if (scene->curr_x < 0) {
-      /* first bin */
-      scene->curr_x = 0;
-      scene->curr_y = 0;
-   } else if (!next_bin(scene)) {
-      /* no more bins left */
-      goto end;
-   }
+      if (p_atomic_read(&bq->next) >= bq->count)
+         continue;
 
-   bin = lp_scene_get_bin(scene, scene->curr_x, scene->curr_y);
-   *x = scene->curr_x;
-   *y = scene->curr_y;
+      const unsigned k = p_atomic_inc_return(&bq->next) - 1;
+      if (k >= bq->count)
+         continue;
 
-end:
-   /*printf("return bin %p at %d, %d\n", (void *) bin, *bin_x, *bin_y);*/
-   mtx_unlock(&scene->mutex);
-   return bin;
+      const unsigned idx = scene->bin_order[q + k * num_queues] & 0xffff;
+      *x = idx % scene->tiles_x;
+      *y = idx / scene->tiles_x;
+      *stolen = i != 0;
+      return &scene->tiles[idx];
+   }
+
+   return NULL;
 }
 
 
@@ -611,9 +643,18 @@ lp_scene_begin_binning(struct lp_scene *scene,
       if (!scene->tiles)
          return;
       memset(scene->tiles, 0, sizeof(struct cmd_bin) * num_required_tiles);
+
+      scene->bin_order = reallocarray(scene->bin_order, num_required_tiles,
+                                      sizeof(uint32_t));
+      if (!scene->bin_order)
+         return;
       scene->num_alloced_tiles = num_required_tiles;
    }
 
+   /* Nothing is known about depth values loaded from memory */
+   lp_scene_bin_zmax_everywhere(scene, INFINITY);
+   scene->zcull_clobbered = false;
+
    /*
     * Determine how many layers the fb has (used for clamping layer value).
     * OpenGL (but not d3d10) permits different amount of layers per rt,
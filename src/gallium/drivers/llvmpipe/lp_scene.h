@@ -38,6 +38,7 @@
 #include "util/u_thread.h"
 #include "lp_rast.h"
 #include "lp_debug.h"
+#include "lp_limits.h"
 
 struct lp_scene_queue;
 struct lp_rast_state;
@@ -98,6 +99,9 @@ struct cmd_bin {
    const struct lp_rast_state *last_state;  /* most recent state set in bin */
    struct cmd_block *head;
    struct cmd_block *tail;
+   float zmax;  /* upper bound of the tile's depth values, or INFINITY */
+   float zmin;  /* lower bound of the depth of the tile's values and of
+                 * everything binned, or -INFINITY */
 };
 
 
@@ -120,6 +124,16 @@ struct resource_ref;
 
 struct shader_ref;
 
+/**
+ * Per-thread queue of bins.  Queue N owns the entries N, N + num_queues,
+ * N + 2 * num_queues, ... of lp_scene::bin_order; threads which run out of
+ * their own bins steal from the other queues.
+ */
+struct lp_bin_queue {
+   unsigned next;   /**< next entry to hand out, bumped atomically */
+   unsigned count;  /**< number of entries owned by this queue */
+};
+
 struct lp_scene_surface {
    uint8_t *map;
    unsigned stride;
@@ -150,6 +164,8 @@ struct lp_scene {
    unsigned num_active_queries;
    /* If queries were either active or there were begin/end query commands */
    bool had_queries;
+   /* If depth writes may have pushed depth values past the bins' zmax */
+   bool zcull_clobbered;
 
    /* Framebuffer mappings - valid only between begin_rasterization()
     * and end_rasterization().
@@ -197,11 +213,18 @@ struct lp_scene {
     */
    unsigned tiles_x, tiles_y;
 
-   int curr_x, curr_y;  /**< for iterating over bins */
    mtx_t mutex;
 
    unsigned num_alloced_tiles;
    struct cmd_bin *tiles;
+
+   /**
+    * Non-empty bins sorted by decreasing estimated cost, packed as
+    * (cost << 16) | bin index.  Filled by lp_scene_bin_iter_begin().
+    */
+   uint32_t *bin_order;
+   struct lp_bin_queue bin_queues[LP_MAX_THREADS];
+   unsigned num_bin_queues;
    struct data_block_list data;
 };
 
@@ -344,6 +367,12 @@ lp_scene_bin_command(struct lp_scene *scene,
       tail->count++;
    }
 
+   /* Commands other than these may have any effect on depth, users binning
+    * primitives with known depth bounds restore zmin themselves.
+    */
+   if (cmd != LP_RAST_OP_SET_STATE && cmd != LP_RAST_OP_CLEAR_COLOR)
+      bin->zmin = -INFINITY;
+
    return true;
 }
 
@@ -372,6 +401,20 @@ lp_scene_bin_cmd_with_state(struct lp_scene *scene,
 }
 
 
+/* Set the depth bounds of all active bins, after a depth clear.
+ */
+static inline void
+lp_scene_bin_zmax_everywhere(struct lp_scene *scene, float zmax)
+{
+   const float zmin = zmax != INFINITY ? zmax : -INFINITY;
+
+   for (unsigned i = 0; i < scene->tiles_x * scene->tiles_y; i++) {
+      scene->tiles[i].zmax = zmax;
+      scene->tiles[i].zmin = zmin;
+   }
+}
+
+
 /* Add a command to all active bins.
  */
 static inline bool
@@ -398,10 +441,11 @@ lp_scene_get_num_bins(const struct lp_scene *scene)
 
 
 void
-lp_scene_bin_iter_begin(struct lp_scene *scene);
+lp_scene_bin_iter_begin(struct lp_scene *scene, unsigned num_queues);
 
 struct cmd_bin *
-lp_scene_bin_iter_next(struct lp_scene *scene, int *x, int *y);
+lp_scene_bin_iter_next(struct lp_scene *scene, unsigned queue,
+                       int *x, int *y, bool *stolen);
 
 
 
@@ -40,6 +40,7 @@
 #include "gallivm/lp_bld_nir.h"
 #include "gallivm/lp_bld_init.h"
 #include "util/disk_cache.h"
+#include "util/hash_table.h"
 #include "util/hex.h"
 #include "util/os_misc.h"
 #include "util/os_time.h"
@@ -102,6 +103,7 @@ static const struct debug_named_value lp_perf_flags[] = {
    { "no_alphatest",   PERF_NO_ALPHATEST, NULL },
    { "no_rast_linear", PERF_NO_RAST_LINEAR, NULL },
    { "no_shade",       PERF_NO_SHADE, NULL },
+   { "tiered_jit",     PERF_TIERED_JIT, NULL },
    DEBUG_NAMED_VALUE_END
 };
 
@@ -349,6 +351,8 @@ llvmpipe_init_screen_caps(struct pipe_screen *screen)
     * draw module's state, which is per-context.
     */
    caps->shareable_shaders = false;
+   /* The other CSOs are plain copies of their templates. */
+   caps->shareable_csos = true;
    caps->max_gs_invocations = 32;
    caps->max_shader_buffer_size = LP_MAX_TGSI_SHADER_BUFFER_SIZE;
    caps->framebuffer_no_attachment = true;
@@ -758,6 +762,9 @@ llvmpipe_destroy_screen(struct pipe_screen *_screen)
    if (screen->cs_tpool)
       lp_cs_tpool_destroy(screen->cs_tpool);
 
+   if (util_queue_is_initialized(&screen->jit_queue))
+      util_queue_destroy(&screen->jit_queue);
+
    if (screen->rast)
       lp_rast_destroy(screen->rast);
 
@@ -786,6 +793,8 @@ llvmpipe_destroy_screen(struct pipe_screen *_screen)
 #endif
    mtx_destroy(&screen->rast_mutex);
    mtx_destroy(&screen->cs_mutex);
+   _mesa_hash_table_destroy(screen->code_cache, NULL);
+   mtx_destroy(&screen->code_cache_mutex);
    FREE(screen);
 }
 
@@ -857,6 +866,11 @@ lp_disk_cache_create(struct llvmpipe_screen *screen)
       return;
 
    _mesa_sha1_update(&ctx, &gallivm_perf, sizeof(gallivm_perf));
+   /* The vector width can be overridden with LP_NATIVE_VECTOR_WIDTH, so it
+    * is not implied by the CPU caps.
+    */
+   _mesa_sha1_update(&ctx, &lp_native_vector_width,
+                     sizeof(lp_native_vector_width));
    update_cache_sha1_cpu(&ctx);
    _mesa_sha1_final(&ctx, sha1);
    mesa_bytes_to_hex(cache_id, sha1, 20);
@@ -886,12 +900,76 @@ llvmpipe_screen_get_fd(struct pipe_screen *_screen)
 }
 
 
+/* Upper bound of the machine code kept in memory by the screen */
+#define LP_CODE_CACHE_MAX_SIZE (64 * 1024 * 1024)
+
+struct lp_code_cache_key {
+   unsigned char sha1[20];
+};
+
+DERIVE_HASH_TABLE(lp_code_cache_key);
+
+struct lp_code_cache_entry {
+   struct lp_code_cache_key key;
+   size_t size;
+   uint8_t data[];
+};
+
+
+static void
+lp_code_cache_insert(struct llvmpipe_screen *screen, const void *data,
+                     size_t size, unsigned char ir_sha1_cache_key[20])
+{
+   mtx_lock(&screen->code_cache_mutex);
+
+   if (screen->code_cache_size + size <= LP_CODE_CACHE_MAX_SIZE) {
+      struct lp_code_cache_entry *entry =
+         ralloc_size(screen->code_cache, sizeof(*entry) + size);
+      if (entry) {
+         memcpy(entry->key.sha1, ir_sha1_cache_key, 20);
+         entry->size = size;
+         memcpy(entry->data, data, size);
+
+         /* Another context might have compiled the same shader meanwhile. */
+         if (!_mesa_hash_table_search(screen->code_cache, &entry->key)) {
+            _mesa_hash_table_insert(screen->code_cache, &entry->key, entry);
+            screen->code_cache_size += size;
+         } else {
+            ralloc_free(entry);
+         }
+      }
+   }
+
+   mtx_unlock(&screen->code_cache_mutex);
+}
+
+
 void
 lp_disk_cache_find_shader(struct llvmpipe_screen *screen,
                           struct lp_cached_code *cache,
                           unsigned char ir_sha1_cache_key[20])
 {
    unsigned char sha1[CACHE_KEY_SIZE];
+   struct lp_code_cache_key key;
+
+   memcpy(key.sha1, ir_sha1_cache_key, 20);
+
+   mtx_lock(&screen->code_cache_mutex);
+   struct hash_entry *he = _mesa_hash_table_search(screen->code_cache, &key);
+   if (he) {
+      struct lp_code_cache_entry *entry = he->data;
+
+      /* The gallivm state takes ownership of the data. */
+      cache->data = malloc(entry->size);
+      if (cache->data) {
+         memcpy(cache->data, entry->data, entry->size);
+         cache->data_size = entry->size;
+      }
+   }
+   mtx_unlock(&screen->code_cache_mutex);
+
+   if (cache->data_size)
+      return;
 
    if (!screen->disk_shader_cache)
       return;
@@ -907,6 +985,8 @@ lp_disk_cache_find_shader(struct llvmpipe_screen *screen,
    }
    cache->data_size = binary_size;
    cache->data = buffer;
+
+   lp_code_cache_insert(screen, buffer, binary_size, ir_sha1_cache_key);
 }
 
 
@@ -917,7 +997,13 @@ lp_disk_cache_insert_shader(struct llvmpipe_screen *screen,
 {
    unsigned char sha1[CACHE_KEY_SIZE];
 
-   if (!screen->disk_shader_cache || !cache->data_size || cache->dont_cache)
+   if (!cache->data_size || cache->dont_cache)
+      return;
+
+   lp_code_cache_insert(screen, cache->data, cache->data_size,
+                        ir_sha1_cache_key);
+
+   if (!screen->disk_shader_cache)
       return;
    disk_cache_compute_key(screen->disk_shader_cache, ir_sha1_cache_key,
                           20, sha1);
@@ -1051,6 +1137,19 @@ llvmpipe_create_screen(struct sw_winsys *winsys)
 
    (void) mtx_init(&screen->late_mutex, mtx_plain);
 
+   (void) mtx_init(&screen->code_cache_mutex, mtx_plain);
+   screen->code_cache = lp_code_cache_key_table_create(NULL);
+
+   /* A single low priority thread is enough to keep up with the variants
+    * a frame creates, without taking cores away from the rasterizer.
+    */
+   if (LP_PERF & PERF_TIERED_JIT) {
+      if (!util_queue_init(&screen->jit_queue, "lpjit", 64, 1,
+                           UTIL_QUEUE_INIT_RESIZE_IF_FULL |
+                           UTIL_QUEUE_INIT_USE_MINIMUM_PRIORITY, NULL))
+         LP_PERF &= ~PERF_TIERED_JIT;
+   }
+
    llvmpipe_init_shader_caps(&screen->base);
    llvmpipe_init_compute_caps(&screen->base);
    llvmpipe_init_screen_caps(&screen->base);
@@ -37,6 +37,7 @@
 #include "pipe/p_screen.h"
 #include "pipe/p_defines.h"
 #include "util/u_thread.h"
+#include "util/u_queue.h"
 #include "util/list.h"
 #include "util/vma.h"
 #include "gallivm/lp_bld.h"
@@ -63,6 +64,9 @@ struct llvmpipe_screen
    struct lp_cs_tpool *cs_tpool;
    mtx_t cs_mutex;
 
+   /* Background recompiles of fragment shader variants with LP_PERF=tiered_jit */
+   struct util_queue jit_queue;
+
    mtx_t late_mutex;
    bool late_init_done;
 
@@ -73,6 +77,14 @@ struct llvmpipe_screen
 
    struct disk_cache *disk_shader_cache;
 
+   /* Machine code of the shaders compiled by any context of this screen,
+    * keyed like the disk cache, so that the other contexts don't have to go
+    * through LLVM again for the same shader.
+    */
+   mtx_t code_cache_mutex;
+   struct hash_table *code_cache;
+   size_t code_cache_size;
+
 #if defined(HAVE_LIBDRM) && defined(HAVE_LINUX_UDMABUF_H)
    int udmabuf_fd;
 #endif
@@ -65,15 +65,52 @@ static bool
 try_update_scene_state(struct lp_setup_context *setup);
 
 
+DEBUG_GET_ONCE_NUM_OPTION(lp_max_scenes, "LP_MAX_SCENES", MAX_SCENES)
+DEBUG_GET_ONCE_NUM_OPTION(lp_max_scene_memory, "LP_MAX_SCENE_MEMORY",
+                          DEFAULT_MAX_SCENE_MEMORY_MB)
+
+
+/**
+ * Sum of the binned data of all scenes still owned by the rasterizer.
+ */
+static uint64_t
+lp_setup_inflight_scene_size(const struct lp_setup_context *setup)
+{
+   uint64_t size = 0;
+
+   for (unsigned i = 0; i < setup->num_active_scenes; i++) {
+      if (setup->scenes[i]->fence)
+         size += setup->scenes[i]->scene_size;
+   }
+
+   return size;
+}
+
+
 static unsigned
 lp_setup_wait_empty_scene(struct lp_setup_context *setup)
 {
-   /* just use the first scene if we run out */
-   if (setup->scenes[0]->fence) {
-      lp_fence_wait(setup->scenes[0]->fence);
-      lp_scene_end_rasterization(setup->scenes[0]);
+   /* Scenes are rasterized in the order they were queued, so wait for the
+    * one with the oldest fence; it is the first one to become available.
+    */
+   unsigned oldest = 0;
+
+   for (unsigned i = 1; i < setup->num_active_scenes; i++) {
+      const struct lp_fence *fence = setup->scenes[i]->fence;
+      const struct lp_fence *oldest_fence = setup->scenes[oldest]->fence;
+
+      if (!fence)
+         continue;
+
+      if (!oldest_fence || (int)(fence->id - oldest_fence->id) < 0)
+         oldest = i;
    }
-   return 0;
+
+   if (setup->scenes[oldest]->fence) {
+      lp_fence_wait(setup->scenes[oldest]->fence);
+      lp_scene_end_rasterization(setup->scenes[oldest]);
+   }
+   return oldest;
 }
 
 
@@ -95,11 +132,16 @@ lp_setup_get_empty_scene(struct lp_setup_context *setup)
       }
    }
 
-   if (setup->num_active_scenes + 1 > MAX_SCENES) {
-      i = lp_setup_wait_empty_scene(setup);
-   } else if (i == setup->num_active_scenes) {
-      /* allocate a new scene */
-      struct lp_scene *scene = lp_scene_create(setup);
+   if (i == setup->num_active_scenes) {
+      /* Grow the scene ring while there is room left in the memory budget,
+       * so that binning can run ahead of rasterization.
+       */
+      struct lp_scene *scene = NULL;
+
+      if (setup->num_active_scenes < setup->max_scenes &&
+          lp_setup_inflight_scene_size(setup) < setup->max_scene_memory)
+         scene = lp_scene_create(setup);
+
       if (!scene) {
          /* block and reuse scenes */
          i = lp_setup_wait_empty_scene(setup);
@@ -312,6 +354,9 @@ begin_binning(struct lp_setup_context *setup)
                                          setup->clear.zsmask))) {
             return false;
          }
+
+         if (setup->clear.flags & PIPE_CLEAR_DEPTH)
+            lp_scene_bin_zmax_everywhere(scene, setup->clear.zmax);
       }
    }
 
@@ -537,6 +582,11 @@ lp_setup_try_clear_zs(struct lp_setup_context *setup,
 
    zsvalue &= zsmask;
 
+   /* Depth values outside [0,1] may get clamped differently when stored
+    * than when tested, don't use them for culling.
+    */
+   const float zmax = depth >= 0.0 && depth <= 1.0 ? depth : INFINITY;
+
    if (format == PIPE_FORMAT_Z24X8_UNORM ||
        format == PIPE_FORMAT_X8Z24_UNORM) {
       /*
@@ -560,6 +610,9 @@ lp_setup_try_clear_zs(struct lp_setup_context *setup,
                                    LP_RAST_OP_CLEAR_ZSTENCIL,
                                    lp_rast_arg_clearzs(zsvalue, zsmask)))
          return false;
+
+      if (flags & PIPE_CLEAR_DEPTH)
+         lp_scene_bin_zmax_everywhere(scene, zmax);
    } else {
       /* Put ourselves into the 'pre-clear' state, specifically to try
        * and accumulate multiple clears to color and depth_stencil
@@ -573,6 +626,8 @@ lp_setup_try_clear_zs(struct lp_setup_context *setup,
       setup->clear.zsmask |= zsmask;
       setup->clear.zsvalue =
          (setup->clear.zsvalue & ~zsmask) | (zsvalue & zsmask);
+      if (flags & PIPE_CLEAR_DEPTH)
+         setup->clear.zmax = zmax;
    }
 
    return true;
@@ -1169,6 +1224,9 @@ try_update_scene_state(struct lp_setup_context *setup)
 
          setup->fs.stored = stored;
 
+         if (stored->variant->zcull_clobber)
+            scene->zcull_clobbered = true;
+
          /* The scene now references the textures in the rasterization
           * state record.  Note that now.
           */
@@ -1404,6 +1462,9 @@ lp_setup_create(struct pipe_context *pipe,
    setup->pipe = pipe;
 
    setup->num_threads = screen->num_threads;
+   setup->max_scenes = CLAMP(debug_get_option_lp_max_scenes(), 1, MAX_SCENES);
+   setup->max_scene_memory =
+      (uint64_t)debug_get_option_lp_max_scene_memory() * 1024 * 1024;
    setup->vbuf = draw_vbuf_stage(draw, &setup->base);
    if (!setup->vbuf) {
       goto no_vbuf;
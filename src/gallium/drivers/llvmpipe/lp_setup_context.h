@@ -59,6 +59,13 @@ struct lp_setup_variant;
 #define INITIAL_SCENES 4
 #define MAX_SCENES 64
 
+/**
+ * Default budget, in MB, for binned data of scenes waiting to be (or being)
+ * rasterized.  Once it is exceeded setup stops growing the scene ring and
+ * waits for the oldest scene instead.
+ */
+#define DEFAULT_MAX_SCENE_MEMORY_MB 1024
+
 
 
 /**
@@ -93,6 +100,8 @@ struct lp_setup_context
 
    struct slab_mempool scene_slab;
    int num_active_scenes;
+   unsigned max_scenes;          /**< LP_MAX_SCENES */
+   uint64_t max_scene_memory;    /**< LP_MAX_SCENE_MEMORY, in bytes */
    struct lp_scene *scenes[MAX_SCENES];  /**< all the scenes */
    struct lp_scene *scene;               /**< current scene being built */
 
@@ -133,6 +142,7 @@ struct lp_setup_context
       union util_color color_val[PIPE_MAX_COLOR_BUFS];
       uint64_t zsmask;
       uint64_t zsvalue;               /**< lp_rast_clear_zstencil() cmd */
+      float zmax;                     /**< see cmd_bin::zmax */
    } clear;
 
    enum setup_state {
@@ -300,7 +310,8 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                       bool opaque,
                       const struct u_rect *bbox,
                       int nr_planes,
-                      unsigned scissor_index);
+                      unsigned scissor_index,
+                      float zmin, float zmax);
 
 bool
 lp_setup_bin_rectangle(struct lp_setup_context *setup,
@@ -713,8 +713,12 @@ try_setup_line(struct lp_setup_context *setup,
       lp_setup_add_scissor_planes(scissor, &plane[4], s_planes);
    }
 
+   /* Wide lines and their end caps may extrapolate z past the endpoints'
+    * values, so leave them out of depth culling.
+    */
    return lp_setup_bin_triangle(setup, line, use_32bits, false,
-                                &bboxpos, nr_planes, viewport_index);
+                                &bboxpos, nr_planes, viewport_index,
+                                -INFINITY, INFINITY);
 }
 
 
@@ -548,7 +548,8 @@ try_setup_point(struct lp_setup_context *setup,
 
       return lp_setup_bin_triangle(setup, point, use_32bits,
                                    setup->fs.current.variant->opaque,
-                                   &bbox, nr_planes, viewport_index);
+                                   &bbox, nr_planes, viewport_index,
+                                   v0[0][2], v0[0][2]);
 
    } else {
       struct lp_rast_rectangle *point =
@@ -745,7 +745,9 @@ do_triangle_ccw(struct lp_setup_context *setup,
 
    return lp_setup_bin_triangle(setup, tri, use_32bits,
                                 check_opaque(setup, v0, v1, v2),
-                                &bbox, nr_planes, viewport_index);
+                                &bbox, nr_planes, viewport_index,
+                                MIN3(v0[0][2], v1[0][2], v2[0][2]),
+                                MAX3(v0[0][2], v1[0][2], v2[0][2]));
 }
 
 /*
@@ -776,6 +778,67 @@ floor_pot(uint32_t n)
 }
 
 
+/*
+ * Margin between a primitive's nearest z and a tile's zmax before the
+ * tile gets culled.  Covers both precision of the interpolated z and the
+ * rounding to the depth buffer format (a LEQUAL test passes on equal
+ * values), down to 16 bit depth.
+ */
+#define LP_ZCULL_EPSILON (1.0f / (1 << 15))
+
+
+/*
+ * Returns true if the primitive can't pass the depth test anywhere in the
+ * given tile.
+ */
+static inline bool
+zcull_tile(struct lp_scene *scene, int x, int y, float zmin)
+{
+   if (zmin - LP_ZCULL_EPSILON < lp_scene_get_bin(scene, x, y)->zmax)
+      return false;
+
+   LP_COUNT(nr_zculled_64);
+   return true;
+}
+
+
+/*
+ * Bin a triangle command, folding zmin (the lower bound of the depth the
+ * command can produce, or -INFINITY) into the bin's zmin which binning a
+ * command otherwise resets.
+ */
+static inline bool
+bin_triangle_cmd(struct lp_scene *scene, int x, int y,
+                 const struct lp_rast_state *state,
+                 unsigned cmd, union lp_rast_cmd_arg arg,
+                 float zmin)
+{
+   struct cmd_bin *bin = lp_scene_get_bin(scene, x, y);
+   const float bin_zmin = bin->zmin;
+
+   if (!lp_scene_bin_cmd_with_state(scene, x, y, state, cmd, arg))
+      return false;
+
+   bin->zmin = MIN2(bin_zmin, zmin);
+   return true;
+}
+
+
+/**
+ * Bin the triangle into the tiles it touches.
+ *
+ * zmin and zmax bound the triangle's depth values, and are used to skip
+ * tiles in which the depth test can't pass: each bin keeps an upper bound
+ * of its stored depth, set by depth clears and lowered when a triangle
+ * writes depth over the whole tile.  As long as depth only gets written
+ * with a LESS/LEQUAL test (see zcull_clobber) stored values can only
+ * decrease, so a triangle entirely behind it can't pass either.
+ *
+ * Conversely each bin keeps a lower bound of its stored depth and of the
+ * depth of everything binned to it.  A triangle in front of that which
+ * covers the whole tile and overwrites color and depth everywhere hides
+ * all earlier commands, so the bin can be emptied before shading it.
+ */
 bool
 lp_setup_bin_triangle(struct lp_setup_context *setup,
                       struct lp_rast_triangle *tri,
@@ -783,11 +846,32 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                       bool opaque,
                       const struct u_rect *bbox,
                       int nr_planes,
-                      unsigned viewport_index)
+                      unsigned viewport_index,
+                      float zmin, float zmax)
 {
    struct lp_scene *scene = setup->scene;
+   const struct lp_fragment_shader_variant *variant =
+      setup->fs.current.variant;
+   const struct lp_setup_variant_key *setup_key = &setup->setup.variant->key;
    unsigned cmd;
 
+   /* Layered rendering shares bins between layers, and culling would
+    * change the results of fragment shader invocation queries.
+    */
+   const bool zcull = variant->zcull_test &&
+                      !scene->zcull_clobbered &&
+                      scene->fb_max_layer == 0 &&
+                      !setup->active_binned_queries &&
+                      setup_key->pgon_offset_units == 0.0f &&
+                      setup_key->pgon_offset_scale == 0.0f &&
+                      zmin < INFINITY;
+   const bool zwrite = zcull && variant->zcull_write && !setup->multisample;
+   /* Dropping hidden commands must not lose stencil values or queries. */
+   const bool zocclude = zwrite && variant->zcull_occlude &&
+                         !scene->had_queries &&
+                         !util_format_has_stencil(util_format_description(scene->fb.zsbuf.format));
+   const float cmd_zmin = zcull ? zmin : -INFINITY;
+
    /* What is the largest power-of-two boundary this triangle crosses:
     */
    const int dx = floor_pot((bbox->x0 ^ bbox->x1) |
@@ -827,6 +911,9 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
       assert(iy0 == bbox->y1 / TILE_SIZE &&
              ix0 == bbox->x1 / TILE_SIZE);
 
+      if (zcull && zcull_tile(scene, ix0, iy0, zmin))
+         return true;
+
       if (nr_planes == 3) {
          if (sz < 4) {
             /* Triangle is contained in a single 4x4 stamp:
@@ -837,9 +924,10 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                cmd = LP_RAST_OP_MS_TRIANGLE_3_4;
             else
                cmd = use_32bits ? LP_RAST_OP_TRIANGLE_32_3_4 : LP_RAST_OP_TRIANGLE_3_4;
-            return lp_scene_bin_cmd_with_state(scene, ix0, iy0,
-                                               setup->fs.stored, cmd,
-                                               lp_rast_arg_triangle_contained(tri, px, py));
+            return bin_triangle_cmd(scene, ix0, iy0,
+                                    setup->fs.stored, cmd,
+                                    lp_rast_arg_triangle_contained(tri, px, py),
+                                    cmd_zmin);
          }
 
          if (sz < 16) {
@@ -857,13 +945,22 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
             assert(px + 16 <= TILE_SIZE);
             assert(py + 16 <= TILE_SIZE);
 
+            /* Number of 4x4 columns/rows of the block the bbox touches,
+             * small triangles usually only cover a few of the 16.
+             */
+            const int nx = ((bbox->x1 - ix0 * TILE_SIZE - (int)px) >> 2) + 1;
+            const int ny = ((bbox->y1 - iy0 * TILE_SIZE - (int)py) >> 2) + 1;
+
             if (setup->multisample)
                cmd = LP_RAST_OP_MS_TRIANGLE_3_16;
             else
                cmd = use_32bits ? LP_RAST_OP_TRIANGLE_32_3_16 : LP_RAST_OP_TRIANGLE_3_16;
-            return lp_scene_bin_cmd_with_state(scene, ix0, iy0,
-                                               setup->fs.stored, cmd,
-                                               lp_rast_arg_triangle_contained(tri, px, py));
+            return bin_triangle_cmd(scene, ix0, iy0,
+                                    setup->fs.stored, cmd,
+                                    lp_rast_arg_triangle_contained_16(tri, px, py,
+                                                                      CLAMP(nx, 1, 4),
+                                                                      CLAMP(ny, 1, 4)),
+                                    cmd_zmin);
          }
       } else if (nr_planes == 4 && sz < 16) {
          px = MIN2(px, TILE_SIZE - 16);
@@ -876,9 +973,10 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
             cmd = LP_RAST_OP_MS_TRIANGLE_4_16;
          else
             cmd = use_32bits ? LP_RAST_OP_TRIANGLE_32_4_16 : LP_RAST_OP_TRIANGLE_4_16;
-         return lp_scene_bin_cmd_with_state(scene, ix0, iy0,
-                                            setup->fs.stored, cmd,
-                                            lp_rast_arg_triangle_contained(tri, px, py));
+         return bin_triangle_cmd(scene, ix0, iy0,
+                                 setup->fs.stored, cmd,
+                                 lp_rast_arg_triangle_contained(tri, px, py),
+                                 cmd_zmin);
       }
 
       /* Triangle is contained in a single tile:
@@ -887,10 +985,11 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
          cmd = lp_rast_ms_tri_tab[nr_planes];
       else
          cmd = use_32bits ? lp_rast_32_tri_tab[nr_planes] : lp_rast_tri_tab[nr_planes];
-      return lp_scene_bin_cmd_with_state(scene, ix0, iy0, setup->fs.stored,
-                                         cmd,
-                                         lp_rast_arg_triangle(tri,
-                                                              (1<<nr_planes)-1));
+      return bin_triangle_cmd(scene, ix0, iy0, setup->fs.stored,
+                              cmd,
+                              lp_rast_arg_triangle(tri,
+                                                   (1<<nr_planes)-1),
+                              cmd_zmin);
    } else {
       struct lp_rast_plane *plane = GET_PLANES(tri);
       int64_t c[MAX_PLANES];
@@ -948,6 +1047,9 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                if (in)
                   break;  /* exiting triangle, all done with this row */
                LP_COUNT(nr_empty_64);
+            } else if (zcull && zcull_tile(scene, x, y, zmin)) {
+               /* hidden behind what's already in the tile */
+               in = true;
             } else if (partial) {
                /* Not trivially accepted by at least one plane -
                 * rasterize/shade partial tile
@@ -959,9 +1061,10 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                   cmd = lp_rast_ms_tri_tab[count];
                else
                   cmd = use_32bits ? lp_rast_32_tri_tab[count] : lp_rast_tri_tab[count];
-               if (!lp_scene_bin_cmd_with_state(scene, x, y,
-                                                setup->fs.stored, cmd,
-                                                lp_rast_arg_triangle(tri, partial)))
+               if (!bin_triangle_cmd(scene, x, y,
+                                     setup->fs.stored, cmd,
+                                     lp_rast_arg_triangle(tri, partial),
+                                     cmd_zmin))
                   goto fail;
 
                LP_COUNT(nr_partially_covered_64);
@@ -969,8 +1072,23 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                /* triangle covers the whole tile- shade whole tile */
                LP_COUNT(nr_fully_covered_64);
                in = true;
+
+               struct cmd_bin *bin = lp_scene_get_bin(scene, x, y);
+               if (zocclude && zmax + LP_ZCULL_EPSILON < bin->zmin) {
+                  /* passes the depth test everywhere, hiding all that
+                   * was binned before
+                   */
+                  lp_scene_bin_reset(scene, x, y);
+                  LP_COUNT(nr_zoccluded_64);
+               }
+
+               const float bin_zmin = bin->zmin;
                if (!lp_setup_whole_tile(setup, &tri->inputs, x, y, opaque))
                   goto fail;
+               bin->zmin = MIN2(bin_zmin, cmd_zmin);
+
+               if (zwrite)
+                  bin->zmax = MIN2(bin->zmax, zmax);
             }
 
             /* Iterate cx values across the region: */
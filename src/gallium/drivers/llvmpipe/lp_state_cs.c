@@ -2118,6 +2118,46 @@ lp_mesh_call_draw(struct llvmpipe_context *lp,
    free(prim_out.primitive_lengths);
 }
 
+/*
+ * A batch of mesh shader workgroups, queued on the compute thread pool
+ * while the previous batch's primitives get drawn.
+ */
+struct lp_mesh_batch {
+   struct lp_cs_job_info job_info;
+   struct lp_cs_tpool_task *task;
+   void *vbuf;
+   unsigned num_tasks;
+};
+
+static void
+lp_mesh_batch_finish(struct llvmpipe_context *lp,
+                     struct lp_mesh_batch *batch,
+                     int prim_out_idx,
+                     int cull_prim_idx,
+                     size_t task_out_size,
+                     int vsize, int psize, int per_prim_count,
+                     size_t prim_offset)
+{
+   struct llvmpipe_screen *screen = llvmpipe_screen(lp->pipe.screen);
+   struct nir_shader *mhs_shader = lp->mhs->base.ir.nir;
+   const unsigned *block_size = batch->job_info.block_size;
+
+   if (batch->task)
+      lp_cs_tpool_wait_for_task(screen->cs_tpool, &batch->task);
+
+   if (!lp->queries_disabled)
+      lp->pipeline_statistics.ms_invocations += batch->num_tasks * block_size[0] * block_size[1] * block_size[2];
+
+   for (unsigned t = 0; t < batch->num_tasks; t++)
+      lp_mesh_call_draw(lp,
+                        mhs_shader->info.mesh.primitive_type,
+                        prim_out_idx, cull_prim_idx, t,
+                        batch->vbuf, task_out_size,
+                        vsize, psize, per_prim_count, prim_offset);
+   free(batch->vbuf);
+   batch->vbuf = NULL;
+}
+
 static void
 llvmpipe_draw_mesh_tasks(struct pipe_context *pipe,
                          const struct pipe_grid_info *info)
@@ -2179,6 +2219,13 @@ llvmpipe_draw_mesh_tasks(struct pipe_context *pipe,
    size_t prim_offset = vsize * (mhs_shader->info.mesh.max_vertices_out + 8);
    size_t task_out_size = prim_offset + psize * (mhs_shader->info.mesh.max_primitives_out + 8);
 
+   /* Mesh workgroups of the next batch run while the current one's
+    * primitives are drawn on this thread, in order.
+    */
+   struct lp_mesh_batch batches[2];
+   struct lp_mesh_batch *pending = NULL;
+   unsigned next_batch = 0;
+
    for (unsigned dr = 0; dr < draw_count; dr++) {
       fill_grid_size(pipe, dr, info, job_info.grid_size);
 
@@ -2268,33 +2315,47 @@ llvmpipe_draw_mesh_tasks(struct pipe_context *pipe,
                   job_info.iter_size[2] = this_z;
                   job_info.use_iters = true;
 
-                  void *vbuf = CALLOC(num_tasks, task_out_size);
-                  if (!vbuf)
+                  struct lp_mesh_batch *batch = &batches[next_batch];
+                  next_batch ^= 1;
+
+                  batch->vbuf = CALLOC(num_tasks, task_out_size);
+                  if (!batch->vbuf) {
+                     if (pending)
+                        lp_mesh_batch_finish(lp, pending, prim_out_idx - first_per_prim_idx,
+                                             cull_prim_idx, task_out_size,
+                                             vsize, psize, per_prim_count, prim_offset);
+                     free(payload);
                      return;
+                  }
 
-                  job_info.io = vbuf;
+                  /* The pool reads the job info while the workgroups run. */
+                  batch->job_info = job_info;
+                  batch->job_info.io = batch->vbuf;
+                  batch->num_tasks = num_tasks;
+                  batch->task = NULL;
                   if (num_tasks) {
-                     struct lp_cs_tpool_task *task;
                      mtx_lock(&screen->cs_mutex);
-                     task = lp_cs_tpool_queue_task(screen->cs_tpool, cs_exec_fn, &job_info, num_tasks);
+                     batch->task = lp_cs_tpool_queue_task(screen->cs_tpool, cs_exec_fn,
+                                                          &batch->job_info, num_tasks);
                      mtx_unlock(&screen->cs_mutex);
-
-                     lp_cs_tpool_wait_for_task(screen->cs_tpool, &task);
                   }
-                  if (!lp->queries_disabled)
-                     lp->pipeline_statistics.ms_invocations += num_tasks * job_info.block_size[0] * job_info.block_size[1] * job_info.block_size[2];
-
-                  for (unsigned t = 0; t < num_tasks; t++)
-                     lp_mesh_call_draw(lp,
-                                       mhs_shader->info.mesh.primitive_type,
-                                       prim_out_idx - first_per_prim_idx,
-                                       cull_prim_idx, t, vbuf, task_out_size,
-                                       vsize, psize, per_prim_count, prim_offset);
-                  free(vbuf);
+
+                  if (pending)
+                     lp_mesh_batch_finish(lp, pending, prim_out_idx - first_per_prim_idx,
+                                          cull_prim_idx, task_out_size,
+                                          vsize, psize, per_prim_count, prim_offset);
+                  pending = batch;
                }
             }
          }
       }
+
+      /* The batches still point into this draw's task payloads. */
+      if (pending)
+         lp_mesh_batch_finish(lp, pending, prim_out_idx - first_per_prim_idx,
+                              cull_prim_idx, task_out_size,
+                              vsize, psize, per_prim_count, prim_offset);
+      pending = NULL;
       free(payload);
    }
    draw_flush(lp->draw);
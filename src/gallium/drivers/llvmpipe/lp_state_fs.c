@@ -677,6 +677,7 @@ fs_fb_fetch(const struct lp_build_fs_iface *iface,
 static void
 generate_fs_loop(struct gallivm_state *gallivm,
                  struct lp_fragment_shader *shader,
+                 struct nir_shader *nir,
                  const struct lp_fragment_shader_variant_key *key,
                  LLVMBuilderRef builder,
                  struct lp_type type,
@@ -713,7 +714,6 @@ generate_fs_loop(struct gallivm_state *gallivm,
    LLVMValueRef min_depth_bounds = NULL, max_depth_bounds = NULL;
    struct lp_build_for_loop_state loop_state, sample_loop_state = {0};
    struct lp_build_mask_context mask;
-   struct nir_shader *nir = shader->base.ir.nir;
    const bool dual_source_blend = key->blend.rt[0].blend_enable &&
                                   util_blend_state_is_dual(&key->blend, 0);
    const bool post_depth_coverage = nir->info.fs.post_depth_coverage;
@@ -3161,15 +3161,14 @@ generate_unswizzled_blend(struct gallivm_state *gallivm,
  * 2x2 pixels.
  */
 static void
-generate_fragment(struct llvmpipe_context *lp,
-                  struct lp_fragment_shader *shader,
+generate_fragment(struct lp_fragment_shader *shader,
+                  struct nir_shader *nir,
                   struct lp_fragment_shader_variant *variant,
                   unsigned partial_mask)
 {
    assert(partial_mask == RAST_WHOLE ||
           partial_mask == RAST_EDGE_TEST);
 
-   struct nir_shader *nir = shader->base.ir.nir;
    struct gallivm_state *gallivm = variant->gallivm;
    struct lp_fragment_shader_variant_key *key = &variant->key;
    struct lp_shader_input inputs[PIPE_MAX_SHADER_INPUTS];
@@ -3510,7 +3509,7 @@ generate_fragment(struct llvmpipe_context *lp,
                                x, y);
 
       generate_fs_loop(gallivm,
-                       shader, key,
+                       shader, nir, key,
                        builder,
                        fs_type,
                        variant->jit_context_type,
@@ -3832,6 +3831,141 @@ lp_fs_get_ir_cache_key(struct lp_fragment_shader_variant *variant,
 }
 
 
+struct lp_fs_optimize_job {
+   struct llvmpipe_screen *screen;
+   struct lp_fragment_shader_variant *variant;
+   /* Private copy, as building the LLVM IR updates NIR metadata */
+   struct nir_shader *nir;
+   unsigned char ir_sha1_cache_key[20];
+};
+
+
+/**
+ * Tiered JIT: rebuild the LLVM fragment functions of a variant with full
+ * optimization and switch the variant over to them.  Runs on the screen's
+ * JIT queue.
+ */
+static void
+fs_variant_optimize_execute(void *data, void *gdata, int thread_index)
+{
+   struct lp_fs_optimize_job *job = data;
+   struct lp_fragment_shader_variant *variant = job->variant;
+   struct lp_fragment_shader *shader = variant->shader;
+
+   /* The LLVM types and values of a variant live in its gallivm's context,
+    * which belongs to the pipe context and can't be used from this thread.
+    * Build into a scratch variant with a context of its own instead.
+    */
+   struct lp_fragment_shader_variant *tmp =
+      MALLOC(sizeof *tmp + shader->variant_key_size - sizeof tmp->key);
+   if (!tmp)
+      return;
+
+   memset(tmp, 0, sizeof(*tmp));
+   tmp->opaque = variant->opaque;
+   tmp->potentially_opaque = variant->potentially_opaque;
+   tmp->blit = variant->blit;
+   tmp->shader = shader;
+   tmp->no = variant->no;
+   memcpy(&tmp->key, &variant->key, shader->variant_key_size);
+
+   lp_context_ref context;
+   lp_context_create(&context);
+   if (!context.ref) {
+      FREE(tmp);
+      return;
+   }
+
+   struct lp_cached_code cached = { 0 };
+   char module_name[64];
+   snprintf(module_name, sizeof(module_name), "fs%u_variant%u_opt",
+            shader->no, variant->no);
+   tmp->gallivm = gallivm_create(module_name, &context, &cached);
+   if (!tmp->gallivm) {
+      lp_context_destroy(&context);
+      FREE(tmp);
+      return;
+   }
+
+   lp_jit_init_types(tmp);
+
+   /* Only redo what the first compile did with LLVM, i.e. not fastpaths. */
+   if (variant->function[RAST_EDGE_TEST])
+      generate_fragment(shader, job->nir, tmp, RAST_EDGE_TEST);
+   if (variant->function[RAST_WHOLE])
+      generate_fragment(shader, job->nir, tmp, RAST_WHOLE);
+
+   gallivm_compile_module(tmp->gallivm);
+
+   lp_jit_frag_func jit_function[2] = { NULL, NULL };
+   for (unsigned i = 0; i < ARRAY_SIZE(jit_function); i++) {
+      if (tmp->function[i]) {
+         jit_function[i] = (lp_jit_frag_func)
+            gallivm_jit_function(tmp->gallivm, tmp->function[i],
+                                 tmp->function_name[i]);
+      }
+   }
+
+   /* Same functions under the same names as the unoptimized module, so
+    * later runs can load this straight from the cache.
+    */
+   lp_disk_cache_insert_shader(job->screen, &cached, job->ir_sha1_cache_key);
+
+   gallivm_free_ir(tmp->gallivm);
+   lp_context_destroy(&context);
+
+   variant->opt_gallivm = tmp->gallivm;
+
+   if (jit_function[RAST_EDGE_TEST]) {
+      /* RAST_WHOLE may just be the edge test function, see generate_variant */
+      if (!jit_function[RAST_WHOLE] &&
+          variant->jit_function[RAST_WHOLE] == variant->jit_function[RAST_EDGE_TEST])
+         jit_function[RAST_WHOLE] = jit_function[RAST_EDGE_TEST];
+      p_atomic_set(&variant->jit_function[RAST_EDGE_TEST],
+                   jit_function[RAST_EDGE_TEST]);
+   }
+   if (jit_function[RAST_WHOLE]) {
+      p_atomic_set(&variant->jit_function[RAST_WHOLE],
+                   jit_function[RAST_WHOLE]);
+   }
+
+   FREE(tmp->function_name[RAST_EDGE_TEST]);
+   FREE(tmp->function_name[RAST_WHOLE]);
+   FREE(tmp);
+}
+
+
+static void
+fs_variant_optimize_cleanup(void *data, void *gdata, int thread_index)
+{
+   struct lp_fs_optimize_job *job = data;
+
+   ralloc_free(job->nir);
+   FREE(job);
+}
+
+
+static void
+fs_variant_queue_optimize(struct llvmpipe_screen *screen,
+                          struct lp_fragment_shader_variant *variant,
+                          const unsigned char ir_sha1_cache_key[20])
+{
+   struct lp_fs_optimize_job *job = CALLOC_STRUCT(lp_fs_optimize_job);
+   if (!job)
+      return;
+
+   job->screen = screen;
+   job->variant = variant;
+   job->nir = nir_shader_clone(NULL, variant->shader->base.ir.nir);
+   memcpy(job->ir_sha1_cache_key, ir_sha1_cache_key,
+          sizeof(job->ir_sha1_cache_key));
+
+   util_queue_add_job(&screen->jit_queue, job, &variant->opt_fence,
+                      fs_variant_optimize_execute,
+                      fs_variant_optimize_cleanup, 0);
+}
+
+
 /**
  * Generate a new fragment shader variant from the shader code and
  * other state indicated by the key.
@@ -3850,6 +3984,7 @@ generate_variant(struct llvmpipe_context *lp,
    memset(variant, 0, sizeof(*variant));
 
    pipe_reference_init(&variant->reference, 1);
+   util_queue_fence_init(&variant->opt_fence);
    lp_fs_reference(lp, &variant->shader, shader);
 
    memcpy(&variant->key, key, shader->variant_key_size);
@@ -3911,6 +4046,47 @@ generate_variant(struct llvmpipe_context *lp,
          !key->blend.rt[0].blend_enable
          ? true : false;
 
+   /* Fragments of a primitive can only pass a LESS/LEQUAL test if its
+    * interpolated z is in front of what's in the depth buffer, and writing
+    * them can then only bring the stored depth closer.  Anything else
+    * skipping the test (stencil ops, side effects) rules out culling.
+    */
+   const bool depth_less =
+         key->depth.enabled &&
+         (key->depth.func == PIPE_FUNC_LESS ||
+          key->depth.func == PIPE_FUNC_LEQUAL);
+
+   variant->zcull_test =
+         depth_less &&
+         !key->stencil[0].enabled &&
+         !key->depth_clamp &&
+         !(nir->info.outputs_written & BITFIELD64_BIT(FRAG_RESULT_DEPTH)) &&
+         !nir->info.writes_memory;
+
+   variant->zcull_write =
+         variant->zcull_test &&
+         key->depth.writemask &&
+         !key->alpha.enabled &&
+         !key->multisample &&
+         !key->blend.alpha_to_coverage &&
+         !key->depth.depth_bounds_test &&
+         !nir->info.fs.uses_discard &&
+         !(nir->info.outputs_written & BITFIELD64_BIT(FRAG_RESULT_SAMPLE_MASK));
+
+   variant->zcull_occlude =
+         variant->zcull_write &&
+         fullcolormask &&
+         !key->blend.logicop_enable &&
+         !key->blend.rt[0].blend_enable &&
+         !nir->info.fs.uses_fbfetch_output;
+
+   variant->zcull_clobber =
+         key->depth.enabled &&
+         key->depth.writemask &&
+         !depth_less &&
+         key->depth.func != PIPE_FUNC_EQUAL &&
+         key->depth.func != PIPE_FUNC_NEVER;
+
    variant->potentially_opaque =
          no_kill &&
          !key->blend.logicop_enable &&
@@ -3990,12 +4166,12 @@ generate_variant(struct llvmpipe_context *lp,
    lp_jit_init_types(variant);
 
    if (variant->jit_function[RAST_EDGE_TEST] == NULL)
-      generate_fragment(lp, shader, variant, RAST_EDGE_TEST);
+      generate_fragment(shader, nir, variant, RAST_EDGE_TEST);
 
    if (variant->jit_function[RAST_WHOLE] == NULL) {
       if (variant->opaque) {
          /* Specialized shader, which doesn't need to read the color buffer. */
-         generate_fragment(lp, shader, variant, RAST_WHOLE);
+         generate_fragment(shader, nir, variant, RAST_WHOLE);
       }
    }
 
@@ -4029,6 +4205,20 @@ generate_variant(struct llvmpipe_context *lp,
       }
    }
 
+   /*
+    * With tiered JIT, a variant that isn't in the disk cache gets compiled
+    * quickly without optimizations first, and recompiled properly in the
+    * background.  The linear path is left alone, as only jit_function[]
+    * gets switched over.
+    */
+   const bool tiered = (LP_PERF & PERF_TIERED_JIT) &&
+      needs_caching && !linear_pipeline &&
+      !(gallivm_debug & GALLIVM_DEBUG_SYMBOLS) &&
+      (variant->function[RAST_EDGE_TEST] || variant->function[RAST_WHOLE]);
+
+   if (tiered)
+      gallivm_set_fast_compile(variant->gallivm);
+
    /*
     * Compile everything
     */
@@ -4075,12 +4265,15 @@ generate_variant(struct llvmpipe_context *lp,
       lp_linear_check_variant(variant);
    }
 
-   if (needs_caching) {
+   if (needs_caching && !tiered) {
       lp_disk_cache_insert_shader(screen, &cached, ir_sha1_cache_key);
    }
 
    gallivm_free_ir(variant->gallivm);
 
+   if (tiered)
+      fs_variant_queue_optimize(screen, variant, ir_sha1_cache_key);
+
    return variant;
 }
 
@@ -4239,6 +4432,10 @@ void
 llvmpipe_destroy_shader_variant(struct llvmpipe_context *lp,
                                 struct lp_fragment_shader_variant *variant)
 {
+   util_queue_fence_wait(&variant->opt_fence);
+   util_queue_fence_destroy(&variant->opt_fence);
+   if (variant->opt_gallivm)
+      gallivm_destroy(variant->opt_gallivm);
    gallivm_destroy(variant->gallivm);
    lp_fs_reference(lp, &variant->shader, NULL);
    FREE(variant->function_name[RAST_EDGE_TEST]);
@@ -38,6 +38,7 @@
 #include "gallivm/lp_bld_tgsi.h" /* for lp_tgsi_info */
 #include "lp_bld_interp.h" /* for struct lp_shader_input */
 #include "util/u_inlines.h"
+#include "util/u_queue.h"
 #include "lp_jit.h"
 
 struct lp_fragment_shader;
@@ -154,10 +155,29 @@ struct lp_fragment_shader_variant
    unsigned opaque:1;
    unsigned blit:1;
    unsigned linear_input_mask:16;
+
+   /*
+    * Depth behaviour the binner's per-tile depth culling relies on, see
+    * lp_setup_bin_triangle().
+    */
+   unsigned zcull_test:1;    /**< fragments only pass if in front of the stored z */
+   unsigned zcull_write:1;   /**< all covered fragments that pass write their z */
+   unsigned zcull_clobber:1; /**< depth writes may move the stored z further away */
+   unsigned zcull_occlude:1; /**< zcull_write, and overwrites the whole color */
    struct pipe_reference reference;
 
    struct gallivm_state *gallivm;
 
+   /*
+    * With LP_PERF=tiered_jit, gallivm above only holds a quick unoptimized
+    * compile, and an optimized one is built into opt_gallivm on the screen's
+    * JIT queue, after which jit_function[] gets switched over.  Scenes may
+    * still be running the old code, so both stay around until the variant
+    * is destroyed.
+    */
+   struct gallivm_state *opt_gallivm;
+   struct util_queue_fence opt_fence;
+
    LLVMTypeRef jit_context_type;
    LLVMTypeRef jit_context_ptr_type;
    LLVMTypeRef jit_thread_data_type;
@@ -83,6 +83,113 @@ lp_resource_copy_ms(struct pipe_context *pipe,
 }
 
 
+/**
+ * Resolve a multisampled 8-bit unorm color buffer on the CPU.
+ *
+ * Each pixel whose samples are all equal (the common case away from
+ * primitive edges) is copied from sample 0 without touching the
+ * arithmetic, the rest are averaged with rounding.  This avoids running
+ * a resolve fragment shader through the blitter for the plain
+ * same-format, unscaled resolves issued at the end of a frame.
+ */
+static bool
+lp_blit_resolve_fast(struct pipe_context *pipe,
+                     const struct pipe_blit_info *info)
+{
+   struct pipe_resource *src = info->src.resource;
+   struct pipe_resource *dst = info->dst.resource;
+   const struct util_format_description *desc =
+      util_format_description(info->src.format);
+   const unsigned nr_samples = src->nr_samples;
+
+   if (src->nr_samples < 2 || dst->nr_samples > 1 ||
+       src->target != PIPE_TEXTURE_2D ||
+       info->src.format != info->dst.format ||
+       src->format != info->src.format ||
+       dst->format != info->dst.format ||
+       info->mask != PIPE_MASK_RGBA ||
+       info->scissor_enable ||
+       info->num_window_rectangles ||
+       info->alpha_blend ||
+       info->swizzle_enable ||
+       info->src.box.width != info->dst.box.width ||
+       info->src.box.height != info->dst.box.height ||
+       info->src.box.depth != 1 || info->dst.box.depth != 1 ||
+       info->src.box.width <= 0 || info->src.box.height <= 0)
+      return false;
+
+   if (desc->layout != UTIL_FORMAT_LAYOUT_PLAIN ||
+       desc->colorspace != UTIL_FORMAT_COLORSPACE_RGB ||
+       desc->block.bits != 32 || desc->nr_channels != 4 ||
+       !util_format_is_unorm(info->src.format))
+      return false;
+   for (unsigned c = 0; c < 4; c++) {
+      if (desc->channel[c].size != 8)
+         return false;
+   }
+
+   struct pipe_transfer *src_trans[LP_MAX_SAMPLES] = { NULL };
+   const uint8_t *src_map[LP_MAX_SAMPLES];
+   struct pipe_transfer *dst_trans;
+   bool ret = false;
+
+   uint8_t *dst_map = pipe->texture_map(pipe, dst, info->dst.level,
+                                        PIPE_MAP_WRITE, &info->dst.box,
+                                        &dst_trans);
+   if (!dst_map)
+      return false;
+
+   unsigned s;
+   for (s = 0; s < nr_samples; s++) {
+      src_map[s] = llvmpipe_transfer_map_ms(pipe, src, info->src.level,
+                                            PIPE_MAP_READ, s,
+                                            &info->src.box, &src_trans[s]);
+      if (!src_map[s])
+         goto out;
+   }
+
+   for (int y = 0; y < info->src.box.height; y++) {
+      uint32_t *dst_row = (uint32_t *)(dst_map + y * dst_trans->stride);
+      const uint32_t *src_row[LP_MAX_SAMPLES];
+      for (s = 0; s < nr_samples; s++)
+         src_row[s] = (const uint32_t *)(src_map[s] + y * src_trans[s]->stride);
+
+      for (int x = 0; x < info->src.box.width; x++) {
+         const uint32_t s0 = src_row[0][x];
+         bool uniform = true;
+         for (s = 1; s < nr_samples; s++)
+            uniform &= src_row[s][x] == s0;
+
+         if (uniform) {
+            dst_row[x] = s0;
+            continue;
+         }
+
+         uint32_t sum[4] = { 0 };
+         for (s = 0; s < nr_samples; s++) {
+            const uint32_t v = src_row[s][x];
+            for (unsigned c = 0; c < 4; c++)
+               sum[c] += (v >> (c * 8)) & 0xff;
+         }
+
+         uint32_t res = 0;
+         for (unsigned c = 0; c < 4; c++)
+            res |= ((sum[c] + nr_samples / 2) / nr_samples) << (c * 8);
+         dst_row[x] = res;
+      }
+   }
+   ret = true;
+
+out:
+   for (s = 0; s < nr_samples; s++) {
+      if (src_trans[s])
+         pipe->texture_unmap(pipe, src_trans[s]);
+   }
+   pipe->texture_unmap(pipe, dst_trans);
+   return ret;
+}
+
+
 static void
 lp_resource_copy(struct pipe_context *pipe,
                  struct pipe_resource *dst, unsigned dst_level,
@@ -145,6 +252,9 @@ lp_blit(struct pipe_context *pipe,
       return;
    }
 
+   if (lp_blit_resolve_fast(pipe, &info))
+      return;
+
    if (!util_blitter_is_blit_supported(lp->blitter, &info)) {
       debug_printf("llvmpipe: blit unsupported %s -> %s\n",
                    util_format_short_name(info.src.resource->format),
@@ -190,6 +190,16 @@ llvmpipe_texture_layout(struct llvmpipe_screen *screen,
          lpr->row_stride[level] = align(nblocksx * block_size,
                                         util_get_cpu_caps()->cacheline);
 
+      /* With a row stride that is a multiple of 4KiB all texels of a column
+       * map to the same L1 cache set, so the rows touched by the texels of a
+       * minified or rotated sampling footprint keep evicting each other.
+       * Pad such rows by a cache line to spread them over the sets.
+       */
+      if (!util_format_is_compressed(pt->format) &&
+          !(pt->flags & PIPE_RESOURCE_FLAG_SPARSE) &&
+          nblocksy > 1 && lpr->row_stride[level] % 4096 == 0)
+         lpr->row_stride[level] += util_get_cpu_caps()->cacheline;
+
       lpr->img_stride[level] = (uint64_t)lpr->row_stride[level] * nblocksy;
 
       /* Number of 3D image slices, cube faces or texture array layers */
@@ -22,6 +22,7 @@
  */
 
 #include "lp_context.h"
+#include "lp_debug.h"
 #include "lp_texture_handle.h"
 #include "lp_screen.h"
 
@@ -254,6 +255,10 @@ llvmpipe_sampler_matrix_destroy(struct llvmpipe_context *ctx)
 {
    struct lp_sampler_matrix *matrix = &ctx->sampler_matrix;
 
+   LP_DBG(DEBUG_TEX, "texture functions: %u built, %u from cache, %u on demand\n",
+          matrix->stats.functions, matrix->stats.cache_hits,
+          matrix->stats.on_demand);
+
    simple_mtx_destroy(&matrix->lock);
 
    for (uint32_t i = 0; i < ARRAY_SIZE(matrix->caches); i++) {
@@ -317,6 +322,10 @@ compile_function(struct llvmpipe_context *ctx, struct gallivm_state *gallivm, LL
 
    void *function_ptr = func_to_pointer(gallivm_jit_function(gallivm, function, func_name));
 
+   ctx->sampler_matrix.stats.functions++;
+   if (!needs_caching)
+      ctx->sampler_matrix.stats.cache_hits++;
+
    if (needs_caching)
       lp_disk_cache_insert_shader(llvmpipe_screen(ctx->pipe.screen), gallivm->cache, cache_key);
 
@@ -745,6 +754,7 @@ get_sample_function(uint64_t _matrix, uint64_t _texture_functions, uint64_t _sam
       result = entry ? entry->data : NULL;
       if (!result) {
          result = compile_sample_function(matrix->ctx, &texture_functions->state, matrix->samplers + sampler_index, sample_key);
+         matrix->stats.on_demand++;
          struct sample_function_cache_key *allocated_key = malloc(sizeof(struct sample_function_cache_key));
          *allocated_key = key;
          /* RCU style update: swap in an updated copy of the cache.
@@ -787,6 +797,7 @@ get_fetch_function(uint64_t _matrix, uint64_t _texture_functions, uint32_t sampl
       if (!result) {
          struct lp_static_sampler_state dummy_sampler = { 0 };
          result = compile_sample_function(matrix->ctx, &texture_functions->state, &dummy_sampler, sample_key);
+         matrix->stats.on_demand++;
          struct sample_function_cache_key *allocated_key = malloc(sizeof(struct sample_function_cache_key));
          *allocated_key = key;
          /* RCU style update: swap in an updated copy of the cache.
@@ -828,6 +839,7 @@ get_size_function(uint64_t _matrix, uint64_t _texture_functions, uint32_t sample
       result = entry ? entry->data : NULL;
       if (!result) {
          result = compile_size_function(matrix->ctx, &texture_functions->state, samples);
+         matrix->stats.on_demand++;
          struct size_function_cache_key *allocated_key = malloc(sizeof(struct size_function_cache_key));
          *allocated_key = key;
          /* RCU style update: swap in an updated copy of the cache.
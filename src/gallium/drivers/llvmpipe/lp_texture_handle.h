@@ -71,6 +71,13 @@ struct lp_sampler_matrix {
    lp_context_ref context;
 
    struct util_dynarray gallivms;
+
+   /* Function compilation statistics, printed with LP_DEBUG=tex. */
+   struct {
+      uint32_t functions;    /* functions built */
+      uint32_t cache_hits;   /* ... whose code came from the shader cache */
+      uint32_t on_demand;    /* ... that were compiled from within a shader */
+   } stats;
 };
 
 void llvmpipe_init_sampler_matrix(struct llvmpipe_context *ctx);
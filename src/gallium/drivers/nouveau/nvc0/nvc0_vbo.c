@@ -1067,9 +1067,6 @@ nvc0_draw_vbo(struct pipe_context *pipe, const struct pipe_draw_info *info,
 
    unsigned drawid = drawid_offset;
 
-   /* dont wanna start trippin */
-   simple_mtx_lock(&nvc0->screen->state_lock);
-
    /* NOTE: caller must ensure that (min_index + index_bias) is >= 0 */
    if (info->index_bounds_valid) {
       nvc0->vb_elt_first = info->min_index + (info->index_size ? draws->index_bias : 0);
@@ -1093,6 +1090,25 @@ nvc0_draw_vbo(struct pipe_context *pipe, const struct pipe_draw_info *info,
       (!indirect || indirect->count_from_stream_output) && info->index_size &&
       (nvc0->vb_elt_limit >= (count_total * 2));
 
+   list_for_each_entry(struct nvc0_resident, resident, &nvc0->tex_head, list) {
+      nvc0_add_resident(nvc0->bufctx_3d, NVC0_BIND_3D_BINDLESS, resident->buf,
+                        resident->flags);
+   }
+
+   list_for_each_entry(struct nvc0_resident, resident, &nvc0->img_head, list) {
+      nvc0_add_resident(nvc0->bufctx_3d, NVC0_BIND_3D_BINDLESS, resident->buf,
+                        resident->flags);
+   }
+
+   BCTX_REFN_bo(nvc0->bufctx_3d, 3D_TEXT, vram_domain | NOUVEAU_BO_RD,
+                screen->text);
+
+   /* Everything above only touches this context, the bufctx included. The
+    * rest may switch the hardware state over from another context and emits
+    * into the channel shared by all contexts of the screen.
+    */
+   simple_mtx_lock(&nvc0->screen->state_lock);
+
    if (nvc0->dirty_3d & (NVC0_NEW_3D_ARRAYS | NVC0_NEW_3D_VERTEX))
       nvc0->constant_vbos = nvc0->vertex->constant_vbos & nvc0->vbo_user;
    /* Check whether we want to switch vertex-submission mode. */
@@ -1144,19 +1160,6 @@ nvc0_draw_vbo(struct pipe_context *pipe, const struct pipe_draw_info *info,
       BCTX_REFN(nvc0->bufctx_3d, 3D_IDX, buf, RD);
    }
 
-   list_for_each_entry(struct nvc0_resident, resident, &nvc0->tex_head, list) {
-      nvc0_add_resident(nvc0->bufctx_3d, NVC0_BIND_3D_BINDLESS, resident->buf,
-                        resident->flags);
-   }
-
-   list_for_each_entry(struct nvc0_resident, resident, &nvc0->img_head, list) {
-      nvc0_add_resident(nvc0->bufctx_3d, NVC0_BIND_3D_BINDLESS, resident->buf,
-                        resident->flags);
-   }
-
-   BCTX_REFN_bo(nvc0->bufctx_3d, 3D_TEXT, vram_domain | NOUVEAU_BO_RD,
-                screen->text);
-
    nvc0_state_validate_3d(nvc0, ~0);
 
    for (unsigned i = 0; i < num_draws; i++) {
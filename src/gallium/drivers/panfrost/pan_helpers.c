@@ -254,6 +254,11 @@ panfrost_track_image_access(struct panfrost_batch *batch,
       unsigned level = is_buffer ? 0 : image->u.tex.level;
       BITSET_SET(rsrc->valid.data, level);
 
+      /* Shader stores bypass the tile writeback, so the CRC of the render
+       * target no longer matches its contents.
+       */
+      rsrc->valid.crc = false;
+
       if (is_buffer) {
          util_range_add(&rsrc->base, &rsrc->valid_buffer_range, 0,
                         rsrc->base.width0);
@@ -1581,8 +1581,13 @@ panfrost_ptr_map(struct pipe_context *pctx, struct pipe_resource *resource,
    pipe_resource_reference(&transfer->base.resource, resource);
    *out_transfer = &transfer->base;
 
-   if (usage & PIPE_MAP_WRITE)
+   /* The CRC no longer matches the memory as soon as the CPU writes to it,
+    * which for persistent mappings can happen before the unmap.
+    */
+   if (usage & PIPE_MAP_WRITE) {
       rsrc->constant_stencil = false;
+      rsrc->valid.crc = false;
+   }
 
    /* We don't have s/w routines for AFBC/AFRC, so use a staging texture */
    if (drm_is_afbc(rsrc->modifier) ||
@@ -1899,6 +1904,11 @@ pan_resource_modifier_convert(struct panfrost_context *ctx,
        * be able to convert back to another modifier if needed */
       rsrc->modifier_constant = false;
 
+      /* The BO now holds the CRC written by the conversion blit, if any, and
+       * the layout matches the one of tmp_rsrc.
+       */
+      rsrc->valid.crc = rsrc->image.props.crc && tmp_rsrc->valid.crc;
+
       struct pipe_resource *tmp_prsrc = &tmp_rsrc->base;
 
       pipe_resource_reference(&tmp_prsrc, NULL);
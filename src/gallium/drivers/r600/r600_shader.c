@@ -127,6 +127,142 @@ static int store_shader(struct pipe_context *ctx,
 	return 0;
 }
 
+/* Cache of final shader variants in the disk cache.
+ *
+ * GS variants are not cached because of their copy shader, and neither
+ * are export shaders, because their outputs depend on the bound GS.
+ */
+static bool r600_shader_cache_key(struct r600_context *rctx,
+				  struct r600_pipe_shader *shader,
+				  const union r600_shader_key *key,
+				  unsigned processor, cache_key hash)
+{
+	struct r600_pipe_shader_selector *sel = shader->selector;
+	struct disk_cache *cache = rctx->screen->b.disk_shader_cache;
+
+	if (!cache || !sel->nir_blob ||
+	    processor == MESA_SHADER_GEOMETRY ||
+	    (processor == MESA_SHADER_VERTEX && key->vs.as_es) ||
+	    (processor == MESA_SHADER_TESS_EVAL && key->tes.as_es))
+		return false;
+
+	struct blob blob;
+	blob_init(&blob);
+	blob_write_bytes(&blob, sel->nir_blob, sel->nir_blob_size);
+	blob_write_bytes(&blob, key, sizeof(*key));
+	blob_write_bytes(&blob, &sel->so, sizeof(sel->so));
+	blob_write_uint32(&blob, rctx->screen->has_compressed_msaa_texturing);
+	blob_write_uint64(&blob, rctx->screen->b.debug_flags);
+
+	bool ok = !blob.out_of_memory;
+	if (ok)
+		disk_cache_compute_key(cache, blob.data, blob.size, hash);
+	blob_finish(&blob);
+	return ok;
+}
+
+static void r600_shader_cache_store(struct r600_context *rctx,
+				    struct r600_pipe_shader *shader,
+				    const cache_key hash,
+				    unsigned atomic_file_count)
+{
+	struct r600_pipe_shader_selector *sel = shader->selector;
+	struct r600_shader info = shader->shader;
+	struct blob blob;
+
+	/* The pointers are restored when loading. */
+	memset(&info.bc, 0, sizeof(info.bc));
+	info.arrays = NULL;
+
+	blob_init(&blob);
+	blob_write_bytes(&blob, &info, sizeof(info));
+	blob_write_uint32(&blob, shader->shader.bc.ndw);
+	blob_write_uint32(&blob, shader->shader.bc.ncf);
+	blob_write_uint32(&blob, shader->shader.bc.nalu_groups);
+	blob_write_uint32(&blob, shader->shader.bc.ngpr);
+	blob_write_uint32(&blob, shader->shader.bc.nstack);
+	blob_write_uint32(&blob, shader->shader.bc.nlds_dw);
+	blob_write_uint32(&blob, shader->shader.bc.nresource);
+	blob_write_bytes(&blob, shader->shader.bc.bytecode,
+			 shader->shader.bc.ndw * sizeof(uint32_t));
+	if (shader->shader.num_arrays)
+		blob_write_bytes(&blob, shader->shader.arrays,
+				 shader->shader.num_arrays * sizeof(*shader->shader.arrays));
+	blob_write_uint32(&blob, shader->scratch_space_needed);
+	blob_write_uint32(&blob, shader->enabled_stream_buffers_mask);
+	blob_write_uint32(&blob, atomic_file_count);
+	blob_write_uint8(&blob, sel->info.writes_memory);
+
+	if (!blob.out_of_memory)
+		disk_cache_put(rctx->screen->b.disk_shader_cache, hash,
+			       blob.data, blob.size, NULL);
+	blob_finish(&blob);
+}
+
+static bool r600_shader_cache_load(struct r600_context *rctx,
+				   struct r600_pipe_shader *shader,
+				   const cache_key hash)
+{
+	struct r600_screen *rscreen = rctx->screen;
+	struct r600_pipe_shader_selector *sel = shader->selector;
+	struct r600_shader *rshader = &shader->shader;
+	struct blob_reader blob;
+	size_t size;
+
+	void *data = disk_cache_get(rscreen->b.disk_shader_cache, hash, &size);
+	if (!data)
+		return false;
+
+	blob_reader_init(&blob, data, size);
+	blob_copy_bytes(&blob, rshader, sizeof(*rshader));
+
+	r600_bytecode_init(&rshader->bc, rscreen->b.gfx_level, rscreen->b.family,
+			   rscreen->has_compressed_msaa_texturing);
+	rshader->bc.type = rshader->processor_type;
+	rshader->bc.isa = rctx->isa;
+	rshader->bc.ndw = blob_read_uint32(&blob);
+	rshader->bc.ncf = blob_read_uint32(&blob);
+	rshader->bc.nalu_groups = blob_read_uint32(&blob);
+	rshader->bc.ngpr = blob_read_uint32(&blob);
+	rshader->bc.nstack = blob_read_uint32(&blob);
+	rshader->bc.nlds_dw = blob_read_uint32(&blob);
+	rshader->bc.nresource = blob_read_uint32(&blob);
+
+	size_t bytecode_size = rshader->bc.ndw * sizeof(uint32_t);
+	rshader->bc.bytecode = malloc(bytecode_size);
+	if (rshader->bc.bytecode)
+		blob_copy_bytes(&blob, rshader->bc.bytecode, bytecode_size);
+
+	if (rshader->num_arrays) {
+		size_t arrays_size = rshader->num_arrays * sizeof(*rshader->arrays);
+		rshader->arrays = malloc(arrays_size);
+		if (rshader->arrays)
+			blob_copy_bytes(&blob, rshader->arrays, arrays_size);
+	}
+
+	shader->scratch_space_needed = blob_read_uint32(&blob);
+	shader->enabled_stream_buffers_mask = blob_read_uint32(&blob);
+	unsigned atomic_file_count = blob_read_uint32(&blob);
+	bool writes_memory = blob_read_uint8(&blob);
+
+	bool ok = !blob.overrun && blob.current == blob.end &&
+		  rshader->bc.bytecode &&
+		  (!rshader->num_arrays || rshader->arrays);
+	free(data);
+
+	if (!ok) {
+		free(rshader->bc.bytecode);
+		free(rshader->arrays);
+		memset(rshader, 0, sizeof(*rshader));
+		return false;
+	}
+
+	/* Side effects of the compilation on the selector. */
+	sel->info.file_count[TGSI_FILE_HW_ATOMIC] += atomic_file_count;
+	sel->info.writes_memory = writes_memory;
+	return true;
+}
+
 extern const struct nir_shader_compiler_options r600_nir_options;
 static int nshader = 0;
 int r600_pipe_shader_create(struct pipe_context *ctx,
@@ -145,6 +281,17 @@ int r600_pipe_shader_create(struct pipe_context *ctx,
 		sel->nir = nir_deserialize(NULL, nir_options, &blob_reader);
 	}
 
+	/* The blob also keys the shader cache. */
+	if (!sel->nir_blob && sel->nir && sel->ir_type != PIPE_SHADER_IR_TGSI) {
+		struct blob blob;
+		blob_init(&blob);
+		nir_serialize(&blob, sel->nir, false);
+		sel->nir_blob = malloc(blob.size);
+		memcpy(sel->nir_blob, blob.data, blob.size);
+		sel->nir_blob_size = blob.size;
+		blob_finish(&blob);
+	}
+
 	int processor = sel->ir_type == PIPE_SHADER_IR_TGSI ?
 		tgsi_get_processor_type(sel->tokens):
 		sel->nir->info.stage;
@@ -152,6 +299,12 @@ int r600_pipe_shader_create(struct pipe_context *ctx,
 	bool dump = r600_can_dump_shader(&rctx->screen->b, processor);
 
 	unsigned export_shader;
+
+	cache_key hash;
+	bool use_cache = !dump &&
+		r600_shader_cache_key(rctx, shader, &key, processor, hash);
+	bool cached = false;
+	unsigned atomic_file_count = 0;
 	
 	shader->shader.bc.isa = rctx->isa;
 	
@@ -173,7 +326,15 @@ int r600_pipe_shader_create(struct pipe_context *ctx,
 		}
 		nir_tgsi_scan_shader(sel->nir, &sel->info, true);
 
-		r = r600_shader_from_nir(rctx, shader, &key);
+		if (use_cache && r600_shader_cache_load(rctx, shader, hash)) {
+			cached = true;
+			r = 0;
+		} else {
+			atomic_file_count = sel->info.file_count[TGSI_FILE_HW_ATOMIC];
+			r = r600_shader_from_nir(rctx, shader, &key);
+			atomic_file_count = sel->info.file_count[TGSI_FILE_HW_ATOMIC] -
+					    atomic_file_count;
+		}
 
 		glsl_type_singleton_decref();
 
@@ -201,6 +362,9 @@ int r600_pipe_shader_create(struct pipe_context *ctx,
 		}
 	}
 
+	if (use_cache && !cached)
+		r600_shader_cache_store(rctx, shader, hash, atomic_file_count);
+
 	if (dump) {
 		fprintf(stderr, "--------------------------------------------------------------\n");
 		r600_bytecode_disasm(&shader->shader.bc);
@@ -286,15 +450,6 @@ int r600_pipe_shader_create(struct pipe_context *ctx,
 				   shader->shader.bc.nstack);
 	}
 
-	if (!sel->nir_blob && sel->nir && sel->ir_type != PIPE_SHADER_IR_TGSI) {
-		struct blob blob;
-		blob_init(&blob);
-		nir_serialize(&blob, sel->nir, false);
-		sel->nir_blob = malloc(blob.size);
-		memcpy(sel->nir_blob, blob.data, blob.size);
-		sel->nir_blob_size = blob.size;
-		blob_finish(&blob);
-	}
 	ralloc_free(sel->nir);
 	sel->nir = NULL;
 
@@ -2408,6 +2408,8 @@ static void radeon_dec_destroy(struct pipe_video_codec *decoder)
    si_resource_reference(&dec->sessionctx, NULL);
    si_resource_reference(&dec->subsample, NULL);
 
+   p_atomic_dec(&((struct si_screen *)dec->screen)->num_video_decoders);
+
    FREE(dec->jcs);
    FREE(dec->jctx);
    FREE(dec);
@@ -3152,6 +3154,8 @@ struct pipe_video_codec *radeon_create_decoder(struct pipe_context *context,
 
    dec->tmz_ctx = sctx->vcn_ip_ver < VCN_2_2_0 && sctx->vcn_ip_ver != VCN_UNKNOWN;
 
+   p_atomic_inc(&sctx->screen->num_video_decoders);
+
    return &dec->base;
 
 error:
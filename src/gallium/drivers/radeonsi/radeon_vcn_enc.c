@@ -1989,6 +1989,8 @@ static void radeon_enc_destroy(struct pipe_video_codec *encoder)
    if (enc->ectx)
       enc->ectx->destroy(enc->ectx);
 
+   p_atomic_dec(&((struct si_screen *)enc->screen)->num_video_encoders);
+
    FREE(enc);
 }
 
@@ -2242,6 +2244,8 @@ struct pipe_video_codec *radeon_create_encoder(struct pipe_context *context,
 
    enc->first_frame = true;
 
+   p_atomic_inc(&sscreen->num_video_encoders);
+
    return &enc->base;
 
 error:
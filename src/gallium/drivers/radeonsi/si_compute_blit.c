@@ -167,6 +167,8 @@ bool si_compute_clear_copy_buffer(struct si_context *sctx, struct pipe_resource
       .info = &sctx->screen->info,
       .print_key = si_can_dump_shader(sctx->screen, MESA_SHADER_COMPUTE, SI_DUMP_SHADER_KEY),
       .fail_if_slow = fail_if_slow,
+      .cp_dma_max_copy_size = sctx->screen->cp_dma_tuning.copy_max_size,
+      .cp_dma_max_clear_size = sctx->screen->cp_dma_tuning.clear_max_size,
    };
 
    struct ac_cs_clear_copy_buffer_info info = {
@@ -151,6 +151,7 @@ static const struct debug_named_value test_options[] = {
    {"dmaperf", DBG(TEST_DMA_PERF), "Test DMA performance"},
    {"testmemperf", DBG(TEST_MEM_PERF), "Test map + memcpy perf using the winsys."},
    {"blitperf", DBG(TEST_BLIT_PERF), "Test gfx and compute clear/copy/blit/resolve performance"},
+   {"tunedma", DBG(TUNE_DMA), "Measure when CP DMA is faster than compute for buffer clears and copies, and store it in the shader cache."},
 
    DEBUG_NAMED_VALUE_END /* must be last */
 };
@@ -1455,6 +1456,7 @@ static struct pipe_screen *radeonsi_screen_create_impl(struct radeon_winsys *ws,
       sscreen->options.vrs2x2 = false;
 
    si_disk_cache_create(sscreen);
+   si_load_dma_tuning(sscreen);
 
    /* Determine the number of shader compiler threads. */
    const struct util_cpu_caps_t *caps = util_get_cpu_caps();
@@ -1670,6 +1672,9 @@ static struct pipe_screen *radeonsi_screen_create_impl(struct radeon_winsys *ws,
    if (test_flags & DBG(TEST_BLIT_PERF))
       si_test_blit_perf(sscreen);
 
+   if (test_flags & DBG(TUNE_DMA))
+      si_tune_dma(sscreen);
+
    if (test_flags & (DBG(TEST_VMFAULT_CP) | DBG(TEST_VMFAULT_SHADER)))
       si_test_vmfault(sscreen, test_flags);
 
@@ -285,6 +285,7 @@ enum
    DBG_TEST_DMA_PERF,
    DBG_TEST_MEM_PERF,
    DBG_TEST_BLIT_PERF,
+   DBG_TUNE_DMA,
 };
 
 #define DBG_ALL_SHADERS (((1 << (DBG_MS + 1)) - 1))
@@ -538,6 +539,14 @@ struct si_screen {
    struct radeon_winsys *ws;
    struct disk_cache *disk_shader_cache;
 
+   /* Buffer sizes up to which CP DMA beats compute, measured by AMD_TEST=tunedma.
+    * 0 means the built-in heuristic is used.
+    */
+   struct {
+      unsigned copy_max_size;
+      unsigned clear_max_size;
+   } cp_dma_tuning;
+
    struct radeon_info info;
    struct nir_shader_compiler_options *nir_options;
    uint64_t debug_flags;
@@ -622,6 +631,10 @@ struct si_screen {
    unsigned num_disk_shader_cache_hits;
    unsigned num_disk_shader_cache_misses;
 
+   /* Live VCN sessions of all contexts, for the HUD. */
+   unsigned num_video_encoders;
+   unsigned num_video_decoders;
+
    /* GPU load thread. */
    simple_mtx_t gpu_load_mutex;
    thrd_t gpu_load_thread;
@@ -1284,6 +1297,7 @@ struct si_context {
    unsigned last_db_flush_num_decompress_calls;
    unsigned num_compute_calls;
    unsigned num_cp_dma_calls;
+   unsigned num_compile_waits; /* shader selections that waited for a compiler */
    unsigned num_vs_flushes;
    unsigned num_ps_flushes;
    unsigned num_cs_flushes;
@@ -1692,6 +1706,8 @@ void si_test_dma_perf(struct si_screen *sscreen);
 void si_test_mem_perf(struct si_screen *sscreen);
 void si_test_clear_buffer(struct si_screen *sscreen);
 void si_test_copy_buffer(struct si_screen *sscreen);
+void si_tune_dma(struct si_screen *sscreen);
+void si_load_dma_tuning(struct si_screen *sscreen);
 
 /* si_test_blit_perf.c */
 void si_test_blit_perf(struct si_screen *sscreen);
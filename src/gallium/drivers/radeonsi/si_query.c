@@ -222,6 +222,13 @@ static bool si_query_sw_begin(struct si_context *sctx, struct si_query *squery)
    case SI_QUERY_NUM_SHADERS_CREATED:
       query->begin_result = p_atomic_read(&sctx->screen->num_shaders_created);
       break;
+   case SI_QUERY_NUM_COMPILE_WAITS:
+      query->begin_result = sctx->num_compile_waits;
+      break;
+   case SI_QUERY_NUM_VIDEO_ENCODERS:
+   case SI_QUERY_NUM_VIDEO_DECODERS:
+      query->begin_result = 0;
+      break;
    case SI_QUERY_LIVE_SHADER_CACHE_HITS:
       query->begin_result = sctx->screen->live_shader_cache.hits;
       break;
@@ -376,6 +383,15 @@ static bool si_query_sw_end(struct si_context *sctx, struct si_query *squery)
    case SI_QUERY_NUM_SHADERS_CREATED:
       query->end_result = p_atomic_read(&sctx->screen->num_shaders_created);
       break;
+   case SI_QUERY_NUM_COMPILE_WAITS:
+      query->end_result = sctx->num_compile_waits;
+      break;
+   case SI_QUERY_NUM_VIDEO_ENCODERS:
+      query->end_result = p_atomic_read(&sctx->screen->num_video_encoders);
+      break;
+   case SI_QUERY_NUM_VIDEO_DECODERS:
+      query->end_result = p_atomic_read(&sctx->screen->num_video_decoders);
+      break;
    case SI_QUERY_BACK_BUFFER_PS_DRAW_RATIO:
       query->end_result = sctx->last_tex_ps_draw_ratio;
       break;
@@ -1759,6 +1775,9 @@ void si_resume_queries(struct si_context *sctx)
 static struct pipe_driver_query_info si_driver_query_list[] = {
    X("num-compilations", NUM_COMPILATIONS, UINT64, CUMULATIVE),
    X("num-shaders-created", NUM_SHADERS_CREATED, UINT64, CUMULATIVE),
+   X("num-compile-waits", NUM_COMPILE_WAITS, UINT64, AVERAGE),
+   X("num-video-encoders", NUM_VIDEO_ENCODERS, UINT64, AVERAGE),
+   X("num-video-decoders", NUM_VIDEO_DECODERS, UINT64, AVERAGE),
    X("draw-calls", DRAW_CALLS, UINT64, AVERAGE),
    X("decompress-calls", DECOMPRESS_CALLS, UINT64, AVERAGE),
    X("compute-calls", COMPUTE_CALLS, UINT64, AVERAGE),
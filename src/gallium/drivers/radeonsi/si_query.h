@@ -87,6 +87,9 @@ enum
    SI_QUERY_GPU_SCRATCH_RAM_BUSY,
    SI_QUERY_NUM_COMPILATIONS,
    SI_QUERY_NUM_SHADERS_CREATED,
+   SI_QUERY_NUM_COMPILE_WAITS,
+   SI_QUERY_NUM_VIDEO_ENCODERS,
+   SI_QUERY_NUM_VIDEO_DECODERS,
    SI_QUERY_BACK_BUFFER_PS_DRAW_RATIO,
    SI_QUERY_GPIN_ASIC_ID,
    SI_QUERY_GPIN_NUM_SIMD,
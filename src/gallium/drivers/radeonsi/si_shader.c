@@ -14,6 +14,7 @@
 #include "si_pipe.h"
 #include "si_shader_internal.h"
 #include "pipe/p_shader_tokens.h"
+#include "util/mesa-sha1.h"
 
 static void si_fix_resource_usage(struct si_screen *sscreen, struct si_shader *shader);
 
@@ -1767,6 +1768,44 @@ static void si_init_mesh_shader_ngg_info(struct si_shader *shader)
    shader->ngg.info.ngg_out_lds_size = 0;
 }
 
+/* Monolithic variants go into the shader cache like main parts, under a key that
+ * also covers the shader key.  The shader key points to the selector of the first
+ * stage of merged shaders, which is replaced by that selector's IR key.
+ */
+static void si_get_monolithic_cache_key(struct si_shader *shader, unsigned char sha1[20])
+{
+   struct si_shader_selector *sel = shader->selector;
+   union si_shader_key key = shader->key;
+   unsigned char ir_sha1_cache_key[20];
+   struct mesa_sha1 ctx;
+
+   _mesa_sha1_init(&ctx);
+   _mesa_sha1_update(&ctx, "monolithic", 10);
+
+   if (sel->stage <= MESA_SHADER_GEOMETRY || sel->stage == MESA_SHADER_MESH) {
+      si_get_ir_cache_key(sel, key.ge.as_ngg, key.ge.as_es, shader->wave_size,
+                          ir_sha1_cache_key);
+      _mesa_sha1_update(&ctx, ir_sha1_cache_key, 20);
+
+      if (sel->stage == MESA_SHADER_TESS_CTRL && key.ge.part.tcs.ls) {
+         si_get_ir_cache_key(key.ge.part.tcs.ls, false, false, shader->wave_size,
+                             ir_sha1_cache_key);
+         _mesa_sha1_update(&ctx, ir_sha1_cache_key, 20);
+      } else if (sel->stage == MESA_SHADER_GEOMETRY && key.ge.part.gs.es) {
+         si_get_ir_cache_key(key.ge.part.gs.es, key.ge.as_ngg, true, shader->wave_size,
+                             ir_sha1_cache_key);
+         _mesa_sha1_update(&ctx, ir_sha1_cache_key, 20);
+      }
+      memset(&key.ge.part, 0, sizeof(key.ge.part));
+   } else {
+      si_get_ir_cache_key(sel, false, false, shader->wave_size, ir_sha1_cache_key);
+      _mesa_sha1_update(&ctx, ir_sha1_cache_key, 20);
+   }
+
+   _mesa_sha1_update(&ctx, &key, sizeof(key));
+   _mesa_sha1_final(&ctx, sha1);
+}
+
 bool si_create_shader_variant(struct si_screen *sscreen, struct ac_llvm_compiler *compiler,
                               struct si_shader *shader, struct util_debug_callback *debug)
 {
@@ -1786,8 +1825,21 @@ bool si_create_shader_variant(struct si_screen *sscreen, struct ac_llvm_compiler
       /* Monolithic shader (compiled as a whole, has many variants,
        * may take a long time to compile).
        */
-      if (!si_compile_shader(sscreen, compiler, shader, debug))
-         return false;
+      unsigned char cache_key[20];
+      si_get_monolithic_cache_key(shader, cache_key);
+
+      simple_mtx_lock(&sscreen->shader_cache_mutex);
+      bool cached = si_shader_cache_load_shader(sscreen, cache_key, shader);
+      simple_mtx_unlock(&sscreen->shader_cache_mutex);
+
+      if (!cached) {
+         if (!si_compile_shader(sscreen, compiler, shader, debug))
+            return false;
+
+         simple_mtx_lock(&sscreen->shader_cache_mutex);
+         si_shader_cache_insert_shader(sscreen, cache_key, shader, true);
+         simple_mtx_unlock(&sscreen->shader_cache_mutex);
+      }
    } else {
       /* The shader consists of several parts:
        *
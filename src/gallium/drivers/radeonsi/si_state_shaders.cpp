@@ -3065,6 +3065,25 @@ use_local_key_copy(const SHADER_KEY_TYPE *key, SHADER_KEY_TYPE *local_key, unsig
 
 #define NO_INLINE_UNIFORMS false
 
+/**
+ * Wait for a shader compilation a draw can't proceed without.
+ *
+ * If the compilation is still queued, it's moved to the front of the queue
+ * first, so that it doesn't wait behind shaders that nobody is drawing with
+ * yet.  Waits are counted for SI_QUERY_NUM_COMPILE_WAITS.
+ */
+static void si_wait_for_compile(struct si_context *sctx, struct util_queue *queue,
+                                struct util_queue_fence *ready)
+{
+   if (util_queue_fence_is_signalled(ready))
+      return;
+
+   sctx->num_compile_waits++;
+   if (queue)
+      util_queue_prioritize_job(queue, ready);
+   util_queue_fence_wait(ready);
+}
+
 /**
  * Select a shader variant according to the shader key.
  *
@@ -3122,7 +3141,7 @@ again:
             goto current_not_ready;
          }
 
-         util_queue_fence_wait(&current->ready);
+         si_wait_for_compile(sctx, NULL, &current->ready);
       }
 
       return current->compilation_failed ? -1 : 0;
@@ -3133,7 +3152,7 @@ current_not_ready:
     * compilation calls this function too, and therefore must enter
     * the mutex first.
     */
-   util_queue_fence_wait(&sel->ready);
+   si_wait_for_compile(sctx, &sscreen->shader_compiler_queue, &sel->ready);
 
    simple_mtx_lock(&sel->mutex);
 
@@ -3179,7 +3198,7 @@ current_not_ready:
                goto again;
             }
 
-            util_queue_fence_wait(&iter->ready);
+            si_wait_for_compile(sctx, NULL, &iter->ready);
          }
 
          if (iter->compilation_failed) {
@@ -3219,7 +3238,7 @@ current_not_ready:
 
       /* We need to wait for the previous shader. */
       if (previous_stage_sel)
-         util_queue_fence_wait(&previous_stage_sel->ready);
+         si_wait_for_compile(sctx, &sscreen->shader_compiler_queue, &previous_stage_sel->ready);
    }
 
    bool is_pure_monolithic =
@@ -3330,6 +3349,7 @@ current_not_ready:
    simple_mtx_unlock(&sel->mutex);
 
    assert(!shader->is_optimized);
+   sctx->num_compile_waits++;
    si_build_shader_variant(shader, -1, false);
 
    util_queue_fence_signal(&shader->ready);
@@ -6,6 +6,7 @@
 
 #include "si_pipe.h"
 #include "si_query.h"
+#include "util/disk_cache.h"
 #include "util/streaming-load-memcpy.h"
 
 #define MIN_SIZE   512
@@ -292,6 +293,141 @@ void si_test_dma_perf(struct si_screen *sscreen)
    exit(0);
 }
 
+#define TUNE_MIN_SIZE 256
+#define TUNE_MAX_SIZE (256 * 1024)
+
+struct si_dma_tuning_blob {
+   uint32_t version;
+   uint32_t copy_max_size;
+   uint32_t clear_max_size;
+};
+
+static void si_get_dma_tuning_cache_key(struct si_screen *sscreen, cache_key key)
+{
+   static const char name[] = "radeonsi_cp_dma_tuning";
+
+   /* The disk cache is per chip and driver build already. */
+   disk_cache_compute_key(sscreen->disk_shader_cache, name, sizeof(name), key);
+}
+
+void si_load_dma_tuning(struct si_screen *sscreen)
+{
+   if (!sscreen->disk_shader_cache || !sscreen->info.has_cp_dma ||
+       sscreen->info.cp_sdma_ge_use_system_memory_scope)
+      return;
+
+   cache_key key;
+   size_t size;
+   si_get_dma_tuning_cache_key(sscreen, key);
+
+   struct si_dma_tuning_blob *blob = disk_cache_get(sscreen->disk_shader_cache, key, &size);
+   if (blob && size == sizeof(*blob) && blob->version == 1) {
+      sscreen->cp_dma_tuning.copy_max_size = blob->copy_max_size;
+      sscreen->cp_dma_tuning.clear_max_size = blob->clear_max_size;
+   }
+   free(blob);
+}
+
+/* Return the GPU time of NUM_RUNS VRAM clears or copies of the given size in nanoseconds. */
+static uint64_t si_time_dma_op(struct si_context *sctx, bool is_copy, bool cp_dma, unsigned size)
+{
+   struct pipe_screen *screen = sctx->b.screen;
+   struct pipe_context *ctx = &sctx->b;
+   struct pipe_resource *dst = pipe_aligned_buffer_create(screen, 0, PIPE_USAGE_DEFAULT, size, 256);
+   struct pipe_resource *src =
+      is_copy ? pipe_aligned_buffer_create(screen, 0, PIPE_USAGE_DEFAULT, size, 256) : NULL;
+   struct pipe_query *q = ctx->create_query(ctx, PIPE_QUERY_TIME_ELAPSED, 0);
+   const uint32_t clear_value = 0x12345678;
+   union pipe_query_result result = {};
+
+   for (unsigned iter = 0; iter < WARMUP_RUNS + NUM_RUNS; iter++) {
+      if (iter == WARMUP_RUNS)
+         ctx->begin_query(ctx, q);
+
+      si_barrier_before_simple_buffer_op(sctx, 0, dst, src);
+      if (cp_dma) {
+         if (is_copy)
+            si_cp_dma_copy_buffer(sctx, dst, src, 0, 0, size);
+         else
+            si_cp_dma_clear_buffer(sctx, &sctx->gfx_cs, dst, 0, size, clear_value);
+      } else {
+         si_compute_clear_copy_buffer(sctx, dst, 0, src, 0, size, &clear_value, 4, 0, false,
+                                      false);
+      }
+      si_barrier_after_simple_buffer_op(sctx, 0, dst, src);
+      sctx->barrier_flags |= SI_BARRIER_INV_L2;
+   }
+
+   ctx->end_query(ctx, q);
+   ctx->get_query_result(ctx, q, true, &result);
+   ctx->destroy_query(ctx, q);
+   pipe_resource_reference(&dst, NULL);
+   pipe_resource_reference(&src, NULL);
+
+   return result.u64;
+}
+
+/* Return the largest power-of-two size up to which CP DMA is faster than compute. */
+static unsigned si_find_cp_dma_crossover(struct si_context *sctx, bool is_copy)
+{
+   unsigned max_size = 0;
+
+   for (unsigned size = TUNE_MIN_SIZE; size <= TUNE_MAX_SIZE; size *= 2) {
+      uint64_t cp_dma_time = si_time_dma_op(sctx, is_copy, true, size);
+      uint64_t compute_time = si_time_dma_op(sctx, is_copy, false, size);
+
+      /* Some chips return 0 for very small ops, which doesn't tell anything. */
+      if (cp_dma_time && compute_time && cp_dma_time >= compute_time)
+         break;
+
+      max_size = size;
+   }
+
+   /* 0 would mean "not tuned", so use the smallest size CP DMA can't beat. */
+   return MAX2(max_size, 1);
+}
+
+/**
+ * Measure up to which size CP DMA is faster than the compute shader for VRAM buffer copies
+ * and clears on this GPU, and store the result in the disk cache, so that all future processes
+ * running the same driver build on the same chip use it.
+ */
+void si_tune_dma(struct si_screen *sscreen)
+{
+   if (!sscreen->info.has_cp_dma || sscreen->info.cp_sdma_ge_use_system_memory_scope) {
+      printf("tunedma: CP DMA isn't used on this chip.\n");
+      return;
+   }
+
+   struct pipe_screen *screen = &sscreen->b;
+   struct pipe_context *ctx = screen->context_create(screen, NULL, 0);
+   struct si_context *sctx = (struct si_context *)ctx;
+
+   sscreen->ws->cs_set_pstate(&sctx->gfx_cs, RADEON_CTX_PSTATE_PEAK);
+
+   struct si_dma_tuning_blob blob = {
+      .version = 1,
+      .copy_max_size = si_find_cp_dma_crossover(sctx, true),
+      .clear_max_size = si_find_cp_dma_crossover(sctx, false),
+   };
+
+   sscreen->ws->cs_set_pstate(&sctx->gfx_cs, RADEON_CTX_PSTATE_NONE);
+   ctx->destroy(ctx);
+
+   sscreen->cp_dma_tuning.copy_max_size = blob.copy_max_size;
+   sscreen->cp_dma_tuning.clear_max_size = blob.clear_max_size;
+
+   printf("tunedma: CP DMA is used for VRAM copies up to %uB and clears up to %uB.\n",
+          blob.copy_max_size, blob.clear_max_size);
+
+   if (sscreen->disk_shader_cache) {
+      cache_key key;
+      si_get_dma_tuning_cache_key(sscreen, key);
+      disk_cache_put(sscreen->disk_shader_cache, key, &blob, sizeof(blob), NULL);
+      disk_cache_wait_for_idle(sscreen->disk_shader_cache);
+   }
+}
+
 void
 si_test_mem_perf(struct si_screen *sscreen)
 {
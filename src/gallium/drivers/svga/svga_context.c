@@ -78,6 +78,7 @@ svga_destroy(struct pipe_context *pipe)
    svga_destroy_swtnl(svga);
    svga_hwtnl_destroy(svga->hwtnl);
 
+   svga_sws(svga)->fence_reference(svga_sws(svga), &svga->last_fence, NULL);
    svga->swc->destroy(svga->swc);
 
    util_bitmask_destroy(svga->blend_object_id_bm);
@@ -467,6 +468,10 @@ svga_context_flush(struct svga_context *svga,
    if (pfence)
       svgascreen->sws->fence_reference(svgascreen->sws, pfence, fence);
 
+   if (fence)
+      svgascreen->sws->fence_reference(svgascreen->sws, &svga->last_fence,
+                                       fence);
+
    svgascreen->sws->fence_reference(svgascreen->sws, &fence, NULL);
 
    SVGA_STATS_TIME_POP(svga_sws(svga));
@@ -703,6 +703,9 @@ struct svga_context
    /** List of buffers with queued transfers */
    struct list_head dirty_buffers;
 
+   /** Fence of the last command buffer submission */
+   struct pipe_fence_handle *last_fence;
+
    /** performance / info queries for HUD */
    struct {
       uint64_t num_draw_calls;          /**< SVGA_QUERY_DRAW_CALLS */
@@ -25,6 +25,21 @@ svga_flush(struct pipe_context *pipe,
     */
    svga_surfaces_flush(svga);
 
+   /* If nothing was recorded since the last submission, its fence already
+    * covers all the work of this context. Don't submit an empty command
+    * buffer just to get a new one, e.g. for glFenceSync after glFlush.
+    */
+   if (fence && svga->last_fence &&
+       !(flags & PIPE_FLUSH_FENCE_FD) &&
+       svga->swc->imported_fence_fd == -1 &&
+       svga->swc->get_command_buffer_size(svga->swc) == 0 &&
+       list_is_empty(&svga->dirty_buffers) &&
+       !svga->state.hw_draw.const0_handle) {
+      struct svga_winsys_screen *sws = svga_sws(svga);
+      sws->fence_reference(sws, fence, svga->last_fence);
+      return;
+   }
+
    if (flags & PIPE_FLUSH_FENCE_FD)
       svga->swc->hints |= SVGA_HINT_FLAG_EXPORT_FENCE_FD;
 
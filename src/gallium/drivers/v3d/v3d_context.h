@@ -232,6 +232,16 @@ struct v3d_uncompiled_shader {
 
         /* For caching */
         unsigned char sha1[20];
+
+        /**
+         * Compile strategy that worked for the last variant compiled, which
+         * the next variants start from.  Variants mostly differ in bits of
+         * state that don't change register pressure much, so if the first
+         * strategies failed for one they are likely to fail for the others.
+         * Also kept in the disk cache, and loaded with the first variant.
+         */
+        uint32_t compile_strategy_hint;
+        bool compile_strategy_hint_loaded;
 };
 
 struct v3d_compiled_shader {
@@ -915,6 +925,13 @@ void v3d_disk_cache_store(struct v3d_context *v3d,
                           const struct v3d_compiled_shader *shader,
                           uint64_t *qpu_insts,
                           uint32_t qpu_size);
+
+uint32_t v3d_disk_cache_retrieve_strategy(struct v3d_context *v3d,
+                                          const struct v3d_uncompiled_shader *uncompiled);
+
+void v3d_disk_cache_store_strategy(struct v3d_context *v3d,
+                                   const struct v3d_uncompiled_shader *uncompiled,
+                                   uint32_t strategy);
 #endif /* ENABLE_SHADER_CACHE */
 
 #ifdef v3dX
@@ -223,5 +223,68 @@ v3d_disk_cache_store(struct v3d_context *v3d,
         blob_finish(&blob);
 }
 
+static void
+v3d_disk_cache_compute_strategy_key(struct disk_cache *cache,
+                                    cache_key cache_key,
+                                    const struct v3d_uncompiled_shader *uncompiled)
+{
+        static const char prefix[] = "v3d compile strategy";
+
+        struct blob blob;
+        blob_init(&blob);
+        blob_write_bytes(&blob, prefix, sizeof(prefix));
+        blob_write_bytes(&blob, uncompiled->sha1, 20);
+
+        disk_cache_compute_key(cache, blob.data, blob.size, cache_key);
+
+        blob_finish(&blob);
+}
+
+/**
+ * Returns the compile strategy recorded for the shader, regardless of the
+ * variant, or 0 (the default strategy) if there is none.
+ */
+uint32_t
+v3d_disk_cache_retrieve_strategy(struct v3d_context *v3d,
+                                 const struct v3d_uncompiled_shader *uncompiled)
+{
+        struct disk_cache *cache = v3d->screen->disk_cache;
+
+        if (!cache)
+                return 0;
+
+        cache_key cache_key;
+        v3d_disk_cache_compute_strategy_key(cache, cache_key, uncompiled);
+
+        size_t buffer_size;
+        void *buffer = disk_cache_get(cache, cache_key, &buffer_size);
+        if (!buffer)
+                return 0;
+
+        uint32_t strategy = 0;
+        if (buffer_size == sizeof(strategy))
+                memcpy(&strategy, buffer, sizeof(strategy));
+
+        free(buffer);
+
+        return strategy;
+}
+
+void
+v3d_disk_cache_store_strategy(struct v3d_context *v3d,
+                              const struct v3d_uncompiled_shader *uncompiled,
+                              uint32_t strategy)
+{
+        struct disk_cache *cache = v3d->screen->disk_cache;
+
+        if (!cache)
+                return;
+
+        cache_key cache_key;
+        v3d_disk_cache_compute_strategy_key(cache, cache_key, uncompiled);
+
+        disk_cache_put(cache, cache_key, &strategy, sizeof(strategy), NULL);
+}
+
 #endif /* ENABLE_SHADER_CACHE */
 
@@ -492,11 +492,22 @@ v3d_get_compiled_shader(struct v3d_context *v3d,
                 int program_id = uncompiled->program_id;
                 uint64_t *qpu_insts;
 
+#ifdef ENABLE_SHADER_CACHE
+                if (!uncompiled->compile_strategy_hint_loaded) {
+                        uncompiled->compile_strategy_hint =
+                                v3d_disk_cache_retrieve_strategy(v3d, uncompiled);
+                        uncompiled->compile_strategy_hint_loaded = true;
+                }
+#endif
+                const uint32_t strategy_hint =
+                        uncompiled->compile_strategy_hint;
+
                 qpu_insts = v3d_compile(v3d->screen->compiler, key,
                                         &shader->prog_data.base, s,
                                         v3d_shader_debug_output,
                                         v3d,
                                         program_id, variant_id,
+                                        strategy_hint,
                                         &shader->qpu_size);
 
                 /* qpu_insts being NULL can happen if the register allocation
@@ -508,6 +519,18 @@ v3d_get_compiled_shader(struct v3d_context *v3d,
                 assert(qpu_insts);
                 ralloc_steal(shader, shader->prog_data.base);
 
+                if (qpu_insts &&
+                    shader->prog_data.base->compile_strategy_idx !=
+                    strategy_hint) {
+                        const uint32_t strategy =
+                                shader->prog_data.base->compile_strategy_idx;
+                        uncompiled->compile_strategy_hint = strategy;
+#ifdef ENABLE_SHADER_CACHE
+                        v3d_disk_cache_store_strategy(v3d, uncompiled,
+                                                      strategy);
+#endif
+                }
+
                 if (shader->qpu_size) {
                         u_upload_data_ref(v3d->state_uploader, 0, shader->qpu_size, 8,
                                       qpu_insts, &shader->offset, &shader->resource);
@@ -392,3 +392,42 @@ TEST_F(VirglStagingMgr, uses_staging_buffer_resource)
 
    release_resources(&out_resource, 1);
 }
+
+TEST_F(VirglStagingMgr, extends_only_the_last_suballocation)
+{
+   struct virgl_hw_res *out_resource[2] = {0};
+   unsigned out_offset;
+   uint8_t *map_ptr;
+   bool alloc_succeeded;
+
+   alloc_succeeded =
+      virgl_staging_alloc(&staging, 100, 1, &out_offset,
+                          &out_resource[0], &map_ptr);
+   EXPECT_TRUE(alloc_succeeded);
+   ASSERT_NE(out_resource[0], nullptr);
+
+   EXPECT_TRUE(virgl_staging_extend(&staging, out_resource[0], 100, 28,
+                                    &map_ptr));
+   EXPECT_EQ(map_ptr, (uint8_t*)resource_map(out_resource[0]) + 100);
+
+   /* Not the end of the last suballocation anymore. */
+   EXPECT_FALSE(virgl_staging_extend(&staging, out_resource[0], 100, 28,
+                                     &map_ptr));
+   /* Does not fit. */
+   EXPECT_FALSE(virgl_staging_extend(&staging, out_resource[0], 128,
+                                     staging_size, &map_ptr));
+
+   alloc_succeeded =
+      virgl_staging_alloc(&staging, 16, 16, &out_offset,
+                          &out_resource[1], &map_ptr);
+   EXPECT_TRUE(alloc_succeeded);
+   EXPECT_EQ(out_offset, 128);
+
+   /* Something else was allocated since. */
+   EXPECT_FALSE(virgl_staging_extend(&staging, out_resource[0], 128, 16,
+                                     &map_ptr));
+   EXPECT_TRUE(virgl_staging_extend(&staging, out_resource[1], 144, 16,
+                                    &map_ptr));
+
+   release_resources(out_resource, 2);
+}
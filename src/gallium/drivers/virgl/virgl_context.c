@@ -1114,6 +1114,7 @@ void virgl_flush_eq(struct virgl_context *ctx, void *closure,
     * involving staging resources.
     */
    ctx->queued_staging_res_size = 0;
+   ctx->last_copy_transfer.cdw = 0;
 }
 
 static void virgl_flush_from_st(struct pipe_context *ctx,
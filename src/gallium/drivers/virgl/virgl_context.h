@@ -113,6 +113,17 @@ struct virgl_context {
 
    /* The total size of staging resources used in queued copy transfers. */
    uint64_t queued_staging_res_size;
+
+   /* The buffer copy transfer that ends the cbuf, if any, so that contiguous
+    * uploads can grow it instead of encoding one transfer each.
+    */
+   struct {
+      unsigned cdw; /* cbuf->cdw right after the command, 0 if none */
+      const struct virgl_hw_res *hw_res;
+      unsigned end;
+      const struct virgl_hw_res *src_hw_res;
+      unsigned src_end;
+   } last_copy_transfer;
 };
 
 struct virgl_vertex_elements_state {
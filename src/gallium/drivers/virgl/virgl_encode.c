@@ -1736,6 +1736,52 @@ void virgl_encode_copy_transfer(struct virgl_context *ctx,
    vs->vws->emit_res(vs->vws, ctx->cbuf, trans->copy_src_hw_res, true);
    virgl_encoder_write_dword(ctx->cbuf, trans->copy_src_offset);
    virgl_encoder_write_dword(ctx->cbuf, direction_and_synchronized);
+
+   if (trans->base.resource->target == PIPE_BUFFER &&
+       trans->direction == VIRGL_TRANSFER_TO_HOST) {
+      ctx->last_copy_transfer.cdw = ctx->cbuf->cdw;
+      ctx->last_copy_transfer.hw_res = trans->hw_res;
+      ctx->last_copy_transfer.end = trans->base.box.x + trans->base.box.width;
+      ctx->last_copy_transfer.src_hw_res = trans->copy_src_hw_res;
+      ctx->last_copy_transfer.src_end =
+         trans->copy_src_offset + trans->base.box.width;
+   } else {
+      ctx->last_copy_transfer.cdw = 0;
+   }
+}
+
+/* Appends the data to the buffer copy transfer encoded last, if it is still
+ * the last command, targets the same range end and nothing else was
+ * allocated from the staging buffer since.  The host then does one copy
+ * for a run of small contiguous uploads.
+ */
+bool virgl_encode_extend_copy_transfer(struct virgl_context *ctx,
+                                       const struct virgl_hw_res *hw_res,
+                                       unsigned offset, unsigned size,
+                                       const void *data)
+{
+   uint32_t *cmd;
+   uint8_t *map;
+
+   if (ctx->last_copy_transfer.cdw != ctx->cbuf->cdw ||
+       ctx->last_copy_transfer.hw_res != hw_res ||
+       ctx->last_copy_transfer.end != offset)
+      return false;
+
+   if (!virgl_staging_extend(&ctx->staging,
+                             ctx->last_copy_transfer.src_hw_res,
+                             ctx->last_copy_transfer.src_end, size, &map))
+      return false;
+
+   memcpy(map, data, size);
+
+   cmd = &ctx->cbuf->buf[ctx->cbuf->cdw - (VIRGL_COPY_TRANSFER3D_SIZE + 1)];
+   cmd[VIRGL_RESOURCE_IW_W] += size;
+
+   ctx->last_copy_transfer.end += size;
+   ctx->last_copy_transfer.src_end += size;
+
+   return true;
 }
 
 void virgl_encode_end_transfers(struct virgl_cmd_buf *buf)
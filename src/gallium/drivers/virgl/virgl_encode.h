@@ -294,6 +294,11 @@ void virgl_encode_transfer(struct virgl_screen *vs, struct virgl_cmd_buf *buf,
 void virgl_encode_copy_transfer(struct virgl_context *ctx,
                                 struct virgl_transfer *trans);
 
+bool virgl_encode_extend_copy_transfer(struct virgl_context *ctx,
+                                       const struct virgl_hw_res *hw_res,
+                                       unsigned offset, unsigned size,
+                                       const void *data);
+
 void virgl_encode_end_transfers(struct virgl_cmd_buf *buf);
 
 int virgl_encode_tweak(struct virgl_context *ctx, enum vrend_tweak_type tweak, uint32_t value);
@@ -983,6 +983,21 @@ static void virgl_buffer_subdata(struct pipe_context *pipe,
       return;
    }
 
+   /* Right after an upload through the staging buffer that ends where this
+    * one starts, this would go through the staging buffer as well, so just
+    * grow that copy transfer.
+    */
+   if (vctx->supports_staging &&
+       likely(!(virgl_debug & VIRGL_DEBUG_XFER)) &&
+       vctx->queued_staging_res_size + size <=
+          VIRGL_QUEUED_STAGING_RES_SIZE_LIMIT &&
+       virgl_encode_extend_copy_transfer(vctx, vbuf->hw_res,
+                                         offset, size, data)) {
+      vctx->queued_staging_res_size += size;
+      util_range_add(&vbuf->b, &vbuf->valid_buffer_range, offset, offset + size);
+      return;
+   }
+
    u_default_buffer_subdata(pipe, resource, usage, offset, size, data);
 }
 
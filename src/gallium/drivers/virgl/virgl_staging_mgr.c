@@ -135,3 +135,20 @@ virgl_staging_alloc(struct virgl_staging_mgr *staging,
 
    return true;
 }
+
+bool
+virgl_staging_extend(struct virgl_staging_mgr *staging,
+                     const struct virgl_hw_res *hw_res,
+                     unsigned end,
+                     unsigned size,
+                     uint8_t **ptr)
+{
+   if (hw_res != staging->hw_res || end != staging->offset ||
+       end + size > staging->size)
+      return false;
+
+   *ptr = staging->map + end;
+   staging->offset = end + size;
+
+   return true;
+}
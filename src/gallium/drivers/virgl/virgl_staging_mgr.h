@@ -85,6 +85,25 @@ virgl_staging_alloc(struct virgl_staging_mgr *staging,
                     struct virgl_hw_res **outbuf,
                     uint8_t **ptr);
 
+/**
+ * Grow the last sub-allocation from the staging buffer in place.
+ *
+ * \param staging          Staging manager
+ * \param hw_res           Staging buffer of the sub-allocation to grow.
+ * \param end              Offset right past the sub-allocation to grow.
+ * \param size             Number of bytes to add.
+ * \param ptr              Pointer to where the pointer to the added memory is
+ *                         returned.
+ * \return                 Whether nothing was allocated since and there is
+ *                         enough space left in the staging buffer.
+ */
+bool
+virgl_staging_extend(struct virgl_staging_mgr *staging,
+                     const struct virgl_hw_res *hw_res,
+                     unsigned end,
+                     unsigned size,
+                     uint8_t **ptr);
+
 #ifdef __cplusplus
 } // extern "C" {
 #endif
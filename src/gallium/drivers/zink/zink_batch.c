@@ -638,16 +638,75 @@ typedef enum {
 
 #define ZINK_MAX_SIGNALS 3
 
-static void
-submit_queue(void *data, void *gdata, int thread_index)
+/* the most batches that are submitted with a single vkQueueSubmit */
+#define ZINK_MAX_COALESCED_SUBMITS 8
+
+/* everything a batch's submit infos point to, so that several batches can be submitted at once */
+struct zink_batch_submit {
+   VkSubmitInfo si[ZINK_SUBMIT_MAX];
+   VkSubmitInfo *submit;
+   int num_si;
+   VkTimelineSemaphoreSubmitInfo sem_submit;
+   VkTimelineSemaphoreSubmitInfo tsi;
+   VkTimelineSemaphoreSubmitInfo user_sem_submit;
+   VkCommandBuffer cmdbufs[3];
+   VkSemaphore signals[ZINK_MAX_SIGNALS];
+   uint64_t signal_values[ZINK_MAX_SIGNALS];
+};
+
+/* batches that only signal the timeline semaphore have no ordering requirements
+ * against anything but the batches around them, so they can be submitted along with those
+ */
+static bool
+batch_can_coalesce(const struct zink_batch_state *bs)
 {
-   MESA_TRACE_FUNC();
-   struct zink_batch_state *bs = data;
-   struct zink_context *ctx = bs->ctx;
-   struct zink_screen *screen = zink_screen(ctx->base.screen);
-   VkSubmitInfo si[ZINK_SUBMIT_MAX] = {0};
-   VkSubmitInfo *submit = si;
-   int num_si = ZINK_SUBMIT_MAX;
+   return !bs->sparse_semaphore && !bs->present && !bs->signal_semaphore &&
+          !bs->dmabuf_exports.entries &&
+          !util_dynarray_num_elements(&bs->acquires, VkSemaphore) &&
+          !util_dynarray_num_elements(&bs->fd_wait_semaphores, VkSemaphore) &&
+          !util_dynarray_num_elements(&bs->wait_semaphores, VkSemaphore) &&
+          !util_dynarray_num_elements(&bs->signal_semaphores, VkSemaphore) &&
+          !util_dynarray_num_elements(&bs->user_signal_semaphores, VkSemaphore);
+}
+
+/* takes the batch along with the batches queued right after it that can be submitted with it
+ * and returns the number of batches taken, which is 0 if the batch was already submitted by an earlier job
+ */
+static unsigned
+take_pending_submits(struct zink_screen *screen, struct zink_batch_state *bs, struct zink_batch_state **batches)
+{
+   simple_mtx_lock(&screen->pending_submits_lock);
+   struct zink_batch_state **pending = screen->pending_submits.data;
+   unsigned num_pending = util_dynarray_num_elements(&screen->pending_submits, struct zink_batch_state *);
+   unsigned start = 0;
+   unsigned num = 0;
+   /* skip the markers of presents queued before this batch: those already ran */
+   while (start < num_pending && !pending[start])
+      start++;
+   if (start < num_pending && pending[start] == bs) {
+      batches[num++] = bs;
+      while (batch_can_coalesce(bs) && num < ZINK_MAX_COALESCED_SUBMITS && start + num < num_pending &&
+             /* batches can't be moved ahead of a present */
+             pending[start + num] && batch_can_coalesce(pending[start + num])) {
+         batches[num] = pending[start + num];
+         num++;
+      }
+   }
+   memmove(pending, pending + start + num, (num_pending - start - num) * sizeof(*pending));
+   screen->pending_submits.size -= (start + num) * sizeof(*pending);
+   simple_mtx_unlock(&screen->pending_submits_lock);
+   return num;
+}
+
+/* fills in the submit infos of a batch and ends its cmdbufs; returns false if the device was lost */
+static bool
+prepare_submit(struct zink_batch_state *bs, struct zink_batch_submit *s)
+{
+   struct zink_screen *screen = zink_screen(bs->ctx->base.screen);
+   VkSubmitInfo *si = s->si;
+   memset(s, 0, sizeof(*s));
+   s->submit = si;
+   s->num_si = ZINK_SUBMIT_MAX;
    while (!bs->fence.batch_id)
       bs->fence.batch_id = (uint32_t)p_atomic_inc_return(&screen->curr_batch);
    bs->usage.usage = bs->fence.batch_id;
@@ -656,7 +715,7 @@ submit_queue(void *data, void *gdata, int thread_index)
 
    uint64_t batch_id = bs->fence.batch_id;
    /* first submit is just for acquire waits since they have a separate array */
-   for (unsigned i = 0; i < ARRAY_SIZE(si); i++)
+   for (unsigned i = 0; i < ZINK_SUBMIT_MAX; i++)
       si[i].sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
    if (bs->sparse_semaphore)
       util_dynarray_append(&bs->acquires, bs->sparse_semaphore);
@@ -679,11 +738,11 @@ submit_queue(void *data, void *gdata, int thread_index)
    si[ZINK_SUBMIT_WAIT_FD].pWaitDstStageMask = bs->fd_wait_semaphore_stages.data;
 
    if (si[ZINK_SUBMIT_WAIT_ACQUIRE].waitSemaphoreCount == 0) {
-      num_si--;
-      submit++;
+      s->num_si--;
+      s->submit++;
       if (si[ZINK_SUBMIT_WAIT_FD].waitSemaphoreCount == 0) {
-         num_si--;
-         submit++;
+         s->num_si--;
+         s->submit++;
       }
    }
 
@@ -691,65 +750,55 @@ submit_queue(void *data, void *gdata, int thread_index)
    si[ZINK_SUBMIT_CMDBUF].waitSemaphoreCount = util_dynarray_num_elements(&bs->wait_semaphores, VkSemaphore);
    si[ZINK_SUBMIT_CMDBUF].pWaitSemaphores = bs->wait_semaphores.data;
    si[ZINK_SUBMIT_CMDBUF].pWaitDstStageMask = bs->wait_semaphore_stages.data;
-   VkTimelineSemaphoreSubmitInfo sem_submit = {
-      VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
-      NULL,
-      si[ZINK_SUBMIT_CMDBUF].waitSemaphoreCount,
-      bs->wait_semaphore_values.data
-   };
+   s->sem_submit.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+   s->sem_submit.waitSemaphoreValueCount = si[ZINK_SUBMIT_CMDBUF].waitSemaphoreCount;
+   s->sem_submit.pWaitSemaphoreValues = bs->wait_semaphore_values.data;
    if (si[ZINK_SUBMIT_CMDBUF].waitSemaphoreCount)
-      si[ZINK_SUBMIT_CMDBUF].pNext = &sem_submit;
-   VkCommandBuffer cmdbufs[3];
+      si[ZINK_SUBMIT_CMDBUF].pNext = &s->sem_submit;
    unsigned c = 0;
    if (bs->has_unsync)
-      cmdbufs[c++] = bs->unsynchronized_cmdbuf;
+      s->cmdbufs[c++] = bs->unsynchronized_cmdbuf;
    if (bs->has_reordered_work)
-      cmdbufs[c++] = bs->reordered_cmdbuf;
+      s->cmdbufs[c++] = bs->reordered_cmdbuf;
    if (bs->has_work)
-      cmdbufs[c++] = bs->cmdbuf;
-   si[ZINK_SUBMIT_CMDBUF].pCommandBuffers = cmdbufs;
+      s->cmdbufs[c++] = bs->cmdbuf;
+   si[ZINK_SUBMIT_CMDBUF].pCommandBuffers = s->cmdbufs;
    si[ZINK_SUBMIT_CMDBUF].commandBufferCount = c;
    /* assorted signal submit from wsi/externals */
    si[ZINK_SUBMIT_CMDBUF].signalSemaphoreCount = util_dynarray_num_elements(&bs->signal_semaphores, VkSemaphore);
    si[ZINK_SUBMIT_CMDBUF].pSignalSemaphores = bs->signal_semaphores.data;
 
    /* then the signal submit with the timeline (fence) semaphore */
-   VkSemaphore signals[ZINK_MAX_SIGNALS];
+   VkSemaphore *signals = s->signals;
    si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount = !!bs->signal_semaphore;
    signals[0] = bs->signal_semaphore;
    si[ZINK_SUBMIT_SIGNAL_INTERNAL].pSignalSemaphores = signals;
-   VkTimelineSemaphoreSubmitInfo tsi = {0};
-   uint64_t signal_values[ZINK_MAX_SIGNALS] = {0};
-   tsi.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
-   si[ZINK_SUBMIT_SIGNAL_INTERNAL].pNext = &tsi;
-   tsi.pSignalSemaphoreValues = signal_values;
-   signal_values[si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount] = batch_id;
+   VkTimelineSemaphoreSubmitInfo *tsi = &s->tsi;
+   tsi->sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+   si[ZINK_SUBMIT_SIGNAL_INTERNAL].pNext = tsi;
+   tsi->pSignalSemaphoreValues = s->signal_values;
+   s->signal_values[si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount] = batch_id;
    signals[si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount++] = screen->sem;
-   tsi.signalSemaphoreValueCount = si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount;
+   tsi->signalSemaphoreValueCount = si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount;
 
    if (bs->present)
       signals[si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount++] = bs->present;
-   tsi.signalSemaphoreValueCount = si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount;
+   tsi->signalSemaphoreValueCount = si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount;
 
    assert(si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount <= ZINK_MAX_SIGNALS);
-   assert(tsi.signalSemaphoreValueCount <= ZINK_MAX_SIGNALS);
+   assert(tsi->signalSemaphoreValueCount <= ZINK_MAX_SIGNALS);
 
    si[ZINK_SUBMIT_SIGNAL_USER].signalSemaphoreCount = util_dynarray_num_elements(&bs->user_signal_semaphores, VkSemaphore);
    si[ZINK_SUBMIT_SIGNAL_USER].pSignalSemaphores = bs->user_signal_semaphores.data;
-   VkTimelineSemaphoreSubmitInfo user_sem_submit = {
-      VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
-      NULL,
-      0,
-      NULL,
-      si[ZINK_SUBMIT_SIGNAL_USER].signalSemaphoreCount,
-      bs->user_signal_semaphore_values.data
-   };
+   s->user_sem_submit.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+   s->user_sem_submit.signalSemaphoreValueCount = si[ZINK_SUBMIT_SIGNAL_USER].signalSemaphoreCount;
+   s->user_sem_submit.pSignalSemaphoreValues = bs->user_signal_semaphore_values.data;
    if (si[ZINK_SUBMIT_SIGNAL_USER].signalSemaphoreCount) {
-      si[ZINK_SUBMIT_SIGNAL_USER].pNext = &user_sem_submit;
+      si[ZINK_SUBMIT_SIGNAL_USER].pNext = &s->user_sem_submit;
    } else {
-      num_si--;
+      s->num_si--;
       if (!si[ZINK_SUBMIT_SIGNAL_INTERNAL].signalSemaphoreCount)
-         num_si--;
+         s->num_si--;
    }
 
    VkResult result;
@@ -759,7 +808,7 @@ submit_queue(void *data, void *gdata, int thread_index)
          if (result != VK_SUCCESS) {
             mesa_loge("ZINK: vkEndCommandBuffer failed (%s)", vk_Result_to_str(result));
             bs->is_device_lost = true;
-            goto end;
+            return false;
          }
       );
    }
@@ -780,7 +829,7 @@ submit_queue(void *data, void *gdata, int thread_index)
          if (result != VK_SUCCESS) {
             mesa_loge("ZINK: vkEndCommandBuffer failed (%s)", vk_Result_to_str(result));
             bs->is_device_lost = true;
-            goto end;
+            return false;
          }
       );
    }
@@ -790,21 +839,17 @@ submit_queue(void *data, void *gdata, int thread_index)
          if (result != VK_SUCCESS) {
             mesa_loge("ZINK: vkEndCommandBuffer failed (%s)", vk_Result_to_str(result));
             bs->is_device_lost = true;
-            goto end;
+            return false;
          }
       );
    }
+   return true;
+}
 
-   simple_mtx_lock(screen->queue_lock);
-   VRAM_ALLOC_LOOP(result,
-      VKSCR(QueueSubmit)(screen->queue, num_si, submit, VK_NULL_HANDLE),
-      if (result != VK_SUCCESS) {
-         mesa_loge("ZINK: vkQueueSubmit failed (%s)", vk_Result_to_str(result));
-         bs->is_device_lost = true;
-      }
-   );
-   simple_mtx_unlock(screen->queue_lock);
-
+/* runs once the batch is in the queue */
+static void
+finish_submit(struct zink_batch_state *bs, struct zink_screen *screen)
+{
    unsigned i = 0;
    VkSemaphore *sem = bs->signal_semaphores.data;
    set_foreach(&bs->dmabuf_exports, entry) {
@@ -821,7 +866,63 @@ submit_queue(void *data, void *gdata, int thread_index)
       (void)util_dynarray_pop(&bs->acquires, VkSemaphore);
 
    bs->usage.submit_count++;
+   p_atomic_inc(&bs->ctx->hud.submitted_batches);
+}
+
+static void
+submit_queue(void *data, void *gdata, int thread_index)
+{
+   MESA_TRACE_FUNC();
+   struct zink_batch_state *bs = data;
+   struct zink_context *ctx = bs->ctx;
+   struct zink_screen *screen = zink_screen(ctx->base.screen);
+   struct zink_batch_state *batches[ZINK_MAX_COALESCED_SUBMITS] = {bs};
+   struct zink_batch_submit submits[ZINK_MAX_COALESCED_SUBMITS];
+   bool prepared[ZINK_MAX_COALESCED_SUBMITS];
+   VkSubmitInfo si[ZINK_MAX_COALESCED_SUBMITS * ZINK_SUBMIT_MAX];
+   unsigned num_batches = 1;
+   unsigned num_si = 0;
+
+   if (screen->threaded_submit) {
+      /* batches which were flushed in a row are submitted together to save on kernel submissions */
+      num_batches = take_pending_submits(screen, bs, batches);
+      /* this was already submitted along with an earlier batch */
+      if (!num_batches)
+         goto end;
+   }
+
+   for (unsigned i = 0; i < num_batches; i++) {
+      prepared[i] = prepare_submit(batches[i], &submits[i]);
+      if (prepared[i]) {
+         memcpy(&si[num_si], submits[i].submit, submits[i].num_si * sizeof(VkSubmitInfo));
+         num_si += submits[i].num_si;
+      }
+   }
+   if (!num_si)
+      goto end;
+
+   VkResult result;
+   simple_mtx_lock(screen->queue_lock);
+   VRAM_ALLOC_LOOP(result,
+      VKSCR(QueueSubmit)(screen->queue, num_si, si, VK_NULL_HANDLE),
+      if (result != VK_SUCCESS) {
+         mesa_loge("ZINK: vkQueueSubmit failed (%s)", vk_Result_to_str(result));
+         for (unsigned i = 0; i < num_batches; i++)
+            batches[i]->is_device_lost = true;
+      }
+   );
+   simple_mtx_unlock(screen->queue_lock);
+   p_atomic_inc(&ctx->hud.queue_submits);
+
+   for (unsigned i = 0; i < num_batches; i++) {
+      if (prepared[i])
+         finish_submit(batches[i], screen);
+   }
+
 end:
+   /* batches submitted along with an earlier one only complete in their own job,
+    * which keeps them from being reused before that job has run
+    */
    cnd_broadcast(&bs->usage.flush);
 
    post_submit(bs, screen);
@@ -934,8 +1035,11 @@ zink_end_batch(struct zink_context *ctx)
       (*mfence)->deferred_ctx = NULL;
 
    if (screen->threaded_submit) {
+      simple_mtx_lock(&screen->pending_submits_lock);
+      util_dynarray_append(&screen->pending_submits, bs);
       util_queue_add_job(&screen->flush_queue, bs, &bs->flush_completed,
                          submit_queue, NULL, 0);
+      simple_mtx_unlock(&screen->pending_submits_lock);
    } else {
       submit_queue(bs, NULL, 0);
    }
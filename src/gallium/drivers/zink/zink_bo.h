@@ -84,6 +84,9 @@ zink_heap_from_domain_flags(VkMemoryPropertyFlags domains, enum zink_alloc_flag
    if ((domains & VK_VIS_VRAM) == VK_VIS_VRAM)
       return ZINK_HEAP_DEVICE_LOCAL_VISIBLE;
 
+   if ((domains & VK_LAZY_VRAM) == VK_LAZY_VRAM)
+      return ZINK_HEAP_DEVICE_LOCAL_LAZY;
+
    if (domains & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
       return ZINK_HEAP_DEVICE_LOCAL;
 
@@ -1075,6 +1075,89 @@ populate_sets(struct zink_context *ctx, struct zink_batch_state *bs,
    return true;
 }
 
+/* a set written to the descriptor buffer, identified by its layout and the
+ * host descriptor data it was written from
+ */
+struct zink_db_set_key {
+   uint32_t hash;
+   uint32_t size;
+   uint64_t offset; //the offset of the set in the descriptor buffer
+   const struct zink_descriptor_layout_key *layout;
+   uint8_t data[];
+};
+
+/* beyond this, sets are rewritten every time they change */
+#define ZINK_DB_SET_KEY_MAX_DATA 2048
+
+static uint32_t
+hash_db_set_key(const void *key)
+{
+   return ((const struct zink_db_set_key *)key)->hash;
+}
+
+static bool
+equals_db_set_key(const void *a, const void *b)
+{
+   const struct zink_db_set_key *a_k = a;
+   const struct zink_db_set_key *b_k = b;
+   return a_k->layout == b_k->layout && a_k->size == b_k->size &&
+          !memcmp(a_k->data, b_k->data, a_k->size);
+}
+
+static void
+free_db_set_key(struct hash_entry *he)
+{
+   ralloc_free((void *)he->key);
+}
+
+/* returns true and the offset of the set if the same set was already written to the
+ * current descriptor buffer, otherwise records that it is about to be written at db_offset
+ *
+ * descriptor buffer contents only depend on the layout and the host data they are
+ * written from, so rebinding a set that changed back to a previous state (e.g., the same
+ * few textures or buffers bound over and over again) doesn't need to write it again;
+ * this is limited to a single batch since handles may be reused once objects
+ * referenced by the batch are destroyed
+ */
+static bool
+find_db_set(struct zink_context *ctx, struct zink_program *pg, enum zink_descriptor_type type, uint64_t *offset)
+{
+   struct zink_batch_state *bs = ctx->bs;
+   const struct zink_descriptor_layout_key *layout = pg->dd.pool_key[type]->layout;
+   uint64_t buf[(sizeof(struct zink_db_set_key) + ZINK_DB_SET_KEY_MAX_DATA) / sizeof(uint64_t)];
+   struct zink_db_set_key *key = (struct zink_db_set_key *)buf;
+
+   unsigned size = 0;
+   for (unsigned i = 0; i < layout->num_bindings; i++)
+      size += layout->bindings[i].descriptorCount * pg->dd.db_template[type][i].stride;
+   if (size > ZINK_DB_SET_KEY_MAX_DATA)
+      return false;
+
+   uint8_t *data = key->data;
+   for (unsigned i = 0; i < layout->num_bindings; i++) {
+      unsigned binding_size = layout->bindings[i].descriptorCount * pg->dd.db_template[type][i].stride;
+      memcpy(data, ((uint8_t *)ctx) + pg->dd.db_template[type][i].offset, binding_size);
+      data += binding_size;
+   }
+   key->size = size;
+   key->layout = layout;
+   key->hash = XXH32(key->data, size, (uint32_t)(uintptr_t)layout);
+
+   struct hash_entry *he = _mesa_hash_table_search_pre_hashed(bs->dd.db_sets, key->hash, key);
+   if (he) {
+      *offset = ((const struct zink_db_set_key *)he->key)->offset;
+      return true;
+   }
+
+   struct zink_db_set_key *new_key = ralloc_size(bs->dd.db_sets, sizeof(struct zink_db_set_key) + size);
+   if (new_key) {
+      memcpy(new_key, key, sizeof(struct zink_db_set_key) + size);
+      new_key->offset = bs->dd.db_offset;
+      _mesa_hash_table_insert_pre_hashed(bs->dd.db_sets, new_key->hash, new_key, NULL);
+   }
+   return false;
+}
+
 static void
 reinit_db(struct zink_screen *screen, struct zink_batch_state *bs)
 {
@@ -1192,7 +1275,9 @@ zink_descriptors_update_masked_buffer(struct zink_context *ctx, enum zink_pipeli
       assert(type < ZINK_DESCRIPTOR_BASE_TYPES);
       bool changed = (changed_sets & BITFIELD_BIT(type)) > 0;
       uint64_t offset = changed ? bs->dd.db_offset : bs->dd.cur_db_offset[type];
-      if (pg->dd.db_template[type] && changed) {
+      if (pg->dd.db_template[type] && changed && find_db_set(ctx, pg, type, &offset)) {
+         bs->dd.cur_db_offset[type] = offset;
+      } else if (pg->dd.db_template[type] && changed) {
          const struct zink_descriptor_layout_key *key = pg->dd.pool_key[type]->layout;
          VkDescriptorGetInfoEXT info;
          info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
@@ -1565,6 +1650,8 @@ zink_batch_descriptor_deinit(struct zink_screen *screen, struct zink_batch_state
       bs->dd.db_bound = false;
       bs->dd.db_offset = 0;
       memset(bs->dd.cur_db_offset, 0, sizeof(bs->dd.cur_db_offset));
+      _mesa_hash_table_destroy(bs->dd.db_sets, NULL);
+      bs->dd.db_sets = NULL;
    }
 }
 
@@ -1595,6 +1682,8 @@ zink_batch_descriptor_reset(struct zink_screen *screen, struct zink_batch_state
    if (zink_descriptor_mode == ZINK_DESCRIPTOR_MODE_DB) {
       bs->dd.db_offset = 0;
       memset(bs->dd.cur_db_offset, 0, sizeof(bs->dd.cur_db_offset));
+      if (bs->dd.db_sets)
+         _mesa_hash_table_clear(bs->dd.db_sets, free_db_set_key);
       if (bs->dd.db && bs->ctx && bs->dd.db->base.b.width0 < bs->ctx->dd.db.max_db_size * screen->base_descriptor_size)
          reinit_db(screen, bs);
       bs->dd.db_bound = false;
@@ -1654,6 +1743,7 @@ zink_batch_descriptor_init(struct zink_screen *screen, struct zink_batch_state *
          return false;
       bs->dd.db = zink_resource(pres);
       bs->dd.db_map = pipe_buffer_map(&bs->ctx->base, pres, PIPE_MAP_READ | PIPE_MAP_WRITE | PIPE_MAP_PERSISTENT | PIPE_MAP_COHERENT | PIPE_MAP_THREAD_SAFE, &bs->dd.db_xfer);
+      bs->dd.db_sets = _mesa_hash_table_create(bs, hash_db_set_key, equals_db_set_key);
    }
    return true;
 }
@@ -967,8 +967,13 @@ zink_kopper_present_queue(struct zink_screen *screen, struct zink_resource *res,
       p_atomic_inc(&cpi->swapchain->async_presents);
       struct pipe_resource *pres = NULL;
       pipe_resource_reference(&pres, &res->base.b);
+      struct zink_batch_state *marker = NULL;
+      simple_mtx_lock(&screen->pending_submits_lock);
+      /* keep batches flushed after this present from being submitted with the ones before it */
+      util_dynarray_append(&screen->pending_submits, marker);
       util_queue_add_job(&screen->flush_queue, cpi, &cdt->swapchain->present_fence,
                          kopper_present, NULL, 0);
+      simple_mtx_unlock(&screen->pending_submits_lock);
    } else {
       if (screen->threaded_submit)
          util_queue_finish(&screen->flush_queue);
@@ -285,6 +285,13 @@ zink_get_gfx_pipeline(struct zink_context *ctx,
    }
 
    struct zink_gfx_pipeline_cache_entry *cache_entry = (struct zink_gfx_pipeline_cache_entry *)entry->data;
+   if (unlikely(!util_queue_fence_is_signalled(&cache_entry->fence))) {
+      /* drawing with the unoptimized pipeline: compile the optimized one before
+       * any pipelines that aren't being drawn with right now
+       */
+      ctx->hud.unoptimized_pipelines++;
+      util_queue_prioritize_job(&screen->cache_get_thread, &cache_entry->fence);
+   }
    if (IS_MESH)
       state->mesh_pipeline = cache_entry->pipeline;
    else
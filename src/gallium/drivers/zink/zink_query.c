@@ -14,6 +14,9 @@
 #define NOWAIT_CHECK_THRESHOLD 10 //prevent spinning
 
 #define ZINK_QUERY_RENDER_PASSES (PIPE_QUERY_DRIVER_SPECIFIC + 0)
+#define ZINK_QUERY_UNOPTIMIZED_PIPELINES (PIPE_QUERY_DRIVER_SPECIFIC + 1)
+#define ZINK_QUERY_SUBMITTED_BATCHES (PIPE_QUERY_DRIVER_SPECIFIC + 2)
+#define ZINK_QUERY_QUEUE_SUBMITS (PIPE_QUERY_DRIVER_SPECIFIC + 3)
 
 struct zink_query_pool {
    struct list_head list;
@@ -93,6 +96,9 @@ struct zink_query {
 
 static const struct pipe_driver_query_info zink_specific_queries[] = {
    {"render-passes", ZINK_QUERY_RENDER_PASSES, { 0 }},
+   {"unoptimized-pipelines", ZINK_QUERY_UNOPTIMIZED_PIPELINES, { 0 }},
+   {"submitted-batches", ZINK_QUERY_SUBMITTED_BATCHES, { 0 }},
+   {"queue-submits", ZINK_QUERY_QUEUE_SUBMITS, { 0 }},
 };
 
 static inline int
@@ -1143,6 +1149,22 @@ zink_get_query_result(struct pipe_context *pctx,
       return true;
    }
 
+   if (query->type == ZINK_QUERY_UNOPTIMIZED_PIPELINES) {
+      result->u64 = ctx->hud.unoptimized_pipelines;
+      ctx->hud.unoptimized_pipelines = 0;
+      return true;
+   }
+
+   if (query->type == ZINK_QUERY_SUBMITTED_BATCHES) {
+      result->u64 = p_atomic_xchg(&ctx->hud.submitted_batches, 0);
+      return true;
+   }
+
+   if (query->type == ZINK_QUERY_QUEUE_SUBMITS) {
+      result->u64 = p_atomic_xchg(&ctx->hud.queue_submits, 0);
+      return true;
+   }
+
    if (query->needs_update) {
       assert(!ctx->tc || !threaded_query(q)->flushed);
       update_qbo(ctx, query);
@@ -405,6 +405,16 @@ check_ici(struct zink_screen *screen, VkImageCreateInfo *ici, uint64_t modifier)
    return true;
 }
 
+/* whether the device has memory which is only backed once it's actually needed,
+ * which transient attachments may never need on tilers
+ */
+static bool
+have_lazy_memory(const struct zink_screen *screen)
+{
+   unsigned idx = screen->heap_map[ZINK_HEAP_DEVICE_LOCAL_LAZY][0];
+   return (screen->info.mem_props.memoryTypes[idx].propertyFlags & VK_LAZY_VRAM) == VK_LAZY_VRAM;
+}
+
 static VkImageUsageFlags
 get_image_usage_for_feats(struct zink_screen *screen, VkFormatFeatureFlags2 feats, const struct pipe_resource *templ, unsigned bind, bool *need_extended)
 {
@@ -412,8 +422,12 @@ get_image_usage_for_feats(struct zink_screen *screen, VkFormatFeatureFlags2 feat
    bool is_planar = util_format_get_num_planes(templ->format) > 1;
    *need_extended = false;
 
-   if (bind & ZINK_BIND_TRANSIENT)
-         return util_format_is_depth_or_stencil(templ->format) ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+   if (bind & ZINK_BIND_TRANSIENT) {
+      usage = util_format_is_depth_or_stencil(templ->format) ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+      if (have_lazy_memory(screen))
+         usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+      return usage;
+   }
 
    /* sadly, gallium doesn't let us know if it'll ever need this, so we have to assume */
    if (is_planar || (feats & VK_FORMAT_FEATURE_TRANSFER_SRC_BIT))
@@ -1050,6 +1064,7 @@ allocate_bo(struct zink_screen *screen, const struct pipe_resource *templ,
       /* not valid based on reqs; demote to more compatible type */
       switch (heap) {
       case ZINK_HEAP_DEVICE_LOCAL_VISIBLE:
+      case ZINK_HEAP_DEVICE_LOCAL_LAZY:
          heap = ZINK_HEAP_DEVICE_LOCAL;
          break;
       case ZINK_HEAP_HOST_VISIBLE_COHERENT_CACHED:
@@ -1068,7 +1083,9 @@ allocate_bo(struct zink_screen *screen, const struct pipe_resource *templ,
             continue;
 
          mai.memoryTypeIndex = screen->heap_map[heap][i];
-         obj->bo = zink_bo(zink_bo_create(screen, reqs->size, alignment, heap, mai.pNext ? ZINK_ALLOC_NO_SUBALLOC : 0, mai.memoryTypeIndex, mai.pNext));
+         /* lazy memory is committed per allocation: don't share it with other resources */
+         bool no_suballoc = mai.pNext || heap == ZINK_HEAP_DEVICE_LOCAL_LAZY;
+         obj->bo = zink_bo(zink_bo_create(screen, reqs->size, alignment, heap, no_suballoc ? ZINK_ALLOC_NO_SUBALLOC : 0, mai.memoryTypeIndex, mai.pNext));
       }
 
       if (obj->bo || heap != ZINK_HEAP_DEVICE_LOCAL_VISIBLE)
@@ -1444,6 +1461,8 @@ create_image(struct zink_screen *screen, struct zink_resource_object *obj,
    alloc_info->need_dedicated = get_image_memory_requirement(screen, obj, num_planes, &reqs);
    if (templ->usage == PIPE_USAGE_STAGING && ici.tiling == VK_IMAGE_TILING_LINEAR)
       alloc_info->flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+   else if (ici.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+      alloc_info->flags = VK_LAZY_VRAM;
    else
       alloc_info->flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
@@ -544,6 +544,8 @@ struct zink_batch_descriptor_data {
    uint8_t *db_map; //the host map for the buffer
    struct pipe_transfer *db_xfer; //the transfer map for the buffer
    uint64_t db_offset; //the "next" offset that will be used when the buffer is updated
+   /* zink_db_set_key -> the sets written to the current descriptor buffer, for reuse */
+   struct hash_table *db_sets;
 };
 
 /** batch types */
@@ -1382,6 +1384,9 @@ struct zink_screen {
    VkSemaphore sem;
    VkFence fence;
    struct util_queue flush_queue;
+   /* batches (and NULL for presents) in the order their jobs were added to flush_queue */
+   simple_mtx_t pending_submits_lock;
+   struct util_dynarray pending_submits;
    simple_mtx_t copy_context_lock;
    struct zink_context *copy_context;
 
@@ -1883,6 +1888,11 @@ struct zink_context {
    } render_condition;
    struct {
       uint64_t render_passes;
+      /* pipeline lookups returning a pipeline whose optimized compile is pending */
+      uint64_t unoptimized_pipelines;
+      /* these are updated from the flush thread */
+      uint64_t submitted_batches;
+      uint64_t queue_submits;
    } hud;
 
    struct pipe_resource *dummy_xfb_buffer;
@@ -225,12 +225,61 @@ lvp_enqueue_encode_as(VkCommandBuffer commandBuffer, const struct vk_acceleratio
    list_addtail(&entry->cmd_link, &cmd_buffer->vk.cmd_queue.cmds);
 }
 
+static void
+lvp_enqueue_update_as(VkCommandBuffer commandBuffer, const struct vk_acceleration_structure_build_state *state)
+{
+   VK_FROM_HANDLE(lvp_cmd_buffer, cmd_buffer, commandBuffer);
+   VK_FROM_HANDLE(vk_acceleration_structure, src, state->build_info->srcAccelerationStructure);
+   VK_FROM_HANDLE(vk_acceleration_structure, dst, state->build_info->dstAccelerationStructure);
+
+   struct vk_cmd_queue_entry *entry =
+      vk_zalloc(cmd_buffer->vk.cmd_queue.alloc, sizeof(struct vk_cmd_queue_entry),
+                8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+   if (!entry)
+      return;
+
+   entry->type = LVP_CMD_UPDATE_AS;
+
+   struct lvp_cmd_update_as *cmd =
+      vk_zalloc(cmd_buffer->vk.cmd_queue.alloc, sizeof(struct lvp_cmd_update_as),
+                8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+   if (!cmd) {
+      vk_free(cmd_buffer->vk.cmd_queue.alloc, entry);
+      return;
+   }
+
+   cmd->src = src;
+   cmd->dst = dst;
+   cmd->intermediate_as_addr = state->build_info->scratchData.deviceAddress + state->scratch.ir_offset;
+   cmd->leaf_count = state->leaf_node_count;
+   cmd->geometry_type = vk_get_as_geometry_type(state->build_info);
+
+   entry->driver_data = cmd;
+
+   list_addtail(&entry->cmd_link, &cmd_buffer->vk.cmd_queue.cmds);
+}
+
 static uint32_t
 ir_id_to_offset(uint32_t id)
 {
    return id & (~3u);
 }
 
+/* Increase the bounding box size a bit for watertightness. */
+static void
+lvp_expand_aabb(vk_aabb *aabb)
+{
+   if (aabb->min.x > aabb->max.x)
+      return;
+
+   aabb->min.x -= MAX2(fabsf(aabb->min.x), 1.0) * FLT_EPSILON;
+   aabb->min.y -= MAX2(fabsf(aabb->min.y), 1.0) * FLT_EPSILON;
+   aabb->min.z -= MAX2(fabsf(aabb->min.z), 1.0) * FLT_EPSILON;
+   aabb->max.x += MAX2(fabsf(aabb->max.x), 1.0) * FLT_EPSILON;
+   aabb->max.y += MAX2(fabsf(aabb->max.y), 1.0) * FLT_EPSILON;
+   aabb->max.z += MAX2(fabsf(aabb->max.z), 1.0) * FLT_EPSILON;
+}
+
 static uint32_t
 lvp_pack_sbt_offset_and_flags(uint32_t sbt_offset, VkGeometryInstanceFlagsKHR flags)
 {
@@ -534,13 +583,7 @@ lvp_encode_as(struct vk_acceleration_structure *dst, VkDeviceAddress intermediat
          const struct vk_ir_node *ir_child = (const void *)(ir_bvh + ir_child_offset);
 
          output_box->bounds[child_index] = ir_child->aabb;
-         /* Increase the bounding box size a bit for watertightness. */
-         output_box->bounds[child_index].min.x -= MAX2(fabsf(output_box->bounds[child_index].min.x), 1.0) * FLT_EPSILON;
-         output_box->bounds[child_index].min.y -= MAX2(fabsf(output_box->bounds[child_index].min.y), 1.0) * FLT_EPSILON;
-         output_box->bounds[child_index].min.z -= MAX2(fabsf(output_box->bounds[child_index].min.z), 1.0) * FLT_EPSILON;
-         output_box->bounds[child_index].max.x += MAX2(fabsf(output_box->bounds[child_index].max.x), 1.0) * FLT_EPSILON;
-         output_box->bounds[child_index].max.y += MAX2(fabsf(output_box->bounds[child_index].max.y), 1.0) * FLT_EPSILON;
-         output_box->bounds[child_index].max.z += MAX2(fabsf(output_box->bounds[child_index].max.z), 1.0) * FLT_EPSILON;
+         lvp_expand_aabb(&output_box->bounds[child_index]);
 
          if (ir_child_offset < root_offset) {
             output_box->children[child_index] =
@@ -580,6 +623,123 @@ lvp_encode_as(struct vk_acceleration_structure *dst, VkDeviceAddress intermediat
    free(node_depth);
 }
 
+static void
+lvp_aabb_union(vk_aabb *dst, const vk_aabb *src)
+{
+   dst->min.x = MIN2(dst->min.x, src->min.x);
+   dst->min.y = MIN2(dst->min.y, src->min.y);
+   dst->min.z = MIN2(dst->min.z, src->min.z);
+   dst->max.x = MAX2(dst->max.x, src->max.x);
+   dst->max.y = MAX2(dst->max.y, src->max.y);
+   dst->max.z = MAX2(dst->max.z, src->max.z);
+}
+
+static const vk_aabb lvp_empty_aabb = {
+   .min = {INFINITY, INFINITY, INFINITY},
+   .max = {-INFINITY, -INFINITY, -INFINITY},
+};
+
+/* Recomputes the child bounds of a box node from its leaves, returns the bounds of the node. */
+static vk_aabb
+lvp_refit_node(uint8_t *output, uint32_t node_id)
+{
+   struct lvp_bvh_box_node *node = (void *)(output + ir_id_to_offset(node_id));
+   vk_aabb bounds = lvp_empty_aabb;
+
+   for (uint32_t child_index = 0; child_index < 2; child_index++) {
+      uint32_t child = node->children[child_index];
+      if (child == LVP_BVH_INVALID_NODE)
+         continue;
+
+      const void *child_node = output + ir_id_to_offset(child);
+      vk_aabb child_bounds = lvp_empty_aabb;
+
+      switch (child & 3) {
+      case lvp_bvh_node_internal:
+         child_bounds = lvp_refit_node(output, child);
+         break;
+      case lvp_bvh_node_triangle: {
+         const struct lvp_bvh_triangle_node *triangle = child_node;
+         /* Inactive triangles don't contribute to the bounds. */
+         if (isnan(triangle->coords[0][0]) || isnan(triangle->coords[1][0]) || isnan(triangle->coords[2][0]))
+            break;
+         for (uint32_t i = 0; i < 3; i++) {
+            vk_aabb vertex = {
+               .min = {triangle->coords[i][0], triangle->coords[i][1], triangle->coords[i][2]},
+               .max = {triangle->coords[i][0], triangle->coords[i][1], triangle->coords[i][2]},
+            };
+            lvp_aabb_union(&child_bounds, &vertex);
+         }
+         lvp_expand_aabb(&child_bounds);
+         break;
+      }
+      case lvp_bvh_node_aabb: {
+         const struct lvp_bvh_aabb_node *aabb = child_node;
+         if (isnan(aabb->bounds.min.x))
+            break;
+         child_bounds = aabb->bounds;
+         lvp_expand_aabb(&child_bounds);
+         break;
+      }
+      default:
+         /* Updates are only supported for bottom level acceleration structures. */
+         UNREACHABLE("Unexpected node type");
+      }
+
+      node->bounds[child_index] = child_bounds;
+      lvp_aabb_union(&bounds, &child_bounds);
+   }
+
+   return bounds;
+}
+
+/* Refits a BVH built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR to new leaves.
+ * The topology (including the flattening done at build time) is kept, only the leaves and the
+ * bounds of the box nodes are rewritten.
+ */
+void
+lvp_update_as(struct vk_acceleration_structure *src, struct vk_acceleration_structure *dst,
+              VkDeviceAddress intermediate_as_addr, uint32_t leaf_count,
+              VkGeometryTypeKHR geometry_type)
+{
+   const uint8_t *ir_bvh = (const void *)(uintptr_t)intermediate_as_addr;
+   uint8_t *output = (void *)(uintptr_t)vk_acceleration_structure_get_va(dst);
+
+   if (src && src != dst) {
+      const void *input = (const void *)(uintptr_t)vk_acceleration_structure_get_va(src);
+      memcpy(output, input, lvp_get_as_size_internal(geometry_type, leaf_count));
+   }
+
+   struct lvp_bvh_header *output_header = (void *)output;
+
+   uint32_t ir_leaf_node_size = 0;
+   uint32_t output_leaf_node_size = 0;
+   lvp_get_leaf_node_size(geometry_type, &ir_leaf_node_size, &output_leaf_node_size);
+
+   for (uint32_t i = 0; i < leaf_count; i++) {
+      const void *ir_leaf = ir_bvh + i * ir_leaf_node_size;
+      void *output_leaf = output + output_header->leaf_nodes_offset + i * output_leaf_node_size;
+      switch (geometry_type) {
+      case VK_GEOMETRY_TYPE_TRIANGLES_KHR: {
+         const struct vk_ir_triangle_node *ir_triangle = ir_leaf;
+         struct lvp_bvh_triangle_node *output_triangle = output_leaf;
+         memcpy(output_triangle->coords, ir_triangle->coords, sizeof(output_triangle->coords));
+         break;
+      }
+      case VK_GEOMETRY_TYPE_AABBS_KHR: {
+         const struct vk_ir_aabb_node *ir_aabb = ir_leaf;
+         struct lvp_bvh_aabb_node *output_aabb = output_leaf;
+         output_aabb->bounds = ir_aabb->base.aabb;
+         break;
+      }
+      default:
+         break;
+      }
+   }
+
+   output_header->bounds = lvp_refit_node(output, LVP_BVH_ROOT_NODE);
+}
+
 static_assert(sizeof(struct lvp_bvh_triangle_node) % 8 == 0, "lvp_bvh_triangle_node is not padded");
 static_assert(sizeof(struct lvp_bvh_aabb_node) % 8 == 0, "lvp_bvh_aabb_node is not padded");
 static_assert(sizeof(struct lvp_bvh_instance_node) % 8 == 0, "lvp_bvh_instance_node is not padded");
@@ -661,10 +821,19 @@ lvp_encode_bind_pipeline(VkCommandBuffer cmd_buffer, const struct vk_acceleratio
    return VK_SUCCESS;
 }
 
+static void
+lvp_update_bind_pipeline(VkCommandBuffer cmd_buffer, const struct vk_acceleration_structure_build_state *state,
+                         bool flushed_cp_after_init_update_scratch, bool flushed_compute_after_init_update_scratch)
+{
+}
+
 const struct vk_acceleration_structure_build_ops accel_struct_ops = {
    .get_as_size = lvp_get_as_size,
    .encode_bind_pipeline[0] = lvp_encode_bind_pipeline,
    .encode_as[0] = lvp_enqueue_encode_as,
+   .update_bind_pipeline[0] = lvp_update_bind_pipeline,
+   .update_as[0] = lvp_enqueue_update_as,
+   .update_from_ir_leaves = true,
 };
 
 VkResult
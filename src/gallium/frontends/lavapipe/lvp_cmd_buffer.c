@@ -55,6 +55,9 @@ lvp_create_cmd_buffer(struct vk_command_pool *pool,
       return result;
    }
 
+   /* Commands get walked again on every submission, keep them together. */
+   vk_cmd_queue_init_linear(&cmd_buffer->vk.cmd_queue);
+
    *cmd_buffer_out = &cmd_buffer->vk;
 
    return VK_SUCCESS;
@@ -62,9 +65,12 @@ lvp_create_cmd_buffer(struct vk_command_pool *pool,
 
 static void
 lvp_reset_cmd_buffer(struct vk_command_buffer *vk_cmd_buffer,
-                     UNUSED VkCommandBufferResetFlags flags)
+                     VkCommandBufferResetFlags flags)
 {
    vk_command_buffer_reset(vk_cmd_buffer);
+
+   if (flags & VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT)
+      vk_cmd_queue_free_linear(&vk_cmd_buffer->cmd_queue, false);
 }
 
 const struct vk_command_buffer_ops lvp_cmd_buffer_ops = {
@@ -4765,6 +4765,17 @@ handle_encode_as(struct vk_cmd_queue_entry *cmd, struct rendering_state *state)
                  encode->geometry_type);
 }
 
+static void
+handle_update_as(struct vk_cmd_queue_entry *cmd, struct rendering_state *state)
+{
+   struct lvp_cmd_update_as *update = cmd->driver_data;
+
+   finish_fence(state);
+
+   lvp_update_as(update->src, update->dst, update->intermediate_as_addr,
+                 update->leaf_count, update->geometry_type);
+}
+
 static void
 handle_save_state(struct vk_cmd_queue_entry *cmd, struct rendering_state *state)
 {
@@ -4966,6 +4977,8 @@ static void lvp_execute_cmd_buffer(struct list_head *cmds,
             handle_fill_buffer_addr(cmd, state);
          } else if (type == LVP_CMD_ENCODE_AS) {
             handle_encode_as(cmd, state);
+         } else if (type == LVP_CMD_UPDATE_AS) {
+            handle_update_as(cmd, state);
          } else if (type == LVP_CMD_SAVE_STATE) {
             handle_save_state(cmd, state);
          } else if (type == LVP_CMD_RESTORE_STATE) {
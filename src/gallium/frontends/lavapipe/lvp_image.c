@@ -781,18 +781,17 @@ lvp_CopyMemoryToImageEXT(VkDevice _device, const VkCopyMemoryToImageInfoEXT *pCo
          break;
       }
 
-      unsigned stride = util_format_get_stride(image->planes[plane].bo->format, copy->memoryRowLength ? copy->memoryRowLength : box.width);
-      unsigned layer_stride = util_format_get_2d_size(image->planes[plane].bo->format, stride, copy->memoryImageHeight ? copy->memoryImageHeight : box.height);
+      /* The image can't be in use by the device during host copies, so write
+       * straight into its storage without syncing with the queue context.
+       */
+      struct pipe_transfer *xfer;
+      uint8_t *dst_data = device->queue.ctx->texture_map(device->queue.ctx, image->planes[plane].bo, copy->imageSubresource.mipLevel,
+                                                         PIPE_MAP_WRITE | PIPE_MAP_UNSYNCHRONIZED | PIPE_MAP_THREAD_SAFE, &box, &xfer);
+      if (!dst_data)
+         return VK_ERROR_MEMORY_MAP_FAILED;
+
       if (vk_format_is_depth_or_stencil(image->vk.format) && image->vk.aspects != aspects) {
-         struct pipe_transfer *xfer;
          const uint8_t *src_data = copy->pHostPointer;
-         uint8_t *dst_data = device->queue.ctx->texture_map(device->queue.ctx,
-                                                      image->planes[plane].bo,
-                                                      copy->imageSubresource.mipLevel,
-                                                      0,
-                                                      &box,
-                                                      &xfer);
-
          enum pipe_format dst_format = image->planes[plane].bo->format;
          enum pipe_format src_format = aspects == VK_IMAGE_ASPECT_DEPTH_BIT ? util_format_get_depth_only(dst_format) : PIPE_FORMAT_S8_UINT;
          const struct vk_image_buffer_layout buffer_layout = vk_memory_to_image_copy_layout(&image->vk, copy);
@@ -804,11 +803,14 @@ lvp_CopyMemoryToImageEXT(VkDevice _device, const VkCopyMemoryToImageInfoEXT *pCo
                         copy->imageExtent.height,
                         box.depth,
                         src_data, src_format, buffer_layout.row_stride_B, buffer_layout.image_stride_B, 0, 0, 0);
-         pipe_texture_unmap(device->queue.ctx, xfer);
       } else {
-         device->queue.ctx->texture_subdata(device->queue.ctx, image->planes[plane].bo, copy->imageSubresource.mipLevel, 0,
-                                          &box, copy->pHostPointer, stride, layer_stride);
+         unsigned stride = util_format_get_stride(image->planes[plane].bo->format, copy->memoryRowLength ? copy->memoryRowLength : box.width);
+         unsigned layer_stride = util_format_get_2d_size(image->planes[plane].bo->format, stride, copy->memoryImageHeight ? copy->memoryImageHeight : box.height);
+         util_copy_box(dst_data, image->planes[plane].bo->format, xfer->stride, xfer->layer_stride,
+                       /* offsets are all zero because texture_map handles the offset */
+                       0, 0, 0, box.width, box.height, box.depth, copy->pHostPointer, stride, layer_stride, 0, 0, 0);
       }
+      pipe_texture_unmap(device->queue.ctx, xfer);
    }
    return VK_SUCCESS;
 }
@@ -27,6 +27,7 @@
 #include "vk_render_pass.h"
 #include "vk_util.h"
 #include "glsl_types.h"
+#include "util/disk_cache.h"
 #include "util/os_time.h"
 #include "spirv/nir_spirv.h"
 #include "nir/nir_builder.h"
@@ -449,20 +450,138 @@ lvp_shader_lower(struct lvp_device *pdevice, nir_shader *nir, struct lvp_pipelin
       NIR_PASS(_, nir, lvp_nir_opt_robustness, pdevice, robustness);
 }
 
+static void
+lvp_hash_pipeline_layout(struct mesa_sha1 *ctx, const struct lvp_pipeline_layout *layout)
+{
+   if (!layout)
+      return;
+
+   _mesa_sha1_update(ctx, &layout->vk.set_count, sizeof(layout->vk.set_count));
+   for (uint32_t s = 0; s < layout->vk.set_count; s++) {
+      if (!layout->vk.set_layouts[s]) {
+         const uint32_t no_set = UINT32_MAX;
+         _mesa_sha1_update(ctx, &no_set, sizeof(no_set));
+         continue;
+      }
+
+      const struct lvp_descriptor_set_layout *set_layout = get_set_layout(layout, s);
+      _mesa_sha1_update(ctx, &set_layout->binding_count, sizeof(set_layout->binding_count));
+
+      for (uint32_t b = 0; b < set_layout->binding_count; b++) {
+         const struct lvp_descriptor_set_binding_layout *binding = &set_layout->binding[b];
+         const uint32_t data[] = {
+            binding->descriptor_index,
+            binding->type,
+            binding->stride,
+            binding->array_size,
+            binding->valid,
+            binding->dynamic_index,
+            binding->uniform_block_offset,
+            binding->uniform_block_size,
+         };
+         _mesa_sha1_update(ctx, data, sizeof(data));
+
+         /* YCbCr conversions of immutable samplers are baked into the shader. */
+         for (uint32_t i = 0; binding->immutable_samplers && i < binding->array_size; i++) {
+            const struct vk_ycbcr_conversion *conversion =
+               binding->immutable_samplers[i]->vk.ycbcr_conversion;
+            if (conversion)
+               _mesa_sha1_update(ctx, &conversion->state, sizeof(conversion->state));
+         }
+      }
+   }
+}
+
+/* Key for the lowered NIR of a stage in the screen's shader disk cache.
+ * disk_cache_compute_key() mixes in the driver build and CPU features.
+ */
+static void
+lvp_shader_cache_key(struct lvp_pipeline *pipeline, struct disk_cache *disk_cache,
+                     const VkPipelineShaderStageCreateInfo *sinfo,
+                     const struct vk_pipeline_robustness_state *robustness,
+                     cache_key key)
+{
+   static const char tag[] = "lvp_nir";
+   unsigned char stage_sha1[SHA1_DIGEST_LENGTH];
+   unsigned char sha1[SHA1_DIGEST_LENGTH];
+   struct mesa_sha1 ctx;
+
+   vk_pipeline_hash_shader_stage(pipeline->flags, sinfo, robustness, stage_sha1);
+
+   _mesa_sha1_init(&ctx);
+   _mesa_sha1_update(&ctx, tag, sizeof(tag));
+   _mesa_sha1_update(&ctx, stage_sha1, sizeof(stage_sha1));
+   lvp_hash_pipeline_layout(&ctx, pipeline->layout);
+   _mesa_sha1_final(&ctx, sha1);
+
+   disk_cache_compute_key(disk_cache, sha1, sizeof(sha1), key);
+}
+
+static struct disk_cache *
+lvp_pipeline_disk_cache(struct lvp_pipeline *pipeline)
+{
+   struct lvp_device *device = lvp_pipeline_device(pipeline);
+   struct pipe_screen *pscreen = lvp_device_physical(device)->pscreen;
+
+   /* Execution graph lowering depends on the other nodes of the graph and
+    * debug info isn't part of the key, so don't cache those.
+    */
+   if (pipeline->type == LVP_PIPELINE_EXEC_GRAPH ||
+       (gallivm_debug & GALLIVM_DEBUG_SYMBOLS) ||
+       !pscreen->get_disk_shader_cache)
+      return NULL;
+
+   return pscreen->get_disk_shader_cache(pscreen);
+}
+
 VkResult
 lvp_spirv_to_nir(struct lvp_pipeline *pipeline, const void *pipeline_pNext,
                  const VkPipelineShaderStageCreateInfo *sinfo, nir_shader **out_nir)
 {
    struct lvp_device *device = lvp_pipeline_device(pipeline);
+   struct disk_cache *disk_cache = lvp_pipeline_disk_cache(pipeline);
+
+   struct vk_pipeline_robustness_state robustness;
+   vk_pipeline_robustness_state_fill(&device->vk, &robustness, pipeline_pNext, sinfo->pNext);
+
+   /* Skip SPIR-V parsing and the whole lowering/optimization sequence when
+    * another process already did it for this stage.  The llvmpipe shader
+    * variants compiled from the result hit the machine code cache in turn.
+    */
+   cache_key key;
+   if (disk_cache) {
+      lvp_shader_cache_key(pipeline, disk_cache, sinfo, &robustness, key);
+
+      size_t size;
+      void *data = disk_cache_get(disk_cache, key, &size);
+      if (data) {
+         mesa_shader_stage stage = vk_to_mesa_shader_stage(sinfo->stage);
+         struct blob_reader reader;
+         blob_reader_init(&reader, data, size);
+         *out_nir = nir_deserialize(NULL, lvp_device_physical(device)->drv_options[stage],
+                                    &reader);
+         free(data);
+         if (*out_nir && !reader.overrun)
+            return VK_SUCCESS;
+         ralloc_free(*out_nir);
+      }
+   }
+
    VkResult result = compile_spirv(device, pipeline->flags, sinfo, out_nir);
    if (result == VK_SUCCESS) {
       if (pipeline->type == LVP_PIPELINE_EXEC_GRAPH)
          lvp_lower_exec_graph(pipeline, *out_nir);
 
-      struct vk_pipeline_robustness_state robustness;
-      vk_pipeline_robustness_state_fill(&device->vk, &robustness, pipeline_pNext, sinfo->pNext);
-
       lvp_shader_lower(device, *out_nir, pipeline->layout, &robustness);
+
+      if (disk_cache) {
+         struct blob blob;
+         blob_init(&blob);
+         nir_serialize(&blob, *out_nir, false);
+         if (!blob.out_of_memory)
+            disk_cache_put(disk_cache, key, blob.data, blob.size, NULL);
+         blob_finish(&blob);
+      }
    }
 
    return result;
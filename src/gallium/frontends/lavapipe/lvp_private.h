@@ -839,11 +839,25 @@ struct lvp_cmd_encode_as {
    VkGeometryTypeKHR geometry_type;
 };
 
+void
+lvp_update_as(struct vk_acceleration_structure *src, struct vk_acceleration_structure *dst,
+              VkDeviceAddress intermediate_as_addr, uint32_t leaf_count,
+              VkGeometryTypeKHR geometry_type);
+
+struct lvp_cmd_update_as {
+   struct vk_acceleration_structure *src;
+   struct vk_acceleration_structure *dst;
+   VkDeviceAddress intermediate_as_addr;
+   uint32_t leaf_count;
+   VkGeometryTypeKHR geometry_type;
+};
+
 enum {
    LVP_CMD_WRITE_BUFFER_CP = VK_CMD_TYPE_COUNT,
    LVP_CMD_DISPATCH_UNALIGNED,
    LVP_CMD_FILL_BUFFER_ADDR,
    LVP_CMD_ENCODE_AS,
+   LVP_CMD_UPDATE_AS,
    LVP_CMD_SAVE_STATE,
    LVP_CMD_RESTORE_STATE,
 };
@@ -851,6 +865,7 @@ enum {
 #define LVP_CMD_DISPATCH_UNALIGNED ((enum vk_cmd_type)LVP_CMD_DISPATCH_UNALIGNED)
 #define LVP_CMD_FILL_BUFFER_ADDR ((enum vk_cmd_type)LVP_CMD_FILL_BUFFER_ADDR)
 #define LVP_CMD_ENCODE_AS ((enum vk_cmd_type)LVP_CMD_ENCODE_AS)
+#define LVP_CMD_UPDATE_AS ((enum vk_cmd_type)LVP_CMD_UPDATE_AS)
 #define LVP_CMD_SAVE_STATE ((enum vk_cmd_type)LVP_CMD_SAVE_STATE)
 #define LVP_CMD_RESTORE_STATE ((enum vk_cmd_type)LVP_CMD_RESTORE_STATE)
 
@@ -174,6 +174,19 @@ impl Context {
             }
 
             if resource.is_none() {
+                // If the driver couldn't import the user memory we end up with a shadow buffer
+                // which gets synced on every map and unmap. On devices sharing memory with the
+                // host, make it a persistently mapped staging buffer so those copies stay cheap.
+                let res_type = if !user_ptr.is_null()
+                    && !copy
+                    && res_type == ResourceType::Normal
+                    && dev.unified_memory()
+                {
+                    ResourceType::Staging
+                } else {
+                    res_type
+                };
+
                 resource = dev.screen().resource_create_buffer(
                     adj_size,
                     res_type,
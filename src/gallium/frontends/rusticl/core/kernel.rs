@@ -36,6 +36,8 @@ use std::ops::Not;
 use std::os::raw::c_void;
 use std::ptr;
 use std::slice;
+use std::sync::atomic::AtomicU32;
+use std::sync::atomic::Ordering;
 use std::sync::Arc;
 use std::sync::OnceLock;
 use std::sync::Weak;
@@ -1216,6 +1218,10 @@ impl SPIRVToNirResult {
     }
 }
 
+// Only counted with RUSTICL_DEBUG=cache.
+static KERNEL_CACHE_HITS: AtomicU32 = AtomicU32::new(0);
+static KERNEL_CACHE_MISSES: AtomicU32 = AtomicU32::new(0);
+
 pub(super) fn convert_spirv_to_nir(
     build: &DeviceProgramBuild,
     name: &str,
@@ -1227,46 +1233,64 @@ pub(super) fn convert_spirv_to_nir(
     let key = build.hash_key(cache.as_ref(), name, spec_constants);
     let spirv_info = build.kernel_info(name).unwrap();
 
-    cache
+    let cached = cache
         .as_ref()
         .and_then(|cache| cache.get(&mut key?))
-        .and_then(|entry| SPIRVToNirResult::deserialize(&entry, dev, spirv_info))
-        .unwrap_or_else(|| {
-            let nir = build.to_nir(name, dev, spec_constants);
+        .and_then(|entry| SPIRVToNirResult::deserialize(&entry, dev, spirv_info));
 
-            if Platform::dbg().nir {
-                eprintln!("=== Printing nir for '{name}' after spirv_to_nir");
-                nir.print();
-            }
+    if cache.is_some() && Platform::dbg().cache {
+        let counter = if cached.is_some() {
+            &KERNEL_CACHE_HITS
+        } else {
+            &KERNEL_CACHE_MISSES
+        };
+        counter.fetch_add(1, Ordering::Relaxed);
+
+        let hits = KERNEL_CACHE_HITS.load(Ordering::Relaxed);
+        let lookups = hits + KERNEL_CACHE_MISSES.load(Ordering::Relaxed);
+        eprintln!(
+            "kernel cache {} for '{name}' on {}: {hits}/{lookups} hits so far",
+            if cached.is_some() { "hit" } else { "miss" },
+            dev.screen().name().to_string_lossy(),
+        );
+    }
 
-            let (mut args, nir) = compile_nir_to_args(dev, nir, args, &dev.lib_clc);
-            let (default_build, optimized) = compile_nir_remaining(dev, nir, &args, name);
+    cached.unwrap_or_else(|| {
+        let nir = build.to_nir(name, dev, spec_constants);
 
-            for build in [Some(&default_build), optimized.as_ref()].into_iter() {
-                let Some(build) = build else {
-                    continue;
-                };
+        if Platform::dbg().nir {
+            eprintln!("=== Printing nir for '{name}' after spirv_to_nir");
+            nir.print();
+        }
 
-                for arg in &build.compiled_args {
-                    if let CompiledKernelArgType::APIArg(idx) = arg.kind {
-                        args[idx].dead &= arg.dead;
-                    }
+        let (mut args, nir) = compile_nir_to_args(dev, nir, args, &dev.lib_clc);
+        let (default_build, optimized) = compile_nir_remaining(dev, nir, &args, name);
+
+        for build in [Some(&default_build), optimized.as_ref()].into_iter() {
+            let Some(build) = build else {
+                continue;
+            };
+
+            for arg in &build.compiled_args {
+                if let CompiledKernelArgType::APIArg(idx) = arg.kind {
+                    args[idx].dead &= arg.dead;
                 }
             }
+        }
 
-            if let Some(cache) = cache {
-                let mut blob = blob::default();
-                unsafe {
-                    blob_init(&mut blob);
-                    SPIRVToNirResult::serialize(&mut blob, &args, &default_build, &optimized);
-                    let bin = slice::from_raw_parts(blob.data, blob.size);
-                    cache.put(bin, &mut key.unwrap());
-                    blob_finish(&mut blob);
-                }
+        if let Some(cache) = cache {
+            let mut blob = blob::default();
+            unsafe {
+                blob_init(&mut blob);
+                SPIRVToNirResult::serialize(&mut blob, &args, &default_build, &optimized);
+                let bin = slice::from_raw_parts(blob.data, blob.size);
+                cache.put(bin, &mut key.unwrap());
+                blob_finish(&mut blob);
             }
+        }
 
-            SPIRVToNirResult::new(dev, spirv_info, args, default_build, optimized)
-        })
+        SPIRVToNirResult::new(dev, spirv_info, args, default_build, optimized)
+    })
 }
 
 fn extract<'a, const S: usize>(buf: &'a mut &[u8]) -> &'a [u8; S] {
@@ -1516,15 +1540,16 @@ impl Kernel {
         grid: &[usize],
         offsets: &[usize],
     ) -> CLResult<EventSig> {
-        // Clone all the data we need to execute this kernel
-        let work_group_size_hint = self.kernel_info.work_group_size_hint;
-        let args = self.kernel_info.args.clone();
+        // Clone all the data we need to execute this kernel. The argument layout is immutable
+        // once the kernel got created, so share it instead of copying it on every launch.
+        let kernel_info = Arc::clone(&self.kernel_info);
+        let work_group_size_hint = kernel_info.work_group_size_hint;
         let arg_values = self.values.clone();
         let nir_kernel_builds = Arc::clone(&self.builds[q.device]);
         let mut bdas = self.bdas.clone();
         let svms = self.svms.clone();
 
-        let mut buffer_arcs = HashMap::new();
+        let mut buffer_arcs = HashMap::with_capacity(arg_values.len());
         let mut image_arcs = HashMap::new();
 
         // need to preprocess buffer and image arguments so we hold a strong reference until the
@@ -1619,7 +1644,7 @@ impl Kernel {
 
             for arg in &nir_kernel_build.compiled_args {
                 let is_opaque = if let CompiledKernelArgType::APIArg(idx) = arg.kind {
-                    args[idx].kind.is_opaque()
+                    kernel_info.args[idx].kind.is_opaque()
                 } else {
                     false
                 };
@@ -1630,7 +1655,7 @@ impl Kernel {
 
                 match arg.kind {
                     CompiledKernelArgType::APIArg(idx) => {
-                        let api_arg = &args[idx];
+                        let api_arg = &kernel_info.args[idx];
                         let Some(value) = &arg_values[idx] else {
                             continue;
                         };
@@ -59,6 +59,7 @@ pub enum PerfDebugLevel {
 
 pub struct PlatformDebug {
     pub allow_invalid_spirv: bool,
+    pub cache: bool,
     pub clc: bool,
     pub max_grid_size: u32,
     pub memory: bool,
@@ -89,6 +90,7 @@ static mut PLATFORM: Platform = Platform {
 };
 static mut PLATFORM_DBG: PlatformDebug = PlatformDebug {
     allow_invalid_spirv: false,
+    cache: false,
     clc: false,
     max_grid_size: 0,
     memory: false,
@@ -112,6 +114,7 @@ fn load_env() {
         for flag in debug_flags.split(',') {
             match flag {
                 "allow_invalid_spirv" => debug.allow_invalid_spirv = true,
+                "cache" => debug.cache = true,
                 "clc" => debug.clc = true,
                 "memory" => debug.memory = true,
                 "nir" => debug.nir = true,
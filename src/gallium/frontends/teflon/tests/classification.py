@@ -54,6 +54,9 @@ if __name__ == '__main__':
       help='input standard deviation')
   parser.add_argument(
       '--num_threads', default=None, type=int, help='number of threads')
+  parser.add_argument(
+      '-n', '--num_iterations', default=4, type=int,
+      help='number of timed inferences')
   parser.add_argument(
       '-e', '--ext_delegate', help='external_delegate_library path')
   parser.add_argument(
@@ -114,7 +117,7 @@ if __name__ == '__main__':
 
   interpreter.invoke()
 
-  num_iterations = 4
+  num_iterations = args.num_iterations
 
   start_time = time.time()
   for i in range(0, num_iterations):
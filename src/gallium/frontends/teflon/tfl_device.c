@@ -9,6 +9,7 @@
 #include "pipe/p_state.h"
 #include "util/format/u_format.h"
 #include "util/macros.h"
+#include "util/os_time.h"
 #include "util/u_inlines.h"
 
 #include "tensorflow/lite/builtin_ops.h"
@@ -21,10 +22,12 @@ static bool fused_relu6_supported(TfLiteTensor *tensor);
 
 enum teflon_debug_flags {
    TEFLON_DEBUG_VERBOSE = 1 << 1,
+   TEFLON_DEBUG_STATS = 1 << 2,
 };
 
 static const struct debug_named_value teflon_debug_flags[] = {
    {"verbose", TEFLON_DEBUG_VERBOSE, "Verbose logging."},
+   {"stats", TEFLON_DEBUG_STATS, "Print partition and invocation timing statistics."},
    DEBUG_NAMED_VALUE_END};
 
 DEBUG_GET_ONCE_FLAGS_OPTION(debug_teflon, "TEFLON_DEBUG", teflon_debug_flags, 0)
@@ -56,6 +59,14 @@ struct teflon_subgraph {
 
    unsigned *output_tensors;
    unsigned output_count;
+
+   /* Only updated with TEFLON_DEBUG=stats */
+   unsigned operation_count;
+   unsigned invoke_count;
+   uint64_t invoke_ns;      /**< time spent in ml_subgraph_invoke */
+   uint64_t read_output_ns; /**< time spent in ml_subgraph_read_output */
+   uint64_t min_ns;
+   uint64_t max_ns;
 };
 
 static struct pipe_resource *
@@ -455,6 +466,91 @@ free_operation(struct pipe_ml_operation *operation)
    free(operation->output_tensors);
 }
 
+static bool
+is_subgraph_output(const TfLiteDelegateParams *params, unsigned tensor_idx)
+{
+   for (int i = 0; i < params->output_tensors->size; i++) {
+      if (params->output_tensors->data[i] == tensor_idx)
+         return true;
+   }
+
+   return false;
+}
+
+static unsigned
+count_consumers(struct pipe_ml_operation *operations, unsigned count, unsigned tensor_idx)
+{
+   unsigned consumers = 0;
+
+   for (unsigned i = 0; i < count; i++) {
+      for (unsigned j = 0; j < operations[i].input_count; j++) {
+         if (operations[i].input_tensors[j]->index == tensor_idx)
+            consumers++;
+      }
+   }
+
+   return consumers;
+}
+
+/*
+ * Folds standalone ReLUs into the convolution producing their input, so the
+ * driver doesn't need a separate pass over the intermediate tensor.
+ *
+ * This is only done when the ReLU doesn't requantize and the convolution
+ * output isn't needed by anybody else, and only if the driver supports the
+ * fused convolution. Returns the new number of operations.
+ */
+static unsigned
+fuse_activations(struct pipe_context *context, const TfLiteDelegateParams *params,
+                 struct pipe_ml_operation *operations, unsigned count)
+{
+   unsigned new_count = 0;
+
+   for (unsigned i = 0; i < count; i++) {
+      struct pipe_ml_operation *relu = &operations[i];
+      struct pipe_ml_operation *conv = NULL;
+
+      if (relu->type == PIPE_ML_OPERATION_TYPE_RELU) {
+         struct pipe_tensor *input = relu->input_tensors[0];
+         struct pipe_tensor *output = relu->output_tensors[0];
+
+         for (unsigned j = 0; j < new_count; j++) {
+            if (operations[j].type == PIPE_ML_OPERATION_TYPE_CONVOLUTION &&
+                operations[j].output_tensors[0] == input) {
+               conv = &operations[j];
+               break;
+            }
+         }
+
+         if (conv && (conv->conv.relu ||
+                      input->scale != output->scale ||
+                      input->zero_point != output->zero_point ||
+                      is_subgraph_output(params, input->index) ||
+                      count_consumers(operations, count, input->index) != 1))
+            conv = NULL;
+      }
+
+      if (conv) {
+         struct pipe_ml_operation fused = *conv;
+         fused.output_tensors = &relu->output_tensors[0];
+         fused.conv.relu = true;
+
+         if (context->ml_operation_supported(context, &fused)) {
+            teflon_debug("teflon: fusing ReLU %d into convolution %d\n",
+                         relu->output_tensors[0]->index, conv->output_tensors[0]->index);
+            conv->output_tensors[0] = relu->output_tensors[0];
+            conv->conv.relu = true;
+            free_operation(relu);
+            continue;
+         }
+      }
+
+      operations[new_count++] = *relu;
+   }
+
+   return new_count;
+}
+
 static void *
 partition_init(TfLiteContext *tf_context, const char *buffer, size_t length)
 {
@@ -483,16 +579,20 @@ partition_init(TfLiteContext *tf_context, const char *buffer, size_t length)
       assert(ret);
    }
 
+   unsigned operation_count = fuse_activations(context, params, operations,
+                                               params->nodes_to_replace->size);
+
    if (debug_get_option_debug_teflon() & TEFLON_DEBUG_VERBOSE)
-      dump_graph(delegate->tensors, tf_context->tensors_size, operations, params->nodes_to_replace->size);
+      dump_graph(delegate->tensors, tf_context->tensors_size, operations, operation_count);
 
    struct pipe_ml_subgraph *subgraph;
    subgraph = context->ml_subgraph_create(context,
                                           operations,
-                                          params->nodes_to_replace->size);
+                                          operation_count);
 
    struct teflon_subgraph *tsubgraph = calloc(1, sizeof(*tsubgraph));
    tsubgraph->base = subgraph;
+   tsubgraph->operation_count = operation_count;
 
    tsubgraph->input_tensors = malloc(params->input_tensors->size * sizeof(*tsubgraph->input_tensors));
    for (int i = 0; i < params->input_tensors->size; i++) {
@@ -516,7 +616,7 @@ partition_init(TfLiteContext *tf_context, const char *buffer, size_t length)
       teflon_debug("teflon: compiled graph, took %ld ms\n", (end - start));
    }
 
-   for (int i = 0; i < params->nodes_to_replace->size; i++) {
+   for (unsigned i = 0; i < operation_count; i++) {
       free_operation(&operations[i]);
    }
 
@@ -539,6 +639,20 @@ partition_free(TfLiteContext *tf_context, void *buffer)
    struct pipe_ml_subgraph *subgraph = tsubgraph->base;
    struct pipe_context *context = subgraph->context;
 
+   if (unlikely(debug_get_option_debug_teflon() & TEFLON_DEBUG_STATS) &&
+       tsubgraph->invoke_count > 0) {
+      const uint64_t total_ns = tsubgraph->invoke_ns + tsubgraph->read_output_ns;
+
+      _debug_printf("teflon: partition with %u operations: %u invocations, "
+                    "avg %.3f ms (invoke %.3f ms, read output %.3f ms), "
+                    "min %.3f ms, max %.3f ms\n",
+                    tsubgraph->operation_count, tsubgraph->invoke_count,
+                    total_ns / 1000000.0 / tsubgraph->invoke_count,
+                    tsubgraph->invoke_ns / 1000000.0 / tsubgraph->invoke_count,
+                    tsubgraph->read_output_ns / 1000000.0 / tsubgraph->invoke_count,
+                    tsubgraph->min_ns / 1000000.0, tsubgraph->max_ns / 1000000.0);
+   }
+
    context->ml_subgraph_destroy(context, subgraph);
    free(tsubgraph->input_tensors);
    free(tsubgraph->output_tensors);
@@ -552,7 +666,9 @@ partition_invoke(TfLiteContext *tf_context, TfLiteNode *node)
    struct teflon_subgraph *tsubgraph = (struct teflon_subgraph *)node->user_data;
    struct pipe_ml_subgraph *subgraph = tsubgraph->base;
    struct pipe_context *context = delegate->context;
+   const bool stats = debug_get_option_debug_teflon() & TEFLON_DEBUG_STATS;
    long start = 0, end = 0;
+   int64_t invoke_start = 0, read_output_start = 0;
 
    if (unlikely(debug_get_option_debug_teflon() & TEFLON_DEBUG_VERBOSE)) {
       struct timespec time;
@@ -560,6 +676,9 @@ partition_invoke(TfLiteContext *tf_context, TfLiteNode *node)
       start = (long)time.tv_sec * 1000 + (long)time.tv_nsec / 1000000;
    }
 
+   if (unlikely(stats))
+      invoke_start = os_time_get_nano();
+
    void **buffers = malloc(tsubgraph->input_count * sizeof(*buffers));
    bool *is_signed = malloc(tsubgraph->input_count * sizeof(*is_signed));
    for (unsigned i = 0; i < tsubgraph->input_count; i++) {
@@ -575,6 +694,9 @@ partition_invoke(TfLiteContext *tf_context, TfLiteNode *node)
    free(buffers);
    free(is_signed);
 
+   if (unlikely(stats))
+      read_output_start = os_time_get_nano();
+
    buffers = malloc(tsubgraph->output_count * sizeof(*buffers));
    is_signed = malloc(tsubgraph->output_count * sizeof(*is_signed));
    for (unsigned i = 0; i < tsubgraph->output_count; i++) {
@@ -590,6 +712,18 @@ partition_invoke(TfLiteContext *tf_context, TfLiteNode *node)
    free(buffers);
    free(is_signed);
 
+   if (unlikely(stats)) {
+      const int64_t now = os_time_get_nano();
+      const uint64_t total_ns = now - invoke_start;
+
+      tsubgraph->invoke_ns += read_output_start - invoke_start;
+      tsubgraph->read_output_ns += now - read_output_start;
+      if (tsubgraph->invoke_count == 0 || total_ns < tsubgraph->min_ns)
+         tsubgraph->min_ns = total_ns;
+      tsubgraph->max_ns = MAX2(tsubgraph->max_ns, total_ns);
+      tsubgraph->invoke_count++;
+   }
+
    if (unlikely(debug_get_option_debug_teflon() & TEFLON_DEBUG_VERBOSE)) {
       struct timespec time;
       clock_gettime(CLOCK_MONOTONIC, &time);
@@ -796,6 +930,11 @@ PrepareDelegate(TfLiteContext *tf_context, TfLiteDelegate *tf_delegate)
    }
    supported_nodes->size = node_count;
 
+   if (unlikely(debug_get_option_debug_teflon() & TEFLON_DEBUG_STATS)) {
+      _debug_printf("teflon: delegating %u of %d operations, %d left to the CPU\n",
+                    node_count, plan->size, plan->size - (int)node_count);
+   }
+
    TfLiteRegistration registration;
 
    registration.init = partition_init;
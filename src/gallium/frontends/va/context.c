@@ -213,6 +213,8 @@ VA_DRIVER_INIT_FUNC(VADriverContextP ctx)
    if (!drv->htab)
       goto error_htab;
 
+   util_dynarray_init(&drv->buffer_pool, NULL);
+
    bool can_init_compositor = drv->vscreen->pscreen->caps.graphics ||
                               drv->vscreen->pscreen->caps.compute;
 
@@ -563,6 +565,7 @@ vlVaTerminate(VADriverContextP ctx)
       return VA_STATUS_ERROR_INVALID_CONTEXT;
 
    drv = ctx->pDriverData;
+   vlVaDestroyBufferPool(drv);
    vl_compositor_cleanup_state(&drv->cstate);
    vl_compositor_cleanup(&drv->compositor);
    if (drv->pipe2)
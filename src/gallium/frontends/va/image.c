@@ -509,7 +509,7 @@ vlVaGetImage(VADriverContextP ctx, VASurfaceID surface, int x, int y,
                                    VL_COMPOSITOR_NONE, &param);
       drv->pipe->flush(drv->pipe, NULL, 0);
       if (ret != VA_STATUS_SUCCESS) {
-         tmp_surf.buffer->destroy(tmp_surf.buffer);
+         vlVaReleaseSurfaceBuffer(drv, &tmp_surf);
          mtx_unlock(&drv->mutex);
          return ret;
       }
@@ -555,7 +555,7 @@ vlVaGetImage(VADriverContextP ctx, VASurfaceID surface, int x, int y,
       }
    }
    if (tmp_surf.buffer)
-      tmp_surf.buffer->destroy(tmp_surf.buffer);
+      vlVaReleaseSurfaceBuffer(drv, &tmp_surf);
    mtx_unlock(&drv->mutex);
 
    return VA_STATUS_SUCCESS;
@@ -678,7 +678,7 @@ vlVaPutImage(VADriverContextP ctx, VASurfaceID surface, VAImageID image,
       ret = vlVaPostProcCompositor(drv, tmp_surf.buffer, surf->buffer,
                                    VL_COMPOSITOR_NONE, &param);
       vlVaSurfaceFlush(drv, surf);
-      tmp_surf.buffer->destroy(tmp_surf.buffer);
+      vlVaReleaseSurfaceBuffer(drv, &tmp_surf);
       mtx_unlock(&drv->mutex);
       return ret;
    }
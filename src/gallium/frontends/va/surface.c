@@ -118,7 +118,7 @@ vlVaDestroySurfaces(VADriverContextP ctx, VASurfaceID *surface_list, int num_sur
          return VA_STATUS_ERROR_INVALID_SURFACE;
       }
       if (surf->buffer)
-         surf->buffer->destroy(surf->buffer);
+         vlVaReleaseSurfaceBuffer(drv, surf);
       if (surf->pipe_fence)
          drv->pipe->screen->fence_reference(drv->pipe->screen, &surf->pipe_fence, NULL);
       if (surf->ctx) {
@@ -940,6 +940,83 @@ fail:
 
 #endif
 
+#define VL_VA_MAX_POOLED_BUFFERS 16
+
+typedef struct {
+   struct pipe_video_buffer templat;
+   struct pipe_video_buffer *buffer;
+} vlVaPooledBuffer;
+
+static bool
+vlVaTemplatesMatch(const struct pipe_video_buffer *a,
+                   const struct pipe_video_buffer *b)
+{
+   return a->buffer_format == b->buffer_format &&
+          a->width == b->width &&
+          a->height == b->height &&
+          a->interlaced == b->interlaced &&
+          a->bind == b->bind &&
+          a->flags == b->flags &&
+          a->contiguous_planes == b->contiguous_planes;
+}
+
+static struct pipe_video_buffer *
+vlVaTakePooledBuffer(vlVaDriver *drv, const struct pipe_video_buffer *templat)
+{
+   util_dynarray_foreach(&drv->buffer_pool, vlVaPooledBuffer, entry) {
+      if (vlVaTemplatesMatch(&entry->templat, templat)) {
+         struct pipe_video_buffer *buffer = entry->buffer;
+         *entry = util_dynarray_pop(&drv->buffer_pool, vlVaPooledBuffer);
+         return buffer;
+      }
+   }
+
+   return NULL;
+}
+
+/**
+ * Drops the video buffer of the surface. Plain driver allocations are kept
+ * in a small pool, so applications creating and destroying surfaces of the
+ * same size all the time, or vaGetImage/vaPutImage needing a temporary
+ * surface, don't have to go through the allocator each time.
+ */
+void
+vlVaReleaseSurfaceBuffer(vlVaDriver *drv, vlVaSurface *surface)
+{
+   struct pipe_video_buffer *buffer = surface->buffer;
+
+   surface->buffer = NULL;
+
+   if (surface->recyclable && !surface->is_dpb &&
+       util_dynarray_num_elements(&drv->buffer_pool, vlVaPooledBuffer) <
+          VL_VA_MAX_POOLED_BUFFERS) {
+      vlVaPooledBuffer entry = {
+         .templat = surface->templat,
+         .buffer = buffer,
+      };
+
+      /* Whatever the last codec attached belongs to the old surface. */
+      if (buffer->associated_data && buffer->destroy_associated_data)
+         buffer->destroy_associated_data(buffer->associated_data);
+      buffer->associated_data = NULL;
+      buffer->codec = NULL;
+
+      util_dynarray_append(&drv->buffer_pool, vlVaPooledBuffer, entry);
+   } else {
+      buffer->destroy(buffer);
+   }
+
+   surface->recyclable = false;
+}
+
+void
+vlVaDestroyBufferPool(vlVaDriver *drv)
+{
+   util_dynarray_foreach(&drv->buffer_pool, vlVaPooledBuffer, entry)
+      entry->buffer->destroy(entry->buffer);
+   util_dynarray_fini(&drv->buffer_pool);
+}
+
 VAStatus
 vlVaHandleSurfaceAllocate(vlVaDriver *drv, vlVaSurface *surface,
                           struct pipe_video_buffer *templat,
@@ -949,6 +1026,8 @@ vlVaHandleSurfaceAllocate(vlVaDriver *drv, vlVaSurface *surface,
    struct pipe_surface *surfaces;
    unsigned i;
 
+   surface->recyclable = false;
+
    if (modifiers_count > 0) {
       if (!drv->pipe->create_video_buffer_with_modifiers)
          return VA_STATUS_ERROR_ATTR_NOT_SUPPORTED;
@@ -957,7 +1036,15 @@ vlVaHandleSurfaceAllocate(vlVaDriver *drv, vlVaSurface *surface,
                                                        modifiers,
                                                        modifiers_count);
    } else {
-      surface->buffer = drv->pipe->create_video_buffer(drv->pipe, templat);
+      surface->buffer = vlVaTakePooledBuffer(drv, templat);
+      if (!surface->buffer)
+         surface->buffer = drv->pipe->create_video_buffer(drv->pipe, templat);
+
+      /* Only buffers described by the surface template can be pooled, as
+       * that's what they get matched against.
+       */
+      surface->recyclable = templat == &surface->templat &&
+                            !(templat->bind & PIPE_BIND_PROTECTED);
    }
    if (!surface->buffer)
       return VA_STATUS_ERROR_ALLOCATION_FAILED;
@@ -1562,6 +1649,10 @@ vlVaExportSurfaceHandle(VADriverContextP ctx,
 
 #endif
 
+   /* Whoever imports the handle may still use the memory after the surface
+    * is gone, so never hand it out again.
+    */
+   surf->recyclable = false;
    drv->has_external_handles = true;
    mtx_unlock(&drv->mutex);
 
@@ -355,6 +355,9 @@ typedef struct {
    char vendor_string[256];
 
    bool has_external_handles;
+
+   /* Video buffers of destroyed surfaces kept around for reuse */
+   struct util_dynarray buffer_pool; /* vlVaPooledBuffer */
 } vlVaDriver;
 
 typedef struct {
@@ -456,6 +459,7 @@ typedef struct vlVaSurface {
    struct pipe_fence_handle *fence; /* pipe_video_codec fence */
    struct pipe_fence_handle *pipe_fence; /* pipe_context fence */
    bool is_dpb;
+   bool recyclable; /* buffer can go back to the pool once the surface is gone */
    unsigned int strides[3];
    unsigned int offsets[3];
    unsigned int data_size;
@@ -577,6 +581,8 @@ VAStatus vlVaHandleVAProcPipelineParameterBufferType(vlVaDriver *drv, vlVaContex
 VAStatus vlVaHandleSurfaceAllocate(vlVaDriver *drv, vlVaSurface *surface, struct pipe_video_buffer *templat,
                                    const uint64_t *modifiers, unsigned int modifiers_count);
 struct pipe_video_buffer *vlVaGetSurfaceBuffer(vlVaDriver *drv, vlVaSurface *surface);
+void vlVaReleaseSurfaceBuffer(vlVaDriver *drv, vlVaSurface *surface);
+void vlVaDestroyBufferPool(vlVaDriver *drv);
 void vlVaSurfaceFlush(vlVaDriver *drv, vlVaSurface *surf);
 void vlVaAddRawHeader(struct util_dynarray *headers, uint8_t type, uint32_t size, uint8_t *buf,
                       bool is_slice, uint32_t emulation_bytes_start);
@@ -914,6 +914,7 @@ struct pipe_caps {
    bool texture_query_samples;
    bool force_persample_interp;
    bool shareable_shaders;
+   bool shareable_csos;
    bool copy_between_compressed_and_plain_formats;
    bool clear_scissored;
    bool draw_parameters;
@@ -926,6 +927,7 @@ struct pipe_caps {
    bool fs_face_is_integer_sysval;
    bool invalidate_buffer;
    bool generate_mipmap;
+   bool prefer_compute_for_mipmaps;
    bool string_marker;
    bool surface_no_compress;
    bool surface_reinterpret_blocks;
@@ -0,0 +1,417 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * CPU overhead microbenchmarks of the gallium driver hot paths.
+ *
+ * Only draws of a few vertices without any rasterized pixel are issued, so
+ * the numbers are dominated by the driver's CPU work. Together with a drm-shim
+ * backend the benchmarks run without the actual GPU, e.g.:
+ *
+ *   LD_PRELOAD=libamdgpu_noop_drm_shim.so pipe_bench -d radeonsi
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compiler/nir/nir_builder.h"
+#include "pipe/p_context.h"
+#include "pipe/p_screen.h"
+#include "pipe/p_state.h"
+#include "pipe-loader/pipe_loader.h"
+#include "util/os_time.h"
+#include "util/u_inlines.h"
+#include "util/u_memory.h"
+#include "util/u_simple_shaders.h"
+#include "util/u_surface.h"
+
+struct bench {
+   struct pipe_screen *screen;
+   struct pipe_context *pipe;
+
+   struct pipe_resource *cbuf;
+   struct pipe_resource *vbuf;
+
+   void *blend[2];
+   void *dsa;
+   void *rast;
+   void *velems;
+   void *vs;
+   void *fs[2];
+   void *cs;
+
+   struct pipe_draw_info info;
+   struct pipe_draw_start_count_bias draw;
+
+   unsigned iterations;
+};
+
+static void
+bench_bind_vertex_buffer(struct bench *b)
+{
+   struct pipe_vertex_buffer vb = { 0 };
+
+   /* The driver takes ownership of the reference. */
+   pipe_resource_reference(&vb.buffer.resource, b->vbuf);
+   b->pipe->set_vertex_buffers(b->pipe, 1, &vb);
+}
+
+static void
+bench_draw(struct bench *b)
+{
+   b->pipe->draw_vbo(b->pipe, &b->info, 0, NULL, &b->draw, 1);
+}
+
+static bool
+bench_init(struct bench *b)
+{
+   struct pipe_screen *screen = b->screen;
+   struct pipe_context *pipe;
+
+   pipe = b->pipe = screen->context_create(screen, NULL, 0);
+   if (!pipe) {
+      fprintf(stderr, "pipe_bench: can't create a context\n");
+      return false;
+   }
+
+   enum pipe_format format = PIPE_FORMAT_B8G8R8A8_UNORM;
+   if (!screen->is_format_supported(screen, format, PIPE_TEXTURE_2D, 0, 0,
+                                    PIPE_BIND_RENDER_TARGET))
+      format = PIPE_FORMAT_R8G8B8A8_UNORM;
+
+   struct pipe_resource templ = {
+      .target = PIPE_TEXTURE_2D,
+      .format = format,
+      .width0 = 64,
+      .height0 = 64,
+      .depth0 = 1,
+      .array_size = 1,
+      .bind = PIPE_BIND_RENDER_TARGET,
+   };
+   b->cbuf = screen->resource_create(screen, &templ);
+   if (!b->cbuf) {
+      fprintf(stderr, "pipe_bench: can't create the color buffer\n");
+      return false;
+   }
+
+   /* A triangle that is entirely outside of the viewport. */
+   static const float vertices[3][4] = {
+      { -3.0f, -3.0f, 0.0f, 1.0f },
+      { -2.0f, -3.0f, 0.0f, 1.0f },
+      { -3.0f, -2.0f, 0.0f, 1.0f },
+   };
+   b->vbuf = pipe_buffer_create_with_data(pipe, PIPE_BIND_VERTEX_BUFFER,
+                                          PIPE_USAGE_IMMUTABLE,
+                                          sizeof(vertices), vertices);
+   if (!b->vbuf) {
+      fprintf(stderr, "pipe_bench: can't create the vertex buffer\n");
+      return false;
+   }
+
+   struct pipe_framebuffer_state fb = {
+      .width = templ.width0,
+      .height = templ.height0,
+      .nr_cbufs = 1,
+   };
+   u_surface_default_template(&fb.cbufs[0], b->cbuf);
+   pipe->set_framebuffer_state(pipe, &fb);
+
+   struct pipe_viewport_state viewport = {
+      .scale = { 0.5f * templ.width0, 0.5f * templ.height0, 0.0f },
+      .translate = { 0.5f * templ.width0, 0.5f * templ.height0, 0.0f },
+      .swizzle_x = PIPE_VIEWPORT_SWIZZLE_POSITIVE_X,
+      .swizzle_y = PIPE_VIEWPORT_SWIZZLE_POSITIVE_Y,
+      .swizzle_z = PIPE_VIEWPORT_SWIZZLE_POSITIVE_Z,
+      .swizzle_w = PIPE_VIEWPORT_SWIZZLE_POSITIVE_W,
+   };
+   pipe->set_viewport_states(pipe, 0, 1, &viewport);
+   pipe->set_sample_mask(pipe, ~0);
+
+   /* Two states that differ just enough to be emitted again on a switch. */
+   struct pipe_blend_state blend = { 0 };
+   blend.rt[0].colormask = PIPE_MASK_RGBA;
+   b->blend[0] = pipe->create_blend_state(pipe, &blend);
+   blend.rt[0].colormask = PIPE_MASK_R | PIPE_MASK_G | PIPE_MASK_B;
+   b->blend[1] = pipe->create_blend_state(pipe, &blend);
+
+   struct pipe_depth_stencil_alpha_state dsa = { 0 };
+   b->dsa = pipe->create_depth_stencil_alpha_state(pipe, &dsa);
+
+   struct pipe_rasterizer_state rast = {
+      .half_pixel_center = 1,
+      .bottom_edge_rule = 1,
+      .depth_clip_near = 1,
+      .depth_clip_far = 1,
+      .line_width = 1,
+   };
+   b->rast = pipe->create_rasterizer_state(pipe, &rast);
+
+   struct pipe_vertex_element velem = {
+      .src_format = PIPE_FORMAT_R32G32B32A32_FLOAT,
+      .src_stride = sizeof(vertices[0]),
+   };
+   b->velems = pipe->create_vertex_elements_state(pipe, 1, &velem);
+
+   static const enum tgsi_semantic semantic_names[] = {
+      TGSI_SEMANTIC_POSITION,
+   };
+   static const unsigned semantic_indices[] = { 0 };
+   b->vs = util_make_vertex_passthrough_shader(pipe, 1, semantic_names,
+                                               semantic_indices, false);
+   b->fs[0] = util_make_empty_fragment_shader(pipe);
+   b->fs[1] = util_make_empty_fragment_shader(pipe);
+
+   if (!b->blend[0] || !b->blend[1] || !b->dsa || !b->rast || !b->velems ||
+       !b->vs || !b->fs[0] || !b->fs[1]) {
+      fprintf(stderr, "pipe_bench: can't create the draw state\n");
+      return false;
+   }
+
+   pipe->bind_blend_state(pipe, b->blend[0]);
+   pipe->bind_depth_stencil_alpha_state(pipe, b->dsa);
+   pipe->bind_rasterizer_state(pipe, b->rast);
+   pipe->bind_vertex_elements_state(pipe, b->velems);
+   pipe->bind_vs_state(pipe, b->vs);
+   pipe->bind_fs_state(pipe, b->fs[0]);
+   bench_bind_vertex_buffer(b);
+
+   b->info.mode = MESA_PRIM_TRIANGLES;
+   b->info.instance_count = 1;
+   b->info.index_bounds_valid = true;
+   b->info.min_index = 0;
+   b->info.max_index = 2;
+   b->draw.start = 0;
+   b->draw.count = 3;
+
+   if (screen->caps.compute) {
+      nir_builder nb =
+         nir_builder_init_simple_shader(MESA_SHADER_COMPUTE,
+                                        screen->nir_options[MESA_SHADER_COMPUTE],
+                                        "pipe_bench_cs");
+      nb.shader->info.workgroup_size[0] = 1;
+      nb.shader->info.workgroup_size[1] = 1;
+      nb.shader->info.workgroup_size[2] = 1;
+
+      if (screen->finalize_nir)
+         screen->finalize_nir(screen, nb.shader, true);
+
+      struct pipe_compute_state cs = {
+         .ir_type = PIPE_SHADER_IR_NIR,
+         .prog = nb.shader,
+      };
+      b->cs = pipe->create_compute_state(pipe, &cs);
+   }
+
+   return true;
+}
+
+static void
+bench_fini(struct bench *b)
+{
+   struct pipe_context *pipe = b->pipe;
+
+   if (!pipe)
+      return;
+
+   pipe->bind_vertex_elements_state(pipe, NULL);
+   pipe->bind_vs_state(pipe, NULL);
+   pipe->bind_fs_state(pipe, NULL);
+   pipe->set_vertex_buffers(pipe, 0, NULL);
+
+   if (b->cs)
+      pipe->delete_compute_state(pipe, b->cs);
+   for (unsigned i = 0; i < 2; i++) {
+      if (b->fs[i])
+         pipe->delete_fs_state(pipe, b->fs[i]);
+      if (b->blend[i])
+         pipe->delete_blend_state(pipe, b->blend[i]);
+   }
+   if (b->vs)
+      pipe->delete_vs_state(pipe, b->vs);
+   if (b->velems)
+      pipe->delete_vertex_elements_state(pipe, b->velems);
+   if (b->rast)
+      pipe->delete_rasterizer_state(pipe, b->rast);
+   if (b->dsa)
+      pipe->delete_depth_stencil_alpha_state(pipe, b->dsa);
+
+   pipe_resource_reference(&b->vbuf, NULL);
+   pipe_resource_reference(&b->cbuf, NULL);
+
+   pipe->destroy(pipe);
+}
+
+/* Flush and wait so that one benchmark doesn't pay for the previous one. */
+static void
+bench_finish(struct bench *b)
+{
+   struct pipe_fence_handle *fence = NULL;
+
+   b->pipe->flush(b->pipe, &fence, 0);
+   if (fence) {
+      b->screen->fence_finish(b->screen, NULL, fence, OS_TIMEOUT_INFINITE);
+      b->screen->fence_reference(b->screen, &fence, NULL);
+   }
+}
+
+static void
+bench_report(struct bench *b, const char *name, int64_t start)
+{
+   int64_t elapsed = os_time_get_nano() - start;
+
+   printf("%-20s %10.1f ns/iter\n", name, (double)elapsed / b->iterations);
+}
+
+static void
+bench_run(struct bench *b)
+{
+   struct pipe_context *pipe = b->pipe;
+   unsigned n = b->iterations;
+   int64_t start;
+
+   /* Warm up, e.g. to compile shader variants. */
+   bench_draw(b);
+   bench_finish(b);
+
+   start = os_time_get_nano();
+   for (unsigned i = 0; i < n; i++)
+      bench_draw(b);
+   bench_report(b, "draw", start);
+   bench_finish(b);
+
+   start = os_time_get_nano();
+   for (unsigned i = 0; i < n; i++) {
+      bench_bind_vertex_buffer(b);
+      bench_draw(b);
+   }
+   bench_report(b, "vbuf + draw", start);
+   bench_finish(b);
+
+   start = os_time_get_nano();
+   for (unsigned i = 0; i < n; i++) {
+      pipe->bind_blend_state(pipe, b->blend[i & 1]);
+      bench_draw(b);
+   }
+   bench_report(b, "blend + draw", start);
+   pipe->bind_blend_state(pipe, b->blend[0]);
+   bench_finish(b);
+
+   start = os_time_get_nano();
+   for (unsigned i = 0; i < n; i++) {
+      pipe->bind_fs_state(pipe, b->fs[i & 1]);
+      bench_draw(b);
+   }
+   bench_report(b, "fs + draw", start);
+   pipe->bind_fs_state(pipe, b->fs[0]);
+   bench_finish(b);
+
+   start = os_time_get_nano();
+   for (unsigned i = 0; i < n; i++) {
+      struct pipe_fence_handle *fence = NULL;
+
+      bench_draw(b);
+      pipe->flush(pipe, &fence, 0);
+      b->screen->fence_reference(b->screen, &fence, NULL);
+   }
+   bench_report(b, "draw + flush", start);
+   bench_finish(b);
+
+   if (b->cs) {
+      struct pipe_grid_info grid = {
+         .block = { 1, 1, 1 },
+         .grid = { 1, 1, 1 },
+      };
+
+      pipe->bind_compute_state(pipe, b->cs);
+      pipe->launch_grid(pipe, &grid);
+      bench_finish(b);
+
+      start = os_time_get_nano();
+      for (unsigned i = 0; i < n; i++)
+         pipe->launch_grid(pipe, &grid);
+      bench_report(b, "dispatch", start);
+      pipe->bind_compute_state(pipe, NULL);
+      bench_finish(b);
+   }
+}
+
+static void
+usage(void)
+{
+   fprintf(stderr,
+           "usage: pipe_bench [-d driver] [-n iterations]\n"
+           "\n"
+           "  -d driver      use the first device of this driver, e.g. iris\n"
+           "  -n iterations  iterations of each benchmark, 100000 by default\n");
+}
+
+int
+main(int argc, char **argv)
+{
+   struct bench b = { .iterations = 100000 };
+   const char *driver = NULL;
+   struct pipe_loader_device **devs, *dev = NULL;
+   int opt, ndevs;
+
+   while ((opt = getopt(argc, argv, "d:n:h")) != -1) {
+      switch (opt) {
+      case 'd':
+         driver = optarg;
+         break;
+      case 'n':
+         b.iterations = strtoul(optarg, NULL, 0);
+         break;
+      default:
+         usage();
+         return opt == 'h' ? 0 : 1;
+      }
+   }
+
+   if (!b.iterations) {
+      usage();
+      return 1;
+   }
+
+   ndevs = pipe_loader_probe(NULL, 0, false);
+   devs = CALLOC(MAX2(ndevs, 1), sizeof(*devs));
+   ndevs = pipe_loader_probe(devs, ndevs, false);
+
+   for (int i = 0; i < ndevs; i++) {
+      if (!dev && (!driver || !strcmp(devs[i]->driver_name, driver)))
+         dev = devs[i];
+      else
+         pipe_loader_release(&devs[i], 1);
+   }
+   FREE(devs);
+
+   if (!dev) {
+      fprintf(stderr, "pipe_bench: no %s device found\n",
+              driver ? driver : "gallium");
+      return 1;
+   }
+
+   b.screen = pipe_loader_create_screen(dev, false);
+   if (!b.screen) {
+      fprintf(stderr, "pipe_bench: can't create the %s screen\n",
+              dev->driver_name);
+      pipe_loader_release(&dev, 1);
+      return 1;
+   }
+
+   printf("%s (%s), %u iterations\n", b.screen->get_name(b.screen),
+          dev->driver_name, b.iterations);
+
+   bool ok = bench_init(&b);
+   if (ok)
+      bench_run(&b);
+
+   bench_fini(&b);
+   b.screen->destroy(b.screen);
+   pipe_loader_release(&dev, 1);
+
+   return ok ? 0 : 1;
+}
@@ -658,6 +658,38 @@ amdgpu_lookup_or_add_buffer(struct amdgpu_cs_context *csc, struct amdgpu_winsys_
    return buffer ? buffer : amdgpu_do_add_buffer(csc, bo, list, add_ref);
 }
 
+#define SLAB_BACKING_CACHE_SIZE 256
+
+/* Adds the real BO backing a slab entry.
+ *
+ * Many slab entries share the same few backing BOs, and the hash list only
+ * tracks the current CS, so it's mostly useless when this runs in the
+ * submit thread.  A small cache of the indices the caller already looked
+ * up avoids a linear walk of the real buffer list for each of those.
+ */
+static struct amdgpu_cs_buffer *
+amdgpu_lookup_or_add_slab_backing(struct amdgpu_cs_context *csc,
+                                  int32_t cache[SLAB_BACKING_CACHE_SIZE],
+                                  struct amdgpu_winsys_bo *slab_entry_bo,
+                                  bool add_ref)
+{
+   struct amdgpu_winsys_bo *bo = &get_slab_entry_real_bo(slab_entry_bo)->b;
+   struct amdgpu_buffer_list *list = &csc->buffer_lists[AMDGPU_BO_REAL];
+   unsigned slot = bo->unique_id % SLAB_BACKING_CACHE_SIZE;
+   int32_t idx = cache[slot];
+
+   if (idx >= 0 && (unsigned)idx < list->num_buffers &&
+       list->buffers[idx].bo == bo)
+      return &list->buffers[idx];
+
+   struct amdgpu_cs_buffer *buffer =
+      amdgpu_lookup_or_add_buffer(csc, bo, list, add_ref);
+   if (buffer)
+      cache[slot] = buffer - list->buffers;
+
+   return buffer;
+}
+
 static unsigned amdgpu_cs_add_buffer(struct radeon_cmdbuf *rcs,
                                     struct pb_buffer_lean *buf,
                                     unsigned usage,
@@ -1160,12 +1192,14 @@ static void amdgpu_add_slab_backing_buffers(struct amdgpu_cs_context *csc)
 {
    unsigned num_buffers = csc->buffer_lists[AMDGPU_BO_SLAB_ENTRY].num_buffers;
    struct amdgpu_cs_buffer *buffers = csc->buffer_lists[AMDGPU_BO_SLAB_ENTRY].buffers;
+   int32_t backing_cache[SLAB_BACKING_CACHE_SIZE];
+
+   memset(backing_cache, -1, sizeof(backing_cache));
 
    for (unsigned i = 0; i < num_buffers; i++) {
       struct amdgpu_cs_buffer *slab_buffer = &buffers[i];
       struct amdgpu_cs_buffer *real_buffer =
-         amdgpu_lookup_or_add_buffer(csc, &get_slab_entry_real_bo(slab_buffer->bo)->b,
-                                     &csc->buffer_lists[AMDGPU_BO_REAL], true);
+         amdgpu_lookup_or_add_slab_backing(csc, backing_cache, slab_buffer->bo, true);
 
       /* We need to set the usage because it determines the BO priority.
        *
@@ -1767,6 +1801,9 @@ static void amdgpu_cs_submit_ib(void *job, void *gdata, int thread_index)
    unsigned initial_num_real_buffers = csc->buffer_lists[AMDGPU_BO_REAL].num_buffers;
    unsigned queue_index_bit = (queue_type == KERNELQ_ALT_FENCE) ?
       0 : BITFIELD_BIT(queue_index);
+   int32_t backing_cache[SLAB_BACKING_CACHE_SIZE];
+
+   memset(backing_cache, -1, sizeof(backing_cache));
 
    for (unsigned i = 0; i < num_slab_entry_buffers; i++) {
       struct amdgpu_cs_buffer *buffer = &slab_entry_buffers[i];
@@ -1783,8 +1820,7 @@ static void amdgpu_cs_submit_ib(void *job, void *gdata, int thread_index)
        * to the kernel. Do it now.
        */
       struct amdgpu_cs_buffer *real_buffer =
-         amdgpu_lookup_or_add_buffer(csc, &get_slab_entry_real_bo(buffer->bo)->b,
-                                     &csc->buffer_lists[AMDGPU_BO_REAL], false);
+         amdgpu_lookup_or_add_slab_backing(csc, backing_cache, buffer->bo, false);
 
       /* We need to set the usage because it determines the BO priority. */
       real_buffer->usage |= buffer->usage;
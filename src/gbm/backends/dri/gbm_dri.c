@@ -478,6 +478,9 @@ gbm_dri_bo_get_planes(struct gbm_bo *_bo)
    struct gbm_dri_device *dri = gbm_dri_device(_bo->gbm);
    struct gbm_dri_bo *bo = gbm_dri_bo(_bo);
 
+   if (bo->has_layout)
+      return bo->num_planes;
+
    return get_number_planes(dri, bo->image);
 }
 
@@ -569,6 +572,14 @@ gbm_dri_bo_get_stride(struct gbm_bo *_bo, int plane)
       return 0;
    }
 
+   if (bo->has_layout) {
+      if (plane >= bo->num_planes) {
+         errno = EINVAL;
+         return 0;
+      }
+      return bo->strides[plane];
+   }
+
    if (plane >= get_number_planes(dri, bo->image)) {
       errno = EINVAL;
       return 0;
@@ -598,6 +609,9 @@ gbm_dri_bo_get_offset(struct gbm_bo *_bo, int plane)
    struct gbm_dri_bo *bo = gbm_dri_bo(_bo);
    int offset = 0;
 
+   if (bo->has_layout)
+      return plane < bo->num_planes ? bo->offsets[plane] : 0;
+
    if (plane >= get_number_planes(dri, bo->image))
       return 0;
 
@@ -628,6 +642,9 @@ gbm_dri_bo_get_modifier(struct gbm_bo *_bo)
    if (!bo->image)
       return DRM_FORMAT_MOD_LINEAR;
 
+   if (bo->has_layout)
+      return bo->modifier;
+
    uint64_t ret = 0;
    int mod;
    if (!dri2_query_image(bo->image, __DRI_IMAGE_ATTRIB_MODIFIER_UPPER,
@@ -645,6 +662,41 @@ gbm_dri_bo_get_modifier(struct gbm_bo *_bo)
    return ret;
 }
 
+/* Compositors query the layout of every buffer they allocate, usually more
+ * than once, and each plane query wraps the plane in a new image. The layout
+ * of an image allocated here never changes, so it's queried once.
+ */
+static void
+gbm_dri_bo_query_layout(struct gbm_dri_device *dri, struct gbm_dri_bo *bo)
+{
+   int num_planes = get_number_planes(dri, bo->image);
+   if (num_planes > GBM_MAX_PLANES)
+      return;
+
+   for (int plane = 0; plane < num_planes; plane++) {
+      int stride = 0, offset = 0;
+
+      struct dri_image *image = dri2_from_planar(bo->image, plane, NULL);
+      if (image) {
+         dri2_query_image(image, __DRI_IMAGE_ATTRIB_STRIDE, &stride);
+         dri2_query_image(image, __DRI_IMAGE_ATTRIB_OFFSET, &offset);
+         dri2_destroy_image(image);
+      } else {
+         if (plane > 0)
+            return;
+         dri2_query_image(bo->image, __DRI_IMAGE_ATTRIB_STRIDE, &stride);
+         dri2_query_image(bo->image, __DRI_IMAGE_ATTRIB_OFFSET, &offset);
+      }
+
+      bo->strides[plane] = (uint32_t)stride;
+      bo->offsets[plane] = (uint32_t)offset;
+   }
+
+   bo->num_planes = num_planes;
+   bo->modifier = gbm_dri_bo_get_modifier(&bo->base);
+   bo->has_layout = true;
+}
+
 static void
 gbm_dri_bo_destroy(struct gbm_bo *_bo)
 {
@@ -1028,6 +1080,9 @@ gbm_dri_bo_create(struct gbm_device *gbm,
    dri2_query_image(bo->image, __DRI_IMAGE_ATTRIB_STRIDE,
                           (int *) &bo->base.v0.stride);
 
+   if (dri->has_dmabuf_import)
+      gbm_dri_bo_query_layout(dri, bo);
+
    return &bo->base;
 
 failed:
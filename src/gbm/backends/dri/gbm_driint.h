@@ -102,6 +102,15 @@ struct gbm_dri_bo {
 
    struct dri_image *image;
 
+   /* Layout of the image, queried once when it is allocated. Imported images
+    * don't have it, since exporting them can still reallocate them.
+    */
+   bool has_layout;
+   int num_planes;
+   uint32_t strides[GBM_MAX_PLANES];
+   uint32_t offsets[GBM_MAX_PLANES];
+   uint64_t modifier;
+
    /* Used for cursors and the swrast front BO */
    uint32_t handle, size;
    void *map;
@@ -6945,10 +6945,28 @@ static void fillEmulatedDrmFormatModPropsList(
 void ResourceTracker::on_vkGetPhysicalDeviceFormatProperties2(
     void* context, VkPhysicalDevice physicalDevice, VkFormat format,
     VkFormatProperties2* pFormatProperties) {
+    // Format properties never change, so repeated queries without a pNext
+    // chain are answered without a round-trip to the host.
+    const bool cacheable = pFormatProperties->pNext == nullptr;
+    if (cacheable) {
+        std::lock_guard<std::recursive_mutex> lock(mLock);
+        const auto& formats = mCachedFormatProperties[physicalDevice];
+        auto it = formats.find(format);
+        if (it != formats.end()) {
+            pFormatProperties->formatProperties = it->second;
+            return;
+        }
+    }
+
     VkEncoder* enc = (VkEncoder*)context;
     enc->vkGetPhysicalDeviceFormatProperties2(physicalDevice, format, pFormatProperties,
                                               true /* do lock */);
 
+    if (cacheable) {
+        std::lock_guard<std::recursive_mutex> lock(mLock);
+        mCachedFormatProperties[physicalDevice][format] = pFormatProperties->formatProperties;
+    }
+
 #ifdef LINUX_GUEST_BUILD
     VkDrmFormatModifierPropertiesListEXT* emulatedDrmFmtModPropsList =
         vk_find_struct(pFormatProperties, DRM_FORMAT_MODIFIER_PROPERTIES_LIST_EXT);
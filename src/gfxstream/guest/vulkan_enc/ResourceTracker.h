@@ -890,6 +890,8 @@ class ResourceTracker {
     std::recursive_mutex mLock;
 
     std::optional<const VkPhysicalDeviceMemoryProperties> mCachedPhysicalDeviceMemoryProps;
+    std::unordered_map<VkPhysicalDevice, std::unordered_map<VkFormat, VkFormatProperties>>
+        mCachedFormatProperties;
 
     struct GfxStreamVkFeatureInfo mFeatureInfo = {};
 
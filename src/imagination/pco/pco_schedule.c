@@ -17,6 +17,83 @@
 
 #include <stdbool.h>
 
+/**
+ * \brief Returns whether an instruction uses a data fence counter.
+ *
+ * \param[in] instr PCO instruction.
+ * \return True if the instruction uses a data fence counter.
+ */
+static bool instr_uses_drc(pco_instr *instr)
+{
+   if (instr->op == PCO_OP_WDF || instr->op == PCO_OP_IDF)
+      return true;
+
+   pco_foreach_instr_src (psrc, instr) {
+      if (pco_ref_is_drc(*psrc))
+         return true;
+   }
+
+   return false;
+}
+
+/**
+ * \brief Returns whether an instruction reads one of the destinations of
+ *        another instruction.
+ *
+ * \param[in] instr PCO instruction.
+ * \param[in] producer Instruction whose destinations are checked.
+ * \return True if instr reads one of the destinations of producer.
+ */
+static bool instr_reads_dests(pco_instr *instr, pco_instr *producer)
+{
+   pco_foreach_instr_src_ssa (psrc, instr) {
+      pco_foreach_instr_dest_ssa (pdest, producer) {
+         if (psrc->val == pdest->val)
+            return true;
+      }
+   }
+
+   return false;
+}
+
+/**
+ * \brief Finds where to wait for the data returned by an instruction.
+ *
+ * The wait is pushed down to the first instruction that reads the returned
+ * data, so that the instructions in between hide the latency. It can't move
+ * past another instruction using a data fence counter, and it isn't moved
+ * out of the block.
+ *
+ * The wait only moves if it ends up in front of a reader: until then the
+ * destinations are live, so register allocation won't hand their registers
+ * to the instructions in between while the data is still being written.
+ *
+ * \param[in] instr Instruction returning data.
+ * \return The instruction to wait in front of, or NULL to wait right after
+ *         instr.
+ */
+static pco_instr *wait_point(pco_instr *instr)
+{
+   pco_block *block = instr->parent_block;
+
+   pco_foreach_instr_dest (pdest, instr) {
+      if (!pco_ref_is_ssa(*pdest))
+         return NULL;
+   }
+
+   for (pco_instr *next = instr; next != pco_last_instr(block);) {
+      next = list_entry(next->link.next, pco_instr, link);
+
+      if (instr_reads_dests(next, instr))
+         return next;
+
+      if (instr_uses_drc(next))
+         return NULL;
+   }
+
+   return NULL;
+}
+
 /**
  * \brief Schedules instructions and inserts waits.
  *
@@ -37,13 +114,20 @@ bool pco_schedule(pco_shader *shader)
             if (!pco_ref_is_drc(*psrc))
                continue;
 
-            b = pco_builder_create(func, pco_cursor_after_instr(instr));
-
             if ((instr->op == PCO_OP_ST32 || instr->op == PCO_OP_ST32_REGBL) &&
                 pco_instr_get_idf(instr)) {
+               b = pco_builder_create(func, pco_cursor_after_instr(instr));
+
                pco_ref addr = pco_ref_chans(instr->src[3], 2);
                pco_idf(&b, *psrc, addr);
                pco_instr_set_idf(instr, false);
+            } else {
+               pco_instr *wait_before = wait_point(instr);
+               pco_cursor cursor = wait_before
+                                      ? pco_cursor_before_instr(wait_before)
+                                      : pco_cursor_after_instr(instr);
+
+               b = pco_builder_create(func, cursor);
             }
 
             pco_wdf(&b, *psrc);
@@ -199,6 +199,7 @@ brw_compile_cs(const struct brw_compiler *compiler,
    prog_data->uses_sampler = brw_nir_uses_sampler(params->base.nir);
 
    std::unique_ptr<brw_shader> v[3];
+   unsigned discarded_compiles = 0;
 
    for (unsigned i = 0; i < 3; i++) {
       const unsigned simd = devinfo->ver >= 30 ? 2 - i : i;
@@ -254,6 +255,7 @@ brw_compile_cs(const struct brw_compiler *compiler,
             break;
       } else {
          simd_state.error[simd] = ralloc_strdup(params->base.mem_ctx, v[simd]->fail_msg);
+         discarded_compiles++;
          if (simd > 0) {
             brw_shader_perf_log(compiler, params->base.log_data,
                                 "SIMD%u shader failed to compile: %s\n",
@@ -275,8 +277,10 @@ brw_compile_cs(const struct brw_compiler *compiler,
 
    assert(selected_simd < 3);
 
-   if (!nir->info.workgroup_size_variable)
+   if (!nir->info.workgroup_size_variable) {
+      discarded_compiles += util_bitcount(prog_data->prog_mask) - 1;
       prog_data->prog_mask = 1 << selected_simd;
+   }
 
    brw_generator g(compiler, &params->base, &prog_data->base,
                   MESA_SHADER_COMPUTE);
@@ -296,8 +300,10 @@ brw_compile_cs(const struct brw_compiler *compiler,
       if (prog_data->prog_mask & (1u << simd)) {
          assert(v[simd]);
          prog_data->prog_offset[simd] = g.generate_code(*v[simd], stats);
-         if (stats)
+         if (stats) {
             stats->max_dispatch_width = max_dispatch_width;
+            stats->discarded_compiles = discarded_compiles;
+         }
          stats = stats ? stats + 1 : NULL;
 
          prog_data->base.grf_used = MAX2(prog_data->base.grf_used,
@@ -1592,6 +1592,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
    std::unique_ptr<brw_shader> v8, v16, v32, vmulti;
    float throughput = 0;
    bool has_spilled = false;
+   unsigned discarded_compiles = 0;
 
    const brw_shader_params base_shader_params = {
       .compiler                = compiler,
@@ -1642,12 +1643,20 @@ brw_compile_fs(const struct brw_compiler *compiler,
       } else {
          /* Not using SIMD8. */
          v8.reset();
+         discarded_compiles++;
       }
    }
 
    if (compiler->optimistic_simd_heuristic) {
       unsigned max_dispatch_width = reqd_dispatch_width ? reqd_dispatch_width : 32;
 
+      /* Only try the widest mode that the NIR register pressure estimate
+       * expects to fit without spilling, so that the backend doesn't have to
+       * find out the hard way.
+       */
+      if (beyond_threshold[2])
+         max_dispatch_width = std::min(max_dispatch_width, 16u);
+
       if (max_polygons >= 2 && !key->coarse_pixel) {
          if (max_polygons >= 4 && max_dispatch_width >= 32 &&
              4 * prog_data->num_varying_inputs <= MAX_VARYING &&
@@ -1664,6 +1673,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                    "Quad-SIMD8 shader failed to compile: %s\n",
                                    vmulti->fail_msg);
                vmulti.reset();
+               discarded_compiles++;
             } else {
                assert(!vmulti->spilled_any_registers);
             }
@@ -1685,6 +1695,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                    "Dual-SIMD16 shader failed to compile: %s\n",
                                    vmulti->fail_msg);
                vmulti.reset();
+               discarded_compiles++;
             } else {
                assert(!vmulti->spilled_any_registers);
             }
@@ -1706,6 +1717,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                    "Dual-SIMD8 shader failed to compile: %s\n",
                                    vmulti->fail_msg);
                vmulti.reset();
+               discarded_compiles++;
             }
          }
       }
@@ -1726,6 +1738,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                 "SIMD32 shader failed to compile: %s\n",
                                 v32->fail_msg);
             v32.reset();
+            discarded_compiles++;
          } else {
             assert(v32->payload().num_regs % reg_unit(devinfo) == 0);
             prog_data->dispatch_grf_start_reg_32 = v32->payload().num_regs / reg_unit(devinfo);
@@ -1746,6 +1759,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                 "SIMD16 shader failed to compile: %s\n",
                                 v16->fail_msg);
             v16.reset();
+            discarded_compiles++;
          } else {
             assert(v16->payload().num_regs % reg_unit(devinfo) == 0);
             prog_data->dispatch_grf_start_reg_16 = v16->payload().num_regs / reg_unit(devinfo);
@@ -1770,6 +1784,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                 "SIMD16 shader failed to compile: %s\n",
                                 v16->fail_msg);
             v16.reset();
+            discarded_compiles++;
          } else {
             dispatch_width_limit = MIN2(dispatch_width_limit, v16->max_dispatch_width);
 
@@ -1806,6 +1821,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                 "SIMD32 shader failed to compile: %s\n",
                                 v32->fail_msg);
             v32.reset();
+            discarded_compiles++;
          } else {
             const brw_performance &perf = v32->performance_analysis.require();
 
@@ -1813,6 +1829,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                brw_shader_perf_log(compiler, params->base.log_data,
                                    "SIMD32 shader inefficient\n");
                v32.reset();
+               discarded_compiles++;
             } else {
                assert(v32->payload().num_regs % reg_unit(devinfo) == 0);
                prog_data->dispatch_grf_start_reg_32 = v32->payload().num_regs / reg_unit(devinfo);
@@ -1843,6 +1860,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                    "Quad-SIMD8 shader failed to compile: %s\n",
                                    vmulti->fail_msg);
                vmulti.reset();
+               discarded_compiles++;
             } else {
                assert(!vmulti->spilled_any_registers);
             }
@@ -1863,6 +1881,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                    "Dual-SIMD16 shader failed to compile: %s\n",
                                    vmulti->fail_msg);
                vmulti.reset();
+               discarded_compiles++;
             } else {
                assert(!vmulti->spilled_any_registers);
             }
@@ -1883,6 +1902,7 @@ brw_compile_fs(const struct brw_compiler *compiler,
                                    "Dual-SIMD8 shader failed to compile: %s\n",
                                    vmulti->fail_msg);
                vmulti.reset();
+               discarded_compiles++;
             }
          }
       }
@@ -1942,8 +1962,10 @@ brw_compile_fs(const struct brw_compiler *compiler,
       max_dispatch_width = 32;
    }
 
-   for (struct genisa_stats *s = params->base.stats; s != NULL && s != stats; s++)
+   for (struct genisa_stats *s = params->base.stats; s != NULL && s != stats; s++) {
       s->max_dispatch_width = max_dispatch_width;
+      s->discarded_compiles = discarded_compiles;
+   }
 
    g.add_const_data(nir->constant_data, nir->constant_data_size);
    return g.get_assembly();
@@ -140,6 +140,11 @@ struct brw_compiler {
     * Run-time performance of the shaders will be reduced since this
     * removes the ability to use a static analysis to estimate the
     * relative performance of the dispatch modes supported.
+    *
+    * The NIR register pressure estimate is used to predict which modes
+    * would spill, so that they don't have to be compiled to find out.
+    * Enabled by INTEL_SIMD_OPTIMISTIC or the intel_simd_fast_compile
+    * driconf option.
     */
    bool optimistic_simd_heuristic;
 
@@ -93,6 +93,99 @@ isl_memcpy_tiled_to_linear(uint32_t xt1, uint32_t xt2,
       tiling, copy_type);
 }
 
+/* The 2D single-sampled Tile64 layouts (acm_tile64_2d_*_swiz and
+ * xe2_tile64_2d_*_swiz) use the Tile4 swizzle for the low 12 address bits.
+ * A 64KB tile is thus made of sixteen 4KB Tile4 blocks: address bits 12 and
+ * up select U(7) and above for 3, 2 or 1 bits depending on the format size,
+ * and V(5) and above for the rest.  Returns log2 of the number of Tile4
+ * blocks across a Tile64 tile.
+ */
+static uint32_t
+isl_tile64_2d_blocks_x_log2(uint32_t format_bpb)
+{
+   switch (format_bpb) {
+   case 128:
+   case  64:
+      return 3;
+   case  32:
+   case  16:
+      return 2;
+   case   8:
+      return 1;
+   default:
+      UNREACHABLE("Unsupported format size for Tile64");
+   }
+}
+
+static void
+isl_memcpy_tile64(uint32_t xt1, uint32_t xt2,
+                  uint32_t yt1, uint32_t yt2,
+                  char *linear, int32_t linear_pitch,
+                  char *tiled, uint32_t tiled_pitch,
+                  uint32_t format_bpb, bool to_tiled,
+                  isl_memcpy_type copy_type)
+{
+   const uint32_t blk_w = 128, blk_h = 32;
+   const uint32_t blocks_x_log2 = isl_tile64_2d_blocks_x_log2(format_bpb);
+   const uint32_t tile_w = blk_w << blocks_x_log2;
+   const uint32_t tile_h = (64 * 1024) / tile_w;
+
+   /* Hand each 4KB block to the Tile4 copy as a surface one tile wide. */
+   for (uint32_t y = ALIGN_DOWN(yt1, blk_h); y < yt2; y += blk_h) {
+      const uint32_t y1 = MAX2(y, yt1), y2 = MIN2(y + blk_h, yt2);
+
+      for (uint32_t x = ALIGN_DOWN(xt1, blk_w); x < xt2; x += blk_w) {
+         const uint32_t x1 = MAX2(x, xt1), x2 = MIN2(x + blk_w, xt2);
+
+         const uint32_t blk = ((x % tile_w) / blk_w) |
+                              (((y % tile_h) / blk_h) << blocks_x_log2);
+         char *tiled_blk = tiled +
+                           (size_t)(y / tile_h) * tile_h * tiled_pitch +
+                           (size_t)(x / tile_w) * 64 * 1024 +
+                           blk * 4096;
+         char *linear_blk = linear +
+                            (ptrdiff_t)(y1 - yt1) * linear_pitch +
+                            (x1 - xt1);
+
+         if (to_tiled) {
+            isl_memcpy_linear_to_tiled(x1 - x, x2 - x, y1 - y, y2 - y,
+                                       tiled_blk, linear_blk,
+                                       blk_w, linear_pitch, false,
+                                       ISL_TILING_4, copy_type);
+         } else {
+            isl_memcpy_tiled_to_linear(x1 - x, x2 - x, y1 - y, y2 - y,
+                                       linear_blk, tiled_blk,
+                                       linear_pitch, blk_w, false,
+                                       ISL_TILING_4, copy_type);
+         }
+      }
+   }
+}
+
+void
+isl_memcpy_linear_to_tile64(uint32_t xt1, uint32_t xt2,
+                            uint32_t yt1, uint32_t yt2,
+                            char *dst, const char *src,
+                            uint32_t dst_pitch, int32_t src_pitch,
+                            uint32_t format_bpb,
+                            isl_memcpy_type copy_type)
+{
+   isl_memcpy_tile64(xt1, xt2, yt1, yt2, (char *)src, src_pitch,
+                     dst, dst_pitch, format_bpb, true, copy_type);
+}
+
+void
+isl_memcpy_tile64_to_linear(uint32_t xt1, uint32_t xt2,
+                            uint32_t yt1, uint32_t yt2,
+                            char *dst, const char *src,
+                            int32_t dst_pitch, uint32_t src_pitch,
+                            uint32_t format_bpb,
+                            isl_memcpy_type copy_type)
+{
+   isl_memcpy_tile64(xt1, xt2, yt1, yt2, dst, dst_pitch,
+                     (char *)src, src_pitch, format_bpb, false, copy_type);
+}
+
 void PRINTFLIKE(3, 4) UNUSED
 __isl_finishme(const char *file, int line, const char *fmt, ...)
 {
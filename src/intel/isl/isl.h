@@ -3309,6 +3309,34 @@ isl_memcpy_tiled_to_linear(uint32_t xt1, uint32_t xt2,
                            enum isl_tiling tiling,
                            isl_memcpy_type copy_type);
 
+/**
+ * Performs a copy from linear to a Tile64 surface
+ *
+ * Same as isl_memcpy_linear_to_tiled() for ISL_TILING_64 and
+ * ISL_TILING_64_XE2, whose layout depends on the format size.  Only valid
+ * for 2D surfaces that are single-sampled or use ISL_MSAA_LAYOUT_INTERLEAVED.
+ */
+void
+isl_memcpy_linear_to_tile64(uint32_t xt1, uint32_t xt2,
+                            uint32_t yt1, uint32_t yt2,
+                            char *dst, const char *src,
+                            uint32_t dst_pitch, int32_t src_pitch,
+                            uint32_t format_bpb,
+                            isl_memcpy_type copy_type);
+
+/**
+ * Performs a copy from a Tile64 surface to linear
+ *
+ * See isl_memcpy_linear_to_tile64().
+ */
+void
+isl_memcpy_tile64_to_linear(uint32_t xt1, uint32_t xt2,
+                            uint32_t yt1, uint32_t yt2,
+                            char *dst, const char *src,
+                            int32_t dst_pitch, uint32_t src_pitch,
+                            uint32_t format_bpb,
+                            isl_memcpy_type copy_type);
+
 /**
  * Computes the tile_w (in bytes) and tile_h (in rows) of
  * different tiling patterns.
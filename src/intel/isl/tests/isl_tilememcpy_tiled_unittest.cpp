@@ -31,6 +31,9 @@
 #define LIN_OFF(y, tw, x) ((y * tw) + x)
 #define IMAGE_FORMAT ISL_FORMAT_R32G32B32_UINT
 #define TILEW_IMAGE_FORMAT ISL_FORMAT_R8_UINT
+#define TILE64_128BPP_IMAGE_FORMAT ISL_FORMAT_R32G32B32A32_UINT
+#define TILE64_32BPP_IMAGE_FORMAT ISL_FORMAT_R32_UINT
+#define TILE64_8BPP_IMAGE_FORMAT ISL_FORMAT_R8_UINT
 
 enum TILE_CONV {LIN_TO_TILE, TILE_TO_LIN};
 
@@ -65,8 +68,15 @@ typedef uint8_t *(*swizzle_func_t)(const uint8_t *base_addr, uint32_t pitch, uin
    std::make_tuple(  0, 128,  0, 64),    \
    std::make_tuple(  0, 128,  0,128)
 
+#define FULL_TILE64_COORDINATES \
+   std::make_tuple(  0,  64,  0, 64),    \
+   std::make_tuple(  0, 128,  0, 64),    \
+   std::make_tuple(  0, 256,  0,256),    \
+   std::make_tuple( 37, 300, 70,300)
+
 struct tile_swizzle_ops {
    enum isl_tiling tiling;
+   uint32_t format_bpb; /* 0 if the layout doesn't depend on it */
    swizzle_func_t linear_to_tile_swizzle;
 };
 
@@ -174,11 +184,58 @@ uint8_t *linear_to_tileW_swizzle(const uint8_t *base_addr, uint32_t pitch, uint3
    return (uint8_t *) (base_addr + tiled_off);
 }
 
+uint8_t *linear_to_tile64_swizzle(const uint8_t *base_addr, uint32_t pitch,
+                                  uint32_t x_B, uint32_t y_px,
+                                  uint32_t cu, uint32_t cv)
+{
+   const uint32_t tile_id = (y_px >> cv) * (pitch >> cu) + (x_B >> cu);
+
+   /* The table below represents the mapping from coordinate (x_B, y_px) to
+    * byte offset in a 1Bpp image, the low 12 bits being the Tile-4 ones:
+    *
+    *    Bit ind  : 15 14 13 12 11 10  9  8  7  6  5  4  3  2  1  0
+    *    128/64bpp: v5 u9 u8 u7 v4 v3 u6 v2 u5 u4 v1 v0 u3 u2 u1 u0
+    *     32/16bpp: v6 v5 u8 u7 v4 v3 u6 v2 u5 u4 v1 v0 u3 u2 u1 u0
+    *         8bpp: v7 v6 v5 u7 v4 v3 u6 v2 u5 u4 v1 v0 u3 u2 u1 u0
+    */
+   uint32_t tiled_off;
+
+   tiled_off = tile_id * 65536 |
+               swizzle_bitops(x_B, 4, 0, 0) |
+               swizzle_bitops(y_px, 2, 0, 4) |
+               swizzle_bitops(x_B, 2, 4, 6) |
+               swizzle_bitops(y_px, 1, 2, 8) |
+               swizzle_bitops(x_B, 1, 6, 9) |
+               swizzle_bitops(y_px, 2, 3, 10) |
+               swizzle_bitops(x_B, cu - 7, 7, 12) |
+               swizzle_bitops(y_px, cv - 5, 5, 12 + cu - 7);
+
+   return (uint8_t *) (base_addr + tiled_off);
+}
+
+uint8_t *linear_to_tile64_128bpp_swizzle(const uint8_t *base_addr, uint32_t pitch, uint32_t x_B, uint32_t y_px)
+{
+   return linear_to_tile64_swizzle(base_addr, pitch, x_B, y_px, 10, 6);
+}
+
+uint8_t *linear_to_tile64_32bpp_swizzle(const uint8_t *base_addr, uint32_t pitch, uint32_t x_B, uint32_t y_px)
+{
+   return linear_to_tile64_swizzle(base_addr, pitch, x_B, y_px, 9, 7);
+}
+
+uint8_t *linear_to_tile64_8bpp_swizzle(const uint8_t *base_addr, uint32_t pitch, uint32_t x_B, uint32_t y_px)
+{
+   return linear_to_tile64_swizzle(base_addr, pitch, x_B, y_px, 8, 8);
+}
+
 struct tile_swizzle_ops swizzle_opers[] = {
-   {ISL_TILING_Y0, linear_to_tileY_swizzle},
-   {ISL_TILING_4, linear_to_tile4_swizzle},
-   {ISL_TILING_X, linear_to_tileX_swizzle},
-   {ISL_TILING_W, linear_to_tileW_swizzle},
+   {ISL_TILING_Y0, 0, linear_to_tileY_swizzle},
+   {ISL_TILING_4, 0, linear_to_tile4_swizzle},
+   {ISL_TILING_X, 0, linear_to_tileX_swizzle},
+   {ISL_TILING_W, 0, linear_to_tileW_swizzle},
+   {ISL_TILING_64, 128, linear_to_tile64_128bpp_swizzle},
+   {ISL_TILING_64, 32, linear_to_tile64_32bpp_swizzle},
+   {ISL_TILING_64, 8, linear_to_tile64_8bpp_swizzle},
 };
 
 class tileTFixture: public ::testing::Test {
@@ -197,6 +254,7 @@ protected:
    uint32_t linear_pitch_B;
    uint32_t linear_sz;
    uint32_t fmt_bs; /* format bytes per block */
+   uint32_t fmt_bpb;
    TILE_CONV conv;
    struct tile_swizzle_ops ops;
    bool print_results;
@@ -236,6 +294,11 @@ class tileWFixture : public tileTFixture,
                                                                      int, int>>
 {};
 
+class tile64Fixture : public tileTFixture,
+                      public ::testing::WithParamInterface<std::tuple<int, int,
+                                                                      int, int>>
+{};
+
 void tileTFixture::test_setup(TILE_CONV convert,
                          enum isl_tiling tiling_fmt,
                          enum isl_format format,
@@ -247,6 +310,7 @@ void tileTFixture::test_setup(TILE_CONV convert,
    const struct isl_format_layout *fmtl = isl_format_get_layout(format);
    conv = convert;
    fmt_bs = fmtl->bpb / 8;
+   fmt_bpb = fmtl->bpb;
    ops.tiling = tiling_fmt;
 
    isl_tiling_get_info(tiling_fmt, ISL_SURF_DIM_2D, ISL_MSAA_LAYOUT_NONE,
@@ -275,7 +339,9 @@ void tileTFixture::test_setup(TILE_CONV convert,
    ASSERT_TRUE(buf_src != nullptr);
 
    for (uint8_t i = 0; i < ARRAY_SIZE(swizzle_opers); i++)
-      if (ops.tiling == swizzle_opers[i].tiling)
+      if (ops.tiling == swizzle_opers[i].tiling &&
+          (swizzle_opers[i].format_bpb == 0 ||
+           swizzle_opers[i].format_bpb == fmt_bpb))
          ops.linear_to_tile_swizzle = swizzle_opers[i].linear_to_tile_swizzle;
 
    memset(buf_src, 0xcc, buf_src_size_B);
@@ -330,7 +396,20 @@ void tileTFixture::convert_texture(uint32_t x1_el, uint32_t x2_el, uint32_t y1_e
 
    uint32_t linear_offset_B = LIN_OFF(y1_el, linear_pitch_B, x1_el * fmt_bs);
 
-   if (conv == LIN_TO_TILE)
+   if (isl_tiling_is_64(ops.tiling)) {
+      if (conv == LIN_TO_TILE)
+         isl_memcpy_linear_to_tile64(x1_el * fmt_bs, x2_el * fmt_bs, y1_el, y2_el,
+                                     (char *)buf_dst,
+                                     (const char *)buf_src + linear_offset_B,
+                                     tiled_pitch_B, linear_pitch_B,
+                                     fmt_bpb, ISL_MEMCPY);
+      else
+         isl_memcpy_tile64_to_linear(x1_el * fmt_bs, x2_el * fmt_bs, y1_el, y2_el,
+                                     (char *)buf_dst + linear_offset_B,
+                                     (const char *)buf_src,
+                                     linear_pitch_B, tiled_pitch_B,
+                                     fmt_bpb, ISL_MEMCPY);
+   } else if (conv == LIN_TO_TILE)
       isl_memcpy_linear_to_tiled(x1_el * fmt_bs, x2_el * fmt_bs, y1_el, y2_el,
                                  (char *)buf_dst,
                                  (const char *)buf_src + linear_offset_B,
@@ -461,6 +540,32 @@ TEST_P(tileWFixture, tiletolin)
     run_test(x1, x2, y1, y2);
 }
 
+TEST_P(tile64Fixture, lintotile)
+{
+    auto [x1, x2, y1, y2] = GetParam();
+    for (auto format : {TILE64_128BPP_IMAGE_FORMAT, TILE64_32BPP_IMAGE_FORMAT,
+                        TILE64_8BPP_IMAGE_FORMAT}) {
+       test_setup(LIN_TO_TILE, ISL_TILING_64, format, x2, y2);
+       if (print_results)
+          printf("Coordinates: x1=%d x2=%d y1=%d y2=%d \n", x1, x2, y1, y2);
+       run_test(x1, x2, y1, y2);
+       TearDown();
+    }
+}
+
+TEST_P(tile64Fixture, tiletolin)
+{
+    auto [x1, x2, y1, y2] = GetParam();
+    for (auto format : {TILE64_128BPP_IMAGE_FORMAT, TILE64_32BPP_IMAGE_FORMAT,
+                        TILE64_8BPP_IMAGE_FORMAT}) {
+       test_setup(TILE_TO_LIN, ISL_TILING_64, format, x2, y2);
+       if (print_results)
+          printf("Coordinates: x1=%d x2=%d y1=%d y2=%d \n", x1, x2, y1, y2);
+       run_test(x1, x2, y1, y2);
+       TearDown();
+    }
+}
+
 
 INSTANTIATE_TEST_SUITE_P(tileY, tileYFixture, testing::Values(TILE_COORDINATES,
                                                               FULL_TILEY_COORDINATES));
@@ -470,3 +575,5 @@ INSTANTIATE_TEST_SUITE_P(tileX, tileXFixture, testing::Values(TILE_COORDINATES,
                                                               FULL_TILEX_COORDINATES));
 INSTANTIATE_TEST_SUITE_P(tileW, tileWFixture, testing::Values(TILE_COORDINATES,
                                                               FULL_TILEW_COORDINATES));
+INSTANTIATE_TEST_SUITE_P(tile64, tile64Fixture, testing::Values(TILE_COORDINATES,
+                                                                FULL_TILE64_COORDINATES));
@@ -254,6 +254,20 @@ anv_batch_bo_create(struct anv_cmd_buffer *cmd_buffer,
 {
    VkResult result;
 
+   /* Reuse a batch buffer from a previous recording if it's big enough.
+    * Callers set the batch up from the BO's actual size.
+    */
+   list_for_each_entry(struct anv_batch_bo, bbo, &cmd_buffer->free_batch_bos, link) {
+      if (bbo->bo->size >= size) {
+         list_del(&bbo->link);
+         anv_reloc_list_clear(&bbo->relocs);
+         bbo->length = 0;
+         bbo->chained = false;
+         *bbo_out = bbo;
+         return VK_SUCCESS;
+      }
+   }
+
    struct anv_batch_bo *bbo = vk_zalloc(&cmd_buffer->vk.pool->alloc, sizeof(*bbo),
                                         8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
    if (bbo == NULL)
@@ -875,6 +889,7 @@ anv_cmd_buffer_init_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer)
    VkResult result;
 
    list_inithead(&cmd_buffer->batch_bos);
+   list_inithead(&cmd_buffer->free_batch_bos);
 
    cmd_buffer->total_batch_size = 0;
 
@@ -963,6 +978,11 @@ anv_cmd_buffer_fini_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer)
       list_del(&bbo->link);
       anv_batch_bo_destroy(bbo, cmd_buffer);
    }
+   list_for_each_entry_safe(struct anv_batch_bo, bbo,
+                            &cmd_buffer->free_batch_bos, link) {
+      list_del(&bbo->link);
+      anv_batch_bo_destroy(bbo, cmd_buffer);
+   }
 
    if (cmd_buffer->generation.ring_bo) {
       ANV_DMR_BO_FREE(&cmd_buffer->vk.base, cmd_buffer->generation.ring_bo);
@@ -972,17 +992,32 @@ anv_cmd_buffer_fini_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer)
 }
 
 void
-anv_cmd_buffer_reset_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer)
+anv_cmd_buffer_reset_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer,
+                                    VkCommandBufferResetFlags flags)
 {
-   /* Delete all but the first batch bo */
+   /* Keep all but the first batch bo for the next recording, unless we're
+    * asked to give the memory back.
+    */
+   const bool release = flags & VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT;
    assert(!list_is_empty(&cmd_buffer->batch_bos));
    while (cmd_buffer->batch_bos.next != cmd_buffer->batch_bos.prev) {
       struct anv_batch_bo *bbo = anv_cmd_buffer_current_batch_bo(cmd_buffer);
       list_del(&bbo->link);
-      anv_batch_bo_destroy(bbo, cmd_buffer);
+      if (release)
+         anv_batch_bo_destroy(bbo, cmd_buffer);
+      else
+         list_add(&bbo->link, &cmd_buffer->free_batch_bos);
    }
    assert(!list_is_empty(&cmd_buffer->batch_bos));
 
+   if (release) {
+      list_for_each_entry_safe(struct anv_batch_bo, bbo,
+                               &cmd_buffer->free_batch_bos, link) {
+         list_del(&bbo->link);
+         anv_batch_bo_destroy(bbo, cmd_buffer);
+      }
+   }
+
    anv_batch_bo_start(anv_cmd_buffer_current_batch_bo(cmd_buffer),
                       &cmd_buffer->batch,
                       GFX9_MI_BATCH_BUFFER_START_length * 4);
@@ -1006,11 +1041,14 @@ anv_cmd_buffer_reset_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer)
    assert(first_bbo->bo->size == ANV_MIN_CMD_BUFFER_BATCH_SIZE);
    cmd_buffer->batch.allocated_batch_size = first_bbo->bo->size;
 
-   /* Delete all generation batch bos */
+   /* Release all generation batch bos */
    list_for_each_entry_safe(struct anv_batch_bo, bbo,
                             &cmd_buffer->generation.batch_bos, link) {
       list_del(&bbo->link);
-      anv_batch_bo_destroy(bbo, cmd_buffer);
+      if (release)
+         anv_batch_bo_destroy(bbo, cmd_buffer);
+      else
+         list_add(&bbo->link, &cmd_buffer->free_batch_bos);
    }
 
    /* And reset generation batch */
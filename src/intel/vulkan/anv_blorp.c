@@ -1153,11 +1153,25 @@ void anv_CmdCopyBuffer2(
 
    for (unsigned r = 0; r < pCopyBufferInfo->regionCount; r++) {
       const VkBufferCopy2 *region = &pCopyBufferInfo->pRegions[r];
+      VkDeviceSize size = region->size;
+
+      /* Each region costs at least one BLORP operation, so merge the
+       * following regions as long as they continue this one in both buffers.
+       */
+      while (r + 1 < pCopyBufferInfo->regionCount) {
+         const VkBufferCopy2 *next = &pCopyBufferInfo->pRegions[r + 1];
+         if (next->srcOffset != region->srcOffset + size ||
+             next->dstOffset != region->dstOffset + size)
+            break;
+
+         size += next->size;
+         r++;
+      }
 
       copy_memory(cmd_buffer->device, &batch,
                   anv_address_add(src_buffer->address, region->srcOffset),
                   anv_address_add(dst_buffer->address, region->dstOffset),
-                  region->size);
+                  size);
    }
 
    anv_add_buffer_write_pending_bits(cmd_buffer, "after copy buffer");
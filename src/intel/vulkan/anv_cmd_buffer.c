@@ -251,14 +251,14 @@ anv_cmd_buffer_destroy(struct vk_command_buffer *vk_cmd_buffer)
 
 static void
 reset_cmd_buffer(struct anv_cmd_buffer *cmd_buffer,
-                 UNUSED VkCommandBufferResetFlags flags)
+                 VkCommandBufferResetFlags flags)
 {
    vk_command_buffer_reset(&cmd_buffer->vk);
 
    cmd_buffer->usage_flags = 0;
    cmd_buffer->perf_query_pool = NULL;
    cmd_buffer->is_companion_rcs_cmd_buffer = false;
-   anv_cmd_buffer_reset_batch_bo_chain(cmd_buffer);
+   anv_cmd_buffer_reset_batch_bo_chain(cmd_buffer, flags);
    anv_cmd_state_reset(cmd_buffer);
 
    memset(&cmd_buffer->generation.shader_state, 0,
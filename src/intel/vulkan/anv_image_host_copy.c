@@ -161,7 +161,19 @@ anv_copy_image_memory(struct anv_device *device,
       tile_extents(surf, offset_el, extent_el, level, img_depth_or_layer,
                    &x1, &x2, &y1, &y2);
 
-      if (mem_to_img) {
+      /* Only the 2D single-sampled Tile64 layouts are handled by ISL. */
+      assert(!isl_tiling_is_64(surf->tiling) ||
+             (surf->dim == ISL_SURF_DIM_2D && surf->samples == 1));
+
+      if (mem_to_img && isl_tiling_is_64(surf->tiling)) {
+         isl_memcpy_linear_to_tile64(x1, x2, y1, y2,
+                                     img_ptr,
+                                     mem_ptr,
+                                     surf->row_pitch_B,
+                                     mem_row_pitch_B,
+                                     fmt_layout->bpb,
+                                     ISL_MEMCPY);
+      } else if (mem_to_img) {
          isl_memcpy_linear_to_tiled(x1, x2, y1, y2,
                                     img_ptr,
                                     mem_ptr,
@@ -171,18 +183,30 @@ anv_copy_image_memory(struct anv_device *device,
                                     surf->tiling,
                                     ISL_MEMCPY);
       } else {
-         isl_memcpy_tiled_to_linear(x1, x2, y1, y2,
-                                    mem_ptr,
-                                    img_ptr,
-                                    mem_row_pitch_B,
-                                    surf->row_pitch_B,
-                                    false,
-                                    surf->tiling,
+         const isl_memcpy_type copy_type =
 #if defined(USE_SSE41)
-                                    util_get_cpu_caps()->has_sse4_1 ?
-                                    ISL_MEMCPY_STREAMING_LOAD :
+            util_get_cpu_caps()->has_sse4_1 ? ISL_MEMCPY_STREAMING_LOAD :
 #endif
-                                    ISL_MEMCPY);
+            ISL_MEMCPY;
+
+         if (isl_tiling_is_64(surf->tiling)) {
+            isl_memcpy_tile64_to_linear(x1, x2, y1, y2,
+                                        mem_ptr,
+                                        img_ptr,
+                                        mem_row_pitch_B,
+                                        surf->row_pitch_B,
+                                        fmt_layout->bpb,
+                                        copy_type);
+         } else {
+            isl_memcpy_tiled_to_linear(x1, x2, y1, y2,
+                                       mem_ptr,
+                                       img_ptr,
+                                       mem_row_pitch_B,
+                                       surf->row_pitch_B,
+                                       false,
+                                       surf->tiling,
+                                       copy_type);
+         }
       }
    }
 
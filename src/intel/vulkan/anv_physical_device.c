@@ -2806,6 +2806,8 @@ anv_physical_device_try_create(struct vk_instance *vk_instance,
    device->compiler->use_bindless_sampler_offset = false;
    device->compiler->spilling_rate =
       driQueryOptioni(&instance->dri_options, "shader_spilling_rate");
+   device->compiler->optimistic_simd_heuristic |=
+      driQueryOptionb(&instance->dri_options, "intel_simd_fast_compile");
 
    isl_device_init(&device->isl_dev, &device->info);
    device->isl_dev.buffer_length_in_aux_addr = !intel_needs_workaround(device->isl_dev.info, 14019708328);
@@ -4804,6 +4804,14 @@ struct anv_cmd_buffer {
    struct list_head                             batch_bos;
    enum anv_cmd_buffer_exec_mode                exec_mode;
 
+   /* Batch buffers released by a previous reset, reused before allocating
+    * new ones from the device's batch_bo_pool so that re-recording doesn't
+    * contend with the other recording threads.
+    *
+    * initialized by anv_cmd_buffer_init_batch_bo_chain()
+    */
+   struct list_head                             free_batch_bos;
+
    /* A vector of anv_batch_bo pointers for every batch or surface buffer
     * referenced by this command buffer
     *
@@ -5022,7 +5030,8 @@ anv_cmd_buffer_has_gfx_stage(struct anv_cmd_buffer *cmd_buffer,
 
 VkResult anv_cmd_buffer_init_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer);
 void anv_cmd_buffer_fini_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer);
-void anv_cmd_buffer_reset_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer);
+void anv_cmd_buffer_reset_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer,
+                                         VkCommandBufferResetFlags flags);
 void anv_cmd_buffer_end_batch_buffer(struct anv_cmd_buffer *cmd_buffer);
 void anv_cmd_buffer_add_secondary(struct anv_cmd_buffer *primary,
                                   struct anv_cmd_buffer *secondary);
@@ -90,6 +90,22 @@ get_slab_pot_entry_size(struct anv_device *device, unsigned size)
    return MAX2(entry_size, min_entry_size);
 }
 
+/* Return the alignment of a slab entry matching the input size.
+ *
+ * Sizes that fit in 3/4 of a power of two are allocated from slabs with 3/4
+ * sized entries, which are only aligned to a quarter of the power of two.
+ */
+static unsigned
+get_slab_entry_alignment(struct anv_device *device, unsigned size)
+{
+   unsigned entry_size = get_slab_pot_entry_size(device, size);
+
+   if (size <= entry_size * 3 / 4)
+      return entry_size / 4;
+
+   return entry_size;
+}
+
 static struct pb_slabs *
 get_slabs(struct anv_device *device, uint64_t size)
 {
@@ -140,7 +156,12 @@ anv_slab_bo_alloc(struct anv_device *device, const char *name, uint64_t requeste
       return NULL;
 
    uint64_t alloc_size = MAX2(alignment, requested_size);
-   alloc_size = get_slab_pot_entry_size(device, alloc_size);
+
+   /* 3/4 entries might not be aligned enough, fall back to a power of two
+    * entry in that case.
+    */
+   if (alignment > get_slab_entry_alignment(device, alloc_size))
+      alloc_size = get_slab_pot_entry_size(device, alloc_size);
 
    if (alloc_size > max_slab_entry_size)
          return NULL;
@@ -264,9 +285,10 @@ anv_slab_alloc(void *priv,
 
    struct pb_slabs *slabs = get_slabs(device, entry_size);
 
-   entry_size = MAX2(entry_size, 1ULL << slabs->min_order);
-   if (!util_is_power_of_two_nonzero(entry_size))
-      entry_size = util_next_power_of_two(entry_size);
+   /* Entries are either a power of two or 3/4 of one. */
+   assert(entry_size >= (1u << slabs->min_order) * 3 / 4);
+   assert(util_is_power_of_two_nonzero(entry_size) ||
+          util_is_power_of_two_nonzero(entry_size / 3));
 
    unsigned slab_parent_size = entry_size * 8;
    /* allocate at least a 2MB buffer, this allows KMD to enable THP for this bo */
@@ -354,7 +376,7 @@ anv_slab_bo_init(struct anv_device *device)
                                       max_slab_order);
 
       if (!pb_slabs_init(&device->bo_slabs[i], min_order, max_order,
-                         heap_max_get(device), false, device,
+                         heap_max_get(device), true, device,
                          anv_can_reclaim_slab,
                          anv_slab_alloc,
                          anv_slab_free)) {
@@ -9,7 +9,13 @@
 
 #include "mtl_types.h"
 
+#include <stdint.h>
+
 mtl_library *mtl_new_library(mtl_device *device, const char *src);
+/* Compiles all sources concurrently and waits for them. libs_out[i] is NULL
+ * if srcs[i] failed to compile. */
+void mtl_new_libraries(mtl_device *device, uint32_t count,
+                       const char *const *srcs, mtl_library **libs_out);
 mtl_function *mtl_new_function_with_name(mtl_library *lib,
                                          const char *entry_point);
 
@@ -7,6 +7,17 @@
 #include "mtl_library.h"
 
 #include <Metal/MTLDevice.h>
+#include <dispatch/dispatch.h>
+
+static MTLCompileOptions *
+mtl_new_compile_options(void)
+{
+   MTLCompileOptions *comp_opts = [MTLCompileOptions new];
+   comp_opts.languageVersion = MTLLanguageVersion3_2;
+   comp_opts.mathMode = MTLMathModeSafe;
+   comp_opts.mathFloatingPointFunctions = MTLMathFloatingPointFunctionsPrecise;
+   return comp_opts;
+}
 
 mtl_library *
 mtl_new_library(mtl_device *device, const char *src)
@@ -16,10 +27,7 @@ mtl_new_library(mtl_device *device, const char *src)
       id<MTLLibrary> lib = NULL;
       NSString *nsstr = [NSString stringWithCString:src encoding:NSASCIIStringEncoding];
       NSError *error;
-      MTLCompileOptions *comp_opts = [MTLCompileOptions new];
-      comp_opts.languageVersion = MTLLanguageVersion3_2;
-      comp_opts.mathMode = MTLMathModeSafe;
-      comp_opts.mathFloatingPointFunctions = MTLMathFloatingPointFunctionsPrecise;
+      MTLCompileOptions *comp_opts = mtl_new_compile_options();
       lib = [dev newLibraryWithSource:nsstr options:comp_opts error:&error];
 
       if (error != nil) {
@@ -31,6 +39,36 @@ mtl_new_library(mtl_device *device, const char *src)
    }
 }
 
+void
+mtl_new_libraries(mtl_device *device, uint32_t count, const char *const *srcs,
+                  mtl_library **libs_out)
+{
+   @autoreleasepool {
+      id<MTLDevice> dev = (id<MTLDevice>)device;
+      MTLCompileOptions *comp_opts = mtl_new_compile_options();
+      dispatch_group_t group = dispatch_group_create();
+
+      for (uint32_t i = 0; i < count; i++) {
+         NSString *nsstr = [NSString stringWithCString:srcs[i] encoding:NSASCIIStringEncoding];
+         libs_out[i] = NULL;
+         dispatch_group_enter(group);
+         [dev newLibraryWithSource:nsstr options:comp_opts
+                 completionHandler:^(id<MTLLibrary> lib, NSError *error) {
+            if (error != nil) {
+               fprintf(stderr, "Failed to create MTLLibrary: %s\n", [error.localizedDescription UTF8String]);
+            }
+            /* The library is only valid during the handler. */
+            libs_out[i] = [lib retain];
+            dispatch_group_leave(group);
+         }];
+      }
+
+      dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+      dispatch_release(group);
+      [comp_opts release];
+   }
+}
+
 mtl_function *
 mtl_new_function_with_name(mtl_library *lib, const char *entry_point)
 {
@@ -12,6 +12,14 @@ mtl_new_library(mtl_device *device, const char *src)
    return NULL;
 }
 
+void
+mtl_new_libraries(mtl_device *device, uint32_t count, const char *const *srcs,
+                  mtl_library **libs_out)
+{
+   for (uint32_t i = 0; i < count; i++)
+      libs_out[i] = NULL;
+}
+
 mtl_function *
 mtl_new_function_with_name(mtl_library *lib, const char *entry_point)
 {
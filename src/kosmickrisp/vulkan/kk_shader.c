@@ -889,20 +889,20 @@ kk_compile_graphics_pipeline(struct kk_device *device,
    assert(vertex_shader->info.stage == MESA_SHADER_VERTEX &&
           fragment_shader->info.stage == MESA_SHADER_FRAGMENT);
 
-   mtl_library *vertex_library =
-      mtl_new_library(device->mtl_handle, vertex_shader->msl_code);
-   if (vertex_library == NULL)
+   /* MSL compilation is the slow part, compile both stages concurrently */
+   const char *srcs[] = {vertex_shader->msl_code, fragment_shader->msl_code};
+   mtl_library *libraries[ARRAY_SIZE(srcs)];
+   mtl_new_libraries(device->mtl_handle, ARRAY_SIZE(srcs), srcs, libraries);
+   mtl_library *vertex_library = libraries[0];
+   mtl_library *fragment_library = libraries[1];
+   if (vertex_library == NULL || fragment_library == NULL) {
+      mtl_release(vertex_library);
+      mtl_release(fragment_library);
       return VK_ERROR_INVALID_SHADER_NV;
+   }
 
    mtl_function *vertex_function = mtl_new_function_with_name(
       vertex_library, vertex_shader->entrypoint_name);
-
-   mtl_library *fragment_library =
-      mtl_new_library(device->mtl_handle, fragment_shader->msl_code);
-   if (fragment_library == NULL) {
-      result = VK_ERROR_INVALID_SHADER_NV;
-      goto destroy_vertex;
-   }
    mtl_function *fragment_function = mtl_new_function_with_name(
       fragment_library, fragment_shader->entrypoint_name);
 
@@ -976,7 +976,6 @@ kk_compile_graphics_pipeline(struct kk_device *device,
    mtl_release(pipeline_descriptor);
    mtl_release(fragment_function);
    mtl_release(fragment_library);
-destroy_vertex:
    mtl_release(vertex_function);
    mtl_release(vertex_library);
 
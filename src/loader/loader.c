@@ -51,6 +51,7 @@
 #include "util/libdrm.h"
 #include "util/os_file.h"
 #include "util/os_misc.h"
+#include "util/simple_mtx.h"
 #include "util/u_debug.h"
 #include "git_sha1.h"
 
@@ -332,47 +333,95 @@ static const driOptionDescription __driConfigOptionsLoader[] = {
     DRI_CONF_SECTION_END
 };
 
-static char *loader_get_dri_config_driver(int fd)
+/* The loader options only depend on the driconf files and the kernel
+ * driver name, so remember them for the life of the process instead of
+ * parsing the XML again for every screen that gets opened.
+ */
+#define LOADER_DRICONF_CACHE_SIZE 8
+
+static simple_mtx_t loader_driconf_mtx = SIMPLE_MTX_INITIALIZER;
+
+static struct {
+   char *kernel_driver;
+   char *dri_driver;
+} loader_driconf_drivers[LOADER_DRICONF_CACHE_SIZE];
+static unsigned loader_driconf_num_drivers;
+
+static bool loader_driconf_device_id_parsed;
+static char *loader_driconf_device_id;
+
+static char *
+loader_parse_dri_config_option(const char *kernel_driver, const char *name)
 {
    driOptionCache defaultInitOptions;
    driOptionCache userInitOptions;
-   char *dri_driver = NULL;
-   char *kernel_driver = loader_get_kernel_driver_name(fd);
+   char *value = NULL;
 
    driParseOptionInfo(&defaultInitOptions, __driConfigOptionsLoader,
                       ARRAY_SIZE(__driConfigOptionsLoader));
    driParseConfigFiles(&userInitOptions, &defaultInitOptions, 0,
                        "loader", kernel_driver, NULL, NULL, 0, NULL, 0);
-   if (driCheckOption(&userInitOptions, "dri_driver", DRI_STRING)) {
-      char *opt = driQueryOptionstr(&userInitOptions, "dri_driver");
+   if (driCheckOption(&userInitOptions, name, DRI_STRING)) {
+      char *opt = driQueryOptionstr(&userInitOptions, name);
       /* not an empty string */
       if (*opt)
-         dri_driver = strdup(opt);
+         value = strdup(opt);
    }
    driDestroyOptionCache(&userInitOptions);
    driDestroyOptionInfo(&defaultInitOptions);
 
+   return value;
+}
+
+static char *loader_get_dri_config_driver(int fd)
+{
+   char *dri_driver = NULL;
+   char *kernel_driver = loader_get_kernel_driver_name(fd);
+
+   simple_mtx_lock(&loader_driconf_mtx);
+
+   for (unsigned i = 0; i < loader_driconf_num_drivers; i++) {
+      if (!strcmp(loader_driconf_drivers[i].kernel_driver,
+                  kernel_driver ? kernel_driver : "")) {
+         if (loader_driconf_drivers[i].dri_driver)
+            dri_driver = strdup(loader_driconf_drivers[i].dri_driver);
+         goto out;
+      }
+   }
+
+   dri_driver = loader_parse_dri_config_option(kernel_driver, "dri_driver");
+
+   if (loader_driconf_num_drivers < LOADER_DRICONF_CACHE_SIZE) {
+      unsigned i = loader_driconf_num_drivers++;
+      loader_driconf_drivers[i].kernel_driver =
+         strdup(kernel_driver ? kernel_driver : "");
+      loader_driconf_drivers[i].dri_driver =
+         dri_driver ? strdup(dri_driver) : NULL;
+   }
+
+out:
+   simple_mtx_unlock(&loader_driconf_mtx);
+
    free(kernel_driver);
    return dri_driver;
 }
 
 static char *loader_get_dri_config_device_id(void)
 {
-   driOptionCache defaultInitOptions;
-   driOptionCache userInitOptions;
    char *prime = NULL;
 
-   driParseOptionInfo(&defaultInitOptions, __driConfigOptionsLoader,
-                      ARRAY_SIZE(__driConfigOptionsLoader));
-   driParseConfigFiles(&userInitOptions, &defaultInitOptions, 0,
-                       "loader", NULL, NULL, NULL, 0, NULL, 0);
-   if (driCheckOption(&userInitOptions, "device_id", DRI_STRING)) {
-      char *opt = driQueryOptionstr(&userInitOptions, "device_id");
-      if (*opt)
-         prime = strdup(opt);
+   simple_mtx_lock(&loader_driconf_mtx);
+
+   if (!loader_driconf_device_id_parsed) {
+      loader_driconf_device_id =
+         loader_parse_dri_config_option(NULL, "device_id");
+      loader_driconf_device_id_parsed = true;
    }
-   driDestroyOptionCache(&userInitOptions);
-   driDestroyOptionInfo(&defaultInitOptions);
+
+   if (loader_driconf_device_id)
+      prime = strdup(loader_driconf_device_id);
+
+   simple_mtx_unlock(&loader_driconf_mtx);
 
    return prime;
 }
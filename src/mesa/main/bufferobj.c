@@ -580,7 +580,7 @@ bufferobj_copy_subdata(struct gl_context *ctx,
    struct pipe_context *pipe = ctx->pipe;
    struct pipe_box box;
 
-   dst->MinMaxCacheDirty = true;
+   _mesa_bufferobj_minmax_dirty(dst, writeOffset, size);
    if (!size)
       return;
 
@@ -2145,7 +2145,7 @@ buffer_storage(struct gl_context *ctx, struct gl_buffer_object *bufObj,
    FLUSH_VERTICES(ctx, 0, 0);
 
    bufObj->Immutable = GL_TRUE;
-   bufObj->MinMaxCacheDirty = true;
+   _mesa_bufferobj_minmax_dirty(bufObj, 0, size);
 
    if (memObj) {
       res = bufferobj_data_mem(ctx, target, size, memObj, offset,
@@ -2390,7 +2390,7 @@ buffer_data(struct gl_context *ctx, struct gl_buffer_object *bufObj,
 
    FLUSH_VERTICES(ctx, 0, 0);
 
-   bufObj->MinMaxCacheDirty = true;
+   _mesa_bufferobj_minmax_dirty(bufObj, 0, size);
 
 #ifdef VBO_DEBUG
    printf("glBufferDataARB(%u, sz %ld, from %p, usage 0x%x)\n",
@@ -2577,7 +2577,7 @@ _mesa_buffer_sub_data(struct gl_context *ctx, struct gl_buffer_object *bufObj,
       return;
 
    bufObj->NumSubDataCalls++;
-   bufObj->MinMaxCacheDirty = true;
+   _mesa_bufferobj_minmax_dirty(bufObj, offset, size);
 
    _mesa_bufferobj_subdata(ctx, offset, size, data, bufObj);
 }
@@ -2782,7 +2782,7 @@ clear_buffer_sub_data(struct gl_context *ctx, struct gl_buffer_object *bufObj,
    if (size == 0)
       return;
 
-   bufObj->MinMaxCacheDirty = true;
+   _mesa_bufferobj_minmax_dirty(bufObj, offset, size);
 
    if (!ctx->pipe->clear_buffer) {
       clear_buffer_subdata_sw(ctx, offset, size,
@@ -3706,7 +3706,7 @@ map_buffer_range(struct gl_context *ctx, struct gl_buffer_object *bufObj,
    }
 
    if (access & GL_MAP_WRITE_BIT) {
-      bufObj->MinMaxCacheDirty = true;
+      _mesa_bufferobj_minmax_dirty(bufObj, offset, length);
    }
 
 #ifdef VBO_DEBUG
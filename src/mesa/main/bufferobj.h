@@ -95,6 +95,24 @@ _mesa_check_disallowed_mapping(const struct gl_buffer_object *obj)
             GL_MAP_PERSISTENT_BIT);
 }
 
+/**
+ * Invalidate the memoized min/max indices of a range of the buffer that is
+ * about to be written.
+ */
+static inline void
+_mesa_bufferobj_minmax_dirty(struct gl_buffer_object *obj,
+                             GLintptr offset, GLsizeiptr size)
+{
+   if (obj->MinMaxDirtyStart < obj->MinMaxDirtyEnd) {
+      obj->MinMaxDirtyStart = MIN2(obj->MinMaxDirtyStart, offset);
+      obj->MinMaxDirtyEnd = MAX2(obj->MinMaxDirtyEnd, offset + size);
+   } else {
+      obj->MinMaxDirtyStart = offset;
+      obj->MinMaxDirtyEnd = offset + size;
+   }
+   obj->MinMaxCacheDirty = true;
+}
+
 
 extern void
 _mesa_init_buffer_objects(struct gl_context *ctx);
@@ -13981,9 +13981,15 @@ _mesa_glthread_execute_list(struct gl_context *ctx, GLuint list)
          case OPCODE_DISABLE:
             _mesa_glthread_Disable(ctx, n[1].e);
             break;
+         case OPCODE_DISABLE_INDEXED:
+            _mesa_glthread_Disablei(ctx, n[2].e, n[1].ui);
+            break;
          case OPCODE_ENABLE:
             _mesa_glthread_Enable(ctx, n[1].e);
             break;
+         case OPCODE_ENABLE_INDEXED:
+            _mesa_glthread_Enablei(ctx, n[2].e, n[1].ui);
+            break;
          case OPCODE_LIST_BASE:
             _mesa_glthread_ListBase(ctx, n[1].ui);
             break;
@@ -14011,6 +14017,14 @@ _mesa_glthread_execute_list(struct gl_context *ctx, GLuint list)
          case OPCODE_MATRIX_POP:
             _mesa_glthread_MatrixPopEXT(ctx, n[1].e);
             break;
+         case OPCODE_VIEWPORT:
+            _mesa_glthread_Viewport(ctx, n[1].i, n[2].i, n[3].i, n[4].i);
+            break;
+         case OPCODE_VIEWPORT_ARRAY_V:
+         case OPCODE_VIEWPORT_INDEXED_F:
+         case OPCODE_VIEWPORT_INDEXED_FV:
+            _mesa_glthread_invalidate_viewport(ctx);
+            break;
          case OPCODE_CONTINUE:
             n = (Node *)get_pointer(&n[1]);
             continue;
@@ -14041,7 +14055,9 @@ _mesa_glthread_should_execute_list(struct gl_context *ctx,
       case OPCODE_CALL_LIST:
       case OPCODE_CALL_LISTS:
       case OPCODE_DISABLE:
+      case OPCODE_DISABLE_INDEXED:
       case OPCODE_ENABLE:
+      case OPCODE_ENABLE_INDEXED:
       case OPCODE_LIST_BASE:
       case OPCODE_MATRIX_MODE:
       case OPCODE_POP_ATTRIB:
@@ -14051,6 +14067,10 @@ _mesa_glthread_should_execute_list(struct gl_context *ctx,
       case OPCODE_ACTIVE_TEXTURE:   /* GL_ARB_multitexture */
       case OPCODE_MATRIX_PUSH:
       case OPCODE_MATRIX_POP:
+      case OPCODE_VIEWPORT:
+      case OPCODE_VIEWPORT_ARRAY_V:
+      case OPCODE_VIEWPORT_INDEXED_F:
+      case OPCODE_VIEWPORT_INDEXED_FV:
          return true;
       case OPCODE_CONTINUE:
          n = (Node *)get_pointer(&n[1]);
@@ -38,12 +38,17 @@
 #include "main/hash.h"
 #include "main/pixelstore.h"
 #include "util/u_atomic.h"
+#include "util/u_debug.h"
 #include "util/u_thread.h"
 #include "util/u_cpu_detect.h"
 #include "util/thread_sched.h"
 
 #include "state_tracker/st_context.h"
 
+DEBUG_GET_ONCE_BOOL_OPTION(glthread_spin, "MESA_GLTHREAD_SPIN", false)
+DEBUG_GET_ONCE_BOOL_OPTION(glthread_deferred_errors,
+                           "MESA_GLTHREAD_DEFERRED_ERRORS", false)
+
 static void
 glthread_update_global_locking(struct gl_context *ctx)
 {
@@ -218,8 +223,11 @@ _mesa_glthread_init(struct gl_context *ctx)
        !screen->caps.allow_mapped_buffers_during_execution)
       return;
 
+   unsigned queue_flags = debug_get_option_glthread_spin() ?
+                             UTIL_QUEUE_INIT_SPIN_BEFORE_WAIT : 0;
+
    if (!util_queue_init(&glthread->queue, "gl", MARSHAL_MAX_BATCHES - 2,
-                        1, 0, NULL)) {
+                        1, queue_flags, NULL)) {
       return;
    }
 
@@ -243,11 +251,15 @@ _mesa_glthread_init(struct gl_context *ctx)
    }
    glthread->next_batch = &glthread->batches[glthread->next];
    glthread->used = 0;
+   glthread->batch_size = MARSHAL_MAX_CMD_SIZE / 8;
    glthread->stats.queue = &glthread->queue;
 
    _mesa_glthread_init_call_fence(&glthread->LastProgramChangeBatch);
    _mesa_glthread_init_call_fence(&glthread->LastDListChangeBatchIndex);
 
+   glthread->Dither = true;
+   glthread->DeferredErrors = debug_get_option_glthread_deferred_errors();
+
    _mesa_glthread_enable(ctx);
 
    /* Execute the thread initialization function in the thread. */
@@ -298,6 +310,9 @@ void _mesa_glthread_enable(struct gl_context *ctx)
    ctx->GLThread.enabled = true;
    ctx->GLApi = ctx->MarshalExec;
 
+   /* The viewport could have been changed without us. */
+   ctx->GLThread.ViewportValid = false;
+
    /* glthread takes over all thread scheduling. */
    ctx->st->thread_scheduler_disabled = true;
 
@@ -353,6 +368,26 @@ glthread_finalize_batch(struct glthread_state *glthread,
    glthread->LastBindBuffer2 = NULL;
 }
 
+/* Adapt the batch size to the worker thread.  If it has already executed
+ * the last batch, it's waiting for this one, and every flush costs a
+ * wakeup, so let the next batch grow.  If it's still busy, it's the
+ * bottleneck, and smaller batches let it start sooner after a sync.
+ */
+static void
+glthread_update_batch_size(struct glthread_state *glthread)
+{
+   struct glthread_batch *last = &glthread->batches[glthread->last];
+
+   if (util_queue_fence_is_signalled(&last->fence)) {
+      glthread->batch_size = MIN2(glthread->batch_size * 2 + 1,
+                                  MARSHAL_MAX_CMD_BUFFER_SIZE / 8 - 1);
+   } else {
+      glthread->batch_size = MAX2(glthread->batch_size -
+                                  glthread->batch_size / 4,
+                                  MARSHAL_MAX_CMD_SIZE / 8);
+   }
+}
+
 void
 _mesa_glthread_flush_batch(struct gl_context *ctx)
 {
@@ -369,6 +404,7 @@ _mesa_glthread_flush_batch(struct gl_context *ctx)
       return; /* the batch is empty */
 
    glthread_apply_thread_sched_policy(ctx, false);
+   glthread_update_batch_size(glthread);
    glthread_finalize_batch(glthread, &glthread->stats.num_offloaded_items);
 
    struct glthread_batch *next = glthread->next_batch;
@@ -24,7 +24,7 @@
 #ifndef _GLTHREAD_H
 #define _GLTHREAD_H
 
-/* The size of one batch and the maximum size of one call.
+/* The initial size of one batch and the maximum size of one call.
  *
  * This should be as low as possible, so that:
  * - multiple synchronizations within a frame don't slow us down much
@@ -33,12 +33,20 @@
  *   chance of experiencing CPU cache thrashing
  * but it should be high enough so that u_queue overhead remains negligible.
  */
-#define MARSHAL_MAX_CMD_BUFFER_SIZE (8 * 1024)
+#define MARSHAL_MIN_BATCH_SIZE (8 * 1024)
+
+/* The size of the command buffer of one batch.
+ *
+ * Batches grow up to this size when the worker thread keeps running out of
+ * work, which happens with apps issuing a lot of tiny calls, so that we wake
+ * it up less often. See glthread_update_batch_size().
+ */
+#define MARSHAL_MAX_CMD_BUFFER_SIZE (32 * 1024)
 
 /* We need to leave 1 slot at the end to insert the END marker for unmarshal
  * calls that look ahead to know where the batch ends.
  */
-#define MARSHAL_MAX_CMD_SIZE (MARSHAL_MAX_CMD_BUFFER_SIZE - 8)
+#define MARSHAL_MAX_CMD_SIZE (MARSHAL_MIN_BATCH_SIZE - 8)
 
 /* The number of batch slots in memory.
  *
@@ -177,11 +185,20 @@ struct glthread_attrib_node {
    GLbitfield Mask;
    int ActiveTexture;
    GLenum16 MatrixMode;
+   bool AlphaTest;
    bool Blend;
    bool CullFace;
    bool DepthTest;
+   bool Dither;
+   bool Fog;
    bool Lighting;
+   bool Normalize;
+   bool PolygonOffsetFill;
    bool PolygonStipple;
+   bool ScissorTest;
+   bool StencilTest;
+   bool ViewportValid;
+   GLfloat Viewport[4];
 };
 
 typedef enum {
@@ -232,6 +249,12 @@ struct glthread_state
    /** Number of uint64_t elements filled already. */
    unsigned used;
 
+   /**
+    * Number of uint64_t elements after which the batch is flushed, between
+    * MARSHAL_MAX_CMD_SIZE / 8 and MARSHAL_MAX_CMD_BUFFER_SIZE / 8 - 1.
+    */
+   unsigned batch_size;
+
    /** Upload buffer. */
    struct gl_buffer_object *upload_buffer;
    uint8_t *upload_ptr;
@@ -282,12 +305,29 @@ struct glthread_state
    int MatrixStackDepth[M_NUM_MATRIX_STACKS];
 
    /** Enable states. */
+   bool AlphaTest;
    bool Blend;
    bool DepthTest;
    bool CullFace;
    bool DebugOutputSynchronous;
+   bool Dither;
+   bool Fog;
    bool Lighting;
+   bool Normalize;
+   bool PolygonOffsetFill;
    bool PolygonStipple;
+   bool ScissorTest;
+   bool StencilTest;
+
+   /**
+    * Viewport 0, valid once it has been set or read back from the context,
+    * since the viewport is initialized from the drawable size.
+    */
+   bool ViewportValid;
+   GLfloat Viewport[4];
+
+   /** glGetError doesn't wait for errors of calls that are still queued. */
+   bool DeferredErrors;
 
    GLuint CurrentDrawFramebuffer;
    GLuint CurrentReadFramebuffer;
@@ -23,23 +23,13 @@
 
 #include "main/glthread_marshal.h"
 #include "dispatch.h"
+#include "util/u_atomic.h"
 
-uint32_t
-_mesa_unmarshal_GetIntegerv(struct gl_context *ctx,
-                            const struct marshal_cmd_GetIntegerv *restrict cmd)
+/* Returns whether pname is tracked by glthread, and its value if it is. */
+static bool
+get_tracked_integer(struct gl_context *ctx, GLenum pname, GLint *p)
 {
-   UNREACHABLE("never executed");
-   return 0;
-}
-
-void GLAPIENTRY
-_mesa_marshal_GetIntegerv(GLenum pname, GLint *p)
-{
-   GET_CURRENT_CONTEXT(ctx);
-
-   /* This will generate GL_INVALID_OPERATION, as it should. */
-   if (ctx->GLThread.inside_begin_end)
-      goto sync;
+   struct glthread_state *glthread = &ctx->GLThread;
 
    /* TODO: Use get_hash_params.py to return values for items containing:
     * - CONST(
@@ -48,91 +38,255 @@ _mesa_marshal_GetIntegerv(GLenum pname, GLint *p)
 
    switch (pname) {
    case GL_ACTIVE_TEXTURE:
-      *p = GL_TEXTURE0 + ctx->GLThread.ActiveTexture;
-      return;
+      *p = GL_TEXTURE0 + glthread->ActiveTexture;
+      return true;
    case GL_ARRAY_BUFFER_BINDING:
-      *p = ctx->GLThread.CurrentArrayBufferName;
-      return;
+      *p = glthread->CurrentArrayBufferName;
+      return true;
    case GL_ATTRIB_STACK_DEPTH:
-      *p = ctx->GLThread.AttribStackDepth;
-      return;
+      *p = glthread->AttribStackDepth;
+      return true;
    case GL_CLIENT_ACTIVE_TEXTURE:
-      *p = GL_TEXTURE0 + ctx->GLThread.ClientActiveTexture;
-      return;
+      *p = GL_TEXTURE0 + glthread->ClientActiveTexture;
+      return true;
    case GL_CLIENT_ATTRIB_STACK_DEPTH:
-      *p = ctx->GLThread.ClientAttribStackTop;
-      return;
+      *p = glthread->ClientAttribStackTop;
+      return true;
    case GL_CURRENT_PROGRAM:
-      *p = ctx->GLThread.CurrentProgram;
-      return;
+      *p = glthread->CurrentProgram;
+      return true;
    case GL_DRAW_INDIRECT_BUFFER_BINDING:
-      *p = ctx->GLThread.CurrentDrawIndirectBufferName;
-      return;
+      *p = glthread->CurrentDrawIndirectBufferName;
+      return true;
    case GL_DRAW_FRAMEBUFFER_BINDING:
-      *p = ctx->GLThread.CurrentDrawFramebuffer;
-      return;
+      *p = glthread->CurrentDrawFramebuffer;
+      return true;
    case GL_READ_FRAMEBUFFER_BINDING:
-      *p = ctx->GLThread.CurrentReadFramebuffer;
-      return;
+      *p = glthread->CurrentReadFramebuffer;
+      return true;
    case GL_PIXEL_PACK_BUFFER_BINDING:
-      *p = ctx->GLThread.CurrentPixelPackBufferName;
-      return;
+      *p = glthread->CurrentPixelPackBufferName;
+      return true;
    case GL_PIXEL_UNPACK_BUFFER_BINDING:
-      *p = ctx->GLThread.CurrentPixelUnpackBufferName;
-      return;
+      *p = glthread->CurrentPixelUnpackBufferName;
+      return true;
    case GL_QUERY_BUFFER_BINDING:
-      *p = ctx->GLThread.CurrentQueryBufferName;
-      return;
+      *p = glthread->CurrentQueryBufferName;
+      return true;
 
    case GL_MATRIX_MODE:
-      *p = ctx->GLThread.MatrixMode;
-      return;
+      *p = glthread->MatrixMode;
+      return true;
    case GL_CURRENT_MATRIX_STACK_DEPTH_ARB:
-      *p = ctx->GLThread.MatrixStackDepth[ctx->GLThread.MatrixIndex] + 1;
-      return;
+      *p = glthread->MatrixStackDepth[glthread->MatrixIndex] + 1;
+      return true;
    case GL_MODELVIEW_STACK_DEPTH:
-      *p = ctx->GLThread.MatrixStackDepth[M_MODELVIEW] + 1;
-      return;
+      *p = glthread->MatrixStackDepth[M_MODELVIEW] + 1;
+      return true;
    case GL_PROJECTION_STACK_DEPTH:
-      *p = ctx->GLThread.MatrixStackDepth[M_PROJECTION] + 1;
-      return;
+      *p = glthread->MatrixStackDepth[M_PROJECTION] + 1;
+      return true;
    case GL_TEXTURE_STACK_DEPTH:
-      *p = ctx->GLThread.MatrixStackDepth[M_TEXTURE0 + ctx->GLThread.ActiveTexture] + 1;
-      return;
+      *p = glthread->MatrixStackDepth[M_TEXTURE0 + glthread->ActiveTexture] + 1;
+      return true;
 
    case GL_VERTEX_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_POS)) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_POS)) != 0;
+      return true;
    case GL_NORMAL_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_NORMAL)) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_NORMAL)) != 0;
+      return true;
    case GL_COLOR_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_COLOR0)) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_COLOR0)) != 0;
+      return true;
    case GL_SECONDARY_COLOR_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_COLOR1)) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_COLOR1)) != 0;
+      return true;
    case GL_FOG_COORD_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_FOG)) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_FOG)) != 0;
+      return true;
    case GL_INDEX_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_COLOR_INDEX)) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_COLOR_INDEX)) != 0;
+      return true;
    case GL_EDGE_FLAG_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_EDGEFLAG)) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_EDGEFLAG)) != 0;
+      return true;
    case GL_TEXTURE_COORD_ARRAY:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled &
-            (1 << (VERT_ATTRIB_TEX0 + ctx->GLThread.ClientActiveTexture))) != 0;
-      return;
+      *p = (glthread->CurrentVAO->UserEnabled &
+            (1 << (VERT_ATTRIB_TEX0 + glthread->ClientActiveTexture))) != 0;
+      return true;
    case GL_POINT_SIZE_ARRAY_OES:
-      *p = (ctx->GLThread.CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_POINT_SIZE)) != 0;
+      *p = (glthread->CurrentVAO->UserEnabled & (1 << VERT_ATTRIB_POINT_SIZE)) != 0;
+      return true;
+
+   case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+      *p = glthread->CurrentVAO->CurrentElementBufferName;
+      return true;
+   case GL_VERTEX_ARRAY_BINDING:
+      *p = glthread->CurrentVAO->Name;
+      return true;
+   case GL_PRIMITIVE_RESTART_INDEX:
+      *p = glthread->RestartIndex;
+      return true;
+   case GL_LIST_BASE:
+      *p = glthread->ListBase;
+      return true;
+   }
+
+   /* All states known to glIsEnabled can be queried too. */
+   int enabled = _mesa_glthread_IsEnabled(ctx, pname);
+   *p = enabled;
+   return enabled >= 0;
+}
+
+/* Returns the viewport, which is read back from the context if glthread
+ * doesn't know it.
+ */
+static const GLfloat *
+get_viewport(struct gl_context *ctx)
+{
+   struct glthread_state *glthread = &ctx->GLThread;
+
+   if (!glthread->ViewportValid) {
+      _mesa_glthread_finish_before(ctx, "GetViewport");
+      glthread->Viewport[0] = ctx->ViewportArray[0].X;
+      glthread->Viewport[1] = ctx->ViewportArray[0].Y;
+      glthread->Viewport[2] = ctx->ViewportArray[0].Width;
+      glthread->Viewport[3] = ctx->ViewportArray[0].Height;
+      glthread->ViewportValid = true;
+   }
+
+   return glthread->Viewport;
+}
+
+uint32_t
+_mesa_unmarshal_GetBooleanv(struct gl_context *ctx,
+                            const struct marshal_cmd_GetBooleanv *restrict cmd)
+{
+   UNREACHABLE("never executed");
+   return 0;
+}
+
+void GLAPIENTRY
+_mesa_marshal_GetBooleanv(GLenum pname, GLboolean *p)
+{
+   GET_CURRENT_CONTEXT(ctx);
+   GLint value;
+
+   /* This will generate GL_INVALID_OPERATION, as it should. */
+   if (ctx->GLThread.inside_begin_end)
+      goto sync;
+
+   if (pname == GL_VIEWPORT) {
+      const GLfloat *v = get_viewport(ctx);
+      for (unsigned i = 0; i < 4; i++)
+         p[i] = v[i] ? GL_TRUE : GL_FALSE;
+      return;
+   }
+
+   if (get_tracked_integer(ctx, pname, &value)) {
+      *p = value ? GL_TRUE : GL_FALSE;
       return;
    }
 
+sync:
+   _mesa_glthread_finish_before(ctx, "GetBooleanv");
+   CALL_GetBooleanv(ctx->Dispatch.Current, (pname, p));
+}
+
+uint32_t
+_mesa_unmarshal_GetFloatv(struct gl_context *ctx,
+                          const struct marshal_cmd_GetFloatv *restrict cmd)
+{
+   UNREACHABLE("never executed");
+   return 0;
+}
+
+void GLAPIENTRY
+_mesa_marshal_GetFloatv(GLenum pname, GLfloat *p)
+{
+   GET_CURRENT_CONTEXT(ctx);
+   GLint value;
+
+   /* This will generate GL_INVALID_OPERATION, as it should. */
+   if (ctx->GLThread.inside_begin_end)
+      goto sync;
+
+   if (pname == GL_VIEWPORT) {
+      memcpy(p, get_viewport(ctx), 4 * sizeof(GLfloat));
+      return;
+   }
+
+   if (get_tracked_integer(ctx, pname, &value)) {
+      *p = value;
+      return;
+   }
+
+sync:
+   _mesa_glthread_finish_before(ctx, "GetFloatv");
+   CALL_GetFloatv(ctx->Dispatch.Current, (pname, p));
+}
+
+uint32_t
+_mesa_unmarshal_GetIntegerv(struct gl_context *ctx,
+                            const struct marshal_cmd_GetIntegerv *restrict cmd)
+{
+   UNREACHABLE("never executed");
+   return 0;
+}
+
+void GLAPIENTRY
+_mesa_marshal_GetIntegerv(GLenum pname, GLint *p)
+{
+   GET_CURRENT_CONTEXT(ctx);
+
+   /* This will generate GL_INVALID_OPERATION, as it should. */
+   if (ctx->GLThread.inside_begin_end)
+      goto sync;
+
+   if (pname == GL_VIEWPORT) {
+      const GLfloat *v = get_viewport(ctx);
+      for (unsigned i = 0; i < 4; i++)
+         p[i] = lroundf(v[i]);
+      return;
+   }
+
+   if (get_tracked_integer(ctx, pname, p))
+      return;
+
 sync:
    _mesa_glthread_finish_before(ctx, "GetIntegerv");
    CALL_GetIntegerv(ctx->Dispatch.Current, (pname, p));
 }
 
-/* TODO: Implement glGetBooleanv, glGetFloatv, etc. if needed */
+uint32_t
+_mesa_unmarshal_GetError(struct gl_context *ctx,
+                         const struct marshal_cmd_GetError *restrict cmd)
+{
+   UNREACHABLE("never executed");
+   return 0;
+}
+
+GLenum GLAPIENTRY
+_mesa_marshal_GetError(void)
+{
+   GET_CURRENT_CONTEXT(ctx);
+
+   /* Errors are set when the worker thread executes calls, so glGetError
+    * has to wait for it to report errors of all previous calls.  With
+    * deferred errors, errors of the calls that are still queued are
+    * reported by a later glGetError instead.  KHR_no_error only reports
+    * GL_OUT_OF_MEMORY and doesn't need to be exact either.
+    */
+   if (!ctx->GLThread.inside_begin_end &&
+       (ctx->GLThread.DeferredErrors || _mesa_is_no_error_enabled(ctx))) {
+      GLenum error = p_atomic_xchg(&ctx->ErrorValue, GL_NO_ERROR);
+
+      if (_mesa_is_no_error_enabled(ctx) && error != GL_OUT_OF_MEMORY)
+         return GL_NO_ERROR;
+      return error;
+   }
+
+   _mesa_glthread_finish_before(ctx, "GetError");
+   return CALL_GetError(ctx->Dispatch.Current, ());
+}
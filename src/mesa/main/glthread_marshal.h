@@ -98,7 +98,7 @@ _mesa_glthread_allocate_command(struct gl_context *ctx,
 
    assert (num_elements <= MARSHAL_MAX_CMD_SIZE / 8);
 
-   if (unlikely(glthread->used + num_elements > MARSHAL_MAX_CMD_SIZE / 8))
+   if (unlikely(glthread->used + num_elements > glthread->batch_size))
       _mesa_glthread_flush_batch(ctx);
 
    struct glthread_batch *next = glthread->next_batch;
@@ -466,6 +466,9 @@ _mesa_glthread_Enable(struct gl_context *ctx, GLenum cap)
    case GL_PRIMITIVE_RESTART_FIXED_INDEX:
       _mesa_glthread_set_prim_restart(ctx, cap, true);
       break;
+   case GL_ALPHA_TEST:
+      ctx->GLThread.AlphaTest = true;
+      break;
    case GL_BLEND:
       ctx->GLThread.Blend = true;
       break;
@@ -479,12 +482,30 @@ _mesa_glthread_Enable(struct gl_context *ctx, GLenum cap)
    case GL_CULL_FACE:
       ctx->GLThread.CullFace = true;
       break;
+   case GL_DITHER:
+      ctx->GLThread.Dither = true;
+      break;
+   case GL_FOG:
+      ctx->GLThread.Fog = true;
+      break;
    case GL_LIGHTING:
       ctx->GLThread.Lighting = true;
       break;
+   case GL_NORMALIZE:
+      ctx->GLThread.Normalize = true;
+      break;
+   case GL_POLYGON_OFFSET_FILL:
+      ctx->GLThread.PolygonOffsetFill = true;
+      break;
    case GL_POLYGON_STIPPLE:
       ctx->GLThread.PolygonStipple = true;
       break;
+   case GL_SCISSOR_TEST:
+      ctx->GLThread.ScissorTest = true;
+      break;
+   case GL_STENCIL_TEST:
+      ctx->GLThread.StencilTest = true;
+      break;
    case GL_VERTEX_ARRAY:
    case GL_NORMAL_ARRAY:
    case GL_COLOR_ARRAY:
@@ -511,6 +532,9 @@ _mesa_glthread_Disable(struct gl_context *ctx, GLenum cap)
    case GL_PRIMITIVE_RESTART_FIXED_INDEX:
       _mesa_glthread_set_prim_restart(ctx, cap, false);
       break;
+   case GL_ALPHA_TEST:
+      ctx->GLThread.AlphaTest = false;
+      break;
    case GL_BLEND:
       ctx->GLThread.Blend = false;
       break;
@@ -524,12 +548,30 @@ _mesa_glthread_Disable(struct gl_context *ctx, GLenum cap)
    case GL_DEPTH_TEST:
       ctx->GLThread.DepthTest = false;
       break;
+   case GL_DITHER:
+      ctx->GLThread.Dither = false;
+      break;
+   case GL_FOG:
+      ctx->GLThread.Fog = false;
+      break;
    case GL_LIGHTING:
       ctx->GLThread.Lighting = false;
       break;
+   case GL_NORMALIZE:
+      ctx->GLThread.Normalize = false;
+      break;
+   case GL_POLYGON_OFFSET_FILL:
+      ctx->GLThread.PolygonOffsetFill = false;
+      break;
    case GL_POLYGON_STIPPLE:
       ctx->GLThread.PolygonStipple = false;
       break;
+   case GL_SCISSOR_TEST:
+      ctx->GLThread.ScissorTest = false;
+      break;
+   case GL_STENCIL_TEST:
+      ctx->GLThread.StencilTest = false;
+      break;
    case GL_VERTEX_ARRAY:
    case GL_NORMAL_ARRAY:
    case GL_COLOR_ARRAY:
@@ -545,6 +587,21 @@ _mesa_glthread_Disable(struct gl_context *ctx, GLenum cap)
    }
 }
 
+/* Only index 0 of indexed enables is visible to glIsEnabled. */
+static inline void
+_mesa_glthread_Enablei(struct gl_context *ctx, GLenum cap, GLuint index)
+{
+   if (index == 0 && (cap == GL_BLEND || cap == GL_SCISSOR_TEST))
+      _mesa_glthread_Enable(ctx, cap);
+}
+
+static inline void
+_mesa_glthread_Disablei(struct gl_context *ctx, GLenum cap, GLuint index)
+{
+   if (index == 0 && (cap == GL_BLEND || cap == GL_SCISSOR_TEST))
+      _mesa_glthread_Disable(ctx, cap);
+}
+
 static inline int
 _mesa_glthread_IsEnabled(struct gl_context *ctx, GLenum cap)
 {
@@ -552,7 +609,12 @@ _mesa_glthread_IsEnabled(struct gl_context *ctx, GLenum cap)
    if (ctx->GLThread.inside_begin_end)
       return -1;
 
+   /* Fixed-func states generate GL_INVALID_ENUM in other APIs. */
+   bool fixed_func = _mesa_is_desktop_gl_compat(ctx) || _mesa_is_gles1(ctx);
+
    switch (cap) {
+   case GL_ALPHA_TEST:
+      return fixed_func ? ctx->GLThread.AlphaTest : -1;
    case GL_BLEND:
       return ctx->GLThread.Blend;
    case GL_CULL_FACE:
@@ -561,10 +623,22 @@ _mesa_glthread_IsEnabled(struct gl_context *ctx, GLenum cap)
       return ctx->GLThread.DebugOutputSynchronous;
    case GL_DEPTH_TEST:
       return ctx->GLThread.DepthTest;
+   case GL_DITHER:
+      return ctx->GLThread.Dither;
+   case GL_FOG:
+      return fixed_func ? ctx->GLThread.Fog : -1;
    case GL_LIGHTING:
       return ctx->GLThread.Lighting;
+   case GL_NORMALIZE:
+      return fixed_func ? ctx->GLThread.Normalize : -1;
+   case GL_POLYGON_OFFSET_FILL:
+      return ctx->GLThread.PolygonOffsetFill;
    case GL_POLYGON_STIPPLE:
       return ctx->GLThread.PolygonStipple;
+   case GL_SCISSOR_TEST:
+      return ctx->GLThread.ScissorTest;
+   case GL_STENCIL_TEST:
+      return ctx->GLThread.StencilTest;
    case GL_VERTEX_ARRAY:
       return !!(ctx->GLThread.CurrentVAO->UserEnabled & VERT_BIT_POS);
    case GL_NORMAL_ARRAY:
@@ -593,25 +667,46 @@ _mesa_glthread_PushAttrib(struct gl_context *ctx, GLbitfield mask)
 
    attr->Mask = mask;
 
-   if (mask & GL_ENABLE_BIT)
+   if (mask & (GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT)) {
+      attr->AlphaTest = ctx->GLThread.AlphaTest;
       attr->Blend = ctx->GLThread.Blend;
+      attr->Dither = ctx->GLThread.Dither;
+   }
 
    if (mask & (GL_POLYGON_BIT | GL_ENABLE_BIT)) {
       attr->CullFace = ctx->GLThread.CullFace;
+      attr->PolygonOffsetFill = ctx->GLThread.PolygonOffsetFill;
       attr->PolygonStipple = ctx->GLThread.PolygonStipple;
    }
 
    if (mask & (GL_DEPTH_BUFFER_BIT | GL_ENABLE_BIT))
       attr->DepthTest = ctx->GLThread.DepthTest;
 
+   if (mask & (GL_FOG_BIT | GL_ENABLE_BIT))
+      attr->Fog = ctx->GLThread.Fog;
+
    if (mask & (GL_LIGHTING_BIT | GL_ENABLE_BIT))
       attr->Lighting = ctx->GLThread.Lighting;
 
+   if (mask & (GL_SCISSOR_BIT | GL_ENABLE_BIT))
+      attr->ScissorTest = ctx->GLThread.ScissorTest;
+
+   if (mask & (GL_STENCIL_BUFFER_BIT | GL_ENABLE_BIT))
+      attr->StencilTest = ctx->GLThread.StencilTest;
+
+   if (mask & (GL_TRANSFORM_BIT | GL_ENABLE_BIT))
+      attr->Normalize = ctx->GLThread.Normalize;
+
    if (mask & GL_TEXTURE_BIT)
       attr->ActiveTexture = ctx->GLThread.ActiveTexture;
 
    if (mask & GL_TRANSFORM_BIT)
       attr->MatrixMode = ctx->GLThread.MatrixMode;
+
+   if (mask & GL_VIEWPORT_BIT) {
+      attr->ViewportValid = ctx->GLThread.ViewportValid;
+      memcpy(attr->Viewport, ctx->GLThread.Viewport, sizeof(attr->Viewport));
+   }
 }
 
 static inline void
@@ -627,20 +722,36 @@ _mesa_glthread_PopAttrib(struct gl_context *ctx)
       &ctx->GLThread.AttribStack[--ctx->GLThread.AttribStackDepth];
    unsigned mask = attr->Mask;
 
-   if (mask & GL_ENABLE_BIT)
+   if (mask & (GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT)) {
+      ctx->GLThread.AlphaTest = attr->AlphaTest;
       ctx->GLThread.Blend = attr->Blend;
+      ctx->GLThread.Dither = attr->Dither;
+   }
 
    if (mask & (GL_POLYGON_BIT | GL_ENABLE_BIT)) {
       ctx->GLThread.CullFace = attr->CullFace;
+      ctx->GLThread.PolygonOffsetFill = attr->PolygonOffsetFill;
       ctx->GLThread.PolygonStipple = attr->PolygonStipple;
    }
 
    if (mask & (GL_DEPTH_BUFFER_BIT | GL_ENABLE_BIT))
       ctx->GLThread.DepthTest = attr->DepthTest;
 
+   if (mask & (GL_FOG_BIT | GL_ENABLE_BIT))
+      ctx->GLThread.Fog = attr->Fog;
+
    if (mask & (GL_LIGHTING_BIT | GL_ENABLE_BIT))
       ctx->GLThread.Lighting = attr->Lighting;
 
+   if (mask & (GL_SCISSOR_BIT | GL_ENABLE_BIT))
+      ctx->GLThread.ScissorTest = attr->ScissorTest;
+
+   if (mask & (GL_STENCIL_BUFFER_BIT | GL_ENABLE_BIT))
+      ctx->GLThread.StencilTest = attr->StencilTest;
+
+   if (mask & (GL_TRANSFORM_BIT | GL_ENABLE_BIT))
+      ctx->GLThread.Normalize = attr->Normalize;
+
    if (mask & GL_TEXTURE_BIT)
       ctx->GLThread.ActiveTexture = attr->ActiveTexture;
 
@@ -648,6 +759,51 @@ _mesa_glthread_PopAttrib(struct gl_context *ctx)
       ctx->GLThread.MatrixMode = attr->MatrixMode;
       ctx->GLThread.MatrixIndex = _mesa_get_matrix_index(ctx, attr->MatrixMode);
    }
+
+   if (mask & GL_VIEWPORT_BIT) {
+      ctx->GLThread.ViewportValid = attr->ViewportValid;
+      memcpy(ctx->GLThread.Viewport, attr->Viewport,
+             sizeof(ctx->GLThread.Viewport));
+   }
+}
+
+static inline void
+_mesa_glthread_Viewport(struct gl_context *ctx, GLint x, GLint y,
+                        GLsizei width, GLsizei height)
+{
+   if (ctx->GLThread.ListMode == GL_COMPILE)
+      return;
+
+   /* These generate errors and don't change the viewport. */
+   if (ctx->GLThread.inside_begin_end || width < 0 || height < 0)
+      return;
+
+   /* Clamp the same way as _mesa_Viewport. */
+   GLfloat *v = ctx->GLThread.Viewport;
+   v[0] = x;
+   v[1] = y;
+   v[2] = MIN2((GLfloat)width, (GLfloat)ctx->Const.MaxViewportWidth);
+   v[3] = MIN2((GLfloat)height, (GLfloat)ctx->Const.MaxViewportHeight);
+
+   if (_mesa_has_ARB_viewport_array(ctx) ||
+       _mesa_has_OES_viewport_array(ctx)) {
+      v[0] = CLAMP(v[0], ctx->Const.ViewportBounds.Min,
+                   ctx->Const.ViewportBounds.Max);
+      v[1] = CLAMP(v[1], ctx->Const.ViewportBounds.Min,
+                   ctx->Const.ViewportBounds.Max);
+   }
+
+   ctx->GLThread.ViewportValid = true;
+}
+
+/* The next viewport query reads it back from the context. */
+static inline void
+_mesa_glthread_invalidate_viewport(struct gl_context *ctx)
+{
+   if (ctx->GLThread.ListMode == GL_COMPILE)
+      return;
+
+   ctx->GLThread.ViewportValid = false;
 }
 
 static bool
@@ -28,6 +28,7 @@
 #include "enums.h"
 #include "context.h"
 #include "hint.h"
+#include "shaderapi.h"
 
 #include "mtypes.h"
 #include "api_exec_decl.h"
@@ -139,6 +140,9 @@ _mesa_MaxShaderCompilerThreadsKHR(GLuint count)
 
    ctx->Hint.MaxShaderCompilerThreads = count;
 
+   if (count)
+      _mesa_init_link_queue(ctx);
+
    struct pipe_screen *screen = ctx->screen;
    if (screen->set_max_shader_compiler_threads)
       screen->set_max_shader_compiler_threads(screen, count);
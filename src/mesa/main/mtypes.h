@@ -83,6 +83,8 @@ struct gl_context;
 struct st_context;
 struct gl_uniform_storage;
 struct prog_instruction;
+struct vbo_minmax_tree;
+struct st_vao_velems;
 struct gl_program_parameter_list;
 struct gl_shader_spirv_data;
 struct set;
@@ -1450,6 +1452,9 @@ struct gl_buffer_object
    unsigned MinMaxCacheHitIndices;
    unsigned MinMaxCacheMissIndices;
    struct hash_table *MinMaxCache;
+   struct vbo_minmax_tree *MinMaxTree;
+   /** Byte range written since MinMaxTree was last brought up to date */
+   GLintptr MinMaxDirtyStart, MinMaxDirtyEnd;
    simple_mtx_t MinMaxCacheMutex;
    bool MinMaxCacheDirty:1;
 
@@ -1644,6 +1649,16 @@ struct gl_vertex_array_object
    /** "Enabled" with the position/generic0 attribute aliasing resolved */
    GLbitfield _EnabledWithMapMode;
 
+   /**
+    * Set along with gl_array_attrib::NewVertexElements when this VAO
+    * changes in a way that affects vertex elements.  Cleared by the state
+    * tracker when it stores the vertex elements in VelemsCache.
+    */
+   bool NewVertexElements;
+
+   /** Vertex elements last built from this VAO, see st_atom_array.cpp. */
+   struct st_vao_velems *VelemsCache;
+
    /** The index buffer (also known as the element array buffer in OpenGL). */
    struct gl_buffer_object *IndexBufferObj;
 };
@@ -2269,6 +2284,7 @@ struct gl_ati_fragment_shader_state
 #define GLSL_CACHE_INFO 0x100 /**< Print debug information about shader cache */
 #define GLSL_CACHE_FALLBACK 0x200 /**< Force shader cache fallback paths */
 #define GLSL_SOURCE 0x400 /**< Only dump GLSL */
+#define GLSL_LINK_TIME 0x800 /**< Print the time spent in each link phase */
 
 
 /**
@@ -3461,6 +3477,15 @@ struct gl_context
     */
    struct nir_shader *SoftFP64;
 
+   /**
+    * GL_KHR_parallel_shader_compile: glLinkProgram runs the GLSL linker on
+    * this queue once the application has called glMaxShaderCompilerThreadsKHR.
+    * PendingLinks holds a reference to each program linked there until its
+    * link has been finished.
+    */
+   struct util_queue LinkQueue;
+   struct util_dynarray PendingLinks; /**< gl_shader_program pointers */
+
    struct gl_query_state Query;  /**< occlusion, timer queries */
 
    struct gl_transform_feedback_state TransformFeedback;
@@ -37,6 +37,7 @@
 #include "program/prog_parameter.h"
 #include "util/mesa-sha1.h"
 #include "util/mesa-blake3.h"
+#include "util/u_queue.h"
 #include "compiler/shader_info.h"
 #include "compiler/list.h"
 #include "compiler/glsl/ir_list.h"
@@ -179,7 +180,7 @@ struct gl_shader
 
    enum gl_compile_status CompileStatus;
 
-   /** SHA1 of the pre-processed source used by the disk cache. */
+   /** Disk cache key of the source, see can_skip_compile(). */
    uint8_t disk_cache_sha1[SHA1_DIGEST_LENGTH];
    /** BLAKE3 of the original source before replacement, set by glShaderSource. */
    blake3_hash source_blake3;
@@ -187,6 +188,13 @@ struct gl_shader
    blake3_hash fallback_source_blake3;
    /** BLAKE3 of the current compiled source, set by successful glCompileShader. */
    blake3_hash compiled_source_blake3;
+   /**
+    * BLAKE3 of Source as stored, which differs from source_blake3 for
+    * replaced shaders.  Set by glShaderSource, so that the disk cache key
+    * doesn't need another pass over the source.
+    */
+   blake3_hash source_key_blake3;
+   bool has_source_key_blake3;
 
    const GLchar *Source;  /**< Source code string */
    const GLchar *FallbackSource;  /**< Fallback string used by on-disk cache*/
@@ -479,6 +487,14 @@ struct gl_shader_program
    struct gl_linked_shader *_LinkedShaders[MESA_SHADER_MESH_STAGES];
 
    unsigned GLSL_Version; /**< GLSL version used for linking */
+
+   /**
+    * GL_KHR_parallel_shader_compile: set while glLinkProgram runs on
+    * gl_context::LinkQueue or hasn't been finished yet, see shaderapi.c.
+    * LinkFence is signalled once the worker thread is done with the program.
+    */
+   bool LinkPending;
+   struct util_queue_fence LinkFence;
 };
 
 /**
@@ -153,6 +153,8 @@ _mesa_get_shader_flags(void)
          flags |= GLSL_USE_PROG;
       if (strstr(env, "errors"))
          flags |= GLSL_REPORT_ERRORS;
+      if (strstr(env, "link_time"))
+         flags |= GLSL_LINK_TIME;
    }
 
    return flags;
@@ -212,6 +214,8 @@ _mesa_init_shader_state(struct gl_context *ctx)
       ctx->TessCtrlProgram.patch_default_outer_level[i] = 1.0;
    for (i = 0; i < 2; ++i)
       ctx->TessCtrlProgram.patch_default_inner_level[i] = 1.0;
+
+   util_dynarray_init(&ctx->PendingLinks, NULL);
 }
 
 
@@ -235,6 +239,13 @@ _mesa_free_shader_state(struct gl_context *ctx)
    _mesa_reference_pipeline_object(ctx, &ctx->_Shader, NULL);
 
    assert(ctx->Shader.RefCount == 1);
+
+   /* Pending links are finished while the state tracker is still alive. */
+   assert(!util_dynarray_num_elements(&ctx->PendingLinks,
+                                      struct gl_shader_program *));
+   if (util_queue_is_initialized(&ctx->LinkQueue))
+      util_queue_destroy(&ctx->LinkQueue);
+   util_dynarray_fini(&ctx->PendingLinks);
 }
 
 
@@ -724,6 +735,16 @@ get_shader_program_completion_status(struct gl_context *ctx,
 {
    struct pipe_screen *screen = ctx->screen;
 
+   if (shprog->LinkPending) {
+      if (!util_queue_fence_is_signalled(&shprog->LinkFence))
+         return false;
+
+      /* What is left is creating the driver shaders, which drivers that
+       * support parallel compilation don't block on.
+       */
+      _mesa_finish_program_link(ctx, shprog);
+   }
+
    if (!screen->is_parallel_shader_compilation_finished)
       return true;
 
@@ -753,8 +774,11 @@ static void
 get_programiv(struct gl_context *ctx, GLuint program, GLenum pname,
               GLint *params)
 {
-   struct gl_shader_program *shProg
-      = _mesa_lookup_shader_program_err(ctx, program, "glGetProgramiv(program)");
+   /* GL_COMPLETION_STATUS_KHR mustn't wait for a pending link. */
+   struct gl_shader_program *shProg = pname == GL_COMPLETION_STATUS_ARB ?
+      _mesa_lookup_shader_program_err_no_wait(ctx, program,
+                                              "glGetProgramiv(program)") :
+      _mesa_lookup_shader_program_err(ctx, program, "glGetProgramiv(program)");
 
    /* Is transform feedback available in this context?
     */
@@ -1191,7 +1215,8 @@ get_shader_source(struct gl_context *ctx, GLuint shader, GLsizei maxLength,
  */
 static void
 set_shader_source(struct gl_shader *sh, const GLchar *source,
-                  const blake3_hash original_blake3)
+                  const blake3_hash original_blake3,
+                  const blake3_hash source_blake3)
 {
    assert(sh);
 
@@ -1219,6 +1244,8 @@ set_shader_source(struct gl_shader *sh, const GLchar *source,
    }
 
    memcpy(sh->source_blake3, original_blake3, BLAKE3_OUT_LEN);
+   memcpy(sh->source_key_blake3, source_blake3, BLAKE3_OUT_LEN);
+   sh->has_source_key_blake3 = true;
 }
 
 static void
@@ -1371,46 +1398,12 @@ capture_shader_program(struct gl_context *ctx,
 }
 
 /**
- * Link a program's shaders.
+ * Update the state that depends on a program after linking it.
  */
-static ALWAYS_INLINE void
-link_program(struct gl_context *ctx, struct gl_shader_program *shProg,
-             bool no_error)
+static void
+link_program_done(struct gl_context *ctx, struct gl_shader_program *shProg,
+                  unsigned programs_in_use)
 {
-   if (!shProg)
-      return;
-
-   MESA_TRACE_FUNC();
-
-   if (!no_error) {
-      /* From the ARB_transform_feedback2 specification:
-       * "The error INVALID_OPERATION is generated by LinkProgram if <program>
-       * is the name of a program being used by one or more transform feedback
-       * objects, even if the objects are not currently bound or are paused."
-       */
-      if (_mesa_transform_feedback_is_using_program(ctx, shProg)) {
-         _mesa_error(ctx, GL_INVALID_OPERATION,
-                     "glLinkProgram(transform feedback is using the program)");
-         return;
-      }
-   }
-
-   capture_shader_program(ctx, shProg);
-
-   unsigned programs_in_use = 0;
-   if (ctx->_Shader)
-      for (unsigned stage = 0; stage < MESA_SHADER_MESH_STAGES; stage++) {
-         if (ctx->_Shader->CurrentProgram[stage] &&
-             ctx->_Shader->CurrentProgram[stage]->Id == shProg->Name) {
-            programs_in_use |= 1 << stage;
-         }
-      }
-
-   ensure_builtin_types(ctx);
-
-   FLUSH_VERTICES(ctx, 0, 0);
-   st_link_shader(ctx, shProg);
-
    /* From section 7.3 (Program Objects) of the OpenGL 4.5 spec:
     *
     *    "If LinkProgram or ProgramBinary successfully re-links a program
@@ -1467,25 +1460,215 @@ link_program(struct gl_context *ctx, struct gl_shader_program *shProg,
    }
 }
 
+/**
+ * GL_KHR_parallel_shader_compile
+ *
+ * Once the application has called glMaxShaderCompilerThreadsKHR, the GLSL
+ * linker and the NIR lowering of glLinkProgram run on ctx->LinkQueue.  Only
+ * creating the driver shaders, which drivers supporting parallel compilation
+ * do asynchronously anyway, is left for when the link is finished on the
+ * context's thread.  That happens as soon as anything but
+ * GL_COMPLETION_STATUS_KHR looks at the program or at one of its attached
+ * shaders, see the lookup functions in shaderobj.c.
+ *
+ * Only programs that nothing else holds a reference to are linked there, so
+ * that no rendering state can depend on a pending link.  The linker writes
+ * to the NIR of the attached shaders, which can be shared by several
+ * programs, so the queue has a single thread and synchronous links wait for
+ * it to be idle.
+ */
+void
+_mesa_init_link_queue(struct gl_context *ctx)
+{
+   if (util_queue_is_initialized(&ctx->LinkQueue))
+      return;
+
+   util_queue_init(&ctx->LinkQueue, "gllink", 16, 1,
+                   UTIL_QUEUE_INIT_RESIZE_IF_FULL, ctx);
+}
+
+static bool
+can_link_program_async(struct gl_context *ctx,
+                       const struct gl_shader_program *shProg)
+{
+   if (!ctx->Hint.MaxShaderCompilerThreads ||
+       !util_queue_is_initialized(&ctx->LinkQueue))
+      return false;
+
+   /* Only the shader object table references it, so it isn't current in any
+    * context or pipeline object.
+    */
+   if (shProg->RefCount != 1)
+      return false;
+
+   for (unsigned i = 0; i < shProg->NumShaders; i++) {
+      if (shProg->Shaders[i]->spirv_data)
+         return false;
+   }
+   return true;
+}
+
+static void
+link_program_async_execute(void *job, void *gdata, int thread_index)
+{
+   struct gl_shader_program *shProg = (struct gl_shader_program *)job;
+   struct gl_context *ctx = (struct gl_context *)gdata;
+
+   st_link_shader_begin(ctx, shProg);
+}
+
+static void
+link_program_async(struct gl_context *ctx, struct gl_shader_program *shProg)
+{
+   /* Drop the references to programs that have been finished since. */
+   unsigned num_pending = 0;
+   util_dynarray_foreach(&ctx->PendingLinks, struct gl_shader_program *, p) {
+      if ((*p)->LinkPending)
+         *util_dynarray_element(&ctx->PendingLinks,
+                                struct gl_shader_program *,
+                                num_pending++) = *p;
+      else
+         _mesa_reference_shader_program(ctx, p, NULL);
+   }
+   util_dynarray_resize(&ctx->PendingLinks, struct gl_shader_program *,
+                        num_pending);
+
+   struct gl_shader_program *ref = NULL;
+   _mesa_reference_shader_program(ctx, &ref, shProg);
+   util_dynarray_append(&ctx->PendingLinks, ref);
+
+   shProg->LinkPending = true;
+   util_queue_add_job(&ctx->LinkQueue, shProg, &shProg->LinkFence,
+                      link_program_async_execute, NULL, 0);
+}
+
+/**
+ * Finish the link of a program started by link_program_async, if any.
+ */
+void
+_mesa_finish_program_link(struct gl_context *ctx,
+                          struct gl_shader_program *shProg)
+{
+   if (likely(!shProg->LinkPending))
+      return;
+
+   MESA_TRACE_FUNC();
+
+   util_queue_fence_wait(&shProg->LinkFence);
+   shProg->LinkPending = false;
+
+   FLUSH_VERTICES(ctx, 0, 0);
+   st_link_shader_end(ctx, shProg);
+   link_program_done(ctx, shProg, 0);
+}
+
+/**
+ * Finish the pending links of the context that use the shader, before it
+ * gets changed or looked at.
+ */
+void
+_mesa_finish_links_using_shader(struct gl_context *ctx, struct gl_shader *sh)
+{
+   util_dynarray_foreach(&ctx->PendingLinks, struct gl_shader_program *, p) {
+      struct gl_shader_program *shProg = *p;
+
+      if (!shProg->LinkPending)
+         continue;
+
+      for (unsigned i = 0; i < shProg->NumShaders; i++) {
+         if (shProg->Shaders[i] == sh) {
+            _mesa_finish_program_link(ctx, shProg);
+            break;
+         }
+      }
+   }
+}
+
+/**
+ * Finish all pending links of the context and drop the references to them.
+ */
+void
+_mesa_finish_pending_links(struct gl_context *ctx)
+{
+   util_dynarray_foreach(&ctx->PendingLinks, struct gl_shader_program *, p) {
+      _mesa_finish_program_link(ctx, *p);
+      _mesa_reference_shader_program(ctx, p, NULL);
+   }
+   util_dynarray_clear(&ctx->PendingLinks);
+}
+
+/**
+ * Link a program's shaders.
+ */
+static ALWAYS_INLINE void
+link_program(struct gl_context *ctx, struct gl_shader_program *shProg,
+             bool no_error, bool allow_async)
+{
+   if (!shProg)
+      return;
+
+   MESA_TRACE_FUNC();
+
+   if (!no_error) {
+      /* From the ARB_transform_feedback2 specification:
+       * "The error INVALID_OPERATION is generated by LinkProgram if <program>
+       * is the name of a program being used by one or more transform feedback
+       * objects, even if the objects are not currently bound or are paused."
+       */
+      if (_mesa_transform_feedback_is_using_program(ctx, shProg)) {
+         _mesa_error(ctx, GL_INVALID_OPERATION,
+                     "glLinkProgram(transform feedback is using the program)");
+         return;
+      }
+   }
+
+   capture_shader_program(ctx, shProg);
+
+   unsigned programs_in_use = 0;
+   if (ctx->_Shader)
+      for (unsigned stage = 0; stage < MESA_SHADER_MESH_STAGES; stage++) {
+         if (ctx->_Shader->CurrentProgram[stage] &&
+             ctx->_Shader->CurrentProgram[stage]->Id == shProg->Name) {
+            programs_in_use |= 1 << stage;
+         }
+      }
+
+   ensure_builtin_types(ctx);
+
+   if (allow_async && can_link_program_async(ctx, shProg)) {
+      assert(!programs_in_use);
+      link_program_async(ctx, shProg);
+      return;
+   }
+
+   /* The linker can't run concurrently with the link queue. */
+   _mesa_finish_pending_links(ctx);
+
+   FLUSH_VERTICES(ctx, 0, 0);
+   st_link_shader(ctx, shProg);
+
+   link_program_done(ctx, shProg, programs_in_use);
+}
+
 
 static void
 link_program_error(struct gl_context *ctx, struct gl_shader_program *shProg)
 {
-   link_program(ctx, shProg, false);
+   link_program(ctx, shProg, false, true);
 }
 
 
 static void
 link_program_no_error(struct gl_context *ctx, struct gl_shader_program *shProg)
 {
-   link_program(ctx, shProg, true);
+   link_program(ctx, shProg, true, true);
 }
 
 
 void
 _mesa_link_program(struct gl_context *ctx, struct gl_shader_program *shProg)
 {
-   link_program_error(ctx, shProg);
+   link_program(ctx, shProg, false, false);
 }
 
 
@@ -2173,8 +2356,9 @@ shader_source(struct gl_context *ctx, GLuint shaderObj, GLsizei count,
    source[totalLength - 2] = '\0';
 
    /* Compute the original source blake3 before shader replacement. */
-   blake3_hash original_blake3;
+   blake3_hash original_blake3, source_blake3;
    _mesa_blake3_compute(source, strlen(source), original_blake3);
+   memcpy(source_blake3, original_blake3, BLAKE3_OUT_LEN);
 
 #ifdef ENABLE_SHADER_CACHE
    GLcharARB *replacement;
@@ -2188,10 +2372,11 @@ shader_source(struct gl_context *ctx, GLuint shaderObj, GLsizei count,
    if (replacement) {
       free(source);
       source = replacement;
+      _mesa_blake3_compute(source, strlen(source), source_blake3);
    }
 #endif /* ENABLE_SHADER_CACHE */
 
-   set_shader_source(sh, source, original_blake3);
+   set_shader_source(sh, source, original_blake3, source_blake3);
 
    free(offsets);
 }
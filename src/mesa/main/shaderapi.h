@@ -73,6 +73,19 @@ _mesa_compile_shader(struct gl_context *ctx, struct gl_shader *sh);
 extern void
 _mesa_link_program(struct gl_context *ctx, struct gl_shader_program *sh_prog);
 
+extern void
+_mesa_init_link_queue(struct gl_context *ctx);
+
+extern void
+_mesa_finish_program_link(struct gl_context *ctx,
+                          struct gl_shader_program *shProg);
+
+extern void
+_mesa_finish_links_using_shader(struct gl_context *ctx, struct gl_shader *sh);
+
+extern void
+_mesa_finish_pending_links(struct gl_context *ctx);
+
 extern unsigned
 _mesa_count_active_attribs(struct gl_shader_program *shProg);
 
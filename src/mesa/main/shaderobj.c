@@ -160,6 +160,8 @@ _mesa_lookup_shader(struct gl_context *ctx, GLuint name)
       if (sh && sh->Type == GL_SHADER_PROGRAM_MESA) {
          return NULL;
       }
+      if (sh)
+         _mesa_finish_links_using_shader(ctx, sh);
       return sh;
    }
    return NULL;
@@ -187,6 +189,7 @@ _mesa_lookup_shader_err(struct gl_context *ctx, GLuint name, const char *caller)
          _mesa_error(ctx, GL_INVALID_OPERATION, "%s", caller);
          return NULL;
       }
+      _mesa_finish_links_using_shader(ctx, sh);
       return sh;
    }
 }
@@ -292,6 +295,8 @@ init_shader_program(struct gl_shader_program *prog)
    prog->FragDataIndexBindings = string_to_uint_map_ctor();
 
    prog->TransformFeedback.BufferMode = GL_INTERLEAVED_ATTRIBS;
+
+   util_queue_fence_init(&prog->LinkFence);
 }
 
 /**
@@ -404,7 +409,11 @@ void
 _mesa_delete_shader_program(struct gl_context *ctx,
                             struct gl_shader_program *shProg)
 {
+   /* Pending links hold a reference. */
+   assert(!shProg->LinkPending);
+
    _mesa_free_shader_program_data(ctx, shProg);
+   util_queue_fence_destroy(&shProg->LinkFence);
    ralloc_free(shProg);
 }
 
@@ -426,18 +435,17 @@ _mesa_lookup_shader_program(struct gl_context *ctx, GLuint name)
       if (shProg && shProg->Type != GL_SHADER_PROGRAM_MESA) {
          return NULL;
       }
+      if (shProg)
+         _mesa_finish_program_link(ctx, shProg);
       return shProg;
    }
    return NULL;
 }
 
 
-/**
- * As above, but record an error if program is not found.
- */
-struct gl_shader_program *
-_mesa_lookup_shader_program_err_glthread(struct gl_context *ctx, GLuint name,
-                                         bool glthread, const char *caller)
+static struct gl_shader_program *
+lookup_shader_program_err(struct gl_context *ctx, GLuint name,
+                          bool glthread, const char *caller)
 {
    if (!name) {
       _mesa_error_glthread_safe(ctx, GL_INVALID_VALUE, glthread, "%s", caller);
@@ -461,9 +469,46 @@ _mesa_lookup_shader_program_err_glthread(struct gl_context *ctx, GLuint name,
 }
 
 
+/**
+ * As _mesa_lookup_shader_program, but record an error if program is not
+ * found.
+ *
+ * With glthread, this is called by the application thread, which can't
+ * finish a pending link, but everything read from there is done by the time
+ * the link fence is signalled.
+ */
+struct gl_shader_program *
+_mesa_lookup_shader_program_err_glthread(struct gl_context *ctx, GLuint name,
+                                         bool glthread, const char *caller)
+{
+   struct gl_shader_program *shProg =
+      lookup_shader_program_err(ctx, name, glthread, caller);
+
+   if (shProg) {
+      if (glthread)
+         util_queue_fence_wait(&shProg->LinkFence);
+      else
+         _mesa_finish_program_link(ctx, shProg);
+   }
+   return shProg;
+}
+
+
 struct gl_shader_program *
 _mesa_lookup_shader_program_err(struct gl_context *ctx, GLuint name,
                                 const char *caller)
 {
    return _mesa_lookup_shader_program_err_glthread(ctx, name, false, caller);
 }
+
+
+/**
+ * As above, but don't wait for a pending link, for queries that mustn't
+ * block like GL_COMPLETION_STATUS_KHR.
+ */
+struct gl_shader_program *
+_mesa_lookup_shader_program_err_no_wait(struct gl_context *ctx, GLuint name,
+                                        const char *caller)
+{
+   return lookup_shader_program_err(ctx, name, false, caller);
+}
@@ -238,6 +238,7 @@ _mesa_vertex_attrib_binding(struct gl_context *ctx,
       if (vao->Enabled & array_bit) {
          ST_SET_STATE(ctx->NewDriverState, ST_NEW_VERTEX_ARRAYS);
          ctx->Array.NewVertexElements = true;
+         vao->NewVertexElements = true;
       }
 
       vao->NonDefaultStateMask |= array_bit | BITFIELD_BIT(bindingIndex);
@@ -307,8 +308,10 @@ _mesa_bind_vertex_buffer(struct gl_context *ctx,
          /* The slow path merges vertex buffers, which affects vertex elements.
           * Stride changes also require new vertex elements.
           */
-         if (!ctx->Const.UseVAOFastPath || stride_changed)
+         if (!ctx->Const.UseVAOFastPath || stride_changed) {
             ctx->Array.NewVertexElements = true;
+            vao->NewVertexElements = true;
+         }
       }
 
       vao->NonDefaultStateMask |= BITFIELD_BIT(index);
@@ -347,6 +350,7 @@ vertex_binding_divisor(struct gl_context *ctx,
       if (vao->Enabled & binding->_BoundArrays) {
          ST_SET_STATE(ctx->NewDriverState, ST_NEW_VERTEX_ARRAYS);
          ctx->Array.NewVertexElements = true;
+         vao->NewVertexElements = true;
       }
 
       vao->NonDefaultStateMask |= BITFIELD_BIT(bindingIndex);
@@ -859,6 +863,7 @@ _mesa_update_array_format(struct gl_context *ctx,
    if (vao->Enabled & VERT_BIT(attrib)) {
       ST_SET_STATE(ctx->NewDriverState, ST_NEW_VERTEX_ARRAYS);
       ctx->Array.NewVertexElements = true;
+      vao->NewVertexElements = true;
    }
 
    vao->NonDefaultStateMask |= BITFIELD_BIT(attrib);
@@ -1126,8 +1131,10 @@ update_array(struct gl_context *ctx,
          /* The slow path merges vertex buffers, which affects vertex
           * elements.
           */
-         if (!ctx->Const.UseVAOFastPath)
+         if (!ctx->Const.UseVAOFastPath) {
             ctx->Array.NewVertexElements = true;
+            vao->NewVertexElements = true;
+         }
       }
 
       vao->NonDefaultStateMask |= BITFIELD_BIT(attrib);
@@ -2158,6 +2165,7 @@ _mesa_enable_vertex_array_attribs(struct gl_context *ctx,
       vao->NonDefaultStateMask |= attrib_bits;
       ST_SET_STATE(ctx->NewDriverState, ST_NEW_VERTEX_ARRAYS);
       ctx->Array.NewVertexElements = true;
+      vao->NewVertexElements = true;
 
       /* Update the map mode if needed */
       if (attrib_bits & (VERT_BIT_POS|VERT_BIT_GENERIC0))
@@ -2261,6 +2269,7 @@ _mesa_disable_vertex_array_attribs(struct gl_context *ctx,
       vao->Enabled &= ~attrib_bits;
       ST_SET_STATE(ctx->NewDriverState, ST_NEW_VERTEX_ARRAYS);
       ctx->Array.NewVertexElements = true;
+      vao->NewVertexElements = true;
 
       /* Update the map mode if needed */
       if (attrib_bits & (VERT_BIT_POS|VERT_BIT_GENERIC0))
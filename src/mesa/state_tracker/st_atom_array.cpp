@@ -81,6 +81,20 @@ enum st_update_velems {
    UPDATE_VELEMS_ON,          /* always works */
 };
 
+/* Vertex elements last built from a VAO, so that binding a VAO that hasn't
+ * changed since it was last drawn with doesn't rebuild them.  Vertex
+ * elements also depend on the vertex shader inputs, which are part of the
+ * key.
+ */
+struct st_vao_velems {
+   GLbitfield inputs_read;
+   GLbitfield dual_slot_inputs;
+   GLbitfield enabled_arrays;
+   gl_attribute_map_mode map_mode;
+   unsigned count;
+   struct cso_velems_state velems;
+};
+
 /* Always inline the non-64bit element code, so that the compiler can see
  * that velements is on the stack.
  */
@@ -400,9 +414,11 @@ template<util_popcnt POPCNT,
 st_update_array_templ(struct st_context *st,
                       const GLbitfield enabled_arrays,
                       const GLbitfield enabled_user_arrays,
-                      const GLbitfield nonzero_divisor_arrays)
+                      const GLbitfield nonzero_divisor_arrays,
+                      struct st_vao_velems *velems_cache)
 {
    struct gl_context *ctx = st->ctx;
+   struct gl_vertex_array_object *vao = ctx->Array._DrawVAO;
 
    /* vertex program validation must be done before this */
    /* _NEW_PROGRAM, ST_NEW_VS_STATE */
@@ -422,6 +438,23 @@ st_update_array_templ(struct st_context *st,
    struct pipe_vertex_buffer *vbuffer;
    unsigned num_vbuffers = 0, num_vbuffers_tc;
    struct cso_velems_state velements;
+   struct cso_velems_state *bind_velems = &velements;
+   const unsigned velems_count =
+      vp->num_inputs + vp_variant->key.passthrough_edgeflags;
+
+   /* The cache is only passed without zero-stride attribs, so the vertex
+    * elements only depend on the VAO and the inputs of the shader.
+    */
+   bool use_velems_cache = false;
+   if (UPDATE_VELEMS && velems_cache) {
+      assert(!ALLOW_ZERO_STRIDE_ATTRIBS && !ALLOW_USER_BUFFERS);
+      use_velems_cache = !vao->NewVertexElements &&
+                         velems_cache->inputs_read == inputs_read &&
+                         velems_cache->dual_slot_inputs == dual_slot_inputs &&
+                         velems_cache->enabled_arrays == enabled_arrays &&
+                         velems_cache->map_mode == vao->_AttributeMapMode &&
+                         velems_cache->count == velems_count;
+   }
 
    if (FILL_TC_SET_VB) {
       assert(!uses_user_vertex_buffers);
@@ -451,11 +484,21 @@ st_update_array_templ(struct st_context *st,
 
    /* ST_NEW_VERTEX_ARRAYS */
    /* Setup arrays */
-   setup_arrays<POPCNT, FILL_TC_SET_VB, USE_VAO_FAST_PATH,
-                ALLOW_ZERO_STRIDE_ATTRIBS, HAS_IDENTITY_ATTRIB_MAPPING,
-                ALLOW_USER_BUFFERS, UPDATE_VELEMS>
-      (ctx, ctx->Array._DrawVAO, dual_slot_inputs, inputs_read,
-       inputs_read & enabled_arrays, &velements, vbuffer, &num_vbuffers);
+   if (use_velems_cache) {
+      /* Only vertex buffers, the vertex elements are reused. */
+      setup_arrays<POPCNT, FILL_TC_SET_VB, USE_VAO_FAST_PATH,
+                   ALLOW_ZERO_STRIDE_ATTRIBS, HAS_IDENTITY_ATTRIB_MAPPING,
+                   ALLOW_USER_BUFFERS, UPDATE_VELEMS_OFF>
+         (ctx, vao, dual_slot_inputs, inputs_read,
+          inputs_read & enabled_arrays, NULL, vbuffer, &num_vbuffers);
+      bind_velems = &velems_cache->velems;
+   } else {
+      setup_arrays<POPCNT, FILL_TC_SET_VB, USE_VAO_FAST_PATH,
+                   ALLOW_ZERO_STRIDE_ATTRIBS, HAS_IDENTITY_ATTRIB_MAPPING,
+                   ALLOW_USER_BUFFERS, UPDATE_VELEMS>
+         (ctx, vao, dual_slot_inputs, inputs_read,
+          inputs_read & enabled_arrays, &velements, vbuffer, &num_vbuffers);
+   }
 
    /* _NEW_CURRENT_ATTRIB */
    /* Setup zero-stride attribs. */
@@ -472,14 +515,30 @@ st_update_array_templ(struct st_context *st,
 
    if (UPDATE_VELEMS) {
       struct cso_context *cso = st->cso_context;
-      velements.count = vp->num_inputs + vp_variant->key.passthrough_edgeflags;
+
+      if (!use_velems_cache) {
+         velements.count = velems_count;
+
+         if (velems_cache) {
+            velems_cache->inputs_read = inputs_read;
+            velems_cache->dual_slot_inputs = dual_slot_inputs;
+            velems_cache->enabled_arrays = enabled_arrays;
+            velems_cache->map_mode = vao->_AttributeMapMode;
+            velems_cache->count = velems_count;
+            /* Only copy the used part, the cso hash only looks at that. */
+            velems_cache->velems.count = velems_count;
+            memcpy(velems_cache->velems.velems, velements.velems,
+                   velems_count * sizeof(velements.velems[0]));
+            vao->NewVertexElements = false;
+         }
+      }
 
       /* Set vertex buffers and elements. */
       if (FILL_TC_SET_VB) {
-         void *state = cso_get_vertex_elements_for_bind(cso, &velements);
+         void *state = cso_get_vertex_elements_for_bind(cso, bind_velems);
          tc_set_vertex_elements_for_call(st->pipe, vbuffer, state);
       } else {
-         cso_set_vertex_buffers_and_elements(cso, &velements, num_vbuffers,
+         cso_set_vertex_buffers_and_elements(cso, bind_velems, num_vbuffers,
                                              uses_user_vertex_buffers, vbuffer);
       }
       /* The driver should clear this after it has processed the update. */
@@ -498,7 +557,8 @@ st_update_array_templ(struct st_context *st,
 typedef void (*update_array_func)(struct st_context *st,
                                   const GLbitfield enabled_arrays,
                                   const GLbitfield enabled_user_attribs,
-                                  const GLbitfield nonzero_divisor_attribs);
+                                  const GLbitfield nonzero_divisor_attribs,
+                                  struct st_vao_velems *velems_cache);
 
 /* This just initializes the table of all st_update_array variants. */
 struct st_update_array_table {
@@ -616,7 +676,8 @@ st_update_array_impl(struct st_context *st)
       st_update_array_templ<POPCNT, FILL_TC_SET_VB_OFF, VAO_FAST_PATH_OFF,
                             ZERO_STRIDE_ATTRIBS_ON, IDENTITY_ATTRIB_MAPPING_OFF,
                             USER_BUFFERS_ON, UPDATE_VELEMS_ON>
-         (st, enabled_arrays, enabled_user_arrays, nonzero_divisor_arrays);
+         (st, enabled_arrays, enabled_user_arrays, nonzero_divisor_arrays,
+          NULL);
       return;
    }
 
@@ -643,10 +704,26 @@ st_update_array_impl(struct st_context *st)
    bool update_velems = ctx->Array.NewVertexElements ||
                         st->uses_user_vertex_buffers != has_user_buffers;
 
+   /* Vertex elements are cached per VAO, unless they also depend on current
+    * attribs or user buffers.  Shared VAOs can be used by several contexts
+    * at once, so they don't get a cache either.
+    */
+   struct st_vao_velems *velems_cache = NULL;
+   if (update_velems && !has_zero_stride_attribs && !has_user_buffers &&
+       !vao->SharedAndImmutable) {
+      if (!vao->VelemsCache) {
+         vao->VelemsCache =
+            (struct st_vao_velems *)malloc(sizeof(*vao->VelemsCache));
+         vao->NewVertexElements = true;
+      }
+      velems_cache = vao->VelemsCache;
+   }
+
    update_array_table.funcs[POPCNT][fill_tc_set_vbs][has_zero_stride_attribs]
                            [has_identity_mapping][has_user_buffers]
                            [update_velems]
-      (st, enabled_arrays, enabled_user_arrays, nonzero_divisor_arrays);
+      (st, enabled_arrays, enabled_user_arrays, nonzero_divisor_arrays,
+       velems_cache);
 }
 
 /* The default callback that must be present before st_init_update_array
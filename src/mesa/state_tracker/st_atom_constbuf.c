@@ -62,6 +62,47 @@ st_unbind_unused_cb0(struct st_context *st, mesa_shader_stage shader_type)
    }
 }
 
+/* Returns true if the constants match the last ones uploaded for the stage,
+ * otherwise records them, so that the next upload can be compared.
+ */
+static bool
+st_constbuf0_cache_match(struct st_context *st, mesa_shader_stage stage,
+                         const gl_constant_value *values, unsigned size)
+{
+   struct st_constbuf0_cache *cache = &st->state.constbuf0_cache[stage];
+
+   if (cache->buffer && cache->size == size &&
+       !memcmp(cache->values, values, size))
+      return true;
+
+   pipe_resource_reference(&cache->buffer, NULL);
+
+   if (size > cache->size || !cache->values) {
+      free(cache->values);
+      cache->values = malloc(size);
+      cache->size = 0;
+      if (!cache->values)
+         return false;
+   }
+
+   memcpy(cache->values, values, size);
+   cache->size = size;
+   return false;
+}
+
+void
+st_destroy_constbuf0_cache(struct st_context *st)
+{
+   for (unsigned i = 0; i < ARRAY_SIZE(st->state.constbuf0_cache); i++) {
+      struct st_constbuf0_cache *cache = &st->state.constbuf0_cache[i];
+
+      pipe_resource_reference(&cache->buffer, NULL);
+      free(cache->values);
+      cache->values = NULL;
+      cache->size = 0;
+   }
+}
+
 /**
  * Pass the given program parameters to the graphics pipe as a
  * constant buffer.
@@ -123,59 +164,62 @@ st_upload_constants(struct st_context *st, struct gl_program *prog, mesa_shader_
       /* this path cannot be used with select/feedback draws */
       if (st->prefer_real_buffer_in_constbuf0) {
          struct pipe_context *pipe = st->pipe;
-         struct pipe_resource *releasebuf = NULL;
-         uint32_t *ptr;
-
-         const unsigned alignment = MAX2(
-            st->ctx->Const.UniformBufferOffsetAlignment, 64);
+         struct st_constbuf0_cache *cache = &st->state.constbuf0_cache[stage];
 
-         /* fetch_state always stores 4 components (16 bytes) per matrix row,
-          * but matrix rows are sometimes allocated partially, so add 12
-          * to compensate for the fetch_state defect.
-          */
-         u_upload_alloc(pipe->const_uploader, 0, paramBytes + 12,
-            alignment, &cb.buffer_offset, &cb.buffer, &releasebuf, (void**)&ptr);
-
-         int uniform_bytes = params->UniformBytes;
-         if (uniform_bytes)
-            memcpy(ptr, params->ParameterValues, uniform_bytes);
-
-         /* Upload the constants which come from fixed-function state, such as
+         /* Update the constants which come from fixed-function state, such as
           * transformation matrices, fog factors, etc.
           */
          if (params->StateFlags)
-            _mesa_upload_state_parameters(st->ctx, params, ptr);
-
-         u_upload_unmap(pipe->const_uploader);
-         pipe->set_constant_buffer(pipe, stage, 0, &cb);
+            _mesa_load_state_parameters(st->ctx, params);
 
-         /* Set inlinable constants. This is more involved because state
-          * parameters are uploaded directly above instead of being loaded
-          * into gl_program_parameter_list. The easiest way to get their values
-          * is to load them.
+         /* Program switches and state changes that don't affect this
+          * program's constants flag them too, so rebind the last upload
+          * if nothing changed.
           */
+         if (st_constbuf0_cache_match(st, stage, params->ParameterValues,
+                                      paramBytes)) {
+            cb.buffer = cache->buffer;
+            cb.buffer_offset = cache->offset;
+            pipe->set_constant_buffer(pipe, stage, 0, &cb);
+         } else {
+            struct pipe_resource *releasebuf = NULL;
+            uint32_t *ptr;
+
+            const unsigned alignment = MAX2(
+               st->ctx->Const.UniformBufferOffsetAlignment, 64);
+
+            /* fetch_state always stores 4 components (16 bytes) per matrix
+             * row, but matrix rows are sometimes allocated partially, so add
+             * 12 to compensate for the fetch_state defect.
+             */
+            u_upload_alloc(pipe->const_uploader, 0, paramBytes + 12,
+               alignment, &cb.buffer_offset, &cb.buffer, &releasebuf, (void**)&ptr);
+
+            memcpy(ptr, params->ParameterValues, paramBytes);
+
+            u_upload_unmap(pipe->const_uploader);
+            pipe->set_constant_buffer(pipe, stage, 0, &cb);
+
+            if (cache->values) {
+               pipe_resource_reference(&cache->buffer, cb.buffer);
+               cache->offset = cb.buffer_offset;
+            }
+            st_add_releasebuf(st, releasebuf);
+         }
+
+         /* Set inlinable constants. */
          unsigned num_inlinable_uniforms = prog->info.num_inlinable_uniforms;
          if (num_inlinable_uniforms) {
             uint32_t values[MAX_INLINABLE_UNIFORMS];
             gl_constant_value *constbuf = params->ParameterValues;
-            bool loaded_state_vars = false;
-
-            for (unsigned i = 0; i < num_inlinable_uniforms; i++) {
-               unsigned dw_offset = prog->info.inlinable_uniform_dw_offsets[i];
-
-               if (dw_offset * 4 >= uniform_bytes && !loaded_state_vars) {
-                  _mesa_load_state_parameters(st->ctx, params);
-                  loaded_state_vars = true;
-               }
 
+            for (unsigned i = 0; i < num_inlinable_uniforms; i++)
                values[i] = constbuf[prog->info.inlinable_uniform_dw_offsets[i]].u;
-            }
 
             pipe->set_inlinable_constants(pipe, stage,
                                           prog->info.num_inlinable_uniforms,
                                           values);
          }
-         st_add_releasebuf(st, releasebuf);
       } else {
          struct pipe_context *pipe = st->pipe;
 
@@ -36,5 +36,7 @@ struct st_context;
 
 void st_upload_constants(struct st_context *st, struct gl_program *prog, mesa_shader_stage stage);
 
+void st_destroy_constbuf0_cache(struct st_context *st);
+
 
 #endif /* ST_ATOM_CONSTBUF_H */
@@ -44,6 +44,7 @@
 #include "pipe/p_defines.h"
 #include "pipe/p_screen.h"
 #include "util/u_gen_mipmap.h"
+#include "util/u_upload_mgr.h"
 #include "util/perf/cpu_trace.h"
 
 
@@ -61,6 +62,12 @@ st_flush(struct st_context *st,
 
    st_flush_bitmap_cache(st);
    st->pipe->flush(st->pipe, fence, flags);
+
+   if (fence && *fence) {
+      u_upload_fence(st->pipe->stream_uploader, *fence);
+      if (st->pipe->const_uploader != st->pipe->stream_uploader)
+         u_upload_fence(st->pipe->const_uploader, *fence);
+   }
 }
 
 
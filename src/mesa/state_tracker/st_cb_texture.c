@@ -686,6 +686,72 @@ upload_astc_slice_with_flushed_void_extents(uint8_t *dst,
    }
 }
 
+/* Uploads a whole compressed fallback image with compute shaders, returns
+ * false if the format pair isn't handled or it failed.
+ */
+static bool
+try_compute_fallback_upload(struct st_context *st,
+                            struct gl_texture_image *texImage,
+                            struct st_texture_image_transfer *itransfer)
+{
+   struct pipe_resource *pt = texImage->pt;
+   const unsigned level = st_texture_image_resource_level(texImage);
+   const unsigned layer = itransfer->box.z;
+   const bool is_dxt_target = pt->format == PIPE_FORMAT_DXT1_RGB ||
+                              pt->format == PIPE_FORMAT_DXT1_SRGB ||
+                              pt->format == PIPE_FORMAT_DXT5_RGBA ||
+                              pt->format == PIPE_FORMAT_DXT5_SRGBA;
+
+   if (_mesa_is_format_astc_2d(texImage->TexFormat)) {
+      switch (pt->format) {
+      case PIPE_FORMAT_DXT5_RGBA:
+      case PIPE_FORMAT_DXT5_SRGBA:
+         return st_compute_transcode_astc_to_dxt5(st, itransfer->temp_data,
+                                                  itransfer->temp_stride,
+                                                  texImage->TexFormat,
+                                                  pt, level, layer);
+      case PIPE_FORMAT_R8G8B8A8_UNORM:
+      case PIPE_FORMAT_R8G8B8A8_SRGB:
+         return st_compute_decode_astc(st, itransfer->temp_data,
+                                       itransfer->temp_stride,
+                                       texImage->TexFormat,
+                                       pt, level, layer);
+      default:
+         return false;
+      }
+   }
+
+   /* ETC decodes quickly on the CPU, it's the DXT encode that is slow. */
+   if ((texImage->TexFormat == MESA_FORMAT_ETC1_RGB8 ||
+        _mesa_is_format_etc2(texImage->TexFormat)) && is_dxt_target) {
+      const unsigned width = itransfer->box.width;
+      const unsigned height = itransfer->box.height;
+      uint8_t *tmp = malloc((size_t)width * height * 4);
+      if (!tmp)
+         return false;
+
+      if (texImage->TexFormat == MESA_FORMAT_ETC1_RGB8) {
+         _mesa_etc1_unpack_rgba8888(tmp, width * 4,
+                                    itransfer->temp_data,
+                                    itransfer->temp_stride,
+                                    width, height);
+      } else {
+         _mesa_unpack_etc2_format(tmp, width * 4,
+                                  itransfer->temp_data,
+                                  itransfer->temp_stride,
+                                  width, height,
+                                  texImage->TexFormat, false);
+      }
+
+      bool success = st_compute_encode_dxt(st, tmp, width * 4,
+                                           pt, level, layer);
+      free(tmp);
+      return success;
+   }
+
+   return false;
+}
+
 void
 st_UnmapTextureImage(struct gl_context *ctx,
                      struct gl_texture_image *texImage,
@@ -706,39 +772,25 @@ st_UnmapTextureImage(struct gl_context *ctx,
          const bool log_unmap_time = false;
          const int64_t unmap_start_us = log_unmap_time ? os_time_get() : 0;
 
-         if (_mesa_is_format_astc_2d(texImage->TexFormat) &&
-             !_mesa_is_format_astc_2d(texImage->pt->format) &&
-             util_format_is_compressed(texImage->pt->format)) {
-
-            /* DXT5 is the only supported transcode target from ASTC. */
-            assert(texImage->pt->format == PIPE_FORMAT_DXT5_RGBA ||
-                   texImage->pt->format == PIPE_FORMAT_DXT5_SRGBA);
-
-            /* Try a compute-based transcode. */
-            if (itransfer->box.x == 0 &&
-                itransfer->box.y == 0 &&
-                itransfer->box.width == texImage->Width &&
-                itransfer->box.height == texImage->Height &&
-                _mesa_has_compute_shaders(ctx) &&
-                st_compute_transcode_astc_to_dxt5(st,
-                   itransfer->temp_data,
-                   itransfer->temp_stride,
-                   texImage->TexFormat,
-                   texImage->pt,
-                   st_texture_image_resource_level(texImage),
-                   itransfer->box.z)) {
-
-               if (log_unmap_time) {
-                  log_unmap_time_delta(&itransfer->box, texImage, "GPU",
-                                       unmap_start_us);
-               }
-
-               /* Mark the unmap as complete. */
-               assert(itransfer->transfer == NULL);
-               memset(itransfer, 0, sizeof(struct st_texture_image_transfer));
-
-               return;
+         /* Try a compute-based transcode or decode. */
+         if (itransfer->box.x == 0 &&
+             itransfer->box.y == 0 &&
+             itransfer->box.width == texImage->Width &&
+             itransfer->box.height == texImage->Height &&
+             _mesa_has_compute_shaders(ctx) &&
+             st->texcompress_compute.progs &&
+             try_compute_fallback_upload(st, texImage, itransfer)) {
+
+            if (log_unmap_time) {
+               log_unmap_time_delta(&itransfer->box, texImage, "GPU",
+                                    unmap_start_us);
             }
+
+            /* Mark the unmap as complete. */
+            assert(itransfer->transfer == NULL);
+            memset(itransfer, 0, sizeof(struct st_texture_image_transfer));
+
+            return;
          }
 
          struct pipe_transfer *transfer;
@@ -1732,11 +1784,44 @@ reinterpret_formats(enum pipe_format *src_format, enum pipe_format *dst_format)
    return true;
 }
 
+/* Picks the texture buffer format to sample and the render target format to
+ * write for a PBO upload.  The formats are only updated on success.
+ */
+static bool
+choose_pbo_upload_formats(struct st_context *st,
+                          enum pipe_format *src_format,
+                          enum pipe_format *dst_format)
+{
+   struct pipe_screen *screen = st->screen;
+   enum pipe_format src = *src_format;
+   enum pipe_format dst = *dst_format;
+
+   if (st->pbo.rgba_only) {
+      if (!reinterpret_formats(&src, &dst))
+         return false;
+
+      if (dst != *dst_format &&
+          !screen->is_format_supported(screen, dst, PIPE_TEXTURE_2D, 0,
+                                       0, PIPE_BIND_RENDER_TARGET))
+         return false;
+   }
+
+   if (!src ||
+       !screen->is_format_supported(screen, src, PIPE_BUFFER, 0, 0,
+                                    PIPE_BIND_SAMPLER_VIEW))
+      return false;
+
+   *src_format = src;
+   *dst_format = dst;
+   return true;
+}
+
 static bool
 try_pbo_upload_common(struct gl_context *ctx,
                       struct pipe_surface *surface,
                       const struct st_pbo_addresses *addr,
-                      enum pipe_format src_format)
+                      enum pipe_format src_format,
+                      enum pipe_format packed_format)
 {
    struct st_context *st = st_context(ctx);
    struct cso_context *cso = st->cso_context;
@@ -1744,7 +1829,12 @@ try_pbo_upload_common(struct gl_context *ctx,
    bool success = false;
    void *fs;
 
-   fs = st_pbo_get_upload_fs(st, src_format, surface->format, addr->depth != 1);
+   if (packed_format != PIPE_FORMAT_NONE)
+      fs = st_pbo_get_upload_unpack_fs(st, packed_format, surface->format,
+                                       addr->depth != 1);
+   else
+      fs = st_pbo_get_upload_fs(st, src_format, surface->format,
+                                addr->depth != 1);
    if (!fs)
       return false;
 
@@ -1858,6 +1948,7 @@ try_pbo_upload(struct gl_context *ctx, GLuint dims,
    struct pipe_screen *screen = st->screen;
    struct st_pbo_addresses addr;
    enum pipe_format src_format;
+   enum pipe_format packed_format = PIPE_FORMAT_NONE;
    const struct util_format_description *desc;
    GLenum gl_target = texImage->TexObject->Target;
    bool success;
@@ -1895,26 +1986,22 @@ try_pbo_upload(struct gl_context *ctx, GLuint dims,
    if (desc->colorspace != UTIL_FORMAT_COLORSPACE_RGB)
       return false;
 
-   if (st->pbo.rgba_only) {
-      enum pipe_format orig_dst_format = dst_format;
-
-      if (!reinterpret_formats(&src_format, &dst_format)) {
-         return false;
-      }
+   if (!choose_pbo_upload_formats(st, &src_format, &dst_format)) {
+      /* Packed formats like B5G6R5 or R10G10B10A2 that the driver can't
+       * sample from a texture buffer can still be fetched one integer per
+       * texel and unpacked in the shader, which also takes care of the
+       * swizzle, so dst_format is used as is.
+       */
+      packed_format = src_format;
+      src_format = st_pbo_get_unpack_view_format(packed_format);
 
-      if (dst_format != orig_dst_format &&
-          !screen->is_format_supported(screen, dst_format, PIPE_TEXTURE_2D, 0,
-                                       0, PIPE_BIND_RENDER_TARGET)) {
+      if (!src_format ||
+          !screen->is_format_supported(screen, src_format, PIPE_BUFFER, 0, 0,
+                                       PIPE_BIND_SAMPLER_VIEW)) {
          return false;
       }
    }
 
-   if (!src_format ||
-       !screen->is_format_supported(screen, src_format, PIPE_BUFFER, 0, 0,
-                                    PIPE_BIND_SAMPLER_VIEW)) {
-      return false;
-   }
-
    /* Compute buffer addresses */
    addr.xoffset = xoffset;
    addr.yoffset = yoffset;
@@ -1943,7 +2030,8 @@ try_pbo_upload(struct gl_context *ctx, GLuint dims,
    templ.context = st->pipe;
    templ.texture = texture;
 
-   success = try_pbo_upload_common(ctx, &templ, &addr, src_format);
+   success = try_pbo_upload_common(ctx, &templ, &addr, src_format,
+                                   packed_format);
 
    return success;
 }
@@ -2448,7 +2536,8 @@ st_try_pbo_compressed_texsubimage(struct gl_context *ctx,
    if (!st_pbo_addresses_setup(st, buf, buf_offset, &addr))
       return false;
 
-   return try_pbo_upload_common(ctx, surface_templ, &addr, surface_templ->format);
+   return try_pbo_upload_common(ctx, surface_templ, &addr, surface_templ->format,
+                                PIPE_FORMAT_NONE);
 }
 
 void
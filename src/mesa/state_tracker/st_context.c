@@ -31,6 +31,7 @@
 #include "main/debug_output.h"
 #include "main/framebuffer.h"
 #include "main/glthread.h"
+#include "main/shaderapi.h"
 #include "main/shaderobj.h"
 #include "main/state.h"
 #include "main/version.h"
@@ -49,6 +50,7 @@
 #include "st_cb_feedback.h"
 #include "st_cb_flush.h"
 #include "st_atom.h"
+#include "st_atom_constbuf.h"
 #include "st_draw.h"
 #include "st_extensions.h"
 #include "st_gen_mipmap.h"
@@ -341,6 +343,16 @@ st_context_free_zombie_objects(struct st_context *st)
 }
 
 
+/* Compute shaders are used to transcode or decode the ASTC and ETC formats
+ * the driver can't sample instead of doing it on the CPU.
+ */
+static bool
+use_texcompress_compute(struct st_context *st)
+{
+   return _mesa_has_compute_shaders(st->ctx) &&
+          (st->transcode_astc || st->transcode_etc || !st->has_astc_2d_ldr);
+}
+
 static void
 st_destroy_context_priv(struct st_context *st, bool destroy_pipe)
 {
@@ -350,12 +362,14 @@ st_destroy_context_priv(struct st_context *st, bool destroy_pipe)
    st_destroy_drawpix(st);
    st_destroy_drawtex(st);
    st_destroy_pbo_helpers(st);
+   st_destroy_gen_mipmap(st);
 
-   if (_mesa_has_compute_shaders(st->ctx) && st->transcode_astc)
+   if (use_texcompress_compute(st))
       st_destroy_texcompress_compute(st);
 
    st_destroy_bound_texture_handles(st);
    st_destroy_bound_image_handles(st);
+   st_destroy_constbuf0_cache(st);
 
    /* free glReadPixels cache data */
    st_invalidate_readpix_cache(st);
@@ -483,6 +497,13 @@ st_create_context_priv(struct gl_context *ctx, struct pipe_context *pipe,
    st->cso_context = cso_create_context(pipe, cso_flags);
    ctx->cso_context = st->cso_context;
 
+   /* st_flush hands the fences it gets to the uploaders, which lets them
+    * reuse their full buffers once they are idle.
+    */
+   u_upload_enable_ring(pipe->stream_uploader, 4);
+   if (pipe->const_uploader != pipe->stream_uploader)
+      u_upload_enable_ring(pipe->const_uploader, 4);
+
 #define ST_STATE(FLAG, st_update) st->update_functions[FLAG] = st_update;
 #include "st_atom_list.h"
 #undef ST_STATE
@@ -742,8 +763,7 @@ st_create_context_priv(struct gl_context *ctx, struct pipe_context *pipe,
       return NULL;
    }
 
-   if (_mesa_has_compute_shaders(ctx) &&
-       st->transcode_astc && !st_init_texcompress_compute(st)) {
+   if (use_texcompress_compute(st) && !st_init_texcompress_compute(st)) {
       /* Transcoding ASTC to DXT5 using compute shaders can provide a
        * significant performance benefit over the CPU path. It isn't strictly
        * necessary to fail if we can't use the compute shader path, but it's
@@ -944,6 +964,9 @@ st_destroy_context(struct st_context *st)
    /* This must be called first so that glthread has a chance to finish */
    _mesa_glthread_destroy(ctx);
 
+   /* Finishing a link needs the state tracker. */
+   _mesa_finish_pending_links(ctx);
+
    _mesa_HashWalk(&ctx->Shared->TexObjects, destroy_tex_sampler_cb, st);
 
    /* For the fallback textures, free any sampler views belonging to this
@@ -231,6 +231,17 @@ struct st_context
       unsigned num_images[MESA_SHADER_MESH_STAGES];
       struct pipe_clip_state clip;
       unsigned constbuf0_enabled_shader_mask;
+      /**
+       * Last CB0 uploaded to a real buffer for each stage, with a copy of
+       * its contents, so unchanged constants are rebound rather than
+       * uploaded again, e.g. when switching back and forth between programs.
+       */
+      struct st_constbuf0_cache {
+         struct pipe_resource *buffer;
+         unsigned offset;
+         unsigned size;
+         gl_constant_value *values;
+      } constbuf0_cache[MESA_SHADER_MESH_STAGES];
       unsigned fb_width;
       unsigned fb_height;
       unsigned fb_num_samples;
@@ -335,6 +346,12 @@ struct st_context
       void *vs;
       void *gs;
       void *upload_fs[5][2];
+      /**
+       * Upload FS unpacking bitmask formats the driver can't sample from a
+       * texture buffer, each a pointer to an array of PIPE_FORMAT_COUNT
+       * elements indexed by the packed format.
+       */
+      void *upload_unpack_fs[5][2];
       /**
        * For drivers supporting formatless storing
        * (pipe_caps.image_store_formatted) it is a pointer to the download FS;
@@ -351,6 +368,9 @@ struct st_context
       bool use_gs;
    } pbo;
 
+   /** Compute shaders of st_generate_mipmap, [is_array][is_srgb] */
+   void *gen_mipmap_cs[2][2];
+
    struct {
       struct gl_program **progs;
       struct pipe_resource *bc1_endpoint_buf;
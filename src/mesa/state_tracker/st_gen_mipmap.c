@@ -36,15 +36,353 @@
 #include "util/u_inlines.h"
 #include "util/format/u_format.h"
 #include "util/u_gen_mipmap.h"
+#include "cso_cache/cso_context.h"
+#include "compiler/nir/nir_builder.h"
+#include "compiler/nir/nir_format_convert.h"
 
+#include "st_atom.h"
 #include "st_debug.h"
 #include "st_context.h"
+#include "st_nir.h"
 #include "st_texture.h"
 #include "st_util.h"
 #include "st_gen_mipmap.h"
 #include "st_cb_bitmap.h"
 #include "st_cb_texture.h"
 
+/* Each workgroup of the compute path reduces a TILE x TILE block of the
+ * first level it writes down to a single texel, writing up to CS_LEVELS
+ * levels in one dispatch.
+ */
+#define GEN_MIPMAP_CS_TILE 8
+#define GEN_MIPMAP_CS_LEVELS 4
+
+static nir_def *
+average4(nir_builder *b, nir_def **texels)
+{
+   nir_def *sum = nir_fadd(b, nir_fadd(b, texels[0], texels[1]),
+                              nir_fadd(b, texels[2], texels[3]));
+   return nir_fmul_imm(b, sum, 0.25);
+}
+
+static void
+store_level(nir_builder *b, nir_variable *img, nir_def *pos, nir_def *layer,
+            nir_def *size, nir_def *color, bool is_srgb)
+{
+   if (is_srgb) {
+      nir_def *rgb = nir_format_linear_to_srgb(b, nir_trim_vector(b, color, 3));
+      color = nir_vector_insert_imm(b, nir_pad_vector(b, rgb, 4),
+                                    nir_channel(b, color, 3), 3);
+   }
+
+   nir_def *zero = nir_imm_int(b, 0);
+   nir_def *coord = nir_vec4(b, nir_channel(b, pos, 0), nir_channel(b, pos, 1),
+                             layer ? layer : zero, zero);
+
+   nir_push_if(b, nir_ball(b, nir_ult(b, pos, size)));
+   nir_image_deref_store(b, &nir_build_deref_var(b, img)->def, coord,
+                         nir_undef(b, 1, 32), color, zero,
+                         .image_dim = GLSL_SAMPLER_DIM_2D,
+                         .image_array = layer != NULL,
+                         .src_type = nir_type_float32,
+                         .access = ACCESS_NON_READABLE);
+   nir_pop_if(b, NULL);
+}
+
+/* Generates num_levels levels from the bound source level, each a 2x2 box
+ * filter of the previous one.  Levels after the first are reduced in shared
+ * memory, so the sizes of all levels but the last must be even.
+ *
+ * params = [ num_levels, width, height ] of the first level written.
+ */
+static void *
+create_gen_mipmap_cs(struct st_context *st, bool is_array, bool is_srgb)
+{
+   const nir_shader_compiler_options *options =
+      st->screen->nir_options[MESA_SHADER_COMPUTE];
+   nir_builder b = nir_builder_init_simple_shader(MESA_SHADER_COMPUTE, options,
+                                                  "st/gen_mipmap CS");
+   b.shader->info.workgroup_size[0] = GEN_MIPMAP_CS_TILE;
+   b.shader->info.workgroup_size[1] = GEN_MIPMAP_CS_TILE;
+   b.shader->info.workgroup_size[2] = 1;
+   b.shader->info.shared_size =
+      GEN_MIPMAP_CS_TILE * GEN_MIPMAP_CS_TILE * 4 * sizeof(float);
+   b.shader->num_uniforms = 4;
+
+   nir_variable *param_var =
+      nir_variable_create(b.shader, nir_var_uniform, glsl_uvec4_type(), "params");
+   nir_def *params = nir_load_var(&b, param_var);
+   nir_def *num_levels = nir_channel(&b, params, 0);
+   nir_def *size = nir_channels(&b, params, 0x6);
+
+   nir_variable *tex_var =
+      nir_variable_create(b.shader, nir_var_uniform,
+                          glsl_sampler_type(GLSL_SAMPLER_DIM_2D, false,
+                                            is_array, GLSL_TYPE_FLOAT),
+                          "tex");
+   tex_var->data.explicit_binding = true;
+   tex_var->data.binding = 0;
+
+   nir_variable *img_vars[GEN_MIPMAP_CS_LEVELS];
+   for (unsigned i = 0; i < GEN_MIPMAP_CS_LEVELS; i++) {
+      img_vars[i] =
+         nir_variable_create(b.shader, nir_var_image,
+                             glsl_image_type(GLSL_SAMPLER_DIM_2D, is_array,
+                                             GLSL_TYPE_FLOAT), "img");
+      img_vars[i]->data.access = ACCESS_NON_READABLE;
+      img_vars[i]->data.explicit_binding = true;
+      img_vars[i]->data.binding = i;
+   }
+
+   nir_def *wg_id = nir_load_workgroup_id(&b);
+   nir_def *local_id = nir_trim_vector(&b, nir_load_local_invocation_id(&b), 2);
+   nir_def *pos = nir_iadd(&b, nir_imul_imm(&b, nir_trim_vector(&b, wg_id, 2),
+                                            GEN_MIPMAP_CS_TILE),
+                           local_id);
+   nir_def *layer = is_array ? nir_channel(&b, wg_id, 2) : NULL;
+
+   /* The first level is filtered from the source texture. */
+   nir_deref_instr *tex_deref = nir_build_deref_var(&b, tex_var);
+   nir_def *src_pos = nir_ishl_imm(&b, pos, 1);
+   nir_def *texels[4];
+   for (unsigned i = 0; i < 4; i++) {
+      nir_def *coord = nir_iadd(&b, src_pos, nir_imm_ivec2(&b, i & 1, i >> 1));
+      if (layer) {
+         coord = nir_vec3(&b, nir_channel(&b, coord, 0),
+                          nir_channel(&b, coord, 1), layer);
+      }
+      texels[i] = nir_txf(&b, coord, .texture_deref = tex_deref,
+                          .lod = nir_imm_int(&b, 0));
+   }
+
+   nir_def *color = average4(&b, texels);
+   store_level(&b, img_vars[0], pos, layer, size, color, is_srgb);
+
+   /* Every invocation owns one vec4 of shared memory, laid out by the local
+    * position in the first level.
+    */
+   nir_def *lx = nir_channel(&b, local_id, 0);
+   nir_def *ly = nir_channel(&b, local_id, 1);
+   nir_def *addr = nir_imul_imm(&b, nir_iadd(&b, nir_imul_imm(&b, ly, GEN_MIPMAP_CS_TILE),
+                                             lx), 16);
+   nir_store_shared(&b, color, addr);
+
+   for (unsigned level = 1; level < GEN_MIPMAP_CS_LEVELS; level++) {
+      const unsigned step = 1 << (level - 1);
+
+      nir_push_if(&b, nir_uge_imm(&b, num_levels, level + 1));
+
+      nir_barrier(&b, .execution_scope = SCOPE_WORKGROUP,
+                  .memory_scope = SCOPE_WORKGROUP,
+                  .memory_semantics = NIR_MEMORY_ACQ_REL,
+                  .memory_modes = nir_var_mem_shared);
+
+      /* Only the invocations at the top left of each 2x2 block of the
+       * previous level carry on, the others provide their texels.
+       */
+      nir_def *owner = nir_ieq_imm(&b, nir_iand_imm(&b, nir_ior(&b, lx, ly),
+                                                    (step << 1) - 1), 0);
+      nir_push_if(&b, owner);
+
+      for (unsigned i = 0; i < 4; i++) {
+         const unsigned offset =
+            ((i >> 1) * step * GEN_MIPMAP_CS_TILE + (i & 1) * step) * 16;
+         texels[i] = nir_load_shared(&b, 4, 32, nir_iadd_imm(&b, addr, offset));
+      }
+
+      color = average4(&b, texels);
+      store_level(&b, img_vars[level], nir_ushr_imm(&b, pos, level), layer,
+                  nir_ushr_imm(&b, size, level), color, is_srgb);
+      nir_store_shared(&b, color, addr);
+
+      nir_pop_if(&b, NULL);
+      nir_pop_if(&b, NULL);
+   }
+
+   return st_nir_finish_builtin_shader(st, b.shader);
+}
+
+static bool
+can_gen_mipmap_compute(struct st_context *st, struct pipe_resource *pt,
+                       enum pipe_format format)
+{
+   struct pipe_screen *screen = st->screen;
+
+   if (!screen->caps.prefer_compute_for_mipmaps ||
+       !screen->caps.image_store_formatted)
+      return false;
+
+   if (pt->target != PIPE_TEXTURE_2D &&
+       pt->target != PIPE_TEXTURE_2D_ARRAY &&
+       pt->target != PIPE_TEXTURE_CUBE &&
+       pt->target != PIPE_TEXTURE_CUBE_ARRAY)
+      return false;
+
+   if (pt->nr_samples > 1 ||
+       util_format_is_depth_or_stencil(format) ||
+       util_format_is_pure_integer(format) ||
+       util_format_is_compressed(format))
+      return false;
+
+   /* sRGB is encoded by the shader, the images are stored as linear. */
+   return screen->is_format_supported(screen, format, pt->target, 0, 0,
+                                      PIPE_BIND_SAMPLER_VIEW) &&
+          screen->is_format_supported(screen, util_format_linear(format),
+                                      pt->target, 0, 0,
+                                      PIPE_BIND_SHADER_IMAGE);
+}
+
+/* Returns whether a level can be reduced in the shared memory of the
+ * compute shader, with the 2x2 box filter matching the blit.
+ */
+static bool
+is_level_even(struct pipe_resource *pt, unsigned level)
+{
+   return u_minify(pt->width0, level) % 2 == 0 &&
+          u_minify(pt->height0, level) % 2 == 0;
+}
+
+/**
+ * Generates the mipmap levels with compute shaders, writing up to
+ * GEN_MIPMAP_CS_LEVELS levels per dispatch rather than blitting them one
+ * at a time.  Levels with odd sizes, which can't be reduced in shared
+ * memory, are blitted.
+ */
+static bool
+gen_mipmap_compute(struct st_context *st, struct pipe_resource *pt,
+                   enum pipe_format format,
+                   unsigned base_level, unsigned last_level,
+                   unsigned first_layer, unsigned last_layer)
+{
+   struct pipe_context *pipe = st->pipe;
+   struct cso_context *cso = st->cso_context;
+   const bool is_array = pt->target != PIPE_TEXTURE_2D;
+   const bool is_srgb = util_format_is_srgb(format);
+
+   if (!can_gen_mipmap_compute(st, pt, format))
+      return false;
+
+   if (!st->gen_mipmap_cs[is_array][is_srgb])
+      st->gen_mipmap_cs[is_array][is_srgb] =
+         create_gen_mipmap_cs(st, is_array, is_srgb);
+
+   void *cs = st->gen_mipmap_cs[is_array][is_srgb];
+   if (!cs)
+      return false;
+
+   unsigned src_level = base_level;
+   bool success = true;
+
+   while (src_level < last_level) {
+      if (!is_level_even(pt, src_level)) {
+         if (!util_gen_mipmap(pipe, pt, format, src_level, src_level + 1,
+                              first_layer, last_layer,
+                              PIPE_TEX_FILTER_LINEAR)) {
+            success = false;
+            break;
+         }
+         src_level++;
+         continue;
+      }
+
+      unsigned num_levels = 1;
+      while (num_levels < GEN_MIPMAP_CS_LEVELS &&
+             src_level + num_levels < last_level &&
+             is_level_even(pt, src_level + num_levels))
+         num_levels++;
+
+      const unsigned width = u_minify(pt->width0, src_level + 1);
+      const unsigned height = u_minify(pt->height0, src_level + 1);
+      const uint32_t params[4] = { num_levels, width, height, 0 };
+      struct pipe_constant_buffer cb = {
+         .user_buffer = params,
+         .buffer_size = sizeof(params),
+      };
+      struct pipe_resource *releasebuf = NULL;
+      pipe_upload_constant_buffer0(pipe, MESA_SHADER_COMPUTE, &cb, &releasebuf);
+
+      cso_save_compute_state(cso, CSO_BIT_COMPUTE_SHADER);
+      cso_set_compute_shader_handle(cso, cs);
+
+      struct pipe_sampler_view templ;
+      u_sampler_view_default_template(&templ, pt, format);
+      templ.target = is_array ? PIPE_TEXTURE_2D_ARRAY : PIPE_TEXTURE_2D;
+      templ.u.tex.first_level = templ.u.tex.last_level = src_level;
+      templ.u.tex.first_layer = first_layer;
+      templ.u.tex.last_layer = last_layer;
+
+      struct pipe_sampler_view *view = pipe->create_sampler_view(pipe, pt, &templ);
+      if (!view) {
+         cso_restore_compute_state(cso);
+         pipe_resource_release(pipe, releasebuf);
+         success = false;
+         break;
+      }
+      pipe->set_sampler_views(pipe, MESA_SHADER_COMPUTE, 0, 1, 0, &view);
+
+      /* Unused images point at the first level, the shader doesn't write
+       * them.
+       */
+      struct pipe_image_view images[GEN_MIPMAP_CS_LEVELS];
+      for (unsigned i = 0; i < GEN_MIPMAP_CS_LEVELS; i++) {
+         images[i] = (struct pipe_image_view) {
+            .resource = pt,
+            .format = util_format_linear(format),
+            .access = PIPE_IMAGE_ACCESS_WRITE,
+            .shader_access = PIPE_IMAGE_ACCESS_WRITE,
+            .u.tex.level = src_level + 1 + (i < num_levels ? i : 0),
+            .u.tex.first_layer = first_layer,
+            .u.tex.last_layer = last_layer,
+         };
+      }
+      pipe->set_shader_images(pipe, MESA_SHADER_COMPUTE, 0,
+                              GEN_MIPMAP_CS_LEVELS, 0, images);
+
+      const struct pipe_grid_info info = {
+         .block = { GEN_MIPMAP_CS_TILE, GEN_MIPMAP_CS_TILE, 1 },
+         .grid = { DIV_ROUND_UP(width, GEN_MIPMAP_CS_TILE),
+                   DIV_ROUND_UP(height, GEN_MIPMAP_CS_TILE),
+                   last_layer - first_layer + 1 },
+      };
+      pipe->launch_grid(pipe, &info);
+
+      pipe->set_shader_images(pipe, MESA_SHADER_COMPUTE, 0, 0,
+                              GEN_MIPMAP_CS_LEVELS, NULL);
+      pipe->set_sampler_views(pipe, MESA_SHADER_COMPUTE, 0, 0,
+                              MAX2(st->state.num_sampler_views[MESA_SHADER_COMPUTE], 1),
+                              NULL);
+      st->state.num_sampler_views[MESA_SHADER_COMPUTE] = 0;
+      pipe->sampler_view_release(pipe, view);
+      cso_restore_compute_state(cso);
+      pipe_resource_release(pipe, releasebuf);
+
+      /* The next dispatch samples the last level written. */
+      pipe->memory_barrier(pipe, PIPE_BARRIER_TEXTURE);
+
+      src_level += num_levels;
+   }
+
+   pipe->memory_barrier(pipe, PIPE_BARRIER_ALL);
+
+   ST_SET_STATE4(st->ctx->NewDriverState, ST_NEW_CS_CONSTANTS,
+                 ST_NEW_CS_SAMPLER_VIEWS, ST_NEW_CS_IMAGES, ST_NEW_CS_STATE);
+
+   return success;
+}
+
+void
+st_destroy_gen_mipmap(struct st_context *st)
+{
+   for (unsigned i = 0; i < 2; i++) {
+      for (unsigned j = 0; j < 2; j++) {
+         if (st->gen_mipmap_cs[i][j]) {
+            st->pipe->delete_compute_state(st->pipe, st->gen_mipmap_cs[i][j]);
+            st->gen_mipmap_cs[i][j] = NULL;
+         }
+      }
+   }
+}
+
 void
 st_generate_mipmap(struct gl_context *ctx, GLenum target,
                    struct gl_texture_object *texObj)
@@ -138,14 +476,17 @@ st_generate_mipmap(struct gl_context *ctx, GLenum target,
    }
 
    /* First see if the driver supports hardware mipmap generation,
-    * if not then generate the mipmap by rendering/texturing.
+    * if not then generate the mipmap with compute shaders when the driver
+    * prefers that, or by rendering/texturing.
     * If that fails, use the software fallback.
     */
    if (!st->screen->caps.generate_mipmap ||
        !st->pipe->generate_mipmap(st->pipe, pt, format, baseLevel,
                                   lastLevel, first_layer, last_layer)) {
 
-      if (!util_gen_mipmap(st->pipe, pt, format, baseLevel, lastLevel,
+      if (!gen_mipmap_compute(st, pt, format, baseLevel, lastLevel,
+                              first_layer, last_layer) &&
+          !util_gen_mipmap(st->pipe, pt, format, baseLevel, lastLevel,
                            first_layer, last_layer, PIPE_TEX_FILTER_LINEAR)) {
          _mesa_generate_mipmap(ctx, target, texObj);
       }
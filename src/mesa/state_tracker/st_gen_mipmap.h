@@ -34,11 +34,15 @@
 
 struct gl_context;
 struct gl_texture_object;
+struct st_context;
 
 
 extern void
 st_generate_mipmap(struct gl_context *ctx, GLenum target,
                    struct gl_texture_object *texObj);
 
+extern void
+st_destroy_gen_mipmap(struct st_context *st);
+
 
 #endif /* ST_GEN_MIPMAP_H */
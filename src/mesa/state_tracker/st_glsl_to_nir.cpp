@@ -438,11 +438,6 @@ st_link_glsl_to_nir(struct gl_context *ctx,
    struct gl_linked_shader *linked_shader[MESA_SHADER_MESH_STAGES];
    unsigned num_shaders = 0;
 
-   /* Return early if we are loading the shader from on-disk cache */
-   if (st_load_nir_from_disk_cache(ctx, shader_program)) {
-      return GL_TRUE;
-   }
-
    MESA_TRACE_FUNC();
 
    assert(shader_program->data->LinkStatus);
@@ -626,6 +621,29 @@ st_link_glsl_to_nir(struct gl_context *ctx,
           shader->Stage == MESA_SHADER_TESS_EVAL ||
           shader->Stage == MESA_SHADER_GEOMETRY)
          st_translate_stream_output_info(prog);
+   }
+
+   return true;
+}
+
+/**
+ * Create the driver shaders of the programs produced by st_link_glsl_to_nir.
+ * Unlike the rest of linking, this needs the context.
+ */
+static bool
+st_finalize_linked_programs(struct gl_context *ctx,
+                            struct gl_shader_program *shader_program)
+{
+   struct st_context *st = st_context(ctx);
+
+   MESA_TRACE_FUNC();
+
+   for (unsigned i = 0; i < MESA_SHADER_MESH_STAGES; i++) {
+      struct gl_linked_shader *shader = shader_program->_LinkedShaders[i];
+      if (!shader)
+         continue;
+
+      struct gl_program *prog = shader->Program;
 
       st_store_nir_in_disk_cache(st, prog);
 
@@ -756,10 +774,13 @@ st_finalize_nir(struct st_context *st, struct gl_program *prog,
 }
 
 /**
- * Link a GLSL shader program.  Called via glLinkProgram().
+ * The part of linking a GLSL shader program that doesn't need the context
+ * other than for constants and the shader cache, so that it can run on
+ * another thread, see _mesa_init_link_queue.  st_link_shader_end must be
+ * called after it.
  */
 void
-st_link_shader(struct gl_context *ctx, struct gl_shader_program *prog)
+st_link_shader_begin(struct gl_context *ctx, struct gl_shader_program *prog)
 {
    unsigned int i;
    bool spirv = false;
@@ -813,16 +834,32 @@ st_link_shader(struct gl_context *ctx, struct gl_shader_program *prog)
       prog->SamplersValidated = GL_TRUE;
    }
 
-   if (prog->data->LinkStatus && !st_link_glsl_to_nir(ctx, prog)) {
+   /* The NIR from the disk cache is loaded by st_link_shader_end. */
+   if (prog->data->LinkStatus == LINKING_SUCCESS &&
+       !st_link_glsl_to_nir(ctx, prog)) {
       prog->data->LinkStatus = LINKING_FAILURE;
    }
 
    if (prog->data->LinkStatus != LINKING_FAILURE)
       _mesa_create_program_resource_hash(prog);
+}
+
+/**
+ * Finish linking a GLSL shader program after st_link_shader_begin.
+ */
+void
+st_link_shader_end(struct gl_context *ctx, struct gl_shader_program *prog)
+{
+   MESA_TRACE_FUNC();
 
    /* Return early if we are loading the shader from on-disk cache */
-   if (prog->data->LinkStatus == LINKING_SKIPPED)
+   if (prog->data->LinkStatus == LINKING_SKIPPED) {
+      st_load_nir_from_disk_cache(ctx, prog);
       return;
+   }
+
+   if (prog->data->LinkStatus && !st_finalize_linked_programs(ctx, prog))
+      prog->data->LinkStatus = LINKING_FAILURE;
 
    if (ctx->_Shader->Flags & GLSL_DUMP) {
       if (!prog->data->LinkStatus) {
@@ -841,4 +878,14 @@ st_link_shader(struct gl_context *ctx, struct gl_shader_program *prog)
 #endif
 }
 
+/**
+ * Link a GLSL shader program.  Called via glLinkProgram().
+ */
+void
+st_link_shader(struct gl_context *ctx, struct gl_shader_program *prog)
+{
+   st_link_shader_begin(ctx, prog);
+   st_link_shader_end(ctx, prog);
+}
+
 } /* extern "C" */
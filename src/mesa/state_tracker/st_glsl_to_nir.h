@@ -31,6 +31,12 @@ extern "C" {
 void
 st_link_shader(struct gl_context *ctx, struct gl_shader_program *prog);
 
+void
+st_link_shader_begin(struct gl_context *ctx, struct gl_shader_program *prog);
+
+void
+st_link_shader_end(struct gl_context *ctx, struct gl_shader_program *prog);
+
 #ifdef __cplusplus
 }
 #endif
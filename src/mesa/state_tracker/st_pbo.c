@@ -43,6 +43,7 @@
 #include "util/u_upload_mgr.h"
 
 #include "compiler/nir/nir_builder.h"
+#include "compiler/nir/nir_format_convert.h"
 
 /* Final setup of buffer addressing information.
  *
@@ -393,13 +394,64 @@ st_pbo_sampler_type_for_target(enum pipe_texture_target target,
 
    return glsl_sampler_type(dim[target], false, is_array, type[conv]);
 }
+/* Splits the texel of a bitmask format, fetched as a single integer, into
+ * its channels and applies the format swizzle.
+ */
+static nir_def *
+unpack_texel(nir_builder *b, nir_def *texel, enum pipe_format format)
+{
+   const struct util_format_description *desc = util_format_description(format);
+   nir_def *packed = nir_channel(b, texel, 0);
+   nir_def *chans[4] = { NULL };
+   bool is_integer = false;
+
+   for (unsigned i = 0; i < desc->nr_channels; i++) {
+      const struct util_format_channel_description *chan = &desc->channel[i];
+      const unsigned bits = chan->size;
+
+      if (chan->type == UTIL_FORMAT_TYPE_VOID)
+         continue;
+
+      nir_def *shift = nir_imm_int(b, chan->shift);
+      nir_def *size = nir_imm_int(b, bits);
+
+      if (chan->type == UTIL_FORMAT_TYPE_SIGNED) {
+         chans[i] = nir_ibitfield_extract(b, packed, shift, size);
+         if (chan->normalized)
+            chans[i] = nir_format_snorm_to_float(b, chans[i], &bits);
+      } else {
+         chans[i] = nir_ubitfield_extract(b, packed, shift, size);
+         if (chan->normalized)
+            chans[i] = nir_format_unorm_to_float(b, chans[i], &bits);
+      }
+
+      is_integer |= chan->pure_integer;
+   }
+
+   nir_def *zero = nir_imm_int(b, 0);
+   nir_def *one = is_integer ? nir_imm_int(b, 1) : nir_imm_float(b, 1.0f);
+   nir_def *comps[4];
 
+   for (unsigned i = 0; i < 4; i++) {
+      const unsigned swz = desc->swizzle[i];
+
+      if (swz <= PIPE_SWIZZLE_W && chans[swz])
+         comps[i] = chans[swz];
+      else if (swz == PIPE_SWIZZLE_1)
+         comps[i] = one;
+      else
+         comps[i] = zero;
+   }
+
+   return nir_vec(b, comps, 4);
+}
 
 static void *
 create_fs(struct st_context *st, bool download,
           enum pipe_texture_target target,
           enum st_pbo_conversion conversion,
           enum pipe_format format,
+          enum pipe_format unpack_format,
           bool need_layer)
 {
    const nir_shader_compiler_options *options =
@@ -507,7 +559,10 @@ create_fs(struct st_context *st, bool download,
 
    nir_variable *tex_var =
       nir_variable_create(b.shader, nir_var_uniform,
-                          st_pbo_sampler_type_for_target(target, conversion),
+                          st_pbo_sampler_type_for_target(target,
+                                                         unpack_format ?
+                                                         ST_PBO_CONVERT_UINT :
+                                                         conversion),
                           "tex");
    tex_var->data.explicit_binding = true;
    tex_var->data.binding = 0;
@@ -533,6 +588,9 @@ create_fs(struct st_context *st, bool download,
    nir_builder_instr_insert(&b, &tex->instr);
    nir_def *result = &tex->def;
 
+   if (unpack_format != PIPE_FORMAT_NONE)
+      result = unpack_texel(&b, result, unpack_format);
+
    if (conversion == ST_PBO_CONVERT_SINT_TO_UINT)
       result = nir_imax(&b, result, zero);
    else if (conversion == ST_PBO_CONVERT_UINT_TO_SINT)
@@ -604,11 +662,75 @@ st_pbo_get_upload_fs(struct st_context *st,
    enum st_pbo_conversion conversion = get_pbo_conversion(src_format, dst_format);
 
    if (!st->pbo.upload_fs[conversion][need_layer])
-      st->pbo.upload_fs[conversion][need_layer] = create_fs(st, false, 0, conversion, PIPE_FORMAT_NONE, need_layer);
+      st->pbo.upload_fs[conversion][need_layer] = create_fs(st, false, 0, conversion, PIPE_FORMAT_NONE, PIPE_FORMAT_NONE, need_layer);
 
    return st->pbo.upload_fs[conversion][need_layer];
 }
 
+/**
+ * Returns the single channel integer format holding one texel of the given
+ * bitmask format, e.g. R16_UINT for B5G6R5_UNORM, or PIPE_FORMAT_NONE if the
+ * upload FS can't unpack the format.
+ *
+ * This lets uploads from formats the driver can't sample from a texture
+ * buffer stay on the GPU.
+ */
+enum pipe_format
+st_pbo_get_unpack_view_format(enum pipe_format format)
+{
+   const struct util_format_description *desc = util_format_description(format);
+
+   if (desc->layout != UTIL_FORMAT_LAYOUT_PLAIN ||
+       desc->colorspace != UTIL_FORMAT_COLORSPACE_RGB ||
+       !desc->is_bitmask)
+      return PIPE_FORMAT_NONE;
+
+   for (unsigned i = 0; i < desc->nr_channels; i++) {
+      const struct util_format_channel_description *chan = &desc->channel[i];
+
+      if (chan->type == UTIL_FORMAT_TYPE_VOID)
+         continue;
+      if (chan->type != UTIL_FORMAT_TYPE_UNSIGNED &&
+          chan->type != UTIL_FORMAT_TYPE_SIGNED)
+         return PIPE_FORMAT_NONE;
+      if (!chan->normalized && !chan->pure_integer)
+         return PIPE_FORMAT_NONE;
+   }
+
+   switch (desc->block.bits) {
+   case 8:
+      return PIPE_FORMAT_R8_UINT;
+   case 16:
+      return PIPE_FORMAT_R16_UINT;
+   case 32:
+      return PIPE_FORMAT_R32_UINT;
+   default:
+      return PIPE_FORMAT_NONE;
+   }
+}
+
+void *
+st_pbo_get_upload_unpack_fs(struct st_context *st,
+                            enum pipe_format packed_format,
+                            enum pipe_format dst_format,
+                            bool need_layer)
+{
+   STATIC_ASSERT(ARRAY_SIZE(st->pbo.upload_unpack_fs) == ST_NUM_PBO_CONVERSIONS);
+
+   enum st_pbo_conversion conversion = get_pbo_conversion(packed_format, dst_format);
+
+   if (!st->pbo.upload_unpack_fs[conversion][need_layer]) {
+      st->pbo.upload_unpack_fs[conversion][need_layer] = calloc(sizeof(void *), PIPE_FORMAT_COUNT);
+      if (!st->pbo.upload_unpack_fs[conversion][need_layer])
+         return NULL;
+   }
+
+   void **fs_array = (void **)st->pbo.upload_unpack_fs[conversion][need_layer];
+   if (!fs_array[packed_format])
+      fs_array[packed_format] = create_fs(st, false, 0, conversion, PIPE_FORMAT_NONE, packed_format, need_layer);
+   return fs_array[packed_format];
+}
+
 void *
 st_pbo_get_download_fs(struct st_context *st, enum pipe_texture_target target,
                        enum pipe_format src_format,
@@ -630,12 +752,12 @@ st_pbo_get_download_fs(struct st_context *st, enum pipe_texture_target target,
 
    if (formatless_store) {
       if (!st->pbo.download_fs[conversion][target][need_layer])
-         st->pbo.download_fs[conversion][target][need_layer] = create_fs(st, true, target, conversion, PIPE_FORMAT_NONE, need_layer);
+         st->pbo.download_fs[conversion][target][need_layer] = create_fs(st, true, target, conversion, PIPE_FORMAT_NONE, PIPE_FORMAT_NONE, need_layer);
       return st->pbo.download_fs[conversion][target][need_layer];
    } else {
       void **fs_array = (void **)st->pbo.download_fs[conversion][target][need_layer];
       if (!fs_array[dst_format])
-         fs_array[dst_format] = create_fs(st, true, target, conversion, dst_format, need_layer);
+         fs_array[dst_format] = create_fs(st, true, target, conversion, dst_format, PIPE_FORMAT_NONE, need_layer);
       return fs_array[dst_format];
    }
 }
@@ -704,6 +826,20 @@ st_destroy_pbo_helpers(struct st_context *st)
       }
    }
 
+   for (i = 0; i < ARRAY_SIZE(st->pbo.upload_unpack_fs); ++i) {
+      for (unsigned j = 0; j < ARRAY_SIZE(st->pbo.upload_unpack_fs[0]); j++) {
+         void **fs_array = (void **)st->pbo.upload_unpack_fs[i][j];
+         if (!fs_array)
+            continue;
+
+         for (unsigned k = 0; k < PIPE_FORMAT_COUNT; k++)
+            if (fs_array[k])
+               st->pipe->delete_fs_state(st->pipe, fs_array[k]);
+         free(fs_array);
+         st->pbo.upload_unpack_fs[i][j] = NULL;
+      }
+   }
+
    for (i = 0; i < ARRAY_SIZE(st->pbo.download_fs); ++i) {
       for (unsigned j = 0; j < ARRAY_SIZE(st->pbo.download_fs[0]); ++j) {
          for (unsigned k = 0; k < ARRAY_SIZE(st->pbo.download_fs[0][0]); k++) {
@@ -104,6 +104,15 @@ st_pbo_get_upload_fs(struct st_context *st,
                      enum pipe_format dst_format,
                      bool need_layer);
 
+enum pipe_format
+st_pbo_get_unpack_view_format(enum pipe_format format);
+
+void *
+st_pbo_get_upload_unpack_fs(struct st_context *st,
+                            enum pipe_format packed_format,
+                            enum pipe_format dst_format,
+                            bool need_layer);
+
 void *
 st_pbo_get_download_fs(struct st_context *st, enum pipe_texture_target target,
                        enum pipe_format src_format,
@@ -471,6 +471,20 @@ release_textures:
    return bc3_tex;
 }
 
+/* Copies a transcoded 2D texture into a level and layer of the destination,
+ * whose blocks must match the texels of the source.
+ */
+static void
+copy_to_image(struct st_context *st,
+              struct pipe_resource *dst, unsigned dst_level,
+              unsigned dst_layer, struct pipe_resource *src)
+{
+   struct pipe_box src_box;
+   u_box_origin_2d(src->width0, src->height0, &src_box);
+   st->pipe->resource_copy_region(st->pipe, dst, dst_level,
+                                  0, 0, dst_layer, src, 0, &src_box);
+}
+
 static struct pipe_resource *
 sw_decode_astc(struct st_context *st,
                uint8_t *astc_data,
@@ -837,10 +851,7 @@ st_compute_transcode_astc_to_dxt5(struct st_context *st,
       goto release_textures;
 
    /* Upload the result. */
-   struct pipe_box src_box;
-   u_box_origin_2d(bc3_tex->width0, bc3_tex->height0, &src_box);
-   st->pipe->resource_copy_region(st->pipe, dxt5_tex, dxt5_level,
-                                  0, 0, dxt5_layer, bc3_tex, 0, &src_box);
+   copy_to_image(st, dxt5_tex, dxt5_level, dxt5_layer, bc3_tex);
 
    success = true;
 
@@ -850,3 +861,86 @@ release_textures:
 
    return success;
 }
+
+/* See st_texcompress_compute.h for more information. */
+bool
+st_compute_decode_astc(struct st_context *st,
+                       uint8_t *astc_data,
+                       unsigned astc_stride,
+                       mesa_format astc_format,
+                       struct pipe_resource *rgba8_tex,
+                       unsigned rgba8_level,
+                       unsigned rgba8_layer)
+{
+   assert(_mesa_has_compute_shaders(st->ctx));
+   assert(_mesa_is_format_astc_2d(astc_format));
+   assert(rgba8_tex->format == PIPE_FORMAT_R8G8B8A8_UNORM ||
+          rgba8_tex->format == PIPE_FORMAT_R8G8B8A8_SRGB);
+   assert(rgba8_level <= rgba8_tex->last_level);
+   assert(rgba8_layer <= util_max_layer(rgba8_tex, rgba8_level));
+
+   struct pipe_resource *decoded_tex =
+      cs_decode_astc(st, astc_data, astc_stride, astc_format,
+                     u_minify(rgba8_tex->width0, rgba8_level),
+                     u_minify(rgba8_tex->height0, rgba8_level));
+   if (!decoded_tex)
+      return false;
+
+   st->pipe->memory_barrier(st->pipe, PIPE_BARRIER_TEXTURE);
+
+   copy_to_image(st, rgba8_tex, rgba8_level, rgba8_layer, decoded_tex);
+
+   pipe_resource_reference(&decoded_tex, NULL);
+
+   return true;
+}
+
+/* See st_texcompress_compute.h for more information. */
+bool
+st_compute_encode_dxt(struct st_context *st,
+                      uint8_t *rgba8_data,
+                      unsigned rgba8_stride,
+                      struct pipe_resource *dxt_tex,
+                      unsigned dxt_level,
+                      unsigned dxt_layer)
+{
+   assert(_mesa_has_compute_shaders(st->ctx));
+   assert(dxt_level <= dxt_tex->last_level);
+   assert(dxt_layer <= util_max_layer(dxt_tex, dxt_level));
+
+   const bool is_dxt5 = dxt_tex->format == PIPE_FORMAT_DXT5_RGBA ||
+                        dxt_tex->format == PIPE_FORMAT_DXT5_SRGBA;
+   assert(is_dxt5 ||
+          dxt_tex->format == PIPE_FORMAT_DXT1_RGB ||
+          dxt_tex->format == PIPE_FORMAT_DXT1_SRGB);
+
+   /* Upload the RGBA8 data. */
+   const unsigned width = u_minify(dxt_tex->width0, dxt_level);
+   const unsigned height = u_minify(dxt_tex->height0, dxt_level);
+   struct pipe_resource *rgba8_tex =
+      st_texture_create(st, PIPE_TEXTURE_2D, PIPE_FORMAT_R8G8B8A8_UNORM, 0,
+                        width, height, 1, 1, 0, 0,
+                        PIPE_BIND_SAMPLER_VIEW, false,
+                        PIPE_COMPRESSION_FIXED_RATE_NONE);
+   if (!rgba8_tex)
+      return false;
+
+   struct pipe_box box;
+   u_box_origin_2d(width, height, &box);
+   st->pipe->texture_subdata(st->pipe, rgba8_tex, 0, 0, &box,
+                             rgba8_data, rgba8_stride, 0);
+
+   /* Encode RGBA8 to BC1 or BC3, the alpha channel of BC1 is ignored. */
+   struct pipe_resource *bc_tex = is_dxt5 ? cs_encode_bc3(st, rgba8_tex) :
+                                            cs_encode_bc1(st, rgba8_tex);
+   pipe_resource_reference(&rgba8_tex, NULL);
+   if (!bc_tex)
+      return false;
+
+   /* Upload the result. */
+   copy_to_image(st, dxt_tex, dxt_level, dxt_layer, bc_tex);
+
+   pipe_resource_reference(&bc_tex, NULL);
+
+   return true;
+}
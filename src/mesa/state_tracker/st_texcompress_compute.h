@@ -48,4 +48,32 @@ st_compute_transcode_astc_to_dxt5(struct st_context *st,
                                   unsigned dxt5_level,
                                   unsigned dxt5_layer);
 
+/**
+ * When this function returns true, the destination image will contain the
+ * contents of astc_data decoded to RGBA8, for drivers that fall back to an
+ * uncompressed format rather than transcoding.
+ */
+bool
+st_compute_decode_astc(struct st_context *st,
+                       uint8_t *astc_data,
+                       unsigned astc_stride,
+                       mesa_format astc_format,
+                       struct pipe_resource *rgba8_tex,
+                       unsigned rgba8_level,
+                       unsigned rgba8_layer);
+
+/**
+ * When this function returns true, the destination image will contain the
+ * RGBA8 data encoded to DXT1/BC1 or DXT5/BC3, depending on the format of
+ * dxt_tex.  This is used for the ETC to DXT transcode, which would otherwise
+ * compress on the CPU.
+ */
+bool
+st_compute_encode_dxt(struct st_context *st,
+                      uint8_t *rgba8_data,
+                      unsigned rgba8_stride,
+                      struct pipe_resource *dxt_tex,
+                      unsigned dxt_level,
+                      unsigned dxt_layer);
+
 #endif /* ST_TEXCOMPRESS_COMPUTE_H */
@@ -33,9 +33,14 @@
 #include "main/macros.h"
 #include "main/sse_minmax.h"
 #include "util/hash_table.h"
+#include "util/range_minimum_query.h"
+#include "util/ralloc.h"
 #include "util/u_memory.h"
 #include "pipe/p_state.h"
 
+/* Number of indices summarized by one entry of the min/max tree */
+#define MINMAX_TREE_BLOCK_SIZE 256
+
 struct minmax_cache_key {
    GLintptr offset;
    GLuint count;
@@ -50,6 +55,29 @@ struct minmax_cache_entry {
 };
 
 
+/**
+ * Per-block min/max of a whole index buffer, with range minimum query
+ * tables on top so that the bounds of any run of whole blocks are O(1).
+ * Draws that use many different ranges of the same static index buffer
+ * then only need to scan the partial blocks at both ends of their range.
+ *
+ * The maximum is tracked as the minimum of the inverted indices.
+ */
+struct vbo_minmax_tree {
+   GLsizeiptr size;
+   unsigned index_size;
+   bool primitive_restart;
+   unsigned restart_index;
+
+   unsigned num_blocks;
+   /* Blocks that need to be rescanned */
+   unsigned dirty_start, dirty_end;
+
+   struct range_minimum_query_table min;
+   struct range_minimum_query_table inv_max;
+};
+
+
 static uint32_t
 vbo_minmax_cache_hash(const struct minmax_cache_key *key)
 {
@@ -98,6 +126,8 @@ vbo_delete_minmax_cache(struct gl_buffer_object *bufferObj)
 {
    _mesa_hash_table_destroy(bufferObj->MinMaxCache, vbo_minmax_cache_delete_entry);
    bufferObj->MinMaxCache = NULL;
+   ralloc_free(bufferObj->MinMaxTree);
+   bufferObj->MinMaxTree = NULL;
 }
 
 
@@ -313,6 +343,197 @@ vbo_get_minmax_index_mapped(unsigned count, unsigned index_size,
 }
 
 
+static struct vbo_minmax_tree *
+vbo_minmax_tree_create(struct gl_buffer_object *bufferObj,
+                       unsigned index_size, bool primitive_restart,
+                       unsigned restart_index)
+{
+   ralloc_free(bufferObj->MinMaxTree);
+
+   struct vbo_minmax_tree *tree = rzalloc(NULL, struct vbo_minmax_tree);
+   bufferObj->MinMaxTree = tree;
+   if (!tree)
+      return NULL;
+
+   tree->size = bufferObj->Size;
+   tree->index_size = index_size;
+   tree->primitive_restart = primitive_restart;
+   tree->restart_index = restart_index;
+   tree->num_blocks = bufferObj->Size / index_size / MINMAX_TREE_BLOCK_SIZE;
+   tree->dirty_start = 0;
+   tree->dirty_end = tree->num_blocks;
+
+   range_minimum_query_table_init(&tree->min);
+   range_minimum_query_table_init(&tree->inv_max);
+   range_minimum_query_table_resize(&tree->min, tree, tree->num_blocks);
+   range_minimum_query_table_resize(&tree->inv_max, tree, tree->num_blocks);
+
+   /* The whole buffer gets scanned now. */
+   bufferObj->MinMaxDirtyStart = 0;
+   bufferObj->MinMaxDirtyEnd = 0;
+
+   return tree;
+}
+
+
+/**
+ * Rescan the blocks written since the last update and redo the range
+ * minimum query tables.
+ */
+static bool
+vbo_minmax_tree_update(struct gl_context *ctx,
+                       struct gl_buffer_object *bufferObj,
+                       struct vbo_minmax_tree *tree)
+{
+   const unsigned block_bytes = MINMAX_TREE_BLOCK_SIZE * tree->index_size;
+
+   if (bufferObj->MinMaxDirtyStart < bufferObj->MinMaxDirtyEnd) {
+      unsigned start = bufferObj->MinMaxDirtyStart / block_bytes;
+      unsigned end = MIN2(DIV_ROUND_UP(bufferObj->MinMaxDirtyEnd, block_bytes),
+                          tree->num_blocks);
+
+      if (tree->dirty_start < tree->dirty_end) {
+         start = MIN2(start, tree->dirty_start);
+         end = MAX2(end, tree->dirty_end);
+      }
+      tree->dirty_start = start;
+      tree->dirty_end = end;
+
+      bufferObj->MinMaxDirtyStart = 0;
+      bufferObj->MinMaxDirtyEnd = 0;
+   }
+
+   if (tree->dirty_start >= tree->dirty_end)
+      return true;
+
+   const char *indices =
+      _mesa_bufferobj_map_range(ctx, (GLintptr)tree->dirty_start * block_bytes,
+                                (GLsizeiptr)(tree->dirty_end - tree->dirty_start) *
+                                block_bytes,
+                                GL_MAP_READ_BIT, bufferObj, MAP_INTERNAL);
+   if (!indices)
+      return false;
+
+   for (unsigned i = tree->dirty_start; i < tree->dirty_end; i++) {
+      unsigned min, max;
+      vbo_get_minmax_index_mapped(MINMAX_TREE_BLOCK_SIZE, tree->index_size,
+                                  tree->restart_index, tree->primitive_restart,
+                                  indices, &min, &max);
+      tree->min.table[i] = min;
+      tree->inv_max.table[i] = ~max;
+      indices += block_bytes;
+   }
+
+   _mesa_bufferobj_unmap(ctx, bufferObj, MAP_INTERNAL);
+
+   range_minimum_query_table_preprocess(&tree->min);
+   range_minimum_query_table_preprocess(&tree->inv_max);
+   tree->dirty_start = 0;
+   tree->dirty_end = 0;
+
+   return true;
+}
+
+
+static bool
+vbo_minmax_scan_range(struct gl_context *ctx,
+                      struct gl_buffer_object *bufferObj,
+                      const struct vbo_minmax_tree *tree,
+                      GLintptr start, unsigned count,
+                      GLuint *min_index, GLuint *max_index)
+{
+   if (!count)
+      return true;
+
+   const void *indices =
+      _mesa_bufferobj_map_range(ctx, start * tree->index_size,
+                                (GLsizeiptr)count * tree->index_size,
+                                GL_MAP_READ_BIT, bufferObj, MAP_INTERNAL);
+   if (!indices)
+      return false;
+
+   unsigned min, max;
+   vbo_get_minmax_index_mapped(count, tree->index_size, tree->restart_index,
+                               tree->primitive_restart, indices, &min, &max);
+   _mesa_bufferobj_unmap(ctx, bufferObj, MAP_INTERNAL);
+
+   *min_index = MIN2(*min_index, min);
+   *max_index = MAX2(*max_index, max);
+   return true;
+}
+
+
+/**
+ * Look the bounds of a range of indices up in the min/max tree of the
+ * buffer, building it if it looks like it will pay off.
+ */
+static bool
+vbo_get_minmax_tree(struct gl_context *ctx, struct gl_buffer_object *bufferObj,
+                    GLintptr offset, unsigned count, unsigned index_size,
+                    bool primitive_restart, unsigned restart_index,
+                    GLuint *min_index, GLuint *max_index)
+{
+   if (offset % index_size || !vbo_use_minmax_cache(bufferObj))
+      return false;
+
+   const GLintptr start = offset / index_size;
+   if ((start + count) * index_size > bufferObj->Size)
+      return false;
+
+   /* The range has to cover at least one whole block. */
+   const unsigned first_block = DIV_ROUND_UP(start, MINMAX_TREE_BLOCK_SIZE);
+   const unsigned end_block = (start + count) / MINMAX_TREE_BLOCK_SIZE;
+   if (first_block >= end_block)
+      return false;
+
+   if (!primitive_restart)
+      restart_index = 0;
+
+   bool found = false;
+   simple_mtx_lock(&bufferObj->MinMaxCacheMutex);
+
+   struct vbo_minmax_tree *tree = bufferObj->MinMaxTree;
+   if (!tree || tree->size != bufferObj->Size ||
+       tree->index_size != index_size ||
+       tree->primitive_restart != primitive_restart ||
+       tree->restart_index != restart_index) {
+      /* Building the tree scans the whole buffer, only do it once the
+       * cache misses have scanned as much.
+       */
+      if (bufferObj->MinMaxCacheMissIndices < bufferObj->Size / index_size)
+         goto out;
+
+      tree = vbo_minmax_tree_create(bufferObj, index_size, primitive_restart,
+                                    restart_index);
+      if (!tree)
+         goto out;
+   }
+
+   if (!vbo_minmax_tree_update(ctx, bufferObj, tree))
+      goto out;
+
+   GLuint min = range_minimum_query(&tree->min, first_block, end_block);
+   GLuint max = ~range_minimum_query(&tree->inv_max, first_block, end_block);
+
+   /* Scan the partial blocks at both ends. */
+   const GLintptr head_end = (GLintptr)first_block * MINMAX_TREE_BLOCK_SIZE;
+   const GLintptr tail_start = (GLintptr)end_block * MINMAX_TREE_BLOCK_SIZE;
+   if (!vbo_minmax_scan_range(ctx, bufferObj, tree, start, head_end - start,
+                              &min, &max) ||
+       !vbo_minmax_scan_range(ctx, bufferObj, tree, tail_start,
+                              start + count - tail_start, &min, &max))
+      goto out;
+
+   *min_index = min;
+   *max_index = max;
+   found = true;
+
+out:
+   simple_mtx_unlock(&bufferObj->MinMaxCacheMutex);
+   return found;
+}
+
+
 /**
  * Compute min and max elements by scanning the index buffer for
  * glDraw[Range]Elements() calls.
@@ -337,6 +558,14 @@ vbo_get_minmax_index(struct gl_context *ctx, struct gl_buffer_object *obj,
                                 max_index))
          return;
 
+      if (vbo_get_minmax_tree(ctx, obj, offset, count, index_size,
+                              primitive_restart, restart_index,
+                              min_index, max_index)) {
+         vbo_minmax_cache_store(ctx, obj, index_size, offset, count,
+                                *min_index, *max_index);
+         return;
+      }
+
       indices = _mesa_bufferobj_map_range(ctx, offset, size, GL_MAP_READ_BIT,
                                           obj, MAP_INTERNAL);
    }
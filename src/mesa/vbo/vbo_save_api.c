@@ -447,16 +447,15 @@ static bool _compare_vertex_key(const void *key1, const void *key2)
                  k1->vertex_size * sizeof(float)) == 0;
 }
 
-static void _free_entry(struct hash_entry *entry)
-{
-   free((void*)entry->key);
-}
-
 /* Add vertex to the vertex buffer and return its index. If this vertex is a duplicate
  * of an existing vertex, return the original index instead.
+ *
+ * 'keys' has room for one key per vertex of the list, the key of the n-th
+ * unique vertex is keys[n].
  */
 static uint32_t
 add_vertex(struct vbo_save_context *save, struct hash_table *hash_to_index,
+           struct vertex_key *keys,
            uint32_t index, fi_type *new_buffer, uint32_t *max_index)
 {
    /* If vertex deduplication is disabled return the original index. */
@@ -465,13 +464,15 @@ add_vertex(struct vbo_save_context *save, struct hash_table *hash_to_index,
 
    fi_type *vert = save->vertex_store->buffer_in_ram + save->vertex_size * index;
 
-   struct vertex_key *key = malloc(sizeof(struct vertex_key));
-   key->vertex_size = save->vertex_size;
-   key->vertex_attributes = vert;
+   struct vertex_key key = {
+      .vertex_size = save->vertex_size,
+      .vertex_attributes = vert,
+   };
+   uint32_t hash = _hash_vertex_key(&key);
 
-   struct hash_entry *entry = _mesa_hash_table_search(hash_to_index, key);
+   struct hash_entry *entry =
+      _mesa_hash_table_search_pre_hashed(hash_to_index, hash, &key);
    if (entry) {
-      free(key);
       /* We found an existing vertex with the same hash, return its index. */
       return (uintptr_t) entry->data;
    } else {
@@ -486,7 +487,9 @@ add_vertex(struct vbo_save_context *save, struct hash_table *hash_to_index,
              vert,
              save->vertex_size * sizeof(fi_type));
 
-      _mesa_hash_table_insert(hash_to_index, key, (void*)(uintptr_t)(n));
+      keys[n] = key;
+      _mesa_hash_table_insert_pre_hashed(hash_to_index, hash, &keys[n],
+                                         (void*)(uintptr_t)(n));
 
       /* The index buffer is shared between list compilations, so add the base index to get
        * the final index.
@@ -607,14 +610,21 @@ compile_vertex_list(struct gl_context *ctx)
 
    int idx = 0;
    struct hash_table *vertex_to_index = NULL;
+   struct vertex_key *vertex_keys = NULL;
    fi_type *temp_vertices_buffer = NULL;
 
+   /* Merging only ever removes primitives. */
+   merged_prims = malloc(node->cold->prim_count * sizeof(struct _mesa_prim));
+
    /* The loopback replay code doesn't use the index buffer, so we can't
     * dedup vertices in this case.
     */
    if (!ctx->ListState.Current.UseLoopback) {
       vertex_to_index = _mesa_hash_table_create(NULL, _hash_vertex_key, _compare_vertex_key);
       temp_vertices_buffer = malloc(save->vertex_store->buffer_in_ram_size);
+      vertex_keys = malloc(get_vertex_count(save) * sizeof(struct vertex_key));
+      /* Avoid rehashing while a large list is being deduplicated. */
+      _mesa_hash_table_reserve(vertex_to_index, get_vertex_count(save));
    }
 
    uint32_t max_index = 0;
@@ -681,7 +691,7 @@ compile_vertex_list(struct gl_context *ctx)
          unsigned tri_count = merged_prims[last_valid_prim].count - 2;
 
          indices[idx] = indices[idx - 1];
-         indices[idx + 1] = add_vertex(save, vertex_to_index,
+         indices[idx + 1] = add_vertex(save, vertex_to_index, vertex_keys,
                                        converted_prim ? CAST_INDEX(tmp_indices, index_size, 0) : original_prims[i].start,
                                        temp_vertices_buffer, &max_index);
          idx += 2;
@@ -689,7 +699,7 @@ compile_vertex_list(struct gl_context *ctx)
 
          if (tri_count % 2) {
             /* Add another index to preserve winding order */
-            indices[idx++] = add_vertex(save, vertex_to_index,
+            indices[idx++] = add_vertex(save, vertex_to_index, vertex_keys,
                                         converted_prim ? CAST_INDEX(tmp_indices, index_size, 0) : original_prims[i].start,
                                         temp_vertices_buffer, &max_index);
             merged_prims[last_valid_prim].count++;
@@ -708,12 +718,12 @@ compile_vertex_list(struct gl_context *ctx)
             (original_prims[i + 1].mode == GL_LINE_STRIP ||
              original_prims[i + 1].mode == GL_LINES)))) {
          for (unsigned j = 0; j < vertex_count; j++) {
-            indices[idx++] = add_vertex(save, vertex_to_index,
+            indices[idx++] = add_vertex(save, vertex_to_index, vertex_keys,
                                         converted_prim ? CAST_INDEX(tmp_indices, index_size, j) : original_prims[i].start + j,
                                         temp_vertices_buffer, &max_index);
             /* Repeat all but the first/last indices. */
             if (j && j != vertex_count - 1) {
-               indices[idx++] = add_vertex(save, vertex_to_index,
+               indices[idx++] = add_vertex(save, vertex_to_index, vertex_keys,
                                            converted_prim ? CAST_INDEX(tmp_indices, index_size, j) : original_prims[i].start + j,
                                            temp_vertices_buffer, &max_index);
             }
@@ -724,7 +734,7 @@ compile_vertex_list(struct gl_context *ctx)
             mode = original_prims[i].mode;
 
          for (unsigned j = 0; j < vertex_count; j++) {
-            indices[idx++] = add_vertex(save, vertex_to_index,
+            indices[idx++] = add_vertex(save, vertex_to_index, vertex_keys,
                                         converted_prim ? CAST_INDEX(tmp_indices, index_size, j) : original_prims[i].start + j,
                                         temp_vertices_buffer, &max_index);
          }
@@ -734,7 +744,7 @@ compile_vertex_list(struct gl_context *ctx)
       if (vertex_count > 0) {
          unsigned min_vert = u_prim_vertex_count(mode)->min;
          for (unsigned j = vertex_count; j < min_vert; j++) {
-            indices[idx++] = add_vertex(save, vertex_to_index,
+            indices[idx++] = add_vertex(save, vertex_to_index, vertex_keys,
                                        converted_prim ? CAST_INDEX(tmp_indices, index_size, vertex_count - 1) :
                                                          original_prims[i].start + vertex_count - 1,
                                        temp_vertices_buffer, &max_index);
@@ -749,7 +759,6 @@ compile_vertex_list(struct gl_context *ctx)
          /* Keep this primitive */
          last_valid_prim += 1;
          assert(last_valid_prim <= i);
-         merged_prims = realloc(merged_prims, (1 + last_valid_prim) * sizeof(struct _mesa_prim));
          merged_prims[last_valid_prim] = original_prims[i];
          merged_prims[last_valid_prim].start = start;
          merged_prims[last_valid_prim].count = idx - start;
@@ -854,7 +863,8 @@ compile_vertex_list(struct gl_context *ctx)
    ctx->ListState.Current.NeedsFlush = true;
 
   if (vertex_to_index) {
-      _mesa_hash_table_destroy(vertex_to_index, _free_entry);
+      _mesa_hash_table_destroy(vertex_to_index, NULL);
+      free(vertex_keys);
       free(temp_vertices_buffer);
    }
 
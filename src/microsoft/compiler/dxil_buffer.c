@@ -22,7 +22,9 @@
  */
 
 #include "dxil_buffer.h"
+#include "util/macros.h"
 #include <assert.h>
+#include <string.h>
 
 void
 dxil_buffer_init(struct dxil_buffer *b, unsigned abbrev_width)
@@ -46,8 +48,17 @@ flush_dword(struct dxil_buffer *b)
    assert(b->buf_bits >= 32 && b->buf_bits < 64);
 
    uint32_t lower_bits = b->buf & UINT32_MAX;
-   if (!blob_write_bytes(&b->blob, &lower_bits, sizeof(lower_bits)))
+
+   /* This runs for every dword of the module, so skip the blob helpers
+    * while there's room left.
+    */
+   if (likely(b->blob.size + sizeof(lower_bits) <= b->blob.allocated &&
+              !b->blob.out_of_memory)) {
+      memcpy(b->blob.data + b->blob.size, &lower_bits, sizeof(lower_bits));
+      b->blob.size += sizeof(lower_bits);
+   } else if (!blob_write_bytes(&b->blob, &lower_bits, sizeof(lower_bits))) {
       return false;
+   }
 
    b->buf >>= 32;
    b->buf_bits -= 32;
@@ -3,7 +3,11 @@
 #include <windows.h>
 #include <unknwn.h>
 
+#include "util/disk_cache.h"
+#include "util/hash_table.h"
+#include "util/mesa-sha1.h"
 #include "util/ralloc.h"
+#include "util/simple_mtx.h"
 #include "util/u_debug.h"
 #include "util/compiler.h"
 
@@ -21,8 +25,38 @@ struct dxil_validator {
    IDxcCompiler *dxc_compiler;
 
    enum dxil_validator_version version;
+
+   /* Digests the validator signed modules with, keyed by the hash of the
+    * unsigned module, so validating the same module again is skipped.
+    */
+   simple_mtx_t validated_lock;
+   struct hash_table *validated;
+   struct disk_cache *disk_cache;
+};
+
+/* Validation signs the container in place by filling in its digest, which
+ * follows the DXBC magic.
+ */
+#define DXIL_DIGEST_OFFSET 4
+#define DXIL_DIGEST_SIZE 16
+
+struct dxil_validated_module {
+   cache_key key;
+   uint8_t digest[DXIL_DIGEST_SIZE];
 };
 
+static uint32_t
+hash_cache_key(const void *key)
+{
+   return _mesa_hash_data(key, sizeof(cache_key));
+}
+
+static bool
+equals_cache_key(const void *a, const void *b)
+{
+   return memcmp(a, b, sizeof(cache_key)) == 0;
+}
+
 extern "C" {
 extern IMAGE_DOS_HEADER __ImageBase;
 }
@@ -195,6 +229,14 @@ dxil_create_validator(const void *ctx)
       val->dxil_mod,
       get_validator_version(val->dxc_validator));
 
+   simple_mtx_init(&val->validated_lock, mtx_plain);
+   val->validated = _mesa_hash_table_create(val, hash_cache_key,
+                                            equals_cache_key);
+
+   char validator_id[16];
+   snprintf(validator_id, sizeof(validator_id), "%x", val->version);
+   val->disk_cache = disk_cache_create("dxil_validator", validator_id, 0);
+
    /* Try to load dxcompiler.dll. This is just used for diagnostics, and
     * will fail on most end-users install. So we do not error out if this
     * fails.
@@ -244,6 +286,9 @@ dxil_destroy_validator(struct dxil_validator *val)
    val->dxc_validator->Release();
    FreeLibrary(val->dxil_mod);
 
+   disk_cache_destroy(val->disk_cache);
+   simple_mtx_destroy(&val->validated_lock);
+
    if (val->dxcompiler_mod) {
       if (val->dxc_library)
          val->dxc_library->Release();
@@ -299,12 +344,83 @@ public:
    size_t m_size;
 };
 
+/* Signs the module with the digest of an earlier validation of the same
+ * module, in this process or a previous one.
+ */
+static bool
+sign_validated_module(struct dxil_validator *val, const cache_key key,
+                      void *data)
+{
+   simple_mtx_lock(&val->validated_lock);
+   struct hash_entry *entry = _mesa_hash_table_search(val->validated, key);
+   if (entry) {
+      struct dxil_validated_module *module =
+         (struct dxil_validated_module *)entry->data;
+      memcpy((uint8_t *)data + DXIL_DIGEST_OFFSET, module->digest,
+             DXIL_DIGEST_SIZE);
+   }
+   simple_mtx_unlock(&val->validated_lock);
+
+   if (entry || !val->disk_cache)
+      return entry != NULL;
+
+   size_t size;
+   void *digest = disk_cache_get(val->disk_cache, key, &size);
+   bool found = digest && size == DXIL_DIGEST_SIZE;
+   if (found) {
+      memcpy((uint8_t *)data + DXIL_DIGEST_OFFSET, digest, DXIL_DIGEST_SIZE);
+
+      struct dxil_validated_module *module =
+         ralloc(val, struct dxil_validated_module);
+      memcpy(module->key, key, sizeof(cache_key));
+      memcpy(module->digest, digest, DXIL_DIGEST_SIZE);
+
+      simple_mtx_lock(&val->validated_lock);
+      _mesa_hash_table_insert(val->validated, module->key, module);
+      simple_mtx_unlock(&val->validated_lock);
+   }
+   free(digest);
+
+   return found;
+}
+
+static void
+record_validated_module(struct dxil_validator *val, const cache_key key,
+                        const void *data)
+{
+   struct dxil_validated_module *module =
+      ralloc(val, struct dxil_validated_module);
+   memcpy(module->key, key, sizeof(cache_key));
+   memcpy(module->digest, (const uint8_t *)data + DXIL_DIGEST_OFFSET,
+          DXIL_DIGEST_SIZE);
+
+   simple_mtx_lock(&val->validated_lock);
+   _mesa_hash_table_insert(val->validated, module->key, module);
+   simple_mtx_unlock(&val->validated_lock);
+
+   if (val->disk_cache)
+      disk_cache_put(val->disk_cache, key, module->digest, DXIL_DIGEST_SIZE,
+                     NULL);
+}
+
 bool
 dxil_validate_module(struct dxil_validator *val, void *data, size_t size, char **error)
 {
    if (!val)
       return false;
 
+   cache_key key;
+   void *unsigned_data = NULL;
+   if (size >= DXIL_DIGEST_OFFSET + DXIL_DIGEST_SIZE) {
+      _mesa_sha1_compute(data, size, key);
+      if (sign_validated_module(val, key, data))
+         return true;
+
+      unsigned_data = malloc(size);
+      if (unsigned_data)
+         memcpy(unsigned_data, data, size);
+   }
+
    ShaderBlob source(data, size);
 
    ComPtr<IDxcOperationResult> result;
@@ -314,6 +430,15 @@ dxil_validate_module(struct dxil_validator *val, void *data, size_t size, char *
    HRESULT hr;
    result->GetStatus(&hr);
 
+   /* Only remember the result if signing is all the validator changed. */
+   if (SUCCEEDED(hr) && unsigned_data &&
+       memcmp(unsigned_data, data, DXIL_DIGEST_OFFSET) == 0 &&
+       memcmp((uint8_t *)unsigned_data + DXIL_DIGEST_OFFSET + DXIL_DIGEST_SIZE,
+              (uint8_t *)data + DXIL_DIGEST_OFFSET + DXIL_DIGEST_SIZE,
+              size - DXIL_DIGEST_OFFSET - DXIL_DIGEST_SIZE) == 0)
+      record_validated_module(val, key, data);
+   free(unsigned_data);
+
    if (FAILED(hr) && error) {
       /* try to resolve error message */
       *error = NULL;
@@ -230,7 +230,7 @@ struct nak_shader_bin {
 void nak_shader_bin_destroy(struct nak_shader_bin *bin);
 
 struct nak_shader_bin *
-nak_compile_shader(nir_shader *nir, bool dump_asm,
+nak_compile_shader(nir_shader *nir, bool dump_asm, bool fast_compile,
                    const struct nak_compiler *nak,
                    nir_variable_mode robust2_modes,
                    const struct nak_fs_key *fs_key);
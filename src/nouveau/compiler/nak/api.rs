@@ -17,6 +17,7 @@ use std::fmt::Write;
 use std::os::raw::c_void;
 use std::panic;
 use std::sync::OnceLock;
+use std::time::Instant;
 
 #[repr(u8)]
 enum DebugFlags {
@@ -27,6 +28,7 @@ enum DebugFlags {
     Annotate,
     NoUgpr,
     Cycles,
+    Time,
 }
 
 pub struct Debug {
@@ -53,6 +55,7 @@ impl Debug {
                 "annotate" => flags |= 1 << DebugFlags::Annotate as u8,
                 "nougpr" => flags |= 1 << DebugFlags::NoUgpr as u8,
                 "cycles" => flags |= 1 << DebugFlags::Cycles as u8,
+                "time" => flags |= 1 << DebugFlags::Time as u8,
                 unk => eprintln!("Unknown NAK_DEBUG flag \"{}\"", unk),
             }
         }
@@ -90,6 +93,10 @@ pub trait GetDebugFlags {
     fn cycles(&self) -> bool {
         self.debug_flags() & (1 << DebugFlags::Cycles as u8) != 0
     }
+
+    fn time(&self) -> bool {
+        self.debug_flags() & (1 << DebugFlags::Time as u8) != 0
+    }
 }
 
 pub static DEBUG: OnceLock<Debug> = OnceLock::new();
@@ -403,7 +410,19 @@ fn eprint_hex(label: &str, data: &[u32]) {
 
 macro_rules! pass {
     ($s: expr, $pass: ident) => {
+        let start = if DEBUG.time() {
+            Some(Instant::now())
+        } else {
+            None
+        };
         $s.$pass();
+        if let Some(start) = start {
+            eprintln!(
+                "NAK pass {}: {} us",
+                stringify!($pass),
+                start.elapsed().as_micros()
+            );
+        }
         if DEBUG.print() {
             eprintln!("NAK IR after {}:\n{}", stringify!($pass), $s);
         }
@@ -413,6 +432,7 @@ macro_rules! pass {
 fn nak_compile_shader_internal(
     nir: *mut nir_shader,
     dump_asm: bool,
+    fast_compile: bool,
     nak: *const nak_compiler,
     robust2_modes: nir_variable_mode,
     fs_key: *const nak_fs_key,
@@ -443,7 +463,12 @@ fn nak_compile_shader_internal(
     pass!(s, opt_out);
     pass!(s, legalize);
     pass!(s, opt_dce);
-    pass!(s, opt_instr_sched_prepass);
+    // Scheduling is only there for performance and is a good chunk of the
+    // compile time for large shaders, skip it when the app asked for a fast
+    // compile rather than a fast shader.
+    if !fast_compile {
+        pass!(s, opt_instr_sched_prepass);
+    }
     pass!(s, assign_regs);
     pass!(s, lower_par_copies);
     pass!(s, lower_copy_swap);
@@ -455,7 +480,9 @@ fn nak_compile_shader_internal(
 
     s.remove_annotations();
 
-    pass!(s, opt_instr_sched_postpass);
+    if !fast_compile {
+        pass!(s, opt_instr_sched_postpass);
+    }
     pass!(s, calc_instr_deps);
 
     s.gather_info();
@@ -474,12 +501,29 @@ fn nak_compile_shader_internal(
 pub extern "C" fn nak_compile_shader(
     nir: *mut nir_shader,
     dump_asm: bool,
+    fast_compile: bool,
     nak: *const nak_compiler,
     robust2_modes: nir_variable_mode,
     fs_key: *const nak_fs_key,
 ) -> *mut nak_shader_bin {
     let compile = || {
-        nak_compile_shader_internal(nir, dump_asm, nak, robust2_modes, fs_key)
+        let start = Instant::now();
+        let bin = nak_compile_shader_internal(
+            nir,
+            dump_asm,
+            fast_compile,
+            nak,
+            robust2_modes,
+            fs_key,
+        );
+        if DEBUG.time() {
+            eprintln!(
+                "NAK compile{}: {} us",
+                if fast_compile { " (fast)" } else { "" },
+                start.elapsed().as_micros()
+            );
+        }
+        bin
     };
     if DEBUG.panic() {
         compile()
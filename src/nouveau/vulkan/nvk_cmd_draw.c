@@ -4046,10 +4046,25 @@ nvk_mme_build_set_draw_params(struct mme_builder *b,
                            NVK_MME_SCRATCH_CB0_VIEW_INDEX,
                            mme_zero());
 
-   mme_mthd(b, NV9097_SET_GLOBAL_BASE_VERTEX_INDEX);
-   mme_emit(b, p->base_vertex);
-   mme_mthd(b, NV9097_SET_VERTEX_ID_BASE);
-   mme_emit(b, p->base_vertex);
+   /* Both methods are only ever set here, to the same value, so the shadow
+    * of one tells us whether the other is up-to-date too.
+    */
+   if (b->devinfo->cls_eng3d >= TURING_A) {
+      struct mme_value old =
+         mme_state(b, NV9097_SET_GLOBAL_BASE_VERTEX_INDEX);
+      mme_if(b, ine, old, p->base_vertex) {
+         mme_mthd(b, NV9097_SET_GLOBAL_BASE_VERTEX_INDEX);
+         mme_emit(b, p->base_vertex);
+         mme_mthd(b, NV9097_SET_VERTEX_ID_BASE);
+         mme_emit(b, p->base_vertex);
+      }
+      mme_free_reg(b, old);
+   } else {
+      mme_mthd(b, NV9097_SET_GLOBAL_BASE_VERTEX_INDEX);
+      mme_emit(b, p->base_vertex);
+      mme_mthd(b, NV9097_SET_VERTEX_ID_BASE);
+      mme_emit(b, p->base_vertex);
+   }
 }
 
 static void
@@ -50,7 +50,10 @@ nvk_descriptor_table_grow_locked(struct nvk_device *dev,
    }
    table->free_table = new_free_table;
 
-   table->alloc = new_alloc;
+   /* Only publish the new size once the arena has grown so that it's always
+    * safe to map any descriptor below nvk_descriptor_table_alloc_count().
+    */
+   p_atomic_set(&table->alloc, new_alloc);
 
    return VK_SUCCESS;
 }
@@ -98,12 +101,14 @@ nvk_descriptor_table_finish(struct nvk_device *dev,
    vk_free(&dev->vk.alloc, table->free_table);
 }
 
+/* The arena never moves memory which has been published so descriptors can
+ * be written without the lock, as long as the caller owns the index.  This
+ * keeps the critical section down to the allocator bookkeeping.
+ */
 static void *
-nvk_descriptor_table_map_locked(struct nvk_descriptor_table *table,
-                                uint32_t index)
+nvk_descriptor_table_map(struct nvk_descriptor_table *table, uint32_t index)
 {
-   assert(index < table->alloc);
-   assert(BITSET_TEST(table->in_use, index));
+   assert(index < p_atomic_read(&table->alloc));
 
    uint32_t offset_B = index * table->desc_size;
    return nvk_contiguous_mem_arena_map_offset(&table->arena, offset_B,
@@ -111,11 +116,11 @@ nvk_descriptor_table_map_locked(struct nvk_descriptor_table *table,
 }
 
 static void
-nvk_descriptor_table_write_locked(struct nvk_descriptor_table *table,
-                                  uint32_t index,
-                                  const void *desc_data, size_t desc_size)
+nvk_descriptor_table_write(struct nvk_descriptor_table *table,
+                           uint32_t index,
+                           const void *desc_data, size_t desc_size)
 {
-   void *map = nvk_descriptor_table_map_locked(table, index);
+   void *map = nvk_descriptor_table_map(table, index);
 
    assert(desc_size == table->desc_size);
    memcpy(map, desc_data, table->desc_size);
@@ -123,10 +128,10 @@ nvk_descriptor_table_write_locked(struct nvk_descriptor_table *table,
 }
 
 static void
-nvk_descriptor_table_clear_locked(struct nvk_descriptor_table *table,
-                                  uint32_t index)
+nvk_descriptor_table_clear(struct nvk_descriptor_table *table,
+                           uint32_t index)
 {
-   void *map = nvk_descriptor_table_map_locked(table, index);
+   void *map = nvk_descriptor_table_map(table, index);
 
    memset(map, 0, table->desc_size);
    nvk_mem_arena_set_map_dirty(&table->arena);
@@ -190,22 +195,6 @@ nvk_descriptor_table_take_locked(struct nvk_device *dev,
    }
 }
 
-static VkResult
-nvk_descriptor_table_add_locked(struct nvk_device *dev,
-                                struct nvk_descriptor_table *table,
-                                const void *desc_data, size_t desc_size,
-                                uint32_t *index_out)
-{
-   VkResult result = nvk_descriptor_table_alloc_locked(dev, table, index_out);
-   if (result != VK_SUCCESS)
-      return result;
-
-   nvk_descriptor_table_write_locked(table, *index_out, desc_data, desc_size);
-
-   return VK_SUCCESS;
-}
-
-
 VkResult
 nvk_descriptor_table_add(struct nvk_device *dev,
                          struct nvk_descriptor_table *table,
@@ -213,26 +202,14 @@ nvk_descriptor_table_add(struct nvk_device *dev,
                          uint32_t *index_out)
 {
    simple_mtx_lock(&table->arena.mutex);
-   VkResult result = nvk_descriptor_table_add_locked(dev, table, desc_data,
-                                                     desc_size, index_out);
+   VkResult result = nvk_descriptor_table_alloc_locked(dev, table, index_out);
    simple_mtx_unlock(&table->arena.mutex);
-
-   return result;
-}
-
-static VkResult
-nvk_descriptor_table_insert_locked(struct nvk_device *dev,
-                                   struct nvk_descriptor_table *table,
-                                   uint32_t index,
-                                   const void *desc_data, size_t desc_size)
-{
-   VkResult result = nvk_descriptor_table_take_locked(dev, table, index);
    if (result != VK_SUCCESS)
       return result;
 
-   nvk_descriptor_table_write_locked(table, index, desc_data, desc_size);
+   nvk_descriptor_table_write(table, *index_out, desc_data, desc_size);
 
-   return result;
+   return VK_SUCCESS;
 }
 
 VkResult
@@ -242,11 +219,14 @@ nvk_descriptor_table_insert(struct nvk_device *dev,
                             const void *desc_data, size_t desc_size)
 {
    simple_mtx_lock(&table->arena.mutex);
-   VkResult result = nvk_descriptor_table_insert_locked(dev, table, index,
-                                                        desc_data, desc_size);
+   VkResult result = nvk_descriptor_table_take_locked(dev, table, index);
    simple_mtx_unlock(&table->arena.mutex);
+   if (result != VK_SUCCESS)
+      return result;
 
-   return result;
+   nvk_descriptor_table_write(table, index, desc_data, desc_size);
+
+   return VK_SUCCESS;
 }
 
 static int
@@ -284,8 +264,6 @@ nvk_descriptor_table_remove_locked(struct nvk_device *dev,
 {
    assert(BITSET_TEST(table->in_use, index));
 
-   nvk_descriptor_table_clear_locked(table, index);
-
    /* There may be duplicate entries in the free table.  For most operations,
     * this is fine as we always consult nvk_descriptor_table::in_use when
     * allocating.  However, it does mean that there's nothing preventing our
@@ -307,6 +285,11 @@ nvk_descriptor_table_remove(struct nvk_device *dev,
                             struct nvk_descriptor_table *table,
                             uint32_t index)
 {
+   /* Clear before giving the index back, after that it may belong to
+    * someone else.
+    */
+   nvk_descriptor_table_clear(table, index);
+
    simple_mtx_lock(&table->arena.mutex);
    nvk_descriptor_table_remove_locked(dev, table, index);
    simple_mtx_unlock(&table->arena.mutex);
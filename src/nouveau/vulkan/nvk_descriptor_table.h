@@ -15,7 +15,7 @@ struct nvk_descriptor_table {
    struct nvk_mem_arena arena;
 
    uint32_t desc_size; /**< Size of a descriptor */
-   uint32_t alloc; /**< Number of descriptors allocated */
+   uint32_t alloc; /**< Number of descriptors allocated, atomic */
    uint32_t max_alloc; /**< Maximum possible number of descriptors */
    uint32_t next_desc; /**< Next unallocated descriptor */
    uint32_t free_count; /**< Size of free_table */
@@ -68,14 +68,11 @@ nvk_descriptor_table_base_address(struct nvk_descriptor_table *table)
    return nvk_contiguous_mem_arena_base_address(&table->arena);
 }
 
+/* Only ever grows, and only after the arena has, so no lock is needed */
 static inline uint64_t
 nvk_descriptor_table_alloc_count(struct nvk_descriptor_table *table)
 {
-   simple_mtx_lock(&table->arena.mutex);
-   uint32_t alloc = table->alloc;
-   simple_mtx_unlock(&table->arena.mutex);
-
-   return alloc;
+   return p_atomic_read(&table->alloc);
 }
 
 #endif
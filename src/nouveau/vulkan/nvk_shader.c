@@ -486,6 +486,8 @@ nvk_compile_nir(struct nvk_device *dev, nir_shader *nir,
 
    const bool dump_asm =
       shader_flags & VK_SHADER_CREATE_CAPTURE_INTERNAL_REPRESENTATIONS_BIT_MESA;
+   const bool fast_compile =
+      shader_flags & VK_SHADER_CREATE_DISABLE_OPTIMIZATION_BIT_MESA;
 
    nir_variable_mode robust2_modes = 0;
    if (rs->uniform_buffers == VK_PIPELINE_ROBUSTNESS_BUFFER_BEHAVIOR_ROBUST_BUFFER_ACCESS_2_EXT)
@@ -493,7 +495,7 @@ nvk_compile_nir(struct nvk_device *dev, nir_shader *nir,
    if (rs->storage_buffers == VK_PIPELINE_ROBUSTNESS_BUFFER_BEHAVIOR_ROBUST_BUFFER_ACCESS_2_EXT)
       robust2_modes |= nir_var_mem_ssbo;
 
-   shader->nak = nak_compile_shader(nir, dump_asm, pdev->nak,
+   shader->nak = nak_compile_shader(nir, dump_asm, fast_compile, pdev->nak,
                                     robust2_modes, fs_key);
    if (!shader->nak)
       return vk_errorf(pdev, VK_ERROR_UNKNOWN, "Internal compiler error in NAK");
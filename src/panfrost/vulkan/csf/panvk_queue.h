@@ -15,6 +15,7 @@
 #include <stdint.h>
 
 #include "panvk_device.h"
+#include "panvk_utrace.h"
 
 #include "vk_queue.h"
 
@@ -90,6 +91,9 @@ struct panvk_gpu_queue {
       uint64_t next_value;
    } utrace;
 
+   /* Only updated with PANVK_DEBUG=submit_stats */
+   struct panvk_utrace_submit_stats submit_stats;
+
    struct panvk_subqueue subqueues[PANVK_SUBQUEUE_COUNT];
 };
 
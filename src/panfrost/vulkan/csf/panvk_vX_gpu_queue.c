@@ -17,6 +17,7 @@
 #include "panvk_utrace.h"
 
 #include "util/bitscan.h"
+#include "util/os_time.h"
 #include "vk_drm_syncobj.h"
 #include "vk_log.h"
 
@@ -1161,10 +1162,18 @@ panvk_queue_submit_ioctl(struct panvk_queue_submit *submit)
          DRM_PANTHOR_OBJ_ARRAY(submit->qsubmit_count, submit->qsubmits),
    };
 
+   const int64_t submit_start =
+      PANVK_DEBUG(SUBMIT_STATS) ? os_time_get_nano() : 0;
+
    ret = pan_kmod_ioctl(dev->drm_fd, DRM_IOCTL_PANTHOR_GROUP_SUBMIT, &gsubmit);
    if (ret)
       return vk_queue_set_lost(&queue->vk, "GROUP_SUBMIT: %m");
 
+   if (PANVK_DEBUG(SUBMIT_STATS)) {
+      panvk_utrace_record_submit(&queue->submit_stats,
+                                 os_time_get_nano() - submit_start);
+   }
+
    return VK_SUCCESS;
 }
 
@@ -1403,6 +1412,9 @@ panvk_per_arch(destroy_gpu_queue)(struct vk_queue *vk_queue)
    struct panvk_gpu_queue *queue = container_of(vk_queue, struct panvk_gpu_queue, vk);
    struct panvk_device *dev = to_panvk_device(queue->vk.base.device);
 
+   if (PANVK_DEBUG(SUBMIT_STATS))
+      panvk_utrace_dump_submit_stats(&queue->submit_stats, "GROUP_SUBMIT");
+
    cleanup_queue(queue);
    destroy_group(queue);
    cleanup_tiler(queue);
@@ -33,6 +33,7 @@ enum panvk_debug_flags {
    PANVK_DEBUG_NO_WB_MMAP = 1 << 14,
    PANVK_DEBUG_NO_USER_MMAP_SYNC = 1 << 15,
    PANVK_DEBUG_COHERENT_BEFORE_CACHED = 1 << 16,
+   PANVK_DEBUG_SUBMIT_STATS = 1 << 17,
 };
 
 extern uint64_t panvk_debug;
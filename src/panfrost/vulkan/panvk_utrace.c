@@ -9,6 +9,7 @@
 #include "kmod/pan_kmod.h"
 #include "util/log.h"
 #include "util/timespec.h"
+#include "util/u_math.h"
 #include "panvk_device.h"
 #include "panvk_physical_device.h"
 #include "panvk_priv_bo.h"
@@ -121,3 +122,44 @@ panvk_utrace_delete_flush_data(struct u_trace_context *utctx, void *flush_data)
    if (data->free_self)
       free(data);
 }
+
+void
+panvk_utrace_record_submit(struct panvk_utrace_submit_stats *stats,
+                           uint64_t duration_ns)
+{
+   const uint64_t duration_us = duration_ns / 1000;
+   const unsigned bucket =
+      duration_us ? MIN2(util_logbase2_64(duration_us) + 1,
+                         PANVK_SUBMIT_LATENCY_BUCKETS - 1)
+                  : 0;
+
+   stats->count++;
+   stats->total_ns += duration_ns;
+   stats->max_ns = MAX2(stats->max_ns, duration_ns);
+   stats->buckets[bucket]++;
+}
+
+void
+panvk_utrace_dump_submit_stats(const struct panvk_utrace_submit_stats *stats,
+                               const char *name)
+{
+   if (!stats->count)
+      return;
+
+   mesa_logi("%s: %" PRIu64 " submits, avg %" PRIu64 "us, max %" PRIu64 "us",
+             name, stats->count, stats->total_ns / stats->count / 1000,
+             stats->max_ns / 1000);
+
+   for (unsigned i = 0; i < PANVK_SUBMIT_LATENCY_BUCKETS; i++) {
+      if (!stats->buckets[i])
+         continue;
+
+      if (i == PANVK_SUBMIT_LATENCY_BUCKETS - 1) {
+         mesa_logi("  >= %6" PRIu64 "us: %u", UINT64_C(1) << (i - 1),
+                   stats->buckets[i]);
+      } else {
+         mesa_logi("  < %7" PRIu64 "us: %u", UINT64_C(1) << i,
+                   stats->buckets[i]);
+      }
+   }
+}
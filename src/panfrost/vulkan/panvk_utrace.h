@@ -30,6 +30,26 @@ struct panvk_utrace_buf {
    void *host;
 };
 
+#define PANVK_SUBMIT_LATENCY_BUCKETS 16
+
+/* Histogram of the CPU time spent submitting to the kernel, collected with
+ * PANVK_DEBUG=submit_stats. Bucket 0 counts the submits that took less than
+ * 1us, bucket i the ones in [2^(i-1), 2^i) us, and the last bucket
+ * everything above.
+ */
+struct panvk_utrace_submit_stats {
+   uint64_t count;
+   uint64_t total_ns;
+   uint64_t max_ns;
+   uint32_t buckets[PANVK_SUBMIT_LATENCY_BUCKETS];
+};
+
+void panvk_utrace_record_submit(struct panvk_utrace_submit_stats *stats,
+                                uint64_t duration_ns);
+
+void panvk_utrace_dump_submit_stats(
+   const struct panvk_utrace_submit_stats *stats, const char *name);
+
 void *panvk_utrace_create_buffer(struct u_trace_context *utctx,
                                  uint64_t size_B);
 
@@ -633,6 +633,102 @@ disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size)
    return buf;
 }
 
+struct disk_cache_batch_job {
+   struct util_queue_fence fence;
+   struct disk_cache_batch *batch;
+   unsigned start, end;
+};
+
+struct disk_cache_batch {
+   struct disk_cache *cache;
+   disk_cache_get_batch_cb cb;
+   void *data;
+
+   cache_key *keys;
+   unsigned num_jobs;
+   struct disk_cache_batch_job jobs[];
+};
+
+static void
+cache_get_batch(void *job, void *gdata, int thread_index)
+{
+   struct disk_cache_batch_job *bjob = (struct disk_cache_batch_job *) job;
+   struct disk_cache_batch *batch = bjob->batch;
+
+   for (unsigned i = bjob->start; i < bjob->end; i++) {
+      size_t size;
+      void *item = disk_cache_get(batch->cache, batch->keys[i], &size);
+      batch->cb(batch->data, i, item, size);
+   }
+}
+
+struct disk_cache_batch *
+disk_cache_get_batch(struct disk_cache *cache, const cache_key *keys,
+                     unsigned num_keys, disk_cache_get_batch_cb cb,
+                     void *data)
+{
+   if (!num_keys)
+      return NULL;
+
+   /* A few jobs per thread, so that a thread done with cheap lookups can
+    * take over some of the keys of a slow one.
+    */
+   struct disk_cache_batch *batch = NULL;
+   unsigned num_jobs = 0;
+   if (util_queue_is_initialized(&cache->cache_queue)) {
+      num_jobs = MIN2(num_keys, cache->cache_queue.max_threads * 4);
+      batch = malloc(sizeof(*batch) + num_jobs * sizeof(batch->jobs[0]));
+   }
+
+   if (batch)
+      batch->keys = malloc(num_keys * sizeof(cache_key));
+
+   if (!batch || !batch->keys) {
+      /* Do the lookups right away instead. */
+      free(batch);
+      for (unsigned i = 0; i < num_keys; i++) {
+         size_t size;
+         void *item = disk_cache_get(cache, keys[i], &size);
+         cb(data, i, item, size);
+      }
+      return NULL;
+   }
+
+   memcpy(batch->keys, keys, num_keys * sizeof(cache_key));
+   batch->cache = cache;
+   batch->cb = cb;
+   batch->data = data;
+   batch->num_jobs = num_jobs;
+
+   for (unsigned i = 0; i < num_jobs; i++) {
+      struct disk_cache_batch_job *job = &batch->jobs[i];
+
+      job->batch = batch;
+      job->start = (uint64_t)num_keys * i / num_jobs;
+      job->end = (uint64_t)num_keys * (i + 1) / num_jobs;
+      util_queue_fence_init(&job->fence);
+      util_queue_add_job(&cache->cache_queue, job, &job->fence,
+                         cache_get_batch, NULL, 0);
+   }
+
+   return batch;
+}
+
+void
+disk_cache_batch_wait(struct disk_cache_batch *batch)
+{
+   if (!batch)
+      return;
+
+   for (unsigned i = 0; i < batch->num_jobs; i++) {
+      util_queue_fence_wait(&batch->jobs[i].fence);
+      util_queue_fence_destroy(&batch->jobs[i].fence);
+   }
+
+   free(batch->keys);
+   free(batch);
+}
+
 void
 disk_cache_put_key(struct disk_cache *cache, const cache_key key)
 {
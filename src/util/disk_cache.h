@@ -64,6 +64,10 @@ typedef signed long
 (*disk_cache_get_cb) (const void *key, signed long keySize,
                       void *value, signed long valueSize);
 
+typedef void
+(*disk_cache_get_batch_cb) (void *data, unsigned index, void *item,
+                            size_t size);
+
 struct cache_item_metadata {
    /**
     * The cache item type. This could be used to identify a GLSL cache item,
@@ -78,6 +82,7 @@ struct cache_item_metadata {
 };
 
 struct disk_cache;
+struct disk_cache_batch;
 
 #ifdef HAVE_DLADDR
 static inline bool
@@ -234,6 +239,30 @@ disk_cache_put_nocopy(struct disk_cache *cache, const cache_key key,
 void *
 disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size);
 
+/**
+ * Start retrieving the items stored under the \num_keys names in \keys,
+ * which get copied.
+ *
+ * The lookups run in parallel on the threads of the cache, which call \cb
+ * once for every key, in no particular order.  \cb gets the index of the
+ * key and what disk_cache_get() returned for it; the item belongs to the
+ * callback.
+ *
+ * \return A batch to pass to disk_cache_batch_wait(), which must be called
+ * before the cache is destroyed.  NULL if all of the callbacks were already
+ * called.
+ */
+struct disk_cache_batch *
+disk_cache_get_batch(struct disk_cache *cache, const cache_key *keys,
+                     unsigned num_keys, disk_cache_get_batch_cb cb,
+                     void *data);
+
+/**
+ * Wait for all of the callbacks of a batch and free it.
+ */
+void
+disk_cache_batch_wait(struct disk_cache_batch *batch);
+
 /**
  * Store the name \key within the cache, (without any associated data).
  *
@@ -317,6 +346,21 @@ disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size)
    return NULL;
 }
 
+static inline struct disk_cache_batch *
+disk_cache_get_batch(struct disk_cache *cache, const cache_key *keys,
+                     unsigned num_keys, disk_cache_get_batch_cb cb,
+                     void *data)
+{
+   for (unsigned i = 0; i < num_keys; i++)
+      cb(data, i, NULL, 0);
+   return NULL;
+}
+
+static inline void
+disk_cache_batch_wait(struct disk_cache_batch *batch)
+{
+}
+
 static inline void
 disk_cache_put_key(struct disk_cache *cache, const cache_key key)
 {
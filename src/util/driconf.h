@@ -370,6 +370,10 @@
    DRI_CONF_OPT_B(intel_sampler_route_to_lsc, def, \
                   "Intel specific toggle to enable sampler route to LSC")
 
+#define DRI_CONF_INTEL_SIMD_FAST_COMPILE(def) \
+   DRI_CONF_OPT_B(intel_simd_fast_compile, def, \
+                  "Only compile the widest fragment shader SIMD mode expected to not spill, instead of comparing the performance of all of them")
+
 #define DRI_CONF_INTEL_DISABLE_THREADED_CONTEXT(def) \
    DRI_CONF_OPT_B(intel_disable_threaded_context, def, "Disable threaded context")
 
@@ -657,6 +661,10 @@
    DRI_CONF_OPT_B(tu_enable_softfloat32, def, \
                   "Enable softfloat emulation for float32 denormals")
 
+#define DRI_CONF_TU_DISABLE_CONCURRENT_BINNING(def) \
+   DRI_CONF_OPT_B(tu_disable_concurrent_binning, def, \
+                  "Don't overlap the binning pass of a render pass with the rendering of the previous ones (a7xx)")
+
 /**
  * \brief Honeykrisp specific configuration options
  */
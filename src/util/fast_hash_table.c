@@ -0,0 +1,460 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * Implements an open-addressing hash table with separate per-slot control
+ * bytes, probed a group of slots at a time.
+ *
+ * The table size is a power of two.  The mixed hash is split in two: the
+ * upper bits pick the group a probe sequence starts at, and the low 7 bits
+ * are stored in the control byte of the slot the entry ends up in.  Groups
+ * don't need to be aligned, so the control array carries a copy of its
+ * first GROUP_WIDTH bytes at the end, and a group can be loaded from any
+ * slot.  Probing advances by triangular numbers of groups, which visits
+ * every group of a power-of-two table.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "fast_hash_table.h"
+#include "bitscan.h"
+#include "detect_arch.h"
+#include "ralloc.h"
+#include "u_math.h"
+
+#if defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || DETECT_ARCH_X86_64
+#include <emmintrin.h>
+#define FAST_HASH_TABLE_SSE2 1
+#else
+#define FAST_HASH_TABLE_SSE2 0
+#endif
+
+/* Control byte values.  Full slots hold 7 bits of hash, with the top bit
+ * clear.
+ */
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xfe
+
+#define ctrl_is_full(c) ((c) < 0x80)
+
+#define MIN_SIZE 16
+
+#if FAST_HASH_TABLE_SSE2
+
+#define GROUP_WIDTH 16
+#define GROUP_SHIFT 0
+
+typedef __m128i group_t;
+
+static inline group_t
+group_load(const uint8_t *ctrl)
+{
+   return _mm_loadu_si128((const __m128i *)ctrl);
+}
+
+static inline uint64_t
+group_match(group_t g, uint8_t h2)
+{
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), g));
+}
+
+static inline uint64_t
+group_match_empty(group_t g)
+{
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)CTRL_EMPTY), g));
+}
+
+static inline uint64_t
+group_match_empty_or_deleted(group_t g)
+{
+   return _mm_movemask_epi8(g);
+}
+
+#else
+
+/* Portable version, doing 8 control bytes at a time in a 64-bit word.
+ * Matches have the top bit of the corresponding byte set.
+ */
+#define GROUP_WIDTH 8
+#define GROUP_SHIFT 3
+
+#define GROUP_LSBS 0x0101010101010101ull
+#define GROUP_MSBS 0x8080808080808080ull
+
+typedef uint64_t group_t;
+
+static inline group_t
+group_load(const uint8_t *ctrl)
+{
+   uint64_t g;
+   memcpy(&g, ctrl, sizeof(g));
+   return util_le64_to_cpu(g);
+}
+
+static inline uint64_t
+group_match(group_t g, uint8_t h2)
+{
+   /* This can report a false positive for a byte following a real match,
+    * which is fine as the entry's hash gets compared anyway.  Only full
+    * slots can ever match.
+    */
+   const uint64_t x = g ^ (GROUP_LSBS * h2);
+   return (x - GROUP_LSBS) & ~x & GROUP_MSBS;
+}
+
+static inline uint64_t
+group_match_empty(group_t g)
+{
+   /* CTRL_EMPTY is the only value with the top bit set and bit 1 clear */
+   return g & ~(g << 6) & GROUP_MSBS;
+}
+
+static inline uint64_t
+group_match_empty_or_deleted(group_t g)
+{
+   return g & GROUP_MSBS;
+}
+
+#endif
+
+static inline unsigned
+group_mask_next(uint64_t *mask)
+{
+   return u_bit_scan64(mask) >> GROUP_SHIFT;
+}
+
+/**
+ * The hash functions used with Mesa's tables are often weak (pointers
+ * shifted down, small integers), which the prime-sized struct hash_table
+ * copes with.  Power-of-two sizes need all bits of the hash mixed in.
+ */
+static inline uint32_t
+mix_hash(uint32_t hash)
+{
+   hash ^= hash >> 16;
+   hash *= 0x85ebca6b;
+   hash ^= hash >> 13;
+   hash *= 0xc2b2ae35;
+   hash ^= hash >> 16;
+   return hash;
+}
+
+#define H1(h) ((h) >> 7)
+#define H2(h) ((uint8_t)((h) & 0x7f))
+
+static inline void
+set_ctrl(struct fast_hash_table *ht, uint32_t i, uint8_t value)
+{
+   ht->ctrl[i] = value;
+   if (i < GROUP_WIDTH)
+      ht->ctrl[ht->size + i] = value;
+}
+
+static uint32_t
+find_insert_slot(const struct fast_hash_table *ht, uint32_t h)
+{
+   const uint32_t mask = ht->size - 1;
+   uint32_t pos = H1(h) & mask;
+
+   for (uint32_t stride = GROUP_WIDTH;; stride += GROUP_WIDTH) {
+      uint64_t m = group_match_empty_or_deleted(group_load(ht->ctrl + pos));
+      if (m)
+         return (pos + group_mask_next(&m)) & mask;
+
+      pos = (pos + stride) & mask;
+      assert(stride <= ht->size);
+   }
+}
+
+static bool
+fast_hash_table_rehash(struct fast_hash_table *ht, uint32_t new_size)
+{
+   assert(util_is_power_of_two_nonzero(new_size) && new_size >= MIN_SIZE);
+
+   uint8_t *old_ctrl = ht->ctrl;
+   struct hash_entry *old_table = ht->table;
+   const uint32_t old_size = ht->size;
+
+   uint8_t *ctrl = ralloc_array(ht, uint8_t, new_size + GROUP_WIDTH);
+   struct hash_entry *table = ralloc_array(ht, struct hash_entry, new_size);
+   if (ctrl == NULL || table == NULL) {
+      ralloc_free(ctrl);
+      ralloc_free(table);
+      return false;
+   }
+
+   memset(ctrl, CTRL_EMPTY, new_size + GROUP_WIDTH);
+
+   ht->ctrl = ctrl;
+   ht->table = table;
+   ht->size = new_size;
+   ht->max_entries = new_size - new_size / 8;
+   ht->deleted_entries = 0;
+
+   for (uint32_t i = 0; i < old_size; i++) {
+      if (!ctrl_is_full(old_ctrl[i]))
+         continue;
+
+      const uint32_t h = mix_hash(old_table[i].hash);
+      const uint32_t slot = find_insert_slot(ht, h);
+      set_ctrl(ht, slot, H2(h));
+      ht->table[slot] = old_table[i];
+   }
+
+   ralloc_free(old_ctrl);
+   ralloc_free(old_table);
+
+   return true;
+}
+
+struct fast_hash_table *
+_mesa_fast_hash_table_create(void *mem_ctx,
+                             uint32_t (*key_hash_function)(const void *key),
+                             bool (*key_equals_function)(const void *a,
+                                                         const void *b))
+{
+   /* mem_ctx is used to allocate the hash table, but the hash table is used
+    * to allocate all of the suballocations.
+    */
+   struct fast_hash_table *ht = rzalloc(mem_ctx, struct fast_hash_table);
+   if (ht == NULL)
+      return NULL;
+
+   ht->key_hash_function = key_hash_function;
+   ht->key_equals_function = key_equals_function;
+
+   if (!fast_hash_table_rehash(ht, MIN_SIZE)) {
+      ralloc_free(ht);
+      return NULL;
+   }
+
+   return ht;
+}
+
+struct fast_hash_table *
+_mesa_pointer_fast_hash_table_create(void *mem_ctx)
+{
+   return _mesa_fast_hash_table_create(mem_ctx, _mesa_hash_pointer,
+                                       _mesa_key_pointer_equal);
+}
+
+/**
+ * Frees the given hash table.
+ *
+ * If delete_function is passed, it gets called on each entry present before
+ * freeing.
+ */
+void
+_mesa_fast_hash_table_destroy(struct fast_hash_table *ht,
+                              void (*delete_function)(struct hash_entry *entry))
+{
+   if (!ht)
+      return;
+
+   if (delete_function) {
+      fast_hash_table_foreach(ht, entry)
+         delete_function(entry);
+   }
+
+   ralloc_free(ht);
+}
+
+/**
+ * Deletes all entries of the given hash table without deleting the table
+ * itself or changing its structure.
+ *
+ * If delete_function is passed, it gets called on each entry present.
+ */
+void
+_mesa_fast_hash_table_clear(struct fast_hash_table *ht,
+                            void (*delete_function)(struct hash_entry *entry))
+{
+   if (!ht)
+      return;
+
+   if (delete_function) {
+      fast_hash_table_foreach(ht, entry)
+         delete_function(entry);
+   }
+
+   memset(ht->ctrl, CTRL_EMPTY, ht->size + GROUP_WIDTH);
+   ht->entries = 0;
+   ht->deleted_entries = 0;
+}
+
+struct hash_entry *
+_mesa_fast_hash_table_search_pre_hashed(const struct fast_hash_table *ht,
+                                        uint32_t hash, const void *key)
+{
+   const uint32_t mask = ht->size - 1;
+   const uint32_t h = mix_hash(hash);
+   uint32_t pos = H1(h) & mask;
+
+   for (uint32_t stride = GROUP_WIDTH;; stride += GROUP_WIDTH) {
+      const group_t g = group_load(ht->ctrl + pos);
+
+      uint64_t m = group_match(g, H2(h));
+      while (m) {
+         struct hash_entry *entry =
+            ht->table + ((pos + group_mask_next(&m)) & mask);
+
+         if (entry->hash == hash &&
+             ht->key_equals_function(key, entry->key))
+            return entry;
+      }
+
+      /* There's always an empty slot left, so a probe sequence ends at
+       * the first group that has one.
+       */
+      if (group_match_empty(g))
+         return NULL;
+
+      pos = (pos + stride) & mask;
+      assert(stride <= ht->size);
+   }
+}
+
+/**
+ * Finds a hash table entry with the given key.
+ *
+ * Returns NULL if no entry is found.
+ */
+struct hash_entry *
+_mesa_fast_hash_table_search(const struct fast_hash_table *ht,
+                             const void *key)
+{
+   assert(ht->key_hash_function);
+   return _mesa_fast_hash_table_search_pre_hashed(ht,
+                                                  ht->key_hash_function(key),
+                                                  key);
+}
+
+/**
+ * Inserts the key with the given hash into the table.
+ *
+ * Note that insertion may rearrange the table on a resize or rehash,
+ * so previously found hash_entries are no longer valid after this function.
+ */
+struct hash_entry *
+_mesa_fast_hash_table_insert_pre_hashed(struct fast_hash_table *ht,
+                                        uint32_t hash, const void *key,
+                                        void *data)
+{
+   /* Replace the existing entry, like _mesa_hash_table_insert() does */
+   struct hash_entry *entry =
+      _mesa_fast_hash_table_search_pre_hashed(ht, hash, key);
+   if (entry) {
+      entry->key = key;
+      entry->data = data;
+      return entry;
+   }
+
+   if (ht->entries + ht->deleted_entries >= ht->max_entries) {
+      /* Only grow if the table is really getting full, otherwise just get
+       * rid of the deleted entries.
+       */
+      const uint32_t new_size =
+         ht->entries >= ht->max_entries / 2 ? ht->size * 2 : ht->size;
+      if (!fast_hash_table_rehash(ht, new_size))
+         return NULL;
+   }
+
+   const uint32_t h = mix_hash(hash);
+   const uint32_t slot = find_insert_slot(ht, h);
+
+   if (ht->ctrl[slot] == CTRL_DELETED)
+      ht->deleted_entries--;
+   set_ctrl(ht, slot, H2(h));
+   ht->entries++;
+
+   entry = ht->table + slot;
+   entry->hash = hash;
+   entry->key = key;
+   entry->data = data;
+
+   return entry;
+}
+
+struct hash_entry *
+_mesa_fast_hash_table_insert(struct fast_hash_table *ht, const void *key,
+                             void *data)
+{
+   assert(ht->key_hash_function);
+   return _mesa_fast_hash_table_insert_pre_hashed(ht,
+                                                  ht->key_hash_function(key),
+                                                  key, data);
+}
+
+/**
+ * This function deletes the given hash table entry.
+ *
+ * Note that deletion doesn't otherwise modify the table, so an iteration
+ * over the table deleting entries is safe.
+ */
+void
+_mesa_fast_hash_table_remove(struct fast_hash_table *ht,
+                             struct hash_entry *entry)
+{
+   if (!entry)
+      return;
+
+   const uint32_t slot = entry - ht->table;
+   assert(slot < ht->size && ctrl_is_full(ht->ctrl[slot]));
+
+   /* Probe sequences may have gone past this slot, so it can't just be
+    * marked empty again.
+    */
+   set_ctrl(ht, slot, CTRL_DELETED);
+   ht->entries--;
+   ht->deleted_entries++;
+}
+
+/**
+ * Removes the entry with the corresponding key, if exists.
+ */
+void
+_mesa_fast_hash_table_remove_key(struct fast_hash_table *ht,
+                                 const void *key)
+{
+   _mesa_fast_hash_table_remove(ht, _mesa_fast_hash_table_search(ht, key));
+}
+
+/**
+ * Makes room for at least size entries without any further rehashing.
+ */
+bool
+_mesa_fast_hash_table_reserve(struct fast_hash_table *ht, unsigned size)
+{
+   if (size <= ht->max_entries - ht->deleted_entries)
+      return true;
+
+   uint32_t new_size = ht->size;
+   while (new_size - new_size / 8 < size)
+      new_size *= 2;
+
+   return fast_hash_table_rehash(ht, new_size);
+}
+
+/**
+ * This function is an iterator over the hash table.
+ *
+ * Pass in NULL for the first entry, as in the start of a for loop.
+ * Note that an iteration over the table is O(table_size) not
+ * O(entries).
+ */
+struct hash_entry *
+_mesa_fast_hash_table_next_entry(const struct fast_hash_table *ht,
+                                 struct hash_entry *entry)
+{
+   uint32_t i = entry ? entry - ht->table + 1 : 0;
+
+   for (; i < ht->size; i++) {
+      if (ctrl_is_full(ht->ctrl[i]))
+         return ht->table + i;
+   }
+
+   return NULL;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef _FAST_HASH_TABLE_H
+#define _FAST_HASH_TABLE_H
+
+#include "hash_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Open-addressing hash table with the same entries and interface as
+ * struct hash_table, but keeping one control byte per slot in a separate
+ * array.  Byte values tell whether a slot is empty, deleted, or full, and
+ * for full slots hold 7 bits of the hash.  Lookups check a whole group of
+ * control bytes at once (16 with SSE2, 8 otherwise) and only touch the
+ * entries whose bits match, so misses and collisions rarely cost a cache
+ * miss into the entry array.
+ *
+ * Unlike struct hash_table, any key value can be stored, including NULL.
+ * Entry pointers stay valid until the next insertion.
+ */
+struct fast_hash_table {
+   uint8_t *ctrl;
+   struct hash_entry *table;
+   uint32_t (*key_hash_function)(const void *key);
+   bool (*key_equals_function)(const void *a, const void *b);
+   uint32_t size;
+   uint32_t max_entries;
+   uint32_t entries;
+   uint32_t deleted_entries;
+};
+
+struct fast_hash_table *
+_mesa_fast_hash_table_create(void *mem_ctx,
+                             uint32_t (*key_hash_function)(const void *key),
+                             bool (*key_equals_function)(const void *a,
+                                                         const void *b));
+
+struct fast_hash_table *
+_mesa_pointer_fast_hash_table_create(void *mem_ctx);
+
+void _mesa_fast_hash_table_destroy(struct fast_hash_table *ht,
+                                   void (*delete_function)(struct hash_entry *entry));
+void _mesa_fast_hash_table_clear(struct fast_hash_table *ht,
+                                 void (*delete_function)(struct hash_entry *entry));
+
+static inline uint32_t
+_mesa_fast_hash_table_num_entries(const struct fast_hash_table *ht)
+{
+   return ht->entries;
+}
+
+struct hash_entry *
+_mesa_fast_hash_table_insert(struct fast_hash_table *ht, const void *key,
+                             void *data);
+struct hash_entry *
+_mesa_fast_hash_table_insert_pre_hashed(struct fast_hash_table *ht,
+                                        uint32_t hash, const void *key,
+                                        void *data);
+struct hash_entry *
+_mesa_fast_hash_table_search(const struct fast_hash_table *ht,
+                             const void *key);
+struct hash_entry *
+_mesa_fast_hash_table_search_pre_hashed(const struct fast_hash_table *ht,
+                                        uint32_t hash, const void *key);
+void _mesa_fast_hash_table_remove(struct fast_hash_table *ht,
+                                  struct hash_entry *entry);
+void _mesa_fast_hash_table_remove_key(struct fast_hash_table *ht,
+                                      const void *key);
+
+bool
+_mesa_fast_hash_table_reserve(struct fast_hash_table *ht, unsigned size);
+
+struct hash_entry *
+_mesa_fast_hash_table_next_entry(const struct fast_hash_table *ht,
+                                 struct hash_entry *entry);
+
+/**
+ * This foreach function is safe against deletion, but not against
+ * insertion (which may rehash the table, making entry a dangling pointer).
+ */
+#define fast_hash_table_foreach(ht, entry)                                      \
+   for (struct hash_entry *entry = _mesa_fast_hash_table_next_entry(ht, NULL);  \
+        entry != NULL;                                                          \
+        entry = _mesa_fast_hash_table_next_entry(ht, entry))
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+#endif /* _FAST_HASH_TABLE_H */
@@ -119,11 +119,14 @@ util_format_dxt5_rgba_fetch_rgba(void *restrict in_dst, const uint8_t *restrict
  * Block decompression.
  */
 
+typedef void (*util_format_dxtn_decode_block_t)(const uint8_t *block,
+                                                uint8_t rgba[16][4]);
+
 static inline void
 util_format_dxtn_rgb_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned dst_stride,
                                         const uint8_t *restrict src_row, unsigned src_stride,
                                         unsigned width, unsigned height,
-                                        util_format_dxtn_fetch_t fetch,
+                                        util_format_dxtn_decode_block_t decode,
                                         unsigned block_size, bool srgb)
 {
    const unsigned bw = 4, bh = 4, comps = 4;
@@ -133,10 +136,12 @@ util_format_dxtn_rgb_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned dst_
       const unsigned h = MIN2(height - y, bh);
       for(x = 0; x < width; x += bw) {
          const unsigned w = MIN2(width - x, bw);
+         uint8_t texels[16][4];
+         decode(src, texels);
          for(j = 0; j < h; ++j) {
             for(i = 0; i < w; ++i) {
                uint8_t *dst = dst_row + (y + j)*dst_stride/sizeof(*dst_row) + (x + i)*comps;
-               fetch(0, src, i, j, dst);
+               memcpy(dst, texels[j * 4 + i], 4);
                if (srgb) {
                   dst[0] = util_format_srgb_to_linear_8unorm(dst[0]);
                   dst[1] = util_format_srgb_to_linear_8unorm(dst[1]);
@@ -158,7 +163,7 @@ util_format_dxt1_rgb_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned dst_
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt1_rgb_fetch,
+                                           decode_block_rgb_dxt1,
                                            8, false);
 }
 
@@ -170,7 +175,7 @@ util_format_dxt1_rgba_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned dst
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt1_rgba_fetch,
+                                           decode_block_rgba_dxt1,
                                            8, false);
 }
 
@@ -182,7 +187,7 @@ util_format_dxt3_rgba_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned dst
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt3_rgba_fetch,
+                                           decode_block_rgba_dxt3,
                                            16, false);
 }
 
@@ -194,7 +199,7 @@ util_format_dxt5_rgba_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned dst
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt5_rgba_fetch,
+                                           decode_block_rgba_dxt5,
                                            16, false);
 }
 
@@ -202,18 +207,19 @@ static inline void
 util_format_dxtn_rgb_unpack_rgba_float(float *restrict dst_row, unsigned dst_stride,
                                        const uint8_t *restrict src_row, unsigned src_stride,
                                        unsigned width, unsigned height,
-                                       util_format_dxtn_fetch_t fetch,
+                                       util_format_dxtn_decode_block_t decode,
                                        unsigned block_size, bool srgb)
 {
    unsigned x, y, i, j;
    for(y = 0; y < height; y += 4) {
       const uint8_t *src = src_row;
       for(x = 0; x < width; x += 4) {
+         uint8_t texels[16][4];
+         decode(src, texels);
          for(j = 0; j < 4; ++j) {
             for(i = 0; i < 4; ++i) {
                float *dst = dst_row + (y + j)*dst_stride/sizeof(*dst_row) + (x + i)*4;
-               uint8_t tmp[4];
-               fetch(0, src, i, j, tmp);
+               const uint8_t *tmp = texels[j * 4 + i];
                if (srgb) {
                   dst[0] = util_format_srgb_8unorm_to_linear_float(tmp[0]);
                   dst[1] = util_format_srgb_8unorm_to_linear_float(tmp[1]);
@@ -241,7 +247,7 @@ util_format_dxt1_rgb_unpack_rgba_float(void *restrict dst_row, unsigned dst_stri
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt1_rgb_fetch,
+                                          decode_block_rgb_dxt1,
                                           8, false);
 }
 
@@ -253,7 +259,7 @@ util_format_dxt1_rgba_unpack_rgba_float(void *restrict dst_row, unsigned dst_str
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt1_rgba_fetch,
+                                          decode_block_rgba_dxt1,
                                           8, false);
 }
 
@@ -265,7 +271,7 @@ util_format_dxt3_rgba_unpack_rgba_float(void *restrict dst_row, unsigned dst_str
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt3_rgba_fetch,
+                                          decode_block_rgba_dxt3,
                                           16, false);
 }
 
@@ -277,7 +283,7 @@ util_format_dxt5_rgba_unpack_rgba_float(void *restrict dst_row, unsigned dst_str
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt5_rgba_fetch,
+                                          decode_block_rgba_dxt5,
                                           16, false);
 }
 
@@ -543,7 +549,7 @@ util_format_dxt1_srgb_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned dst
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt1_rgb_fetch,
+                                           decode_block_rgb_dxt1,
                                            8, true);
 }
 
@@ -553,7 +559,7 @@ util_format_dxt1_srgba_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned ds
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt1_rgba_fetch,
+                                           decode_block_rgba_dxt1,
                                            8, true);
 }
 
@@ -563,7 +569,7 @@ util_format_dxt3_srgba_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned ds
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt3_rgba_fetch,
+                                           decode_block_rgba_dxt3,
                                            16, true);
 }
 
@@ -573,7 +579,7 @@ util_format_dxt5_srgba_unpack_rgba_8unorm(uint8_t *restrict dst_row, unsigned ds
    util_format_dxtn_rgb_unpack_rgba_8unorm(dst_row, dst_stride,
                                            src_row, src_stride,
                                            width, height,
-                                           util_format_dxt5_rgba_fetch,
+                                           decode_block_rgba_dxt5,
                                            16, true);
 }
 
@@ -583,7 +589,7 @@ util_format_dxt1_srgb_unpack_rgba_float(void *restrict dst_row, unsigned dst_str
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt1_rgb_fetch,
+                                          decode_block_rgb_dxt1,
                                           8, true);
 }
 
@@ -593,7 +599,7 @@ util_format_dxt1_srgba_unpack_rgba_float(void *restrict dst_row, unsigned dst_st
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt1_rgba_fetch,
+                                          decode_block_rgba_dxt1,
                                           8, true);
 }
 
@@ -603,7 +609,7 @@ util_format_dxt3_srgba_unpack_rgba_float(void *restrict dst_row, unsigned dst_st
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt3_rgba_fetch,
+                                          decode_block_rgba_dxt3,
                                           16, true);
 }
 
@@ -613,7 +619,7 @@ util_format_dxt5_srgba_unpack_rgba_float(void *restrict dst_row, unsigned dst_st
    util_format_dxtn_rgb_unpack_rgba_float(dst_row, dst_stride,
                                           src_row, src_stride,
                                           width, height,
-                                          util_format_dxt5_rgba_fetch,
+                                          decode_block_rgba_dxt5,
                                           16, true);
 }
 
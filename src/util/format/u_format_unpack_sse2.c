@@ -0,0 +1,189 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "util/detect_arch.h"
+#include "util/format/u_format.h"
+
+#if (DETECT_ARCH_X86 || DETECT_ARCH_X86_64) && defined(__SSE2__) && !defined(NO_FORMAT_ASM)
+
+#include <emmintrin.h>
+#include "u_format_pack.h"
+
+/* All of these work on 4 pixels of 32 bits at a time and leave the rest of
+ * the row to the generated unpack functions.
+ */
+
+static inline __m128i
+bgra_to_rgba_8unorm(__m128i px)
+{
+   const __m128i ag_mask = _mm_set1_epi32(0xff00ff00);
+   __m128i ag = _mm_and_si128(px, ag_mask);
+   __m128i br = _mm_andnot_si128(ag_mask, px);
+   br = _mm_or_si128(_mm_slli_epi32(br, 16), _mm_srli_epi32(br, 16));
+   return _mm_or_si128(ag, br);
+}
+
+static void
+util_format_b8g8r8a8_unorm_unpack_rgba_8unorm_sse2(uint8_t *restrict dst, const uint8_t *restrict src, unsigned width)
+{
+   while (width >= 4) {
+      __m128i px = _mm_loadu_si128((const __m128i *)src);
+      _mm_storeu_si128((__m128i *)dst, bgra_to_rgba_8unorm(px));
+      width -= 4;
+      dst += 4 * 4;
+      src += 4 * 4;
+   }
+   if (width)
+      util_format_b8g8r8a8_unorm_unpack_rgba_8unorm(dst, src, width);
+}
+
+static void
+util_format_b8g8r8x8_unorm_unpack_rgba_8unorm_sse2(uint8_t *restrict dst, const uint8_t *restrict src, unsigned width)
+{
+   const __m128i alpha = _mm_set1_epi32(0xff000000);
+
+   while (width >= 4) {
+      __m128i px = _mm_loadu_si128((const __m128i *)src);
+      px = _mm_or_si128(bgra_to_rgba_8unorm(px), alpha);
+      _mm_storeu_si128((__m128i *)dst, px);
+      width -= 4;
+      dst += 4 * 4;
+      src += 4 * 4;
+   }
+   if (width)
+      util_format_b8g8r8x8_unorm_unpack_rgba_8unorm(dst, src, width);
+}
+
+static void
+util_format_r8g8b8x8_unorm_unpack_rgba_8unorm_sse2(uint8_t *restrict dst, const uint8_t *restrict src, unsigned width)
+{
+   const __m128i alpha = _mm_set1_epi32(0xff000000);
+
+   while (width >= 4) {
+      __m128i px = _mm_loadu_si128((const __m128i *)src);
+      _mm_storeu_si128((__m128i *)dst, _mm_or_si128(px, alpha));
+      width -= 4;
+      dst += 4 * 4;
+      src += 4 * 4;
+   }
+   if (width)
+      util_format_r8g8b8x8_unorm_unpack_rgba_8unorm(dst, src, width);
+}
+
+/* Converts the 4 pixels to floats, with the channels in memory order. */
+static inline void
+unpack_4x8unorm_float(float *restrict dst, __m128i px)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+   __m128i lo = _mm_unpacklo_epi8(px, zero);
+   __m128i hi = _mm_unpackhi_epi8(px, zero);
+
+   _mm_storeu_ps(dst + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+   _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+   _mm_storeu_ps(dst + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+   _mm_storeu_ps(dst + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+}
+
+static void
+util_format_r8g8b8a8_unorm_unpack_rgba_float_sse2(void *restrict dst_row, const uint8_t *restrict src, unsigned width)
+{
+   float *dst = dst_row;
+
+   while (width >= 4) {
+      unpack_4x8unorm_float(dst, _mm_loadu_si128((const __m128i *)src));
+      width -= 4;
+      dst += 4 * 4;
+      src += 4 * 4;
+   }
+   if (width)
+      util_format_r8g8b8a8_unorm_unpack_rgba_float(dst, src, width);
+}
+
+static void
+util_format_r8g8b8x8_unorm_unpack_rgba_float_sse2(void *restrict dst_row, const uint8_t *restrict src, unsigned width)
+{
+   const __m128i alpha = _mm_set1_epi32(0xff000000);
+   float *dst = dst_row;
+
+   while (width >= 4) {
+      __m128i px = _mm_loadu_si128((const __m128i *)src);
+      unpack_4x8unorm_float(dst, _mm_or_si128(px, alpha));
+      width -= 4;
+      dst += 4 * 4;
+      src += 4 * 4;
+   }
+   if (width)
+      util_format_r8g8b8x8_unorm_unpack_rgba_float(dst, src, width);
+}
+
+static void
+util_format_b8g8r8a8_unorm_unpack_rgba_float_sse2(void *restrict dst_row, const uint8_t *restrict src, unsigned width)
+{
+   float *dst = dst_row;
+
+   while (width >= 4) {
+      __m128i px = _mm_loadu_si128((const __m128i *)src);
+      unpack_4x8unorm_float(dst, bgra_to_rgba_8unorm(px));
+      width -= 4;
+      dst += 4 * 4;
+      src += 4 * 4;
+   }
+   if (width)
+      util_format_b8g8r8a8_unorm_unpack_rgba_float(dst, src, width);
+}
+
+static void
+util_format_b8g8r8x8_unorm_unpack_rgba_float_sse2(void *restrict dst_row, const uint8_t *restrict src, unsigned width)
+{
+   const __m128i alpha = _mm_set1_epi32(0xff000000);
+   float *dst = dst_row;
+
+   while (width >= 4) {
+      __m128i px = _mm_loadu_si128((const __m128i *)src);
+      unpack_4x8unorm_float(dst, _mm_or_si128(bgra_to_rgba_8unorm(px), alpha));
+      width -= 4;
+      dst += 4 * 4;
+      src += 4 * 4;
+   }
+   if (width)
+      util_format_b8g8r8x8_unorm_unpack_rgba_float(dst, src, width);
+}
+
+static const struct util_format_unpack_description util_format_unpack_descriptions_sse2[] = {
+   [PIPE_FORMAT_B8G8R8A8_UNORM] = {
+      .unpack_rgba_8unorm = &util_format_b8g8r8a8_unorm_unpack_rgba_8unorm_sse2,
+      .unpack_rgba = &util_format_b8g8r8a8_unorm_unpack_rgba_float_sse2,
+   },
+   [PIPE_FORMAT_B8G8R8X8_UNORM] = {
+      .unpack_rgba_8unorm = &util_format_b8g8r8x8_unorm_unpack_rgba_8unorm_sse2,
+      .unpack_rgba = &util_format_b8g8r8x8_unorm_unpack_rgba_float_sse2,
+   },
+   [PIPE_FORMAT_R8G8B8A8_UNORM] = {
+      .unpack_rgba_8unorm = &util_format_r8g8b8a8_unorm_unpack_rgba_8unorm,
+      .unpack_rgba = &util_format_r8g8b8a8_unorm_unpack_rgba_float_sse2,
+   },
+   [PIPE_FORMAT_R8G8B8X8_UNORM] = {
+      .unpack_rgba_8unorm = &util_format_r8g8b8x8_unorm_unpack_rgba_8unorm_sse2,
+      .unpack_rgba = &util_format_r8g8b8x8_unorm_unpack_rgba_float_sse2,
+   },
+};
+
+const struct util_format_unpack_description *
+util_format_unpack_description_sse2(enum pipe_format format)
+{
+   /* SSE2 is part of x86-64, and 32-bit builds only get here when they were
+    * built for it anyway.
+    */
+   if (format >= ARRAY_SIZE(util_format_unpack_descriptions_sse2))
+      return NULL;
+
+   if (!util_format_unpack_descriptions_sse2[format].unpack_rgba)
+      return NULL;
+
+   return &util_format_unpack_descriptions_sse2[format];
+}
+
+#endif /* DETECT_ARCH_X86 | DETECT_ARCH_X86_64 */
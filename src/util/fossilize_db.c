@@ -168,6 +168,7 @@ update_foz_index(struct foz_db *foz_db, FILE *db_idx, unsigned file_idx)
       struct foz_db_entry *entry = ralloc(foz_db->mem_ctx,
                                           struct foz_db_entry);
       entry->header = *header;
+      entry->header_valid = false;
       entry->file_idx = file_idx;
       _mesa_sha1_hex_to_sha1(entry->key, hash_str);
 
@@ -604,35 +605,52 @@ foz_read_entry(struct foz_db *foz_db, const uint8_t *cache_key_160bit,
       return NULL;
    }
 
-   uint8_t file_idx = entry->file_idx;
-   if (fseek(foz_db->file[file_idx], entry->offset, SEEK_SET) < 0)
-      goto fail;
-
-   uint32_t header_size = sizeof(struct foz_payload_header);
-   if (fread(&entry->header, 1, header_size, foz_db->file[file_idx]) !=
-       header_size)
-      goto fail;
+   /* Entries are flushed to disk before they are added to the index and are
+    * never rewritten, so the payload can be read with pread() outside the
+    * mutex.  This doesn't move the shared file offset and lets concurrent
+    * readers, such as pre-compilation threads, overlap their I/O.
+    */
+   int fd = fileno(foz_db->file[entry->file_idx]);
+   uint64_t offset = entry->offset;
+   const bool header_valid = entry->header_valid;
+   struct foz_payload_header header = entry->header;
 
    /* Check for collision using full 160bit hash for increased assurance
     * against potential collisions.
     */
-   for (int i = 0; i < 20; i++) {
-      if (cache_key_160bit[i] != entry->key[i])
-         goto fail;
-   }
+   bool collision = memcmp(cache_key_160bit, entry->key, 20) != 0;
+
+   simple_mtx_unlock(&foz_db->mtx);
+
+   if (collision)
+      return NULL;
 
-   uint32_t data_sz = entry->header.payload_size;
+   uint32_t header_size = sizeof(struct foz_payload_header);
+   if (!header_valid &&
+       pread(fd, &header, header_size, offset) != header_size)
+      return NULL;
+
+   uint32_t data_sz = header.payload_size;
    data = malloc(data_sz);
-   if (fread(data, 1, data_sz, foz_db->file[file_idx]) != data_sz)
+   if (!data)
+      return NULL;
+
+   if (pread(fd, data, data_sz, offset + header_size) != data_sz)
       goto fail;
 
    /* verify checksum */
-   if (entry->header.crc != 0) {
-      if (util_hash_crc32(data, data_sz) != entry->header.crc)
+   if (header.crc != 0) {
+      if (util_hash_crc32(data, data_sz) != header.crc)
          goto fail;
    }
 
-   simple_mtx_unlock(&foz_db->mtx);
+   /* Remember the payload header so later reads only need one pread() */
+   if (!header_valid) {
+      simple_mtx_lock(&foz_db->mtx);
+      entry->header = header;
+      entry->header_valid = true;
+      simple_mtx_unlock(&foz_db->mtx);
+   }
 
    if (size)
       *size = data_sz;
@@ -642,9 +660,6 @@ foz_read_entry(struct foz_db *foz_db, const uint8_t *cache_key_160bit,
 fail:
    free(data);
 
-   /* reading db entry failed. reset the file offset */
-   simple_mtx_unlock(&foz_db->mtx);
-
    return NULL;
 }
 
@@ -689,6 +704,7 @@ foz_write_entry(struct foz_db *foz_db, const uint8_t *cache_key_160bit,
    header.format = FOSSILIZE_COMPRESSION_NONE;
    header.payload_size = blob_size;
    header.crc = util_hash_crc32(blob, blob_size);
+   const struct foz_payload_header payload_header = header;
 
    fseek(foz_db->file[0], 0, SEEK_END);
 
@@ -734,7 +750,8 @@ foz_write_entry(struct foz_db *foz_db, const uint8_t *cache_key_160bit,
    fflush(foz_db->db_idx);
 
    entry = ralloc(foz_db->mem_ctx, struct foz_db_entry);
-   entry->header = header;
+   entry->header = payload_header;
+   entry->header_valid = true;
    entry->offset = offset;
    entry->file_idx = 0;
    _mesa_sha1_hex_to_sha1(entry->key, hash_str);
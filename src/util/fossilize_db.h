@@ -74,6 +74,7 @@ struct foz_db_entry {
    uint8_t key[20];
    uint64_t offset;
    struct foz_payload_header header;
+   bool header_valid;                /* header is the payload's header */
 };
 
 struct foz_dbs_list_updater {
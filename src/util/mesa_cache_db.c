@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "crc32.h"
@@ -56,6 +57,7 @@ struct mesa_index_db_hash_entry {
    uint64_t last_access_time;
    uint32_t size;
    bool evicted;
+   bool access_pending;
 };
 
 static inline bool mesa_db_seek_end(FILE *file)
@@ -96,6 +98,9 @@ mesa_db_reopen_file(struct mesa_cache_db_file *db_file);
 static void
 mesa_db_close_file(struct mesa_cache_db_file *db_file);
 
+static void
+mesa_db_flush_access_times(struct mesa_cache_db *db);
+
 static int
 mesa_db_flock(FILE *file, int op)
 {
@@ -112,6 +117,7 @@ static bool
 mesa_db_lock(struct mesa_cache_db *db)
 {
    simple_mtx_lock(&db->flock_mtx);
+   u_rwlock_wrlock(&db->index_lock);
 
    if (!mesa_db_reopen_file(&db->index) ||
        !mesa_db_reopen_file(&db->cache))
@@ -123,6 +129,8 @@ mesa_db_lock(struct mesa_cache_db *db)
    if (mesa_db_flock(db->index.file, LOCK_EX) < 0)
       goto unlock_cache;
 
+   mesa_db_flush_access_times(db);
+
    return true;
 
 unlock_cache:
@@ -131,6 +139,7 @@ close_files:
    mesa_db_close_file(&db->index);
    mesa_db_close_file(&db->cache);
 
+   u_rwlock_wrunlock(&db->index_lock);
    simple_mtx_unlock(&db->flock_mtx);
 
    return false;
@@ -145,6 +154,7 @@ mesa_db_unlock(struct mesa_cache_db *db)
    mesa_db_close_file(&db->index);
    mesa_db_close_file(&db->cache);
 
+   u_rwlock_wrunlock(&db->index_lock);
    simple_mtx_unlock(&db->flock_mtx);
 }
 
@@ -211,6 +221,38 @@ static bool mesa_db_uuid_changed(struct mesa_cache_db *db)
    return false;
 }
 
+/* Write out the last access times of the entries that were read without
+ * taking the file lock.  Must be called with the lock held, before anything
+ * reloads the index.
+ */
+static void
+mesa_db_flush_access_times(struct mesa_cache_db *db)
+{
+   if (!db->pending_access.size)
+      return;
+
+   /* The entries moved if the database was compacted in the meantime. */
+   if (db->alive && !mesa_db_uuid_changed(db)) {
+      util_dynarray_foreach(&db->pending_access,
+                            struct mesa_index_db_hash_entry *, entry) {
+         long offset = (*entry)->index_db_file_offset +
+            offsetof(struct mesa_index_db_file_entry, last_access_time);
+
+         if (!mesa_db_seek(db->index.file, offset) ||
+             !mesa_db_write(db->index.file, &(*entry)->last_access_time))
+            break;
+      }
+
+      fflush(db->index.file);
+   }
+
+   util_dynarray_foreach(&db->pending_access,
+                         struct mesa_index_db_hash_entry *, entry)
+      (*entry)->access_pending = false;
+
+   util_dynarray_clear(&db->pending_access);
+}
+
 static bool
 mesa_db_write_header(struct mesa_cache_db_file *db_file,
                      uint64_t uuid, bool reset)
@@ -278,7 +320,7 @@ mesa_db_cache_entry_valid(struct mesa_cache_db_file_entry *entry)
 static bool
 mesa_db_update_index(struct mesa_cache_db *db)
 {
-   struct mesa_index_db_hash_entry *hash_entry;
+   struct mesa_index_db_hash_entry *hash_entries;
    struct mesa_index_db_file_entry *index_entries, *index_entry;
    size_t file_length;
    size_t old_entries, new_entries;
@@ -300,20 +342,31 @@ mesa_db_update_index(struct mesa_cache_db *db)
    new_entries = (file_length - db->index.offset) / sizeof(*index_entries);
    _mesa_hash_table_reserve(&db->index_db->table, old_entries + new_entries);
 
+   if (!new_entries)
+      return mesa_db_seek(db->index.file, db->index.offset) &&
+             db->index.offset == file_length;
+
    new_index_size = new_entries * sizeof(*index_entries);
    index_entries = malloc(new_index_size);
+   if (!index_entries)
+      return false;
+
    if (!mesa_db_read_data(db->index.file, index_entries, new_index_size))
       goto error;
 
+   /* Big caches have many thousands of entries, allocate them all at once. */
+   hash_entries = rzalloc_array(db->mem_ctx, struct mesa_index_db_hash_entry,
+                                new_entries);
+   if (!hash_entries)
+      goto error;
+
    for (i = 0, index_entry = index_entries; i < new_entries; i++, index_entry++) {
+      struct mesa_index_db_hash_entry *hash_entry = &hash_entries[i];
+
       /* Check whether the index entry looks valid or we have a corrupted DB */
       if (!mesa_db_index_entry_valid(index_entry))
          break;
 
-      hash_entry = ralloc(db->mem_ctx, struct mesa_index_db_hash_entry);
-      if (!hash_entry)
-         break;
-
       hash_entry->cache_db_file_offset = index_entry->cache_db_file_offset;
       hash_entry->index_db_file_offset = db->index.offset;
       hash_entry->last_access_time = index_entry->last_access_time;
@@ -336,6 +389,7 @@ error:
 static void
 mesa_db_hash_table_reset(struct mesa_cache_db *db)
 {
+   util_dynarray_clear(&db->pending_access);
    _mesa_hash_table_u64_clear(db->index_db);
    ralloc_free(db->mem_ctx);
    db->mem_ctx = ralloc_context(NULL);
@@ -375,9 +429,15 @@ mesa_db_load(struct mesa_cache_db *db, bool reload)
 
    db->index.offset = ftell(db->index.file);
 
-   if (reload)
+   if (reload) {
       mesa_db_hash_table_reset(db);
 
+      /* The files may have been removed and created anew meanwhile. */
+      if (db->cache_fd >= 0)
+         close(db->cache_fd);
+      db->cache_fd = open(db->cache.path, O_RDONLY | O_CLOEXEC);
+   }
+
    /* The update failed so we assume the files are corrupt and
     * recreate them.
     */
@@ -696,6 +756,12 @@ mesa_cache_db_open(struct mesa_cache_db *db, const char *cache_path)
       goto close_index;
 
    simple_mtx_init(&db->flock_mtx, mtx_plain);
+   simple_mtx_init(&db->access_mtx, mtx_plain);
+   u_rwlock_init(&db->index_lock);
+   util_dynarray_init(&db->pending_access, NULL);
+
+   /* Not fatal, reads then always use the locked path. */
+   db->cache_fd = open(db->cache.path, O_RDONLY | O_CLOEXEC);
 
    db->index_db = _mesa_hash_table_u64_create(NULL);
    if (!db->index_db)
@@ -709,6 +775,11 @@ mesa_cache_db_open(struct mesa_cache_db *db, const char *cache_path)
 destroy_hash:
    _mesa_hash_table_u64_destroy(db->index_db);
 destroy_mtx:
+   if (db->cache_fd >= 0)
+      close(db->cache_fd);
+   util_dynarray_fini(&db->pending_access);
+   u_rwlock_destroy(&db->index_lock);
+   simple_mtx_destroy(&db->access_mtx);
    simple_mtx_destroy(&db->flock_mtx);
 
    ralloc_free(db->mem_ctx);
@@ -739,7 +810,17 @@ mesa_db_wipe_path(const char *cache_path)
 void
 mesa_cache_db_close(struct mesa_cache_db *db)
 {
+   /* Write out the access times of the last unlocked reads. */
+   if (db->pending_access.size && mesa_db_lock(db))
+      mesa_db_unlock(db);
+
+   if (db->cache_fd >= 0)
+      close(db->cache_fd);
+
    _mesa_hash_table_u64_destroy(db->index_db);
+   util_dynarray_fini(&db->pending_access);
+   u_rwlock_destroy(&db->index_lock);
+   simple_mtx_destroy(&db->access_mtx);
    simple_mtx_destroy(&db->flock_mtx);
    ralloc_free(db->mem_ctx);
 
@@ -760,6 +841,92 @@ mesa_cache_db_file_entry_size(void)
    return sizeof(struct mesa_cache_db_file_entry);
 }
 
+static bool
+mesa_db_pread_uuid(int fd, uint64_t *uuid)
+{
+   return pread(fd, uuid, sizeof(*uuid),
+                offsetof(struct mesa_db_file_header, uuid)) == sizeof(*uuid);
+}
+
+/* Looks up an entry without taking the file lock, which serializes every
+ * access to the database across processes.  Entries are only moved or
+ * overwritten by compaction, which zeroes the header uuid before touching
+ * them and writes a new uuid once done, so the data read is what the
+ * in-memory index describes if the uuid matches the index before and after
+ * reading it.  pread() is used rather than mapping the file, as compaction
+ * truncates it under us.
+ *
+ * Returns false if the locked path has to be taken, either because the
+ * read couldn't be validated or because other processes added entries
+ * that the in-memory index doesn't know about yet.
+ */
+static bool
+mesa_db_read_entry_unlocked(struct mesa_cache_db *db,
+                            const uint8_t *cache_key_160bit,
+                            void **data_out, size_t *size)
+{
+   uint64_t hash = to_mesa_cache_db_hash(cache_key_160bit);
+   struct mesa_cache_db_file_entry cache_entry;
+   struct mesa_index_db_hash_entry *hash_entry;
+   void *data = NULL;
+   uint64_t uuid;
+   bool ret = false;
+
+   *data_out = NULL;
+
+   u_rwlock_rdlock(&db->index_lock);
+
+   if (!db->alive || !db->uuid || db->cache_fd < 0 ||
+       !mesa_db_pread_uuid(db->cache_fd, &uuid) || uuid != db->uuid)
+      goto out;
+
+   hash_entry = _mesa_hash_table_u64_search(db->index_db, hash);
+   if (!hash_entry) {
+      struct stat st;
+
+      /* The index file is append-only between compactions. */
+      ret = !stat(db->index.path, &st) && st.st_size == db->index.offset;
+      goto out;
+   }
+
+   if (pread(db->cache_fd, &cache_entry, sizeof(cache_entry),
+             hash_entry->cache_db_file_offset) != sizeof(cache_entry) ||
+       !mesa_db_cache_entry_valid(&cache_entry) ||
+       memcmp(cache_entry.key, cache_key_160bit, sizeof(cache_entry.key)))
+      goto out;
+
+   data = malloc(cache_entry.size);
+   if (!data)
+      goto out;
+
+   if (pread(db->cache_fd, data, cache_entry.size,
+             hash_entry->cache_db_file_offset + sizeof(cache_entry)) !=
+          cache_entry.size ||
+       util_hash_crc32(data, cache_entry.size) != cache_entry.crc ||
+       !mesa_db_pread_uuid(db->cache_fd, &uuid) || uuid != db->uuid) {
+      free(data);
+      goto out;
+   }
+
+   /* The access time is written out the next time the lock is taken. */
+   simple_mtx_lock(&db->access_mtx);
+   hash_entry->last_access_time = os_time_get_nano();
+   if (!hash_entry->access_pending) {
+      hash_entry->access_pending = true;
+      util_dynarray_append(&db->pending_access, hash_entry);
+   }
+   simple_mtx_unlock(&db->access_mtx);
+
+   *data_out = data;
+   *size = cache_entry.size;
+   ret = true;
+
+out:
+   u_rwlock_rdunlock(&db->index_lock);
+
+   return ret;
+}
+
 void *
 mesa_cache_db_read_entry(struct mesa_cache_db *db,
                          const uint8_t *cache_key_160bit,
@@ -771,6 +938,9 @@ mesa_cache_db_read_entry(struct mesa_cache_db *db,
    struct mesa_index_db_hash_entry *hash_entry;
    void *data = NULL;
 
+   if (mesa_db_read_entry_unlocked(db, cache_key_160bit, &data, size))
+      return data;
+
    if (!mesa_db_lock(db))
       return NULL;
 
@@ -898,7 +1068,7 @@ mesa_cache_db_entry_write(struct mesa_cache_db *db,
    index_entry.last_access_time = os_time_get_nano();
    index_entry.cache_db_file_offset = ftell(db->cache.file);
 
-   hash_entry = ralloc(db->mem_ctx, struct mesa_index_db_hash_entry);
+   hash_entry = rzalloc(db->mem_ctx, struct mesa_index_db_hash_entry);
    if (!hash_entry)
       goto fail;
 
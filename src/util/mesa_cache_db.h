@@ -15,7 +15,9 @@
 #include <stdio.h>
 
 #include "detect_os.h"
+#include "rwlock.h"
 #include "simple_mtx.h"
+#include "u_dynarray.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,6 +39,16 @@ struct mesa_cache_db {
    void *mem_ctx;
    uint64_t uuid;
    bool alive;
+
+   /* Lookups that don't take the file lock, see mesa_db_read_entry_unlocked().
+    * index_lock is held for writing along with the file lock.
+    */
+   struct u_rwlock index_lock;
+   int cache_fd;
+
+   /* Index entries whose new last access time still has to be written */
+   simple_mtx_t access_mtx;
+   struct util_dynarray pending_access;
 };
 
 #if DETECT_OS_WINDOWS == 0
@@ -0,0 +1,102 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "u_compile_event.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "c11/threads.h"
+#include "util/os_time.h"
+#include "util/perf/cpu_trace.h"
+#include "util/simple_mtx.h"
+#include "util/u_atomic.h"
+#include "util/u_call_once.h"
+#include "util/u_debug.h"
+
+static const char *const event_names[UTIL_COMPILE_EVENT_COUNT] = {
+   [UTIL_COMPILE_EVENT_CACHE_LOOKUP] = "compile: cache lookup",
+   [UTIL_COMPILE_EVENT_NIR] = "compile: nir",
+   [UTIL_COMPILE_EVENT_BACKEND] = "compile: backend",
+};
+
+static const char *const event_csv_names[UTIL_COMPILE_EVENT_COUNT] = {
+   [UTIL_COMPILE_EVENT_CACHE_LOOKUP] = "cache_lookup",
+   [UTIL_COMPILE_EVENT_NIR] = "nir",
+   [UTIL_COMPILE_EVENT_BACKEND] = "backend",
+};
+
+static struct {
+   util_once_flag once;
+   simple_mtx_t lock;
+   FILE *file;
+   uint32_t next_thread;
+} compile_events = { UTIL_ONCE_FLAG_INIT, SIMPLE_MTX_INITIALIZER };
+
+static thread_local uint32_t thread_idx;
+
+DEBUG_GET_ONCE_OPTION(compile_events, "MESA_COMPILE_EVENTS", NULL)
+
+static void
+compile_events_fini(void)
+{
+   fclose(compile_events.file);
+   compile_events.file = NULL;
+}
+
+static void
+compile_events_init_once(void)
+{
+   const char *filename = debug_get_option_compile_events();
+   if (!filename || !__normal_user())
+      return;
+
+   FILE *file = fopen(filename, "w");
+   if (!file)
+      return;
+
+   fprintf(file, "type,label,thread,start_ns,duration_ns,hit\n");
+   compile_events.file = file;
+   atexit(compile_events_fini);
+}
+
+void
+util_compile_event_begin(struct util_compile_event *evt,
+                         enum util_compile_event_type type,
+                         const char *label)
+{
+   util_call_once(&compile_events.once, compile_events_init_once);
+
+   evt->type = type;
+   evt->label = label;
+   evt->hit = false;
+   evt->start_ns = compile_events.file ? os_time_get_nano() : 0;
+
+   _MESA_TRACE_BEGIN(event_names[type]);
+   _MESA_GPUVIS_TRACE_BEGIN(event_names[type]);
+   evt->trace_scope = _MESA_SYSPROF_TRACE_BEGIN(event_names[type]);
+}
+
+void
+util_compile_event_end(struct util_compile_event *evt)
+{
+   _MESA_GPUVIS_TRACE_END();
+   _MESA_TRACE_END();
+   _MESA_SYSPROF_TRACE_END(&evt->trace_scope);
+
+   if (!compile_events.file)
+      return;
+
+   const int64_t duration_ns = os_time_get_nano() - evt->start_ns;
+
+   if (!thread_idx)
+      thread_idx = p_atomic_inc_return(&compile_events.next_thread);
+
+   simple_mtx_lock(&compile_events.lock);
+   fprintf(compile_events.file, "%s,%s,%u,%" PRId64 ",%" PRId64 ",%u\n",
+           event_csv_names[evt->type], evt->label ? evt->label : "",
+           thread_idx - 1, evt->start_ns, duration_ns, evt->hit);
+   simple_mtx_unlock(&compile_events.lock);
+}
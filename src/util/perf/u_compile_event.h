@@ -0,0 +1,64 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef U_COMPILE_EVENT_H
+#define U_COMPILE_EVENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Driver independent timing of the steps of shader compilation.
+ *
+ * Callers bracket a step with util_compile_event_begin()/end().  Every
+ * event shows up as a CPU trace slice (perfetto, gpuvis, sysprof), and when
+ * MESA_COMPILE_EVENTS is set to a file name, also as one CSV line in that
+ * file:
+ *
+ *    type,label,thread,start_ns,duration_ns,hit
+ *
+ * thread is a small per-process index of the thread that did the work, so
+ * that compiles running in parallel can be told apart.  hit is only
+ * meaningful for cache lookups.
+ */
+
+enum util_compile_event_type {
+   /* Looking a shader or pipeline up in a cache */
+   UTIL_COMPILE_EVENT_CACHE_LOOKUP,
+   /* Getting the shader to NIR and running the common lowering on it */
+   UTIL_COMPILE_EVENT_NIR,
+   /* Compiling NIR to a binary in the driver's backend */
+   UTIL_COMPILE_EVENT_BACKEND,
+   UTIL_COMPILE_EVENT_COUNT,
+};
+
+struct util_compile_event {
+   enum util_compile_event_type type;
+   /* Static string, typically the shader stage */
+   const char *label;
+   int64_t start_ns;
+   /* Set by the caller before util_compile_event_end() for cache lookups */
+   bool hit;
+
+   void *trace_scope;
+};
+
+void
+util_compile_event_begin(struct util_compile_event *evt,
+                         enum util_compile_event_type type,
+                         const char *label);
+
+void
+util_compile_event_end(struct util_compile_event *evt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U_COMPILE_EVENT_H */
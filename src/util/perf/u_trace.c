@@ -26,6 +26,7 @@
 #include <inttypes.h>
 
 #include "util/list.h"
+#include "util/memstream.h"
 #include "util/u_call_once.h"
 #include "util/u_debug.h"
 #include "util/u_vector.h"
@@ -118,6 +119,30 @@ struct u_trace_chunk {
    bool free_flush_data;
 };
 
+/**
+ * Flight recorder for U_TRACE_TYPE_RING.  Each frame is printed to its own
+ * memstream, and the last num_frames frames are kept around.  Once a frame
+ * spans more than threshold_ns of GPU time, the retained frames (including
+ * the long one) are written to the trace file, oldest first, and dropped.
+ */
+struct u_trace_ring {
+   FILE *file;
+   uint64_t threshold_ns;
+
+   struct u_memstream stream;
+   bool frame_open;
+   uint64_t frame_first_ns;
+   uint64_t frame_last_ns;
+
+   unsigned num_frames;
+   unsigned head;
+   unsigned count;
+   struct {
+      char *buf;
+      size_t size;
+   } frames[];
+};
+
 struct u_trace_printer {
    void (*start)(struct u_trace_context *utctx);
    void (*end)(struct u_trace_context *utctx);
@@ -446,10 +471,13 @@ static const struct debug_named_value config_control[] = {
 #endif
    { "markers", U_TRACE_TYPE_MARKERS, "Enable marker trace" },
    { "indirects", U_TRACE_TYPE_INDIRECTS, "Enable indirect data capture" },
+   { "ring", U_TRACE_TYPE_RING, "Only print the frames leading up to a long frame" },
    DEBUG_NAMED_VALUE_END
 };
 
 DEBUG_GET_ONCE_OPTION(trace_file, "MESA_GPU_TRACEFILE", NULL)
+DEBUG_GET_ONCE_NUM_OPTION(ring_frames, "MESA_GPU_TRACE_RING_FRAMES", 8)
+DEBUG_GET_ONCE_NUM_OPTION(ring_threshold_ms, "MESA_GPU_TRACE_RING_THRESHOLD_MS", 50)
 
 static void
 trace_file_fini(void)
@@ -493,6 +521,82 @@ u_trace_is_enabled(enum u_trace_type type)
    return (u_trace_state.enabled_traces & type) == type;
 }
 
+static void
+ring_init(struct u_trace_context *utctx)
+{
+   const unsigned num_frames = MAX2(debug_get_option_ring_frames(), 1);
+   struct u_trace_ring *ring =
+      calloc(1, sizeof(*ring) + num_frames * sizeof(ring->frames[0]));
+   if (!ring)
+      return;
+
+   ring->file = utctx->out;
+   ring->threshold_ns = debug_get_option_ring_threshold_ms() * 1000000ull;
+   ring->num_frames = num_frames;
+   utctx->ring = ring;
+}
+
+static void
+ring_fini(struct u_trace_context *utctx)
+{
+   struct u_trace_ring *ring = utctx->ring;
+
+   for (unsigned i = 0; i < ring->num_frames; i++)
+      free(ring->frames[i].buf);
+   free(ring);
+   utctx->ring = NULL;
+}
+
+static void
+ring_start_frame(struct u_trace_context *utctx)
+{
+   struct u_trace_ring *ring = utctx->ring;
+
+   free(ring->frames[ring->head].buf);
+   ring->frames[ring->head].buf = NULL;
+   ring->frames[ring->head].size = 0;
+
+   ring->frame_first_ns = 0;
+   ring->frame_last_ns = 0;
+
+   /* If we can't get a stream, the frame is simply not printed. */
+   ring->frame_open = u_memstream_open(&ring->stream,
+                                        &ring->frames[ring->head].buf,
+                                        &ring->frames[ring->head].size);
+   utctx->out = ring->frame_open ? u_memstream_get(&ring->stream) : NULL;
+}
+
+static void
+ring_end_frame(struct u_trace_context *utctx)
+{
+   struct u_trace_ring *ring = utctx->ring;
+
+   if (!ring->frame_open)
+      return;
+
+   u_memstream_close(&ring->stream);
+   ring->frame_open = false;
+   utctx->out = ring->file;
+
+   ring->head = (ring->head + 1) % ring->num_frames;
+   ring->count = MIN2(ring->count + 1, ring->num_frames);
+
+   if (ring->frame_last_ns - ring->frame_first_ns < ring->threshold_ns)
+      return;
+
+   for (unsigned i = 0; i < ring->count; i++) {
+      unsigned idx =
+         (ring->head + ring->num_frames - ring->count + i) % ring->num_frames;
+
+      fwrite(ring->frames[idx].buf, 1, ring->frames[idx].size, ring->file);
+      free(ring->frames[idx].buf);
+      ring->frames[idx].buf = NULL;
+      ring->frames[idx].size = 0;
+   }
+   ring->count = 0;
+   fflush(ring->file);
+}
+
 static void
 queue_init(struct u_trace_context *utctx)
 {
@@ -509,6 +613,31 @@ queue_init(struct u_trace_context *utctx)
       utctx->out = NULL;
 }
 
+static void
+start_of_frame(struct u_trace_context *utctx)
+{
+   if (utctx->ring)
+      ring_start_frame(utctx);
+
+   if (utctx->out) {
+      utctx->out_printer->start_of_frame(utctx);
+   }
+}
+
+static void
+end_of_frame(struct u_trace_context *utctx)
+{
+   if (utctx->ring && !utctx->ring->frame_open)
+      return;
+
+   if (utctx->out) {
+      utctx->out_printer->end_of_frame(utctx);
+   }
+
+   if (utctx->ring)
+      ring_end_frame(utctx);
+}
+
 void
 u_trace_context_init(struct u_trace_context *utctx,
                      void *pctx,
@@ -542,6 +671,7 @@ u_trace_context_init(struct u_trace_context *utctx,
    utctx->batch_nr = 0;
    utctx->event_nr = 0;
    utctx->start_of_frame = true;
+   utctx->ring = NULL;
 
    utctx->dummy_indirect_data = calloc(1, max_indirect_size_bytes);
 
@@ -557,6 +687,13 @@ u_trace_context_init(struct u_trace_context *utctx,
       } else {
          utctx->out_printer = &txt_printer;
       }
+
+      /* The JSON output is a single array across all frames, it can't be
+       * cut into pieces.
+       */
+      if ((utctx->enabled_traces & U_TRACE_TYPE_RING) &&
+          !(utctx->enabled_traces & U_TRACE_TYPE_JSON))
+         ring_init(utctx);
    } else {
       utctx->out = NULL;
       utctx->out_printer = NULL;
@@ -593,22 +730,26 @@ u_trace_context_fini(struct u_trace_context *utctx)
    simple_mtx_unlock(&ctx_list_mutex);
 #endif
 
+   /* Let the queue print what it still has before ending the output. */
+   if (utctx->queue.jobs) {
+      util_queue_finish(&utctx->queue);
+      util_queue_destroy(&utctx->queue);
+      free_chunks(&utctx->flushed_trace_chunks);
+   }
+
    if (utctx->out) {
       if (utctx->batch_nr > 0) {
-         utctx->out_printer->end_of_frame(utctx);
+         end_of_frame(utctx);
       }
 
       utctx->out_printer->end(utctx);
       fflush(utctx->out);
    }
 
-   free (utctx->dummy_indirect_data);
+   if (utctx->ring)
+      ring_fini(utctx);
 
-   if (!utctx->queue.jobs)
-      return;
-   util_queue_finish(&utctx->queue);
-   util_queue_destroy(&utctx->queue);
-   free_chunks(&utctx->flushed_trace_chunks);
+   free (utctx->dummy_indirect_data);
 }
 
 #ifdef HAVE_PERFETTO
@@ -654,9 +795,7 @@ process_chunk(void *job, void *gdata, int thread_index)
 
    if (chunk->frame_nr != U_TRACE_FRAME_UNKNOWN &&
        chunk->frame_nr != utctx->frame_nr) {
-      if (utctx->out) {
-         utctx->out_printer->end_of_frame(utctx);
-      }
+      end_of_frame(utctx);
       utctx->frame_nr = chunk->frame_nr;
       utctx->start_of_frame = true;
    }
@@ -664,9 +803,7 @@ process_chunk(void *job, void *gdata, int thread_index)
    if (utctx->start_of_frame) {
       utctx->start_of_frame = false;
       utctx->batch_nr = 0;
-      if (utctx->out) {
-         utctx->out_printer->start_of_frame(utctx);
-      }
+      start_of_frame(utctx);
    }
 
    /* For first chunk of batch, accumulated times will be zerod: */
@@ -715,6 +852,12 @@ process_chunk(void *job, void *gdata, int thread_index)
          }
       }
 
+      if (utctx->ring) {
+         if (!utctx->ring->frame_first_ns)
+            utctx->ring->frame_first_ns = ns;
+         utctx->ring->frame_last_ns = MAX2(utctx->ring->frame_last_ns, ns);
+      }
+
       if (utctx->out) {
          utctx->out_printer->event(utctx, chunk, evt, ns, delta, indirect_data);
       }
@@ -741,9 +884,7 @@ process_chunk(void *job, void *gdata, int thread_index)
    }
 
    if (chunk->eof) {
-      if (utctx->out) {
-         utctx->out_printer->end_of_frame(utctx);
-      }
+      end_of_frame(utctx);
       utctx->frame_nr++;
       utctx->start_of_frame = true;
    }
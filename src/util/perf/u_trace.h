@@ -72,6 +72,7 @@ struct u_trace_context;
 struct u_trace;
 struct u_trace_chunk;
 struct u_trace_printer;
+struct u_trace_ring;
 
 /**
  * Special reserved value to indicate that no timestamp was captured,
@@ -189,6 +190,7 @@ enum u_trace_type {
    U_TRACE_TYPE_MARKERS = 1u << 4,
    U_TRACE_TYPE_INDIRECTS = 1u << 5,
    U_TRACE_TYPE_CSV = 1u << 6,
+   U_TRACE_TYPE_RING = 1u << 7,
 
    U_TRACE_TYPE_PRINT_CSV = U_TRACE_TYPE_PRINT | U_TRACE_TYPE_CSV,
    U_TRACE_TYPE_PRINT_JSON = U_TRACE_TYPE_PRINT | U_TRACE_TYPE_JSON,
@@ -230,6 +232,11 @@ struct u_trace_context {
    FILE *out;
    struct u_trace_printer *out_printer;
 
+   /* With U_TRACE_TYPE_RING, the printer output of the last few frames is
+    * kept in memory and only written out when a frame takes too long.
+    */
+   struct u_trace_ring *ring;
+
    /* Once u_trace_flush() is called u_trace_chunk's are queued up to
     * render tracepoints on a queue.  The per-chunk queue jobs block until
     * timestamps are available.
@@ -664,6 +664,9 @@ struct gc_ctx {
 
    uint8_t current_gen;
    void *rubbish;
+
+   /* Leave freed objects to the next sweep, see gc_set_defer_free(). */
+   bool defer_free;
 };
 
 static gc_block_header *
@@ -905,12 +908,32 @@ gc_free(void *ptr)
       return;
 
    gc_block_header *header = get_gc_header(ptr);
-   header->flags &= ~IS_USED;
 
-   if (header->bucket < NUM_FREELIST_BUCKETS)
+   if (header->bucket < NUM_FREELIST_BUCKETS) {
+      /* A freed object is unreachable, so simply leaving it as used makes
+       * the next sweep reclaim it along with the other dead objects.
+       */
+      if (get_gc_slab(header)->ctx->defer_free)
+         return;
+
+      header->flags &= ~IS_USED;
       free_from_slab(header, true);
-   else
+   } else {
+      header->flags &= ~IS_USED;
       ralloc_free(header);
+   }
+}
+
+void
+gc_set_defer_free(gc_ctx *ctx, bool defer)
+{
+   ctx->defer_free = defer;
+}
+
+bool
+gc_get_defer_free(const gc_ctx *ctx)
+{
+   return ctx->defer_free;
 }
 
 gc_ctx *gc_get_context(void *ptr)
@@ -518,6 +518,17 @@ void *gc_zalloc_size(gc_ctx *ctx, size_t size, size_t alignment) MALLOCLIKE;
 void gc_free(void *ptr);
 gc_ctx *gc_get_context(void *ptr);
 
+/**
+ * Bump allocation mode: gc_free() no longer returns small objects to their
+ * slab's freelist but leaves them for the next gc_sweep_end(), which
+ * reclaims them like any other object that wasn't marked live.  Allocation
+ * then keeps appending to the newest slab, so objects allocated together
+ * stay together in memory, and freeing costs nothing.  The price is that
+ * memory only gets reused after a sweep.
+ */
+void gc_set_defer_free(gc_ctx *ctx, bool defer);
+bool gc_get_defer_free(const gc_ctx *ctx);
+
 void gc_sweep_start(gc_ctx *ctx);
 void gc_mark_live(gc_ctx *ctx, const void *mem);
 void gc_sweep_end(gc_ctx *ctx);
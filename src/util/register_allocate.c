@@ -692,6 +692,7 @@ ra_reset_node_interference(struct ra_graph *g, unsigned int n)
       ra_node_remove_adjacency(g, adj->elems[i], n);
 
    adj->size = 0;
+   g->nodes[n].q_total = 0;
 }
 
 static void
@@ -1057,23 +1058,19 @@ ra_set_node_reg(struct ra_graph *g, unsigned int n, unsigned int reg)
 static float
 ra_get_spill_benefit(struct ra_graph *g, unsigned int n)
 {
-   float benefit = 0;
    int n_class = g->nodes[n].class;
 
    /* Define the benefit of eliminating an interference between n, n2
     * through spilling as q(C, B) / p(C).  This is similar to the
     * "count number of edges" approach of traditional graph coloring,
     * but takes classes into account.
+    *
+    * Summed over all neighbors, that is the q_total of the node, which is
+    * kept up to date as interferences are added and reset.  This saves
+    * walking every adjacency list each time a driver looks for a node to
+    * spill.
     */
-   struct ra_list *adj = &g->nodes[n].adjacency;
-   for (unsigned i = 0; i < adj->size; i++) {
-      unsigned int n2 = adj->elems[i];
-      unsigned int n2_class = g->nodes[n2].class;
-      benefit += ((float)g->regs->classes[n_class]->q[n2_class] /
-                  g->regs->classes[n_class]->p);
-   }
-
-   return benefit;
+   return (float)g->nodes[n].q_total / g->regs->classes[n_class]->p;
 }
 
 float
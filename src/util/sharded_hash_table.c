@@ -0,0 +1,217 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "sharded_hash_table.h"
+
+static inline struct util_sharded_hash_table_shard *
+get_shard(struct util_sharded_hash_table *ht, uint32_t hash)
+{
+   /* The shard tables use the hash modulo their (prime) size, so pick the
+    * shard from the top bits of a multiplicative hash to keep the two
+    * independent.
+    */
+   const uint32_t idx = (hash * 0x9e3779b1u) >>
+                        (32 - UTIL_SHARDED_HASH_TABLE_SHARD_BITS);
+   return &ht->shards[idx];
+}
+
+static inline void
+shard_lock(struct util_sharded_hash_table_shard *shard)
+{
+   if (!simple_mtx_trylock(&shard->lock)) {
+      simple_mtx_lock(&shard->lock);
+      shard->contended++;
+   }
+   shard->acquisitions++;
+}
+
+static inline void
+shard_unlock(struct util_sharded_hash_table_shard *shard)
+{
+   simple_mtx_unlock(&shard->lock);
+}
+
+void
+util_sharded_hash_table_init(struct util_sharded_hash_table *ht,
+                             uint32_t (*key_hash_function)(const void *key),
+                             bool (*key_equals_function)(const void *a,
+                                                         const void *b))
+{
+   ht->key_hash_function = key_hash_function;
+
+   for (unsigned i = 0; i < UTIL_SHARDED_HASH_TABLE_SHARDS; i++) {
+      struct util_sharded_hash_table_shard *shard = &ht->shards[i];
+
+      simple_mtx_init(&shard->lock, mtx_plain);
+      shard->acquisitions = 0;
+      shard->contended = 0;
+      _mesa_hash_table_init(&shard->table, NULL, key_hash_function,
+                            key_equals_function);
+   }
+}
+
+/**
+ * Frees the storage of the table.  No other thread may still use it.
+ *
+ * If delete_function is passed, it gets called on each entry present.
+ */
+void
+util_sharded_hash_table_fini(struct util_sharded_hash_table *ht,
+                             void (*delete_function)(struct hash_entry *entry))
+{
+   for (unsigned i = 0; i < UTIL_SHARDED_HASH_TABLE_SHARDS; i++) {
+      struct util_sharded_hash_table_shard *shard = &ht->shards[i];
+
+      _mesa_hash_table_fini(&shard->table, delete_function);
+      simple_mtx_destroy(&shard->lock);
+   }
+}
+
+/**
+ * Returns the data of the entry with the given key, or NULL.
+ */
+void *
+util_sharded_hash_table_search(struct util_sharded_hash_table *ht,
+                               const void *key)
+{
+   const uint32_t hash = ht->key_hash_function(key);
+   struct util_sharded_hash_table_shard *shard = get_shard(ht, hash);
+
+   shard_lock(shard);
+   struct hash_entry *entry =
+      _mesa_hash_table_search_pre_hashed(&shard->table, hash, key);
+   void *data = entry ? entry->data : NULL;
+   shard_unlock(shard);
+
+   return data;
+}
+
+/**
+ * Inserts the key, replacing the data of an existing entry.
+ */
+void
+util_sharded_hash_table_insert(struct util_sharded_hash_table *ht,
+                               const void *key, void *data)
+{
+   const uint32_t hash = ht->key_hash_function(key);
+   struct util_sharded_hash_table_shard *shard = get_shard(ht, hash);
+
+   shard_lock(shard);
+   _mesa_hash_table_insert_pre_hashed(&shard->table, hash, key, data);
+   shard_unlock(shard);
+}
+
+/**
+ * Returns the data of the entry with the given key if there is one,
+ * otherwise inserts the key with the given data and returns that.
+ *
+ * This is the usual pattern for caches, where several threads might race
+ * to create the same object: whoever doesn't get their data back knows to
+ * throw away their copy.
+ */
+void *
+util_sharded_hash_table_search_or_insert(struct util_sharded_hash_table *ht,
+                                         const void *key, void *data)
+{
+   const uint32_t hash = ht->key_hash_function(key);
+   struct util_sharded_hash_table_shard *shard = get_shard(ht, hash);
+
+   shard_lock(shard);
+   struct hash_entry *entry =
+      _mesa_hash_table_search_pre_hashed(&shard->table, hash, key);
+   if (entry)
+      data = entry->data;
+   else
+      _mesa_hash_table_insert_pre_hashed(&shard->table, hash, key, data);
+   shard_unlock(shard);
+
+   return data;
+}
+
+/**
+ * Removes the entry with the given key, and returns its data, or NULL if
+ * there was none.
+ */
+void *
+util_sharded_hash_table_remove(struct util_sharded_hash_table *ht,
+                               const void *key)
+{
+   const uint32_t hash = ht->key_hash_function(key);
+   struct util_sharded_hash_table_shard *shard = get_shard(ht, hash);
+   void *data = NULL;
+
+   shard_lock(shard);
+   struct hash_entry *entry =
+      _mesa_hash_table_search_pre_hashed(&shard->table, hash, key);
+   if (entry) {
+      data = entry->data;
+      _mesa_hash_table_remove(&shard->table, entry);
+   }
+   shard_unlock(shard);
+
+   return data;
+}
+
+/**
+ * Returns the number of entries.  With other threads modifying the table
+ * this is only a snapshot, as the shards are counted one after the other.
+ */
+uint32_t
+util_sharded_hash_table_num_entries(struct util_sharded_hash_table *ht)
+{
+   uint32_t entries = 0;
+
+   for (unsigned i = 0; i < UTIL_SHARDED_HASH_TABLE_SHARDS; i++) {
+      struct util_sharded_hash_table_shard *shard = &ht->shards[i];
+
+      shard_lock(shard);
+      entries += _mesa_hash_table_num_entries(&shard->table);
+      shard_unlock(shard);
+   }
+
+   return entries;
+}
+
+/**
+ * Calls the callback on every entry, with the lock of its shard held.  The
+ * callback must not call back into the table.
+ */
+void
+util_sharded_hash_table_foreach(struct util_sharded_hash_table *ht,
+                                void (*callback)(const void *key,
+                                                 void *data,
+                                                 void *closure),
+                                void *closure)
+{
+   for (unsigned i = 0; i < UTIL_SHARDED_HASH_TABLE_SHARDS; i++) {
+      struct util_sharded_hash_table_shard *shard = &ht->shards[i];
+
+      shard_lock(shard);
+      hash_table_call_foreach(&shard->table, callback, closure);
+      shard_unlock(shard);
+   }
+}
+
+/**
+ * Sums up the lock statistics of all shards, for debugging contention.
+ */
+void
+util_sharded_hash_table_get_stats(struct util_sharded_hash_table *ht,
+                                  struct util_sharded_hash_table_stats *stats)
+{
+   memset(stats, 0, sizeof(*stats));
+
+   for (unsigned i = 0; i < UTIL_SHARDED_HASH_TABLE_SHARDS; i++) {
+      struct util_sharded_hash_table_shard *shard = &ht->shards[i];
+
+      simple_mtx_lock(&shard->lock);
+      const uint32_t entries = _mesa_hash_table_num_entries(&shard->table);
+      stats->acquisitions += shard->acquisitions;
+      stats->contended += shard->contended;
+      stats->entries += entries;
+      stats->max_shard_entries = MAX2(stats->max_shard_entries, entries);
+      simple_mtx_unlock(&shard->lock);
+   }
+}
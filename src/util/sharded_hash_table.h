@@ -0,0 +1,150 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef _SHARDED_HASH_TABLE_H
+#define _SHARDED_HASH_TABLE_H
+
+#include "hash_table.h"
+#include "simple_mtx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UTIL_SHARDED_HASH_TABLE_SHARD_BITS 4
+#define UTIL_SHARDED_HASH_TABLE_SHARDS (1 << UTIL_SHARDED_HASH_TABLE_SHARD_BITS)
+
+struct util_sharded_hash_table_shard {
+   simple_mtx_t lock;
+
+   /* Only updated with the lock held */
+   uint64_t acquisitions;
+   uint64_t contended;  /**< acquisitions that had to wait for the lock */
+
+   struct hash_table table;
+};
+
+/**
+ * Thread-safe hash table, for caches shared between threads that would
+ * otherwise serialize on a single mutex around a struct hash_table.
+ *
+ * Keys are spread by hash over UTIL_SHARDED_HASH_TABLE_SHARDS tables, each
+ * with its own lock, so threads only contend when they hit the same shard.
+ * Entries are never handed out since they could move as soon as the shard
+ * is unlocked, the functions return the data pointer instead.
+ */
+struct util_sharded_hash_table {
+   uint32_t (*key_hash_function)(const void *key);
+   struct util_sharded_hash_table_shard shards[UTIL_SHARDED_HASH_TABLE_SHARDS];
+};
+
+struct util_sharded_hash_table_stats {
+   uint64_t acquisitions;
+   uint64_t contended;
+   uint32_t entries;
+   uint32_t max_shard_entries;
+};
+
+void
+util_sharded_hash_table_init(struct util_sharded_hash_table *ht,
+                             uint32_t (*key_hash_function)(const void *key),
+                             bool (*key_equals_function)(const void *a,
+                                                         const void *b));
+
+void
+util_sharded_hash_table_fini(struct util_sharded_hash_table *ht,
+                             void (*delete_function)(struct hash_entry *entry));
+
+void *
+util_sharded_hash_table_search(struct util_sharded_hash_table *ht,
+                               const void *key);
+
+void
+util_sharded_hash_table_insert(struct util_sharded_hash_table *ht,
+                               const void *key, void *data);
+
+void *
+util_sharded_hash_table_search_or_insert(struct util_sharded_hash_table *ht,
+                                         const void *key, void *data);
+
+void *
+util_sharded_hash_table_remove(struct util_sharded_hash_table *ht,
+                               const void *key);
+
+uint32_t
+util_sharded_hash_table_num_entries(struct util_sharded_hash_table *ht);
+
+void
+util_sharded_hash_table_foreach(struct util_sharded_hash_table *ht,
+                                void (*callback)(const void *key,
+                                                 void *data,
+                                                 void *closure),
+                                void *closure);
+
+void
+util_sharded_hash_table_get_stats(struct util_sharded_hash_table *ht,
+                                  struct util_sharded_hash_table_stats *stats);
+
+/**
+ * Thread-safe set, on top of struct util_sharded_hash_table.
+ */
+struct util_sharded_set {
+   struct util_sharded_hash_table ht;
+};
+
+static inline void
+util_sharded_set_init(struct util_sharded_set *set,
+                      uint32_t (*key_hash_function)(const void *key),
+                      bool (*key_equals_function)(const void *a,
+                                                  const void *b))
+{
+   util_sharded_hash_table_init(&set->ht, key_hash_function,
+                                key_equals_function);
+}
+
+static inline void
+util_sharded_set_fini(struct util_sharded_set *set,
+                      void (*delete_function)(struct hash_entry *entry))
+{
+   util_sharded_hash_table_fini(&set->ht, delete_function);
+}
+
+/**
+ * Adds the key unless an equal one is already in the set, and returns the
+ * key that is in the set afterwards.
+ */
+static inline const void *
+util_sharded_set_add(struct util_sharded_set *set, const void *key)
+{
+   return util_sharded_hash_table_search_or_insert(&set->ht, key,
+                                                   (void *)key);
+}
+
+/**
+ * Returns the key of the set equal to the given one, or NULL.
+ */
+static inline const void *
+util_sharded_set_search(struct util_sharded_set *set, const void *key)
+{
+   return util_sharded_hash_table_search(&set->ht, key);
+}
+
+static inline const void *
+util_sharded_set_remove(struct util_sharded_set *set, const void *key)
+{
+   return util_sharded_hash_table_remove(&set->ht, key);
+}
+
+static inline uint32_t
+util_sharded_set_num_entries(struct util_sharded_set *set)
+{
+   return util_sharded_hash_table_num_entries(&set->ht);
+}
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+#endif /* _SHARDED_HASH_TABLE_H */
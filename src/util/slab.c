@@ -28,6 +28,11 @@
 #include <stdbool.h>
 #include <string.h>
 
+/* How many elements freed in a pool other than their own are collected
+ * before they are handed back to their owners.
+ */
+#define SLAB_REMOTE_BATCH 32
+
 #define SLAB_MAGIC_ALLOCATED 0xcafe4321
 #define SLAB_MAGIC_FREE 0x7ee01234
 
@@ -95,6 +100,45 @@ slab_free_orphaned(struct slab_element_header *elt)
       free(page);
 }
 
+/* Hand the elements that were freed in this pool, but belong to other
+ * pools, back to their owners.
+ */
+static void
+slab_flush_remote(struct slab_child_pool *pool)
+{
+   struct slab_element_header *orphaned = NULL;
+
+   if (!pool->remote)
+      return;
+
+   simple_mtx_lock(&pool->parent->mutex);
+   while (pool->remote) {
+      struct slab_element_header *elt = pool->remote;
+      pool->remote = elt->next;
+
+      /* The owner may have been destroyed since the element was freed. */
+      intptr_t owner_int = p_atomic_read(&elt->owner);
+
+      if (!(owner_int & 1)) {
+         struct slab_child_pool *owner = (struct slab_child_pool *)owner_int;
+         elt->next = owner->migrated;
+         owner->migrated = elt;
+      } else {
+         elt->next = orphaned;
+         orphaned = elt;
+      }
+   }
+   simple_mtx_unlock(&pool->parent->mutex);
+
+   pool->num_remote = 0;
+
+   while (orphaned) {
+      struct slab_element_header *elt = orphaned;
+      orphaned = elt->next;
+      slab_free_orphaned(elt);
+   }
+}
+
 /**
  * Create a parent pool for the allocation of same-sized objects.
  *
@@ -129,6 +173,8 @@ void slab_create_child(struct slab_child_pool *pool,
    pool->pages = NULL;
    pool->free = NULL;
    pool->migrated = NULL;
+   pool->remote = NULL;
+   pool->num_remote = 0;
 }
 
 /**
@@ -142,6 +188,8 @@ void slab_destroy_child(struct slab_child_pool *pool)
    if (!pool->parent)
       return; /* the slab probably wasn't even created */
 
+   slab_flush_remote(pool);
+
    simple_mtx_lock(&pool->parent->mutex);
 
    while (pool->pages) {
@@ -209,6 +257,9 @@ slab_alloc(struct slab_child_pool *pool)
    struct slab_element_header *elt;
 
    if (!pool->free) {
+      /* Elements of other pools might be what they are waiting for. */
+      slab_flush_remote(pool);
+
       /* First, collect elements that belong to us but were freed from a
        * different child pool.
        */
@@ -250,7 +301,9 @@ slab_zalloc(struct slab_child_pool *pool)
  *
  * Freeing an object in a different child pool from the one where it was
  * allocated is allowed, as long the pool belong to the same parent. No
- * additional locking is required in this case.
+ * additional locking is required in this case. Such objects only become
+ * available to their own pool after a batch of them was collected, or when
+ * this pool runs out of elements or is destroyed.
  */
 void slab_free(struct slab_child_pool *pool, void *ptr)
 {
@@ -260,7 +313,9 @@ void slab_free(struct slab_child_pool *pool, void *ptr)
    CHECK_MAGIC(elt, SLAB_MAGIC_ALLOCATED);
    SET_MAGIC(elt, SLAB_MAGIC_FREE);
 
-   if (p_atomic_read(&elt->owner) == (intptr_t)pool) {
+   owner_int = p_atomic_read(&elt->owner);
+
+   if (owner_int == (intptr_t)pool) {
       /* This is the simple case: The caller guarantees that we can safely
        * access the free list.
        */
@@ -269,27 +324,25 @@ void slab_free(struct slab_child_pool *pool, void *ptr)
       return;
    }
 
-   /* The slow case: migration or an orphaned page. */
-   if (pool->parent)
-      simple_mtx_lock(&pool->parent->mutex);
-
-   /* Note: we _must_ re-read elt->owner here because the owning child pool
-    * may have been destroyed by another thread in the meantime.
-    */
-   owner_int = p_atomic_read(&elt->owner);
-
-   if (!(owner_int & 1)) {
-      struct slab_child_pool *owner = (struct slab_child_pool *)owner_int;
-      elt->next = owner->migrated;
-      owner->migrated = elt;
-      if (pool->parent)
-         simple_mtx_unlock(&pool->parent->mutex);
-   } else {
-      if (pool->parent)
-         simple_mtx_unlock(&pool->parent->mutex);
-
+   /* Pages never stop being orphaned, so this needs no lock. */
+   if (owner_int & 1) {
       slab_free_orphaned(elt);
+      return;
    }
+
+   /* Migration: queue the element up to be handed back with others. */
+   if (pool->parent) {
+      elt->next = pool->remote;
+      pool->remote = elt;
+      if (++pool->num_remote >= SLAB_REMOTE_BATCH)
+         slab_flush_remote(pool);
+      return;
+   }
+
+   /* The pool was destroyed, so there is no mutex that could be taken. */
+   struct slab_child_pool *owner = (struct slab_child_pool *)owner_int;
+   elt->next = owner->migrated;
+   owner->migrated = elt;
 }
 
 /**
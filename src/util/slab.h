@@ -72,6 +72,13 @@ struct slab_child_pool {
     * This list is protected by the parent mutex.
     */
    struct slab_element_header *migrated;
+
+   /* Elements owned by other pools that were freed with this pool as the
+    * argument to slab_free.  They are handed back to their owners in batches
+    * to take the parent mutex once per batch instead of once per element.
+    */
+   struct slab_element_header *remote;
+   unsigned num_remote;
 };
 
 void slab_create_parent(struct slab_parent_pool *parent,
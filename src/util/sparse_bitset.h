@@ -267,6 +267,30 @@ u_sparse_bitset_merge(struct u_sparse_bitset *dst, struct u_sparse_bitset *src)
    return changed;
 }
 
+/* Clears all bits of dst that are set in src */
+static inline void
+u_sparse_bitset_subtract(struct u_sparse_bitset *dst,
+                         struct u_sparse_bitset *src)
+{
+   assert(dst->capacity == src->capacity);
+
+   if (_u_sparse_bitset_is_small(src)) {
+      for (unsigned i = 0; i < BITSET_WORDS(src->capacity); i++)
+         dst->vals[i] &= ~src->vals[i];
+      return;
+   }
+
+   rb_tree_foreach(struct u_sparse_bitset_node, node, &src->tree, node) {
+      struct u_sparse_bitset_node *dst_node =
+         _u_sparse_bitset_get_node(dst, node->offset);
+
+      if (dst_node) {
+         for (unsigned i = 0; i < ARRAY_SIZE(node->vals); i++)
+            dst_node->vals[i] &= ~node->vals[i];
+      }
+   }
+}
+
 static inline unsigned
 u_sparse_bitset_count(struct u_sparse_bitset *s)
 {
@@ -0,0 +1,43 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "util/u_cpu_detect.h"
+#include <immintrin.h>
+
+#ifndef USE_AVX2
+#error "Compiler doesn't support AVX2!"
+#endif
+
+size_t util_streaming_load_memcpy_avx2(char *restrict dst, char *restrict src,
+                                       size_t len);
+
+/* Copies the 64-byte blocks of a 32-byte aligned src to a 32-byte aligned
+ * dst with 32-byte non-temporal loads, and returns the number of bytes
+ * copied. The caller copies the tail.
+ */
+size_t
+util_streaming_load_memcpy_avx2(char *restrict dst, char *restrict src,
+                                size_t len)
+{
+   assert(util_get_cpu_caps()->has_avx2);
+   assert(((uintptr_t)dst & 31) == 0 && ((uintptr_t)src & 31) == 0);
+
+   size_t copied = 0;
+
+   while (len - copied >= 64) {
+      __m256i *dst_cacheline = (__m256i *)(dst + copied);
+      __m256i *src_cacheline = (__m256i *)(src + copied);
+
+      __m256i temp1 = _mm256_stream_load_si256(src_cacheline + 0);
+      __m256i temp2 = _mm256_stream_load_si256(src_cacheline + 1);
+
+      _mm256_store_si256(dst_cacheline + 0, temp1);
+      _mm256_store_si256(dst_cacheline + 1, temp2);
+
+      copied += 64;
+   }
+
+   return copied;
+}
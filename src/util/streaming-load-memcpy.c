@@ -34,6 +34,12 @@
 #include <smmintrin.h>
 #endif
 
+/* Defined in streaming-load-memcpy-avx2.c */
+#ifdef USE_AVX2
+size_t util_streaming_load_memcpy_avx2(char *restrict dst, char *restrict src,
+                                       size_t len);
+#endif
+
 /* Copies memory from src to dst, using non-temporal load instructions to get
  * streaming read performance from uncached memory.
  */
@@ -55,17 +61,29 @@ util_streaming_load_memcpy(void *restrict dst, void *restrict src, size_t len)
       return;
    }
 
+   /* 32-byte non-temporal loads need dst and src to be co-aligned to 32
+    * bytes as well.
+    */
+#if defined(USE_AVX2)
+   const bool use_avx2 = util_get_cpu_caps()->has_avx2 &&
+                         (((uintptr_t)d ^ (uintptr_t)s) & 31) == 0;
+   const uintptr_t align = use_avx2 ? 32 : 16;
+#else
+   const uintptr_t align = 16;
+#endif
+
    /* memcpy() the misaligned header. At the end of this if block, <d> and <s>
-    * are aligned to a 16-byte boundary or <len> == 0.
+    * are aligned to an <align>-byte boundary or <len> == 0.
     */
-   if ((uintptr_t)d & 15) {
-      uintptr_t bytes_before_alignment_boundary = 16 - ((uintptr_t)d & 15);
-      assert(bytes_before_alignment_boundary < 16);
+   if ((uintptr_t)d & (align - 1)) {
+      uintptr_t bytes_before_alignment_boundary =
+         align - ((uintptr_t)d & (align - 1));
+      assert(bytes_before_alignment_boundary < align);
 
       memcpy(d, s, MIN2(bytes_before_alignment_boundary, len));
 
-      d = (char *)align_uintptr((uintptr_t)d, 16);
-      s = (char *)align_uintptr((uintptr_t)s, 16);
+      d = (char *)align_uintptr((uintptr_t)d, align);
+      s = (char *)align_uintptr((uintptr_t)s, align);
       len -= MIN2(bytes_before_alignment_boundary, len);
    }
 
@@ -73,6 +91,15 @@ util_streaming_load_memcpy(void *restrict dst, void *restrict src, size_t len)
    if (len >= 64)
       _mm_mfence();
 
+#if defined(USE_AVX2)
+   if (use_avx2) {
+      size_t copied = util_streaming_load_memcpy_avx2(d, s, len);
+      d += copied;
+      s += copied;
+      len -= copied;
+   }
+#endif
+
    while (len >= 64) {
       __m128i *dst_cacheline = (__m128i *)d;
       __m128i *src_cacheline = (__m128i *)s;
@@ -502,6 +502,67 @@ test_put_key_and_get_key(const char *driver_id)
    disk_cache_destroy(cache);
 }
 
+struct get_batch_result {
+   char *item;
+   size_t size;
+};
+
+static void
+get_batch_cb(void *data, unsigned index, void *item, size_t size)
+{
+   struct get_batch_result *results = (struct get_batch_result *) data;
+
+   results[index].item = (char *) item;
+   results[index].size = size;
+}
+
+static void
+test_get_batch(const char *driver_id)
+{
+   struct disk_cache *cache;
+   char blobs[64][32];
+   cache_key keys[64];
+   struct get_batch_result results[64];
+
+#ifdef SHADER_CACHE_DISABLE_BY_DEFAULT
+   os_set_option("MESA_SHADER_CACHE_DISABLE", "false", true);
+#endif /* SHADER_CACHE_DISABLE_BY_DEFAULT */
+
+   cache = disk_cache_create("test", driver_id, 0);
+
+   /* Store every other item, so that the batch has hits and misses. */
+   for (unsigned i = 0; i < ARRAY_SIZE(keys); i++) {
+      snprintf(blobs[i], sizeof(blobs[i]), "batch blob %u", i);
+      disk_cache_compute_key(cache, blobs[i], sizeof(blobs[i]), keys[i]);
+      if (i % 2 == 0)
+         disk_cache_put(cache, keys[i], blobs[i], sizeof(blobs[i]), NULL);
+   }
+
+   /* disk_cache_put() hands things off to a thread so wait for it. */
+   disk_cache_wait_for_idle(cache);
+
+   memset(results, 0xff, sizeof(results));
+   struct disk_cache_batch *batch =
+      disk_cache_get_batch(cache, keys, ARRAY_SIZE(keys), get_batch_cb,
+                           results);
+   disk_cache_batch_wait(batch);
+
+   for (unsigned i = 0; i < ARRAY_SIZE(keys); i++) {
+      if (i % 2 == 0) {
+         EXPECT_NE(results[i].item, nullptr) << "disk_cache_get_batch of existing item (pointer)";
+         EXPECT_EQ(results[i].size, sizeof(blobs[i])) << "disk_cache_get_batch of existing item (size)";
+         if (results[i].item)
+            EXPECT_STREQ(results[i].item, blobs[i]) << "disk_cache_get_batch of existing item (data)";
+      } else {
+         EXPECT_EQ(results[i].item, nullptr) << "disk_cache_get_batch with non-existent item (pointer)";
+         EXPECT_EQ(results[i].size, 0) << "disk_cache_get_batch with non-existent item (size)";
+      }
+      free(results[i].item);
+   }
+
+   disk_cache_destroy(cache);
+}
+
 /* To make sure we are not just using the inmemory cache index for the single
  * file cache we test adding and retriving cache items between two different
  * cache instances.
@@ -761,6 +822,8 @@ run_tests:
 
    test_put_key_and_get_key(driver_id);
 
+   test_get_batch(driver_id);
+
    os_set_option("MESA_DISK_CACHE_MULTI_FILE", "false", true);
 
    int err = rmrf_local(CACHE_TEST_TMP);
@@ -842,6 +905,8 @@ TEST_F(Cache, Database)
 
    test_put_key_and_get_key(driver_id);
 
+   test_get_batch(driver_id);
+
    test_put_and_get_between_instances(driver_id);
 
    test_put_and_get_between_instances_with_eviction(driver_id);
@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+#include "util/fast_hash_table.h"
+#include "util/hash_table.h"
+#include "util/os_time.h"
+
+static uint32_t
+bad_hash(const void *key)
+{
+   return 42;
+}
+
+TEST(fast_hash_table, basic)
+{
+   struct fast_hash_table *ht = _mesa_pointer_fast_hash_table_create(NULL);
+
+   const void *a = (const void *)10;
+   const void *b = (const void *)20;
+
+   _mesa_fast_hash_table_insert(ht, a, (void *)1);
+   _mesa_fast_hash_table_insert(ht, b, (void *)2);
+   EXPECT_EQ(_mesa_fast_hash_table_num_entries(ht), 2);
+
+   /* Inserting an existing key replaces its data. */
+   _mesa_fast_hash_table_insert(ht, a, (void *)3);
+   EXPECT_EQ(_mesa_fast_hash_table_num_entries(ht), 2);
+
+   struct hash_entry *entry = _mesa_fast_hash_table_search(ht, a);
+   ASSERT_TRUE(entry);
+   EXPECT_EQ(entry->key, a);
+   EXPECT_EQ(entry->data, (void *)3);
+
+   _mesa_fast_hash_table_remove(ht, entry);
+   EXPECT_EQ(_mesa_fast_hash_table_num_entries(ht), 1);
+   EXPECT_FALSE(_mesa_fast_hash_table_search(ht, a));
+
+   /* NULL is a valid key. */
+   _mesa_fast_hash_table_insert(ht, NULL, (void *)4);
+   entry = _mesa_fast_hash_table_search(ht, NULL);
+   ASSERT_TRUE(entry);
+   EXPECT_EQ(entry->data, (void *)4);
+
+   _mesa_fast_hash_table_clear(ht, NULL);
+   EXPECT_EQ(_mesa_fast_hash_table_num_entries(ht), 0);
+   fast_hash_table_foreach(ht, he) {
+      GTEST_FAIL();
+   }
+
+   _mesa_fast_hash_table_destroy(ht, NULL);
+}
+
+TEST(fast_hash_table, collision)
+{
+   struct fast_hash_table *ht =
+      _mesa_fast_hash_table_create(NULL, bad_hash, _mesa_key_pointer_equal);
+
+   for (uintptr_t i = 1; i <= 100; i++)
+      _mesa_fast_hash_table_insert(ht, (void *)i, (void *)(i * 2));
+   EXPECT_EQ(_mesa_fast_hash_table_num_entries(ht), 100);
+
+   for (uintptr_t i = 1; i <= 100; i += 2)
+      _mesa_fast_hash_table_remove_key(ht, (void *)i);
+
+   for (uintptr_t i = 1; i <= 100; i++) {
+      struct hash_entry *entry = _mesa_fast_hash_table_search(ht, (void *)i);
+      if (i % 2) {
+         EXPECT_FALSE(entry);
+      } else {
+         ASSERT_TRUE(entry);
+         EXPECT_EQ(entry->data, (void *)(i * 2));
+      }
+   }
+
+   _mesa_fast_hash_table_destroy(ht, NULL);
+}
+
+static void
+count_entry(struct hash_entry *entry)
+{
+   (*(unsigned *)entry->data)++;
+}
+
+TEST(fast_hash_table, churn)
+{
+   struct fast_hash_table *ht = _mesa_pointer_fast_hash_table_create(NULL);
+   unsigned deleted = 0;
+
+   /* Keep the number of entries steady while replacing them, so the table
+    * has to get rid of deleted entries rather than grow.
+    */
+   const uintptr_t window = 200;
+   for (uintptr_t i = 1; i <= 10000; i++) {
+      _mesa_fast_hash_table_insert(ht, (void *)i, &deleted);
+      if (i > window)
+         _mesa_fast_hash_table_remove_key(ht, (void *)(i - window));
+   }
+   EXPECT_EQ(_mesa_fast_hash_table_num_entries(ht), window);
+   EXPECT_LE(ht->size, 1024);
+
+   unsigned count = 0;
+   fast_hash_table_foreach(ht, entry) {
+      uintptr_t key = (uintptr_t)entry->key;
+      EXPECT_GT(key, 10000 - window);
+      EXPECT_LE(key, 10000);
+      count++;
+
+      /* Removing while iterating is fine. */
+      if (key % 2)
+         _mesa_fast_hash_table_remove(ht, entry);
+   }
+   EXPECT_EQ(count, window);
+   EXPECT_EQ(_mesa_fast_hash_table_num_entries(ht), window / 2);
+
+   _mesa_fast_hash_table_destroy(ht, count_entry);
+   EXPECT_EQ(deleted, window / 2);
+}
+
+TEST(fast_hash_table, reserve)
+{
+   struct fast_hash_table *ht = _mesa_pointer_fast_hash_table_create(NULL);
+
+   ASSERT_TRUE(_mesa_fast_hash_table_reserve(ht, 1000));
+   const uint32_t size = ht->size;
+
+   for (uintptr_t i = 1; i <= 1000; i++)
+      _mesa_fast_hash_table_insert(ht, (void *)(i << 4), NULL);
+   EXPECT_EQ(ht->size, size);
+
+   for (uintptr_t i = 1; i <= 1000; i++)
+      EXPECT_TRUE(_mesa_fast_hash_table_search(ht, (void *)(i << 4)));
+
+   _mesa_fast_hash_table_destroy(ht, NULL);
+}
+
+/* Not a real test, prints how both tables do on a mix of lookups that hit
+ * and miss, with pointer-like keys.
+ */
+TEST(fast_hash_table, benchmark)
+{
+   const unsigned num_keys = 100000;
+   const unsigned num_rounds = 10;
+   uintptr_t *keys = (uintptr_t *)malloc(num_keys * sizeof(*keys));
+
+   for (unsigned i = 0; i < num_keys; i++)
+      keys[i] = 0x10000 + (uintptr_t)i * 48;
+
+   unsigned hits = 0, fast_hits = 0;
+
+   int64_t start = os_time_get_nano();
+   for (unsigned r = 0; r < num_rounds; r++) {
+      struct hash_table *ht = _mesa_pointer_hash_table_create(NULL);
+      for (unsigned i = 0; i < num_keys; i += 2)
+         _mesa_hash_table_insert(ht, (void *)keys[i], NULL);
+      for (unsigned i = 0; i < num_keys; i++)
+         hits += _mesa_hash_table_search(ht, (void *)keys[i]) != NULL;
+      _mesa_hash_table_destroy(ht, NULL);
+   }
+   int64_t hash_table_time = os_time_get_nano() - start;
+
+   start = os_time_get_nano();
+   for (unsigned r = 0; r < num_rounds; r++) {
+      struct fast_hash_table *ht = _mesa_pointer_fast_hash_table_create(NULL);
+      for (unsigned i = 0; i < num_keys; i += 2)
+         _mesa_fast_hash_table_insert(ht, (void *)keys[i], NULL);
+      for (unsigned i = 0; i < num_keys; i++)
+         fast_hits += _mesa_fast_hash_table_search(ht, (void *)keys[i]) != NULL;
+      _mesa_fast_hash_table_destroy(ht, NULL);
+   }
+   int64_t fast_hash_table_time = os_time_get_nano() - start;
+
+   EXPECT_EQ(hits, num_rounds * num_keys / 2);
+   EXPECT_EQ(fast_hits, hits);
+
+   printf("hash_table:      %.2f ms\n", hash_table_time / 1000000.0);
+   printf("fast_hash_table: %.2f ms\n", fast_hash_table_time / 1000000.0);
+
+   free(keys);
+}
@@ -46,3 +46,28 @@ TEST(gc_alloc, align)
       }
    }
 }
+
+TEST(gc_alloc, defer_free)
+{
+   gc_ctx *ctx = gc_context(NULL);
+
+   /* Freed objects get recycled right away by default. */
+   void *a = gc_alloc_size(ctx, 32, 8);
+   gc_free(a);
+   EXPECT_EQ(gc_alloc_size(ctx, 32, 8), a);
+
+   gc_set_defer_free(ctx, true);
+
+   gc_free(a);
+   void *b = gc_alloc_size(ctx, 32, 8);
+   EXPECT_NE(b, a);
+
+   /* ...and with deferred frees only once a sweep reclaimed them. */
+   gc_sweep_start(ctx);
+   gc_mark_live(ctx, b);
+   gc_sweep_end(ctx);
+
+   EXPECT_EQ(gc_alloc_size(ctx, 32, 8), a);
+
+   ralloc_free(ctx);
+}
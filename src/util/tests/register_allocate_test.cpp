@@ -279,3 +279,58 @@ TEST_F(ra_test, serialization_roundtrip)
    blob_finish(&blob);
 }
 
+
+TEST_F(ra_test, spill_benefit)
+{
+   struct ra_regs *regs = ra_alloc_reg_set(mem_ctx, 4, true);
+   struct ra_class *c1 = ra_alloc_contig_reg_class(regs, 1);
+   struct ra_class *c2 = ra_alloc_contig_reg_class(regs, 2);
+
+   for (int i = 0; i < 4; i++)
+      ra_class_add_reg(c1, i);
+   for (int i = 0; i < 4; i += 2)
+      ra_class_add_reg(c2, i);
+
+   ra_set_finalize(regs, NULL);
+
+   struct ra_graph *g = ra_alloc_interference_graph(regs, 4);
+   ra_set_node_class(g, 0, c1);
+   ra_set_node_class(g, 1, c1);
+   ra_set_node_class(g, 2, c2);
+   ra_set_node_class(g, 3, c1);
+
+   ra_add_node_interference(g, 0, 1);
+   ra_add_node_interference(g, 0, 2);
+   ra_add_node_interference(g, 0, 3);
+   ra_add_node_interference(g, 1, 2);
+
+   /* sum of q(c1, neighbor class) / p(c1) */
+   EXPECT_FLOAT_EQ(ra_debug_get_spill_benefit(g, 0),
+                   (2.0f * c1->q[c1->index] + c1->q[c2->index]) / c1->p);
+   EXPECT_FLOAT_EQ(ra_debug_get_spill_benefit(g, 2),
+                   2.0f * c2->q[c1->index] / c2->p);
+
+   /* Nodes still on the stack after an allocation aren't spill candidates,
+    * start from a successful one so that all of them are.
+    */
+   ASSERT_TRUE(ra_allocate(g));
+
+   for (unsigned n = 0; n < 4; n++)
+      ra_set_node_spill_cost(g, n, n == 2 ? 1.5f : 1.0f);
+   EXPECT_EQ(ra_get_best_spill_node(g), 0);
+
+   /* Spilling a node drops its interferences, which the benefits of its
+    * neighbors have to reflect.
+    */
+   ra_reset_node_interference(g, 0);
+   EXPECT_FLOAT_EQ(ra_debug_get_spill_benefit(g, 0), 0.0f);
+   EXPECT_FLOAT_EQ(ra_debug_get_spill_benefit(g, 1),
+                   (float)c1->q[c2->index] / c1->p);
+   EXPECT_FLOAT_EQ(ra_debug_get_spill_benefit(g, 3), 0.0f);
+   EXPECT_EQ(ra_get_best_spill_node(g), 1);
+
+   ra_set_node_spill_cost(g, 1, 2.0f);
+   EXPECT_EQ(ra_get_best_spill_node(g), 2);
+
+   ralloc_free(g);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include "c11/threads.h"
+#include "util/sharded_hash_table.h"
+
+#define NUM_THREADS 8
+#define NUM_KEYS 4096
+
+TEST(sharded_hash_table, basic)
+{
+   struct util_sharded_hash_table ht;
+   util_sharded_hash_table_init(&ht, _mesa_hash_pointer,
+                                _mesa_key_pointer_equal);
+
+   const void *a = (const void *)10;
+   const void *b = (const void *)20;
+
+   util_sharded_hash_table_insert(&ht, a, (void *)1);
+   EXPECT_EQ(util_sharded_hash_table_search_or_insert(&ht, a, (void *)2),
+             (void *)1);
+   EXPECT_EQ(util_sharded_hash_table_search_or_insert(&ht, b, (void *)3),
+             (void *)3);
+   EXPECT_EQ(util_sharded_hash_table_num_entries(&ht), 2);
+
+   util_sharded_hash_table_insert(&ht, a, (void *)4);
+   EXPECT_EQ(util_sharded_hash_table_search(&ht, a), (void *)4);
+
+   EXPECT_EQ(util_sharded_hash_table_remove(&ht, a), (void *)4);
+   EXPECT_EQ(util_sharded_hash_table_remove(&ht, a), nullptr);
+   EXPECT_EQ(util_sharded_hash_table_search(&ht, a), nullptr);
+   EXPECT_EQ(util_sharded_hash_table_num_entries(&ht), 1);
+
+   util_sharded_hash_table_fini(&ht, NULL);
+}
+
+TEST(sharded_hash_table, set)
+{
+   struct util_sharded_set set;
+   util_sharded_set_init(&set, _mesa_hash_string, _mesa_key_string_equal);
+
+   char a1[] = "a", a2[] = "a";
+
+   /* The first key added is the one that stays in the set. */
+   EXPECT_EQ(util_sharded_set_add(&set, a1), a1);
+   EXPECT_EQ(util_sharded_set_add(&set, a2), a1);
+   EXPECT_EQ(util_sharded_set_search(&set, a2), a1);
+   EXPECT_EQ(util_sharded_set_search(&set, "b"), nullptr);
+   EXPECT_EQ(util_sharded_set_num_entries(&set), 1);
+
+   EXPECT_EQ(util_sharded_set_remove(&set, a2), a1);
+   EXPECT_EQ(util_sharded_set_num_entries(&set), 0);
+
+   util_sharded_set_fini(&set, NULL);
+}
+
+struct thread_data {
+   struct util_sharded_hash_table *ht;
+   unsigned thread;
+   unsigned inserted;
+};
+
+static int
+insert_keys(void *_data)
+{
+   struct thread_data *data = (struct thread_data *)_data;
+
+   /* All threads race to insert the same keys, each in a different order. */
+   for (unsigned i = 0; i < NUM_KEYS; i++) {
+      uintptr_t key = 1 + (i + data->thread * 997) % NUM_KEYS;
+
+      void *winner =
+         util_sharded_hash_table_search_or_insert(data->ht, (void *)key, data);
+      if (winner == data)
+         data->inserted++;
+
+      EXPECT_EQ(util_sharded_hash_table_search(data->ht, (void *)key), winner);
+   }
+
+   return 0;
+}
+
+TEST(sharded_hash_table, threads)
+{
+   struct util_sharded_hash_table ht;
+   util_sharded_hash_table_init(&ht, _mesa_hash_pointer,
+                                _mesa_key_pointer_equal);
+
+   /* Pre-insert half of the keys, the rest get raced for below. */
+   for (uintptr_t key = 1; key <= NUM_KEYS / 2; key++)
+      util_sharded_hash_table_insert(&ht, (void *)key, &ht);
+
+   thrd_t threads[NUM_THREADS];
+   struct thread_data data[NUM_THREADS];
+   for (unsigned i = 0; i < NUM_THREADS; i++) {
+      data[i] = (struct thread_data) { &ht, i, 0 };
+      thrd_create(&threads[i], insert_keys, &data[i]);
+   }
+
+   /* Every remaining key was inserted by exactly one thread. */
+   unsigned inserted = 0;
+   for (unsigned i = 0; i < NUM_THREADS; i++) {
+      int ret;
+      thrd_join(threads[i], &ret);
+      inserted += data[i].inserted;
+   }
+   EXPECT_EQ(inserted, NUM_KEYS / 2);
+   EXPECT_EQ(util_sharded_hash_table_num_entries(&ht), NUM_KEYS);
+
+   struct util_sharded_hash_table_stats stats;
+   util_sharded_hash_table_get_stats(&ht, &stats);
+   EXPECT_EQ(stats.entries, NUM_KEYS);
+   EXPECT_LE(stats.contended, stats.acquisitions);
+   EXPECT_LT(stats.max_shard_entries, NUM_KEYS / 4);
+
+   util_sharded_hash_table_fini(&ht, NULL);
+}
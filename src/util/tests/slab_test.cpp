@@ -0,0 +1,128 @@
+/*
+ * Copyright © 2026 Mesa contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include "c11/threads.h"
+#include "util/slab.h"
+
+/* A multiple of the 16 elements per page, so that no page has spare ones. */
+#define NUM_ITEMS 1024
+
+TEST(slab, cross_pool_free)
+{
+   struct slab_parent_pool parent;
+   struct slab_child_pool a, b;
+   void *items[NUM_ITEMS];
+
+   slab_create_parent(&parent, sizeof(uint64_t), 16);
+   slab_create_child(&a, &parent);
+   slab_create_child(&b, &parent);
+
+   for (unsigned i = 0; i < NUM_ITEMS; i++) {
+      items[i] = slab_alloc(&a);
+      ASSERT_TRUE(items[i]);
+      *(uint64_t *)items[i] = i;
+   }
+
+   /* Free everything in the other pool, then check that the owner gets its
+    * elements back instead of allocating new pages.
+    */
+   for (unsigned i = 0; i < NUM_ITEMS; i++) {
+      EXPECT_EQ(*(uint64_t *)items[i], i);
+      slab_free(&b, items[i]);
+   }
+
+   slab_destroy_child(&b);
+
+   for (unsigned i = 0; i < NUM_ITEMS; i++) {
+      void *item = slab_alloc(&a);
+      bool found = false;
+      for (unsigned j = 0; j < NUM_ITEMS && !found; j++)
+         found = items[j] == item;
+      EXPECT_TRUE(found);
+      slab_free(&a, item);
+   }
+
+   slab_destroy_child(&a);
+   slab_destroy_parent(&parent);
+}
+
+TEST(slab, free_after_owner_destroyed)
+{
+   struct slab_parent_pool parent;
+   struct slab_child_pool a, b;
+   void *items[NUM_ITEMS];
+
+   slab_create_parent(&parent, sizeof(uint64_t), 16);
+   slab_create_child(&a, &parent);
+   slab_create_child(&b, &parent);
+
+   for (unsigned i = 0; i < NUM_ITEMS; i++)
+      items[i] = slab_alloc(&a);
+
+   /* Some elements are still waiting to be handed back to "a" when it gets
+    * destroyed.  Run with a leak checker to see that the pages go away.
+    */
+   for (unsigned i = 0; i < NUM_ITEMS / 2 + 5; i++)
+      slab_free(&b, items[i]);
+
+   slab_destroy_child(&a);
+
+   for (unsigned i = NUM_ITEMS / 2 + 5; i < NUM_ITEMS; i++)
+      slab_free(&b, items[i]);
+
+   slab_destroy_child(&b);
+   slab_destroy_parent(&parent);
+}
+
+struct thread_data {
+   struct slab_child_pool *owner;
+   struct slab_parent_pool *parent;
+   void **items;
+};
+
+static int
+free_items(void *_data)
+{
+   struct thread_data *data = (struct thread_data *)_data;
+   struct slab_child_pool pool;
+
+   slab_create_child(&pool, data->parent);
+   for (unsigned i = 0; i < NUM_ITEMS; i++)
+      slab_free(&pool, data->items[i]);
+   slab_destroy_child(&pool);
+
+   return 0;
+}
+
+TEST(slab, threads)
+{
+   struct slab_parent_pool parent;
+   struct slab_child_pool pool;
+   void *items[2][NUM_ITEMS];
+
+   slab_create_parent(&parent, sizeof(uint64_t), 16);
+   slab_create_child(&pool, &parent);
+
+   /* Another thread frees one batch while this one keeps allocating. */
+   for (unsigned i = 0; i < NUM_ITEMS; i++)
+      items[0][i] = slab_alloc(&pool);
+
+   struct thread_data data = { &pool, &parent, items[0] };
+   thrd_t thread;
+   thrd_create(&thread, free_items, &data);
+
+   for (unsigned i = 0; i < NUM_ITEMS; i++)
+      items[1][i] = slab_alloc(&pool);
+
+   int ret;
+   thrd_join(thread, &ret);
+
+   for (unsigned i = 0; i < NUM_ITEMS; i++)
+      slab_free(&pool, items[1][i]);
+
+   slab_destroy_child(&pool);
+   slab_destroy_parent(&parent);
+}
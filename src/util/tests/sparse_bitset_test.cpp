@@ -100,6 +100,34 @@ TEST(sparse_bitset, set_merge)
    u_sparse_bitset_free(&set2);
 }
 
+TEST(sparse_bitset, set_subtract)
+{
+   struct u_sparse_bitset set;
+   u_sparse_bitset_init(&set, 1048577, NULL);
+
+   u_sparse_bitset_set(&set, 128);
+   u_sparse_bitset_set(&set, 65535);
+   u_sparse_bitset_set(&set, 1048576);
+
+   struct u_sparse_bitset set2;
+   u_sparse_bitset_init(&set2, 1048577, NULL);
+   u_sparse_bitset_set(&set2, 128);
+   u_sparse_bitset_set(&set2, 16383);
+   u_sparse_bitset_set(&set2, 1048576);
+
+   u_sparse_bitset_subtract(&set, &set2);
+
+   EXPECT_EQ(u_sparse_bitset_test(&set, 128), false);
+   EXPECT_EQ(u_sparse_bitset_test(&set, 16383), false);
+   EXPECT_EQ(u_sparse_bitset_test(&set, 65535), true);
+   EXPECT_EQ(u_sparse_bitset_test(&set, 1048576), false);
+   EXPECT_EQ(u_sparse_bitset_test(&set2, 128), true);
+   EXPECT_EQ(u_sparse_bitset_count(&set), 1);
+
+   u_sparse_bitset_free(&set);
+   u_sparse_bitset_free(&set2);
+}
+
 TEST(sparse_bitset, set_foreach)
 {
    struct u_sparse_bitset set;
@@ -23,6 +23,11 @@
 
 #include <gtest/gtest.h>
 #include <driconf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <utime.h>
 
 #include "util/xmlconfig.h"
 #include "util/os_misc.h"
@@ -296,4 +301,49 @@ TEST_F(xmlconfig_test, drirc_exec_override)
    EXPECT_EQ(driQueryOptioni(&cache, "mesa_drirc_option"), 1);
    driDestroyOptionCache(&cache);
 }
+
+static void
+write_drirc(const std::string &path, int value, time_t mtime)
+{
+   FILE *f = fopen(path.c_str(), "w");
+   ASSERT_TRUE(f);
+   fprintf(f, "<driconf><device><application name=\"Cached\" "
+              "executable=\"cachedapp\"><option name=\"mesa_drirc_option\" "
+              "value=\"%d\"/></application></device></driconf>\n", value);
+   fclose(f);
+
+   struct utimbuf times = { mtime, mtime };
+   utime(path.c_str(), &times);
+}
+
+TEST_F(xmlconfig_test, drirc_file_changed)
+{
+   char dir[] = "/tmp/drirc_test_XXXXXX";
+   ASSERT_TRUE(mkdtemp(dir));
+   const std::string path = std::string(dir) + "/00-cached.conf";
+
+   const char *configdir = os_get_option("DRIRC_CONFIGDIR");
+   const std::string old_configdir = configdir ? configdir : "";
+   os_set_option("DRIRC_CONFIGDIR", dir, true);
+
+   /* The parsed file is reused until it changes. */
+   write_drirc(path, 20, 1000);
+   driOptionCache cache = drirc_init("driver", "drm", "cachedapp",
+                                     NULL, 0, NULL, 0);
+   EXPECT_EQ(driQueryOptioni(&cache, "mesa_drirc_option"), 20);
+   driDestroyOptionCache(&cache);
+   driDestroyOptionInfo(&options);
+
+   write_drirc(path, 30, 2000);
+   cache = drirc_init("driver", "drm", "cachedapp", NULL, 0, NULL, 0);
+   EXPECT_EQ(driQueryOptioni(&cache, "mesa_drirc_option"), 30);
+   driDestroyOptionCache(&cache);
+
+   if (configdir)
+      os_set_option("DRIRC_CONFIGDIR", old_configdir.c_str(), true);
+   else
+      os_unset_option("DRIRC_CONFIGDIR");
+   unlink(path.c_str());
+   rmdir(dir);
+}
 #endif
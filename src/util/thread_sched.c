@@ -15,6 +15,7 @@ util_thread_scheduler_enabled(void)
 {
 #if DETECT_ARCH_X86 || DETECT_ARCH_X86_64
    return util_get_cpu_caps()->num_L3_caches > 1 ||
+          util_get_cpu_caps()->big_affinity_mask ||
           debug_get_option_pin_threads();
 #else
    return false;
@@ -64,12 +65,27 @@ util_thread_sched_apply_policy(thrd_t thread, enum util_thread_name name,
    if (name == UTIL_THREAD_APP_CALLER)
       return false;
 
+   const struct util_cpu_caps_t *caps = util_get_cpu_caps();
+
+   /* On hybrid CPUs with a single L3, keep Mesa threads off the E-cores
+    * instead. The mask never changes, so this is done only once, like
+    * pinning.
+    */
+   if (caps->num_L3_caches == 1 && caps->big_affinity_mask) {
+      if (sched_state && !*sched_state)
+         return false;
+
+      if (sched_state)
+         *sched_state = 0;
+      return util_set_thread_affinity(thread, *caps->big_affinity_mask,
+                                      NULL, caps->num_cpu_mask_bits);
+   }
+
    /* Move Mesa threads to the L3 core complex where the app thread
     * resides. We call this "L3 chasing".
     *
     * This improves multithreading performance by up to 33% on Ryzen 3900X.
     */
-   const struct util_cpu_caps_t *caps = util_get_cpu_caps();
    int L3_cache = caps->cpu_to_L3[app_thread_cpu];
 
    /* Don't do anything if the app thread hasn't moved to a different
@@ -442,6 +442,69 @@ check_os_loongarch64_support(void)
 #endif /* DETECT_ARCH_LOONGARCH64 */
 
 
+#if DETECT_OS_LINUX && (DETECT_ARCH_X86 || DETECT_ARCH_X86_64)
+/* Parse a sysfs CPU list such as "0-7,16-23" into mask. */
+static unsigned
+parse_cpu_list(const char *list, util_affinity_mask mask)
+{
+   unsigned count = 0;
+   const char *p = list;
+
+   while (*p) {
+      char *end;
+      unsigned long first = strtoul(p, &end, 10);
+      unsigned long last = first;
+      if (end == p)
+         break;
+
+      if (*end == '-') {
+         p = end + 1;
+         last = strtoul(p, &end, 10);
+         if (end == p)
+            break;
+      }
+
+      for (unsigned long i = first; i <= last && i < UTIL_MAX_CPUS; i++) {
+         mask[i / 32] |= 1u << (i % 32);
+         count++;
+      }
+
+      if (*end != ',')
+         break;
+      p = end + 1;
+   }
+
+   return count;
+}
+
+/* Intel hybrid CPUs register their P-cores and E-cores as two separate
+ * perf PMUs, and the CPU list of "cpu_core" is the list of P-cores.
+ */
+static void
+get_hybrid_topology(void)
+{
+   size_t size = 0;
+   char *list = os_read_file("/sys/devices/cpu_core/cpus", &size);
+   if (!list)
+      return;
+
+   util_affinity_mask *mask = calloc(1, sizeof(util_affinity_mask));
+   if (mask && parse_cpu_list(list, *mask)) {
+      util_cpu_caps.big_affinity_mask = mask;
+
+      if (debug_get_option_dump_cpu()) {
+         fprintf(stderr, "P-core mask = ");
+         for (int j = util_cpu_caps.max_cpus - 1; j >= 0; j -= 32)
+            fprintf(stderr, "%08x ", (*mask)[j / 32]);
+         fprintf(stderr, "\n");
+      }
+   } else {
+      free(mask);
+   }
+   free(list);
+}
+#endif
+
 static void
 get_cpu_topology(bool zen)
 {
@@ -484,6 +547,11 @@ get_cpu_topology(bool zen)
    util_cpu_caps.nr_big_cpus = num_big_cpus;
 #endif
 
+#if DETECT_OS_LINUX && (DETECT_ARCH_X86 || DETECT_ARCH_X86_64)
+   if (util_cpu_caps.has_hybrid)
+      get_hybrid_topology();
+#endif
+
 #if DETECT_ARCH_X86 || DETECT_ARCH_X86_64
    /* AMD Zen */
    if (zen) {
@@ -839,6 +907,7 @@ _util_cpu_detect_once(void)
          uint32_t regs7[4];
          cpuid_count(0x00000007, 0x00000000, regs7);
          util_cpu_caps.has_clflushopt = (regs7[1] >> 23) & 1;
+         util_cpu_caps.has_hybrid = (regs7[3] >> 15) & 1;
          if (util_cpu_caps.has_avx) {
             util_cpu_caps.has_avx2 = (regs7[1] >> 5) & 1;
 
@@ -926,6 +995,7 @@ _util_cpu_detect_once(void)
       printf("util_cpu_caps.has_avx512vl = %u\n", util_cpu_caps.has_avx512vl);
       printf("util_cpu_caps.has_avx512vbmi = %u\n", util_cpu_caps.has_avx512vbmi);
       printf("util_cpu_caps.has_clflushopt = %u\n", util_cpu_caps.has_clflushopt);
+      printf("util_cpu_caps.has_hybrid = %u\n", util_cpu_caps.has_hybrid);
       printf("util_cpu_caps.num_L3_caches = %u\n", util_cpu_caps.num_L3_caches);
       printf("util_cpu_caps.num_cpu_mask_bits = %u\n", util_cpu_caps.num_cpu_mask_bits);
    }
@@ -103,6 +103,7 @@ struct util_cpu_caps_t {
    unsigned has_avx512vbmi:1;
 
    unsigned has_clflushopt:1;
+   unsigned has_hybrid:1;
 
    unsigned num_L3_caches;
    unsigned num_cpu_mask_bits;
@@ -112,6 +113,9 @@ struct util_cpu_caps_t {
 
    /* Affinity masks for each L3 cache. */
    util_affinity_mask *L3_affinity_mask;
+   /* Affinity mask of the performance cores of a hybrid CPU, NULL if the
+    * cores are homogeneous or if they can't be told apart. */
+   util_affinity_mask *big_affinity_mask;
    /**
     * number of "big" CPUs in big.LITTLE configuration
     * 
@@ -27,6 +27,7 @@
 #include "u_queue.h"
 
 #include "c11/threads.h"
+#include "util/u_call_once.h"
 #include "util/u_cpu_detect.h"
 #include "util/os_time.h"
 #include "util/u_string.h"
@@ -231,6 +232,54 @@ struct thread_input {
    int thread_index;
 };
 
+/* How many times an idle thread of a UTIL_QUEUE_INIT_SPIN_BEFORE_WAIT queue
+ * checks for new jobs before going to sleep.
+ */
+#define UTIL_QUEUE_SPIN_COUNT 2048
+
+/* How often threads check again for a job whose dependency was signalled
+ * from outside the queue.
+ */
+#define UTIL_QUEUE_DEP_POLL_NSEC 100000
+
+static inline void
+util_queue_spin_pause(void)
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+   __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+   __asm__ volatile("yield");
+#endif
+}
+
+static void
+util_queue_finish_execute(void *data, void *gdata, int num_thread);
+
+/* Return the index of the first job that can be started, or -1 if there is
+ * none, either because the queue is empty or because all queued jobs wait
+ * for their dependencies.
+ */
+static int
+util_queue_find_runnable_job(struct util_queue *queue)
+{
+   unsigned i = queue->read_idx;
+
+   for (int n = 0; n < queue->num_queued; n++, i = (i + 1) % queue->max_jobs) {
+      struct util_queue_job *job = &queue->jobs[i];
+
+      /* util_queue_finish relies on the barrier jobs starting only after
+       * all jobs in front of them have, and on no later job overtaking
+       * them.
+       */
+      if (job->execute == util_queue_finish_execute)
+         return i == queue->read_idx ? (int)i : -1;
+
+      if (!job->dep || util_queue_fence_is_signalled(job->dep))
+         return i;
+   }
+   return -1;
+}
+
 static int
 util_queue_thread_func(void *input)
 {
@@ -266,13 +315,38 @@ util_queue_thread_func(void *input)
 
    while (1) {
       struct util_queue_job job;
+      int idx;
 
       mtx_lock(&queue->lock);
       assert(queue->num_queued >= 0 && queue->num_queued <= queue->max_jobs);
 
-      /* wait if the queue is empty */
-      while (thread_index < queue->num_threads && queue->num_queued == 0)
-         cnd_wait(&queue->has_queued_cond, &queue->lock);
+      /* poll for a while without the lock before going to sleep, which
+       * saves the wakeup if a job is added soon
+       */
+      if (queue->flags & UTIL_QUEUE_INIT_SPIN_BEFORE_WAIT &&
+          thread_index < queue->num_threads && queue->num_queued == 0) {
+         mtx_unlock(&queue->lock);
+         for (unsigned i = 0; i < UTIL_QUEUE_SPIN_COUNT &&
+                              !p_atomic_read(&queue->num_queued); i++)
+            util_queue_spin_pause();
+         mtx_lock(&queue->lock);
+      }
+
+      /* wait if the queue is empty or all jobs wait for dependencies */
+      while (thread_index < queue->num_threads &&
+             (idx = util_queue_find_runnable_job(queue)) < 0) {
+         if (queue->num_queued == 0) {
+            cnd_wait(&queue->has_queued_cond, &queue->lock);
+         } else {
+            /* Dependencies can be signalled from outside the queue, which
+             * doesn't wake us up, so check again soon.
+             */
+            struct timespec ts;
+            timespec_get(&ts, TIME_UTC);
+            timespec_add_nsec(&ts, &ts, UTIL_QUEUE_DEP_POLL_NSEC);
+            cnd_timedwait(&queue->has_queued_cond, &queue->lock, &ts);
+         }
+      }
 
       /* only kill threads that are above "num_threads" */
       if (thread_index >= queue->num_threads) {
@@ -280,7 +354,15 @@ util_queue_thread_func(void *input)
          break;
       }
 
-      job = queue->jobs[queue->read_idx];
+      /* Take the job out and close the gap, keeping the order of the jobs
+       * it overtook.
+       */
+      job = queue->jobs[idx];
+      while (idx != queue->read_idx) {
+         unsigned prev = (idx + queue->max_jobs - 1) % queue->max_jobs;
+         queue->jobs[idx] = queue->jobs[prev];
+         idx = prev;
+      }
       memset(&queue->jobs[queue->read_idx], 0, sizeof(struct util_queue_job));
       queue->read_idx = (queue->read_idx + 1) % queue->max_jobs;
 
@@ -543,6 +625,7 @@ static void
 util_queue_add_job_locked(struct util_queue *queue,
                           void *job,
                           struct util_queue_fence *fence,
+                          struct util_queue_fence *dep,
                           util_queue_execute_func execute,
                           util_queue_execute_func cleanup,
                           const size_t job_size,
@@ -614,6 +697,7 @@ util_queue_add_job_locked(struct util_queue *queue,
    ptr->job = job;
    ptr->global_data = queue->global_data;
    ptr->fence = fence;
+   ptr->dep = dep;
    ptr->execute = execute;
    ptr->cleanup = cleanup;
    ptr->job_size = job_size;
@@ -635,8 +719,31 @@ util_queue_add_job(struct util_queue *queue,
                    util_queue_execute_func cleanup,
                    const size_t job_size)
 {
-   util_queue_add_job_locked(queue, job, fence, execute, cleanup, job_size,
-                             false);
+   util_queue_add_job_locked(queue, job, fence, NULL, execute, cleanup,
+                             job_size, false);
+}
+
+/**
+ * Like util_queue_add_job, but the job doesn't start before the "dep" fence
+ * is signalled.  Other jobs can run ahead of it in the meantime, which makes
+ * it possible to queue a whole graph of jobs at once instead of waiting for
+ * each step to finish on the calling thread.
+ *
+ * "dep" is usually the fence of a job added to the same queue before, but
+ * it can be any fence.  It must not belong to a job added later, or
+ * util_queue_finish could wait forever.
+ */
+void
+util_queue_add_job_after(struct util_queue *queue,
+                         void *job,
+                         struct util_queue_fence *fence,
+                         struct util_queue_fence *dep,
+                         util_queue_execute_func execute,
+                         util_queue_execute_func cleanup,
+                         const size_t job_size)
+{
+   util_queue_add_job_locked(queue, job, fence, dep, execute, cleanup,
+                             job_size, false);
 }
 
 /**
@@ -678,6 +785,37 @@ util_queue_drop_job(struct util_queue *queue, struct util_queue_fence *fence)
       util_queue_fence_wait(fence);
 }
 
+/**
+ * Move the job with the given fence to the front of the queue, so that it
+ * is the next one a thread picks up.  This is for jobs somebody is about to
+ * wait for.  The order of the other jobs doesn't change.  Jobs that are
+ * already running or done are left alone.
+ */
+void
+util_queue_prioritize_job(struct util_queue *queue,
+                          struct util_queue_fence *fence)
+{
+   if (util_queue_fence_is_signalled(fence))
+      return;
+
+   mtx_lock(&queue->lock);
+   for (unsigned i = queue->read_idx; i != queue->write_idx;
+        i = (i + 1) % queue->max_jobs) {
+      if (queue->jobs[i].fence == fence) {
+         struct util_queue_job job = queue->jobs[i];
+
+         while (i != queue->read_idx) {
+            unsigned prev = (i + queue->max_jobs - 1) % queue->max_jobs;
+            queue->jobs[i] = queue->jobs[prev];
+            i = prev;
+         }
+         queue->jobs[i] = job;
+         break;
+      }
+   }
+   mtx_unlock(&queue->lock);
+}
+
 /**
  * Wait until all previously added jobs have completed.
  */
@@ -713,7 +851,7 @@ util_queue_finish(struct util_queue *queue)
 
    for (unsigned i = 0; i < queue->num_threads; ++i) {
       util_queue_fence_init(&fences[i]);
-      util_queue_add_job_locked(queue, &barrier, &fences[i],
+      util_queue_add_job_locked(queue, &barrier, &fences[i], NULL,
                                 util_queue_finish_execute, NULL, 0, true);
    }
    queue->create_threads_on_demand = true;
@@ -727,6 +865,38 @@ util_queue_finish(struct util_queue *queue)
    free(fences);
 }
 
+static struct util_queue shared_queue;
+static util_once_flag shared_queue_once = UTIL_ONCE_FLAG_INIT;
+
+static void
+util_queue_init_shared(void)
+{
+   const struct util_cpu_caps_t *caps = util_get_cpu_caps();
+   unsigned num_threads = caps->nr_big_cpus ? caps->nr_big_cpus : caps->nr_cpus;
+
+   util_queue_init(&shared_queue, "mesa", 64, MAX2(num_threads, 1),
+                   UTIL_QUEUE_INIT_RESIZE_IF_FULL |
+                   UTIL_QUEUE_INIT_SET_FULL_THREAD_AFFINITY, NULL);
+}
+
+/**
+ * Return the process-wide queue, with up to one thread per (big) CPU core,
+ * or NULL if it couldn't be created.
+ *
+ * Components that each create a queue sized to the number of cores end up
+ * with several times more threads than cores when they are used together,
+ * e.g. a GL and a Vulkan driver in the same process, or several screens.
+ * Using this queue instead for CPU-bound work keeps the total in check.
+ * The queue has no global_data, and util_queue_finish waits for the jobs of
+ * everybody, so prefer waiting for the fences of one's own jobs.
+ */
+struct util_queue *
+util_queue_get_shared(void)
+{
+   util_call_once(&shared_queue_once, util_queue_init_shared);
+   return util_queue_is_initialized(&shared_queue) ? &shared_queue : NULL;
+}
+
 int64_t
 util_queue_get_thread_time_nano(struct util_queue *queue, unsigned thread_index)
 {
@@ -51,6 +51,8 @@ extern "C" {
 #define UTIL_QUEUE_INIT_USE_MINIMUM_PRIORITY      (1 << 0)
 #define UTIL_QUEUE_INIT_RESIZE_IF_FULL            (1 << 1)
 #define UTIL_QUEUE_INIT_SET_FULL_THREAD_AFFINITY  (1 << 2)
+/* Threads poll for new jobs for a little while before sleeping. */
+#define UTIL_QUEUE_INIT_SPIN_BEFORE_WAIT          (1 << 3)
 
 #if UTIL_FUTEX_SUPPORTED
 #define UTIL_QUEUE_FENCE_FUTEX
@@ -216,6 +218,7 @@ struct util_queue_job {
    void *global_data;
    size_t job_size;
    struct util_queue_fence *fence;
+   struct util_queue_fence *dep; /* don't start before this is signalled */
    util_queue_execute_func execute;
    util_queue_execute_func cleanup;
 };
@@ -257,11 +260,22 @@ void util_queue_add_job(struct util_queue *queue,
                         util_queue_execute_func execute,
                         util_queue_execute_func cleanup,
                         const size_t job_size);
+void util_queue_add_job_after(struct util_queue *queue,
+                              void *job,
+                              struct util_queue_fence *fence,
+                              struct util_queue_fence *dep,
+                              util_queue_execute_func execute,
+                              util_queue_execute_func cleanup,
+                              const size_t job_size);
 void util_queue_drop_job(struct util_queue *queue,
                          struct util_queue_fence *fence);
+void util_queue_prioritize_job(struct util_queue *queue,
+                               struct util_queue_fence *fence);
 
 void util_queue_finish(struct util_queue *queue);
 
+struct util_queue *util_queue_get_shared(void);
+
 /* Adjust the number of active threads. The new number of threads can't be
  * greater than the initial number of threads at the creation of the queue,
  * and it can't be less than 1.
@@ -42,6 +42,10 @@
 #include <errno.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include "hash_table.h"
+#include "ralloc.h"
+#include "simple_mtx.h"
+#include "u_dynarray.h"
 #endif
 #ifdef NO_REGEX
 typedef int regex_t;
@@ -645,6 +649,8 @@ struct OptConfData {
    const char *name;
 #if WITH_XMLCONFIG
    XML_Parser parser;
+   /* Where to record the elements of the file being parsed, if not NULL */
+   struct OptConfFile *record;
 #endif
    driOptionCache *cache;
    int screenNum;
@@ -997,9 +1003,70 @@ optConfEndElem(void *userData, const char *name)
    }
 }
 
+/**
+ * The elements of a configuration file as the parser reported them.
+ *
+ * Which options apply depends on the driver, device and application, so
+ * the matching is done again on every driParseConfigFiles call.  Only the
+ * XML parsing is skipped, by replaying the elements of files that are
+ * unchanged since the last time they were parsed.
+ */
+struct OptConfElemRecord {
+   const char *name;
+   const char **attr; /* NULL for end tags */
+};
+
+struct OptConfFile {
+   dev_t dev;
+   ino_t ino;
+   off_t size;
+   time_t mtime;
+   struct util_dynarray elems; /* struct OptConfElemRecord */
+};
+
+static simple_mtx_t optConfFilesMutex = SIMPLE_MTX_INITIALIZER;
+static struct hash_table *optConfFiles;
+
+static void
+recordStartElem(void *userData, const char *name, const char **attr)
+{
+   struct OptConfData *data = (struct OptConfData *)userData;
+   struct OptConfFile *file = data->record;
+   unsigned count = 0;
+
+   while (attr[count])
+      count++;
+
+   const char **attr_copy = ralloc_array(file, const char *, count + 1);
+   for (unsigned i = 0; i < count; i++)
+      attr_copy[i] = ralloc_strdup(file, attr[i]);
+   attr_copy[count] = NULL;
+
+   struct OptConfElemRecord record = {
+      .name = ralloc_strdup(file, name),
+      .attr = attr_copy,
+   };
+   util_dynarray_append(&file->elems, record);
+
+   optConfStartElem(userData, name, attr);
+}
+
 static void
+recordEndElem(void *userData, const char *name)
+{
+   struct OptConfData *data = (struct OptConfData *)userData;
+   struct OptConfElemRecord record = {
+      .name = ralloc_strdup(data->record, name),
+   };
+   util_dynarray_append(&data->record->elems, record);
+
+   optConfEndElem(userData, name);
+}
+
+static bool
 _parseOneConfigFile(XML_Parser p)
 {
+   bool success = false;
 #define BUF_SIZE 0x1000
    struct OptConfData *data = (struct OptConfData *)XML_GetUserData(p);
    int status;
@@ -1008,7 +1075,7 @@ _parseOneConfigFile(XML_Parser p)
    if ((fd = open(data->name, O_RDONLY)) == -1) {
       __driUtilMessage("Can't open configuration file %s: %s.",
                        data->name, strerror(errno));
-      return;
+      return false;
    }
 
    while (1) {
@@ -1029,11 +1096,14 @@ _parseOneConfigFile(XML_Parser p)
          XML_ERROR("%s.", XML_ErrorString(XML_GetErrorCode(p)));
          break;
       }
-      if (bytesRead == 0)
+      if (bytesRead == 0) {
+         success = true;
          break;
+      }
    }
 
    close(fd);
+   return success;
 #undef BUF_SIZE
 }
 
@@ -1042,11 +1112,8 @@ static void
 parseOneConfigFile(struct OptConfData *data, const char *filename)
 {
    XML_Parser p;
+   struct stat st;
 
-   p = XML_ParserCreate(NULL); /* use encoding specified by file */
-   XML_SetElementHandler(p, optConfStartElem, optConfEndElem);
-   XML_SetUserData(p, data);
-   data->parser = p;
    data->name = filename;
    data->ignoringDevice = 0;
    data->ignoringApp = 0;
@@ -1055,8 +1122,74 @@ parseOneConfigFile(struct OptConfData *data, const char *filename)
    data->inApp = 0;
    data->inOption = 0;
 
-   _parseOneConfigFile(p);
+   /* Files that can't be stat'ed can't be opened either, the parser below
+    * reports that.
+    */
+   bool cacheable = stat(filename, &st) == 0;
+
+   simple_mtx_lock(&optConfFilesMutex);
+
+   if (cacheable) {
+      if (!optConfFiles)
+         optConfFiles = _mesa_hash_table_create(NULL, _mesa_hash_string,
+                                                _mesa_key_string_equal);
+
+      struct hash_entry *entry =
+         _mesa_hash_table_search(optConfFiles, filename);
+      struct OptConfFile *file = entry ? entry->data : NULL;
+      if (file && file->dev == st.st_dev && file->ino == st.st_ino &&
+          file->size == st.st_size && file->mtime == st.st_mtime) {
+         data->parser = NULL;
+         util_dynarray_foreach(&file->elems, struct OptConfElemRecord, elem) {
+            if (elem->attr)
+               optConfStartElem(data, elem->name, elem->attr);
+            else
+               optConfEndElem(data, elem->name);
+         }
+         simple_mtx_unlock(&optConfFilesMutex);
+         return;
+      }
+
+      if (entry) {
+         _mesa_hash_table_remove(optConfFiles, entry);
+         ralloc_free(file);
+      }
+
+      data->record = rzalloc(NULL, struct OptConfFile);
+      if (data->record) {
+         util_dynarray_init(&data->record->elems, data->record);
+         data->record->dev = st.st_dev;
+         data->record->ino = st.st_ino;
+         data->record->size = st.st_size;
+         data->record->mtime = st.st_mtime;
+      }
+   }
+
+   p = XML_ParserCreate(NULL); /* use encoding specified by file */
+   if (data->record)
+      XML_SetElementHandler(p, recordStartElem, recordEndElem);
+   else
+      XML_SetElementHandler(p, optConfStartElem, optConfEndElem);
+   XML_SetUserData(p, data);
+   data->parser = p;
+
+   bool success = _parseOneConfigFile(p);
    XML_ParserFree(p);
+   data->parser = NULL;
+
+   /* Files with errors get parsed again, so the errors get reported again. */
+   if (data->record) {
+      if (success) {
+         _mesa_hash_table_insert(optConfFiles,
+                                 ralloc_strdup(data->record, filename),
+                                 data->record);
+      } else {
+         ralloc_free(data->record);
+      }
+      data->record = NULL;
+   }
+
+   simple_mtx_unlock(&optConfFilesMutex);
 }
 
 static int
@@ -35,6 +35,7 @@ static const struct debug_control vn_debug_options[] = {
    { "no_second_queue", VN_DEBUG_NO_SECOND_QUEUE },
    { "no_ray_tracing", VN_DEBUG_NO_RAY_TRACING },
    { "mem_budget", VN_DEBUG_MEM_BUDGET },
+   { "wait_stats", VN_DEBUG_WAIT_STATS },
    { NULL, 0 },
    /* clang-format on */
 };
@@ -154,6 +155,14 @@ void
 vn_relax_fini(struct vn_relax_state *state)
 {
    vn_watchdog_release(&state->instance->ring.watchdog);
+
+   if (VN_DEBUG(WAIT_STATS) && state->iter) {
+      struct vn_relax_stats *stats =
+         &state->instance->ring.relax_stats[state->reason];
+      p_atomic_inc(&stats->waits);
+      p_atomic_add(&stats->iters, state->iter);
+      p_atomic_add(&stats->sleep_us, state->sleep_us);
+   }
 }
 
 static inline const char *
@@ -238,6 +247,7 @@ vn_relax_init(struct vn_instance *instance, enum vn_relax_reason reason)
       .instance = instance,
       .iter = 0,
       .profile = vn_relax_get_profile(reason),
+      .reason = reason,
       .reason_str = vn_relax_reason_string(reason),
    };
 }
@@ -288,6 +298,22 @@ vn_relax(struct vn_relax_state *state)
 
    const uint32_t shift = util_last_bit(*iter) - busy_wait_order - 1;
    os_time_sleep(base_sleep_us << shift);
+   state->sleep_us += base_sleep_us << shift;
+}
+
+void
+vn_relax_dump_stats(struct vn_instance *instance)
+{
+   for (uint32_t i = 0; i < VN_RELAX_REASON_COUNT; i++) {
+      const struct vn_relax_stats *stats = &instance->ring.relax_stats[i];
+      if (!stats->waits)
+         continue;
+
+      vn_log(instance,
+             "%s waits: %u, polls: %" PRIu64 ", slept: %" PRIu64 " us",
+             vn_relax_reason_string(i), stats->waits, stats->iters,
+             stats->sleep_us);
+   }
 }
 
 struct vn_ring *
@@ -123,6 +123,7 @@ enum vn_debug {
    VN_DEBUG_NO_SECOND_QUEUE = 1ull << 9,
    VN_DEBUG_NO_RAY_TRACING = 1ull << 10,
    VN_DEBUG_MEM_BUDGET = 1ull << 11,
+   VN_DEBUG_WAIT_STATS = 1ull << 12,
 };
 
 enum vn_perf {
@@ -235,6 +236,15 @@ enum vn_relax_reason {
    VN_RELAX_REASON_QUERY,
 };
 
+#define VN_RELAX_REASON_COUNT (VN_RELAX_REASON_QUERY + 1)
+
+/* Only collected with VN_DEBUG=wait_stats */
+struct vn_relax_stats {
+   uint32_t waits;
+   uint64_t iters;
+   uint64_t sleep_us;
+};
+
 /* vn_relax_profile defines the driver side polling behavior
  *
  * - base_sleep_us:
@@ -265,7 +275,9 @@ struct vn_relax_profile {
 struct vn_relax_state {
    struct vn_instance *instance;
    uint32_t iter;
+   uint64_t sleep_us;
    const struct vn_relax_profile profile;
+   enum vn_relax_reason reason;
    const char *reason_str;
 };
 
@@ -424,6 +436,9 @@ vn_relax(struct vn_relax_state *state);
 void
 vn_relax_fini(struct vn_relax_state *state);
 
+void
+vn_relax_dump_stats(struct vn_instance *instance);
+
 static_assert(sizeof(vn_object_id) >= sizeof(uintptr_t), "");
 
 static inline VkResult
@@ -441,6 +441,9 @@ vn_DestroyInstance(VkInstance _instance,
       if (ring_submit.ring_seqno_valid)
          vn_ring_wait_seqno(instance->ring.ring, ring_submit.ring_seqno);
 
+      if (VN_DEBUG(WAIT_STATS))
+         vn_relax_dump_stats(instance);
+
       vn_instance_fini_ring(instance);
 
       vn_renderer_shmem_pool_fini(instance->renderer,
@@ -50,6 +50,8 @@ struct vn_instance {
       struct list_head tls_rings;
 
       struct vn_watchdog watchdog;
+
+      struct vn_relax_stats relax_stats[VN_RELAX_REASON_COUNT];
    } ring;
 
    /* Between the driver and the app, VN_MAX_API_VERSION is what we advertise
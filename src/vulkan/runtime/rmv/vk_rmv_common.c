@@ -24,6 +24,7 @@
 #include "vk_rmv_common.h"
 #include "vk_buffer.h"
 #include "vk_device.h"
+#include "util/perf/cpu_trace.h"
 
 void
 vk_memory_trace_init(struct vk_device *device, const struct vk_rmv_device_info *device_info)
@@ -35,6 +36,7 @@ vk_memory_trace_init(struct vk_device *device, const struct vk_rmv_device_info *
 
    device->memory_trace_data.next_resource_id = 1;
    device->memory_trace_data.handle_table = _mesa_hash_table_u64_create(NULL);
+   device->memory_trace_data.allocation_table = _mesa_hash_table_u64_create(NULL);
 }
 
 void
@@ -63,9 +65,66 @@ vk_memory_trace_finish(struct vk_device *device)
       fprintf(stderr,
               "mesa: Unfreed resources detected at device destroy, there may be memory leaks!\n");
    _mesa_hash_table_u64_destroy(device->memory_trace_data.handle_table);
+   _mesa_hash_table_u64_destroy(device->memory_trace_data.allocation_table);
    device->memory_trace_data.is_enabled = false;
 }
 
+static const char *const allocated_size_counters[VK_RMV_MEMORY_LOCATION_COUNT] = {
+   [VK_RMV_MEMORY_LOCATION_DEVICE] = "RMV allocated bytes (device)",
+   [VK_RMV_MEMORY_LOCATION_DEVICE_INVISIBLE] = "RMV allocated bytes (device invisible)",
+   [VK_RMV_MEMORY_LOCATION_HOST] = "RMV allocated bytes (host)",
+};
+
+static const char *const allocation_count_counters[VK_RMV_MEMORY_LOCATION_COUNT] = {
+   [VK_RMV_MEMORY_LOCATION_DEVICE] = "RMV allocations (device)",
+   [VK_RMV_MEMORY_LOCATION_DEVICE_INVISIBLE] = "RMV allocations (device invisible)",
+   [VK_RMV_MEMORY_LOCATION_HOST] = "RMV allocations (host)",
+};
+
+static void
+update_counters(struct vk_memory_trace_data *data, enum vk_rmv_memory_location location,
+                int64_t page_delta)
+{
+   data->allocated_size[location] += page_delta * 4096;
+   data->allocation_count[location] += page_delta > 0 ? 1 : -1;
+
+   MESA_TRACE_SET_COUNTER(allocated_size_counters[location], data->allocated_size[location]);
+   MESA_TRACE_SET_COUNTER(allocation_count_counters[location], data->allocation_count[location]);
+}
+
+/* Keeps the per-location totals up to date. Virtual allocations are tracked
+ * by address, because the free tokens don't carry their size.
+ */
+static void
+track_virtual_memory(struct vk_memory_trace_data *data, enum vk_rmv_token_type type,
+                     const void *token_data)
+{
+   if (type == VK_RMV_TOKEN_TYPE_VIRTUAL_ALLOCATE) {
+      const struct vk_rmv_virtual_allocate_token *token = token_data;
+      enum vk_rmv_memory_location location;
+      if (!(token->preferred_domains & VK_RMV_KERNEL_MEMORY_DOMAIN_VRAM))
+         location = VK_RMV_MEMORY_LOCATION_HOST;
+      else if (token->is_in_invisible_vram)
+         location = VK_RMV_MEMORY_LOCATION_DEVICE_INVISIBLE;
+      else
+         location = VK_RMV_MEMORY_LOCATION_DEVICE;
+
+      /* The page count is never 0, so the entry is never NULL. */
+      uintptr_t entry = (uintptr_t)token->page_count << 2 | location;
+      _mesa_hash_table_u64_insert(data->allocation_table, token->address, (void *)entry);
+      update_counters(data, location, token->page_count);
+   } else if (type == VK_RMV_TOKEN_TYPE_VIRTUAL_FREE) {
+      const struct vk_rmv_virtual_free_token *token = token_data;
+      uintptr_t entry =
+         (uintptr_t)_mesa_hash_table_u64_search(data->allocation_table, token->address);
+      if (!entry)
+         return;
+
+      _mesa_hash_table_u64_remove(data->allocation_table, token->address);
+      update_counters(data, entry & 3, -(int64_t)(entry >> 2));
+   }
+}
+
 void
 vk_rmv_emit_token(struct vk_memory_trace_data *data, enum vk_rmv_token_type type, void *token_data)
 {
@@ -74,6 +133,8 @@ vk_rmv_emit_token(struct vk_memory_trace_data *data, enum vk_rmv_token_type type
    token.timestamp = (uint64_t)os_time_get_nano();
    memcpy(&token.data, token_data, vk_rmv_token_size_from_type(type));
    util_dynarray_append(&data->tokens, token);
+
+   track_virtual_memory(data, type, token_data);
 }
 
 uint32_t
@@ -116,6 +116,12 @@ struct vk_memory_trace_data {
 
    struct hash_table_u64 *handle_table;
    uint32_t next_resource_id;
+
+   /* Live totals exported as perfetto counters. The allocation table maps
+    * the address of each virtual allocation to its size and location. */
+   struct hash_table_u64 *allocation_table;
+   uint64_t allocated_size[VK_RMV_MEMORY_LOCATION_COUNT];
+   uint32_t allocation_count[VK_RMV_MEMORY_LOCATION_COUNT];
 };
 
 struct vk_device;
@@ -214,7 +214,7 @@ vk_acceleration_structure_build_state_init(struct vk_acceleration_structure_buil
    state->scratch.size = offset;
 
    if (build_info->type == VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR &&
-       device->as_build_ops->update_as[0]) {
+       device->as_build_ops->update_as[0] && !device->as_build_ops->update_from_ir_leaves) {
       state->scratch.update_size = device->as_build_ops->get_update_scratch_size(vk_device_to_handle(device), state);
    } else {
       state->scratch.update_size = offset;
@@ -558,7 +558,8 @@ build_leaves(VkCommandBuffer commandBuffer,
       commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
 
    for (uint32_t i = 0; i < infoCount; ++i) {
-      if (bvh_states[i].vk.config.internal_type == VK_INTERNAL_BUILD_TYPE_UPDATE)
+      if (bvh_states[i].vk.config.internal_type == VK_INTERNAL_BUILD_TYPE_UPDATE &&
+          !device->as_build_ops->update_from_ir_leaves)
          continue;
       if (bvh_states[i].vk.config.updateable != updateable)
          continue;
@@ -635,6 +636,9 @@ morton_generate(VkCommandBuffer commandBuffer, struct vk_device *device,
    for (uint32_t i = 0; i < infoCount; ++i) {
       if (bvh_states[i].vk.config.internal_type == VK_INTERNAL_BUILD_TYPE_UPDATE)
          continue;
+      /* Empty dispatches aren't free, skip them for builds without primitives. */
+      if (!bvh_states[i].vk.leaf_node_count)
+         continue;
       const struct morton_args consts = {
          .bvh = pInfos[i].scratchData.deviceAddress + bvh_states[i].vk.scratch.ir_offset,
          .header = pInfos[i].scratchData.deviceAddress + bvh_states[i].vk.scratch.header_offset,
@@ -1129,12 +1133,14 @@ vk_cmd_build_acceleration_structures(VkCommandBuffer commandBuffer,
       } else if (bvh_states[i].vk.config.internal_type == VK_INTERNAL_BUILD_TYPE_UPDATE) {
          batch_state.any_update = true;
          /* For updates, the leaf node pass never runs, so set leaf_node_count here. */
-         bvh_states[i].vk.leaf_node_count = leaf_node_count;
+         if (!ops->update_from_ir_leaves)
+            bvh_states[i].vk.leaf_node_count = leaf_node_count;
       } else {
          UNREACHABLE("Unknown internal_build_type");
       }
 
-      if (bvh_states[i].vk.config.internal_type != VK_INTERNAL_BUILD_TYPE_UPDATE) {
+      if (bvh_states[i].vk.config.internal_type != VK_INTERNAL_BUILD_TYPE_UPDATE ||
+          ops->update_from_ir_leaves) {
          /* The internal node count is updated in lbvh_build_internal for LBVH
           * and from the PLOC shader for PLOC. */
          struct vk_ir_header header = {
@@ -1172,7 +1178,9 @@ vk_cmd_build_acceleration_structures(VkCommandBuffer commandBuffer,
                                                 .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
                                              }, 0, NULL, 0, NULL);
 
-   if (batch_state.any_lbvh || batch_state.any_ploc) {
+   const bool build_update_leaves = batch_state.any_update && ops->update_from_ir_leaves;
+
+   if (batch_state.any_lbvh || batch_state.any_ploc || build_update_leaves) {
       VkResult result;
 
       if (batch_state.any_non_updateable) {
@@ -1200,6 +1208,10 @@ vk_cmd_build_acceleration_structures(VkCommandBuffer commandBuffer,
       }
 
       vk_barrier_compute_w_to_compute_r(commandBuffer);
+   }
+
+   if (batch_state.any_lbvh || batch_state.any_ploc) {
+      VkResult result;
 
       result =
          morton_generate(commandBuffer, device, meta, args, infoCount, pInfos, bvh_states);
@@ -1232,6 +1244,7 @@ vk_cmd_build_acceleration_structures(VkCommandBuffer commandBuffer,
             ploc_build_internal(commandBuffer, device, meta, args, infoCount, pInfos, bvh_states);
 
          if (result != VK_SUCCESS) {
+            free(bvh_states);
             vk_command_buffer_set_error(cmd_buffer, result);
             return;
          }
@@ -1239,9 +1252,11 @@ vk_cmd_build_acceleration_structures(VkCommandBuffer commandBuffer,
 
       vk_barrier_compute_w_to_compute_r(commandBuffer);
       vk_barrier_compute_w_to_indirect_compute_r(commandBuffer);
-      flushed_compute_after_init_update_scratch = true;
    }
 
+   if (batch_state.any_lbvh || batch_state.any_ploc || build_update_leaves)
+      flushed_compute_after_init_update_scratch = true;
+
    struct vk_acceleration_structure_build_marker encode_marker;
    bool inside_encode_marker = false;
 
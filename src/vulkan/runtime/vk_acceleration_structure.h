@@ -144,6 +144,13 @@ struct vk_acceleration_structure_build_ops {
                                                    bool flushed_cp_after_init_update_scratch, bool flushed_compute_after_init_update_scratch);
    void (*update_as[MAX_ENCODE_PASSES])(VkCommandBuffer cmd_buffer, const struct vk_acceleration_structure_build_state *state);
 
+   /* Updates refit the BVH from IR leaves: the runtime builds the leaves of
+    * updated acceleration structures like it does for full builds, using the
+    * build scratch layout, and update_as then only has to refit the nodes.
+    * init_update_scratch and get_update_scratch_size are unused.
+    */
+   bool update_from_ir_leaves;
+
    const uint32_t *leaf_spirv_override;
    size_t leaf_spirv_override_size;
 };
@@ -29,6 +29,47 @@
 #include "vk_device.h"
 #include "vk_log.h"
 
+/* Applications commonly describe one array with one template entry per
+ * element.  If pEntry continues entry, in both the descriptor array and the
+ * user data, fold it into entry so drivers walk a single, longer entry.
+ */
+static bool
+vk_descriptor_template_entry_extend(struct vk_descriptor_template_entry *entry,
+                                    const VkDescriptorUpdateTemplateEntry *pEntry)
+{
+   /* For inline uniform blocks, counts and array elements are in bytes and
+    * the stride is ignored.
+    */
+   if (entry->type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK)
+      return false;
+
+   if (pEntry->descriptorType != entry->type ||
+       pEntry->dstBinding != entry->binding ||
+       pEntry->dstArrayElement != entry->array_element + entry->array_count)
+      return false;
+
+   /* The stride of a single-element entry is never used, so the distance
+    * to the next entry's data becomes the stride of the merged entry.
+    */
+   size_t stride = entry->stride;
+   if (entry->array_count == 1) {
+      if (pEntry->offset <= entry->offset)
+         return false;
+      stride = pEntry->offset - entry->offset;
+   } else if (pEntry->offset != entry->offset +
+                                entry->array_count * entry->stride) {
+      return false;
+   }
+
+   if (pEntry->descriptorCount > 1 && pEntry->stride != stride)
+      return false;
+
+   entry->stride = stride;
+
+   entry->array_count += pEntry->descriptorCount;
+   return true;
+}
+
 VKAPI_ATTR VkResult VKAPI_CALL
 vk_common_CreateDescriptorUpdateTemplate(VkDevice _device,
    const VkDescriptorUpdateTemplateCreateInfo *pCreateInfo,
@@ -66,7 +107,6 @@ vk_common_CreateDescriptorUpdateTemplate(VkDevice _device,
       template->set = pCreateInfo->set;
 
    uint32_t entry_idx = 0;
-   template->entry_count = entry_count;
    for (uint32_t i = 0; i < pCreateInfo->descriptorUpdateEntryCount; i++) {
       const VkDescriptorUpdateTemplateEntry *pEntry =
          &pCreateInfo->pDescriptorUpdateEntries[i];
@@ -74,6 +114,11 @@ vk_common_CreateDescriptorUpdateTemplate(VkDevice _device,
       if (pEntry->descriptorCount == 0)
          continue;
 
+      if (entry_idx > 0 &&
+          vk_descriptor_template_entry_extend(&template->entries[entry_idx - 1],
+                                              pEntry))
+         continue;
+
       template->entries[entry_idx++] = (struct vk_descriptor_template_entry) {
          .type = pEntry->descriptorType,
          .binding = pEntry->dstBinding,
@@ -83,7 +128,8 @@ vk_common_CreateDescriptorUpdateTemplate(VkDevice _device,
          .stride = pEntry->stride,
       };
    }
-   assert(entry_idx == entry_count);
+   assert(entry_idx <= entry_count);
+   template->entry_count = entry_idx;
 
    *pDescriptorUpdateTemplate =
       vk_descriptor_update_template_to_handle(template);
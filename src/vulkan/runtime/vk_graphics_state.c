@@ -2084,6 +2084,12 @@ void
 vk_dynamic_graphics_state_copy(struct vk_dynamic_graphics_state *dst,
                                const struct vk_dynamic_graphics_state *src)
 {
+   /* Everything below is gated on src->set, so a pipeline that makes all
+    * of its state dynamic has nothing to copy.
+    */
+   if (BITSET_IS_EMPTY(src->set))
+      return;
+
 #define IS_SET_IN_SRC(STATE) \
    BITSET_TEST(src->set, MESA_VK_DYNAMIC_##STATE)
 
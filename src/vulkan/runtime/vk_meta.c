@@ -34,6 +34,7 @@
 #include "nir.h"
 
 #include "util/hash_table.h"
+#include "util/u_atomic.h"
 
 #include <string.h>
 
@@ -41,6 +42,9 @@ struct cache_key {
    VkObjectType obj_type;
    uint32_t key_size;
    const void *key_data;
+
+   /* Object cached under this key, only set for keys in vk_meta_device::cache */
+   struct vk_object_base *obj;
 };
 
 static struct cache_key *
@@ -53,6 +57,7 @@ cache_key_create(VkObjectType obj_type, const void *key_data, size_t key_size)
       .obj_type = obj_type,
       .key_size = key_size,
       .key_data = key + 1,
+      .obj = NULL,
    };
    memcpy(key + 1, key_data, key_size);
 
@@ -123,10 +128,19 @@ vk_meta_lookup_object(struct vk_meta_device *meta,
    };
 
    uint32_t hash = cache_key_hash(&key);
+   void **slot = &meta->lookup_cache[hash % VK_META_LOOKUP_CACHE_SIZE];
+
+   const struct cache_key *recent = p_atomic_read(slot);
+   if (recent != NULL && cache_key_equal(recent, &key)) {
+      assert(recent->obj->type == obj_type);
+      return (uint64_t)(uintptr_t)recent->obj;
+   }
 
    simple_mtx_lock(&meta->cache_mtx);
    struct hash_entry *entry =
       _mesa_hash_table_search_pre_hashed(meta->cache, hash, &key);
+   if (entry != NULL)
+      p_atomic_set(slot, (void *)entry->key);
    simple_mtx_unlock(&meta->cache_mtx);
 
    if (entry == NULL)
@@ -154,12 +168,16 @@ vk_meta_cache_object(struct vk_device *device,
       vk_object_base_from_u64_handle(handle, obj_type);
 
    uint32_t hash = cache_key_hash(key);
+   key->obj = obj;
 
    simple_mtx_lock(&meta->cache_mtx);
    struct hash_entry *entry =
       _mesa_hash_table_search_pre_hashed(meta->cache, hash, key);
-   if (entry == NULL)
+   if (entry == NULL) {
       _mesa_hash_table_insert_pre_hashed(meta->cache, hash, key, obj);
+      p_atomic_set(&meta->lookup_cache[hash % VK_META_LOOKUP_CACHE_SIZE],
+                   (void *)key);
+   }
    simple_mtx_unlock(&meta->cache_mtx);
 
    if (entry != NULL) {
@@ -102,10 +102,19 @@ enum vk_meta_buffer_chunk_size_id {
    VK_META_BUFFER_CHUNK_SIZE_COUNT,
 };
 
+#define VK_META_LOOKUP_CACHE_SIZE 64
+
 struct vk_meta_device {
    struct hash_table *cache;
    simple_mtx_t cache_mtx;
 
+   /* Direct-mapped table of recently used cache entries, indexed by the low
+    * bits of the key hash.  Entries are published with p_atomic_set() and
+    * only freed in vk_meta_device_finish(), so vk_meta_lookup_object() can
+    * check it without taking cache_mtx.
+    */
+   void *lookup_cache[VK_META_LOOKUP_CACHE_SIZE];
+
    VkPipelineCache pipeline_cache;
 
    uint32_t max_bind_map_buffer_size_B;
@@ -44,6 +44,7 @@
 #include "shader_enums.h"
 
 #include "util/mesa-sha1.h"
+#include "util/perf/u_compile_event.h"
 
 struct vk_pipeline_binary {
    struct vk_object_base base;
@@ -947,16 +948,24 @@ vk_pipeline_precompile_shader(struct vk_device *device,
    const struct spirv_to_nir_options spirv_options =
       ops->get_spirv_options(device->physical, stage->stage, &rs);
 
+   struct util_compile_event evt;
+   util_compile_event_begin(&evt, UTIL_COMPILE_EVENT_NIR,
+                            _mesa_shader_stage_to_abbrev(stage->stage));
+
    nir_shader *nir;
    result = vk_pipeline_shader_stage_to_nir(device, pipeline_flags, info,
                                             &spirv_options, nir_options,
                                             NULL, &nir);
-   if (result != VK_SUCCESS)
+   if (result != VK_SUCCESS) {
+      util_compile_event_end(&evt);
       return result;
+   }
 
    if (ops->preprocess_nir != NULL)
       ops->preprocess_nir(device->physical, nir, &rs);
 
+   util_compile_event_end(&evt);
+
    stage->precomp =
       vk_pipeline_precomp_shader_create(device, stage->precomp_key,
                                         sizeof(stage->precomp_key),
@@ -1227,6 +1236,9 @@ vk_pipeline_to_shader_flags(VkPipelineCreateFlags2KHR pipeline_flags,
    if (pipeline_flags & VK_PIPELINE_CREATE_2_INDIRECT_BINDABLE_BIT_EXT)
       shader_flags |= VK_SHADER_CREATE_INDIRECT_BINDABLE_BIT_EXT;
 
+   if (pipeline_flags & VK_PIPELINE_CREATE_2_DISABLE_OPTIMIZATION_BIT_KHR)
+      shader_flags |= VK_SHADER_CREATE_DISABLE_OPTIMIZATION_BIT_MESA;
+
    if (stage == MESA_SHADER_FRAGMENT) {
       if (pipeline_flags & VK_PIPELINE_CREATE_2_RENDERING_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR)
          shader_flags |= VK_SHADER_CREATE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_EXT;
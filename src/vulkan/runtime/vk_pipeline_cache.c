@@ -36,6 +36,7 @@
 #include "util/disk_cache.h"
 #include "util/hash_table.h"
 #include "util/set.h"
+#include "util/perf/u_compile_event.h"
 
 #define vk_pipeline_cache_log(cache, ...)                                      \
    if (cache->base.client_visible)                                             \
@@ -148,14 +149,33 @@ vk_pipeline_cache_lock(struct vk_pipeline_cache *cache)
 {
 
    if (!(cache->flags & VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT))
-      simple_mtx_lock(&cache->lock);
+      u_rwlock_wrlock(&cache->lock);
 }
 
 static void
 vk_pipeline_cache_unlock(struct vk_pipeline_cache *cache)
 {
    if (!(cache->flags & VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT))
-      simple_mtx_unlock(&cache->lock);
+      u_rwlock_wrunlock(&cache->lock);
+}
+
+/* Lookups only take the lock for reading, so that threads compiling
+ * pipelines with the same cache don't serialize on cache hits.  Taking a
+ * reference under the read lock is fine because dropping the last reference
+ * of a weakly referenced object takes the lock for writing.
+ */
+static void
+vk_pipeline_cache_rdlock(struct vk_pipeline_cache *cache)
+{
+   if (!(cache->flags & VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT))
+      u_rwlock_rdlock(&cache->lock);
+}
+
+static void
+vk_pipeline_cache_rdunlock(struct vk_pipeline_cache *cache)
+{
+   if (!(cache->flags & VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT))
+      u_rwlock_rdunlock(&cache->lock);
 }
 
 /* cache->lock must be held when calling */
@@ -332,11 +352,11 @@ vk_pipeline_cache_insert_object(struct vk_pipeline_cache *cache,
    return result;
 }
 
-struct vk_pipeline_cache_object *
-vk_pipeline_cache_lookup_object(struct vk_pipeline_cache *cache,
-                                const void *key_data, size_t key_size,
-                                const struct vk_pipeline_cache_object_ops *ops,
-                                bool *cache_hit)
+static struct vk_pipeline_cache_object *
+lookup_object(struct vk_pipeline_cache *cache,
+              const void *key_data, size_t key_size,
+              const struct vk_pipeline_cache_object_ops *ops,
+              bool *cache_hit)
 {
    assert(key_size <= UINT32_MAX);
    assert(ops != NULL);
@@ -353,7 +373,7 @@ vk_pipeline_cache_lookup_object(struct vk_pipeline_cache *cache,
    struct vk_pipeline_cache_object *object = NULL;
 
    if (cache != NULL && cache->object_cache != NULL) {
-      vk_pipeline_cache_lock(cache);
+      vk_pipeline_cache_rdlock(cache);
       struct set_entry *entry =
          _mesa_set_search_pre_hashed(cache->object_cache, hash, &key);
       if (entry) {
@@ -361,7 +381,7 @@ vk_pipeline_cache_lookup_object(struct vk_pipeline_cache *cache,
          if (cache_hit != NULL)
             *cache_hit = true;
       }
-      vk_pipeline_cache_unlock(cache);
+      vk_pipeline_cache_rdunlock(cache);
    }
 
    if (object == NULL) {
@@ -422,6 +442,24 @@ vk_pipeline_cache_lookup_object(struct vk_pipeline_cache *cache,
    return object;
 }
 
+struct vk_pipeline_cache_object *
+vk_pipeline_cache_lookup_object(struct vk_pipeline_cache *cache,
+                                const void *key_data, size_t key_size,
+                                const struct vk_pipeline_cache_object_ops *ops,
+                                bool *cache_hit)
+{
+   struct util_compile_event evt;
+   util_compile_event_begin(&evt, UTIL_COMPILE_EVENT_CACHE_LOOKUP, NULL);
+
+   struct vk_pipeline_cache_object *object =
+      lookup_object(cache, key_data, key_size, ops, cache_hit);
+
+   evt.hit = object != NULL;
+   util_compile_event_end(&evt);
+
+   return object;
+}
+
 struct vk_pipeline_cache_object *
 vk_pipeline_cache_add_object(struct vk_pipeline_cache *cache,
                              struct vk_pipeline_cache_object *object)
@@ -594,8 +632,14 @@ vk_pipeline_cache_load(struct vk_pipeline_cache *cache,
       if (blob.overrun)
          break;
 
-      const struct vk_pipeline_cache_object_ops *ops =
-         find_ops_for_type(cache->base.device->physical, type);
+      /* Only keep the raw data of the objects and deserialize them the first
+       * time they are looked up, so that importing a big cache doesn't
+       * create every object the application might never use.  Weakly
+       * referenced caches can't replace raw objects on lookup.
+       */
+      const struct vk_pipeline_cache_object_ops *ops = NULL;
+      if (cache->weak_ref)
+         ops = find_ops_for_type(cache->base.device->physical, type);
 
       struct vk_pipeline_cache_object *object =
          vk_pipeline_cache_create_and_insert_object(cache, key_data, key_size,
@@ -651,7 +695,7 @@ vk_pipeline_cache_create(struct vk_device *device,
    };
    memcpy(cache->header.uuid, pdevice_props.pipelineCacheUUID, VK_UUID_SIZE);
 
-   simple_mtx_init(&cache->lock, mtx_plain);
+   u_rwlock_init(&cache->lock);
 
    if (info->force_enable ||
        debug_get_bool_option("VK_ENABLE_PIPELINE_CACHE", true)) {
@@ -681,7 +725,7 @@ vk_pipeline_cache_destroy(struct vk_pipeline_cache *cache,
       }
       _mesa_set_destroy(cache->object_cache, NULL);
    }
-   simple_mtx_destroy(&cache->lock);
+   u_rwlock_destroy(&cache->lock);
    vk_object_free(cache->base.device, pAllocator, cache);
 }
 
@@ -747,7 +791,7 @@ vk_common_GetPipelineCacheData(VkDevice _device,
       return VK_INCOMPLETE;
    }
 
-   vk_pipeline_cache_lock(cache);
+   vk_pipeline_cache_rdlock(cache);
 
    VkResult result = VK_SUCCESS;
    if (cache->object_cache != NULL) {
@@ -793,7 +837,7 @@ vk_common_GetPipelineCacheData(VkDevice _device,
       }
    }
 
-   vk_pipeline_cache_unlock(cache);
+   vk_pipeline_cache_rdunlock(cache);
 
    blob_overwrite_uint32(&blob, count_offset, count);
 
@@ -831,7 +875,7 @@ vk_common_MergePipelineCaches(VkDevice _device,
       if (src == dst)
          continue;
 
-      vk_pipeline_cache_lock(src);
+      vk_pipeline_cache_rdlock(src);
 
       set_foreach(src->object_cache, src_entry) {
          struct vk_pipeline_cache_object *src_object = (void *)src_entry->key;
@@ -858,7 +902,7 @@ vk_common_MergePipelineCaches(VkDevice _device,
          }
       }
 
-      vk_pipeline_cache_unlock(src);
+      vk_pipeline_cache_rdunlock(src);
    }
 
    vk_pipeline_cache_unlock(dst);
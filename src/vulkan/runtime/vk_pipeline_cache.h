@@ -26,7 +26,7 @@
 #include "vk_object.h"
 #include "vk_util.h"
 
-#include "util/simple_mtx.h"
+#include "util/rwlock.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -160,7 +160,7 @@ struct vk_pipeline_cache {
    struct vk_pipeline_cache_header header;
 
    /** Protects object_cache */
-   simple_mtx_t lock;
+   struct u_rwlock lock;
 
    struct set *object_cache;
 };
@@ -705,6 +705,56 @@ done:
    return result;
 }
 
+/* Folds the submits queued right behind submit into it for as long as
+ * their waits are already satisfied and vk_queue_submits_merge() accepts
+ * them, so that a burst of small, ready submits becomes a single
+ * queue::driver_submit call.  Returns the submit at the head of the list.
+ */
+static struct vk_queue_submit *
+vk_queue_submit_thread_merge_ready(struct vk_queue *queue,
+                                   struct vk_queue_submit *submit)
+{
+   while (true) {
+      /* Only this thread removes submits but vk_queue_push_submit() may be
+       * appending concurrently, so look at the list under the lock.
+       */
+      mtx_lock(&queue->submit.mutex);
+      struct vk_queue_submit *next = NULL;
+      if (submit->link.next != &queue->submit.submits)
+         next = list_entry(submit->link.next, struct vk_queue_submit, link);
+      mtx_unlock(&queue->submit.mutex);
+
+      if (next == NULL)
+         return submit;
+
+      if (next->wait_count > 0) {
+         VkResult result = vk_sync_wait_many(queue->base.device,
+                                             next->wait_count, next->waits,
+                                             VK_SYNC_WAIT_PENDING, 0);
+         if (result != VK_SUCCESS)
+            return submit;
+      }
+
+      mtx_lock(&queue->submit.mutex);
+      list_del(&next->link);
+      list_del(&submit->link);
+      struct vk_queue_submit *merged =
+         vk_queue_submits_merge(queue, submit, next);
+      if (merged == NULL) {
+         list_add(&next->link, &queue->submit.submits);
+         list_add(&submit->link, &queue->submit.submits);
+      } else {
+         list_add(&merged->link, &queue->submit.submits);
+      }
+      mtx_unlock(&queue->submit.mutex);
+
+      if (merged == NULL)
+         return submit;
+
+      submit = merged;
+   }
+}
+
 static int
 vk_queue_submit_thread_func(void *_data)
 {
@@ -739,6 +789,8 @@ vk_queue_submit_thread_func(void *_data)
          return 1;
       }
 
+      submit = vk_queue_submit_thread_merge_ready(queue, submit);
+
       result = vk_queue_submit_final(queue, submit);
       if (unlikely(result != VK_SUCCESS)) {
          vk_queue_set_lost(queue, "queue::driver_submit failed");
@@ -34,6 +34,7 @@
 #include "vk_pipeline.h"
 
 #include "util/mesa-sha1.h"
+#include "util/perf/u_compile_event.h"
 
 #include "nir.h"
 
@@ -217,8 +218,14 @@ vk_compile_shaders(struct vk_device *device,
    const struct vk_device_shader_ops *ops = device->shader_ops;
    VkResult result;
 
+   struct util_compile_event evt;
+   util_compile_event_begin(&evt, UTIL_COMPILE_EVENT_BACKEND,
+                            shader_count == 1 ?
+                            _mesa_shader_stage_to_abbrev(infos[0].stage) :
+                            "linked");
    result = ops->compile(device, shader_count, infos, state,
                          enabled_features, pAllocator, shaders_out);
+   util_compile_event_end(&evt);
    if (result != VK_SUCCESS)
       return result;
 
@@ -320,7 +320,7 @@ vk_sync_timeline_complete_point_locked(struct vk_device *device,
       return;
 
    assert(state->highest_past < point->value);
-   state->highest_past = point->value;
+   p_atomic_set(&state->highest_past, point->value);
 
    point->pending = false;
    list_del(&point->link);
@@ -383,7 +383,7 @@ vk_sync_timeline_point_install(struct vk_device *device,
    mtx_lock(&state->mutex);
 
    assert(point->value > state->highest_pending);
-   state->highest_pending = point->value;
+   p_atomic_set(&state->highest_pending, point->value);
 
    /* Adding to the pending list implicitly takes a reference but also this
     * function is documented to consume the reference to point so we don't
@@ -434,6 +434,12 @@ vk_sync_timeline_get_point(struct vk_device *device,
 {
    struct vk_sync_timeline_state *state = timeline->state;
 
+   if (p_atomic_read(&state->highest_past) >= wait_value) {
+      /* Nothing to wait on */
+      *point_out = NULL;
+      return VK_SUCCESS;
+   }
+
    mtx_lock(&state->mutex);
    VkResult result = vk_sync_timeline_get_point_locked(device, state,
                                                        wait_value, point_out);
@@ -458,7 +464,8 @@ vk_sync_timeline_signal_locked(struct vk_device *device,
 
    assert(list_is_empty(&state->pending_points));
    assert(state->highest_pending == state->highest_past);
-   state->highest_pending = state->highest_past = value;
+   p_atomic_set(&state->highest_pending, value);
+   p_atomic_set(&state->highest_past, value);
 
    int ret = u_cnd_monotonic_broadcast(&state->cond);
    if (ret == thrd_error)
@@ -566,6 +573,16 @@ vk_sync_timeline_wait(struct vk_device *device,
    if (wait_value == 0)
       return VK_SUCCESS;
 
+   /* Both values only ever increase and are published with p_atomic_set()
+    * under the mutex, so a wait that is already satisfied can return
+    * without taking the lock or touching the condition variable.
+    */
+   if (p_atomic_read(&state->highest_past) >= wait_value)
+      return VK_SUCCESS;
+   if ((wait_flags & VK_SYNC_WAIT_PENDING) &&
+       p_atomic_read(&state->highest_pending) >= wait_value)
+      return VK_SUCCESS;
+
    mtx_lock(&state->mutex);
    VkResult result = vk_sync_timeline_wait_locked(device, state,
                                                   wait_value, wait_flags,
@@ -91,10 +91,17 @@ extern "C" {
 #endif
 
 struct vk_device_dispatch_table;
+struct vk_cmd_queue_chunk;
 
 struct vk_cmd_queue {
    const VkAllocationCallbacks *alloc;
    struct list_head cmds;
+
+   /* Linear allocator set up by vk_cmd_queue_init_linear() */
+   VkAllocationCallbacks linear_alloc;
+   const VkAllocationCallbacks *linear_parent_alloc;
+   struct vk_cmd_queue_chunk *linear_chunk;
+   size_t linear_offset;
 };
 
 enum vk_cmd_type {
@@ -184,10 +191,16 @@ struct vk_cmd_queue_entry {
 
 void vk_free_queue(struct vk_cmd_queue *queue);
 
+void vk_cmd_queue_init_linear(struct vk_cmd_queue *queue);
+void vk_cmd_queue_free_linear(struct vk_cmd_queue *queue, bool keep_last_chunk);
+
 static inline void
 vk_cmd_queue_init(struct vk_cmd_queue *queue, VkAllocationCallbacks *alloc)
 {
    queue->alloc = alloc;
+   queue->linear_parent_alloc = NULL;
+   queue->linear_chunk = NULL;
+   queue->linear_offset = 0;
    list_inithead(&queue->cmds);
 }
 
@@ -195,6 +208,7 @@ static inline void
 vk_cmd_queue_reset(struct vk_cmd_queue *queue)
 {
    vk_free_queue(queue);
+   vk_cmd_queue_free_linear(queue, true);
    list_inithead(&queue->cmds);
 }
 
@@ -202,6 +216,7 @@ static inline void
 vk_cmd_queue_finish(struct vk_cmd_queue *queue)
 {
    vk_free_queue(queue);
+   vk_cmd_queue_free_linear(queue, false);
    list_inithead(&queue->cmds);
 }
 
@@ -296,6 +311,108 @@ ${get_params_copy(c, types)}}
 
 % endfor
 
+struct vk_cmd_queue_chunk {
+   struct vk_cmd_queue_chunk *prev;
+   size_t size;
+};
+
+#define VK_CMD_QUEUE_MIN_CHUNK_SIZE (16 * 1024)
+#define VK_CMD_QUEUE_MAX_CHUNK_SIZE (1024 * 1024)
+
+static VKAPI_ATTR void * VKAPI_CALL
+vk_cmd_queue_linear_alloc(void *user_data, size_t size, size_t align,
+                          VkSystemAllocationScope scope)
+{
+   struct vk_cmd_queue *queue = user_data;
+   struct vk_cmd_queue_chunk *chunk = queue->linear_chunk;
+
+   size_t offset = ALIGN_POT(queue->linear_offset, align);
+   if (!chunk || offset + size > chunk->size) {
+      size_t header_size = ALIGN_POT(sizeof(*chunk), align);
+      size_t chunk_size = chunk ? MIN2(chunk->size * 2, VK_CMD_QUEUE_MAX_CHUNK_SIZE)
+                                : VK_CMD_QUEUE_MIN_CHUNK_SIZE;
+      chunk_size = MAX2(chunk_size, header_size + size);
+
+      struct vk_cmd_queue_chunk *new_chunk =
+         vk_alloc(queue->linear_parent_alloc, chunk_size, MAX2(align, 8), scope);
+      if (!new_chunk)
+         return NULL;
+
+      new_chunk->prev = chunk;
+      new_chunk->size = chunk_size;
+      queue->linear_chunk = chunk = new_chunk;
+      offset = header_size;
+   }
+
+   queue->linear_offset = offset + size;
+   return (char *)chunk + offset;
+}
+
+static VKAPI_ATTR void * VKAPI_CALL
+vk_cmd_queue_linear_realloc(void *user_data, void *original, size_t size,
+                            size_t align, VkSystemAllocationScope scope)
+{
+   /* The size of the original allocation isn't known, nothing reallocates
+    * command queue memory.
+    */
+   assert(original == NULL);
+   return vk_cmd_queue_linear_alloc(user_data, size, align, scope);
+}
+
+static VKAPI_ATTR void VKAPI_CALL
+vk_cmd_queue_linear_free(void *user_data, void *memory)
+{
+   /* Everything gets freed at once by vk_cmd_queue_free_linear() */
+}
+
+/**
+ * Makes an empty queue allocate its commands linearly, from chunks
+ * allocated with the queue allocator.  Commands recorded one after the
+ * other are then contiguous in memory, which makes walking the queue at
+ * execution time cheaper, and resetting the queue keeps the last chunk
+ * around for the next recording.
+ */
+void
+vk_cmd_queue_init_linear(struct vk_cmd_queue *queue)
+{
+   assert(list_is_empty(&queue->cmds));
+   assert(queue->linear_parent_alloc == NULL);
+
+   queue->linear_parent_alloc = queue->alloc;
+   queue->linear_alloc = (VkAllocationCallbacks) {
+      .pUserData = queue,
+      .pfnAllocation = vk_cmd_queue_linear_alloc,
+      .pfnReallocation = vk_cmd_queue_linear_realloc,
+      .pfnFree = vk_cmd_queue_linear_free,
+   };
+   queue->alloc = &queue->linear_alloc;
+}
+
+void
+vk_cmd_queue_free_linear(struct vk_cmd_queue *queue, bool keep_last_chunk)
+{
+   if (!queue->linear_parent_alloc)
+      return;
+
+   struct vk_cmd_queue_chunk *chunk = queue->linear_chunk;
+   struct vk_cmd_queue_chunk *prev = chunk ? chunk->prev : NULL;
+
+   if (keep_last_chunk && chunk) {
+      chunk->prev = NULL;
+      queue->linear_offset = sizeof(*chunk);
+   } else {
+      vk_free(queue->linear_parent_alloc, chunk);
+      queue->linear_chunk = NULL;
+      queue->linear_offset = 0;
+   }
+
+   while (prev) {
+      struct vk_cmd_queue_chunk *next = prev->prev;
+      vk_free(queue->linear_parent_alloc, prev);
+      prev = next;
+   }
+}
+
 void
 vk_free_queue(struct vk_cmd_queue *queue)
 {
@@ -57,6 +57,8 @@ static const struct debug_control debug_control[] = {
    { "linear",       WSI_DEBUG_LINEAR },
    { "dxgi",         WSI_DEBUG_DXGI },
    { "nowlts",       WSI_DEBUG_NOWLTS },
+   { "directprime",  WSI_DEBUG_DIRECTPRIME },
+   { "blit",         WSI_DEBUG_BLIT },
    { NULL, },
 };
 
@@ -268,6 +270,9 @@ wsi_device_init(struct wsi_device *wsi,
    wsi->force_headless_swapchain =
       debug_get_bool_option("MESA_VK_WSI_HEADLESS_SWAPCHAIN", false);
 
+   wsi->max_frame_latency =
+      debug_get_num_option("MESA_VK_WSI_MAX_FRAME_LATENCY", 0);
+
    if (dri_options) {
       if (driCheckOption(dri_options, "adaptive_sync", DRI_BOOL))
          wsi->enable_adaptive_sync = driQueryOptionb(dri_options,
@@ -480,6 +485,17 @@ wsi_swapchain_init(const struct wsi_device *wsi,
    chain->alloc = *pAllocator;
    chain->blit.type = get_blit_type(wsi, image_params, _device);
 
+   if (WSI_DEBUG & WSI_DEBUG_BLIT) {
+      static const char *const blit_names[] = {
+         [WSI_SWAPCHAIN_NO_BLIT] = "none",
+         [WSI_SWAPCHAIN_BUFFER_BLIT] = "buffer",
+         [WSI_SWAPCHAIN_IMAGE_BLIT] = "image",
+      };
+      fprintf(stderr, "MESA-WSI: swapchain %ux%u, blit: %s\n",
+              pCreateInfo->imageExtent.width, pCreateInfo->imageExtent.height,
+              blit_names[chain->blit.type]);
+   }
+
    chain->blit.queue = NULL;
    if (chain->blit.type != WSI_SWAPCHAIN_NO_BLIT) {
       if (wsi->get_blit_queue) {
@@ -1279,6 +1295,47 @@ wsi_signal_fence_for_image(struct vk_device *device,
                          &fence->temporary);
 }
 
+/* Holds back the acquire until the rendering of all but the last
+ * max_frame_latency presents is done, so that the app samples its input
+ * as late as possible instead of queuing up frames.
+ */
+static void
+wsi_throttle_acquire(const struct wsi_device *wsi,
+                     struct wsi_swapchain *swapchain, uint64_t timeout)
+{
+   if (!wsi->max_frame_latency || !timeout ||
+       swapchain->present_serial < wsi->max_frame_latency)
+      return;
+
+   /* The fence of an image signals for its last present, so wait for the
+    * earliest one at or after the target, which also covers everything
+    * before it.
+    */
+   const uint64_t target =
+      swapchain->present_serial - wsi->max_frame_latency + 1;
+   VkFence fence = VK_NULL_HANDLE;
+   uint64_t fence_serial = UINT64_MAX;
+   for (uint32_t i = 0; i < swapchain->image_count; i++) {
+      struct wsi_image *image = swapchain->get_wsi_image(swapchain, i);
+      if (image->acquired || image->present_serial < target ||
+          image->present_serial >= fence_serial ||
+          swapchain->fences[i] == VK_NULL_HANDLE)
+         continue;
+
+      fence = swapchain->fences[i];
+      fence_serial = image->present_serial;
+   }
+
+   if (fence == VK_NULL_HANDLE)
+      return;
+
+   /* This is only pacing, so a timeout or error is not reported here, the
+    * acquire below deals with the swapchain state.
+    */
+   MESA_TRACE_SCOPE("frame latency");
+   wsi->WaitForFences(swapchain->device, 1, &fence, true, timeout);
+}
+
 VkResult
 wsi_common_acquire_next_image2(const struct wsi_device *wsi,
                                VkDevice _device,
@@ -1288,6 +1345,8 @@ wsi_common_acquire_next_image2(const struct wsi_device *wsi,
    VK_FROM_HANDLE(wsi_swapchain, swapchain, pAcquireInfo->swapchain);
    VK_FROM_HANDLE(vk_device, device, _device);
 
+   wsi_throttle_acquire(wsi, swapchain, pAcquireInfo->timeout);
+
    VkResult result = swapchain->acquire_next_image(swapchain, pAcquireInfo,
                                                    pImageIndex);
    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
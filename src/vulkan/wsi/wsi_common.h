@@ -103,6 +103,11 @@ struct wsi_device {
 
    bool disable_unordered_submits;
 
+   /* Maximum number of presents whose rendering may still be in flight when
+    * an image gets acquired.  0 = only throttled by the image count.
+    */
+   uint32_t max_frame_latency;
+
    struct {
       /* Override the minimum number of images on the swapchain.
        * 0 = no override */
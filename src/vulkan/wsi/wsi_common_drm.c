@@ -893,8 +893,31 @@ bool
 wsi_drm_image_needs_buffer_blit(const struct wsi_device *wsi,
                                 const struct wsi_drm_image_params *params)
 {
-   if (!params->same_gpu)
+   if (!params->same_gpu) {
+      /* A display server on another GPU that takes LINEAR can read the image
+       * directly, saving the blit into a linear buffer.  Whether the buffer
+       * can end up in memory both GPUs can access depends on the kernel
+       * drivers though, so this is opt-in.
+       */
+      if (!(WSI_DEBUG & WSI_DEBUG_DIRECTPRIME))
+         return true;
+
+      for (uint32_t l = 0; l < params->num_modifier_lists; l++) {
+         if (params->num_modifiers[l] == 0)
+            continue;
+
+         /* wsi_configure_native_image only uses the first list that has a
+          * modifier we support, and we always support LINEAR.
+          */
+         for (uint32_t i = 0; i < params->num_modifiers[l]; i++) {
+            if (params->modifiers[l][i] == DRM_FORMAT_MOD_LINEAR)
+               return false;
+         }
+         return true;
+      }
+
       return true;
+   }
 
    if (params->num_modifier_lists > 0 || wsi->supports_scanout)
       return false;
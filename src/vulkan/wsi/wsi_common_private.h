@@ -41,6 +41,8 @@ struct wsi_swapchain;
 #define WSI_DEBUG_LINEAR      (1ull << 3)
 #define WSI_DEBUG_DXGI        (1ull << 4)
 #define WSI_DEBUG_NOWLTS      (1ull << 5)
+#define WSI_DEBUG_DIRECTPRIME (1ull << 6)
+#define WSI_DEBUG_BLIT        (1ull << 7)
 
 extern uint64_t WSI_DEBUG;
 
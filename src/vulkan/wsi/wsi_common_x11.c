@@ -2405,12 +2405,10 @@ wsi_x11_swapchain_query_dri3_modifiers_changed(struct x11_swapchain *chain)
    struct wsi_x11_connection *wsi_conn =
          wsi_x11_get_connection((struct wsi_device*)chain->base.wsi, chain->conn);
 
-   xcb_get_geometry_reply_t *geometry =
-         xcb_get_geometry_reply(chain->conn, xcb_get_geometry(chain->conn, chain->window), NULL);
-   if (geometry == NULL)
-      return false;
-   uint32_t bit_depth = geometry->depth;
-   free(geometry);
+   /* The depth of a window never changes, so there is no need for a round
+    * trip to query it again.
+    */
+   uint32_t bit_depth = chain->depth;
 
    drm_image_params = (struct wsi_drm_image_params){
       .base.image_type = WSI_IMAGE_TYPE_DRM,
@@ -2617,16 +2615,38 @@ x11_surface_create_swapchain(VkIcdSurfaceBase *icd_surface,
 
    /* Get the geometry of that window. The bit depth of the swapchain will be fitted and the
     * chain's images extents should fit it for performance-optimizing flips.
+    *
+    * Send the present capabilities query along with it, so both only cost
+    * a single round trip.
     */
+   xcb_get_geometry_cookie_t geometry_cookie = xcb_get_geometry(conn, window);
+#ifdef HAVE_X11_DRM
+   xcb_present_query_capabilities_cookie_t present_query_cookie =
+      xcb_present_query_capabilities(conn, window);
+#endif
    xcb_get_geometry_reply_t *geometry =
-      xcb_get_geometry_reply(conn, xcb_get_geometry(conn, window), NULL);
-   if (geometry == NULL)
+      xcb_get_geometry_reply(conn, geometry_cookie, NULL);
+   if (geometry == NULL) {
+#ifdef HAVE_X11_DRM
+      xcb_discard_reply(conn, present_query_cookie.sequence);
+#endif
       return VK_ERROR_SURFACE_LOST_KHR;
+   }
    const uint32_t bit_depth = geometry->depth;
    const uint16_t cur_width = geometry->width;
    const uint16_t cur_height = geometry->height;
    free(geometry);
 
+   uint32_t present_caps = 0;
+#ifdef HAVE_X11_DRM
+   xcb_present_query_capabilities_reply_t *present_query_reply =
+      xcb_present_query_capabilities_reply(conn, present_query_cookie, NULL);
+   if (present_query_reply) {
+      present_caps = present_query_reply->capabilities;
+      free(present_query_reply);
+   }
+#endif
+
    /* Allocate the actual swapchain. The size depends on image count. */
    size_t size = sizeof(*chain) + num_images * sizeof(chain->images[0]);
    chain = vk_zalloc(pAllocator, size, 8,
@@ -2664,18 +2684,6 @@ x11_surface_create_swapchain(VkIcdSurfaceBase *icd_surface,
       return VK_ERROR_OUT_OF_HOST_MEMORY;
    }
 
-   uint32_t present_caps = 0;
-#ifdef HAVE_X11_DRM
-   xcb_present_query_capabilities_cookie_t present_query_cookie;
-   xcb_present_query_capabilities_reply_t *present_query_reply;
-   present_query_cookie = xcb_present_query_capabilities(conn, window);
-   present_query_reply = xcb_present_query_capabilities_reply(conn, present_query_cookie, NULL);
-   if (present_query_reply) {
-      present_caps = present_query_reply->capabilities;
-      free(present_query_reply);
-   }
-#endif
-
 #ifdef HAVE_X11_DRM
    struct wsi_drm_image_params drm_image_params;
    uint32_t num_modifiers[2] = {0, 0};